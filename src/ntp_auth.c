@@ -0,0 +1,590 @@
+﻿/**
+ * @file ntp_auth.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 对称密钥认证（MD5、SHA1、AES-128-CMAC）的 密钥表 与 MAC 计算接口。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_auth.h"
+#include "ntp_packet.h"
+#include "ntp_cmac.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <errno.h>
+
+#ifdef XNTP_OPENSSL
+#ifndef OPENSSL_SUPPRESS_DEPRECATED
+#define OPENSSL_SUPPRESS_DEPRECATED
+#endif // OPENSSL_SUPPRESS_DEPRECATED
+#include <openssl/md5.h>
+#include <openssl/sha.h>
+#include <openssl/crypto.h>
+#endif // XNTP_OPENSSL
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 内部相关的数据类型与常量
+//
+
+/**
+ * 每个密钥 都预先计算好 与报文无关的部分（吸收了密钥的 摘要上下文、AES 轮密钥 与 CMAC 子密钥），
+ * 计算 MAC 时 只需在栈上复制一份上下文，再处理报文数据，整个过程 不分配内存、不加锁，
+ * 且 密钥表 可被多个线程 并发读取。
+ * 这里使用 OpenSSL 的 底层摘要/分组加密接口（而非 EVP），正是为了能 按值复制 上下文。
+ */
+
+/**
+ * @struct xntp_key_t
+ * @brief  密钥表 中的 单个密钥。
+ */
+typedef struct xntp_key_t
+{
+    x_uint32_t  xut_keyid;                  ///< key ID
+    xntp_auth_t xit_type;                   ///< 认证算法
+
+#ifdef XNTP_OPENSSL
+    union
+    {
+        MD5_CTX xmd5_ctx;                   ///< 已吸收密钥的 MD5 上下文
+        SHA_CTX xsha_ctx;                   ///< 已吸收密钥的 SHA1 上下文
+        xntp_cmac_t xcmac;                  ///< AES-128-CMAC 的 轮密钥 与 子密钥
+    } xstate;
+#endif // XNTP_OPENSSL
+} xntp_key_t;
+
+/**
+ * @struct xntp_keytab_t
+ * @brief  密钥表（按 key ID 升序存放，以 二分查找 定位）。
+ */
+typedef struct xntp_keytab_t
+{
+    xntp_key_t * xkey_list;     ///< 密钥数组
+    x_uint32_t   xut_count;     ///< 密钥数量
+    x_uint32_t   xut_capacity;  ///< 密钥数组的 容量
+} xntp_keytab_t;
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 二分查找 key ID 在 密钥数组 中的位置。
+ *
+ * @param [in ] xkey_table : 密钥表。
+ * @param [in ] xut_keyid  : key ID。
+ * @param [out] xut_index  : 找到时 为其位置，否则 为其应插入的位置。
+ *
+ * @return x_bool_t : 找到，返回 X_TRUE；否则返回 X_FALSE。
+ */
+static x_bool_t ntpkey_search(xntp_keyptr_t xkey_table, x_uint32_t xut_keyid, x_uint32_t * xut_index)
+{
+    x_uint32_t xut_lpos = 0;
+    x_uint32_t xut_rpos = xkey_table->xut_count;
+    x_uint32_t xut_mpos = 0;
+
+    while (xut_lpos < xut_rpos)
+    {
+        xut_mpos = xut_lpos + (xut_rpos - xut_lpos) / 2;
+        if (xkey_table->xkey_list[xut_mpos].xut_keyid < xut_keyid)
+            xut_lpos = xut_mpos + 1;
+        else
+            xut_rpos = xut_mpos;
+    }
+
+    *xut_index = xut_lpos;
+
+    return ((xut_lpos < xkey_table->xut_count) &&
+            (xkey_table->xkey_list[xut_lpos].xut_keyid == xut_keyid)) ? X_TRUE : X_FALSE;
+}
+
+/**********************************************************/
+/**
+ * @brief 查找 key ID 对应的 密钥（不存在时 返回 X_NULL）。
+ */
+static inline const xntp_key_t * ntpkey_find(xntp_keyptr_t xkey_table, x_uint32_t xut_keyid)
+{
+    x_uint32_t xut_index = 0;
+
+    if ((X_NULL == xkey_table) || !ntpkey_search(xkey_table, xut_keyid, &xut_index))
+        return X_NULL;
+    return &xkey_table->xkey_list[xut_index];
+}
+
+
+/**********************************************************/
+/**
+ * @brief 计算报文数据的 MAC 摘要。
+ *
+ * @return x_uint32_t : 返回 摘要的字节数。
+ */
+static x_uint32_t ntpkey_digest(
+                        const xntp_key_t * xkey_ptr,
+                        const x_uchar_t * xbt_data,
+                        x_uint32_t xut_dlen,
+                        x_uchar_t xbt_digest[XNTP_AUTH_DIGEST_MAX])
+{
+#ifdef XNTP_OPENSSL
+    MD5_CTX xmd5_ctx;
+    SHA_CTX xsha_ctx;
+
+    switch (xkey_ptr->xit_type)
+    {
+    case ntp_auth_md5:
+        xmd5_ctx = xkey_ptr->xstate.xmd5_ctx;
+        MD5_Update(&xmd5_ctx, xbt_data, xut_dlen);
+        MD5_Final(xbt_digest, &xmd5_ctx);
+        return MD5_DIGEST_LENGTH;
+
+    case ntp_auth_sha1:
+        xsha_ctx = xkey_ptr->xstate.xsha_ctx;
+        SHA1_Update(&xsha_ctx, xbt_data, xut_dlen);
+        SHA1_Final(xbt_digest, &xsha_ctx);
+        return SHA_DIGEST_LENGTH;
+
+    case ntp_auth_cmac:
+        ntp_cmac_calc(&xkey_ptr->xstate.xcmac, xbt_data, xut_dlen, xbt_digest);
+        return XCMAC_BLOCK;
+
+    default:
+        break;
+    }
+#else // !XNTP_OPENSSL
+    (x_void_t)xkey_ptr;
+    (x_void_t)xbt_data;
+    (x_void_t)xut_dlen;
+    (x_void_t)xbt_digest;
+#endif // XNTP_OPENSSL
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 十六进制串 解码为 字节数据。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；串中含 非十六进制字符，返回 X_FALSE。
+ */
+static x_bool_t ntpkey_unhex(x_cstring_t xszt_hex, x_uint32_t xut_slen, x_uchar_t * xbt_dst)
+{
+    x_uint32_t xut_iter  = 0;
+    x_int32_t  xit_value = 0;
+    x_char_t   xct_char  = 0;
+
+    for (xut_iter = 0; xut_iter < xut_slen; ++xut_iter)
+    {
+        xct_char = xszt_hex[xut_iter];
+        if ((xct_char >= '0') && (xct_char <= '9'))
+            xit_value = xct_char - '0';
+        else if ((xct_char >= 'a') && (xct_char <= 'f'))
+            xit_value = xct_char - 'a' + 10;
+        else if ((xct_char >= 'A') && (xct_char <= 'F'))
+            xit_value = xct_char - 'A' + 10;
+        else
+            return X_FALSE;
+
+        if (0 == (xut_iter & 1))
+            xbt_dst[xut_iter / 2] = (x_uchar_t)(xit_value << 4);
+        else
+            xbt_dst[xut_iter / 2] |= (x_uchar_t)xit_value;
+    }
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 比较 两个字符串 是否相同（不区分大小写）。
+ */
+static x_bool_t ntpkey_same(x_cstring_t xszt_lstr, x_cstring_t xszt_rstr)
+{
+    while (('\0' != *xszt_lstr) && ('\0' != *xszt_rstr))
+    {
+        if (toupper((x_uchar_t)*xszt_lstr++) != toupper((x_uchar_t)*xszt_rstr++))
+            return X_FALSE;
+    }
+
+    return (*xszt_lstr == *xszt_rstr) ? X_TRUE : X_FALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 外部相关操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 创建 密钥表。
+ *
+ * @return xntp_keyptr_t : 成功，返回 密钥表；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_keyptr_t ntpkey_create(void)
+{
+    xntp_keyptr_t xkey_table = (xntp_keyptr_t)calloc(1, sizeof(xntp_keytab_t));
+    if (X_NULL == xkey_table)
+    {
+        errno = ENOMEM;
+    }
+
+    return xkey_table;
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁 密钥表。
+ */
+x_void_t ntpkey_destroy(xntp_keyptr_t xkey_table)
+{
+    if (X_NULL == xkey_table)
+    {
+        return;
+    }
+
+    if (X_NULL != xkey_table->xkey_list)
+    {
+        // 清除 密钥相关的数据
+        memset(xkey_table->xkey_list, 0, xkey_table->xut_capacity * sizeof(xntp_key_t));
+        free(xkey_table->xkey_list);
+        xkey_table->xkey_list = X_NULL;
+    }
+
+    free(xkey_table);
+}
+
+/**********************************************************/
+/**
+ * @brief 向 密钥表 添加（或替换）密钥。
+ *
+ * @param [in ] xkey_table : 密钥表。
+ * @param [in ] xut_keyid  : key ID（不可为 0）。
+ * @param [in ] xit_type   : 认证算法（参看 xntp_auth_t）。
+ * @param [in ] xbt_key    : 密钥数据。
+ * @param [in ] xut_klen   : 密钥字节数（AES-128-CMAC 须为 16；其他 1 ~ XNTP_AUTH_KEY_MAX）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpkey_add(
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid,
+                xntp_auth_t xit_type,
+                const x_uchar_t * xbt_key,
+                x_uint32_t xut_klen)
+{
+    x_uint32_t   xut_index = 0;
+    xntp_key_t * xkey_list = X_NULL;
+    xntp_key_t   xkey_this;
+
+    if ((X_NULL == xkey_table) || (0 == xut_keyid) || (X_NULL == xbt_key) ||
+        (0 == xut_klen) || (xut_klen > XNTP_AUTH_KEY_MAX))
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 预先计算 与报文无关的部分
+
+    memset(&xkey_this, 0, sizeof(xntp_key_t));
+    xkey_this.xut_keyid = xut_keyid;
+    xkey_this.xit_type  = xit_type;
+
+#ifdef XNTP_OPENSSL
+    switch (xit_type)
+    {
+    case ntp_auth_md5:
+        MD5_Init(&xkey_this.xstate.xmd5_ctx);
+        MD5_Update(&xkey_this.xstate.xmd5_ctx, xbt_key, xut_klen);
+        break;
+
+    case ntp_auth_sha1:
+        SHA1_Init(&xkey_this.xstate.xsha_ctx);
+        SHA1_Update(&xkey_this.xstate.xsha_ctx, xbt_key, xut_klen);
+        break;
+
+    case ntp_auth_cmac:
+        if ((XCMAC_BLOCK != xut_klen) || !ntp_cmac_init(&xkey_this.xstate.xcmac, xbt_key))
+            return EINVAL;
+        break;
+
+    default:
+        return EINVAL;
+    }
+#else // !XNTP_OPENSSL
+    return ENOTSUP;
+#endif // XNTP_OPENSSL
+
+    //======================================
+
+    if (ntpkey_search(xkey_table, xut_keyid, &xut_index))
+    {
+        xkey_table->xkey_list[xut_index] = xkey_this;
+        return 0;
+    }
+
+    if (xkey_table->xut_count >= xkey_table->xut_capacity)
+    {
+        xkey_list = (xntp_key_t *)realloc(
+                        xkey_table->xkey_list,
+                        (xkey_table->xut_capacity + 8) * sizeof(xntp_key_t));
+        if (X_NULL == xkey_list)
+        {
+            return ENOMEM;
+        }
+
+        xkey_table->xkey_list     = xkey_list;
+        xkey_table->xut_capacity += 8;
+    }
+
+    memmove(&xkey_table->xkey_list[xut_index + 1],
+            &xkey_table->xkey_list[xut_index],
+            (xkey_table->xut_count - xut_index) * sizeof(xntp_key_t));
+    xkey_table->xkey_list[xut_index] = xkey_this;
+    xkey_table->xut_count += 1;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 从 ntpd 格式的 密钥文件（ntp.keys）加载密钥。
+ *
+ * @param [in ] xkey_table : 密钥表。
+ * @param [in ] xszt_path  : 密钥文件路径。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码（格式错误为 EINVAL）。
+ */
+x_int32_t ntpkey_load(xntp_keyptr_t xkey_table, x_cstring_t xszt_path)
+{
+    x_int32_t    xit_errno = 0;
+    FILE       * xfile_ptr = X_NULL;
+    x_char_t   * xszt_iter = X_NULL;
+    x_char_t   * xszt_type = X_NULL;
+    x_char_t   * xszt_key  = X_NULL;
+    x_uint32_t   xut_keyid = 0;
+    x_uint32_t   xut_klen  = 0;
+    xntp_auth_t  xit_type  = ntp_auth_none;
+    x_char_t     xszt_line[TEXT_LEN_256];
+    x_uchar_t    xbt_key[XNTP_AUTH_KEY_MAX];
+
+    if ((X_NULL == xkey_table) || (X_NULL == xszt_path))
+    {
+        return EINVAL;
+    }
+
+#ifdef _MSC_VER
+    if (0 != fopen_s(&xfile_ptr, xszt_path, "r"))
+        xfile_ptr = X_NULL;
+#else // !_MSC_VER
+    xfile_ptr = fopen(xszt_path, "r");
+#endif // _MSC_VER
+    if (X_NULL == xfile_ptr)
+    {
+        return errno;
+    }
+
+    while ((0 == xit_errno) && (X_NULL != fgets(xszt_line, TEXT_LEN_256, xfile_ptr)))
+    {
+        //======================================
+        // 去掉注释，拆分出 keyid、type、key 三个字段
+
+        for (xszt_iter = xszt_line; '\0' != *xszt_iter; ++xszt_iter)
+        {
+            if (('#' == *xszt_iter) || ('\r' == *xszt_iter) || ('\n' == *xszt_iter))
+            {
+                *xszt_iter = '\0';
+                break;
+            }
+        }
+
+        xszt_iter = xszt_line;
+        while (isspace((x_uchar_t)*xszt_iter))
+            ++xszt_iter;
+        if ('\0' == *xszt_iter)
+            continue;
+
+        xut_keyid = (x_uint32_t)strtoul(xszt_iter, &xszt_iter, 10);
+
+        while (isspace((x_uchar_t)*xszt_iter))
+            *xszt_iter++ = '\0';
+        xszt_type = xszt_iter;
+        while (('\0' != *xszt_iter) && !isspace((x_uchar_t)*xszt_iter))
+            ++xszt_iter;
+
+        while (isspace((x_uchar_t)*xszt_iter))
+            *xszt_iter++ = '\0';
+        xszt_key = xszt_iter;
+        while (('\0' != *xszt_iter) && !isspace((x_uchar_t)*xszt_iter))
+            ++xszt_iter;
+        *xszt_iter = '\0';
+
+        //======================================
+
+        if (ntpkey_same(xszt_type, "MD5") || ntpkey_same(xszt_type, "M"))
+            xit_type = ntp_auth_md5;
+        else if (ntpkey_same(xszt_type, "SHA1") || ntpkey_same(xszt_type, "SHA-1"))
+            xit_type = ntp_auth_sha1;
+        else if (ntpkey_same(xszt_type, "AES128CMAC") || ntpkey_same(xszt_type, "AES-128-CMAC"))
+            xit_type = ntp_auth_cmac;
+        else
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        xut_klen = (x_uint32_t)strlen(xszt_key);
+        if ((0 == xut_keyid) || (0 == xut_klen))
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        if (xut_klen <= 20)
+        {
+            memcpy(xbt_key, xszt_key, xut_klen);
+        }
+        else if ((0 == (xut_klen & 1)) && (xut_klen <= 2 * XNTP_AUTH_KEY_MAX) &&
+                 ntpkey_unhex(xszt_key, xut_klen, xbt_key))
+        {
+            xut_klen /= 2;
+        }
+        else
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        xit_errno = ntpkey_add(xkey_table, xut_keyid, xit_type, xbt_key, xut_klen);
+    }
+
+    memset(xbt_key, 0, sizeof(xbt_key));
+    memset(xszt_line, 0, sizeof(xszt_line));
+    fclose(xfile_ptr);
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 判断 密钥表 中 是否存在指定的 key ID。
+ */
+x_bool_t ntpkey_exist(xntp_keyptr_t xkey_table, x_uint32_t xut_keyid)
+{
+    return (X_NULL != ntpkey_find(xkey_table, xut_keyid)) ? X_TRUE : X_FALSE;
+}
+
+/**********************************************************/
+/**
+ * @brief 为报文计算 MAC，并追加到报文之后（4 字节的 key ID + 摘要）。
+ *
+ * @param [in    ] xkey_table : 密钥表。
+ * @param [in    ] xut_keyid  : key ID。
+ * @param [in,out] xbt_pack   : 报文缓存（其后 须留有 4 + XNTP_AUTH_DIGEST_MAX 字节的空间）。
+ * @param [in    ] xut_dlen   : 报文长度（MAC 所覆盖的 数据长度）。
+ * @param [out   ] xut_mlen   : 操作成功时，返回 所追加的 MAC 字节数。
+ *
+ * @return x_int32_t : 成功，返回 0；key ID 不存在，返回 ENOENT。
+ */
+x_int32_t ntpkey_sign(
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid,
+                x_uchar_t * xbt_pack,
+                x_uint32_t xut_dlen,
+                x_uint32_t * xut_mlen)
+{
+    const xntp_key_t * xkey_ptr = ntpkey_find(xkey_table, xut_keyid);
+    if (X_NULL == xkey_ptr)
+    {
+        return ENOENT;
+    }
+
+    ntp_store32(xbt_pack + xut_dlen, xut_keyid);
+    *xut_mlen = XNTP_MAC_KEYID +
+                ntpkey_digest(xkey_ptr, xbt_pack, xut_dlen, xbt_pack + xut_dlen + XNTP_MAC_KEYID);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 校验报文的 MAC 摘要（以常量时间比较）。
+ *
+ * @param [in ] xkey_table : 密钥表。
+ * @param [in ] xut_keyid  : MAC 中的 key ID。
+ * @param [in ] xbt_data   : MAC 所覆盖的 报文数据。
+ * @param [in ] xut_dlen   : MAC 所覆盖的 数据长度。
+ * @param [in ] xbt_digest : 报文所携带的 摘要。
+ * @param [in ] xut_glen   : 报文所携带的 摘要字节数。
+ *
+ * @return x_int32_t : 校验通过，返回 0；key ID 不存在，返回 ENOENT；校验失败，返回 EACCES。
+ */
+x_int32_t ntpkey_verify(
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid,
+                const x_uchar_t * xbt_data,
+                x_uint32_t xut_dlen,
+                const x_uchar_t * xbt_digest,
+                x_uint32_t xut_glen)
+{
+    x_uint32_t         xut_clen = 0;
+    const xntp_key_t * xkey_ptr = ntpkey_find(xkey_table, xut_keyid);
+    x_uchar_t          xbt_calc[XNTP_AUTH_DIGEST_MAX];
+
+    if (X_NULL == xkey_ptr)
+    {
+        return ENOENT;
+    }
+
+    xut_clen = ntpkey_digest(xkey_ptr, xbt_data, xut_dlen, xbt_calc);
+    if ((0 == xut_clen) || (xut_clen != xut_glen))
+    {
+        return EACCES;
+    }
+
+#ifdef XNTP_OPENSSL
+    if (0 != CRYPTO_memcmp(xbt_calc, xbt_digest, xut_clen))
+#else // !XNTP_OPENSSL
+    if (0 != memcmp(xbt_calc, xbt_digest, xut_clen))
+#endif // XNTP_OPENSSL
+    {
+        return EACCES;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,179 @@
+﻿/**
+ * @file ntp_auth.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 对称密钥认证（MD5、SHA1、AES-128-CMAC）的 密钥表 与 MAC 计算接口。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_AUTH_H__
+#define __NTP_AUTH_H__
+
+#include "xtypes.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * 认证算法 依赖 OpenSSL（libcrypto），由 CMake 选项 XNTP_OPENSSL 控制；
+ * 未启用时，本文件的接口依然可用，但 添加密钥 会返回 ENOTSUP。
+ */
+
+/**
+ * @enum  xntp_auth_t
+ * @brief 对称密钥认证 的 算法类型。
+ */
+typedef enum xntp_auth_t
+{
+    ntp_auth_none = 0,  ///< 不认证
+    ntp_auth_md5  = 1,  ///< MD5(key || 报文)，16 字节摘要（RFC 5905）
+    ntp_auth_sha1 = 2,  ///< SHA1(key || 报文)，20 字节摘要
+    ntp_auth_cmac = 3,  ///< AES-128-CMAC(key, 报文)，16 字节摘要（RFC 8573）
+} xntp_auth_t;
+
+/** MAC 摘要 的 最大字节数（SHA1） */
+#define XNTP_AUTH_DIGEST_MAX    20
+
+/** 密钥 的 最大字节数 */
+#define XNTP_AUTH_KEY_MAX       64
+
+/** 定义 密钥表 的 指针类型 */
+typedef struct xntp_keytab_t * xntp_keyptr_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 创建 密钥表。
+ * @note
+ * 密钥表 在添加完密钥后 只被读取，可由多个线程（客户端对象、本地服务端 等）共用；
+ * 添加密钥 不是线程安全的，应在共用之前完成。
+ *
+ * @return xntp_keyptr_t : 成功，返回 密钥表；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_keyptr_t ntpkey_create(void);
+
+/**********************************************************/
+/**
+ * @brief 销毁 密钥表。
+ */
+x_void_t ntpkey_destroy(xntp_keyptr_t xkey_table);
+
+/**********************************************************/
+/**
+ * @brief 向 密钥表 添加（或替换）密钥。
+ *
+ * @param [in ] xkey_table : 密钥表。
+ * @param [in ] xut_keyid  : key ID（不可为 0）。
+ * @param [in ] xit_type   : 认证算法（参看 xntp_auth_t）。
+ * @param [in ] xbt_key    : 密钥数据。
+ * @param [in ] xut_klen   : 密钥字节数（AES-128-CMAC 须为 16；其他 1 ~ XNTP_AUTH_KEY_MAX）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpkey_add(
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid,
+                xntp_auth_t xit_type,
+                const x_uchar_t * xbt_key,
+                x_uint32_t xut_klen);
+
+/**********************************************************/
+/**
+ * @brief 从 ntpd 格式的 密钥文件（ntp.keys）加载密钥。
+ * @note
+ * 每行格式为 “keyid type key”，'#' 之后为注释；
+ * type 取 MD5、SHA1、AES128CMAC（不区分大小写）；
+ * key 不超过 20 个字符时 为 ASCII 文本，否则 为 十六进制串。
+ *
+ * @param [in ] xkey_table : 密钥表。
+ * @param [in ] xszt_path  : 密钥文件路径。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码（格式错误为 EINVAL）。
+ */
+x_int32_t ntpkey_load(xntp_keyptr_t xkey_table, x_cstring_t xszt_path);
+
+/**********************************************************/
+/**
+ * @brief 判断 密钥表 中 是否存在指定的 key ID。
+ */
+x_bool_t ntpkey_exist(xntp_keyptr_t xkey_table, x_uint32_t xut_keyid);
+
+/**********************************************************/
+/**
+ * @brief 为报文计算 MAC，并追加到报文之后（4 字节的 key ID + 摘要）。
+ *
+ * @param [in    ] xkey_table : 密钥表。
+ * @param [in    ] xut_keyid  : key ID。
+ * @param [in,out] xbt_pack   : 报文缓存（其后 须留有 4 + XNTP_AUTH_DIGEST_MAX 字节的空间）。
+ * @param [in    ] xut_dlen   : 报文长度（MAC 所覆盖的 数据长度）。
+ * @param [out   ] xut_mlen   : 操作成功时，返回 所追加的 MAC 字节数。
+ *
+ * @return x_int32_t : 成功，返回 0；key ID 不存在，返回 ENOENT。
+ */
+x_int32_t ntpkey_sign(
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid,
+                x_uchar_t * xbt_pack,
+                x_uint32_t xut_dlen,
+                x_uint32_t * xut_mlen);
+
+/**********************************************************/
+/**
+ * @brief 校验报文的 MAC 摘要（以常量时间比较）。
+ *
+ * @param [in ] xkey_table : 密钥表。
+ * @param [in ] xut_keyid  : MAC 中的 key ID。
+ * @param [in ] xbt_data   : MAC 所覆盖的 报文数据。
+ * @param [in ] xut_dlen   : MAC 所覆盖的 数据长度。
+ * @param [in ] xbt_digest : 报文所携带的 摘要。
+ * @param [in ] xut_glen   : 报文所携带的 摘要字节数。
+ *
+ * @return x_int32_t : 校验通过，返回 0；key ID 不存在，返回 ENOENT；校验失败，返回 EACCES。
+ */
+x_int32_t ntpkey_verify(
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid,
+                const x_uchar_t * xbt_data,
+                x_uint32_t xut_dlen,
+                const x_uchar_t * xbt_digest,
+                x_uint32_t xut_glen);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_AUTH_H__
@@ -0,0 +1,615 @@
+﻿/**
+ * @file ntp_bcast.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 广播/组播 客户端（被动接收 服务端 周期发送的 时间）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_bcast.h"
+#include "ntp_packet.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if (defined(_WIN32) || defined(_WIN64))
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <windows.h>
+#elif (defined(__linux__) || defined(__unix__))
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 内部数据类型
+// 
+
+/** 校准请求 的 默认超时时间（毫秒） */
+#define XBC_TMOUT_DEF       3000
+
+/** 服务端 沉默多少个 轮询间隔 之后，才允许 锁定 其他服务端 */
+#define XBC_STALE_POLLS     4
+
+/** 广播报文 中 轮询间隔（log2 秒）的 取值范围 */
+#define XBC_POLL_MIN        4
+#define XBC_POLL_MAX        17
+
+/**
+ * @struct xntp_bcast_t
+ * @brief  广播/组播 客户端 的结构体描述信息。
+ */
+typedef struct xntp_bcast_t
+{
+    xntp_bcast_conf_t xconf;        ///< 工作参数（字符串字段 不保留）
+    x_uint32_t        xut_group;    ///< 组播组 地址（网络字节序；接收广播 时 为 INADDR_ANY）
+    x_uint32_t        xut_iface;    ///< 加入组播组 所用的 本地接口 地址（网络字节序）
+    x_sockfd_t        xfdt_sockfd;  ///< 监听套接字
+    xntp_cliptr_t     xntp_calib;   ///< 校准请求 所用的 NTP 客户端对象（单个工作通道）
+
+    x_uint32_t        xut_ipv4;     ///< 锁定的 服务端 IPv4 地址（0 表示 尚未锁定）
+    x_uint16_t        xut_port;     ///< 锁定的 服务端 端口号
+    x_uint32_t        xut_stratum;  ///< 锁定的 服务端 层数
+    x_uint64_t        xut_last;     ///< 最近一个 有效报文 的 发送时间戳（剔除 重复 与 过期 的报文）
+    xtime_vnsec_t     xtm_heard;    ///< 最近一次 收到 有效报文 的 单调时钟时间
+    xtime_vnsec_t     xtm_stale;    ///< 服务端 沉默 超过 该时长 后，可锁定 其他服务端
+
+    x_bool_t          xbt_calib;    ///< 是否 已经校准
+    x_int64_t         xit_delay;    ///< 校准所得的 单程时延（100 纳秒）
+    xtime_vnsec_t     xtm_calib;    ///< 最近一次 校准的 单调时钟时间
+
+    xntp_bcast_stat_t xstat;        ///< 统计信息
+} xntp_bcast_t;
+
+//====================================================================
+
+// 
+// 内部辅助函数
+// 
+
+/**********************************************************/
+/**
+ * @brief 返回 最近一次 套接字操作 的 错误码。
+ */
+static x_int32_t ntpbc_sock_errno(x_void_t)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    return (x_int32_t)WSAGetLastError();
+#else // !(defined(_WIN32) || defined(_WIN64))
+    return errno;
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 关闭套接字。
+ */
+static x_void_t ntpbc_sock_close(x_sockfd_t xfdt_sockfd)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    closesocket(xfdt_sockfd);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    close(xfdt_sockfd);
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 四段式 IPv4 地址（返回 网络字节序 的地址）。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；失败，返回 X_FALSE。
+ */
+static x_bool_t ntpbc_parse_ipv4(x_cstring_t xszt_addr, x_uint32_t * xut_addr)
+{
+    struct in_addr xin_addr;
+
+    if (1 != inet_pton(AF_INET, xszt_addr, &xin_addr))
+        return X_FALSE;
+
+    *xut_addr = (x_uint32_t)xin_addr.s_addr;
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 等待 套接字可读，直至 截止时间。
+ *
+ * @return x_int32_t : 可读，返回 0；超时，返回 ETIMEDOUT；失败，返回 错误码。
+ */
+static x_int32_t ntpbc_wait(x_sockfd_t xfdt_sockfd, xtime_vnsec_t xtm_dline)
+{
+    x_int32_t      xit_errno = 0;
+    xtime_vnsec_t  xtm_mono  = 0;
+    fd_set         xfds_rset;
+    struct timeval xtm_value;
+
+    for (;;)
+    {
+        if (XTMVNSEC_IS_VALID(xtm_dline))
+        {
+            // 不足 1 微秒的剩余时间，也视为超时
+            xtm_mono = time_mono();
+            if ((xtm_mono + 10) > xtm_dline)
+                return ETIMEDOUT;
+
+            xtm_mono = xtm_dline - xtm_mono;
+            xtm_value.tv_sec  = (x_long_t)(xtm_mono / XTIME_100NS_BASE);
+            xtm_value.tv_usec = (x_long_t)((xtm_mono % XTIME_100NS_BASE) / 10ULL);
+        }
+
+        FD_ZERO(&xfds_rset);
+        FD_SET(xfdt_sockfd, &xfds_rset);
+
+        xit_errno = select((x_int32_t)(xfdt_sockfd + 1),
+                           &xfds_rset,
+                           X_NULL,
+                           X_NULL,
+                           XTMVNSEC_IS_VALID(xtm_dline) ? &xtm_value : X_NULL);
+        if (xit_errno > 0)
+            return 0;
+
+        if (xit_errno < 0)
+        {
+            xit_errno = ntpbc_sock_errno();
+#if (defined(_WIN32) || defined(_WIN64))
+            if (WSAEINTR != xit_errno)
+#else // !(defined(_WIN32) || defined(_WIN64))
+            if (EINTR != xit_errno)
+#endif // (defined(_WIN32) || defined(_WIN64))
+            {
+                return xit_errno;
+            }
+        }
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 检查 广播报文 的 有效性（模式、版本、层数、飞跃指示、发送时间戳、认证）。
+ *
+ * @return x_bool_t : 有效，返回 X_TRUE；否则返回 X_FALSE。
+ */
+static x_bool_t ntpbc_check(
+                    xntp_bcastptr_t xbc_this,
+                    const xntp_view_t * xview_ptr,
+                    const x_uchar_t * xbt_data)
+{
+    if ((ntp_mode_broadcast != ntpv_mode(xview_ptr)) ||
+        (ntpv_version(xview_ptr) < 3) || (ntpv_version(xview_ptr) > 4) ||
+        (3 == ntpv_leap(xview_ptr)) ||
+        (ntpv_stratum(xview_ptr) < 1) || (ntpv_stratum(xview_ptr) > 15) ||
+        (0 == ntpv_transmit(xview_ptr)))
+    {
+        return X_FALSE;
+    }
+
+    // 要求认证时，报文 须携带 指定 key ID 的 MAC，且 校验通过
+    if (0 != xbc_this->xconf.xut_keyid)
+    {
+        if (!ntpv_has_mac(xview_ptr) ||
+            (xbc_this->xconf.xut_keyid != ntpv_keyid(xview_ptr)) ||
+            (0 != ntpkey_verify(xbc_this->xconf.xkey_table,
+                                xbc_this->xconf.xut_keyid,
+                                xbt_data,
+                                xview_ptr->xut_mpos,
+                                ntpv_digest(xview_ptr),
+                                ntpv_digest_len(xview_ptr))))
+        {
+            return X_FALSE;
+        }
+    }
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 一次 客户端模式 的请求 校准 锁定服务端 的 单程时延（取 往返时延 的一半）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpbc_calibrate(xntp_bcastptr_t xbc_this, xtime_vnsec_t xtm_mono)
+{
+    x_int32_t    xit_errno = 0;
+    x_int64_t    xit_delay = 0;
+    xntp_sweep_t xsw_item;
+
+    memset(&xsw_item, 0, sizeof(xntp_sweep_t));
+    xsw_item.xut_ipv4  = xbc_this->xut_ipv4;
+    xsw_item.xut_port  = xbc_this->xut_port;
+    xsw_item.xut_keyid = xbc_this->xconf.xut_keyid;
+
+    xbc_this->xstat.xut_calibs += 1;
+    xbc_this->xtm_calib = xtm_mono;
+
+    xit_errno = ntpcli_req_sweep(xbc_this->xntp_calib,
+                                 &xsw_item,
+                                 1,
+                                 time_mono() + xbc_this->xconf.xut_tmout * XTIME_VNSEC_MSEC);
+    if (0 == xit_errno)
+        xit_errno = xsw_item.xit_errno;
+    if (0 != xit_errno)
+    {
+        xbc_this->xstat.xut_failed += 1;
+        return xit_errno;
+    }
+
+    // delay = ((T4 - T1) - (T3 - T2)) / 2
+    xit_delay = ((x_int64_t)(xsw_item.xtm_4time[3] - xsw_item.xtm_4time[0]) -
+                 (x_int64_t)(xsw_item.xtm_4time[2] - xsw_item.xtm_4time[1])) / 2;
+
+    xbc_this->xit_delay = (xit_delay > 0) ? xit_delay : 0;
+    xbc_this->xbt_calib = X_TRUE;
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 外部接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 打开 广播/组播 客户端（绑定 监听端口，并 加入组播组）。
+ * @note
+ * 同一主机上 可以有 多个客户端 监听 同一端口（SO_REUSEADDR），各自 收到 每一个 组播报文。
+ *
+ * @param [in ] xconf_ptr : 工作参数。
+ *
+ * @return xntp_bcastptr_t :
+ * 成功，返回 客户端对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_bcastptr_t ntpbc_open(const xntp_bcast_conf_t * xconf_ptr)
+{
+    x_int32_t          xit_errno = 0;
+    x_int32_t          xit_reuse = 1;
+    xntp_bcastptr_t    xbc_this  = X_NULL;
+    struct sockaddr_in xin_addr;
+    struct ip_mreq     xip_mreq;
+
+    if ((X_NULL == xconf_ptr) || (0 == xconf_ptr->xut_port))
+    {
+        errno = EINVAL;
+        return X_NULL;
+    }
+
+    xbc_this = (xntp_bcastptr_t)calloc(1, sizeof(xntp_bcast_t));
+    if (X_NULL == xbc_this)
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    xbc_this->xconf       = *xconf_ptr;
+    xbc_this->xfdt_sockfd = X_INVALID_SOCKFD;
+    xbc_this->xut_group   = htonl(INADDR_ANY);
+    xbc_this->xut_iface   = htonl(INADDR_ANY);
+    xbc_this->xconf.xszt_group = X_NULL;
+    xbc_this->xconf.xszt_iface = X_NULL;
+    if (0 == xbc_this->xconf.xut_tmout)
+        xbc_this->xconf.xut_tmout = XBC_TMOUT_DEF;
+
+    do
+    {
+        //======================================
+        // 参数验证
+
+        if (((X_NULL != xconf_ptr->xszt_group) &&
+             (!ntpbc_parse_ipv4(xconf_ptr->xszt_group, &xbc_this->xut_group) ||
+              !IN_MULTICAST(ntohl(xbc_this->xut_group)))) ||
+            ((X_NULL != xconf_ptr->xszt_iface) &&
+             !ntpbc_parse_ipv4(xconf_ptr->xszt_iface, &xbc_this->xut_iface)))
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        //======================================
+        // 校准请求 所用的 客户端对象
+
+        xbc_this->xntp_calib = ntpcli_open_ex(1);
+        if (X_NULL == xbc_this->xntp_calib)
+        {
+            xit_errno = errno;
+            break;
+        }
+
+        xit_errno = ntpcli_auth(xbc_this->xntp_calib, xconf_ptr->xkey_table, xconf_ptr->xut_keyid);
+        if (0 != xit_errno)
+        {
+            break;
+        }
+
+        //======================================
+        // 监听套接字
+
+        xbc_this->xfdt_sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (X_INVALID_SOCKFD == xbc_this->xfdt_sockfd)
+        {
+            xit_errno = ntpbc_sock_errno();
+            break;
+        }
+
+        setsockopt(xbc_this->xfdt_sockfd, SOL_SOCKET, SO_REUSEADDR,
+                   (const x_char_t *)&xit_reuse, sizeof(x_int32_t));
+
+        memset(&xin_addr, 0, sizeof(struct sockaddr_in));
+        xin_addr.sin_family      = AF_INET;
+        xin_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        xin_addr.sin_port        = htons(xconf_ptr->xut_port);
+        if (0 != bind(xbc_this->xfdt_sockfd, (struct sockaddr *)&xin_addr, sizeof(struct sockaddr_in)))
+        {
+            xit_errno = ntpbc_sock_errno();
+            break;
+        }
+
+        if (X_NULL != xconf_ptr->xszt_group)
+        {
+            xip_mreq.imr_multiaddr.s_addr = xbc_this->xut_group;
+            xip_mreq.imr_interface.s_addr = xbc_this->xut_iface;
+            if (0 != setsockopt(xbc_this->xfdt_sockfd, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                                (const x_char_t *)&xip_mreq, sizeof(struct ip_mreq)))
+            {
+                xit_errno = ntpbc_sock_errno();
+                break;
+            }
+        }
+
+        //======================================
+    } while (0);
+
+    if (0 != xit_errno)
+    {
+        ntpbc_close(xbc_this);
+        errno = xit_errno;
+        return X_NULL;
+    }
+
+    return xbc_this;
+}
+
+/**********************************************************/
+/**
+ * @brief 关闭 广播/组播 客户端（退出组播组）。
+ */
+x_void_t ntpbc_close(xntp_bcastptr_t xbc_this)
+{
+    if (X_NULL == xbc_this)
+    {
+        return;
+    }
+
+    // 关闭 套接字 时，系统 会自动 退出组播组
+    if (X_INVALID_SOCKFD != xbc_this->xfdt_sockfd)
+    {
+        ntpbc_sock_close(xbc_this->xfdt_sockfd);
+        xbc_this->xfdt_sockfd = X_INVALID_SOCKFD;
+    }
+
+    if (X_NULL != xbc_this->xntp_calib)
+    {
+        ntpcli_close(xbc_this->xntp_calib);
+        xbc_this->xntp_calib = X_NULL;
+    }
+
+    free(xbc_this);
+}
+
+/**********************************************************/
+/**
+ * @brief 等待 下一个 有效的 广播报文，返回 其对应的 服务端时间。
+ * @note
+ * 首个有效报文 的 发送方 被锁定 为 服务端，并 立即校准 时延；
+ * 该服务端 沉默 超过 其 轮询间隔 的 4 倍 后，才会 改为 锁定 其他服务端（并 重新校准）。
+ * 首次校准 失败 时 返回 其错误码，下一个报文 到达时 再次尝试；
+ * 周期性的 重新校准 失败 时，沿用 原有的 时延。
+ * 客户端对象 不可被 多个线程 同时调用。
+ *
+ * @param [in ] xbc_this  : 广播/组播 客户端。
+ * @param [out] xres_ptr  : 返回 接收结果。
+ * @param [in ] xtm_dline : 单调时钟（time_mono()）的 截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；截止时间 到达，返回 ETIMEDOUT；校准失败，返回 其错误码；其他失败，返回 错误码。
+ */
+x_int32_t ntpbc_recv(
+                xntp_bcastptr_t xbc_this,
+                xntp_bcast_result_t * xres_ptr,
+                xtime_vnsec_t xtm_dline)
+{
+    x_int32_t          xit_errno = 0;
+    x_int32_t          xit_dlen  = 0;
+    x_int32_t          xit_poll  = 0;
+    x_uint32_t         xut_ipv4  = 0;
+    x_uint16_t         xut_port  = 0;
+    x_uint64_t         xut_xmt   = 0;
+    x_bool_t           xbt_calib = X_FALSE;
+    xtime_vnsec_t      xtm_T4    = 0;
+    xtime_vnsec_t      xtm_mono  = 0;
+    xntp_view_t        xview_pk;
+    x_uchar_t          xbt_pack[XNTP_PKT_MAX + 4];
+    struct sockaddr_in xin_addr;
+#if (defined(_WIN32) || defined(_WIN64))
+    x_int32_t          xit_alen  = 0;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen  = 0;
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    if ((X_NULL == xbc_this) || (X_NULL == xres_ptr))
+    {
+        return EINVAL;
+    }
+
+    for (;;)
+    {
+        //======================================
+        // 接收 一个 报文
+
+        xit_errno = ntpbc_wait(xbc_this->xfdt_sockfd, xtm_dline);
+        if (0 != xit_errno)
+        {
+            return xit_errno;
+        }
+
+        xit_alen = sizeof(struct sockaddr_in);
+        xit_dlen = (x_int32_t)recvfrom(xbc_this->xfdt_sockfd,
+                                       (x_char_t *)xbt_pack,
+                                       sizeof(xbt_pack),
+                                       0,
+                                       (struct sockaddr *)&xin_addr,
+                                       &xit_alen);
+        xtm_T4   = time_vnsec();
+        xtm_mono = time_mono();
+
+        if (xit_dlen < 0)
+        {
+            continue;
+        }
+
+        xbc_this->xstat.xut_packets += 1;
+
+        // 缓存 比 XNTP_PKT_MAX 多留几个字节，被截断的 超长报文 因而会被判为 EMSGSIZE
+        if ((0 != ntpv_init(&xview_pk, xbt_pack, xit_dlen)) ||
+            !ntpbc_check(xbc_this, &xview_pk, xbt_pack))
+        {
+            xbc_this->xstat.xut_rejects += 1;
+            continue;
+        }
+
+        xut_ipv4 = ntohl(xin_addr.sin_addr.s_addr);
+        xut_port = ntohs(xin_addr.sin_port);
+        xut_xmt  = ntpv_transmit(&xview_pk);
+
+        //======================================
+        // 锁定 服务端：只接受 锁定服务端 的报文，直到 其沉默 过久
+
+        if ((xut_ipv4 != xbc_this->xut_ipv4) || (xut_port != xbc_this->xut_port))
+        {
+            if ((0 != xbc_this->xut_ipv4) && ((xtm_mono - xbc_this->xtm_heard) < xbc_this->xtm_stale))
+            {
+                xbc_this->xstat.xut_rejects += 1;
+                continue;
+            }
+
+            xbc_this->xut_ipv4  = xut_ipv4;
+            xbc_this->xut_port  = xut_port;
+            xbc_this->xut_last  = 0;
+            xbc_this->xbt_calib = X_FALSE;
+        }
+        else if ((x_int64_t)(xut_xmt - xbc_this->xut_last) <= 0)
+        {
+            // 重复 或 过期 的报文（发送时间戳 未增长）
+            xbc_this->xstat.xut_rejects += 1;
+            continue;
+        }
+
+        xit_poll = ntpv_poll(&xview_pk);
+        xit_poll = (xit_poll < XBC_POLL_MIN) ? XBC_POLL_MIN : ((xit_poll > XBC_POLL_MAX) ? XBC_POLL_MAX : xit_poll);
+
+        xbc_this->xut_last    = xut_xmt;
+        xbc_this->xut_stratum = ntpv_stratum(&xview_pk);
+        xbc_this->xtm_heard   = xtm_mono;
+        xbc_this->xtm_stale   = (XBC_STALE_POLLS * XTIME_100NS_BASE) << xit_poll;
+
+        //======================================
+        // 校准：锁定服务端 之后 首个报文，或 重新校准 的 周期已到
+
+        xbt_calib = X_FALSE;
+        if (!xbc_this->xbt_calib ||
+            ((0 != xbc_this->xconf.xut_recal) &&
+             ((xtm_mono - xbc_this->xtm_calib) >= (xbc_this->xconf.xut_recal * XTIME_VNSEC_MSEC))))
+        {
+            xit_errno = ntpbc_calibrate(xbc_this, xtm_mono);
+            if (!xbc_this->xbt_calib)
+            {
+                return xit_errno;
+            }
+
+            xbt_calib = (0 == xit_errno);
+        }
+
+        break;
+    }
+
+    //======================================
+
+    xres_ptr->xut_ipv4    = xbc_this->xut_ipv4;
+    xres_ptr->xut_port    = xbc_this->xut_port;
+    xres_ptr->xut_stratum = xbc_this->xut_stratum;
+    xres_ptr->xbt_calib   = xbt_calib;
+    xres_ptr->xit_delay   = xbc_this->xit_delay;
+    xres_ptr->xtm_local   = xtm_T4;
+    xres_ptr->xtm_vnsec   = ntp_stamp_to_vnsec(xut_xmt, ntp_era_seconds(xtm_T4)) + (xtime_vnsec_t)xbc_this->xit_delay;
+    xres_ptr->xit_offset  = (x_int64_t)(xres_ptr->xtm_vnsec - xtm_T4);
+
+    xbc_this->xstat.xut_updates += 1;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 要求 下一个 有效的 广播报文 到达时 重新校准 时延。
+ */
+x_void_t ntpbc_recal(xntp_bcastptr_t xbc_this)
+{
+    if (X_NULL != xbc_this)
+    {
+        xbc_this->xbt_calib = X_FALSE;
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 获取 统计信息。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpbc_stat(xntp_bcastptr_t xbc_this, xntp_bcast_stat_t * xstat_ptr)
+{
+    if ((X_NULL == xbc_this) || (X_NULL == xstat_ptr))
+    {
+        return EINVAL;
+    }
+
+    *xstat_ptr = xbc_this->xstat;
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,166 @@
+﻿/**
+ * @file ntp_bcast.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 广播/组播 客户端（被动接收 服务端 周期发送的 时间）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_BCAST_H__
+#define __NTP_BCAST_H__
+
+#include "ntp_client.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * 广播/组播 客户端 只监听 服务端 以 广播模式（ntp_mode_broadcast）周期发送的 报文：
+ * 锁定 首个 有效的 服务端 后，先以 一次 客户端模式 的请求 校准 网络时延，
+ * 此后 每收到一个 广播报文，即以 其 发送时间戳 加 单程时延 得到 服务端时间，
+ * 不再发出 任何请求（直到 重新校准 或 更换服务端）。
+ */
+
+/** NTP 组播 的 IANA 分配地址 */
+#define NTP_MCAST_GROUP     "224.0.1.1"
+
+/** 定义 广播/组播 客户端 的 指针类型 */
+typedef struct xntp_bcast_t * xntp_bcastptr_t;
+
+/**
+ * @struct xntp_bcast_conf_t
+ * @brief  广播/组播 客户端 的 工作参数。
+ */
+typedef struct xntp_bcast_conf_t
+{
+    x_cstring_t   xszt_group;   ///< 组播组 地址（如 NTP_MCAST_GROUP）；取 X_NULL 时，接收 广播
+    x_cstring_t   xszt_iface;   ///< 加入组播组 所用的 本地接口 IPv4 地址（取 X_NULL 时，由系统选择）
+    x_uint16_t    xut_port;     ///< 监听的 端口号（一般为 NTP_PORT）
+    x_uint32_t    xut_tmout;    ///< 校准请求 的 超时时间（毫秒，取 0 时 为 3000）
+    x_uint32_t    xut_recal;    ///< 重新校准 的 周期（毫秒，取 0 时 只在 锁定服务端 时 校准一次）
+    xntp_keyptr_t xkey_table;   ///< 认证 所用的 密钥表（可为 X_NULL）
+    x_uint32_t    xut_keyid;    ///< 广播报文 与 校准请求 所用的 key ID（取 0 时 不认证）
+} xntp_bcast_conf_t;
+
+/**
+ * @struct xntp_bcast_result_t
+ * @brief  一次 广播报文 的 接收结果。
+ */
+typedef struct xntp_bcast_result_t
+{
+    x_uint32_t    xut_ipv4;     ///< 服务端的 IPv4 地址（主机字节序）
+    x_uint16_t    xut_port;     ///< 服务端的 端口号
+    x_uint32_t    xut_stratum;  ///< 服务端的 层数
+    x_bool_t      xbt_calib;    ///< 本次接收 是否 进行了 校准（发出了 一次 客户端模式 的请求）
+    x_int64_t     xit_delay;    ///< 校准所得的 单程时延（单位为 100 纳秒）
+    x_int64_t     xit_offset;   ///< 本地时钟 相对于 服务端 的偏差（单位为 100 纳秒）
+    xtime_vnsec_t xtm_local;    ///< 收到 广播报文 时的 本地时间戳
+    xtime_vnsec_t xtm_vnsec;    ///< 收到 广播报文 时 对应的 服务端时间戳（发送时间戳 + 单程时延）
+} xntp_bcast_result_t;
+
+/**
+ * @struct xntp_bcast_stat_t
+ * @brief  广播/组播 客户端 的 统计信息。
+ */
+typedef struct xntp_bcast_stat_t
+{
+    x_uint64_t xut_packets;  ///< 收到的 报文 数量
+    x_uint64_t xut_updates;  ///< 有效的 广播报文（即 时间更新）数量
+    x_uint64_t xut_rejects;  ///< 被丢弃的 报文 数量（模式、层数、认证 不符，或 重复、过期 的报文）
+    x_uint64_t xut_calibs;   ///< 校准 的 次数（即 发出的 请求数量）
+    x_uint64_t xut_failed;   ///< 校准失败 的 次数
+} xntp_bcast_stat_t;
+
+/**********************************************************/
+/**
+ * @brief 打开 广播/组播 客户端（绑定 监听端口，并 加入组播组）。
+ * @note
+ * 同一主机上 可以有 多个客户端 监听 同一端口（SO_REUSEADDR），各自 收到 每一个 组播报文。
+ *
+ * @param [in ] xconf_ptr : 工作参数。
+ *
+ * @return xntp_bcastptr_t :
+ * 成功，返回 客户端对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_bcastptr_t ntpbc_open(const xntp_bcast_conf_t * xconf_ptr);
+
+/**********************************************************/
+/**
+ * @brief 关闭 广播/组播 客户端（退出组播组）。
+ */
+x_void_t ntpbc_close(xntp_bcastptr_t xbc_this);
+
+/**********************************************************/
+/**
+ * @brief 等待 下一个 有效的 广播报文，返回 其对应的 服务端时间。
+ * @note
+ * 首个有效报文 的 发送方 被锁定 为 服务端，并 立即校准 时延；
+ * 该服务端 沉默 超过 其 轮询间隔 的 4 倍 后，才会 改为 锁定 其他服务端（并 重新校准）。
+ * 首次校准 失败 时 返回 其错误码，下一个报文 到达时 再次尝试；
+ * 周期性的 重新校准 失败 时，沿用 原有的 时延。
+ * 客户端对象 不可被 多个线程 同时调用。
+ *
+ * @param [in ] xbc_this  : 广播/组播 客户端。
+ * @param [out] xres_ptr  : 返回 接收结果。
+ * @param [in ] xtm_dline : 单调时钟（time_mono()）的 截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；截止时间 到达，返回 ETIMEDOUT；校准失败，返回 其错误码；其他失败，返回 错误码。
+ */
+x_int32_t ntpbc_recv(
+                xntp_bcastptr_t xbc_this,
+                xntp_bcast_result_t * xres_ptr,
+                xtime_vnsec_t xtm_dline);
+
+/**********************************************************/
+/**
+ * @brief 要求 下一个 有效的 广播报文 到达时 重新校准 时延。
+ */
+x_void_t ntpbc_recal(xntp_bcastptr_t xbc_this);
+
+/**********************************************************/
+/**
+ * @brief 获取 统计信息。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpbc_stat(xntp_bcastptr_t xbc_this, xntp_bcast_stat_t * xstat_ptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_BCAST_H__
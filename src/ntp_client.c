@@ -31,6 +31,12 @@
  */
 
 #include "ntp_client.h"
+#include "ntp_auth.h"
+#include "ntp_nts.h"
+#include "xuring.h"
+#include "xatomic.h"
+#include "ntp_packet.h"
+#include "ntp_state.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -51,6 +57,7 @@
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <netdb.h>
+#include <time.h>
 #else // UNKNOW
 #error "unknow platform!"
 #endif // PLATFORM
@@ -64,150 +71,6 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-//====================================================================
-
-// 
-// 内部相关数据类型与常量
-// 
-
-/**
- * @struct xtime_stamp_t
- * @brief  NTP所使用的时间戳。
- */
-typedef struct xtime_stamp_t
-{
-    x_uint32_t xut_seconds;  ///< 从 1900年至今所经过的秒数
-    x_uint32_t xut_fraction; ///< 小数部份，其单位是 百纳秒数 的 (2^32 / 10^7) 倍
-} xtime_stamp_t;
-
-/**
- * 1900-01-01 00:00:00 ~ 1970-01-01 00:00:00 之间的时间 秒数。
- * Time of day conversion constant.  Ntp's time scale starts in 1900,
- * Unix in 1970.  The value is 1970 - 1900 in seconds, 0x83aa7e80 or
- * 2208988800.  This is larger than 32-bit INT_MAX, so unsigned
- * type is forced.
- */
-#define XTIME_SEC_1900_1970 0x83AA7E80
-
-/** 百纳秒 的进位基数 10^7 */
-#define XTIME_100NS_BASE    10000000ULL
-
-/** 将 时间计量值 转为 NTP 时间戳 */
-#define XTIME_UTOS(xvnsec, xstamp)                                                                  \
-do                                                                                                  \
-{                                                                                                   \
-    (xstamp).xut_seconds  = (x_uint32_t)((((xvnsec) / XTIME_100NS_BASE) + XTIME_SEC_1900_1970));    \
-    (xstamp).xut_fraction = (x_uint32_t)((((xvnsec) % XTIME_100NS_BASE) << 32) / XTIME_100NS_BASE); \
-} while (0)
-
-/** 将 NTP 时间戳 转为 时间计量值 */
-#define XTIME_STOU(xstamp, xvnsec)                                                     \
-do                                                                                     \
-{                                                                                      \
-    if (((xstamp).xut_seconds) > XTIME_SEC_1900_1970)                                  \
-        (xvnsec) = (((xstamp).xut_seconds - XTIME_SEC_1900_1970) * XTIME_100NS_BASE) + \
-                    (((xstamp).xut_fraction * XTIME_100NS_BASE) >> 32);                \
-    else                                                                               \
-        (xvnsec) = XTIME_INVALID_VNSEC;                                                \
-} while (0)
-
-/**
- * @enum  xntp_mode_t
- * @brief NTP工作模式的相关枚举值。
- */
-typedef enum xntp_mode_t
-{
-    ntp_mode_unknow     = 0,  ///< 未定义
-    ntp_mode_initiative = 1,  ///< 主动对等体模式
-    ntp_mode_passive    = 2,  ///< 被动对等体模式
-    ntp_mode_client     = 3,  ///< 客户端模式
-    ntp_mode_server     = 4,  ///< 服务器模式
-    ntp_mode_broadcast  = 5,  ///< 广播模式或组播模式
-    ntp_mode_control    = 6,  ///< 报文为 NTP 控制报文
-    ntp_mode_reserved   = 7,  ///< 预留给内部使用
-} xntp_mode_t;
-
-/**
- * @struct xntp_pack_t
- * @brief  NTP 报文格式。
- */
-typedef struct xntp_pack_t
-{
-#if 1
-
-    x_uchar_t     xct_lvmflag  ;  ///< 2 bits，飞跃指示器；3 bits，版本号；3 bits，NTP工作模式（参看 xntp_mode_t 相关枚举值）
-    x_uchar_t     xct_stratum  ;  ///< 系统时钟的层数，取值范围为1~16，它定义了时钟的准确度。层数为1的时钟准确度最高，准确度从1到16依次递减，层数为16的时钟处于未同步状态，不能作为参考时钟
-    x_uchar_t     xct_ppoll    ;  ///< 轮询时间，即两个连续NTP报文之间的时间间隔
-    x_char_t      xct_percision;  ///< 系统时钟的精度
-
-    x_uint32_t    xut_rootdelay;  ///< 本地到主参考时钟源的往返时间
-    x_uint32_t    xut_rootdisp ;  ///< 系统时钟相对于主参考时钟的最大误差
-    x_uint32_t    xut_refid    ;  ///< 参考时钟源的标识
-
-    /**
-     * T1，客户端发送请求时的 本地系统时间戳；
-     * T2，服务端接收到客户端请求时的 本地系统时间戳；
-     * T3，服务端发送应答数据包时的 本地系统时间戳；
-     * T4，客户端接收到服务端应答数据包时的 本地系统时间戳。
-     */
-    xtime_stamp_t xtms_reference; ///< 系统时钟最后一次被设定或更新的时间
-    xtime_stamp_t xtms_originate; ///< 服务端应答时，将客户端请求时的 T1 返送回去
-    xtime_stamp_t xtms_receive  ; ///< 服务端接收到客户端请求时的 本地系统时间戳 T2
-    xtime_stamp_t xtms_transmit ; ///< 客户端请求时 发送 T1，服务端应答时 回复 T3
-
-#else
-
-    x_uchar_t     xct_lvmflag;    ///< peer leap indicator: leap, version, mode
-    x_uchar_t     xct_stratum;    ///< peer stratum
-    x_uchar_t     xct_ppoll;      ///< peer poll interval
-    x_char_t      xct_precision;  ///< peer clock precision
-    x_uint32_t    xut_rootdelay;  ///< roundtrip delay to primary source
-    x_uint32_t    xut_rootdisp;   ///< dispersion to primary sourc
-    x_uint32_t    xut_refid;      ///< reference id
-    xtime_stamp_t xtms_reference; ///< last update time
-    xtime_stamp_t xtms_originate; ///< originate time stamp
-    xtime_stamp_t xtms_receive  ; ///< receive time stamp
-    xtime_stamp_t xtms_transmit ; ///< transmit time stamp
-
-/** max extension field size */
-#define NTP_MAXEXTEN   2048
-
-#define	MIN_V4_PKT_LEN (12 * sizeof(u_int32))    ///< min header length
-#define	LEN_PKT_NOMAC  (12 * sizeof(u_int32))    ///< min header length
-#define	MIN_MAC_LEN    (1 * sizeof(u_int32))     ///< crypto_NAK
-#define	MAX_MD5_LEN    (5 * sizeof(u_int32))     ///< MD5
-#define	MAX_MAC_LEN    (6 * sizeof(u_int32))     ///< SHA
-#define	KEY_MAC_LEN    sizeof(u_int32)           ///< key ID in MAC
-#define	MAX_MDG_LEN    (MAX_MAC_LEN-KEY_MAC_LEN) ///< max. digest len
-
-    /**
-     * The length of the packet less MAC must be a multiple of 64
-     * with an RSA modulus and Diffie-Hellman prime of 256 octets
-     * and maximum host name of 128 octets, the maximum autokey
-     * command is 152 octets and maximum autokey response is 460
-     * octets. A packet can contain no more than one command and one
-     * response, so the maximum total extension field length is 864
-     * octets. But, to handle humungus certificates, the bank must
-     * be broke.
-     * 
-     * The different definitions of the 'exten' field are here for
-     * the benefit of applications that want to send a packet from
-     * an auto variable in the stack - not using the AUTOKEY version
-     * saves 2KB of stack space. The receive buffer should ALWAYS be
-     * big enough to hold a full extended packet if the extension
-     * fields have to be parsed or skipped.
-     */
-#ifdef AUTOKEY
-	x_uint32_t	xut_exten[(NTP_MAXEXTEN + MAX_MAC_LEN) / sizeof(x_uint32_t)];
-#else // !AUTOKEY follows
-	x_uint32_t	xut_exten[(MAX_MAC_LEN) / sizeof(x_uint32_t)];
-#endif // !AUTOKEY
-
-#endif
-} xntp_pack_t;
-
-////////////////////////////////////////////////////////////////////////////////
-
 // 
 // 定义相关的调试信息输出接口
 // 
@@ -238,11 +101,9 @@ static x_void_t output_ns(xtime_vnsec_t xtm_vnsec)
 /**
  * @brief 输出 NTP 时间戳 的 具体时间信息。
  */
-static x_void_t output_ts(xtime_stamp_t * xtm_stamp)
+static x_void_t output_ts(x_uint64_t xut_stamp)
 {
-    xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
-    XTIME_STOU(*xtm_stamp, xtm_vnsec);
-    output_ns(xtm_vnsec);
+    output_ns(ntp_stamp_to_vnsec(xut_stamp, ntp_era_seconds(time_vnsec())));
 }
 
 /**********************************************************/
@@ -260,10 +121,10 @@ static x_void_t output_tu(x_cstring_t xszt_info, xtime_vnsec_t xtm_vnsec)
 /**
  * @brief 打上信息标号，输出 NTP 时间戳 的 具体时间信息。
  */
-static x_void_t output_tm(x_cstring_t xszt_info, xtime_stamp_t * xtm_stamp)
+static x_void_t output_tm(x_cstring_t xszt_info, x_uint64_t xut_stamp)
 {
     printf("%s : ", xszt_info);
-    output_ts(xtm_stamp);
+    output_ts(xut_stamp);
     printf("\n");
 }
 
@@ -450,94 +311,97 @@ static x_int32_t sockfd_close(x_sockfd_t xfdt_sockfd)
 #endif // (defined(_WIN32) || defined(_WIN64))
 }
 
-////////////////////////////////////////////////////////////////////////////////
-
-// 
-// NTP 相关辅助操作的接口
-// 
-
 /**********************************************************/
 /**
- * @brief 初始化 NTP 的请求数据包。
+ * @brief 判断套接字操作失败的错误码，是否为 可重试 的暂时性错误（如 EAGAIN、EINTR）。
  */
-static x_void_t ntp_init_req_packet(xntp_pack_t * xnpt_dptr)
+static x_bool_t sockfd_retry(x_int32_t xit_errno)
 {
-/*
- * Stuff for putting things back into li_vn_mode in packets and vn_mode
- * in ntp_monitor.c's mon_entry.
- */
-#define NTP_VN_MODE(v, m)		((((v) & 7) << 3) | ((m) & 0x7))
-#define	NTP_LI_VN_MODE(l, v, m) ((((l) & 3) << 6) | NTP_VN_MODE((v), (m)))
+#if (defined(_WIN32) || defined(_WIN64))
+    return ((WSAEWOULDBLOCK == xit_errno) || (WSAEINTR == xit_errno));
+#else // !(defined(_WIN32) || defined(_WIN64))
+    return ((EAGAIN == xit_errno) || (EWOULDBLOCK == xit_errno) || (EINTR == xit_errno));
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
 
-    xnpt_dptr->xct_lvmflag   = NTP_LI_VN_MODE(0, 3, ntp_mode_client);
-    xnpt_dptr->xct_stratum   = 0;
-    xnpt_dptr->xct_ppoll     = 4;
-    xnpt_dptr->xct_percision = (x_char_t)(-6);
+////////////////////////////////////////////////////////////////////////////////
 
-    xnpt_dptr->xut_rootdelay = (1 << 16);
-    xnpt_dptr->xut_rootdisp  = (1 << 16);
-    xnpt_dptr->xut_refid     = 0;
+//
+// 截止时间（deadline）相关辅助操作的接口
+//
 
-    xnpt_dptr->xtms_reference.xut_seconds  = 0;
-    xnpt_dptr->xtms_reference.xut_fraction = 0;
-    xnpt_dptr->xtms_originate.xut_seconds  = 0;
-    xnpt_dptr->xtms_originate.xut_fraction = 0;
-    xnpt_dptr->xtms_receive  .xut_seconds  = 0;
-    xnpt_dptr->xtms_receive  .xut_fraction = 0;
-    xnpt_dptr->xtms_transmit .xut_seconds  = 0;
-    xnpt_dptr->xtms_transmit .xut_fraction = 0;
+/**********************************************************/
+/**
+ * @brief 将 超时时间（毫秒）转换为 单调时钟 的 截止时间。
+ *
+ * @param [in ] xut_tmout : 超时时间（单位为 毫秒），取 0 时表示无限等待。
+ *
+ * @return xtime_vnsec_t :
+ * 返回 截止时间；无限等待时，返回 XTIME_INVALID_VNSEC。
+ */
+static xtime_vnsec_t ntp_tmout_dline(x_uint32_t xut_tmout)
+{
+    if (0 == xut_tmout)
+        return XTIME_INVALID_VNSEC;
+    return (time_mono() + xut_tmout * XTIME_VNSEC_MSEC);
 }
 
 /**********************************************************/
 /**
- * @brief 将 xntp_pack_t 中的 网络字节序 字段转换为 主机字节序。
+ * @brief 计算距离 截止时间 的剩余时间，用于 select() 的超时参数。
+ *
+ * @param [in ] xtm_dline : 单调时钟的截止时间（XTIME_INVALID_VNSEC 表示无限等待）。
+ * @param [out] xtm_value : 操作成功时，返回剩余的时间。
+ *
+ * @return x_int32_t :
+ * 返回 0，表示 xtm_value 有效；返回 ETIMEDOUT，表示已超时；
+ * 返回 EAGAIN，表示无限等待（此时 xtm_value 无效）。
  */
-static x_void_t ntp_ntoh_packet(xntp_pack_t * xnpt_nptr)
+static x_int32_t ntp_dline_remain(xtime_vnsec_t xtm_dline, struct timeval * xtm_value)
 {
-#if 0
-    xnpt_nptr->xct_lvmflag   = xnpt_nptr->xct_lvmflag  ;
-    xnpt_nptr->xct_stratum   = xnpt_nptr->xct_stratum  ;
-    xnpt_nptr->xct_ppoll     = xnpt_nptr->xct_ppoll    ;
-    xnpt_nptr->xct_percision = xnpt_nptr->xct_percision;
-#endif
-    xnpt_nptr->xut_rootdelay               = ntohl(xnpt_nptr->xut_rootdelay              );
-    xnpt_nptr->xut_rootdisp                = ntohl(xnpt_nptr->xut_rootdisp               );
-    xnpt_nptr->xut_refid                   = ntohl(xnpt_nptr->xut_refid                  );
-    xnpt_nptr->xtms_reference.xut_seconds  = ntohl(xnpt_nptr->xtms_reference.xut_seconds );
-    xnpt_nptr->xtms_reference.xut_fraction = ntohl(xnpt_nptr->xtms_reference.xut_fraction);
-    xnpt_nptr->xtms_originate.xut_seconds  = ntohl(xnpt_nptr->xtms_originate.xut_seconds );
-    xnpt_nptr->xtms_originate.xut_fraction = ntohl(xnpt_nptr->xtms_originate.xut_fraction);
-    xnpt_nptr->xtms_receive  .xut_seconds  = ntohl(xnpt_nptr->xtms_receive  .xut_seconds );
-    xnpt_nptr->xtms_receive  .xut_fraction = ntohl(xnpt_nptr->xtms_receive  .xut_fraction);
-    xnpt_nptr->xtms_transmit .xut_seconds  = ntohl(xnpt_nptr->xtms_transmit .xut_seconds );
-    xnpt_nptr->xtms_transmit .xut_fraction = ntohl(xnpt_nptr->xtms_transmit .xut_fraction);
+    xtime_vnsec_t xtm_mono = XTIME_INVALID_VNSEC;
+
+    if (!XTMVNSEC_IS_VALID(xtm_dline))
+    {
+        return EAGAIN;
+    }
+
+    // 不足 1 微秒的剩余时间，也视为超时
+    xtm_mono = time_mono();
+    if ((xtm_mono + 10) > xtm_dline)
+    {
+        return ETIMEDOUT;
+    }
+
+    xtm_mono = xtm_dline - xtm_mono;
+    xtm_value->tv_sec  = (x_long_t)(xtm_mono / XTIME_100NS_BASE);
+    xtm_value->tv_usec = (x_long_t)((xtm_mono % XTIME_100NS_BASE) / 10ULL);
+
+    return 0;
 }
 
 /**********************************************************/
 /**
- * @brief 将 xntp_pack_t 中的 主机字节序 字段转换为 网络字节序。
+ * @brief 休眠指定时长（单位为 100 纳秒）。
  */
-static x_void_t ntp_hton_packet(xntp_pack_t * xnpt_nptr)
+static x_void_t ntp_sleep(xtime_vnsec_t xtm_vnsec)
 {
-#if 0
-    xnpt_nptr->xct_lvmflag   = xnpt_nptr->xct_lvmflag  ;
-    xnpt_nptr->xct_stratum   = xnpt_nptr->xct_stratum  ;
-    xnpt_nptr->xct_ppoll     = xnpt_nptr->xct_ppoll    ;
-    xnpt_nptr->xct_percision = xnpt_nptr->xct_percision;
-#endif
-    xnpt_nptr->xut_rootdelay               = htonl(xnpt_nptr->xut_rootdelay              );
-    xnpt_nptr->xut_rootdisp                = htonl(xnpt_nptr->xut_rootdisp               );
-    xnpt_nptr->xut_refid                   = htonl(xnpt_nptr->xut_refid                  );
-    xnpt_nptr->xtms_reference.xut_seconds  = htonl(xnpt_nptr->xtms_reference.xut_seconds );
-    xnpt_nptr->xtms_reference.xut_fraction = htonl(xnpt_nptr->xtms_reference.xut_fraction);
-    xnpt_nptr->xtms_originate.xut_seconds  = htonl(xnpt_nptr->xtms_originate.xut_seconds );
-    xnpt_nptr->xtms_originate.xut_fraction = htonl(xnpt_nptr->xtms_originate.xut_fraction);
-    xnpt_nptr->xtms_receive  .xut_seconds  = htonl(xnpt_nptr->xtms_receive  .xut_seconds );
-    xnpt_nptr->xtms_receive  .xut_fraction = htonl(xnpt_nptr->xtms_receive  .xut_fraction);
-    xnpt_nptr->xtms_transmit .xut_seconds  = htonl(xnpt_nptr->xtms_transmit .xut_seconds );
-    xnpt_nptr->xtms_transmit .xut_fraction = htonl(xnpt_nptr->xtms_transmit .xut_fraction);
+#if (defined(_WIN32) || defined(_WIN64))
+    Sleep((DWORD)((xtm_vnsec + XTIME_VNSEC_MSEC - 1) / XTIME_VNSEC_MSEC));
+#else // !(defined(_WIN32) || defined(_WIN64))
+    struct timespec xtm_value;
+    xtm_value.tv_sec  = (time_t)(xtm_vnsec / XTIME_100NS_BASE);
+    xtm_value.tv_nsec = (long)((xtm_vnsec % XTIME_100NS_BASE) * 100ULL);
+    nanosleep(&xtm_value, X_NULL);
+#endif // (defined(_WIN32) || defined(_WIN64))
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// NTP 相关辅助操作的接口
+// 
+
 /**********************************************************/
 /**
  * @brief 计算最后的结果，公式：T = T4 + ((T2 - T1) + (T3 - T4)) / 2;
@@ -566,439 +430,3818 @@ static xtime_vnsec_t ntp_calc_4T(xtime_vnsec_t xtm_4time[4])
  * @struct xntp_client_t
  * @brief  NTP 客户端工作对象的结构体描述信息。
  */
+/**
+ * @struct xntp_lane_t
+ * @brief  NTP 客户端的 工作通道（独占一个缓存行）。
+ * @note
+ * 每个通道持有一个 套接字，同一时刻只能被一个线程占用（xut_busy 以 CAS 置位）；
+ * 多个线程共用同一 客户端对象 时，各自占用不同的通道，请求过程互不干扰，且无需加锁。
+ */
+typedef struct xntp_lane_t
+{
+    x_sockfd_t xfdt_sockfd;     ///< 网络通信使用的 套接字（首次占用时创建）
+    x_uint32_t xut_busy;        ///< 通道是否已被占用
+} xntp_lane_t;
+
+/** 单个 客户端对象 的 最大通道数量 */
+#define XNTP_LANE_MAX   64
+
+/** 每个通道所占用的 字节数 */
+#define XNTP_LANE_SIZE  XCACHE_ALIGN(sizeof(xntp_lane_t))
+
 typedef struct xntp_client_t
 {
-    x_sockfd_t    xfdt_sockfd;              ///< 网络通信使用的 套接字
     x_char_t      xszt_host[TEXT_LEN_256];  ///< 存储提供 NTP 服务的 服务端 地址
     x_uint16_t    xut_port;                 ///< 存储提供 NTP 服务的 服务端 端口号
-    xtime_vnsec_t xtm_4time[4];             ///< 完成 NTP 请求后，所得到的 4 个相关时间戳
+    x_uint32_t    xut_lanes;                ///< 工作通道 的 数量
+    x_bptr_t      xbt_lanes;                ///< 工作通道 的 存储区（紧随本结构体之后，按缓存行对齐）
+    xntp_keyptr_t xkey_table;               ///< 认证所用的 密钥表（参看 ntpcli_auth()）
+    x_uint32_t    xut_keyid;                ///< 认证所用的 key ID（取 0 时 不认证）
+    xntp_ntsptr_t xnts_sess;                ///< NTS 会话（参看 ntpcli_nts()，设置后 取代 对称密钥认证）
+    xntp_leapptr_t  xleap_tab;              ///< 闰秒表（参看 ntpcli_leap()）
+    xntp_leapmode_t xit_leapmode;           ///< 闰秒的处理方式
+    x_uint32_t      xut_leap;               ///< 最近一次 应答的 LI（原子读写）
+    xntp_leapplan_t xleap_plan;             ///< 当前的 闰秒计划（原子读写）
+    x_bool_t      xbt_clock;                ///< 是否以 请求结果 校准 TSC 时钟（参看 ntpcli_clock()）
+    xntp_shmptr_t xshm_pub;                 ///< 发布 请求结果 的 共享内存段（参看 ntpcli_publish()）
+    x_char_t      xszt_state[TEXT_LEN_256]; ///< 热启动状态文件 的 路径（空串 表示 不保存，参看 ntpcli_state()）
+    x_uint32_t    xut_saved;                ///< 最近一次 保存状态 的 时刻（单调时钟 的 秒数 加 1，0 表示 尚未保存）
+    x_uint32_t    xut_aseqn;                ///< 地址缓存 的 序列号（奇数 表示 正在更新）
+    x_uint32_t    xut_naddr;                ///< 地址缓存：xszt_host 解析所得的 地址数量（0 表示 没有缓存）
+    x_uint32_t    xut_addrs[XNTP_STATE_ADDRS]; ///< 地址缓存：IPv4 地址（主机字节序，首项 为 最近一次 成功请求 的 地址）
+    xtime_vnsec_t xtm_aexpire;              ///< 地址缓存 的 过期时刻（UTC）
+    x_uint32_t    xut_iburst;               ///< 快速初始同步：0 未开启，1 下一次请求 突发，2 已完成（参看 ntpcli_iburst()）
+    x_uint32_t    xut_hbudget;              ///< 对冲请求 的 预算（千分比，0 表示 不开启，参看 ntpcli_hedge()）
+    x_uint32_t    xut_htoken;               ///< 对冲请求 的 令牌（XNTP_HEDGE_TOKEN 为 一次 对冲请求）
+    x_uint32_t    xut_hreqs;                ///< 可对冲的 请求 数量
+    x_uint32_t    xut_hsent;                ///< 额外发出的 对冲请求 数量
+    x_uint32_t    xut_hwins;                ///< 对冲请求 先于 主请求 得到 有效应答 的 次数
+    xntp_rtt_t    xrtt_list[XNTP_STATE_ADDRS]; ///< 各个 地址 的 往返时延 统计（各字段 原子读写）
+    x_bool_t      xbt_pooled;               ///< 是否为 线程私有对象池 中的对象
+    xntp_cliptr_t xntp_next;                ///< 对象池 空闲链表 的 后继节点
 } xntp_client_t;
 
+/** 客户端对象 的 头部 所占用的 字节数 */
+#define XNTP_HEAD_SIZE  XCACHE_ALIGN(sizeof(xntp_client_t))
+
+/** 访问 客户端对象 的 第 xindex 个工作通道 */
+#define XNTP_LANE(xntp, xindex) \
+    ((xntp_lane_t *)((xntp)->xbt_lanes + (x_size_t)(xindex) * XNTP_LANE_SIZE))
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 批量请求（sweep）的 传输流程
+// 
+
+/** 请求项数量不超过该值时，直接线性查找，不建立索引表 */
+#define XSWEEP_LINEAR   8
+
+/** io_uring 后端，每准备好该数量的 发送请求 即提交一次（以减小 T1 与 实际发送时刻 的偏差） */
+#define XSWEEP_CHUNK    16
+
+/** 判断 请求项 是否已发送，且仍在等待应答 */
+#define XSWEEP_PENDING(xsw) \
+    (XTMVNSEC_IS_VALID((xsw)->xtm_4time[0]) && !XTMVNSEC_IS_VALID((xsw)->xtm_4time[3]))
+
+/**
+ * @struct xntp_sweep_ctx_t
+ * @brief  一次批量请求过程中，所使用的 上下文信息。
+ */
+typedef struct xntp_sweep_ctx_t
+{
+    x_sockfd_t     xfdt_sockfd; ///< 网络通信使用的 套接字
+    xntp_keyptr_t  xkey_table;  ///< 认证所用的 密钥表（可为 X_NULL）
+    xntp_ntsptr_t  xnts_sess;   ///< NTS 会话（可为 X_NULL；非空时 只含一个请求项）
+    xntp_ntsreq_t  xnts_req;    ///< NTS 请求的 上下文
+    xntp_sweep_t * xsw_list;    ///< 请求项列表
+    x_uint32_t     xut_count;   ///< 请求项数量
+    x_uint32_t     xut_pending; ///< 已发送，且仍在等待应答的 请求项数量
+    x_bool_t       xbt_sent;    ///< 是否已完成 发送阶段
+    x_bool_t       xbt_first;   ///< 是否 收到 首个 有效应答 即 结束（对冲请求，不再等待 其余请求项）
+    x_uint32_t     xut_hmask;   ///< 索引表的 掩码
+    x_uint32_t   * xut_htable;  ///< 以 (地址, 端口) 为键的 开放寻址索引表（存放 请求项下标 + 1）
+    xtime_pair_t   xtm_base;    ///< 开始时 成对采集的 时钟读数（T1、T4 以 单调时钟 计时，再由此 换算为 系统时间）
+} xntp_sweep_ctx_t;
+
 /**********************************************************/
 /**
- * @brief 向 NTP 服务器发送 NTP 请求，获取相关计算所需的时间戳（T1、T2、T3、T4如下所诉）。
- * <pre>
- *  1. 客户端 发送一个NTP报文给 服务端，该报文带有它离开 客户端 时的时间戳，该时间戳为 T1。
- *  2. 当此NTP报文到达 服务端 时，服务端 加上自己的时间戳，该时间戳为 T2。
- *  3. 当此NTP报文离开 服务端 时，服务端 再加上自己的时间戳，该时间戳为 T3。
- *  4. 当 客户端 接收到该应答报文时，客户端 的本地时间戳，该时间戳为 T4。
- * </pre>
- * 
- * @param [in ] xntp_this : NTP 客户端工作对象。
- * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址）。
- * @param [in ] xut_tmout : 超时时间（单位 毫秒）。
- * 
+ * @brief 以 批量请求 开始时 成对采集的 时钟读数 为基准，读取 当前的 系统时间。
+ * @note
+ * 整个 批量请求 只读取一次 系统时间，T1、T4 之间 发生的 系统时间跳变 不影响 往返时延 与 偏移量。
+ */
+static inline xtime_vnsec_t ntp_sweep_now(xntp_sweep_ctx_t * xctx_ptr)
+{
+    return xctx_ptr->xtm_base.xtm_real + (time_mono_fast() - xctx_ptr->xtm_base.xtm_mono);
+}
+
+/** 计算 (地址, 端口) 在索引表中的 起始位置 */
+#define XSWEEP_HASH(xipv4, xport, xmask) \
+    ((((x_uint32_t)(xipv4) * 0x9E3779B1U) ^ ((x_uint32_t)(xport) * 0x85EBCA6BU)) & (xmask))
+
+/**********************************************************/
+/**
+ * @brief 初始化 批量请求 的上下文（重置各个请求项的结果，建立索引表）。
+ *
  * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
  */
-static x_int32_t ntpcli_get_4T(
-                    xntp_cliptr_t xntp_this,
-                    x_cstring_t xszt_host,
-                    x_uint32_t xut_tmout)
+static x_int32_t ntp_sweep_init(
+                    xntp_sweep_ctx_t * xctx_ptr,
+                    x_sockfd_t xfdt_sockfd,
+                    xntp_keyptr_t xkey_table,
+                    xntp_ntsptr_t xnts_sess,
+                    xntp_sweep_t * xsw_list,
+                    x_uint32_t xut_count)
 {
-    x_int32_t xit_errno = EPERM;
+    x_uint32_t xut_iter = 0;
+    x_uint32_t xut_hpos = 0;
+
+    xctx_ptr->xfdt_sockfd = xfdt_sockfd;
+    xctx_ptr->xkey_table  = xkey_table;
+    xctx_ptr->xnts_sess   = xnts_sess;
+    xctx_ptr->xsw_list    = xsw_list;
+    xctx_ptr->xut_count   = xut_count;
+    xctx_ptr->xut_pending = 0;
+    xctx_ptr->xbt_sent    = X_FALSE;
+    xctx_ptr->xbt_first   = X_FALSE;
+    xctx_ptr->xut_hmask   = 0;
+    xctx_ptr->xut_htable  = X_NULL;
+    xctx_ptr->xtm_base    = time_pair();
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xsw_list[xut_iter].xit_errno    = ETIMEDOUT;
+        xsw_list[xut_iter].xtm_vnsec    = XTIME_INVALID_VNSEC;
+        xsw_list[xut_iter].xtm_4time[0] = XTIME_INVALID_VNSEC;
+        xsw_list[xut_iter].xtm_4time[1] = XTIME_INVALID_VNSEC;
+        xsw_list[xut_iter].xtm_4time[2] = XTIME_INVALID_VNSEC;
+        xsw_list[xut_iter].xtm_4time[3] = XTIME_INVALID_VNSEC;
+        xsw_list[xut_iter].xut_mackey   = 0;
+        xsw_list[xut_iter].xut_leap     = 0;
+        xsw_list[xut_iter].xut_stratum  = 0;
+    }
 
-    xntp_pack_t        xnpt_pack;
-    x_int32_t          xit_alen;
-    struct sockaddr_in xin_addr;
-    fd_set             xfds_rset;
-    struct timeval     xtm_value;
+    if (xut_count <= XSWEEP_LINEAR)
+    {
+        return 0;
+    }
 
-    do 
+    //======================================
+    // 索引表的容量 取 不小于 2 倍请求项数量 的 2 的幂
+
+    for (xctx_ptr->xut_hmask = 1; xctx_ptr->xut_hmask < (xut_count * 2); xctx_ptr->xut_hmask <<= 1)
     {
-        //======================================
+    }
+
+    xctx_ptr->xut_htable = (x_uint32_t *)calloc(xctx_ptr->xut_hmask, sizeof(x_uint32_t));
+    if (X_NULL == xctx_ptr->xut_htable)
+    {
+        return ENOMEM;
+    }
 
-        if ((X_NULL == xntp_this) || (X_NULL == xszt_host))
+    xctx_ptr->xut_hmask -= 1;
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xut_hpos = XSWEEP_HASH(xsw_list[xut_iter].xut_ipv4,
+                               xsw_list[xut_iter].xut_port,
+                               xctx_ptr->xut_hmask);
+        while (0 != xctx_ptr->xut_htable[xut_hpos])
         {
-            xit_errno = EINVAL;
-            break;
+            xut_hpos = (xut_hpos + 1) & xctx_ptr->xut_hmask;
         }
 
-        xntp_this->xtm_4time[0] = XTIME_INVALID_VNSEC;
-        xntp_this->xtm_4time[1] = XTIME_INVALID_VNSEC;
-        xntp_this->xtm_4time[2] = XTIME_INVALID_VNSEC;
-        xntp_this->xtm_4time[3] = XTIME_INVALID_VNSEC;
+        xctx_ptr->xut_htable[xut_hpos] = xut_iter + 1;
+    }
 
-        //======================================
+    return 0;
+}
 
-        // 服务端主机地址
-        memset(&xin_addr, 0, sizeof(struct sockaddr_in));
-        xin_addr.sin_family = AF_INET;
-        xin_addr.sin_port   = htons(xntp_this->xut_port);
-        inet_pton(AF_INET, xszt_host, &xin_addr.sin_addr.s_addr);
+/**********************************************************/
+/**
+ * @brief 释放 批量请求 上下文所占用的资源。
+ */
+static x_void_t ntp_sweep_release(xntp_sweep_ctx_t * xctx_ptr)
+{
+    if (X_NULL != xctx_ptr->xut_htable)
+    {
+        free(xctx_ptr->xut_htable);
+        xctx_ptr->xut_htable = X_NULL;
+    }
+}
 
-        //======================================
+/**********************************************************/
+/**
+ * @brief 向 已由请求模板初始化的 报文缓存 写入 发送时间戳（请求项要求认证时，再追加 MAC），并记录 T1。
+ * @note
+ * 使用 NTS 时，改为 追加 NTS 扩展字段（transmit 字段 为 随机值），加密完成后 才记录 T1。
+ *
+ * @param [in ] xctx_ptr : 批量请求的上下文。
+ * @param [in ] xsw_item : 请求项。
+ * @param [out] xbt_pack : 报文缓存（XNTP_PKT_LEN + XNTP_MAC_MAX 字节；使用 NTS 时 为 XNTP_PKT_MAX 字节）。
+ * @param [out] xut_plen : 返回 报文的长度。
+ *
+ * @return x_int32_t : 成功，返回 0；请求项的 key ID 不在密钥表中，返回 ENOENT；NTS 失败，返回 其错误码。
+ */
+static inline x_int32_t ntp_sweep_stamp(
+                            xntp_sweep_ctx_t * xctx_ptr,
+                            xntp_sweep_t * xsw_item,
+                            x_uchar_t * xbt_pack,
+                            x_uint32_t * xut_plen)
+{
+    x_int32_t  xit_errno = 0;
+    x_uint32_t xut_mlen  = 0;
 
-        // 初始化请求数据包
-        ntp_init_req_packet(&xnpt_pack);
+    if (X_NULL != xctx_ptr->xnts_sess)
+    {
+        xit_errno = ntpnts_seal(xctx_ptr->xnts_sess, &xctx_ptr->xnts_req, xbt_pack, XNTP_PKT_MAX, xut_plen);
+        xsw_item->xtm_4time[0] = ntp_sweep_now(xctx_ptr);
+        return xit_errno;
+    }
 
-        // T1
-        xntp_this->xtm_4time[0] = time_vnsec();
+    // T1
+    xsw_item->xtm_4time[0] = ntp_sweep_now(xctx_ptr);
 
-        // NTP请求报文离开发送端时发送端的本地时间
-        XTIME_UTOS(xntp_this->xtm_4time[0], xnpt_pack.xtms_transmit);
+    // NTP请求报文离开发送端时发送端的本地时间（只写入 8 字节的 transmit 字段）
+    ntp_req_stamp(xbt_pack, xsw_item->xtm_4time[0]);
+    *xut_plen = XNTP_PKT_LEN;
 
-        // 转成网络字节序
-        ntp_hton_packet(&xnpt_pack);
+    if (0 != xsw_item->xut_keyid)
+    {
+        xit_errno = ntpkey_sign(xctx_ptr->xkey_table, xsw_item->xut_keyid, xbt_pack, XNTP_PKT_LEN, &xut_mlen);
+        *xut_plen += xut_mlen;
+    }
 
-        // 发送 NTP 请求
-        xit_errno = sendto(
-                        xntp_this->xfdt_sockfd,
-                        (x_char_t *)&xnpt_pack,
-                        sizeof(xntp_pack_t),
-                        0,
-                        (struct sockaddr *)&xin_addr,
-                        sizeof(struct sockaddr_in));
-        if (xit_errno < 0)
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 为 请求项 构建 NTP 请求报文（网络字节序），并记录 T1（参看 ntp_sweep_stamp()）。
+ */
+static x_int32_t ntp_sweep_build(
+                    xntp_sweep_ctx_t * xctx_ptr,
+                    xntp_sweep_t * xsw_item,
+                    x_uchar_t * xbt_pack,
+                    x_uint32_t * xut_plen)
+{
+    ntp_req_init(xbt_pack);
+    return ntp_sweep_stamp(xctx_ptr, xsw_item, xbt_pack, xut_plen);
+}
+
+/**********************************************************/
+/**
+ * @brief 标记 请求项 发送失败。
+ */
+static x_void_t ntp_sweep_fail(xntp_sweep_ctx_t * xctx_ptr, xntp_sweep_t * xsw_item, x_int32_t xit_errno)
+{
+    if (XSWEEP_PENDING(xsw_item))
+    {
+        xctx_ptr->xut_pending -= 1;
+    }
+
+    xsw_item->xtm_4time[0] = XTIME_INVALID_VNSEC;
+    xsw_item->xit_errno    = xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 处理接收到的一个 应答报文，并匹配到对应的 请求项。
+ * @note
+ * 以 (地址, 端口) 查找请求项，再比对应答中的 originate 与请求项的 T1，
+ * 不匹配的报文（如 先前请求的迟到应答）被直接丢弃。
+ *
+ * @param [in ] xctx_ptr  : 批量请求的上下文。
+ * @param [in ] xbt_data  : 应答报文数据（网络字节序）。
+ * @param [in ] xit_dlen  : 应答报文长度。
+ * @param [in ] xut_ipv4  : 应答来源的 IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 应答来源的 端口号（主机字节序）。
+ * @param [in ] xtm_T4    : 接收到应答时的 本地系统时间戳 T4。
+ *
+ * @return x_bool_t : 匹配并完成了某个请求项，返回 X_TRUE；否则返回 X_FALSE。
+ */
+static x_bool_t ntp_sweep_reply(
+                    xntp_sweep_ctx_t * xctx_ptr,
+                    const x_uchar_t * xbt_data,
+                    x_int32_t xit_dlen,
+                    x_uint32_t xut_ipv4,
+                    x_uint16_t xut_port,
+                    xtime_vnsec_t xtm_T4)
+{
+    xntp_view_t    xview_pk;
+    x_int32_t      xit_perr = 0;
+    x_uint64_t     xut_orig = 0;
+    x_uint64_t     xut_pivot = 0;
+    xntp_sweep_t * xsw_item = X_NULL;
+    x_uint32_t     xut_iter = 0;
+    x_uint32_t     xut_hpos = 0;
+
+    // 直接在接收缓存上访问报文字段，只解码用到的 originate、receive、transmit
+    xit_perr = ntpv_init(&xview_pk, xbt_data, xit_dlen);
+    if (0 == xit_perr)
+    {
+        xut_orig = ntpv_originate(&xview_pk);
+    }
+
+    if (X_NULL != xctx_ptr->xut_htable)
+        xut_hpos = XSWEEP_HASH(xut_ipv4, xut_port, xctx_ptr->xut_hmask);
+
+    for (;;)
+    {
+        //======================================
+        // 依次取出 地址与端口 相同的 请求项
+
+        if (X_NULL == xctx_ptr->xut_htable)
         {
-            xit_errno = sockfd_errno();
-#if (defined(_WIN32) || defined(_WIN64))
-            if (WSAEWOULDBLOCK != xit_errno)
-#elif (defined(__linux__) || defined(__unix__))
-            if ((EAGAIN != xit_errno) && (EWOULDBLOCK != xit_errno))
-#else // UNKNOW
-#endif // PLATFORM
-            {
+            if (xut_iter >= xctx_ptr->xut_count)
                 break;
-            }
+            xsw_item = &xctx_ptr->xsw_list[xut_iter++];
+        }
+        else
+        {
+            if (0 == xctx_ptr->xut_htable[xut_hpos])
+                break;
+            xsw_item = &xctx_ptr->xsw_list[xctx_ptr->xut_htable[xut_hpos] - 1];
+            xut_hpos = (xut_hpos + 1) & xctx_ptr->xut_hmask;
+        }
+
+        if ((xsw_item->xut_ipv4 != xut_ipv4) ||
+            (xsw_item->xut_port != xut_port) ||
+            !XSWEEP_PENDING(xsw_item))
+        {
+            continue;
         }
 
         //======================================
-        // 使用 select() 检测套接字可读
 
-        FD_ZERO(&xfds_rset);
-        FD_SET(xntp_this->xfdt_sockfd, &xfds_rset);
+        // 判断数据包是否有效（无效时，继续等待，超时后 返回该错误码）
+        if (0 != xit_perr)
+        {
+            xsw_item->xit_errno = xit_perr;
+            continue;
+        }
 
-        // 超时时间
-        if (xut_tmout > 0)
+        if (xut_orig != ((X_NULL != xctx_ptr->xnts_sess) ?
+                         xctx_ptr->xnts_req.xut_xmt : ntp_stamp_from_vnsec(xsw_item->xtm_4time[0])))
         {
-            xtm_value.tv_sec  = (xut_tmout / 1000);
-            xtm_value.tv_usec = (xut_tmout % 1000) * 1000;
+            continue;
         }
 
-        xit_errno = select(
-                        (x_int32_t)(xntp_this->xfdt_sockfd + 1),
-                        &xfds_rset,
-                        X_NULL,
-                        X_NULL,
-                        (xut_tmout > 0) ? &xtm_value : X_NULL);
-        if (xit_errno <= 0)
+        // NTS：应答 须通过 Unique Identifier 与 AEAD 的校验
+        if ((X_NULL != xctx_ptr->xnts_sess) &&
+            (0 != ntpnts_open(xctx_ptr->xnts_sess, &xctx_ptr->xnts_req, xbt_data, (x_uint32_t)xit_dlen)))
         {
-            xit_errno = (0 == xit_errno) ? ETIMEDOUT : sockfd_errno();
-            break;
+            xsw_item->xit_errno = EACCES;
+            continue;
         }
 
-        if (!FD_ISSET(xntp_this->xfdt_sockfd, &xfds_rset))
+        // 认证的请求，应答须携带 同一 key ID 的有效 MAC（crypto-NAK、缺少 或 无效的 MAC，
+        // 均按 认证失败 继续等待，超时后 返回 EACCES）
+        if ((0 != xsw_item->xut_keyid) &&
+            ((ntpv_keyid(&xview_pk) != xsw_item->xut_keyid) ||
+             (0 != ntpkey_verify(xctx_ptr->xkey_table,
+                                 xsw_item->xut_keyid,
+                                 xview_pk.xbt_data,
+                                 xview_pk.xut_mpos,
+                                 ntpv_digest(&xview_pk),
+                                 ntpv_digest_len(&xview_pk)))))
         {
-            xit_errno = EBADF;
-            break;
+            xsw_item->xit_errno = EACCES;
+            continue;
         }
 
         //======================================
 
-        memset(&xnpt_pack, 0, sizeof(xntp_pack_t));
-
-        // 接收应答
-        xit_alen  = sizeof(struct sockaddr_in);
-        xit_errno = recvfrom(
-                        xntp_this->xfdt_sockfd,
-                        (x_char_t *)&xnpt_pack,
-                        sizeof(xntp_pack_t),
-                        0,
-                        (struct sockaddr *)&xin_addr,
-                        (socklen_t *)&xit_alen);
-        // T4
-        xntp_this->xtm_4time[3] = time_vnsec();
+        // 以 T4 为参照 确定 T2、T3 的 纪元（2036 年之后 秒数回绕）
+        xut_pivot = ntp_era_seconds(xtm_T4);
 
-        if (xit_errno < 0)
-        {
-            xit_errno = sockfd_errno();
-            break;
-        }
+        xsw_item->xtm_4time[3] = xtm_T4;                                                  // T4
+        xsw_item->xtm_4time[1] = ntp_stamp_to_vnsec(ntpv_receive (&xview_pk), xut_pivot); // T2
+        xsw_item->xtm_4time[2] = ntp_stamp_to_vnsec(ntpv_transmit(&xview_pk), xut_pivot); // T3
+        xsw_item->xut_mackey   = ntpv_keyid(&xview_pk);
+        xsw_item->xut_leap     = ntpv_leap(&xview_pk);
+        xsw_item->xut_stratum  = ntpv_stratum(&xview_pk);
+        xctx_ptr->xut_pending -= 1;
 
-        // 判断数据包长度是否有效
-        if (sizeof(xntp_pack_t) != xit_errno)
+        if (!XTMVNSEC_IS_VALID(xsw_item->xtm_4time[1]) ||
+            !XTMVNSEC_IS_VALID(xsw_item->xtm_4time[2]))
         {
-            xit_errno = ENODATA;
-            break;
+            xsw_item->xit_errno = ETIME;
+            return X_TRUE;
         }
 
-        // 转成主机字节序
-        ntp_ntoh_packet(&xnpt_pack);
-
-        XTIME_STOU(xnpt_pack.xtms_receive , xntp_this->xtm_4time[1]); // T2
-        XTIME_STOU(xnpt_pack.xtms_transmit, xntp_this->xtm_4time[2]); // T3
+        xsw_item->xit_errno = 0;
+        xsw_item->xtm_vnsec = ntp_calc_4T(xsw_item->xtm_4time);
 
-        if (!XTMVNSEC_IS_VALID(xntp_this->xtm_4time[1]) ||
-            !XTMVNSEC_IS_VALID(xntp_this->xtm_4time[2]))
+        // 对冲请求：首个 有效应答 即可 结束
+        if (xctx_ptr->xbt_first)
         {
-            xit_errno = ETIME;
-            break;
+            xctx_ptr->xut_pending = 0;
         }
 
         //======================================
 #ifdef XNTP_DBG_OUTPUT
         printf("========================================\n"
-               "%s : %s\n", xntp_this->xszt_host, xszt_host);
-        output_tm("\tNTP RT", &xnpt_pack.xtms_reference);
-        output_tm("\tNTP T1", &xnpt_pack.xtms_originate);
-        output_tm("\tNTP T2", &xnpt_pack.xtms_receive  );
-        output_tm("\tNTP T3", &xnpt_pack.xtms_transmit );
-        output_tu("\tSYS T1", xntp_this->xtm_4time[0]);
-        output_tu("\tSYS T2", xntp_this->xtm_4time[1]);
-        output_tu("\tSYS T3", xntp_this->xtm_4time[2]);
-        output_tu("\tSYS T4", xntp_this->xtm_4time[3]);
+               "%u.%u.%u.%u:%u\n",
+               (xut_ipv4 >> 24) & 0xFF, (xut_ipv4 >> 16) & 0xFF,
+               (xut_ipv4 >>  8) & 0xFF, (xut_ipv4 >>  0) & 0xFF,
+               xut_port);
+        output_tm("\tNTP RT", ntpv_reference(&xview_pk));
+        output_tm("\tNTP T1", ntpv_originate(&xview_pk));
+        output_tm("\tNTP T2", ntpv_receive  (&xview_pk));
+        output_tm("\tNTP T3", ntpv_transmit (&xview_pk));
+        output_tu("\tSYS T1", xsw_item->xtm_4time[0]);
+        output_tu("\tSYS T2", xsw_item->xtm_4time[1]);
+        output_tu("\tSYS T3", xsw_item->xtm_4time[2]);
+        output_tu("\tSYS T4", xsw_item->xtm_4time[3]);
         printf("\n");
 #endif // XNTP_DBG_OUTPUT
         //======================================
-        xit_errno = 0;
-    } while (0);
 
-    return xit_errno;
+        return X_TRUE;
+    }
+
+    return X_FALSE;
 }
 
+//====================================================================
+
+// 
+// 批量请求的 select() 后端
+// 
+
 /**********************************************************/
 /**
- * @brief 向 NTP 服务器发送 NTP 请求，获取相关计算所需的时间戳。
- *
- * @param [in ] xntp_this : NTP 客户端工作对象。
- * @param [in ] xut_tmout : 网络请求的超时时间（单位为毫秒）。
- *
- * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ * @brief 使用 sendto() 依次发送各个请求项的 NTP 请求报文。
  */
-static x_int32_t ntpcli_get_4T_by_name(
-                        xntp_cliptr_t xntp_this,
-                        x_uint32_t xut_tmout)
+static x_void_t ntp_sweep_send(xntp_sweep_ctx_t * xctx_ptr)
 {
-    x_int32_t xit_errno = EPERM;
+    x_int32_t          xit_errno = 0;
+    x_uint32_t         xut_iter  = 0;
+    x_uint32_t         xut_plen  = 0;
+    xntp_sweep_t     * xsw_item  = X_NULL;
+    x_uchar_t          xbt_pack[XNTP_PKT_MAX];
+    struct sockaddr_in xin_addr;
 
-    struct addrinfo   xai_hint;
-    struct addrinfo * xai_rptr = X_NULL;
-    struct addrinfo * xai_iptr = X_NULL;
+    memset(&xin_addr, 0, sizeof(struct sockaddr_in));
+    xin_addr.sin_family = AF_INET;
 
-    x_char_t xszt_host[TEXT_LEN_256] = { 0 };
+    // 所有请求项共用同一报文缓存，逐项发送时 只改写 transmit 字段
+    ntp_req_init(xbt_pack);
 
-    do
+    for (xut_iter = 0; xut_iter < xctx_ptr->xut_count; ++xut_iter)
     {
-        //======================================
-
-        if (X_NULL == xntp_this)
-        {
-            xit_errno = EINVAL;
-            break;
-        }
+        xsw_item = &xctx_ptr->xsw_list[xut_iter];
 
-        memset(&xai_hint, 0, sizeof(xai_hint));
-        xai_hint.ai_family   = AF_INET;
-        xai_hint.ai_socktype = SOCK_DGRAM;
+        // 服务端主机地址
+        xin_addr.sin_port        = htons(xsw_item->xut_port);
+        xin_addr.sin_addr.s_addr = htonl(xsw_item->xut_ipv4);
 
-        xit_errno = getaddrinfo(xntp_this->xszt_host, X_NULL, &xai_hint, &xai_rptr);
+        xit_errno = ntp_sweep_stamp(xctx_ptr, xsw_item, xbt_pack, &xut_plen);
+        xctx_ptr->xut_pending += 1;
         if (0 != xit_errno)
         {
-            break;
+            ntp_sweep_fail(xctx_ptr, xsw_item, xit_errno);
+            continue;
         }
 
-        //======================================
-
-        for (xai_iptr = xai_rptr; X_NULL != xai_iptr; xai_iptr = xai_iptr->ai_next)
-        {
-            if (AF_INET != xai_iptr->ai_family)
-            {
-                continue;
-            }
+        // 发送 NTP 请求
+        xit_errno = sendto(
+                        xctx_ptr->xfdt_sockfd,
+                        (x_char_t *)xbt_pack,
+                        xut_plen,
+                        0,
+                        (struct sockaddr *)&xin_addr,
+                        sizeof(struct sockaddr_in));
+        if (xit_errno < 0)
+        {
+            xit_errno = sockfd_errno();
+#if (defined(_WIN32) || defined(_WIN64))
+            if (WSAEWOULDBLOCK != xit_errno)
+#elif (defined(__linux__) || defined(__unix__))
+            if ((EAGAIN != xit_errno) && (EWOULDBLOCK != xit_errno))
+#else // UNKNOW
+#endif // PLATFORM
+            {
+                ntp_sweep_fail(xctx_ptr, xsw_item, xit_errno);
+            }
+        }
+    }
+
+    xctx_ptr->xbt_sent = X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 recvfrom() 读取 套接字缓存 中的 应答（非阻塞），直至 缓存读空 或 所有请求项完成。
+ *
+ * @return x_int32_t :
+ * 所有请求项完成，返回 0；否则 返回 recvfrom() 的 错误码（缓存读空 时 为 EAGAIN 等，参看 sockfd_retry()）。
+ */
+static x_int32_t ntp_sweep_drain(xntp_sweep_ctx_t * xctx_ptr)
+{
+    x_int32_t          xit_errno = 0;
+    x_int32_t          xit_alen;
+    x_uchar_t          xbt_pack[XNTP_PKT_MAX + 4];
+    xtime_vnsec_t      xtm_T4;
+    struct sockaddr_in xin_addr;
+
+    for (;;)
+    {
+        xit_alen  = sizeof(struct sockaddr_in);
+        xit_errno = recvfrom(
+                        xctx_ptr->xfdt_sockfd,
+                        (x_char_t *)xbt_pack,
+                        sizeof(xbt_pack),
+                        0,
+                        (struct sockaddr *)&xin_addr,
+                        (socklen_t *)&xit_alen);
+        // T4
+        xtm_T4 = ntp_sweep_now(xctx_ptr);
+
+        if (xit_errno < 0)
+        {
+            xit_errno = sockfd_errno();
+#if (defined(_WIN32) || defined(_WIN64))
+            // 超长的报文 被截断时，Windows 返回该错误（数据已被取出），按 超长报文 处理
+            if (WSAEMSGSIZE == xit_errno)
+                xit_errno = (x_int32_t)sizeof(xbt_pack);
+            else
+#endif // (defined(_WIN32) || defined(_WIN64))
+            return xit_errno;
+        }
+
+        // 缓存 比 XNTP_PKT_MAX 多留几个字节，被截断的 超长报文 因而会被判为 EMSGSIZE
+        ntp_sweep_reply(xctx_ptr,
+                        xbt_pack,
+                        xit_errno,
+                        ntohl(xin_addr.sin_addr.s_addr),
+                        ntohs(xin_addr.sin_port),
+                        xtm_T4);
+        if (0 == xctx_ptr->xut_pending)
+        {
+            return 0;
+        }
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 使用 select() 检测套接字可读，接收应答，直至 所有请求项完成 或 超过截止时间。
+ * @note
+ * 以 单调时钟 的截止时间计算每次 select() 的剩余超时时间，
+ * 遇到 EINTR 中断，或 收到不匹配的应答报文时，继续在剩余时间内等待，而不会重新计时。
+ *
+ * @return x_int32_t : 正常结束（含超时），返回 0；套接字出错，返回 错误码。
+ */
+static x_int32_t ntp_sweep_wait(xntp_sweep_ctx_t * xctx_ptr, xtime_vnsec_t xtm_dline)
+{
+    x_int32_t      xit_errno = 0;
+    x_sockfd_t     xfdt_sock = xctx_ptr->xfdt_sockfd;
+    fd_set         xfds_rset;
+    struct timeval xtm_value;
+
+    while (xctx_ptr->xut_pending > 0)
+    {
+        //======================================
+
+        xit_errno = ntp_dline_remain(xtm_dline, &xtm_value);
+        if (ETIMEDOUT == xit_errno)
+        {
+            xit_errno = 0;
+            break;
+        }
+
+        FD_ZERO(&xfds_rset);
+        FD_SET(xfdt_sock, &xfds_rset);
+
+        xit_errno = select(
+                        (x_int32_t)(xfdt_sock + 1),
+                        &xfds_rset,
+                        X_NULL,
+                        X_NULL,
+                        (0 == xit_errno) ? &xtm_value : X_NULL);
+        if (xit_errno < 0)
+        {
+            xit_errno = sockfd_errno();
+            if (sockfd_retry(xit_errno))
+                continue;
+            break;
+        }
+
+        // 超时后，回到循环开始处判断截止时间
+        if ((0 == xit_errno) || !FD_ISSET(xfdt_sock, &xfds_rset))
+        {
+            continue;
+        }
+
+        //======================================
+        // 接收应答（读空套接字缓存）
+
+        xit_errno = ntp_sweep_drain(xctx_ptr);
+        if ((0 != xit_errno) && !sockfd_retry(xit_errno))
+        {
+            break;
+        }
+
+        xit_errno = 0;
+    }
+
+    return xit_errno;
+}
+
+//====================================================================
+
+// 
+// 批量请求的 io_uring 后端
+// 
+
+#ifdef XNTP_IO_URING
+
+/** io_uring 操作类型（存放于 user_data 的高 32 位） */
+#define XSWEEP_UD_SEND      1ULL
+#define XSWEEP_UD_RECV      2ULL
+#define XSWEEP_UD_TIMEOUT   3ULL
+#define XSWEEP_UD_CANCEL    4ULL
+#define XSWEEP_UD(xtype, xindex) (((xtype) << 32) | (x_uint64_t)(xindex))
+
+/** 接收应答时，控制信息（内核接收时间戳）的 缓存字节数 */
+#define XSWEEP_CMSG_SIZE    CMSG_SPACE(sizeof(struct timespec))
+
+/**
+ * @struct xntp_sweep_sreq_t
+ * @brief  io_uring 发送请求 所引用的数据（须在操作完成前保持有效）。
+ */
+typedef struct xntp_sweep_sreq_t
+{
+    x_uchar_t          xbt_pack[XNTP_PKT_LEN + XNTP_MAC_MAX];
+    struct sockaddr_in xin_addr;
+    struct iovec       xio_vec;
+    struct msghdr      xmsg_hdr;
+} xntp_sweep_sreq_t;
+
+/**
+ * @struct xntp_sweep_uring_t
+ * @brief  io_uring 后端 在一次批量请求中 的工作状态。
+ */
+typedef struct xntp_sweep_uring_t
+{
+    xuring_ptr_t              xring_ptr; ///< 线程私有的 io_uring 工作对象
+    struct msghdr             xmsg_recv; ///< 多次接收（multishot recvmsg）操作的 报文头模板
+    struct __kernel_timespec  xtms_dline;///< 截止时间（CLOCK_MONOTONIC 绝对时间）
+    x_uint32_t                xut_sends; ///< 尚未完成的 发送操作 数量
+    x_bool_t                  xbt_recv;  ///< 接收操作 是否仍在进行
+    x_bool_t                  xbt_tmout; ///< 链接超时操作 是否仍在进行
+    x_bool_t                  xbt_cancel;///< 取消操作 是否仍在进行
+    x_bool_t                  xbt_expire;///< 是否已超过截止时间
+    x_bool_t                  xbt_nosupp;///< 内核不支持 多次接收 操作，需回退到 select() 后端
+} xntp_sweep_uring_t;
+
+/**********************************************************/
+/**
+ * @brief 提交 多次接收（multishot recvmsg）操作，以及链接在其后的 截止时间 超时操作。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntp_sweep_uring_arm(
+                    xntp_sweep_ctx_t * xctx_ptr,
+                    xntp_sweep_uring_t * xur_this,
+                    xtime_vnsec_t xtm_dline)
+{
+    struct io_uring_sqe * xsqe_recv = X_NULL;
+    struct io_uring_sqe * xsqe_tmo  = X_NULL;
+
+    xsqe_recv = xuring_get_sqe(xur_this->xring_ptr);
+    if (XTMVNSEC_IS_VALID(xtm_dline))
+        xsqe_tmo = xuring_get_sqe(xur_this->xring_ptr);
+
+    if ((X_NULL == xsqe_recv) || (XTMVNSEC_IS_VALID(xtm_dline) && (X_NULL == xsqe_tmo)))
+    {
+        return EBUSY;
+    }
+
+    xsqe_recv->opcode    = IORING_OP_RECVMSG;
+    xsqe_recv->fd        = xctx_ptr->xfdt_sockfd;
+    xsqe_recv->addr      = (x_uint64_t)(x_size_t)&xur_this->xmsg_recv;
+    xsqe_recv->len       = 1;
+    xsqe_recv->ioprio    = IORING_RECV_MULTISHOT;
+    xsqe_recv->flags     = IOSQE_BUFFER_SELECT;
+    xsqe_recv->buf_group = XURING_BUF_GROUP;
+    xsqe_recv->user_data = XSWEEP_UD(XSWEEP_UD_RECV, 0);
+    xur_this->xbt_recv   = X_TRUE;
+
+    if (X_NULL != xsqe_tmo)
+    {
+        xsqe_recv->flags |= IOSQE_IO_LINK;
+
+        xsqe_tmo->opcode        = IORING_OP_LINK_TIMEOUT;
+        xsqe_tmo->fd            = -1;
+        xsqe_tmo->addr          = (x_uint64_t)(x_size_t)&xur_this->xtms_dline;
+        xsqe_tmo->len           = 1;
+        xsqe_tmo->timeout_flags = IORING_TIMEOUT_ABS;
+        xsqe_tmo->user_data     = XSWEEP_UD(XSWEEP_UD_TIMEOUT, 0);
+        xur_this->xbt_tmout     = X_TRUE;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 处理 多次接收 操作所得到的一个 提供缓存 中的 应答报文。
+ */
+static x_void_t ntp_sweep_uring_data(
+                    xntp_sweep_ctx_t * xctx_ptr,
+                    xntp_sweep_uring_t * xur_this,
+                    x_bptr_t xbt_data,
+                    x_int32_t xit_dlen)
+{
+    struct io_uring_recvmsg_out * xout_ptr = (struct io_uring_recvmsg_out *)xbt_data;
+    struct sockaddr_in          * xin_addr = X_NULL;
+    struct cmsghdr              * xcmsg    = X_NULL;
+    struct timespec             * xtms_rcv = X_NULL;
+    x_bptr_t                      xbt_load = X_NULL;
+    x_uint32_t                    xut_hlen = 0;
+    x_int32_t                     xit_plen = 0;
+    xtime_vnsec_t                 xtm_T4   = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t                 xtm_kstamp = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t                 xtm_age  = 0;
+    struct msghdr                 xmsg_ctl;
+
+    // 缓存布局：io_uring_recvmsg_out + 地址 + 控制信息 + 报文数据
+    xut_hlen = (x_uint32_t)(sizeof(struct io_uring_recvmsg_out) +
+                            xur_this->xmsg_recv.msg_namelen     +
+                            xur_this->xmsg_recv.msg_controllen);
+    if ((xit_dlen < (x_int32_t)xut_hlen) || (xout_ptr->namelen < sizeof(struct sockaddr_in)))
+    {
+        return;
+    }
+
+    xin_addr = (struct sockaddr_in *)(xbt_data + sizeof(struct io_uring_recvmsg_out));
+    xbt_load = xbt_data + xut_hlen;
+    // 被截断时 取报文的实际长度（提供缓存 足以容纳 XNTP_PKT_MAX 字节的报文，
+    // 故 截断的报文 必然超长，会被判为 EMSGSIZE，而不会访问缓存之外的数据）
+    xit_plen = (xout_ptr->flags & MSG_TRUNC) ? (x_int32_t)xout_ptr->payloadlen : (xit_dlen - (x_int32_t)xut_hlen);
+
+    //======================================
+    // T4 优先取 内核接收时间戳（SO_TIMESTAMPNS），与 完成事件被处理的时刻 无关；
+    // 内核时间戳 为 系统时间（CLOCK_REALTIME），只取 其 与 当前系统时间 之差 作为 报文的 滞留时长，
+    // 再 以 批量请求的 时钟基准 换算，使 T4 与 T1 处于 同一时间基准（不受 系统时间跳变 影响）
+
+    memset(&xmsg_ctl, 0, sizeof(xmsg_ctl));
+    xmsg_ctl.msg_control    = (x_bptr_t)xin_addr + xur_this->xmsg_recv.msg_namelen;
+    xmsg_ctl.msg_controllen = xout_ptr->controllen;
+
+    for (xcmsg = CMSG_FIRSTHDR(&xmsg_ctl); X_NULL != xcmsg; xcmsg = CMSG_NXTHDR(&xmsg_ctl, xcmsg))
+    {
+        if ((SOL_SOCKET == xcmsg->cmsg_level) && (SCM_TIMESTAMPNS == xcmsg->cmsg_type))
+        {
+            xtms_rcv = (struct timespec *)CMSG_DATA(xcmsg);
+            xtm_kstamp = (xtime_vnsec_t)(xtms_rcv->tv_sec * 10000000ULL + xtms_rcv->tv_nsec / 100ULL);
+            break;
+        }
+    }
+
+    xtm_T4 = ntp_sweep_now(xctx_ptr);
+
+    if (XTMVNSEC_IS_VALID(xtm_kstamp))
+    {
+        // 滞留时长 限定在 [0, 批量请求 已进行的时长] 之内（其间 系统时间 跳变 时，时长 不可信）
+        xtm_age = time_vnsec();
+        xtm_age = (xtm_age > xtm_kstamp) ? (xtm_age - xtm_kstamp) : 0;
+        if (xtm_age > (xtm_T4 - xctx_ptr->xtm_base.xtm_real))
+        {
+            xtm_age = xtm_T4 - xctx_ptr->xtm_base.xtm_real;
+        }
+
+        xtm_T4 -= xtm_age;
+    }
+
+    ntp_sweep_reply(xctx_ptr,
+                    xbt_load,
+                    xit_plen,
+                    ntohl(xin_addr->sin_addr.s_addr),
+                    ntohs(xin_addr->sin_port),
+                    xtm_T4);
+}
+
+/**********************************************************/
+/**
+ * @brief 处理 io_uring 完成队列中的 所有完成事件。
+ */
+static x_void_t ntp_sweep_uring_reap(xntp_sweep_ctx_t * xctx_ptr, xntp_sweep_uring_t * xur_this)
+{
+    struct io_uring_cqe * xcqe_ptr = X_NULL;
+    x_uint64_t            xult_ud  = 0;
+    x_uint16_t            xut_bid  = 0;
+
+    while (X_NULL != (xcqe_ptr = xuring_peek_cqe(xur_this->xring_ptr)))
+    {
+        xult_ud = xcqe_ptr->user_data;
+
+        switch (xult_ud >> 32)
+        {
+        case XSWEEP_UD_SEND:
+            xur_this->xut_sends -= 1;
+            if (xcqe_ptr->res < 0)
+            {
+                ntp_sweep_fail(xctx_ptr,
+                               &xctx_ptr->xsw_list[(x_uint32_t)xult_ud],
+                               -xcqe_ptr->res);
+            }
+            break;
+
+        case XSWEEP_UD_RECV:
+            if (xcqe_ptr->flags & IORING_CQE_F_BUFFER)
+            {
+                xut_bid = (x_uint16_t)(xcqe_ptr->flags >> IORING_CQE_BUFFER_SHIFT);
+                if (xcqe_ptr->res > 0)
+                {
+                    ntp_sweep_uring_data(xctx_ptr,
+                                         xur_this,
+                                         xuring_buf_addr(xur_this->xring_ptr, xut_bid),
+                                         xcqe_ptr->res);
+                }
+                xuring_buf_recycle(xur_this->xring_ptr, xut_bid);
+            }
+
+            if (0 == (xcqe_ptr->flags & IORING_CQE_F_MORE))
+            {
+                // 多次接收 操作已终止（超时、被取消、缓存耗尽 或 内核不支持）
+                xur_this->xbt_recv = X_FALSE;
+                if ((-EINVAL == xcqe_ptr->res) || (-EOPNOTSUPP == xcqe_ptr->res))
+                    xur_this->xbt_nosupp = X_TRUE;
+            }
+            break;
+
+        case XSWEEP_UD_TIMEOUT:
+            xur_this->xbt_tmout = X_FALSE;
+            if (-ETIME == xcqe_ptr->res)
+                xur_this->xbt_expire = X_TRUE;
+            break;
+
+        case XSWEEP_UD_CANCEL:
+            xur_this->xbt_cancel = X_FALSE;
+            break;
+
+        default:
+            break;
+        }
+
+        xuring_cqe_seen(xur_this->xring_ptr);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 使用 io_uring 执行批量请求：批量提交发送操作，
+ *        以 多次接收（multishot recvmsg + 提供缓存环）接收所有应答，
+ *        并以 链接超时（IORING_OP_LINK_TIMEOUT）约束截止时间。
+ * @note
+ * 返回前，所有已提交的操作均已完成（或被取消），不会残留引用栈上数据的操作。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；返回 ENOSYS 时，表示需回退到 select() 后端
+ * （若 xctx_ptr->xbt_sent 已置位，则只需继续等待应答）；其他值为 错误码。
+ */
+static x_int32_t ntp_sweep_uring(
+                    xuring_ptr_t xring_ptr,
+                    xntp_sweep_ctx_t * xctx_ptr,
+                    xtime_vnsec_t xtm_dline)
+{
+    x_int32_t             xit_errno = 0;
+    x_uint32_t            xut_iter  = 0;
+    x_uint32_t            xut_chunk = 0;
+    x_uint32_t            xut_plen  = 0;
+    xntp_sweep_t        * xsw_item  = X_NULL;
+    xntp_sweep_sreq_t   * xsreq_ptr = X_NULL;
+    struct io_uring_sqe * xsqe_ptr  = X_NULL;
+    xntp_sweep_uring_t    xur_this;
+
+    xsreq_ptr = (xntp_sweep_sreq_t *)xuring_scratch(
+                    xring_ptr, xctx_ptr->xut_count * sizeof(xntp_sweep_sreq_t));
+    if (X_NULL == xsreq_ptr)
+    {
+        return ENOSYS;
+    }
+
+    memset(&xur_this, 0, sizeof(xntp_sweep_uring_t));
+    xur_this.xring_ptr                = xring_ptr;
+    xur_this.xmsg_recv.msg_namelen    = sizeof(struct sockaddr_in);
+    xur_this.xmsg_recv.msg_controllen = XSWEEP_CMSG_SIZE;
+    if (XTMVNSEC_IS_VALID(xtm_dline))
+    {
+        xur_this.xtms_dline.tv_sec  = (x_int64_t)(xtm_dline / XTIME_100NS_BASE);
+        xur_this.xtms_dline.tv_nsec = (x_int64_t)(xtm_dline % XTIME_100NS_BASE) * 100LL;
+    }
+
+    //======================================
+    // 先提交接收操作，再分批提交发送操作
+
+    xit_errno = ntp_sweep_uring_arm(xctx_ptr, &xur_this, xtm_dline);
+    if (0 != xit_errno)
+    {
+        return ENOSYS;
+    }
+
+    for (xut_iter = 0; xut_iter < xctx_ptr->xut_count; ++xut_iter)
+    {
+        xsw_item = &xctx_ptr->xsw_list[xut_iter];
+
+        // 先排除 key ID 无效的请求项，取得 SQE 之后 构建报文 便不会失败
+        if ((0 != xsw_item->xut_keyid) && !ntpkey_exist(xctx_ptr->xkey_table, xsw_item->xut_keyid))
+        {
+            ntp_sweep_fail(xctx_ptr, xsw_item, ENOENT);
+            continue;
+        }
+
+        while (X_NULL == (xsqe_ptr = xuring_get_sqe(xring_ptr)))
+        {
+            xuring_submit(xring_ptr, 0);
+            ntp_sweep_uring_reap(xctx_ptr, &xur_this);
+        }
+
+        // 报文缓存 由请求模板整体覆盖，无需清零
+        memset(&xsreq_ptr[xut_iter].xin_addr, 0, sizeof(struct sockaddr_in));
+        memset(&xsreq_ptr[xut_iter].xmsg_hdr, 0, sizeof(struct msghdr));
+        xsreq_ptr[xut_iter].xin_addr.sin_family      = AF_INET;
+        xsreq_ptr[xut_iter].xin_addr.sin_port        = htons(xsw_item->xut_port);
+        xsreq_ptr[xut_iter].xin_addr.sin_addr.s_addr = htonl(xsw_item->xut_ipv4);
+        xsreq_ptr[xut_iter].xio_vec.iov_base         = xsreq_ptr[xut_iter].xbt_pack;
+        xsreq_ptr[xut_iter].xmsg_hdr.msg_name        = &xsreq_ptr[xut_iter].xin_addr;
+        xsreq_ptr[xut_iter].xmsg_hdr.msg_namelen     = sizeof(struct sockaddr_in);
+        xsreq_ptr[xut_iter].xmsg_hdr.msg_iov         = &xsreq_ptr[xut_iter].xio_vec;
+        xsreq_ptr[xut_iter].xmsg_hdr.msg_iovlen      = 1;
+
+        ntp_sweep_build(xctx_ptr, xsw_item, xsreq_ptr[xut_iter].xbt_pack, &xut_plen);
+        xsreq_ptr[xut_iter].xio_vec.iov_len          = xut_plen;
+        xctx_ptr->xut_pending += 1;
+
+        xsqe_ptr->opcode    = IORING_OP_SENDMSG;
+        xsqe_ptr->fd        = xctx_ptr->xfdt_sockfd;
+        xsqe_ptr->addr      = (x_uint64_t)(x_size_t)&xsreq_ptr[xut_iter].xmsg_hdr;
+        xsqe_ptr->len       = 1;
+        xsqe_ptr->user_data = XSWEEP_UD(XSWEEP_UD_SEND, xut_iter);
+        xur_this.xut_sends += 1;
+
+        if (++xut_chunk >= XSWEEP_CHUNK)
+        {
+            xuring_submit(xring_ptr, 0);
+            xut_chunk = 0;
+        }
+    }
+
+    xctx_ptr->xbt_sent = X_TRUE;
+    xit_errno = xuring_submit(xring_ptr, 0);
+
+    //======================================
+    // 处理完成事件，直至 所有操作均已结束
+
+    while (0 == xit_errno)
+    {
+        ntp_sweep_uring_reap(xctx_ptr, &xur_this);
+
+        if (!xur_this.xbt_recv && !xur_this.xbt_tmout && !xur_this.xbt_nosupp && !xur_this.xbt_expire &&
+            (xctx_ptr->xut_pending > 0))
+        {
+            // 多次接收 因缓存耗尽等原因终止，截止时间前重新提交
+            if (XTMVNSEC_IS_VALID(xtm_dline) && (time_mono() >= xtm_dline))
+                xur_this.xbt_expire = X_TRUE;
+            else if (0 != ntp_sweep_uring_arm(xctx_ptr, &xur_this, xtm_dline))
+                xur_this.xbt_nosupp = X_TRUE;
+        }
+
+        if (xur_this.xbt_recv && !xur_this.xbt_cancel &&
+            ((0 == xctx_ptr->xut_pending) || xur_this.xbt_nosupp))
+        {
+            // 所有请求项均已完成，取消仍在进行的 接收操作
+            xsqe_ptr = xuring_get_sqe(xring_ptr);
+            if (X_NULL != xsqe_ptr)
+            {
+                xsqe_ptr->opcode    = IORING_OP_ASYNC_CANCEL;
+                xsqe_ptr->fd        = -1;
+                xsqe_ptr->addr      = XSWEEP_UD(XSWEEP_UD_RECV, 0);
+                xsqe_ptr->user_data = XSWEEP_UD(XSWEEP_UD_CANCEL, 0);
+                xur_this.xbt_cancel = X_TRUE;
+            }
+        }
+
+        if ((0 == xur_this.xut_sends) && !xur_this.xbt_recv && !xur_this.xbt_tmout && !xur_this.xbt_cancel)
+        {
+            break;
+        }
+
+        xit_errno = xuring_submit(xring_ptr, 1);
+    }
+
+    if (xur_this.xbt_nosupp)
+    {
+        // 内核不支持 多次接收 操作，此后不再使用 io_uring
+        xuring_disable();
+        return ENOSYS;
+    }
+
+    return xit_errno;
+}
+
+#endif // XNTP_IO_URING
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 执行批量请求：向各个请求项发送 NTP 请求，并在截止时间前 接收与匹配 应答。
+ * @note
+ * 在支持 io_uring 的 Linux 平台上，优先使用 io_uring 后端，否则使用 select() 后端。
+ *
+ * @param [in ] xfdt_sockfd : 网络通信使用的 套接字。
+ * @param [in ] xkey_table : 认证所用的 密钥表（请求项的 xut_keyid 非 0 时使用）。
+ * @param [in ] xnts_sess : NTS 会话（可为 X_NULL；非空时 只能有一个请求项，且 只使用 select() 后端）。
+ * @param [in ] xsw_list  : 请求项列表。
+ * @param [in ] xut_count : 请求项数量。
+ * @param [in ] xtm_dline : 单调时钟的截止时间（XTIME_INVALID_VNSEC 表示无限等待）。
+ *
+ * @return x_int32_t : 成功，返回 0（各请求项的结果见其 xit_errno）；失败，返回 错误码。
+ */
+static x_int32_t ntpcli_sweep(
+                    x_sockfd_t xfdt_sockfd,
+                    xntp_keyptr_t xkey_table,
+                    xntp_ntsptr_t xnts_sess,
+                    xntp_sweep_t * xsw_list,
+                    x_uint32_t xut_count,
+                    xtime_vnsec_t xtm_dline)
+{
+    x_int32_t        xit_errno = EPERM;
+    x_uint32_t       xut_iter  = 0;
+    xntp_sweep_ctx_t xctx_this;
+
+#ifdef XNTP_IO_URING
+    xuring_ptr_t xring_ptr = X_NULL;
+#endif // XNTP_IO_URING
+
+    do
+    {
+        //======================================
+
+        xit_errno = ntp_sweep_init(&xctx_this, xfdt_sockfd, xkey_table, xnts_sess, xsw_list, xut_count);
+        if (0 != xit_errno)
+        {
+            break;
+        }
+
+        if ((X_NULL != xnts_sess) && (1 != xut_count))
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        //======================================
+
+#ifdef XNTP_IO_URING
+        // NTS 请求 只有一个，且报文较长，直接使用 select() 后端
+        xring_ptr = (X_NULL == xnts_sess) ? xuring_local() : X_NULL;
+        if (X_NULL != xring_ptr)
+        {
+            xit_errno = ntp_sweep_uring(xring_ptr, &xctx_this, xtm_dline);
+            if (ENOSYS != xit_errno)
+            {
+                break;
+            }
+        }
+#endif // XNTP_IO_URING
+
+        if (!xctx_this.xbt_sent)
+        {
+            ntp_sweep_send(&xctx_this);
+        }
+
+        xit_errno = ntp_sweep_wait(&xctx_this, xtm_dline);
+
+        //======================================
+    } while (0);
+
+    // 套接字出错时，将仍在等待的请求项 标记为该错误
+    if ((0 != xit_errno) && (xctx_this.xut_pending > 0))
+    {
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+        {
+            if (XSWEEP_PENDING(&xsw_list[xut_iter]))
+            {
+                ntp_sweep_fail(&xctx_this, &xsw_list[xut_iter], xit_errno);
+            }
+        }
+    }
+
+    ntp_sweep_release(&xctx_this);
+
+    return xit_errno;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// NTP 内部相关操作接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 向 NTP 服务器发送 NTP 请求，获取相关计算所需的时间戳（T1、T2、T3、T4如下所诉）。
+ * <pre>
+ *  1. 客户端 发送一个NTP报文给 服务端，该报文带有它离开 客户端 时的时间戳，该时间戳为 T1。
+ *  2. 当此NTP报文到达 服务端 时，服务端 加上自己的时间戳，该时间戳为 T2。
+ *  3. 当此NTP报文离开 服务端 时，服务端 再加上自己的时间戳，该时间戳为 T3。
+ *  4. 当 客户端 接收到该应答报文时，客户端 的本地时间戳，该时间戳为 T4。
+ * </pre>
+ * @note
+ * 以只含一个请求项的 批量请求 完成，传输后端 参看 ntpcli_sweep()。
+ * 
+ * @param [in ] xfdt_sockfd : 网络通信使用的 套接字。
+ * @param [in ] xkey_table : 认证所用的 密钥表。
+ * @param [in ] xut_keyid : 认证所用的 key ID（取 0 时 不认证）。
+ * @param [in ] xnts_sess : NTS 会话（可为 X_NULL）。
+ * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址）。
+ * @param [in ] xut_port  : NTP 服务器的 端口号。
+ * @param [out] xtm_4time : 操作返回的 4 个相关时间戳。
+ * @param [out] xut_leap  : 操作成功时，返回 应答的 LI。
+ * @param [in ] xtm_dline : 单调时钟的截止时间（XTIME_INVALID_VNSEC 表示无限等待）。
+ * 
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpcli_get_4T(
+                    x_sockfd_t xfdt_sockfd,
+                    xntp_keyptr_t xkey_table,
+                    x_uint32_t xut_keyid,
+                    xntp_ntsptr_t xnts_sess,
+                    x_cstring_t xszt_host,
+                    x_uint16_t xut_port,
+                    xtime_vnsec_t xtm_4time[4],
+                    x_uint32_t * xut_leap,
+                    xtime_vnsec_t xtm_dline)
+{
+    x_int32_t    xit_errno = EPERM;
+    xntp_sweep_t xsw_item;
+
+    do 
+    {
+        //======================================
+
+        if (X_NULL == xszt_host)
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        xtm_4time[0] = XTIME_INVALID_VNSEC;
+        xtm_4time[1] = XTIME_INVALID_VNSEC;
+        xtm_4time[2] = XTIME_INVALID_VNSEC;
+        xtm_4time[3] = XTIME_INVALID_VNSEC;
+
+        // 服务端主机地址
+        if (!name_is_ipv4(xszt_host, &xsw_item.xut_ipv4))
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        xsw_item.xut_port  = xut_port;
+        xsw_item.xut_keyid = xut_keyid;
+
+        //======================================
+
+        xit_errno = ntpcli_sweep(xfdt_sockfd, xkey_table, xnts_sess, &xsw_item, 1, xtm_dline);
+        if (0 == xit_errno)
+        {
+            xit_errno = xsw_item.xit_errno;
+        }
+
+        xtm_4time[0] = xsw_item.xtm_4time[0];
+        xtm_4time[1] = xsw_item.xtm_4time[1];
+        xtm_4time[2] = xsw_item.xtm_4time[2];
+        xtm_4time[3] = xsw_item.xtm_4time[3];
+        *xut_leap    = xsw_item.xut_leap;
+
+        //======================================
+    } while (0);
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 客户端 的 地址缓存（序列锁 的 读取方）。
+ *
+ * @param [in ] xntp_this : 客户端对象。
+ * @param [out] xut_addrs : 返回 缓存的 IPv4 地址（主机字节序），至少 XNTP_STATE_ADDRS 项。
+ * @param [out] xtm_expire : 入参不为 X_NULL 时，返回 缓存 的 过期时刻（UTC）。
+ *
+ * @return x_uint32_t : 返回 地址数量；没有缓存 或 已过期，返回 0。
+ */
+static x_uint32_t ntpcli_addr_get(
+                        xntp_cliptr_t xntp_this,
+                        x_uint32_t xut_addrs[XNTP_STATE_ADDRS],
+                        xtime_vnsec_t * xtm_expire)
+{
+    x_uint32_t    xut_seqn  = 0;
+    x_uint32_t    xut_naddr = 0;
+    xtime_vnsec_t xtm_until = 0;
+
+    do
+    {
+        while ((xut_seqn = XATOMIC_LOAD32(&xntp_this->xut_aseqn)) & 1)
+            XATOMIC_PAUSE();
+
+        xut_naddr = xntp_this->xut_naddr;
+        xtm_until = xntp_this->xtm_aexpire;
+        memcpy(xut_addrs, xntp_this->xut_addrs, XNTP_STATE_ADDRS * sizeof(x_uint32_t));
+        XATOMIC_FENCE();
+    } while (xut_seqn != XATOMIC_LOAD32(&xntp_this->xut_aseqn));
+
+    if (X_NULL != xtm_expire)
+    {
+        *xtm_expire = xtm_until;
+    }
+
+    return ((xut_naddr <= XNTP_STATE_ADDRS) && (time_vnsec() < xtm_until)) ? xut_naddr : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 更新 客户端 的 地址缓存（其他线程 正在更新 时，直接放弃）。
+ *
+ * @param [in ] xntp_this  : 客户端对象。
+ * @param [in ] xut_addrs  : IPv4 地址（主机字节序）。
+ * @param [in ] xut_naddr  : 地址数量（取 0 时 清除缓存；超出 XNTP_STATE_ADDRS 的 部分 被忽略）。
+ * @param [in ] xut_first  : 置于 首项 的 地址 在 xut_addrs 中的 索引号（最近一次 成功请求 的 地址）。
+ * @param [in ] xtm_expire : 过期时刻（UTC）。
+ */
+static x_void_t ntpcli_addr_set(
+                    xntp_cliptr_t xntp_this,
+                    const x_uint32_t * xut_addrs,
+                    x_uint32_t xut_naddr,
+                    x_uint32_t xut_first,
+                    xtime_vnsec_t xtm_expire)
+{
+    x_uint32_t xut_seqn = XATOMIC_LOAD32(&xntp_this->xut_aseqn);
+    x_uint32_t xut_iter = 0;
+    x_uint32_t xut_nput = 0;
+
+    if ((xut_seqn & 1) || !XATOMIC_CAS32(&xntp_this->xut_aseqn, xut_seqn, xut_seqn + 1))
+    {
+        return;
+    }
+
+    xut_naddr = (xut_naddr < XNTP_STATE_ADDRS) ? xut_naddr : XNTP_STATE_ADDRS;
+    if (xut_first < xut_naddr)
+    {
+        xntp_this->xut_addrs[xut_nput++] = xut_addrs[xut_first];
+    }
+
+    for (xut_iter = 0; xut_iter < xut_naddr; ++xut_iter)
+    {
+        if (xut_iter != xut_first)
+            xntp_this->xut_addrs[xut_nput++] = xut_addrs[xut_iter];
+    }
+
+    xntp_this->xut_naddr   = xut_nput;
+    xntp_this->xtm_aexpire = xtm_expire;
+
+    XATOMIC_STORE32(&xntp_this->xut_aseqn, xut_seqn + 2);
+}
+
+/**********************************************************/
+/**
+ * @brief 首个地址 请求超时 后，将其 移到 地址缓存 的 末尾，下次 先请求 其余的 地址；
+ *        只有 一个地址 时，清除缓存，下次 重新解析 域名。
+ *
+ * @param [in ] xntp_this  : 客户端对象。
+ * @param [in ] xut_addrs  : 请求时 所用的 地址缓存（主机字节序）。
+ * @param [in ] xut_naddr  : 地址数量。
+ * @param [in ] xtm_expire : 地址缓存 的 过期时刻（UTC）。
+ */
+static x_void_t ntpcli_addr_demote(
+                    xntp_cliptr_t xntp_this,
+                    const x_uint32_t * xut_addrs,
+                    x_uint32_t xut_naddr,
+                    xtime_vnsec_t xtm_expire)
+{
+    x_uint32_t xut_order[XNTP_STATE_ADDRS];
+
+    xut_naddr = (xut_naddr < XNTP_STATE_ADDRS) ? xut_naddr : XNTP_STATE_ADDRS;
+    if (xut_naddr < 2)
+    {
+        ntpcli_addr_set(xntp_this, X_NULL, 0, 0, 0);
+        return;
+    }
+
+    memcpy(xut_order, xut_addrs + 1, (xut_naddr - 1) * sizeof(x_uint32_t));
+    xut_order[xut_naddr - 1] = xut_addrs[0];
+
+    ntpcli_addr_set(xntp_this, xut_order, xut_naddr, 0, xtm_expire);
+}
+
+/**********************************************************/
+/**
+ * @brief 依次请求 地址列表 时，当前地址 的 截止时间：
+ *        剩余的 等待时间 由 尚未请求的 各个地址 平分，不应答的 地址 不会 耗尽 全部时间。
+ *
+ * @param [in ] xtm_dline : 整体的 截止时间（XTIME_INVALID_VNSEC 表示无限等待）。
+ * @param [in ] xut_nleft : 尚未请求的 地址数量（含 当前地址）。
+ *
+ * @return xtime_vnsec_t : 当前地址 的 截止时间（最后一个地址 即为 整体的 截止时间）。
+ */
+static xtime_vnsec_t ntpcli_addr_dline(xtime_vnsec_t xtm_dline, x_uint32_t xut_nleft)
+{
+    xtime_vnsec_t xtm_mono = time_mono();
+
+    if (!XTMVNSEC_IS_VALID(xtm_dline) || (xut_nleft < 2) || (xtm_mono >= xtm_dline))
+    {
+        return xtm_dline;
+    }
+
+    return xtm_mono + (xtm_dline - xtm_mono) / xut_nleft;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 域名，得到 IPv4 地址 列表。
+ * @note
+ * 域名解析（getaddrinfo()）本身为阻塞操作，无法被中途打断。
+ *
+ * @param [in ] xszt_name : 域名。
+ * @param [out] xut_addrs : 返回 IPv4 地址（主机字节序），至多 XNTP_STATE_ADDRS 项。
+ * @param [out] xut_naddr : 返回 地址数量。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 getaddrinfo() 的 错误码。
+ */
+static x_int32_t ntpcli_resolve(
+                    x_cstring_t xszt_name,
+                    x_uint32_t xut_addrs[XNTP_STATE_ADDRS],
+                    x_uint32_t * xut_naddr)
+{
+    x_int32_t xit_errno = EPERM;
+
+    struct addrinfo   xai_hint;
+    struct addrinfo * xai_rptr = X_NULL;
+    struct addrinfo * xai_iptr = X_NULL;
+
+    *xut_naddr = 0;
+
+    memset(&xai_hint, 0, sizeof(xai_hint));
+    xai_hint.ai_family   = AF_INET;
+    xai_hint.ai_socktype = SOCK_DGRAM;
+
+    xit_errno = getaddrinfo(xszt_name, X_NULL, &xai_hint, &xai_rptr);
+    if (0 != xit_errno)
+    {
+        return xit_errno;
+    }
+
+    for (xai_iptr = xai_rptr;
+         (X_NULL != xai_iptr) && (*xut_naddr < XNTP_STATE_ADDRS);
+         xai_iptr = xai_iptr->ai_next)
+    {
+        if (AF_INET != xai_iptr->ai_family)
+        {
+            continue;
+        }
+
+        xut_addrs[(*xut_naddr)++] =
+            ntohl(((struct sockaddr_in *)(xai_iptr->ai_addr))->sin_addr.s_addr);
+    }
+
+    freeaddrinfo(xai_rptr);
+
+    return (*xut_naddr > 0) ? 0 : EADDRNOTAVAIL;
+}
+
+/**********************************************************/
+/**
+ * @brief 依次 向 地址列表 中的 各个地址 发送 NTP 请求，直至 成功。
+ * @note
+ * 与 ntpcli_get_4T() 相同，以只含一个请求项的 批量请求 完成；
+ * 剩余的 等待时间 由 尚未请求的 地址 平分（参看 ntpcli_addr_dline()），某个地址 超时 后 继续 请求 下一个；
+ * 截止时间已过，则不再尝试余下的地址，返回 ETIMEDOUT。
+ *
+ * @param [in ] xfdt_sockfd : 网络通信使用的 套接字。
+ * @param [in ] xkey_table : 认证所用的 密钥表。
+ * @param [in ] xut_keyid : 认证所用的 key ID（取 0 时 不认证）。
+ * @param [in ] xnts_sess : NTS 会话（可为 X_NULL）。
+ * @param [in ] xut_addrs : IPv4 地址（主机字节序）列表。
+ * @param [in ] xut_naddr : 地址数量。
+ * @param [in ] xut_port  : NTP 服务器的 端口号。
+ * @param [out] xtm_4time : 操作返回的 4 个相关时间戳。
+ * @param [out] xut_leap  : 操作成功时，返回 应答的 LI。
+ * @param [out] xut_used  : 操作成功时，返回 应答地址 在 列表 中的 索引号。
+ * @param [in ] xtm_dline : 单调时钟的截止时间（XTIME_INVALID_VNSEC 表示无限等待）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpcli_get_4T_by_list(
+                        x_sockfd_t xfdt_sockfd,
+                        xntp_keyptr_t xkey_table,
+                        x_uint32_t xut_keyid,
+                        xntp_ntsptr_t xnts_sess,
+                        const x_uint32_t * xut_addrs,
+                        x_uint32_t xut_naddr,
+                        x_uint16_t xut_port,
+                        xtime_vnsec_t xtm_4time[4],
+                        x_uint32_t * xut_leap,
+                        x_uint32_t * xut_used,
+                        xtime_vnsec_t xtm_dline)
+{
+    x_int32_t    xit_errno = EADDRNOTAVAIL;
+    x_uint32_t   xut_iter  = 0;
+    xntp_sweep_t xsw_item;
+
+    for (xut_iter = 0; xut_iter < xut_naddr; ++xut_iter)
+    {
+        if (XTMVNSEC_IS_VALID(xtm_dline) && (time_mono() >= xtm_dline))
+        {
+            xit_errno = ETIMEDOUT;
+            break;
+        }
+
+        xsw_item.xut_ipv4  = xut_addrs[xut_iter];
+        xsw_item.xut_port  = xut_port;
+        xsw_item.xut_keyid = xut_keyid;
+
+        xit_errno = ntpcli_sweep(xfdt_sockfd, xkey_table, xnts_sess, &xsw_item, 1,
+                                 ntpcli_addr_dline(xtm_dline, xut_naddr - xut_iter));
+        if (0 == xit_errno)
+        {
+            xit_errno = xsw_item.xit_errno;
+        }
+
+        if (0 == xit_errno)
+        {
+            xtm_4time[0] = xsw_item.xtm_4time[0];
+            xtm_4time[1] = xsw_item.xtm_4time[1];
+            xtm_4time[2] = xsw_item.xtm_4time[2];
+            xtm_4time[3] = xsw_item.xtm_4time[3];
+            *xut_leap    = xsw_item.xut_leap;
+            *xut_used    = xut_iter;
+            break;
+        }
+    }
+
+    return xit_errno;
+}
+
+//====================================================================
+
+/** 对冲请求：一次 对冲请求 消耗的 令牌（预算 以 千分比 计） */
+#define XNTP_HEDGE_TOKEN    1000
+
+/** 对冲请求：令牌桶 的 容量（次） */
+#define XNTP_HEDGE_BURST    4
+
+/** 对冲请求：往返时延 的 样本 少于 该数量 时，按 XNTP_HEDGE_INIT 对冲 */
+#define XNTP_HEDGE_WARM     4
+
+/** 对冲请求：尚无 往返时延 统计 的 地址，等待 该时长（毫秒）后 对冲 */
+#define XNTP_HEDGE_INIT     250
+
+/** 对冲请求：等待时长 的 下限（100 纳秒），避免 调度抖动 引起 不必要的 对冲 */
+#define XNTP_HEDGE_FLOOR    ((xtime_vnsec_t)XTIME_VNSEC_MSEC)
+
+/**********************************************************/
+/**
+ * @brief 查找 地址 的 往返时延 统计项。
+ * @note
+ * 统计项 只有 XNTP_STATE_ADDRS 个，线性查找；多个线程 同时更新 时 可能 丢失 个别样本，不影响 请求 的 正确性。
+ *
+ * @param [in ] xntp_this  : 客户端对象。
+ * @param [in ] xut_ipv4   : 服务端 地址（主机字节序）。
+ * @param [in ] xbt_create : 未找到 时，是否 将 样本最少的 一项（空项 优先）改为 该地址。
+ *
+ * @return xntp_rtt_t * : 返回 统计项；未找到 且 不创建 时，返回 X_NULL。
+ */
+static xntp_rtt_t * ntpcli_rtt_slot(xntp_cliptr_t xntp_this, x_uint32_t xut_ipv4, x_bool_t xbt_create)
+{
+    x_uint32_t   xut_iter  = 0;
+    xntp_rtt_t * xrtt_iter = X_NULL;
+    xntp_rtt_t * xrtt_free = &xntp_this->xrtt_list[0];
+
+    for (xut_iter = 0; xut_iter < XNTP_STATE_ADDRS; ++xut_iter)
+    {
+        xrtt_iter = &xntp_this->xrtt_list[xut_iter];
+        if (xut_ipv4 == XATOMIC_LOAD32(&xrtt_iter->xut_ipv4))
+        {
+            return xrtt_iter;
+        }
+
+        if (XATOMIC_LOAD32(&xrtt_iter->xut_count) < XATOMIC_LOAD32(&xrtt_free->xut_count))
+        {
+            xrtt_free = xrtt_iter;
+        }
+    }
+
+    if (!xbt_create)
+    {
+        return X_NULL;
+    }
+
+    XATOMIC_STORE32(&xrtt_free->xut_count, 0);
+    XATOMIC_STORE32(&xrtt_free->xut_ipv4, xut_ipv4);
+
+    return xrtt_free;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 一次 有效应答 的 往返时延 更新 地址 的 统计（与 TCP 的 SRTT/RTTVAR 相同，增益 取 1/8、1/4）。
+ */
+static x_void_t ntpcli_rtt_update(xntp_cliptr_t xntp_this, x_uint32_t xut_ipv4, xtime_vnsec_t xtm_rtt)
+{
+    xntp_rtt_t * xrtt_this  = ntpcli_rtt_slot(xntp_this, xut_ipv4, X_TRUE);
+    x_uint32_t   xut_rtt    = (xtm_rtt < 0xFFFFFFFFULL) ? (x_uint32_t)xtm_rtt : 0xFFFFFFFF;
+    x_uint32_t   xut_srtt   = XATOMIC_LOAD32(&xrtt_this->xut_srtt);
+    x_uint32_t   xut_rttvar = XATOMIC_LOAD32(&xrtt_this->xut_rttvar);
+    x_uint32_t   xut_diff   = 0;
+
+    if (0 == XATOMIC_LOAD32(&xrtt_this->xut_count))
+    {
+        xut_srtt   = xut_rtt;
+        xut_rttvar = xut_rtt / 2;
+    }
+    else
+    {
+        xut_diff   = (xut_srtt > xut_rtt) ? (xut_srtt - xut_rtt) : (xut_rtt - xut_srtt);
+        xut_rttvar = xut_rttvar - (xut_rttvar / 4) + (xut_diff / 4);
+        xut_srtt   = xut_srtt - (xut_srtt / 8) + (xut_rtt / 8);
+    }
+
+    XATOMIC_STORE32(&xrtt_this->xut_srtt, xut_srtt);
+    XATOMIC_STORE32(&xrtt_this->xut_rttvar, xut_rttvar);
+    XATOMIC_ADD32(&xrtt_this->xut_count, 1);
+}
+
+/**********************************************************/
+/**
+ * @brief 估计 地址 往返时延 的 p95（平滑均值 加 2 倍 平均偏差），即 主请求 发出后 等待 该时长 再 对冲。
+ */
+static xtime_vnsec_t ntpcli_rtt_p95(xntp_cliptr_t xntp_this, x_uint32_t xut_ipv4)
+{
+    xntp_rtt_t  * xrtt_this = ntpcli_rtt_slot(xntp_this, xut_ipv4, X_FALSE);
+    xtime_vnsec_t xtm_p95   = (xtime_vnsec_t)XNTP_HEDGE_INIT * XTIME_VNSEC_MSEC;
+
+    if ((X_NULL != xrtt_this) && (XATOMIC_LOAD32(&xrtt_this->xut_count) >= XNTP_HEDGE_WARM))
+    {
+        xtm_p95 = (xtime_vnsec_t)XATOMIC_LOAD32(&xrtt_this->xut_srtt) +
+                  (xtime_vnsec_t)XATOMIC_LOAD32(&xrtt_this->xut_rttvar) * 2;
+    }
+
+    return (xtm_p95 > XNTP_HEDGE_FLOOR) ? xtm_p95 : XNTP_HEDGE_FLOOR;
+}
+
+/**********************************************************/
+/**
+ * @brief 可对冲的 请求 积累 令牌（每次 xut_hbudget，至多 XNTP_HEDGE_BURST 次 对冲请求）。
+ */
+static x_void_t ntpcli_hedge_credit(xntp_cliptr_t xntp_this, x_uint32_t xut_budget)
+{
+    x_uint32_t xut_token = 0;
+    x_uint32_t xut_value = 0;
+
+    XATOMIC_ADD32(&xntp_this->xut_hreqs, 1);
+
+    do
+    {
+        xut_token = XATOMIC_LOAD32(&xntp_this->xut_htoken);
+        if (xut_token >= XNTP_HEDGE_BURST * XNTP_HEDGE_TOKEN)
+        {
+            break;
+        }
+
+        xut_value = xut_token + xut_budget;
+        if (xut_value > XNTP_HEDGE_BURST * XNTP_HEDGE_TOKEN)
+        {
+            xut_value = XNTP_HEDGE_BURST * XNTP_HEDGE_TOKEN;
+        }
+    } while (!XATOMIC_CAS32(&xntp_this->xut_htoken, xut_token, xut_value));
+}
+
+/**********************************************************/
+/**
+ * @brief 取用 一次 对冲请求 的 令牌。
+ *
+ * @return x_bool_t : 令牌 足够，返回 X_TRUE；否则 返回 X_FALSE（本次 不对冲）。
+ */
+static x_bool_t ntpcli_hedge_take(xntp_cliptr_t xntp_this)
+{
+    x_uint32_t xut_token = 0;
+
+    do
+    {
+        xut_token = XATOMIC_LOAD32(&xntp_this->xut_htoken);
+        if (xut_token < XNTP_HEDGE_TOKEN)
+        {
+            return X_FALSE;
+        }
+    } while (!XATOMIC_CAS32(&xntp_this->xut_htoken, xut_token, xut_token - XNTP_HEDGE_TOKEN));
+
+    XATOMIC_ADD32(&xntp_this->xut_hsent, 1);
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 向 地址列表 发送 NTP 请求：开启 对冲 时，前两个地址 以 对冲请求 竞速，否则 依次请求。
+ * @note
+ * xntp_cache 为 X_NULL、未开启 对冲（参看 ntpcli_hedge()）或 只有 一个地址 时，等同于 ntpcli_get_4T_by_list()。
+ * 对冲时，先 向 首个地址 发送 主请求，至 其 往返时延 的 p95 仍在等待，且 预算 允许，再 向 第二个地址 发送，
+ * 两者 共用 同一套接字 与 截止时间，取 先到的 有效应答；主请求 已失败 时，直接 请求 第二个地址（不计入 预算）。
+ * 两个地址 均失败 且 截止时间 未到 时，依次 请求 余下的 地址。
+ *
+ * @param [in ] xntp_cache : 持有 对冲预算 与 往返时延 统计 的 客户端对象（可为 X_NULL）。
+ * 其余参数 与 ntpcli_get_4T_by_list() 相同。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpcli_get_4T_hedge(
+                        x_sockfd_t xfdt_sockfd,
+                        xntp_keyptr_t xkey_table,
+                        x_uint32_t xut_keyid,
+                        xntp_ntsptr_t xnts_sess,
+                        xntp_cliptr_t xntp_cache,
+                        const x_uint32_t * xut_addrs,
+                        x_uint32_t xut_naddr,
+                        x_uint16_t xut_port,
+                        xtime_vnsec_t xtm_4time[4],
+                        x_uint32_t * xut_leap,
+                        x_uint32_t * xut_used,
+                        xtime_vnsec_t xtm_dline)
+{
+    x_int32_t        xit_errno  = EPERM;
+    x_uint32_t       xut_budget = 0;
+    x_uint32_t       xut_iter   = 0;
+    x_uint32_t       xut_win    = 2;
+    x_bool_t         xbt_second = X_FALSE;
+    x_bool_t         xbt_hedged = X_FALSE;
+    xtime_vnsec_t    xtm_hedge  = XTIME_INVALID_VNSEC;
+    xntp_sweep_t     xsw_list[2];
+    xntp_sweep_ctx_t xctx_this;
+    xntp_sweep_ctx_t xctx_next;
+
+    if (X_NULL != xntp_cache)
+    {
+        xut_budget = XATOMIC_LOAD32(&xntp_cache->xut_hbudget);
+    }
+
+    if ((0 == xut_budget) || (X_NULL != xnts_sess) || (xut_naddr < 2))
+    {
+        return ntpcli_get_4T_by_list(xfdt_sockfd, xkey_table, xut_keyid, xnts_sess,
+                                     xut_addrs, xut_naddr, xut_port,
+                                     xtm_4time, xut_leap, xut_used, xtm_dline);
+    }
+
+    ntpcli_hedge_credit(xntp_cache, xut_budget);
+
+    //======================================
+    // 主请求（两个请求项，不建立索引表，无须 ntp_sweep_release()）
+
+    for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+    {
+        xsw_list[xut_iter].xut_ipv4  = xut_addrs[xut_iter];
+        xsw_list[xut_iter].xut_port  = xut_port;
+        xsw_list[xut_iter].xut_keyid = xut_keyid;
+    }
+
+    ntp_sweep_init(&xctx_this, xfdt_sockfd, xkey_table, X_NULL, xsw_list, 2);
+    xctx_this.xbt_first = X_TRUE;
+
+    xctx_this.xut_count = 1;
+    ntp_sweep_send(&xctx_this);
+    xctx_this.xut_count = 2;
+
+    xtm_hedge = time_mono() + ntpcli_rtt_p95(xntp_cache, xut_addrs[0]);
+    if (XTMVNSEC_IS_VALID(xtm_dline) && (xtm_dline < xtm_hedge))
+    {
+        xtm_hedge = xtm_dline;
+    }
+
+    xit_errno = ntp_sweep_wait(&xctx_this, xtm_hedge);
+
+    //======================================
+    // 主请求 尚无 有效应答：仍在等待 时 按预算 对冲，已失败 时 直接 请求 第二个地址
+
+    if ((0 == xit_errno) &&
+        (0 != xsw_list[0].xit_errno) &&
+        (!XTMVNSEC_IS_VALID(xtm_dline) || (time_mono() < xtm_dline)))
+    {
+        xbt_hedged = XSWEEP_PENDING(&xsw_list[0]);
+        xbt_second = !xbt_hedged || ntpcli_hedge_take(xntp_cache);
+        xbt_hedged = xbt_hedged && xbt_second;
+
+        if (xbt_second)
+        {
+            xctx_next = xctx_this;
+            xctx_next.xsw_list    = &xsw_list[1];
+            xctx_next.xut_count   = 1;
+            xctx_next.xut_pending = 0;
+            ntp_sweep_send(&xctx_next);
+            xctx_this.xut_pending += xctx_next.xut_pending;
+        }
+
+        xit_errno = ntp_sweep_wait(&xctx_this, xtm_dline);
+    }
+
+    //======================================
+    // 有效应答 更新 往返时延 统计
+
+    for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+    {
+        if (0 == xsw_list[xut_iter].xit_errno)
+        {
+            ntpcli_rtt_update(xntp_cache,
+                              xsw_list[xut_iter].xut_ipv4,
+                              xsw_list[xut_iter].xtm_4time[3] - xsw_list[xut_iter].xtm_4time[0]);
+            xut_win = xut_iter;
+        }
+    }
+
+    if (xut_win < 2)
+    {
+        if (xbt_hedged && (1 == xut_win))
+        {
+            XATOMIC_ADD32(&xntp_cache->xut_hwins, 1);
+        }
+
+        xtm_4time[0] = xsw_list[xut_win].xtm_4time[0];
+        xtm_4time[1] = xsw_list[xut_win].xtm_4time[1];
+        xtm_4time[2] = xsw_list[xut_win].xtm_4time[2];
+        xtm_4time[3] = xsw_list[xut_win].xtm_4time[3];
+        *xut_leap    = xsw_list[xut_win].xut_leap;
+        *xut_used    = xut_win;
+        return 0;
+    }
+
+    if (0 != xit_errno)
+    {
+        return xit_errno;
+    }
+
+    //======================================
+    // 两个地址 均失败，依次 请求 余下的 地址
+
+    xit_errno = xsw_list[xbt_second ? 1 : 0].xit_errno;
+    if (xut_naddr > 2)
+    {
+        xit_errno = ntpcli_get_4T_by_list(xfdt_sockfd, xkey_table, xut_keyid, X_NULL,
+                                          xut_addrs + 2, xut_naddr - 2, xut_port,
+                                          xtm_4time, xut_leap, xut_used, xtm_dline);
+        if (0 == xit_errno)
+        {
+            *xut_used += 2;
+        }
+    }
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 向 NTP 服务器发送 NTP 请求，获取相关计算所需的时间戳。
+ * @note
+ * xntp_cache 不为 X_NULL 时，先使用 其 地址缓存（未过期），全部失败 后 才 重新解析 域名；
+ * 解析所得的 地址 写入 缓存，最近一次 成功请求 的 地址 排在首位，下次 优先使用；
+ * 缓存的 地址 请求超时 时，不再 重新解析，首个地址 移到 缓存末尾（参看 ntpcli_addr_demote()）。
+ * 域名解析（getaddrinfo()）本身为阻塞操作，无法被中途打断，
+ * 只能在其返回后检测截止时间。
+ *
+ * @param [in ] xfdt_sockfd : 网络通信使用的 套接字。
+ * @param [in ] xkey_table : 认证所用的 密钥表。
+ * @param [in ] xut_keyid : 认证所用的 key ID（取 0 时 不认证）。
+ * @param [in ] xnts_sess : NTS 会话（可为 X_NULL）。
+ * @param [in ] xntp_cache : 持有 xszt_name 地址缓存（与 对冲预算）的 客户端对象（可为 X_NULL）。
+ * @param [in ] xszt_name : NTP 服务器的 域名。
+ * @param [in ] xut_port  : NTP 服务器的 端口号。
+ * @param [out] xtm_4time : 操作返回的 4 个相关时间戳。
+ * @param [out] xut_leap  : 操作成功时，返回 应答的 LI。
+ * @param [in ] xtm_dline : 单调时钟的截止时间（XTIME_INVALID_VNSEC 表示无限等待）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpcli_get_4T_by_name(
+                        x_sockfd_t xfdt_sockfd,
+                        xntp_keyptr_t xkey_table,
+                        x_uint32_t xut_keyid,
+                        xntp_ntsptr_t xnts_sess,
+                        xntp_cliptr_t xntp_cache,
+                        x_cstring_t xszt_name,
+                        x_uint16_t xut_port,
+                        xtime_vnsec_t xtm_4time[4],
+                        x_uint32_t * xut_leap,
+                        xtime_vnsec_t xtm_dline)
+{
+    x_int32_t     xit_errno = EPERM;
+    x_uint32_t    xut_naddr = 0;
+    x_uint32_t    xut_used  = 0;
+    xtime_vnsec_t xtm_until = 0;
+    x_uint32_t    xut_addrs[XNTP_STATE_ADDRS];
+
+    if (X_NULL == xszt_name)
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 地址缓存
+
+    if (X_NULL != xntp_cache)
+    {
+        xut_naddr = ntpcli_addr_get(xntp_cache, xut_addrs, &xtm_until);
+        if (xut_naddr > 0)
+        {
+            xit_errno = ntpcli_get_4T_hedge(xfdt_sockfd, xkey_table, xut_keyid, xnts_sess, xntp_cache,
+                                            xut_addrs, xut_naddr, xut_port,
+                                            xtm_4time, xut_leap, &xut_used, xtm_dline);
+            if (0 == xit_errno)
+            {
+                if (0 != xut_used)
+                    ntpcli_addr_set(xntp_cache, xut_addrs, xut_naddr, xut_used, xtm_until);
+                return 0;
+            }
+
+            if (ETIMEDOUT == xit_errno)
+            {
+                ntpcli_addr_demote(xntp_cache, xut_addrs, xut_naddr, xtm_until);
+                return xit_errno;
+            }
+        }
+    }
+
+    //======================================
+    // 重新解析
+
+    xit_errno = ntpcli_resolve(xszt_name, xut_addrs, &xut_naddr);
+    if (0 != xit_errno)
+    {
+        return xit_errno;
+    }
+
+    xit_errno = ntpcli_get_4T_hedge(xfdt_sockfd, xkey_table, xut_keyid, xnts_sess, xntp_cache,
+                                    xut_addrs, xut_naddr, xut_port,
+                                    xtm_4time, xut_leap, &xut_used, xtm_dline);
+    if (X_NULL != xntp_cache)
+    {
+        ntpcli_addr_set(xntp_cache, xut_addrs, xut_naddr, (0 == xit_errno) ? xut_used : 0,
+                        time_vnsec() + (xtime_vnsec_t)XNTP_STATE_ADDR_TTL * 1000ULL * XTIME_VNSEC_MSEC);
+    }
+
+    return xit_errno;
+}
+
+/** 突发请求 首轮 的 最长等待时间（毫秒） */
+#define XNTP_IBURST_WAIT    1000
+
+/** 突发请求 之后各轮 在 已观测 最大时延 的 2 倍 之外，额外等待的 时间（毫秒） */
+#define XNTP_IBURST_SLACK   20
+
+/**********************************************************/
+/**
+ * @brief 突发请求：向 服务端 的 各个地址 并行地 连续请求 若干轮，以 最小时延 选取 样本（参看 ntpcli_req_burst()）。
+ *
+ * @param [in ] xfdt_sockfd : 网络通信使用的 套接字。
+ * @param [in ] xkey_table : 认证所用的 密钥表。
+ * @param [in ] xut_keyid : 认证所用的 key ID（取 0 时 不认证）。
+ * @param [in ] xnts_sess : NTS 会话（可为 X_NULL；非空时 只请求 一个地址）。
+ * @param [in ] xntp_cache : 持有 xszt_host 地址缓存 的 客户端对象（可为 X_NULL）。
+ * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名。
+ * @param [in ] xut_port  : NTP 服务器的 端口号。
+ * @param [in ] xut_count : 轮数（1 ~ XNTP_IBURST_MAX）。
+ * @param [in ] xut_gap   : 相邻 两轮 开始时刻 的 最小间隔（毫秒）。
+ * @param [out] xtm_4time : 返回 选中样本 的 4 个相关时间戳。
+ * @param [out] xut_leap  : 操作成功时，返回 选中样本 的 LI。
+ * @param [out] xburst_ptr : 入参不为 X_NULL 时，返回 统计 与 选中样本。
+ * @param [in ] xtm_dline : 单调时钟的截止时间（XTIME_INVALID_VNSEC 表示无限等待）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpcli_get_4T_burst(
+                        x_sockfd_t xfdt_sockfd,
+                        xntp_keyptr_t xkey_table,
+                        x_uint32_t xut_keyid,
+                        xntp_ntsptr_t xnts_sess,
+                        xntp_cliptr_t xntp_cache,
+                        x_cstring_t xszt_host,
+                        x_uint16_t xut_port,
+                        x_uint32_t xut_count,
+                        x_uint32_t xut_gap,
+                        xtime_vnsec_t xtm_4time[4],
+                        x_uint32_t * xut_leap,
+                        xntp_burst_t * xburst_ptr,
+                        xtime_vnsec_t xtm_dline)
+{
+    x_int32_t     xit_errno = 0;
+    x_int32_t     xit_lerr  = ETIMEDOUT;
+    x_uint32_t    xut_naddr = 0;
+    x_uint32_t    xut_nsend = 0;
+    x_uint32_t    xut_round = 0;
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_jter  = 0;
+    x_uint32_t    xut_best  = XNTP_STATE_ADDRS;
+    x_uint32_t    xut_reps  = 0;
+    x_int64_t     xit_delay = 0;
+    x_int64_t     xit_dmax  = 0;
+    x_int64_t     xit_bdist = 0;
+    x_int64_t     xit_dist  = 0;
+    x_int64_t     xit_diff  = 0;
+    xtime_vnsec_t xtm_start = time_mono();
+    xtime_vnsec_t xtm_round = xtm_start;
+    xtime_vnsec_t xtm_rdline = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t xtm_until = 0;
+    x_uint32_t    xut_addrs[XNTP_STATE_ADDRS];
+    x_uint32_t    xut_index[XNTP_STATE_ADDRS];
+    x_uint32_t    xut_nsamp[XNTP_STATE_ADDRS];
+    x_int64_t     xit_bdelay[XNTP_STATE_ADDRS];
+    x_int64_t     xit_spread[XNTP_STATE_ADDRS];
+    x_int64_t     xit_offs[XNTP_STATE_ADDRS][XNTP_IBURST_MAX];
+    xntp_sweep_t  xsw_best[XNTP_STATE_ADDRS];
+    xntp_sweep_t  xsw_list[XNTP_STATE_ADDRS];
+
+    //======================================
+    // 服务端 的 地址列表（重复的 地址 只请求一次）
+
+    if (name_is_ipv4(xszt_host, &xut_addrs[0]))
+    {
+        xut_naddr = 1;
+    }
+    else
+    {
+        if (X_NULL != xntp_cache)
+        {
+            xut_naddr = ntpcli_addr_get(xntp_cache, xut_addrs, &xtm_until);
+        }
+
+        if (0 == xut_naddr)
+        {
+            xit_errno = ntpcli_resolve(xszt_host, xut_addrs, &xut_naddr);
+            if (0 != xit_errno)
+            {
+                return xit_errno;
+            }
+
+            xtm_until = time_vnsec() + (xtime_vnsec_t)XNTP_STATE_ADDR_TTL * 1000ULL * XTIME_VNSEC_MSEC;
+        }
+    }
+
+    for (xut_iter = 1, xut_jter = 1; xut_iter < xut_naddr; ++xut_iter)
+    {
+        for (xut_reps = 0; xut_reps < xut_jter; ++xut_reps)
+        {
+            if (xut_addrs[xut_reps] == xut_addrs[xut_iter])
+                break;
+        }
+
+        if (xut_reps == xut_jter)
+            xut_addrs[xut_jter++] = xut_addrs[xut_iter];
+    }
+
+    if (xut_naddr > 0)
+    {
+        xut_naddr = xut_jter;
+    }
+
+    // NTS 的 批量请求 只能含 一个请求项
+    if ((X_NULL != xnts_sess) && (xut_naddr > 1))
+    {
+        xut_naddr = 1;
+    }
+
+    memset(xut_nsamp, 0, sizeof(xut_nsamp));
+    xut_reps = 0;
+
+    //======================================
+    // 各轮 请求
+
+    for (xut_round = 0; xut_round < xut_count; ++xut_round)
+    {
+        // 首轮 之后，只向 有应答的 地址 继续请求
+        for (xut_iter = 0, xut_nsend = 0; xut_iter < xut_naddr; ++xut_iter)
+        {
+            if ((0 != xut_round) && (0 == xut_nsamp[xut_iter]))
+                continue;
+
+            xsw_list[xut_nsend].xut_ipv4  = xut_addrs[xut_iter];
+            xsw_list[xut_nsend].xut_port  = xut_port;
+            xsw_list[xut_nsend].xut_keyid = xut_keyid;
+            xut_index[xut_nsend++] = xut_iter;
+        }
+
+        if (0 == xut_nsend)
+        {
+            break;
+        }
+
+        if ((xut_round > 0) && (xut_gap > 0))
+        {
+            xtm_rdline = xtm_round + (xtime_vnsec_t)xut_gap * XTIME_VNSEC_MSEC;
+            if (XTMVNSEC_IS_VALID(xtm_dline) && (xtm_rdline > xtm_dline))
+                xtm_rdline = xtm_dline;
+            if (xtm_rdline > time_mono())
+                ntp_sleep(xtm_rdline - time_mono());
+        }
+
+        xtm_round = time_mono();
+        if (XTMVNSEC_IS_VALID(xtm_dline) && (xtm_round >= xtm_dline))
+        {
+            break;
+        }
+
+        xtm_rdline = xtm_round + ((0 == xut_round) ?
+                        (xtime_vnsec_t)XNTP_IBURST_WAIT * XTIME_VNSEC_MSEC :
+                        (xtime_vnsec_t)(2 * xit_dmax) + (xtime_vnsec_t)XNTP_IBURST_SLACK * XTIME_VNSEC_MSEC);
+        if (XTMVNSEC_IS_VALID(xtm_dline) && (xtm_rdline > xtm_dline))
+        {
+            xtm_rdline = xtm_dline;
+        }
+
+        xit_errno = ntpcli_sweep(xfdt_sockfd, xkey_table, xnts_sess, xsw_list, xut_nsend, xtm_rdline);
+        if (0 != xit_errno)
+        {
+            break;
+        }
+
+        //======================================
+        // 记录 样本：每个 地址 保留 时延最小 的 样本
+
+        for (xut_jter = 0; xut_jter < xut_nsend; ++xut_jter)
+        {
+            xntp_sweep_t * xsw_item = &xsw_list[xut_jter];
+
+            xut_iter = xut_index[xut_jter];
+            if (0 != xsw_item->xit_errno)
+            {
+                xit_lerr = xsw_item->xit_errno;
+                continue;
+            }
+
+            xit_delay = ((x_int64_t)(xsw_item->xtm_4time[3] - xsw_item->xtm_4time[0]) -
+                         (x_int64_t)(xsw_item->xtm_4time[2] - xsw_item->xtm_4time[1]));
+            xit_delay = (xit_delay > 0) ? xit_delay : 0;
+
+            xit_offs[xut_iter][xut_nsamp[xut_iter]] =
+                (x_int64_t)(xsw_item->xtm_vnsec - xsw_item->xtm_4time[3]);
+            if ((0 == xut_nsamp[xut_iter]) || (xit_delay < xit_bdelay[xut_iter]))
+            {
+                xit_bdelay[xut_iter] = xit_delay;
+                xsw_best[xut_iter]   = *xsw_item;
+            }
+
+            xut_nsamp[xut_iter] += 1;
+            xut_reps += 1;
+            xit_dmax  = (xit_delay > xit_dmax) ? xit_delay : xit_dmax;
+        }
+    }
+
+    //======================================
+    // 选取 服务端：有效样本 不少于 轮数的一半，时延的一半 加上 样本偏差 最小
+
+    for (xut_iter = 0; xut_iter < xut_naddr; ++xut_iter)
+    {
+        if ((0 == xut_nsamp[xut_iter]) || ((xut_nsamp[xut_iter] * 2) < xut_count))
+            continue;
+
+        xit_spread[xut_iter] = 0;
+        for (xut_jter = 0; xut_jter < xut_nsamp[xut_iter]; ++xut_jter)
+        {
+            xit_diff = xit_offs[xut_iter][xut_jter] -
+                       (x_int64_t)(xsw_best[xut_iter].xtm_vnsec - xsw_best[xut_iter].xtm_4time[3]);
+            xit_diff = (xit_diff < 0) ? -xit_diff : xit_diff;
+            xit_spread[xut_iter] = (xit_diff > xit_spread[xut_iter]) ? xit_diff : xit_spread[xut_iter];
+        }
+
+        xit_dist = xit_bdelay[xut_iter] / 2 + xit_spread[xut_iter];
+        if ((XNTP_STATE_ADDRS == xut_best) || (xit_dist < xit_bdist))
+        {
+            xut_best  = xut_iter;
+            xit_bdist = xit_dist;
+        }
+    }
+
+    if (X_NULL != xburst_ptr)
+    {
+        memset(xburst_ptr, 0, sizeof(xntp_burst_t));
+        xburst_ptr->xut_servers = xut_naddr;
+        xburst_ptr->xut_replies = xut_reps;
+        xburst_ptr->xtm_elapsed = time_mono() - xtm_start;
+    }
+
+    if (XNTP_STATE_ADDRS == xut_best)
+    {
+        return (0 != xit_errno) ? xit_errno : xit_lerr;
+    }
+
+    //======================================
+
+    xtm_4time[0] = xsw_best[xut_best].xtm_4time[0];
+    xtm_4time[1] = xsw_best[xut_best].xtm_4time[1];
+    xtm_4time[2] = xsw_best[xut_best].xtm_4time[2];
+    xtm_4time[3] = xsw_best[xut_best].xtm_4time[3];
+    *xut_leap    = xsw_best[xut_best].xut_leap;
+
+    if (X_NULL != xburst_ptr)
+    {
+        xburst_ptr->xut_ipv4    = xut_addrs[xut_best];
+        xburst_ptr->xut_samples = xut_nsamp[xut_best];
+        xburst_ptr->xit_offset  = (x_int64_t)(xsw_best[xut_best].xtm_vnsec - xtm_4time[3]);
+        xburst_ptr->xit_delay   = xit_bdelay[xut_best];
+        xburst_ptr->xit_spread  = xit_spread[xut_best];
+    }
+
+    // 选中的 地址 排在 地址缓存 的 首位
+    if ((X_NULL != xntp_cache) && (0 != xtm_until))
+    {
+        ntpcli_addr_set(xntp_cache, xut_addrs, xut_naddr, xut_best, xtm_until);
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 保存 客户端 的 热启动状态（参看 ntpcli_state()）。
+ * @note
+ * 距 上次保存 不足 XNTP_STATE_PERIOD 秒 时 跳过（xbt_force 除外）；多个线程 同时到期 时，只有一个 执行保存。
+ *
+ * @return x_int32_t : 已保存 或 跳过，返回 0；否则 返回 ntpstate_save() 的 错误码。
+ */
+static x_int32_t ntpcli_state_save(xntp_cliptr_t xntp_this, x_bool_t xbt_force)
+{
+    x_uint32_t     xut_last = 0;
+    x_uint32_t     xut_curr = 0;
+    xntp_clkstat_t xclk_stat;
+    xntp_state_t   xstate;
+
+    if ('\0' == xntp_this->xszt_state[0])
+    {
+        return 0;
+    }
+
+    // 以 单调时钟 的 秒数 加 1 记录 保存时刻（0 表示 尚未保存）
+    xut_curr = (x_uint32_t)(time_mono() / (1000ULL * XTIME_VNSEC_MSEC)) + 1;
+    xut_last = XATOMIC_LOAD32(&xntp_this->xut_saved);
+    if (!xbt_force && (0 != xut_last) && (xut_curr - xut_last < XNTP_STATE_PERIOD))
+    {
+        return 0;
+    }
+
+    if (!XATOMIC_CAS32(&xntp_this->xut_saved, xut_last, xut_curr))
+    {
+        return 0;
+    }
+
+    memset(&xstate, 0, sizeof(xntp_state_t));
+    xstate.xtm_saved = time_vnsec();
+
+    ntpclk_stat(&xclk_stat);
+    if (xclk_stat.xbt_valid && xclk_stat.xbt_freq)
+    {
+        xstate.xbt_freq = X_TRUE;
+        xstate.xit_freq = xclk_stat.xit_freq;
+    }
+
+    xstate.xut_naddr = ntpcli_addr_get(xntp_this, xstate.xut_addrs, &xstate.xtm_expire);
+    if (xstate.xut_naddr > 0)
+    {
+        memcpy(xstate.xszt_host, xntp_this->xszt_host, TEXT_LEN_256);
+        xstate.xut_port = xntp_this->xut_port;
+    }
+
+    return ntpstate_save(xntp_this->xszt_state, &xstate);
+}
+
+/**********************************************************/
+/**
+ * @brief 记录 应答的 LI，并按 闰秒的处理方式 校正 服务器时间戳。
+ * @note
+ * 只在 LI 变化 或 闰秒计划过期 时 重新计算 闰秒计划（多个线程 同时计算时，结果相同，后写者 覆盖即可）；
+ * 平滑计算 本身 没有分支跳转。
+ *
+ * @param [in ] xntp_this : 客户端对象。
+ * @param [in ] xtm_vnsec : 计算所得的 服务器时间戳。
+ * @param [in ] xut_leap  : 应答的 LI。
+ *
+ * @return xtime_vnsec_t : 返回 校正后的 时间戳。
+ */
+static xtime_vnsec_t ntpcli_leap_apply(
+                        xntp_cliptr_t xntp_this,
+                        xtime_vnsec_t xtm_vnsec,
+                        x_uint32_t xut_leap)
+{
+    xntp_leapplan_t xleap_plan = XATOMIC_LOAD64(&xntp_this->xleap_plan);
+
+    if ((xut_leap != XATOMIC_LOAD32(&xntp_this->xut_leap)) ||
+        (xtm_vnsec >= XNTP_LEAPPLAN_UNTIL(xleap_plan)))
+    {
+        XATOMIC_STORE32(&xntp_this->xut_leap, xut_leap);
+        xleap_plan = ntpleap_plan(xntp_this->xleap_tab, xleap_plan, xtm_vnsec, xut_leap);
+        XATOMIC_STORE64(&xntp_this->xleap_plan, xleap_plan);
+    }
+
+    if (ntp_leap_smear == xntp_this->xit_leapmode)
+    {
+        xtm_vnsec = ntpleap_smear(xleap_plan, xtm_vnsec);
+    }
+
+    return xtm_vnsec;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 成功请求 的 结果 校准 TSC 时钟、处理 闰秒、发布 与 保存 状态。
+ *
+ * @param [in ] xntp_this : 客户端对象。
+ * @param [in ] xtm_4time : 请求所得的 4 个时间戳。
+ * @param [in ] xut_leap  : 应答的 LI。
+ * @param [in ] xbt_save  : 是否 保存 热启动状态（异步请求 不在 事件循环 中 写文件）。
+ *
+ * @return xtime_vnsec_t : 返回 校正后的 服务器时间戳。
+ */
+static xtime_vnsec_t ntpcli_req_done(
+                        xntp_cliptr_t xntp_this,
+                        xtime_vnsec_t xtm_4time[4],
+                        x_uint32_t xut_leap,
+                        x_bool_t xbt_save)
+{
+    xtime_vnsec_t xtm_vnsec  = ntp_calc_4T(xtm_4time);
+    x_int64_t     xit_offset = (x_int64_t)(xtm_vnsec - xtm_4time[3]);
+    xntp_shmptr_t xshm_ptr   = X_NULL;
+
+    if (xntp_this->xbt_clock)
+    {
+        ntpclk_update(xit_offset);
+    }
+
+    xtm_vnsec = ntpcli_leap_apply(xntp_this, xtm_vnsec, xut_leap);
+
+    xshm_ptr = (xntp_shmptr_t)XATOMIC_LOADPTR(&xntp_this->xshm_pub);
+    if (X_NULL != xshm_ptr)
+    {
+        ntpshm_publish(xshm_ptr,
+                       xit_offset,
+                       (ntp_leap_smear == xntp_this->xit_leapmode) ? XATOMIC_LOAD64(&xntp_this->xleap_plan) : 0);
+    }
+
+    if (xbt_save)
+    {
+        ntpcli_state_save(xntp_this, X_FALSE);
+    }
+
+    return xtm_vnsec;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// NTP 客户端对象的 创建、工作通道 与 线程私有对象池
+// 
+
+/**********************************************************/
+/**
+ * @brief 创建 NTP 请求所使用的 UDP 套接字（非阻塞模式）。
+ *
+ * @param [out] xfdt_sockfd : 操作成功时，返回 套接字；失败时，置为 X_INVALID_SOCKFD。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpcli_sock_open(x_sockfd_t * xfdt_sockfd)
+{
+    x_int32_t xit_errno = EPERM;
+
+    *xfdt_sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (X_INVALID_SOCKFD == *xfdt_sockfd)
+    {
+        return sockfd_errno();
+    }
+
+    if (0 != sockfd_nbio(*xfdt_sockfd))
+    {
+        xit_errno = sockfd_errno();
+        sockfd_close(*xfdt_sockfd);
+        *xfdt_sockfd = X_INVALID_SOCKFD;
+        return xit_errno;
+    }
+
+#ifdef XNTP_IO_URING
+    // io_uring 后端 以 内核接收时间戳 作为 T4（设置失败时，以处理完成事件的时刻代替）
+    xit_errno = 1;
+    setsockopt(*xfdt_sockfd, SOL_SOCKET, SO_TIMESTAMPNS, &xit_errno, sizeof(x_int32_t));
+#endif // XNTP_IO_URING
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 客户端对象 默认的 工作通道数量（在线的 CPU 核数，限定在 [1, XNTP_LANE_MAX] 内）。
+ */
+static x_uint32_t ntp_lane_count(void)
+{
+    x_int32_t xit_count = 1;
+
+#if (defined(_WIN32) || defined(_WIN64))
+    SYSTEM_INFO xsys_info;
+    GetSystemInfo(&xsys_info);
+    xit_count = (x_int32_t)xsys_info.dwNumberOfProcessors;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    xit_count = (x_int32_t)sysconf(_SC_NPROCESSORS_ONLN);
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    if (xit_count < 1)
+        xit_count = 1;
+    else if (xit_count > XNTP_LANE_MAX)
+        xit_count = XNTP_LANE_MAX;
+
+    return (x_uint32_t)xit_count;
+}
+
+/**********************************************************/
+/**
+ * @brief 初始化 客户端对象 的 工作参数 与 工作通道（通道的套接字 均置为无效）。
+ *
+ * @param [in ] xntp_this : 客户端对象（其存储区 须包含紧随其后的 通道存储区）。
+ * @param [in ] xut_lanes : 工作通道 的 数量。
+ */
+static x_void_t ntpcli_reset(xntp_cliptr_t xntp_this, x_uint32_t xut_lanes)
+{
+    x_uint32_t    xut_iter  = 0;
+    xntp_lane_t * xlane_ptr = X_NULL;
+
+    xntp_this->xszt_host[0] = '\0';
+    xntp_this->xut_port     = NTP_PORT;
+    xntp_this->xut_lanes    = xut_lanes;
+    xntp_this->xbt_lanes    = (x_bptr_t)xntp_this + XNTP_HEAD_SIZE;
+    xntp_this->xkey_table   = X_NULL;
+    xntp_this->xut_keyid    = 0;
+    xntp_this->xnts_sess    = X_NULL;
+    xntp_this->xleap_tab    = X_NULL;
+    xntp_this->xit_leapmode = ntp_leap_step;
+    xntp_this->xut_leap     = 0;
+    xntp_this->xleap_plan   = 0;
+    xntp_this->xbt_clock    = X_FALSE;
+    xntp_this->xshm_pub     = X_NULL;
+    xntp_this->xszt_state[0] = '\0';
+    xntp_this->xut_saved    = 0;
+    xntp_this->xut_aseqn    = 0;
+    xntp_this->xut_naddr    = 0;
+    xntp_this->xtm_aexpire  = 0;
+    xntp_this->xut_iburst   = 0;
+    xntp_this->xut_hbudget  = 0;
+    xntp_this->xut_htoken   = 0;
+    xntp_this->xut_hreqs    = 0;
+    xntp_this->xut_hsent    = 0;
+    xntp_this->xut_hwins    = 0;
+    xntp_this->xbt_pooled   = X_FALSE;
+    xntp_this->xntp_next    = X_NULL;
+    memset(xntp_this->xrtt_list, 0, sizeof(xntp_this->xrtt_list));
+
+    for (xut_iter = 0; xut_iter < xut_lanes; ++xut_iter)
+    {
+        xlane_ptr = XNTP_LANE(xntp_this, xut_iter);
+        xlane_ptr->xfdt_sockfd = X_INVALID_SOCKFD;
+        xlane_ptr->xut_busy    = 0;
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 关闭 客户端对象 各个工作通道 的套接字。
+ */
+static x_void_t ntpcli_lanes_close(xntp_cliptr_t xntp_this)
+{
+    x_uint32_t    xut_iter  = 0;
+    xntp_lane_t * xlane_ptr = X_NULL;
+
+    for (xut_iter = 0; xut_iter < xntp_this->xut_lanes; ++xut_iter)
+    {
+        xlane_ptr = XNTP_LANE(xntp_this, xut_iter);
+        if (X_INVALID_SOCKFD != xlane_ptr->xfdt_sockfd)
+        {
+            sockfd_close(xlane_ptr->xfdt_sockfd);
+            xlane_ptr->xfdt_sockfd = X_INVALID_SOCKFD;
+        }
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 含指定数量 工作通道 的 客户端对象（对象头部 与 通道 在同一内存块中）。
+ *
+ * @return xntp_cliptr_t :
+ * 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+static xntp_cliptr_t ntpcli_create(x_uint32_t xut_lanes)
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+
+    xntp_this = (xntp_cliptr_t)xcache_alloc(XNTP_HEAD_SIZE + xut_lanes * XNTP_LANE_SIZE);
+    if (X_NULL == xntp_this)
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    ntpcli_reset(xntp_this, xut_lanes);
+
+    return xntp_this;
+}
+
+//====================================================================
+
+/** 线程私有对象池 中的 对象数量 */
+#define XNTP_POOL_SIZE      8
+
+/** 对象池 中每个对象所占用的 字节数（只含一个工作通道，按缓存行对齐，避免 伪共享） */
+#define XNTP_POOL_SLOT      (XNTP_HEAD_SIZE + XNTP_LANE_SIZE)
+
+/**
+ * @struct xntp_pool_t
+ * @brief  线程私有的 NTP 客户端对象池（固定容量的 slab，单次分配，按缓存行对齐）。
+ * @note
+ * 对象池只由 所属线程 访问，取出/归还 均无需加锁；
+ * 对象的套接字 在首次使用时创建，此后一直保持打开，直至 线程退出 时销毁对象池。
+ */
+typedef struct xntp_pool_t
+{
+    xntp_cliptr_t xntp_free;  ///< 空闲对象链表
+    x_bptr_t      xbt_slab;   ///< 对象的存储区（紧随本结构体之后，首地址按缓存行对齐）
+} xntp_pool_t;
+
+#if (defined(_WIN32) || defined(_WIN64))
+static DWORD     xfls_pool  = FLS_OUT_OF_INDEXES;
+static INIT_ONCE xonce_pool = INIT_ONCE_STATIC_INIT;
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <pthread.h>
+static pthread_key_t  xkey_pool;
+static pthread_once_t xonce_pool = PTHREAD_ONCE_INIT;
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+/** 调用线程 的 对象池（快速访问路径；线程退出时 由 存储键 的析构回调 负责释放） */
+static XTLS_VAR xntp_pool_t * xpool_local = X_NULL;
+
+/**********************************************************/
+/**
+ * @brief 线程退出时，销毁其 对象池 的回调函数。
+ */
+#if (defined(_WIN32) || defined(_WIN64))
+static VOID WINAPI ntp_pool_free(PVOID xpvt_value)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_void_t ntp_pool_free(x_pvoid_t xpvt_value)
+#endif // (defined(_WIN32) || defined(_WIN64))
+{
+    xntp_pool_t * xpool_ptr = (xntp_pool_t *)xpvt_value;
+    x_uint32_t    xut_iter  = 0;
+
+    if (X_NULL == xpool_ptr)
+    {
+        return;
+    }
+
+    for (xut_iter = 0; xut_iter < XNTP_POOL_SIZE; ++xut_iter)
+    {
+        ntpcli_lanes_close((xntp_cliptr_t)(xpool_ptr->xbt_slab + xut_iter * XNTP_POOL_SLOT));
+    }
+
+    xcache_free(xpool_ptr);
+
+    if (xpool_local == xpool_ptr)
+    {
+        xpool_local = X_NULL;
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 对象池 的 存储键（用于在线程退出时 销毁对象池）。
+ */
+#if (defined(_WIN32) || defined(_WIN64))
+static BOOL CALLBACK ntp_pool_key_init(PINIT_ONCE xonce_ptr, PVOID xpvt_param, PVOID * xpvt_context)
+{
+    xfls_pool = FlsAlloc(ntp_pool_free);
+    return TRUE;
+}
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_void_t ntp_pool_key_init(void)
+{
+    pthread_key_create(&xkey_pool, ntp_pool_free);
+}
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+/**********************************************************/
+/**
+ * @brief 获取 调用线程 的 对象池（首次调用时创建）。
+ *
+ * @return xntp_pool_t * : 成功，返回 对象池；失败，返回 X_NULL。
+ */
+static xntp_pool_t * ntp_pool_local(void)
+{
+    xntp_pool_t * xpool_ptr = xpool_local;
+    xntp_cliptr_t xntp_this = X_NULL;
+    x_uint32_t    xut_iter  = 0;
+
+    if (X_NULL != xpool_ptr)
+    {
+        return xpool_ptr;
+    }
+
+    //======================================
+
+#if (defined(_WIN32) || defined(_WIN64))
+    InitOnceExecuteOnce(&xonce_pool, ntp_pool_key_init, X_NULL, X_NULL);
+    if (FLS_OUT_OF_INDEXES == xfls_pool)
+        return X_NULL;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_once(&xonce_pool, ntp_pool_key_init);
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    xpool_ptr = (xntp_pool_t *)xcache_alloc(XCACHE_LINE + XNTP_POOL_SIZE * XNTP_POOL_SLOT);
+    if (X_NULL == xpool_ptr)
+    {
+        return X_NULL;
+    }
+
+    //======================================
+
+    xpool_ptr->xntp_free = X_NULL;
+    xpool_ptr->xbt_slab  = (x_bptr_t)xpool_ptr + XCACHE_LINE;
+
+    for (xut_iter = XNTP_POOL_SIZE; xut_iter > 0; --xut_iter)
+    {
+        xntp_this = (xntp_cliptr_t)(xpool_ptr->xbt_slab + (xut_iter - 1) * XNTP_POOL_SLOT);
+        ntpcli_reset(xntp_this, 1);
+        xntp_this->xbt_pooled = X_TRUE;
+        xntp_this->xntp_next  = xpool_ptr->xntp_free;
+        xpool_ptr->xntp_free  = xntp_this;
+    }
+
+#if (defined(_WIN32) || defined(_WIN64))
+    FlsSetValue(xfls_pool, xpool_ptr);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_setspecific(xkey_pool, xpool_ptr);
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    xpool_local = xpool_ptr;
+
+    return xpool_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 从 调用线程 的 对象池 中取出 NTP 客户端对象（只含一个工作通道）。
+ * @note
+ * 对象池已空（或创建失败）时，回退为 ntpcli_create() 创建对象；
+ * 取出的对象，必须由 同一线程 调用 ntp_pool_put()（或 ntpcli_close()）归还。
+ *
+ * @return xntp_cliptr_t :
+ * 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+static xntp_cliptr_t ntp_pool_get(void)
+{
+    xntp_pool_t * xpool_ptr = ntp_pool_local();
+    xntp_cliptr_t xntp_this = X_NULL;
+
+    if ((X_NULL == xpool_ptr) || (X_NULL == xpool_ptr->xntp_free))
+    {
+        return ntpcli_create(1);
+    }
+
+    xntp_this = xpool_ptr->xntp_free;
+    xpool_ptr->xntp_free = xntp_this->xntp_next;
+    xntp_this->xntp_next = X_NULL;
+
+    return xntp_this;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 NTP 客户端对象 归还到 调用线程 的 对象池 中（非对象池中的对象，则直接关闭）。
+ */
+static x_void_t ntp_pool_put(xntp_cliptr_t xntp_this)
+{
+    xntp_pool_t * xpool_ptr = xpool_local;
+
+    if (!xntp_this->xbt_pooled)
+    {
+        ntpcli_close(xntp_this);
+        return;
+    }
+
+    // 保留已打开的套接字 与 服务端设置（地址缓存 随之 保留，参看 ntpcli_config()）
+
+    xntp_this->xntp_next = xpool_ptr->xntp_free;
+    xpool_ptr->xntp_free = xntp_this;
+}
+
+//====================================================================
+
+/** 为各个线程分配 通道起始索引 的 计数器 */
+static x_uint32_t xut_lane_seed = 0;
+
+/** 调用线程 的 通道起始索引（取 0 时，表示尚未分配） */
+static XTLS_VAR x_uint32_t xut_lane_hint = 0;
+
+/**********************************************************/
+/**
+ * @brief 释放 ntp_lane_acquire() 所占用的 工作通道。
+ *
+ * @param [in ] xlane_ptr  : 工作通道。
+ * @param [in ] xntp_spare : ntp_lane_acquire() 所借用的 对象池对象（可为 X_NULL）。
+ */
+static x_void_t ntp_lane_release(xntp_lane_t * xlane_ptr, xntp_cliptr_t xntp_spare)
+{
+    XATOMIC_STORE32(&xlane_ptr->xut_busy, 0);
+
+    if (X_NULL != xntp_spare)
+    {
+        ntp_pool_put(xntp_spare);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 为 调用线程 占用 客户端对象 的一个空闲 工作通道（通道的套接字 在首次占用时创建）。
+ * @note
+ * 各线程从各自的 起始索引 开始，以 CAS 依次尝试占用通道，因而线程数不超过通道数时，
+ * 各线程基本固定使用各自的通道；所有通道均被占用时，借用 线程私有对象池 中的对象，
+ * 整个过程 不会阻塞。
+ *
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [out] xntp_spare : 返回所借用的 对象池对象（未借用时为 X_NULL），释放通道时 需一并传入。
+ *
+ * @return xntp_lane_t * :
+ * 成功，返回 工作通道；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+static xntp_lane_t * ntp_lane_acquire(xntp_cliptr_t xntp_this, xntp_cliptr_t * xntp_spare)
+{
+    x_int32_t     xit_errno = EPERM;
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_index = 0;
+    xntp_lane_t * xlane_ptr = X_NULL;
+
+    *xntp_spare = X_NULL;
+
+    if (0 == xut_lane_hint)
+    {
+        xut_lane_hint = XATOMIC_ADD32(&xut_lane_seed, 1) + 1;
+    }
+
+    //======================================
+
+    xut_index = (xut_lane_hint - 1) % xntp_this->xut_lanes;
+    for (xut_iter = 0; xut_iter < xntp_this->xut_lanes; ++xut_iter)
+    {
+        xlane_ptr = XNTP_LANE(xntp_this, xut_index);
+        if ((0 == XATOMIC_LOAD32(&xlane_ptr->xut_busy)) &&
+            XATOMIC_CAS32(&xlane_ptr->xut_busy, 0, 1))
+        {
+            break;
+        }
+
+        xlane_ptr = X_NULL;
+        if (++xut_index == xntp_this->xut_lanes)
+            xut_index = 0;
+    }
+
+    if (X_NULL == xlane_ptr)
+    {
+        *xntp_spare = ntp_pool_get();
+        if (X_NULL == *xntp_spare)
+        {
+            return X_NULL;
+        }
+
+        xlane_ptr = XNTP_LANE(*xntp_spare, 0);
+        XATOMIC_STORE32(&xlane_ptr->xut_busy, 1);
+    }
+
+    //======================================
+
+    if (X_INVALID_SOCKFD == xlane_ptr->xfdt_sockfd)
+    {
+        xit_errno = ntpcli_sock_open(&xlane_ptr->xfdt_sockfd);
+        if (0 != xit_errno)
+        {
+            ntp_lane_release(xlane_ptr, *xntp_spare);
+            *xntp_spare = X_NULL;
+            errno = xit_errno;
+            return X_NULL;
+        }
+    }
+
+    return xlane_ptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// NTP 外部相关操作接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 打开 NTP 客户端工作对象。
+ * @note
+ * 工作对象按 在线的 CPU 核数 预留 工作通道（每个通道持有独立的 套接字），
+ * 因而可被多个线程共用，并发调用 ntpcli_req_time() 等接口时 无需加锁。
+ * 
+ * @return xntp_cliptr_t : 
+ * 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_cliptr_t ntpcli_open(void)
+{
+    return ntpcli_open_ex(0);
+}
+
+/**********************************************************/
+/**
+ * @brief 打开 NTP 客户端工作对象，并指定 工作通道 的数量。
+ * @note
+ * 只由单个线程使用的工作对象（如 轮询器 的各个分片），取 1 个通道即可。
+ *
+ * @param [in ] xut_lanes : 工作通道的数量（取 0 时，为 在线的 CPU 核数；最大为 64）。
+ *
+ * @return xntp_cliptr_t : 
+ * 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_cliptr_t ntpcli_open_ex(x_uint32_t xut_lanes)
+{
+    x_int32_t     xit_errno = EPERM;
+    xntp_cliptr_t xntp_this = X_NULL;
+
+    do
+    {
+        //======================================
+
+        if (0 == xut_lanes)
+            xut_lanes = ntp_lane_count();
+        else if (xut_lanes > XNTP_LANE_MAX)
+            xut_lanes = XNTP_LANE_MAX;
+
+        xntp_this = ntpcli_create(xut_lanes);
+        if (X_NULL == xntp_this)
+        {
+            xit_errno = errno;
+            break;
+        }
+
+        //======================================
+        // socket fd（其余通道的套接字，在首次占用时创建）
+
+        xit_errno = ntpcli_sock_open(&XNTP_LANE(xntp_this, 0)->xfdt_sockfd);
+        if (0 != xit_errno)
+        {
+            break;
+        }
+
+        //======================================
+        xit_errno = 0;
+    } while (0);
+
+    if (0 != xit_errno)
+    {
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+        errno = xit_errno;
+    }
+
+    return xntp_this;
+}
+
+/**********************************************************/
+/**
+ * @brief 关闭 NTP 客户端工作对象。
+ */
+x_void_t ntpcli_close(xntp_cliptr_t xntp_this)
+{
+    if (X_NULL == xntp_this)
+    {
+        return;
+    }
+
+    if (xntp_this->xbt_pooled)
+    {
+        ntp_pool_put(xntp_this);
+        return;
+    }
+
+    if (0 != xntp_this->xut_saved)
+    {
+        ntpcli_state_save(xntp_this, X_TRUE);
+    }
+
+    ntpcli_lanes_close(xntp_this);
+    xcache_free(xntp_this);
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 NTP 服务端的 地址 与 端口号。
+ * @note
+ * 必须在 ntpcli_req_time() 调用前，设置好这些工作参数；
+ * 多个线程共用工作对象时，应在共用之前完成设置。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名（如 3.cn.pool.ntp.org）。
+ * @param [in ] xut_port  : NTP 服务器的 端口号（可取默认的端口号 NTP_PORT : 123）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_config(
+                xntp_cliptr_t xntp_this,
+                x_cstring_t xszt_host,
+                x_uint16_t xut_port)
+{
+    if ((X_NULL == xntp_this) ||
+        (X_NULL == xszt_host) ||
+        (strlen(xszt_host) >= TEXT_LEN_256))
+    {
+        return EINVAL;
+    }
+
+    if ((xut_port == xntp_this->xut_port) && (0 == strcmp(xszt_host, xntp_this->xszt_host)))
+    {
+        return 0;
+    }
+
+#if (defined(_WIN32) || defined(_WIN64))
+    strncpy_s(xntp_this->xszt_host, TEXT_LEN_256, xszt_host, TEXT_LEN_256);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    strncpy(xntp_this->xszt_host, xszt_host, TEXT_LEN_256);
+#endif // PLATFORM
+
+    xntp_this->xut_port = xut_port;
+
+    // 服务端 已改变，清除 地址缓存
+    ntpcli_addr_set(xntp_this, X_NULL, 0, 0, 0);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 请求认证 所使用的 密钥表 与 key ID。
+ * @note
+ * 与 ntpcli_config() 相同，多个线程共用工作对象时，应在共用之前完成设置；
+ * 密钥表 由调用方管理，须在 工作对象关闭 之前 保持有效。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xkey_table : 密钥表（取 X_NULL 时，不再认证）。
+ * @param [in ] xut_keyid  : ntpcli_req_time() 等请求 所使用的 key ID（取 0 时 不认证；
+ *                           批量请求 则使用 各请求项 自己的 key ID）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；key ID 不在密钥表中，返回 ENOENT；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_auth(
+                xntp_cliptr_t xntp_this,
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid)
+{
+    if (X_NULL == xntp_this)
+    {
+        return EINVAL;
+    }
+
+    if (X_NULL == xkey_table)
+    {
+        xut_keyid = 0;
+    }
+    else if ((0 != xut_keyid) && !ntpkey_exist(xkey_table, xut_keyid))
+    {
+        return ENOENT;
+    }
+
+    xntp_this->xkey_table = xkey_table;
+    xntp_this->xut_keyid  = xut_keyid;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 请求 所使用的 NTS 会话（Network Time Security，RFC 8915）。
+ * @note
+ * 设置后，ntpcli_req_time() 等请求 发往 NTS-KE 握手协商的 NTP 服务端（ntpcli_config() 的设置 不再使用），
+ * 请求 与 应答 均经 AEAD 保护，对称密钥认证 的设置 被忽略；批量请求 不使用 NTS。
+ * 会话 由调用方管理，可被多个 客户端对象 或 线程 共用，须在 工作对象关闭 之前 保持有效。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xnts_sess : NTS 会话（取 X_NULL 时，不再使用 NTS）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_nts(xntp_cliptr_t xntp_this, xntp_ntsptr_t xnts_sess)
+{
+    if (X_NULL == xntp_this)
+    {
+        return EINVAL;
+    }
+
+    xntp_this->xnts_sess = xnts_sess;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 闰秒表 与 闰秒的处理方式（跳变 或 24 小时线性平滑）。
+ * @note
+ * 与 ntpcli_config() 相同，多个线程共用工作对象时，应在共用之前完成设置；
+ * 闰秒表 由调用方管理，须在 工作对象关闭 之前 保持有效。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xleap_tab : 闰秒表（可为 X_NULL，此时 只依据 应答的 LI）。
+ * @param [in ] xit_mode  : 闰秒的处理方式（参看 xntp_leapmode_t）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_leap(
+                xntp_cliptr_t xntp_this,
+                xntp_leapptr_t xleap_tab,
+                xntp_leapmode_t xit_mode)
+{
+    if ((X_NULL == xntp_this) || ((ntp_leap_step != xit_mode) && (ntp_leap_smear != xit_mode)))
+    {
+        return EINVAL;
+    }
+
+    xntp_this->xleap_tab    = xleap_tab;
+    xntp_this->xit_leapmode = xit_mode;
+    xntp_this->xleap_plan   = 0;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 最近一次 应答的 LI（0 无闰秒，1 插入，2 删除，3 服务端未同步）。
+ */
+x_uint32_t ntpcli_leap_ind(xntp_cliptr_t xntp_this)
+{
+    return (X_NULL != xntp_this) ? XATOMIC_LOAD32(&xntp_this->xut_leap) : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 当前的 闰秒计划（尚无时 为 0）；可用于 以 ntpleap_smear() 平滑 其他的时间戳。
+ */
+xntp_leapplan_t ntpcli_leap_plan(xntp_cliptr_t xntp_this)
+{
+    return (X_NULL != xntp_this) ? XATOMIC_LOAD64(&xntp_this->xleap_plan) : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 是否以 请求结果 校准 进程内的 TSC 时钟（参看 ntpclk_update()，默认 不校准）。
+ * @note
+ * 开启后，每次 成功的 ntpcli_req_time() 等请求，以 其偏移量（不含 闰秒平滑）校准 TSC 时钟，
+ * 此后 可由 ntpclk_now() 以 数纳秒 的开销 读取 校正后的 UTC；批量请求 不参与 校准。
+ * TSC 时钟 为 进程内 唯一，多个 客户端对象 开启时，共同校准 同一时钟。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xbt_feed  : 是否 校准。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；TSC 不可用 时，返回 ENOTSUP；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_clock(xntp_cliptr_t xntp_this, x_bool_t xbt_feed)
+{
+    if (X_NULL == xntp_this)
+    {
+        return EINVAL;
+    }
+
+    if (xbt_feed && (0 == time_tsc_freq()))
+    {
+        return ENOTSUP;
+    }
+
+    xntp_this->xbt_clock = xbt_feed;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 发布 请求结果 的 共享内存段（参看 ntpshm_create()，X_NULL 表示 不发布；默认 不发布）。
+ * @note
+ * 设置后，每次 成功的 ntpcli_req_time() 等请求，在 校准 TSC 时钟（若已开启 ntpcli_clock()）之后，
+ * 将 偏移量、TSC 时钟 的 模型 与（平滑方式 下）闰秒计划 发布到 共享内存段，
+ * 同一主机 的 其他进程 即可由 ntpshm_now() 读取 校正时间，而 无须 各自 请求 NTP 服务端。
+ * 共享内存段 由 调用方 管理，须在 客户端对象 关闭 之后（或 取消设置 之后）才能 关闭。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xshm_ptr  : 共享内存段（须为 发布方 的 句柄）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_publish(xntp_cliptr_t xntp_this, xntp_shmptr_t xshm_ptr)
+{
+    if (X_NULL == xntp_this)
+    {
+        return EINVAL;
+    }
+
+    XATOMIC_STOREPTR(&xntp_this->xshm_pub, xshm_ptr);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 热启动状态文件（X_NULL 表示 不保存；默认 不保存）。
+ * @note
+ * 设置时 加载 上次运行 保存的 状态（文件 不存在 视为 成功）：
+ * TSC 时钟 的 频率偏差 经 ntpclk_warm() 预设，服务端 的 地址 与 ntpcli_config() 的 设置一致 且 未过期 时，
+ * 作为 地址缓存，首次请求 即可 跳过 域名解析。
+ * 此后 每次 成功的 ntpcli_req_time() 等请求，至多 每 XNTP_STATE_PERIOD 秒 保存 一次 状态，
+ * 关闭 客户端对象 时 再保存 一次。
+ * 应在 ntpcli_config()、ntpcli_clock() 之后，多个线程共用工作对象 之前 调用。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xszt_path : 状态文件 的 路径（参看 ntpstate_load()）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；状态文件 格式错误，返回 EPROTO；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_state(xntp_cliptr_t xntp_this, x_cstring_t xszt_path)
+{
+    x_int32_t    xit_errno = EPERM;
+    xntp_state_t xstate;
+
+    if ((X_NULL == xntp_this) ||
+        ((X_NULL != xszt_path) && (strlen(xszt_path) >= TEXT_LEN_256)))
+    {
+        return EINVAL;
+    }
+
+    if (X_NULL == xszt_path)
+    {
+        xntp_this->xszt_state[0] = '\0';
+        return 0;
+    }
+
+    xit_errno = ntpstate_load(xszt_path, &xstate);
+    if (ENOENT == xit_errno)
+    {
+        memset(&xstate, 0, sizeof(xntp_state_t));
+    }
+    else if (0 != xit_errno)
+    {
+        return xit_errno;
+    }
+
+#if (defined(_WIN32) || defined(_WIN64))
+    strncpy_s(xntp_this->xszt_state, TEXT_LEN_256, xszt_path, TEXT_LEN_256);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    memcpy(xntp_this->xszt_state, xszt_path, strlen(xszt_path) + 1);
+#endif // PLATFORM
+
+    if (xstate.xbt_freq)
+    {
+        ntpclk_warm(xstate.xit_freq);
+    }
+
+    if ((xstate.xut_naddr > 0) &&
+        (xstate.xut_port == xntp_this->xut_port) &&
+        (0 == strcmp(xstate.xszt_host, xntp_this->xszt_host)) &&
+        (time_vnsec() < xstate.xtm_expire))
+    {
+        ntpcli_addr_set(xntp_this, xstate.xut_addrs, xstate.xut_naddr, 0, xstate.xtm_expire);
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 立即 保存 热启动状态（阻塞的 文件操作）。
+ * @note
+ * 异步请求（ntpcli_async_start()）的 完成路径 不写 状态文件，以免 阻塞 宿主的 事件循环；
+ * 只使用 异步请求 时，宿主 可在 工作线程 中 定期 调用 本接口（关闭 客户端对象 时 亦会 保存）。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功（未设置 状态文件 时 不做 任何操作）；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_state_flush(xntp_cliptr_t xntp_this)
+{
+    if (X_NULL == xntp_this)
+    {
+        return EINVAL;
+    }
+
+    return ntpcli_state_save(xntp_this, X_TRUE);
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 是否开启 快速初始同步（iburst，默认 不开启）。
+ * @note
+ * 开启后，首次 ntpcli_req_time() 等请求 以 ntpcli_req_burst()
+ * （XNTP_IBURST_COUNT 轮，间隔 XNTP_IBURST_GAP）完成，直至 成功一次；
+ * 此后 的 请求 恢复为 单次请求。再次 开启，则 下一次请求 重新 突发。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xbt_enable : 是否开启。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_iburst(xntp_cliptr_t xntp_this, x_bool_t xbt_enable)
+{
+    if (X_NULL == xntp_this)
+    {
+        return EINVAL;
+    }
+
+    XATOMIC_STORE32(&xntp_this->xut_iburst, xbt_enable ? 1 : 0);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 对冲请求（hedged request）的 预算（默认 不开启）。
+ * @note
+ * 开启时 预存 一次 对冲请求 的 令牌，此后 每次 可对冲的 请求 积累 xut_budget / 1000 次。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xut_budget : 对冲请求 的 预算（千分比；取 0 时 不开启；至多 1000）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_hedge(xntp_cliptr_t xntp_this, x_uint32_t xut_budget)
+{
+    if ((X_NULL == xntp_this) || (xut_budget > XNTP_HEDGE_TOKEN))
+    {
+        return EINVAL;
+    }
+
+    XATOMIC_STORE32(&xntp_this->xut_htoken, (0 != xut_budget) ? XNTP_HEDGE_TOKEN : 0);
+    XATOMIC_STORE32(&xntp_this->xut_hbudget, xut_budget);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 对冲请求 的 统计 与 各个地址 的 往返时延 统计。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [out] xhedge_ptr : 返回 统计信息。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_hedge_stat(xntp_cliptr_t xntp_this, xntp_hedge_t * xhedge_ptr)
+{
+    x_uint32_t xut_iter = 0;
+
+    if ((X_NULL == xntp_this) || (X_NULL == xhedge_ptr))
+    {
+        return EINVAL;
+    }
+
+    xhedge_ptr->xut_requests = XATOMIC_LOAD32(&xntp_this->xut_hreqs);
+    xhedge_ptr->xut_hedges   = XATOMIC_LOAD32(&xntp_this->xut_hsent);
+    xhedge_ptr->xut_wins     = XATOMIC_LOAD32(&xntp_this->xut_hwins);
+
+    for (xut_iter = 0; xut_iter < XNTP_STATE_ADDRS; ++xut_iter)
+    {
+        xhedge_ptr->xrtt_list[xut_iter].xut_ipv4   = XATOMIC_LOAD32(&xntp_this->xrtt_list[xut_iter].xut_ipv4);
+        xhedge_ptr->xrtt_list[xut_iter].xut_count  = XATOMIC_LOAD32(&xntp_this->xrtt_list[xut_iter].xut_count);
+        xhedge_ptr->xrtt_list[xut_iter].xut_srtt   = XATOMIC_LOAD32(&xntp_this->xrtt_list[xut_iter].xut_srtt);
+        xhedge_ptr->xrtt_list[xut_iter].xut_rttvar = XATOMIC_LOAD32(&xntp_this->xrtt_list[xut_iter].xut_rttvar);
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 发送 NTP 请求，获取服务器时间戳。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xut_tmout : 网络请求的超时时间（单位为毫秒）。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码。
+ */
+xtime_vnsec_t ntpcli_req_time(xntp_cliptr_t xntp_this, x_uint32_t xut_tmout)
+{
+    return ntpcli_req_time_dl(xntp_this, ntp_tmout_dline(xut_tmout));
+}
+
+/**********************************************************/
+/**
+ * @brief 执行 NTP 请求（单次 或 突发），并以 结果 校准 TSC 时钟、处理 闰秒、发布 与 保存 状态。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xut_count  : 突发请求 的 轮数（取 0 时 为 单次请求）。
+ * @param [in ] xut_gap    : 突发请求 相邻 两轮 的 最小间隔（毫秒）。
+ * @param [out] xburst_ptr : 突发请求 的 统计（可为 X_NULL）。
+ * @param [in ] xtm_dline  : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码。
+ */
+static xtime_vnsec_t ntpcli_req_exec(
+                        xntp_cliptr_t xntp_this,
+                        x_uint32_t xut_count,
+                        x_uint32_t xut_gap,
+                        xntp_burst_t * xburst_ptr,
+                        xtime_vnsec_t xtm_dline)
+{
+    x_int32_t     xit_errno  = EPERM;
+    xntp_lane_t * xlane_ptr  = X_NULL;
+    xntp_cliptr_t xntp_spare = X_NULL;
+    x_cstring_t   xszt_host  = X_NULL;
+    x_uint16_t    xut_port   = 0;
+    x_uint32_t    xut_keyid  = 0;
+    x_uint32_t    xut_leap   = 0;
+    xtime_vnsec_t xtm_4time[4];
+    x_char_t      xszt_nts[TEXT_LEN_256];
+
+    //======================================
+    // 参数验证
+
+    if (X_NULL == xntp_this)
+    {
+        errno = EINVAL;
+        return XTIME_INVALID_VNSEC;
+    }
+
+    xszt_host = xntp_this->xszt_host;
+    xut_port  = xntp_this->xut_port;
+    xut_keyid = xntp_this->xut_keyid;
+
+    // NTS：没有可用的 cookie 时 先握手，NTP 服务端 取 握手协商的结果
+    if (X_NULL != xntp_this->xnts_sess)
+    {
+        xit_errno = ntpnts_ready(xntp_this->xnts_sess, xtm_dline);
+        if (0 == xit_errno)
+            xit_errno = ntpnts_server(xntp_this->xnts_sess, xszt_nts, TEXT_LEN_256, &xut_port);
+        if (0 != xit_errno)
+        {
+            errno = xit_errno;
+            return XTIME_INVALID_VNSEC;
+        }
+
+        xszt_host = xszt_nts;
+        xut_keyid = 0;
+    }
+
+    //======================================
+
+    xlane_ptr = ntp_lane_acquire(xntp_this, &xntp_spare);
+    if (X_NULL == xlane_ptr)
+    {
+        return XTIME_INVALID_VNSEC;
+    }
+
+    if (xut_count > 0)
+        xit_errno = ntpcli_get_4T_burst(xlane_ptr->xfdt_sockfd,
+                                        xntp_this->xkey_table,
+                                        xut_keyid,
+                                        xntp_this->xnts_sess,
+                                        (X_NULL == xntp_this->xnts_sess) ? xntp_this : X_NULL,
+                                        xszt_host,
+                                        xut_port,
+                                        xut_count,
+                                        xut_gap,
+                                        xtm_4time,
+                                        &xut_leap,
+                                        xburst_ptr,
+                                        xtm_dline);
+    else if (name_is_ipv4(xszt_host, X_NULL))
+        xit_errno = ntpcli_get_4T(xlane_ptr->xfdt_sockfd,
+                                  xntp_this->xkey_table,
+                                  xut_keyid,
+                                  xntp_this->xnts_sess,
+                                  xszt_host,
+                                  xut_port,
+                                  xtm_4time,
+                                  &xut_leap,
+                                  xtm_dline);
+    else
+        xit_errno = ntpcli_get_4T_by_name(xlane_ptr->xfdt_sockfd,
+                                          xntp_this->xkey_table,
+                                          xut_keyid,
+                                          xntp_this->xnts_sess,
+                                          (X_NULL == xntp_this->xnts_sess) ? xntp_this : X_NULL,
+                                          xszt_host,
+                                          xut_port,
+                                          xtm_4time,
+                                          &xut_leap,
+                                          xtm_dline);
+
+    ntp_lane_release(xlane_ptr, xntp_spare);
+
+    if (0 != xit_errno)
+    {
+        errno = xit_errno;
+        return XTIME_INVALID_VNSEC;
+    }
+
+    return ntpcli_req_done(xntp_this, xtm_4time, xut_leap, X_TRUE);
+
+    //======================================
+}
 
-            memset(xszt_host, 0, TEXT_LEN_256);
-            if (X_NULL == inet_ntop(
-                            AF_INET,
-                            &(((struct sockaddr_in *)(xai_iptr->ai_addr))->sin_addr),
-                            xszt_host,
-                            TEXT_LEN_256))
-            {
-                continue;
-            }
+/**********************************************************/
+/**
+ * @brief 发送 NTP 请求，获取服务器时间戳（以 截止时间 约束整个请求流程）。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码（超时为 ETIMEDOUT）。
+ */
+xtime_vnsec_t ntpcli_req_time_dl(xntp_cliptr_t xntp_this, xtime_vnsec_t xtm_dline)
+{
+    xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
 
-            xit_errno = ntpcli_get_4T(xntp_this, xszt_host, xut_tmout);
-            if (0 == xit_errno)
-            {
-                break;
-            }
+    if ((X_NULL != xntp_this) && (1 == XATOMIC_LOAD32(&xntp_this->xut_iburst)))
+    {
+        xtm_vnsec = ntpcli_req_exec(xntp_this, XNTP_IBURST_COUNT, XNTP_IBURST_GAP, X_NULL, xtm_dline);
+        if (XTMVNSEC_IS_VALID(xtm_vnsec))
+        {
+            XATOMIC_CAS32(&xntp_this->xut_iburst, 1, 2);
         }
 
-        //======================================
-    } while (0);
+        return xtm_vnsec;
+    }
+
+    return ntpcli_req_exec(xntp_this, 0, 0, X_NULL, xtm_dline);
+}
+
+/**********************************************************/
+/**
+ * @brief 突发请求：向 服务端 的 各个地址 并行地 连续请求 若干轮，以 最小时延 选取 样本。
+ * @note
+ * 域名 解析所得的 各个地址（参看 ntpcli_state() 的 地址缓存）视为 不同的 服务端，每轮 各发送 一个请求；
+ * 首轮 无应答的 地址 不再参与 之后的 各轮；首轮 至多等待 1 秒，之后 各轮 至多等待 已观测 最大时延 的 2 倍 加 20 毫秒。
+ * 每个 服务端 取 时延最小 的 样本（网络排队 只会 增大时延 与 偏移量误差），
+ * 有效样本 不少于 轮数 的 一半 的 服务端 中，选取 时延 的 一半 加上 样本偏差 最小者。
+ * 选中样本 随后 与 ntpcli_req_time_dl() 相同地 校准 TSC 时钟、处理 闰秒、发布 与 保存 状态。
+ * 使用 NTS 时，只请求 一个地址。
+ * 对 启用 速率限制 的 服务端，xut_gap 应 不小于 其 最小请求间隔（例如 ntpd 的 2 秒）。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xut_count  : 轮数（1 ~ XNTP_IBURST_MAX）。
+ * @param [in ] xut_gap    : 相邻 两轮 开始时刻 的 最小间隔（毫秒）。
+ * @param [out] xburst_ptr : 入参不为 X_NULL 时，返回 统计 与 选中样本。
+ * @param [in ] xtm_dline  : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码（没有 服务端 的 有效样本 足够多 时，为 最后的 请求错误码 或 ETIMEDOUT）。
+ */
+xtime_vnsec_t ntpcli_req_burst(
+                xntp_cliptr_t xntp_this,
+                x_uint32_t xut_count,
+                x_uint32_t xut_gap,
+                xntp_burst_t * xburst_ptr,
+                xtime_vnsec_t xtm_dline)
+{
+    if ((0 == xut_count) || (xut_count > XNTP_IBURST_MAX))
+    {
+        errno = EINVAL;
+        return XTIME_INVALID_VNSEC;
+    }
+
+    return ntpcli_req_exec(xntp_this, xut_count, xut_gap, xburst_ptr, xtm_dline);
+}
+
+/**********************************************************/
+/**
+ * @brief 批量请求：向多个 NTP 服务端（IPv4 地址）同时发送请求，并在截止时间前收集应答。
+ * @note
+ * 所有请求共用 xntp_this 的同一 工作通道（套接字），应答按 (地址, 端口) 与 originate 时间戳 匹配到请求项；
+ * 在支持 io_uring 的 Linux 平台上，整个批量请求只需少量的系统调用，
+ * 否则（或 运行时检测到内核不支持时）自动回退为 sendto()/select()/recvfrom() 方式。
+ * 
+ * @param [in    ] xntp_this : NTP 客户端工作对象。
+ * @param [in,out] xsw_list  : 请求项列表（输入 地址、端口，输出 各项的结果）。
+ * @param [in    ] xut_count : 请求项数量。
+ * @param [in    ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示批量请求已执行（各请求项的结果见其 xit_errno，超时的为 ETIMEDOUT）；
+ * 其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_req_sweep(
+                xntp_cliptr_t xntp_this,
+                xntp_sweep_t * xsw_list,
+                x_uint32_t xut_count,
+                xtime_vnsec_t xtm_dline)
+{
+    x_int32_t     xit_errno  = EPERM;
+    xntp_lane_t * xlane_ptr  = X_NULL;
+    xntp_cliptr_t xntp_spare = X_NULL;
+
+    if ((X_NULL == xntp_this) || ((X_NULL == xsw_list) && (xut_count > 0)))
+    {
+        return EINVAL;
+    }
+
+    if (0 == xut_count)
+    {
+        return 0;
+    }
 
-    if (X_NULL != xai_rptr)
+    xlane_ptr = ntp_lane_acquire(xntp_this, &xntp_spare);
+    if (X_NULL == xlane_ptr)
     {
-        freeaddrinfo(xai_rptr);
-        xai_rptr = X_NULL;
+        return errno;
     }
 
+    xit_errno = ntpcli_sweep(xlane_ptr->xfdt_sockfd, xntp_this->xkey_table, X_NULL, xsw_list, xut_count, xtm_dline);
+
+    ntp_lane_release(xlane_ptr, xntp_spare);
+
     return xit_errno;
 }
 
-////////////////////////////////////////////////////////////////////////////////
+//====================================================================
 
 // 
-// NTP 外部相关操作接口
+// 异步请求（由 宿主的 事件循环 驱动）
 // 
 
 /**********************************************************/
 /**
- * @brief 打开 NTP 客户端工作对象。
- * 
- * @return xntp_cliptr_t : 
- * 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ * @brief 以 异步请求 的 状态 构建 只含一个请求项的 批量请求 上下文（不重置 请求项）。
  */
-xntp_cliptr_t ntpcli_open(void)
+static x_void_t ntp_async_ctx(xntp_asyncptr_t xasync, xntp_sweep_ctx_t * xctx_ptr)
 {
-    x_int32_t     xit_errno = EPERM;
-    xntp_cliptr_t xntp_this = X_NULL;
+    xctx_ptr->xfdt_sockfd = ((xntp_lane_t *)xasync->xpvt_lane)->xfdt_sockfd;
+    xctx_ptr->xkey_table  = xasync->xntp_this->xkey_table;
+    xctx_ptr->xnts_sess   = X_NULL;
+    xctx_ptr->xsw_list    = &xasync->xsw_item;
+    xctx_ptr->xut_count   = 1;
+    xctx_ptr->xut_pending = XSWEEP_PENDING(&xasync->xsw_item) ? 1 : 0;
+    xctx_ptr->xbt_sent    = X_TRUE;
+    xctx_ptr->xbt_first   = X_FALSE;
+    xctx_ptr->xut_hmask   = 0;
+    xctx_ptr->xut_htable  = X_NULL;
+    xctx_ptr->xtm_base    = xasync->xtm_base;
+}
 
-    do
-    {
-        //======================================
+/**********************************************************/
+/**
+ * @brief 从 当前地址（xut_iaddr）开始，依次 向 地址列表 中的 地址 发送 请求，直至 发送成功。
+ * @note
+ * 发送时 按 ntpcli_addr_dline() 设置 当前地址 的 截止时间（xtm_adline）。
+ *
+ * @return x_bool_t :
+ * 已发出请求，返回 X_TRUE；地址 已用完 或 截止时间 已过，返回 X_FALSE（请求项 的 xit_errno 为 最后的 错误码）。
+ */
+static x_bool_t ntp_async_send(xntp_asyncptr_t xasync)
+{
+    xntp_sweep_ctx_t xctx_this;
 
-        xntp_this = (xntp_cliptr_t)malloc(sizeof(xntp_client_t));
-        if (X_NULL == xntp_this)
+    for (; xasync->xut_iaddr < xasync->xut_naddr; ++xasync->xut_iaddr)
+    {
+        if (XTMVNSEC_IS_VALID(xasync->xtm_dline) && (time_mono() >= xasync->xtm_dline))
         {
-            xit_errno = errno;
+            xasync->xsw_item.xit_errno = ETIMEDOUT;
             break;
         }
 
-        //======================================
-        // socket fd
-
-        xntp_this->xfdt_sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-        if (X_INVALID_SOCKFD == xntp_this->xfdt_sockfd)
+        // 只含一个请求项，不建立索引表，无须 ntp_sweep_release()
+        xasync->xsw_item.xut_ipv4 = xasync->xut_addrs[xasync->xut_iaddr];
+        xasync->xtm_adline = ntpcli_addr_dline(xasync->xtm_dline, xasync->xut_naddr - xasync->xut_iaddr);
+        ntp_sweep_init(&xctx_this,
+                       ((xntp_lane_t *)xasync->xpvt_lane)->xfdt_sockfd,
+                       xasync->xntp_this->xkey_table,
+                       X_NULL,
+                       &xasync->xsw_item,
+                       1);
+        ntp_sweep_send(&xctx_this);
+
+        xasync->xtm_base = xctx_this.xtm_base;
+        if (xctx_this.xut_pending > 0)
         {
-            xit_errno = sockfd_errno();
-            break;
+            return X_TRUE;
         }
+    }
+
+    return X_FALSE;
+}
 
-        if (0 != sockfd_nbio(xntp_this->xfdt_sockfd))
+/**********************************************************/
+/**
+ * @brief 结束 异步请求：处理 结果，释放 工作通道，再 调用 回调函数。
+ */
+static x_void_t ntp_async_finish(xntp_asyncptr_t xasync)
+{
+    xntp_cliptr_t  xntp_this = xasync->xntp_this;
+    xntp_sweep_t * xsw_item  = &xasync->xsw_item;
+    xntp_async_cbk xfunc_cbk = xasync->xfunc_cbk;
+    x_pvoid_t      xpvt_ctx  = xasync->xpvt_ctx;
+    xntp_sample_t  xsample;
+
+    memset(&xsample, 0, sizeof(xntp_sample_t));
+    xsample.xit_errno    = xsw_item->xit_errno;
+    xsample.xut_ipv4     = xsw_item->xut_ipv4;
+    xsample.xut_port     = xsw_item->xut_port;
+    xsample.xtm_vnsec    = XTIME_INVALID_VNSEC;
+    xsample.xtm_4time[0] = xsw_item->xtm_4time[0];
+    xsample.xtm_4time[1] = xsw_item->xtm_4time[1];
+    xsample.xtm_4time[2] = xsw_item->xtm_4time[2];
+    xsample.xtm_4time[3] = xsw_item->xtm_4time[3];
+    xsample.xut_mackey   = xsw_item->xut_mackey;
+    xsample.xut_leap     = xsw_item->xut_leap;
+
+    if (0 == xsample.xit_errno)
+    {
+        // 与 ntpcli_get_4T_by_name() 相同，成功的 地址 移到 地址缓存 的 首位
+        if ((0 != xasync->xtm_aexpire) && (0 != xasync->xut_iaddr))
         {
-            xit_errno = sockfd_errno();
-            break;
+            ntpcli_addr_set(xntp_this, xasync->xut_addrs, xasync->xut_naddr,
+                            xasync->xut_iaddr, xasync->xtm_aexpire);
         }
 
-        //======================================
+        xsample.xit_offset = (x_int64_t)(xsw_item->xtm_vnsec - xsw_item->xtm_4time[3]);
+        xsample.xit_delay  = (x_int64_t)(xsw_item->xtm_4time[3] - xsw_item->xtm_4time[0]) -
+                             (x_int64_t)(xsw_item->xtm_4time[2] - xsw_item->xtm_4time[1]);
+        xsample.xit_delay  = (xsample.xit_delay > 0) ? xsample.xit_delay : 0;
+        xsample.xtm_vnsec  = ntpcli_req_done(xntp_this, xsw_item->xtm_4time, xsw_item->xut_leap, X_FALSE);
+    }
+    else if (xasync->xbt_cached)
+    {
+        // 与 ntpcli_get_4T_by_name() 相同，超时 时 首个地址 移到 地址缓存 的 末尾；其他错误 清除缓存
+        if (ETIMEDOUT == xsample.xit_errno)
+            ntpcli_addr_demote(xntp_this, xasync->xut_addrs, xasync->xut_naddr, xasync->xtm_aexpire);
+        else
+            ntpcli_addr_set(xntp_this, X_NULL, 0, 0, 0);
+    }
 
-        memset(xntp_this->xszt_host, 0, TEXT_LEN_256);
-        xntp_this->xut_port = NTP_PORT;
+    ntp_lane_release((xntp_lane_t *)xasync->xpvt_lane, xasync->xntp_spare);
+    xasync->xpvt_lane  = X_NULL;
+    xasync->xntp_spare = X_NULL;
 
-        xntp_this->xtm_4time[0] = XTIME_INVALID_VNSEC;
-        xntp_this->xtm_4time[1] = XTIME_INVALID_VNSEC;
-        xntp_this->xtm_4time[2] = XTIME_INVALID_VNSEC;
-        xntp_this->xtm_4time[3] = XTIME_INVALID_VNSEC;
+    xfunc_cbk(xasync, &xsample, xpvt_ctx);
+}
 
-        //======================================
-        xit_errno = 0;
-    } while (0);
+/**********************************************************/
+/**
+ * @brief 开始 异步请求：发送 NTP 请求 后 立即返回，由 宿主的 事件循环 驱动 后续的 接收 与 超时。
+ * 
+ * @param [in ] xasync    : 异步请求 的 存储区（首次使用前 须 清零）。
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * @param [in ] xfunc_cbk : 完成时的 回调函数。
+ * @param [in ] xpvt_ctx  : 回调上下文。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示 请求 已发出（之后 恰好 回调 一次，除非 先行 ntpcli_async_close()）；
+ * 请求 正在进行中，返回 EBUSY；没有 可用的 地址缓存，返回 EAGAIN；其他值则表示操作失败的错误码（不回调）。
+ */
+x_int32_t ntpcli_async_start(
+                xntp_asyncptr_t xasync,
+                xntp_cliptr_t xntp_this,
+                xtime_vnsec_t xtm_dline,
+                xntp_async_cbk xfunc_cbk,
+                x_pvoid_t xpvt_ctx)
+{
+    x_int32_t     xit_errno = EPERM;
+    xntp_lane_t * xlane_ptr = X_NULL;
 
-    if (0 != xit_errno)
+    if ((X_NULL == xasync) || (X_NULL == xntp_this) || (X_NULL == xfunc_cbk))
     {
-        ntpcli_close(xntp_this);
-        xntp_this = X_NULL;
+        return EINVAL;
     }
 
-    return xntp_this;
+    if (X_NULL != xasync->xpvt_lane)
+    {
+        return EBUSY;
+    }
+
+    // NTS 的 握手 与 cookie 更新 均为 阻塞操作
+    if (X_NULL != xntp_this->xnts_sess)
+    {
+        return ENOTSUP;
+    }
+
+    //======================================
+    // 地址列表：IP 地址，或 地址缓存（不在 事件循环 中 解析域名，参看 ntpcli_resolve_host()）
+
+    xasync->xbt_cached  = X_FALSE;
+    xasync->xut_iaddr   = 0;
+    xasync->xtm_aexpire = 0;
+
+    if (name_is_ipv4(xntp_this->xszt_host, &xasync->xut_addrs[0]))
+    {
+        xasync->xut_naddr = 1;
+    }
+    else
+    {
+        xasync->xut_naddr  = ntpcli_addr_get(xntp_this, xasync->xut_addrs, &xasync->xtm_aexpire);
+        xasync->xbt_cached = (xasync->xut_naddr > 0);
+        if (!xasync->xbt_cached)
+        {
+            return EAGAIN;
+        }
+    }
+
+    //======================================
+
+    xlane_ptr = ntp_lane_acquire(xntp_this, &xasync->xntp_spare);
+    if (X_NULL == xlane_ptr)
+    {
+        return errno;
+    }
+
+    xasync->xntp_this          = xntp_this;
+    xasync->xpvt_lane          = xlane_ptr;
+    xasync->xfunc_cbk          = xfunc_cbk;
+    xasync->xpvt_ctx           = xpvt_ctx;
+    xasync->xtm_dline          = xtm_dline;
+    xasync->xtm_adline         = xtm_dline;
+    xasync->xsw_item.xut_port  = xntp_this->xut_port;
+    xasync->xsw_item.xut_keyid = xntp_this->xut_keyid;
+
+    if (!ntp_async_send(xasync))
+    {
+        xit_errno = xasync->xsw_item.xit_errno;
+        ntp_lane_release(xlane_ptr, xasync->xntp_spare);
+        xasync->xpvt_lane  = X_NULL;
+        xasync->xntp_spare = X_NULL;
+        return xit_errno;
+    }
+
+    return 0;
 }
 
 /**********************************************************/
 /**
- * @brief 关闭 NTP 客户端工作对象。
+ * @brief 异步请求 所使用的 套接字（非阻塞；请求 未在进行中 时，返回 X_INVALID_SOCKFD）。
  */
-x_void_t ntpcli_close(xntp_cliptr_t xntp_this)
+x_sockfd_t ntpcli_async_fd(xntp_asyncptr_t xasync)
 {
-    if (X_NULL == xntp_this)
+    if ((X_NULL == xasync) || (X_NULL == xasync->xpvt_lane))
     {
-        return;
+        return X_INVALID_SOCKFD;
     }
 
-    if (X_INVALID_SOCKFD != xntp_this->xfdt_sockfd)
+    return ((xntp_lane_t *)xasync->xpvt_lane)->xfdt_sockfd;
+}
+
+/**********************************************************/
+/**
+ * @brief 异步请求 的 截止时间（单调时钟；无限等待 或 未在进行中 时，返回 XTIME_INVALID_VNSEC）。
+ */
+xtime_vnsec_t ntpcli_async_deadline(xntp_asyncptr_t xasync)
+{
+    if ((X_NULL == xasync) || (X_NULL == xasync->xpvt_lane))
     {
-        sockfd_close(xntp_this->xfdt_sockfd);
+        return XTIME_INVALID_VNSEC;
     }
 
-    free(xntp_this);
+    return xasync->xtm_adline;
 }
 
 /**********************************************************/
 /**
- * @brief 设置 NTP 服务端的 地址 与 端口号。
- * @note  必须在 ntpcli_req_time() 调用前，设置好这些工作参数。
+ * @brief 处理 宿主事件循环 报告的 事件（接收 应答、检查 截止时间）。
  * 
- * @param [in ] xntp_this : NTP 客户端工作对象。
- * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名（如 3.cn.pool.ntp.org）。
- * @param [in ] xut_port  : NTP 服务器的 端口号（可取默认的端口号 NTP_PORT : 123）。
+ * @param [in ] xasync     : 异步请求。
+ * @param [in ] xut_events : 事件（XNTP_ASYNC_READ、XNTP_ASYNC_TIMER 的 组合，可为 0）。
  * 
  * @return x_int32_t : 
- * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ * 请求 仍在进行中，返回 EINPROGRESS；请求 已结束（本次 或 此前 已回调），返回 0；参数无效，返回 EINVAL。
  */
-x_int32_t ntpcli_config(
-                xntp_cliptr_t xntp_this,
-                x_cstring_t xszt_host,
-                x_uint16_t xut_port)
+x_int32_t ntpcli_async_process(xntp_asyncptr_t xasync, x_uint32_t xut_events)
 {
-    if ((X_NULL == xntp_this) ||
-        (X_NULL == xszt_host) ||
-        (strlen(xszt_host) >= TEXT_LEN_256))
+    x_int32_t        xit_errno = 0;
+    xntp_sweep_ctx_t xctx_this;
+
+    if (X_NULL == xasync)
     {
         return EINVAL;
     }
 
-#if (defined(_WIN32) || defined(_WIN64))
-    strncpy_s(xntp_this->xszt_host, TEXT_LEN_256, xszt_host, TEXT_LEN_256);
-#else // !(defined(_WIN32) || defined(_WIN64))
-    strncpy(xntp_this->xszt_host, xszt_host, TEXT_LEN_256);
-#endif // PLATFORM
+    if (X_NULL == xasync->xpvt_lane)
+    {
+        return 0;
+    }
 
-    xntp_this->xut_port = xut_port;
+    //======================================
+
+    if (xut_events & XNTP_ASYNC_READ)
+    {
+        ntp_async_ctx(xasync, &xctx_this);
+
+        xit_errno = ntp_sweep_drain(&xctx_this);
+        if ((0 != xit_errno) && !sockfd_retry(xit_errno))
+        {
+            ntp_sweep_fail(&xctx_this, &xasync->xsw_item, xit_errno);
+        }
+    }
+
+    if (!XSWEEP_PENDING(&xasync->xsw_item))
+    {
+        // 当前地址 失败（发送失败、套接字出错、应答时间戳无效）时，改为 请求 下一个地址
+        if (0 != xasync->xsw_item.xit_errno)
+        {
+            xasync->xut_iaddr += 1;
+            if (ntp_async_send(xasync))
+            {
+                return EINPROGRESS;
+            }
+        }
+    }
+    else if (!XTMVNSEC_IS_VALID(xasync->xtm_adline) || (time_mono() < xasync->xtm_adline))
+    {
+        return EINPROGRESS;
+    }
+    else if ((xasync->xut_iaddr + 1) < xasync->xut_naddr)
+    {
+        // 当前地址 超时（整体的 截止时间 未到），改为 请求 下一个地址
+        xasync->xut_iaddr += 1;
+        if (ntp_async_send(xasync))
+        {
+            return EINPROGRESS;
+        }
+    }
+
+    // 成功、地址 已用完，或 截止时间 已过（请求项的 xit_errno 为 ETIMEDOUT，或 收到的 无效应答 的 错误码）
+    ntp_async_finish(xasync);
 
     return 0;
 }
 
 /**********************************************************/
 /**
- * @brief 发送 NTP 请求，获取服务器时间戳。
+ * @brief 取消 异步请求（进行中的 请求 不再回调；已结束 的 请求，直接返回）。
+ */
+x_void_t ntpcli_async_close(xntp_asyncptr_t xasync)
+{
+    if ((X_NULL == xasync) || (X_NULL == xasync->xpvt_lane))
+    {
+        return;
+    }
+
+    // 已发出 请求 的 迟到应答，在 该通道 的 下一次请求 中 因 originate 不匹配 而被丢弃
+    ntp_lane_release((xntp_lane_t *)xasync->xpvt_lane, xasync->xntp_spare);
+    xasync->xpvt_lane  = X_NULL;
+    xasync->xntp_spare = X_NULL;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 服务端 的 域名，建立 地址缓存（阻塞操作）。
+ * @note
+ * 异步请求 不在 宿主的 事件循环 中 解析域名：ntpcli_async_start() 没有 可用的 地址缓存 时 返回 EAGAIN，
+ * 宿主 可在 工作线程 中 调用 本接口，完成后 再 发起请求。服务端 为 IPv4 地址 时，直接返回 0。
  * 
  * @param [in ] xntp_this : NTP 客户端工作对象。
- * @param [in ] xut_tmout : 网络请求的超时时间（单位为毫秒）。
  * 
- * @return xtime_vnsec_t : 
- * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
- * 若值无效，则可通过 errno 获知错误码。
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码（getaddrinfo() 的 错误码，或 EADDRNOTAVAIL）。
  */
-xtime_vnsec_t ntpcli_req_time(xntp_cliptr_t xntp_this, x_uint32_t xut_tmout)
+x_int32_t ntpcli_resolve_host(xntp_cliptr_t xntp_this)
 {
-    x_int32_t xit_errno = EPERM;
-
-    //======================================
-    // 参数验证
+    x_int32_t  xit_errno = EPERM;
+    x_uint32_t xut_naddr = 0;
+    x_uint32_t xut_addrs[XNTP_STATE_ADDRS];
 
     if (X_NULL == xntp_this)
     {
-        errno = EINVAL;
-        return XTIME_INVALID_VNSEC;
+        return EINVAL;
     }
 
-    //======================================
-
-    if (name_is_ipv4(xntp_this->xszt_host, X_NULL))
-        xit_errno = ntpcli_get_4T(xntp_this, xntp_this->xszt_host, xut_tmout);
-    else
-        xit_errno = ntpcli_get_4T_by_name(xntp_this, xut_tmout);
+    if (name_is_ipv4(xntp_this->xszt_host, &xut_addrs[0]))
+    {
+        return 0;
+    }
 
+    xit_errno = ntpcli_resolve(xntp_this->xszt_host, xut_addrs, &xut_naddr);
     if (0 != xit_errno)
     {
-        errno = xit_errno;
-        return XTIME_INVALID_VNSEC;
+        return xit_errno;
     }
 
-    //======================================
-
-    return ntp_calc_4T(xntp_this->xtm_4time);
+    ntpcli_addr_set(xntp_this, xut_addrs, xut_naddr, 0,
+                    time_vnsec() + (xtime_vnsec_t)XNTP_STATE_ADDR_TTL * 1000ULL * XTIME_VNSEC_MSEC);
 
-    //======================================
+    return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1008,8 +4251,8 @@ xtime_vnsec_t ntpcli_req_time(xntp_cliptr_t xntp_this, x_uint32_t xut_tmout)
  * @brief 
  * 向 NTP 服务器发送 NTP 请求，获取服务器时间戳。
  * @note 
- * 该接口内部自动 创建/销毁 NTP 客户端对象，执行完整的 NTP 请求流程。
- * 这适用于只执行单次请求操作。
+ * 该接口内部自动 取出/归还 线程私有对象池 中的 NTP 客户端对象，执行完整的 NTP 请求流程。
+ * 这适用于只执行单次请求操作，在循环中反复调用时，不会反复 分配内存 与 创建套接字。
  *
  * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名（如 3.cn.pool.ntp.org）。
  * @param [in ] xut_port  : NTP 服务器的 端口号（可取默认的端口号 NTP_PORT : 123）。
@@ -1023,6 +4266,27 @@ xtime_vnsec_t ntpcli_get_time(
                     x_cstring_t xszt_host,
                     x_uint16_t xut_port,
                     x_uint32_t xut_tmout)
+{
+    return ntpcli_get_time_dl(xszt_host, xut_port, ntp_tmout_dline(xut_tmout));
+}
+
+/**********************************************************/
+/**
+ * @brief 
+ * 向 NTP 服务器发送 NTP 请求，获取服务器时间戳（以 截止时间 约束整个请求流程）。
+ *
+ * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名（如 3.cn.pool.ntp.org）。
+ * @param [in ] xut_port  : NTP 服务器的 端口号（可取默认的端口号 NTP_PORT : 123）。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ *
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码。
+ */
+xtime_vnsec_t ntpcli_get_time_dl(
+                    x_cstring_t xszt_host,
+                    x_uint16_t xut_port,
+                    xtime_vnsec_t xtm_dline)
 {
     x_int32_t     xit_errno = EPERM;
     xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
@@ -1032,7 +4296,7 @@ xtime_vnsec_t ntpcli_get_time(
 
     do
     {
-        xntp_this = ntpcli_open();
+        xntp_this = ntp_pool_get();
         if (X_NULL == xntp_this)
         {
             break;
@@ -1045,12 +4309,12 @@ xtime_vnsec_t ntpcli_get_time(
             break;
         }
 
-        xtm_vnsec = ntpcli_req_time(xntp_this, xut_tmout);
+        xtm_vnsec = ntpcli_req_time_dl(xntp_this, xtm_dline);
     } while (0);
 
     if (X_NULL != xntp_this)
     {
-        ntpcli_close(xntp_this);
+        ntp_pool_put(xntp_this);
         xntp_this = X_NULL;
     }
 
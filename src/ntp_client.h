@@ -34,6 +34,12 @@
 #define __NTP_CLIENT_H__
 
 #include "xtime.h"
+#include "ntp_auth.h"
+#include "ntp_nts.h"
+#include "ntp_leap.h"
+#include "ntp_clock.h"
+#include "ntp_shm.h"
+#include "ntp_state.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -55,17 +61,166 @@ extern "C" {
 /** 定义 NTP 客户端工作对象的 指针类型 */
 typedef struct xntp_client_t * xntp_cliptr_t;
 
+/** 突发请求（iburst）的 默认轮数：每轮 向 各个服务端 各发送 一个请求 */
+#define XNTP_IBURST_COUNT   4
+
+/** 突发请求 的 最大轮数 */
+#define XNTP_IBURST_MAX     8
+
+/** 突发请求 的 默认轮间隔（毫秒）：0 表示 上一轮 结束后 立即开始 */
+#define XNTP_IBURST_GAP     0
+
+/** 对冲请求（hedged request）的 默认预算（千分比）：额外的 对冲请求 至多 为 请求数量 的 5% */
+#define XNTP_HEDGE_BUDGET   50
+
+/**
+ * @struct xntp_sweep_t
+ * @brief  批量请求（一次轮询多个 NTP 服务端）时，单个请求项的 参数 与 结果。
+ */
+typedef struct xntp_sweep_t
+{
+    x_uint32_t    xut_ipv4;     ///< [in ] NTP 服务器的 IPv4 地址（主机字节序）
+    x_uint16_t    xut_port;     ///< [in ] NTP 服务器的 端口号
+    x_uint32_t    xut_keyid;    ///< [in ] 请求认证所用的 key ID（取 0 时 不认证；密钥表 参看 ntpcli_auth()）
+    x_int32_t     xit_errno;    ///< [out] 请求结果的错误码（0 表示成功；认证失败 为 EACCES）
+    xtime_vnsec_t xtm_vnsec;    ///< [out] 成功时，计算所得的 服务器时间戳（不做 闰秒平滑）
+    xtime_vnsec_t xtm_4time[4]; ///< [out] T1、T2、T3、T4 四个时间戳
+    x_uint32_t    xut_mackey;   ///< [out] 应答所携带 MAC 的 key ID（无 MAC 时 为 0）
+    x_uint32_t    xut_leap;     ///< [out] 应答的 LI（0 无闰秒，1 插入，2 删除，3 服务端未同步）
+    x_uint32_t    xut_stratum;  ///< [out] 应答的 层数（0 为 KoD 或 未指定，16 为 未同步）
+} xntp_sweep_t;
+
+/**
+ * @struct xntp_burst_t
+ * @brief  突发请求（参看 ntpcli_req_burst()）的 统计与 选中样本。
+ */
+typedef struct xntp_burst_t
+{
+    x_uint32_t    xut_servers;  ///< 参与的 服务端（地址）数量
+    x_uint32_t    xut_replies;  ///< 收到的 有效应答 总数
+    x_uint32_t    xut_ipv4;     ///< 选中的 服务端 地址（主机字节序）
+    x_uint32_t    xut_samples;  ///< 选中服务端 的 有效样本 数量
+    x_int64_t     xit_offset;   ///< 选中样本 的 偏移量（UTC 减去 本地系统时间，100 纳秒）
+    x_int64_t     xit_delay;    ///< 选中样本 的 往返时延（100 纳秒）
+    x_int64_t     xit_spread;   ///< 选中服务端 其余样本 的 偏移量 与 选中样本 的 最大偏差（100 纳秒）
+    xtime_vnsec_t xtm_elapsed;  ///< 整个 突发请求 的 耗时（100 纳秒）
+} xntp_burst_t;
+
+/**
+ * @struct xntp_rtt_t
+ * @brief  单个 服务端 地址 的 往返时延 统计（在线更新，参看 ntpcli_hedge()）。
+ * @note
+ * 往返时延 为 T4 - T1（含 服务端 的 处理时间，即 客户端 等待应答 的 时长）；
+ * 以 正态分布 近似，p95 估计为 xut_srtt + 2 * xut_rttvar。
+ */
+typedef struct xntp_rtt_t
+{
+    x_uint32_t    xut_ipv4;     ///< 服务端 地址（主机字节序，0 表示 空项）
+    x_uint32_t    xut_count;    ///< 样本数量
+    x_uint32_t    xut_srtt;     ///< 往返时延 的 平滑均值（100 纳秒）
+    x_uint32_t    xut_rttvar;   ///< 往返时延 的 平滑平均偏差（100 纳秒）
+} xntp_rtt_t;
+
+/**
+ * @struct xntp_hedge_t
+ * @brief  对冲请求（参看 ntpcli_hedge()）的 统计。
+ */
+typedef struct xntp_hedge_t
+{
+    x_uint32_t    xut_requests; ///< 可对冲的 请求 数量（地址 不少于 2 个 的 单次请求）
+    x_uint32_t    xut_hedges;   ///< 额外发出的 对冲请求 数量
+    x_uint32_t    xut_wins;     ///< 对冲请求 先于 主请求 得到 有效应答 的 次数
+    xntp_rtt_t    xrtt_list[XNTP_STATE_ADDRS]; ///< 各个 地址 的 往返时延 统计
+} xntp_hedge_t;
+
+/**
+ * @struct xntp_sample_t
+ * @brief  异步请求（参看 ntpcli_async_start()）完成时，交付 回调函数 的 样本。
+ */
+typedef struct xntp_sample_t
+{
+    x_int32_t     xit_errno;    ///< 请求结果的错误码（0 表示成功；超时 为 ETIMEDOUT）
+    x_uint32_t    xut_ipv4;     ///< 最后请求的 服务端 地址（主机字节序）
+    x_uint16_t    xut_port;     ///< 服务端 的 端口号
+    xtime_vnsec_t xtm_vnsec;    ///< 成功时，校正后的 服务器时间戳（与 ntpcli_req_time_dl() 的 返回值 相同）
+    xtime_vnsec_t xtm_4time[4]; ///< T1、T2、T3、T4 四个时间戳
+    x_int64_t     xit_offset;   ///< 成功时，偏移量（UTC 减去 本地系统时间，不含 闰秒平滑，100 纳秒）
+    x_int64_t     xit_delay;    ///< 成功时，往返时延（100 纳秒）
+    x_uint32_t    xut_mackey;   ///< 应答所携带 MAC 的 key ID（无 MAC 时 为 0）
+    x_uint32_t    xut_leap;     ///< 应答的 LI
+} xntp_sample_t;
+
+/** 定义 异步请求 的 指针类型 */
+typedef struct xntp_async_t * xntp_asyncptr_t;
+
+/**
+ * @brief 异步请求 完成时的 回调函数（在 ntpcli_async_process() 中 调用，每次请求 恰好 一次）。
+ * @note
+ * 回调时 请求 已结束 且 已释放 工作通道，回调函数 内 可以 以 同一 xasync 再次 ntpcli_async_start()。
+ *
+ * @param [in ] xasync    : 异步请求。
+ * @param [in ] xsample   : 请求的 样本（仅在 回调期间 有效）。
+ * @param [in ] xpvt_ctx  : ntpcli_async_start() 传入的 回调上下文。
+ */
+typedef x_void_t (* xntp_async_cbk)(xntp_asyncptr_t xasync, const xntp_sample_t * xsample, x_pvoid_t xpvt_ctx);
+
+/** ntpcli_async_process() 的 事件：套接字 可读 */
+#define XNTP_ASYNC_READ     0x0001
+
+/** ntpcli_async_process() 的 事件：定时器 到期（截止时间 已到） */
+#define XNTP_ASYNC_TIMER    0x0002
+
+/**
+ * @struct xntp_async_t
+ * @brief  异步请求 的 状态（存储区 由 调用方 提供，首次使用前 须 清零）。
+ * @note
+ * 各字段 由 ntpcli_async_*() 维护，调用方 不可 修改；请求 进行中 时，存储区 不可 移动 或 释放。
+ */
+typedef struct xntp_async_t
+{
+    xntp_cliptr_t  xntp_this;   ///< 发起请求的 客户端对象
+    x_pvoid_t      xpvt_lane;   ///< 请求 占用的 工作通道（请求 结束后 为 X_NULL）
+    xntp_cliptr_t  xntp_spare;  ///< 工作通道 均被占用时，借用的 对象池对象
+    xntp_async_cbk xfunc_cbk;   ///< 完成时的 回调函数
+    x_pvoid_t      xpvt_ctx;    ///< 回调上下文
+    xtime_vnsec_t  xtm_dline;   ///< 单调时钟的截止时间（XTIME_INVALID_VNSEC 表示无限等待）
+    xtime_vnsec_t  xtm_adline;  ///< 当前地址 的 截止时间（剩余时间 由 尚未请求的 地址 平分）
+    x_bool_t       xbt_cached;  ///< 地址列表 是否 取自 此前的 地址缓存
+    x_uint32_t     xut_iaddr;   ///< 当前 请求的 地址 的 索引号
+    x_uint32_t     xut_naddr;   ///< 地址数量
+    x_uint32_t     xut_addrs[XNTP_STATE_ADDRS]; ///< 依次请求的 IPv4 地址（主机字节序）
+    xtime_vnsec_t  xtm_aexpire; ///< 地址列表 作为 地址缓存 的 过期时刻（UTC）
+    xtime_pair_t   xtm_base;    ///< 发送 当前请求 时 成对采集的 时钟读数
+    xntp_sweep_t   xsw_item;    ///< 当前 请求项
+} xntp_async_t;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**********************************************************/
 /**
  * @brief 打开 NTP 客户端工作对象。
+ * @note
+ * 工作对象按 在线的 CPU 核数 预留 工作通道（每个通道持有独立的 套接字），
+ * 因而可被多个线程共用，并发调用 ntpcli_req_time() 等接口时 无需加锁。
  * 
  * @return xntp_cliptr_t : 
  * 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
  */
 xntp_cliptr_t ntpcli_open(void);
 
+/**********************************************************/
+/**
+ * @brief 打开 NTP 客户端工作对象，并指定 工作通道 的数量。
+ * @note
+ * 只由单个线程使用的工作对象（如 轮询器 的各个分片），取 1 个通道即可。
+ *
+ * @param [in ] xut_lanes : 工作通道的数量（取 0 时，为 在线的 CPU 核数；最大为 64）。
+ *
+ * @return xntp_cliptr_t : 
+ * 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_cliptr_t ntpcli_open_ex(x_uint32_t xut_lanes);
+
 /**********************************************************/
 /**
  * @brief 关闭 NTP 客户端工作对象。
@@ -75,7 +230,9 @@ x_void_t ntpcli_close(xntp_cliptr_t xntp_this);
 /**********************************************************/
 /**
  * @brief 设置 NTP 服务端的 地址 与 端口号。
- * @note  必须在 ntpcli_req_time() 调用前，设置好这些工作参数。
+ * @note
+ * 必须在 ntpcli_req_time() 调用前，设置好这些工作参数；
+ * 多个线程共用工作对象时，应在共用之前完成设置。
  * 
  * @param [in ] xntp_this : NTP 客户端工作对象。
  * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名（如 3.cn.pool.ntp.org）。
@@ -89,6 +246,191 @@ x_int32_t ntpcli_config(
                 x_cstring_t xszt_host,
                 x_uint16_t xut_port);
 
+/**********************************************************/
+/**
+ * @brief 设置 请求认证 所使用的 密钥表 与 key ID（对称密钥认证：MD5、SHA1、AES-128-CMAC）。
+ * @note
+ * 设置后，请求报文 追加 MAC，应答 须携带 同一 key ID 的有效 MAC，否则 请求以 EACCES 失败；
+ * 与 ntpcli_config() 相同，多个线程共用工作对象时，应在共用之前完成设置；
+ * 密钥表 由调用方管理，须在 工作对象关闭 之前 保持有效。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xkey_table : 密钥表（取 X_NULL 时，不再认证）。
+ * @param [in ] xut_keyid  : ntpcli_req_time() 等请求 所使用的 key ID（取 0 时 不认证；
+ *                           批量请求 则使用 各请求项 自己的 key ID）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；key ID 不在密钥表中，返回 ENOENT；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_auth(
+                xntp_cliptr_t xntp_this,
+                xntp_keyptr_t xkey_table,
+                x_uint32_t xut_keyid);
+
+/**********************************************************/
+/**
+ * @brief 设置 请求 所使用的 NTS 会话（Network Time Security，RFC 8915）。
+ * @note
+ * 设置后，ntpcli_req_time() 等请求 发往 NTS-KE 握手协商的 NTP 服务端（ntpcli_config() 的设置 不再使用），
+ * 请求 与 应答 均经 AEAD 保护，对称密钥认证 的设置 被忽略；批量请求 不使用 NTS。
+ * 会话 由调用方管理，可被多个 客户端对象 或 线程 共用，须在 工作对象关闭 之前 保持有效。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xnts_sess : NTS 会话（取 X_NULL 时，不再使用 NTS）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_nts(xntp_cliptr_t xntp_this, xntp_ntsptr_t xnts_sess);
+
+/**********************************************************/
+/**
+ * @brief 设置 闰秒表 与 闰秒的处理方式（跳变 或 24 小时线性平滑）。
+ * @note
+ * ntpcli_req_time() 等接口 记录 每次应答的 LI，并据此（闰秒表 有效时 以 闰秒表 为准）维护 闰秒计划；
+ * 平滑方式 下，返回的 校正时间 经 ntpleap_smear() 计算，闰秒前后 各 12 小时 内 线性地 分摊 这 1 秒；
+ * 跳变方式（默认）下，返回的 校正时间 与 服务端 相同。批量请求 的结果 不做平滑。
+ * 与 ntpcli_config() 相同，多个线程共用工作对象时，应在共用之前完成设置；
+ * 闰秒表 由调用方管理，须在 工作对象关闭 之前 保持有效。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xleap_tab : 闰秒表（可为 X_NULL，此时 只依据 应答的 LI）。
+ * @param [in ] xit_mode  : 闰秒的处理方式（参看 xntp_leapmode_t）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_leap(
+                xntp_cliptr_t xntp_this,
+                xntp_leapptr_t xleap_tab,
+                xntp_leapmode_t xit_mode);
+
+/**********************************************************/
+/**
+ * @brief 最近一次 应答的 LI（0 无闰秒，1 插入，2 删除，3 服务端未同步）。
+ */
+x_uint32_t ntpcli_leap_ind(xntp_cliptr_t xntp_this);
+
+/**********************************************************/
+/**
+ * @brief 当前的 闰秒计划（尚无时 为 0）；可用于 以 ntpleap_smear() 平滑 其他的时间戳。
+ */
+xntp_leapplan_t ntpcli_leap_plan(xntp_cliptr_t xntp_this);
+
+/**********************************************************/
+/**
+ * @brief 设置 是否以 请求结果 校准 进程内的 TSC 时钟（参看 ntpclk_update()，默认 不校准）。
+ * @note
+ * 开启后，每次 成功的 ntpcli_req_time() 等请求，以 其偏移量（不含 闰秒平滑）校准 TSC 时钟，
+ * 此后 可由 ntpclk_now() 以 数纳秒 的开销 读取 校正后的 UTC；批量请求 不参与 校准。
+ * TSC 时钟 为 进程内 唯一，多个 客户端对象 开启时，共同校准 同一时钟。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xbt_feed  : 是否 校准。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；TSC 不可用 时，返回 ENOTSUP；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_clock(xntp_cliptr_t xntp_this, x_bool_t xbt_feed);
+
+/**********************************************************/
+/**
+ * @brief 设置 发布 请求结果 的 共享内存段（参看 ntpshm_create()，X_NULL 表示 不发布；默认 不发布）。
+ * @note
+ * 设置后，每次 成功的 ntpcli_req_time() 等请求，在 校准 TSC 时钟（若已开启 ntpcli_clock()）之后，
+ * 将 偏移量、TSC 时钟 的 模型 与（平滑方式 下）闰秒计划 发布到 共享内存段，
+ * 同一主机 的 其他进程 即可由 ntpshm_now() 读取 校正时间，而 无须 各自 请求 NTP 服务端。
+ * 共享内存段 由 调用方 管理，须在 客户端对象 关闭 之后（或 取消设置 之后）才能 关闭。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xshm_ptr  : 共享内存段（须为 发布方 的 句柄）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_publish(xntp_cliptr_t xntp_this, xntp_shmptr_t xshm_ptr);
+
+/**********************************************************/
+/**
+ * @brief 设置 热启动状态文件（X_NULL 表示 不保存；默认 不保存）。
+ * @note
+ * 设置时 加载 上次运行 保存的 状态（文件 不存在 视为 成功）：
+ * TSC 时钟 的 频率偏差 经 ntpclk_warm() 预设，服务端 的 地址 与 ntpcli_config() 的 设置一致 且 未过期 时，
+ * 作为 地址缓存，首次请求 即可 跳过 域名解析。
+ * 此后 每次 成功的 ntpcli_req_time() 等请求，至多 每 XNTP_STATE_PERIOD 秒 保存 一次 状态，
+ * 关闭 客户端对象 时 再保存 一次。
+ * 应在 ntpcli_config()、ntpcli_clock() 之后，多个线程共用工作对象 之前 调用。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xszt_path : 状态文件 的 路径（参看 ntpstate_load()）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；状态文件 格式错误，返回 EPROTO；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_state(xntp_cliptr_t xntp_this, x_cstring_t xszt_path);
+
+/**********************************************************/
+/**
+ * @brief 立即 保存 热启动状态（阻塞的 文件操作）。
+ * @note
+ * 异步请求（ntpcli_async_start()）的 完成路径 不写 状态文件，以免 阻塞 宿主的 事件循环；
+ * 只使用 异步请求 时，宿主 可在 工作线程 中 定期 调用 本接口（关闭 客户端对象 时 亦会 保存）。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功（未设置 状态文件 时 不做 任何操作）；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_state_flush(xntp_cliptr_t xntp_this);
+
+/**********************************************************/
+/**
+ * @brief 设置 是否开启 快速初始同步（iburst，默认 不开启）。
+ * @note
+ * 开启后，首次 ntpcli_req_time() 等请求 以 ntpcli_req_burst()
+ * （XNTP_IBURST_COUNT 轮，间隔 XNTP_IBURST_GAP）完成，直至 成功一次；
+ * 此后 的 请求 恢复为 单次请求。再次 开启，则 下一次请求 重新 突发。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xbt_enable : 是否开启。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_iburst(xntp_cliptr_t xntp_this, x_bool_t xbt_enable);
+
+/**********************************************************/
+/**
+ * @brief 设置 对冲请求（hedged request）的 预算（默认 不开启）。
+ * @note
+ * 开启后，域名 解析 得到 多个地址 时，ntpcli_req_time() 等 单次请求 先 向 首个地址（主请求）发送，
+ * 至 该地址 往返时延 的 p95 仍未收到 应答，再 向 第二个地址 发送 对冲请求，取 先到的 有效应答；
+ * 主请求 在此之前 即已失败（如 应答 无效），则 与 未开启时 相同，改为 请求 下一个地址，不计入 预算。
+ * 各个地址 的 往返时延 统计 随 每次应答 在线更新（参看 xntp_rtt_t），尚无统计 的 地址 按 250 毫秒 对冲；
+ * 对冲请求 以 令牌桶 限额：每次 可对冲的 请求 积累 xut_budget / 1000 次 对冲，
+ * 额外的 对冲请求 因而 不超过 请求数量 的 xut_budget / 1000 再加 1 次。
+ * 突发请求、异步请求 与 NTS 不使用 对冲。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xut_budget : 对冲请求 的 预算（千分比，如 XNTP_HEDGE_BUDGET；取 0 时 不开启；至多 1000）。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_hedge(xntp_cliptr_t xntp_this, x_uint32_t xut_budget);
+
+/**********************************************************/
+/**
+ * @brief 读取 对冲请求 的 统计 与 各个地址 的 往返时延 统计（其他线程 正在请求 时，各项 可能 相差 一次请求）。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [out] xhedge_ptr : 返回 统计信息。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_hedge_stat(xntp_cliptr_t xntp_this, xntp_hedge_t * xhedge_ptr);
+
 /**********************************************************/
 /**
  * @brief 发送 NTP 请求，获取服务器时间戳。
@@ -104,6 +446,169 @@ xtime_vnsec_t ntpcli_req_time(
                 xntp_cliptr_t xntp_this,
                 x_uint32_t xut_tmout);
 
+/**********************************************************/
+/**
+ * @brief 发送 NTP 请求，获取服务器时间戳（以 截止时间 约束整个请求流程）。
+ * @note
+ * 截止时间 以 time_mono() 的单调时钟为基准（如 time_mono() + 3000 * XTIME_VNSEC_MSEC），
+ * 对 域名解析后的多个地址 依次请求 时，共用同一截止时间，剩余时间逐级向下传递，
+ * 不会因 地址数量、EINTR 中断 或 系统时间跳变 而延长总的等待时间。
+ * 开启 ntpcli_iburst() 后，成功之前的 请求 以 突发请求 完成（参看 ntpcli_req_burst()）。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码（超时为 ETIMEDOUT）。
+ */
+xtime_vnsec_t ntpcli_req_time_dl(
+                xntp_cliptr_t xntp_this,
+                xtime_vnsec_t xtm_dline);
+
+/**********************************************************/
+/**
+ * @brief 突发请求：向 服务端 的 各个地址 并行地 连续请求 若干轮，以 最小时延 选取 样本。
+ * @note
+ * 域名 解析所得的 各个地址（参看 ntpcli_state() 的 地址缓存）视为 不同的 服务端，每轮 各发送 一个请求；
+ * 首轮 无应答的 地址 不再参与 之后的 各轮；首轮 至多等待 1 秒，之后 各轮 至多等待 已观测 最大时延 的 2 倍 加 20 毫秒。
+ * 每个 服务端 取 时延最小 的 样本（网络排队 只会 增大时延 与 偏移量误差），
+ * 有效样本 不少于 轮数 的 一半 的 服务端 中，选取 时延 的 一半 加上 样本偏差 最小者。
+ * 选中样本 随后 与 ntpcli_req_time_dl() 相同地 校准 TSC 时钟、处理 闰秒、发布 与 保存 状态。
+ * 使用 NTS 时，只请求 一个地址。
+ * 对 启用 速率限制 的 服务端，xut_gap 应 不小于 其 最小请求间隔（例如 ntpd 的 2 秒）。
+ * 
+ * @param [in ] xntp_this  : NTP 客户端工作对象。
+ * @param [in ] xut_count  : 轮数（1 ~ XNTP_IBURST_MAX）。
+ * @param [in ] xut_gap    : 相邻 两轮 开始时刻 的 最小间隔（毫秒）。
+ * @param [out] xburst_ptr : 入参不为 X_NULL 时，返回 统计 与 选中样本。
+ * @param [in ] xtm_dline  : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码（没有 服务端 的 有效样本 足够多 时，为 最后的 请求错误码 或 ETIMEDOUT）。
+ */
+xtime_vnsec_t ntpcli_req_burst(
+                xntp_cliptr_t xntp_this,
+                x_uint32_t xut_count,
+                x_uint32_t xut_gap,
+                xntp_burst_t * xburst_ptr,
+                xtime_vnsec_t xtm_dline);
+
+/**********************************************************/
+/**
+ * @brief 批量请求：向多个 NTP 服务端（IPv4 地址）同时发送请求，并在截止时间前收集应答。
+ * @note
+ * 所有请求共用 xntp_this 的同一 工作通道（套接字），应答按 (地址, 端口) 与 originate 时间戳 匹配到请求项；
+ * 在支持 io_uring 的 Linux 平台上，整个批量请求只需少量的系统调用，
+ * 否则（或 运行时检测到内核不支持时）自动回退为 sendto()/select()/recvfrom() 方式。
+ * 
+ * @param [in    ] xntp_this : NTP 客户端工作对象。
+ * @param [in,out] xsw_list  : 请求项列表（输入 地址、端口，输出 各项的结果）。
+ * @param [in    ] xut_count : 请求项数量。
+ * @param [in    ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示批量请求已执行（各请求项的结果见其 xit_errno，超时的为 ETIMEDOUT）；
+ * 其他值则表示操作失败的错误码。
+ */
+x_int32_t ntpcli_req_sweep(
+                xntp_cliptr_t xntp_this,
+                xntp_sweep_t * xsw_list,
+                x_uint32_t xut_count,
+                xtime_vnsec_t xtm_dline);
+
+/**********************************************************/
+/**
+ * @brief 开始 异步请求：发送 NTP 请求 后 立即返回，由 宿主的 事件循环 驱动 后续的 接收 与 超时。
+ * @note
+ * 宿主 以 ntpcli_async_fd() 的 套接字 注册 可读事件，以 ntpcli_async_deadline() 设置 定时器，
+ * 事件 发生 时 调用 ntpcli_async_process()；整个过程 不阻塞，也不创建 线程。
+ * 请求 占用 客户端对象 的 一个 工作通道，直至 完成 或 ntpcli_async_close()，
+ * 因而 一个 客户端对象 可同时 进行 多个 异步请求（通道 不足 时 借用 线程私有对象池 的 对象，
+ * 此时 请求 的 各个接口 须在 同一线程 调用）。
+ * 服务端 为 域名 时，依次 请求 地址缓存 中的 地址（参看 ntpcli_state()）；没有 可用的 地址缓存 时，
+ * 不解析域名（getaddrinfo() 为 阻塞操作），直接 返回 EAGAIN，由 宿主 在 工作线程 中 调用 ntpcli_resolve_host()。
+ * 地址缓存 的 地址 全部失败（超时 除外）时，清除 地址缓存，下一次 请求 返回 EAGAIN。
+ * 成功的 结果 与 ntpcli_req_time_dl() 相同地 校准 TSC 时钟、处理 闰秒、发布 状态，
+ * 但 不写 状态文件（参看 ntpcli_state_flush()）；
+ * 不使用 快速初始同步（ntpcli_iburst()）；设置了 NTS 会话 时，返回 ENOTSUP。
+ * 关闭 客户端对象 之前，其 所有 异步请求 须已 结束 或 取消（ntpcli_async_close()）。
+ * 
+ * @param [in ] xasync    : 异步请求 的 存储区（首次使用前 须 清零）。
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ * @param [in ] xfunc_cbk : 完成时的 回调函数。
+ * @param [in ] xpvt_ctx  : 回调上下文。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示 请求 已发出（之后 恰好 回调 一次，除非 先行 ntpcli_async_close()）；
+ * 请求 正在进行中，返回 EBUSY；没有 可用的 地址缓存，返回 EAGAIN；其他值则表示操作失败的错误码（不回调）。
+ */
+x_int32_t ntpcli_async_start(
+                xntp_asyncptr_t xasync,
+                xntp_cliptr_t xntp_this,
+                xtime_vnsec_t xtm_dline,
+                xntp_async_cbk xfunc_cbk,
+                x_pvoid_t xpvt_ctx);
+
+/**********************************************************/
+/**
+ * @brief 异步请求 所使用的 套接字（非阻塞；请求 未在进行中 时，返回 X_INVALID_SOCKFD）。
+ * @note
+ * 同一 xasync 的 各次请求 可能 使用 不同的 套接字，每次 ntpcli_async_start() 之后 须 重新获取。
+ */
+x_sockfd_t ntpcli_async_fd(xntp_asyncptr_t xasync);
+
+/**********************************************************/
+/**
+ * @brief 异步请求 的 截止时间（单调时钟，参看 time_mono()；无限等待 或 未在进行中 时，返回 XTIME_INVALID_VNSEC）。
+ * @note
+ * 依次请求 多个 缓存地址 时，返回 当前地址 的 截止时间（剩余时间 由 尚未请求的 地址 平分），
+ * 到期后 ntpcli_async_process() 改为 请求 下一个地址，宿主 应 重新获取 并 设置 定时器。
+ */
+xtime_vnsec_t ntpcli_async_deadline(xntp_asyncptr_t xasync);
+
+/**********************************************************/
+/**
+ * @brief 处理 宿主事件循环 报告的 事件（接收 应答、检查 截止时间）。
+ * @note
+ * XNTP_ASYNC_READ 时，读空 套接字缓存 并 匹配 应答；无论 事件 为何，均检查 截止时间。
+ * 当前地址 失败（如 发送失败、应答 无效）时，在 截止时间 之前 改为 请求 下一个地址。
+ * 请求 结束 时，释放 工作通道，再 调用 回调函数（回调 为 本接口 的 最后一步）。
+ * 返回 EINPROGRESS 时（如 定时器 提前 到期），宿主 应 按 ntpcli_async_deadline() 重新设置 定时器。
+ * 
+ * @param [in ] xasync    : 异步请求。
+ * @param [in ] xut_events : 事件（XNTP_ASYNC_READ、XNTP_ASYNC_TIMER 的 组合，可为 0）。
+ * 
+ * @return x_int32_t : 
+ * 请求 仍在进行中，返回 EINPROGRESS；请求 已结束（本次 或 此前 已回调），返回 0；参数无效，返回 EINVAL。
+ */
+x_int32_t ntpcli_async_process(xntp_asyncptr_t xasync, x_uint32_t xut_events);
+
+/**********************************************************/
+/**
+ * @brief 取消 异步请求（进行中的 请求 不再回调；已结束 的 请求，直接返回）。
+ * @note
+ * 宿主 须先 注销 套接字 的 事件，再 调用 本接口（套接字 随 工作通道 归还 客户端对象，并不关闭）。
+ */
+x_void_t ntpcli_async_close(xntp_asyncptr_t xasync);
+
+/**********************************************************/
+/**
+ * @brief 解析 服务端 的 域名，建立 地址缓存（阻塞操作）。
+ * @note
+ * 异步请求 不在 宿主的 事件循环 中 解析域名：ntpcli_async_start() 没有 可用的 地址缓存 时 返回 EAGAIN，
+ * 宿主 可在 工作线程（如 libuv 的 uv_queue_work()、asio 的 thread_pool）中 调用 本接口，完成后 再 发起请求；
+ * 也可 经 ntpcli_state() 载入 上次运行 的 地址缓存。服务端 为 IPv4 地址 时，直接返回 0。
+ * 
+ * @param [in ] xntp_this : NTP 客户端工作对象。
+ * 
+ * @return x_int32_t : 
+ * 返回 0 表示操作成功；其他值则表示操作失败的错误码（getaddrinfo() 的 错误码，或 EADDRNOTAVAIL）。
+ */
+x_int32_t ntpcli_resolve_host(xntp_cliptr_t xntp_this);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**********************************************************/
@@ -111,8 +616,8 @@ xtime_vnsec_t ntpcli_req_time(
  * @brief 
  * 向 NTP 服务器发送 NTP 请求，获取服务器时间戳。
  * @note 
- * 该接口内部自动 创建/销毁 NTP 客户端对象，执行完整的 NTP 请求流程。
- * 这适用于只执行单次请求操作。
+ * 该接口内部自动 取出/归还 线程私有对象池 中的 NTP 客户端对象，执行完整的 NTP 请求流程。
+ * 这适用于只执行单次请求操作，在循环中反复调用时，不会反复 分配内存 与 创建套接字。
  *
  * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名（如 3.cn.pool.ntp.org）。
  * @param [in ] xut_port  : NTP 服务器的 端口号（可取默认的端口号 NTP_PORT : 123）。
@@ -127,6 +632,26 @@ xtime_vnsec_t ntpcli_get_time(
                     x_uint16_t xut_port,
                     x_uint32_t xut_tmout);
 
+/**********************************************************/
+/**
+ * @brief 
+ * 向 NTP 服务器发送 NTP 请求，获取服务器时间戳（以 截止时间 约束整个请求流程）。
+ * @note 
+ * 与 ntpcli_get_time() 相同，只是超时参数换为 单调时钟 的 截止时间。
+ *
+ * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名（如 3.cn.pool.ntp.org）。
+ * @param [in ] xut_port  : NTP 服务器的 端口号（可取默认的端口号 NTP_PORT : 123）。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ *
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断是否为有效值；
+ * 若值无效，则可通过 errno 获知错误码。
+ */
+xtime_vnsec_t ntpcli_get_time_dl(
+                    x_cstring_t xszt_host,
+                    x_uint16_t xut_port,
+                    xtime_vnsec_t xtm_dline);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef __cplusplus
@@ -0,0 +1,670 @@
+﻿/**
+ * @file ntp_client.hpp
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 客户端 的 C++20 封装（只有头文件）：RAII 的 客户端对象、协程 可等待的 异步请求、
+ *            when_all() 并发请求、std::stop_token 取消，以及 std::future 形式的 请求。
+ * @note
+ * 建立在 ntpcli_async_*() 之上：请求 的 状态 存放在 协程帧 中（co_await 的 临时对象），
+ * 挂起的 请求 除 协程帧 之外，不分配 内存，也不占用 线程。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_CLIENT_HPP__
+#define __NTP_CLIENT_HPP__
+
+#include "ntp_client.h"
+
+#include <array>
+#include <cerrno>
+#include <coroutine>
+#include <cstring>
+#include <future>
+#include <optional>
+#include <stop_token>
+#include <system_error>
+#include <utility>
+
+#if (defined(_WIN32) || defined(_WIN64))
+#include <WinSock2.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <sys/select.h>
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace xntp
+{
+
+/** 请求的 结果：偏移量、往返时延 等（参看 xntp_sample_t；被取消 时 xit_errno 为 ECANCELED） */
+using sample = xntp_sample_t;
+
+class request;
+
+//====================================================================
+
+/**
+ * @class driver
+ * @brief 驱动 异步请求 的 事件循环 接口。
+ * @note
+ * request 开始后 调用 attach()：实现方 为 request::fd() 注册 可读事件，按 request::deadline() 设置 定时器；
+ * 事件 发生 时 调用 request::process()，返回 true 表示 请求 已结束（其间 已调用 detach() 并 恢复 等待的 协程）。
+ * 接入 libuv、asio 等 外部事件循环 时，实现 本接口 即可；select_loop 为 内置的 实现。
+ * 所有 调用 均在 事件循环 的 线程 中 进行。
+ */
+class driver
+{
+public:
+    virtual ~driver(void) = default;
+
+    /** 请求 已发出：开始 监视 其 套接字 与 截止时间 */
+    virtual void attach(request & xreq) noexcept = 0;
+
+    /** 请求 即将结束 或 取消：停止 监视（随后 其 套接字 归还 客户端对象） */
+    virtual void detach(request & xreq) noexcept = 0;
+};
+
+//====================================================================
+
+/**
+ * @class request
+ * @brief 一次 异步请求（可 co_await，结果 为 sample）。
+ * @note
+ * 由 client::query() 创建；开始（co_await 或 start()）之后 不可 移动，直至 结束。
+ * 请求 进行中 被 析构（如 协程 被 销毁）时，直接 取消，不再 恢复 协程。
+ * std::stop_token 的 取消请求 须在 事件循环 的 线程 中 发出，被取消的 请求 以 ECANCELED 结束。
+ */
+class request
+{
+    template <std::size_t N> friend class when_all_awaitable;
+
+    /** std::stop_callback 的 回调：取消 请求 */
+    struct stopper
+    {
+        request * xreq_this;
+        void operator()(void) const noexcept { xreq_this->cancel(); }
+    };
+
+public:
+    request(xntp_cliptr_t xntp_this, driver & xdrv_this, xtime_vnsec_t xtm_dline, std::stop_token xstop_tok = {}) noexcept
+        : xntp_this(xntp_this)
+        , xdrv_this(&xdrv_this)
+        , xtm_dline(xtm_dline)
+        , xstop_tok(std::move(xstop_tok))
+    {
+        reset();
+    }
+
+    /** 只可 移动 尚未开始的 请求 */
+    request(request && xother) noexcept
+        : xntp_this(xother.xntp_this)
+        , xdrv_this(xother.xdrv_this)
+        , xtm_dline(xother.xtm_dline)
+        , xstop_tok(std::move(xother.xstop_tok))
+    {
+        reset();
+    }
+
+    request(const request &) = delete;
+    request & operator=(const request &) = delete;
+    request & operator=(request &&) = delete;
+
+    ~request(void)
+    {
+        if (xbt_pending)
+        {
+            xco_wait = nullptr;
+            xut_left = nullptr;
+            finish(ECANCELED);
+        }
+    }
+
+    //======================================
+    // 可等待对象 的 接口
+
+    bool await_ready(void) noexcept { return !start(); }
+    void await_suspend(std::coroutine_handle<> xco_wait) noexcept { this->xco_wait = xco_wait; }
+    sample await_resume(void) const noexcept { return xsample; }
+
+    //======================================
+
+    /**********************************************************/
+    /**
+     * @brief 发出 请求，并 交由 driver 监视。
+     *
+     * @return bool : 请求 进行中，返回 true；已结束（发起失败 或 已被取消），返回 false，结果 见 result()。
+     */
+    bool start(void) noexcept
+    {
+        x_int32_t xit_errno = ntpcli_async_start(&xasync, xntp_this, xtm_dline, &request::on_done, this);
+        if (0 != xit_errno)
+        {
+            xsample.xit_errno = xit_errno;
+            return false;
+        }
+
+        xbt_pending = true;
+        xdrv_this->attach(*this);
+
+        // 已经 发出的 取消请求，在 构造 std::stop_callback 时 立即 回调
+        if (xstop_tok.stop_possible())
+        {
+            xstop_cbk.emplace(xstop_tok, stopper{ this });
+        }
+
+        return xbt_pending;
+    }
+
+    /** 请求 是否 进行中 */
+    bool pending(void) const noexcept { return xbt_pending; }
+
+    /** 请求 所使用的 套接字（参看 ntpcli_async_fd()） */
+    x_sockfd_t fd(void) const noexcept { return ntpcli_async_fd(const_cast<xntp_async_t *>(&xasync)); }
+
+    /** 请求 的 截止时间（单调时钟，XTIME_INVALID_VNSEC 表示 无限等待） */
+    xtime_vnsec_t deadline(void) const noexcept { return ntpcli_async_deadline(const_cast<xntp_async_t *>(&xasync)); }
+
+    /** 请求 的 结果（请求 结束后 有效） */
+    const sample & result(void) const noexcept { return xsample; }
+
+    /**********************************************************/
+    /**
+     * @brief 处理 事件（XNTP_ASYNC_READ、XNTP_ASYNC_TIMER 的 组合，参看 ntpcli_async_process()）。
+     *
+     * @return bool : 请求 已结束（已 detach() 并 恢复 等待的 协程），返回 true；否则 返回 false。
+     */
+    bool process(x_uint32_t xut_events) noexcept
+    {
+        if (!xbt_pending)
+        {
+            return true;
+        }
+
+        if (EINPROGRESS == ntpcli_async_process(&xasync, xut_events))
+        {
+            return false;
+        }
+
+        xbt_pending = false;
+        xdrv_this->detach(*this);
+        resume();
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 取消 请求（以 ECANCELED 结束，并 恢复 等待的 协程）；请求 未在进行中 时，直接返回。
+     */
+    void cancel(void) noexcept
+    {
+        if (xbt_pending)
+        {
+            finish(ECANCELED);
+        }
+    }
+
+    //======================================
+
+    request * xlink_prev = nullptr; ///< 供 driver 的 实现 使用的 链表指针
+    request * xlink_next = nullptr; ///< 供 driver 的 实现 使用的 链表指针
+
+private:
+    /**********************************************************/
+    /**
+     * @brief 重置 结果 与 异步请求 的 状态。
+     */
+    void reset(void) noexcept
+    {
+        std::memset(&xasync, 0, sizeof(xntp_async_t));
+        std::memset(&xsample, 0, sizeof(sample));
+        xsample.xit_errno = EINVAL;
+        xsample.xtm_vnsec = XTIME_INVALID_VNSEC;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 以 错误码 结束 进行中的 请求（不回调 ntpcli_async_start() 的 回调函数）。
+     */
+    void finish(x_int32_t xit_errno) noexcept
+    {
+        xbt_pending = false;
+        xdrv_this->detach(*this);
+        ntpcli_async_close(&xasync);
+
+        std::memset(&xsample, 0, sizeof(sample));
+        xsample.xit_errno = xit_errno;
+        xsample.xtm_vnsec = XTIME_INVALID_VNSEC;
+
+        resume();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 恢复 等待的 协程（when_all() 中，最后 结束的 请求 才 恢复）。
+     */
+    void resume(void) noexcept
+    {
+        if ((nullptr != xut_left) && (0 != --*xut_left))
+        {
+            return;
+        }
+
+        if (xco_wait)
+        {
+            std::exchange(xco_wait, nullptr).resume();
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief ntpcli_async_start() 的 回调函数：记录 样本。
+     */
+    static x_void_t on_done(xntp_asyncptr_t xasync, const xntp_sample_t * xsample, x_pvoid_t xpvt_ctx)
+    {
+        (x_void_t)xasync;
+        static_cast<request *>(xpvt_ctx)->xsample = *xsample;
+    }
+
+private:
+    xntp_cliptr_t           xntp_this;              ///< 发起请求的 客户端对象
+    driver                * xdrv_this;              ///< 驱动 请求 的 事件循环
+    xtime_vnsec_t           xtm_dline;              ///< 单调时钟的截止时间
+    std::stop_token         xstop_tok;              ///< 取消 令牌
+    std::optional<std::stop_callback<stopper>> xstop_cbk; ///< 取消 回调（请求 开始后 注册）
+    std::coroutine_handle<> xco_wait = nullptr;     ///< 等待 请求 的 协程
+    x_uint32_t            * xut_left = nullptr;     ///< when_all() 中 尚未结束的 请求 计数
+    bool                    xbt_pending = false;    ///< 请求 是否 进行中
+    xntp_async_t            xasync;                 ///< 异步请求 的 状态
+    sample                  xsample;                ///< 请求的 结果
+};
+
+//====================================================================
+
+/**
+ * @class select_loop
+ * @brief 以 select() 实现的 单线程 事件循环（driver 的 内置实现）。
+ * @note
+ * 以 侵入式链表 管理 进行中的 请求，不分配 内存；套接字 须 小于 FD_SETSIZE（Windows 除外）。
+ */
+class select_loop final : public driver
+{
+public:
+    select_loop(void) = default;
+    select_loop(const select_loop &) = delete;
+    select_loop & operator=(const select_loop &) = delete;
+
+    void attach(request & xreq) noexcept override
+    {
+        xreq.xlink_prev = nullptr;
+        xreq.xlink_next = xreq_head;
+        if (nullptr != xreq_head)
+            xreq_head->xlink_prev = &xreq;
+        xreq_head = &xreq;
+    }
+
+    void detach(request & xreq) noexcept override
+    {
+        if (nullptr != xreq.xlink_prev)
+            xreq.xlink_prev->xlink_next = xreq.xlink_next;
+        else
+            xreq_head = xreq.xlink_next;
+
+        if (nullptr != xreq.xlink_next)
+            xreq.xlink_next->xlink_prev = xreq.xlink_prev;
+
+        xreq.xlink_prev = nullptr;
+        xreq.xlink_next = nullptr;
+    }
+
+    /** 是否 没有 进行中的 请求 */
+    bool empty(void) const noexcept { return (nullptr == xreq_head); }
+
+    /**********************************************************/
+    /**
+     * @brief 等待 并 处理 一轮 事件。
+     *
+     * @param [in ] xtm_wait : 最长的 等待时间（100 纳秒）；取 XTIME_INVALID_VNSEC 时，至多 等到 最早的 截止时间。
+     *
+     * @return x_int32_t : 成功（含 超时），返回 0；select() 失败，返回 错误码。
+     */
+    x_int32_t run_once(xtime_vnsec_t xtm_wait = XTIME_INVALID_VNSEC) noexcept
+    {
+        xtime_vnsec_t  xtm_now  = time_mono();
+        xtime_vnsec_t  xtm_wake = XTMVNSEC_IS_VALID(xtm_wait) ? (xtm_now + xtm_wait) : XTIME_INVALID_VNSEC;
+        xtime_vnsec_t  xtm_dline = XTIME_INVALID_VNSEC;
+        x_sockfd_t     xfdt_max = 0;
+        x_sockfd_t     xfdt_sock = X_INVALID_SOCKFD;
+        x_uint32_t     xut_events = 0;
+        request      * xreq_iter = nullptr;
+        fd_set         xfds_rset;
+        struct timeval xtm_value;
+
+        if (empty())
+        {
+            return 0;
+        }
+
+        //======================================
+
+        FD_ZERO(&xfds_rset);
+        for (xreq_iter = xreq_head; nullptr != xreq_iter; xreq_iter = xreq_iter->xlink_next)
+        {
+            xfdt_sock = xreq_iter->fd();
+            FD_SET(xfdt_sock, &xfds_rset);
+            if (xfdt_sock > xfdt_max)
+                xfdt_max = xfdt_sock;
+
+            xtm_dline = xreq_iter->deadline();
+            if (XTMVNSEC_IS_VALID(xtm_dline) && (!XTMVNSEC_IS_VALID(xtm_wake) || (xtm_dline < xtm_wake)))
+                xtm_wake = xtm_dline;
+        }
+
+        if (XTMVNSEC_IS_VALID(xtm_wake))
+        {
+            xtm_wake = (xtm_wake > xtm_now) ? (xtm_wake - xtm_now) : 0;
+            xtm_value.tv_sec  = (x_long_t)(xtm_wake / (1000ULL * XTIME_VNSEC_MSEC));
+            xtm_value.tv_usec = (x_long_t)((xtm_wake % (1000ULL * XTIME_VNSEC_MSEC)) / 10ULL);
+        }
+
+        if (select((x_int32_t)(xfdt_max + 1),
+                   &xfds_rset,
+                   nullptr,
+                   nullptr,
+                   XTMVNSEC_IS_VALID(xtm_wake) ? &xtm_value : nullptr) < 0)
+        {
+#if (defined(_WIN32) || defined(_WIN64))
+            return WSAGetLastError();
+#else // !(defined(_WIN32) || defined(_WIN64))
+            return (EINTR == errno) ? 0 : errno;
+#endif // (defined(_WIN32) || defined(_WIN64))
+        }
+
+        //======================================
+        // 请求 结束 时 恢复的 协程 可能 发起 或 取消 其他请求，因而 从头 重新遍历
+
+        xtm_now = time_mono();
+        for (xreq_iter = xreq_head; nullptr != xreq_iter; )
+        {
+            xut_events = FD_ISSET(xreq_iter->fd(), &xfds_rset) ? XNTP_ASYNC_READ : 0;
+            xtm_dline  = xreq_iter->deadline();
+            if (XTMVNSEC_IS_VALID(xtm_dline) && (xtm_now >= xtm_dline))
+                xut_events |= XNTP_ASYNC_TIMER;
+
+            if ((0 != xut_events) && xreq_iter->process(xut_events))
+                xreq_iter = xreq_head;
+            else
+                xreq_iter = xreq_iter->xlink_next;
+        }
+
+        return 0;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 运行 事件循环，直至 没有 进行中的 请求。
+     */
+    void run(void) noexcept
+    {
+        while (!empty())
+        {
+            run_once();
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 发出 请求（由 本事件循环 驱动），并 运行 事件循环 直至 该请求 结束（不需要 协程）。
+     */
+    sample wait(request & xreq) noexcept
+    {
+        if (xreq.start())
+        {
+            while (xreq.pending())
+            {
+                run_once();
+            }
+        }
+
+        return xreq.result();
+    }
+
+private:
+    request * xreq_head = nullptr;  ///< 进行中的 请求 链表
+};
+
+//====================================================================
+
+/**
+ * @class client
+ * @brief NTP 客户端对象 的 RAII 封装（取代 ntpcli_open()/ntpcli_close()），对应 一个 服务端。
+ * @note
+ * 地址缓存、TSC 时钟 校准 等 均 随 客户端对象，因而 每个 服务端 使用 各自的 客户端对象；
+ * 其他设置（ntpcli_auth()、ntpcli_state() 等）以 get() 取得 句柄 后 调用 C 接口。
+ * 关闭（析构）之前，其 所有 请求 须已 结束。
+ */
+class client
+{
+public:
+    /**********************************************************/
+    /**
+     * @brief 打开 客户端对象，并 设置 服务端（失败时 抛出 std::system_error）。
+     *
+     * @param [in ] xszt_host : NTP 服务器的 IP（四段式 IP 地址） 或 域名。
+     * @param [in ] xut_port  : NTP 服务器的 端口号。
+     * @param [in ] xut_lanes : 工作通道的数量（参看 ntpcli_open_ex()）。
+     */
+    explicit client(x_cstring_t xszt_host, x_uint16_t xut_port = NTP_PORT, x_uint32_t xut_lanes = 0)
+        : xntp_this(ntpcli_open_ex(xut_lanes))
+    {
+        x_int32_t xit_errno = 0;
+
+        if (nullptr == xntp_this)
+        {
+            throw std::system_error(errno, std::generic_category(), "ntpcli_open_ex");
+        }
+
+        xit_errno = ntpcli_config(xntp_this, xszt_host, xut_port);
+        if (0 != xit_errno)
+        {
+            ntpcli_close(xntp_this);
+            xntp_this = nullptr;
+            throw std::system_error(xit_errno, std::generic_category(), "ntpcli_config");
+        }
+    }
+
+    client(client && xother) noexcept
+        : xntp_this(std::exchange(xother.xntp_this, nullptr))
+    {
+    }
+
+    client & operator=(client && xother) noexcept
+    {
+        if (this != &xother)
+        {
+            close();
+            xntp_this = std::exchange(xother.xntp_this, nullptr);
+        }
+
+        return *this;
+    }
+
+    client(const client &) = delete;
+    client & operator=(const client &) = delete;
+
+    ~client(void)
+    {
+        close();
+    }
+
+    /** 客户端对象 的 句柄（用于 调用 C 接口；已移走 时 为 X_NULL） */
+    xntp_cliptr_t get(void) const noexcept { return xntp_this; }
+
+    /**********************************************************/
+    /**
+     * @brief 创建 异步请求（co_await 时 发出，结果 为 sample）。
+     *
+     * @param [in ] xdrv_this : 驱动 请求 的 事件循环。
+     * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+     * @param [in ] xstop_tok : 取消 令牌（可选）。
+     */
+    request query(driver & xdrv_this, xtime_vnsec_t xtm_dline, std::stop_token xstop_tok = {}) const noexcept
+    {
+        return request(xntp_this, xdrv_this, xtm_dline, std::move(xstop_tok));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 以 std::future 的 形式 请求（延迟执行：get()/wait() 时 在 调用线程 以 私有的 select_loop 完成）。
+     * @note
+     * 不创建 线程；std::future 的 共享状态 由 标准库 分配。没有 可用的 地址缓存（EAGAIN）时，
+     * 在 调用线程 解析域名（ntpcli_resolve_host()）后 再 请求 一次。
+     */
+    std::future<sample> query_future(xtime_vnsec_t xtm_dline) const
+    {
+        xntp_cliptr_t xntp_this = this->xntp_this;
+
+        return std::async(std::launch::deferred, [xntp_this, xtm_dline](void) -> sample
+        {
+            select_loop xloop;
+            sample      xsample{};
+
+            {
+                request xreq(xntp_this, xloop, xtm_dline);
+                xsample = xloop.wait(xreq);
+            }
+
+            if ((EAGAIN == xsample.xit_errno) && (0 == ntpcli_resolve_host(xntp_this)))
+            {
+                request xreq(xntp_this, xloop, xtm_dline);
+                xsample = xloop.wait(xreq);
+            }
+
+            return xsample;
+        });
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 解析 服务端 的 域名，建立 地址缓存（阻塞操作，失败时 抛出 std::system_error）。
+     * @note
+     * query() 没有 可用的 地址缓存 时 以 EAGAIN 结束，宿主 可在 工作线程 中 调用 本接口 后 再 请求。
+     */
+    void resolve(void) const
+    {
+        x_int32_t xit_errno = ntpcli_resolve_host(xntp_this);
+        if (0 != xit_errno)
+        {
+            throw std::system_error(xit_errno, std::generic_category(), "ntpcli_resolve_host");
+        }
+    }
+
+private:
+    void close(void) noexcept
+    {
+        if (nullptr != xntp_this)
+        {
+            ntpcli_close(xntp_this);
+            xntp_this = nullptr;
+        }
+    }
+
+private:
+    xntp_cliptr_t xntp_this = nullptr;  ///< 客户端对象
+};
+
+//====================================================================
+
+/**
+ * @class when_all_awaitable
+ * @brief 同时 发出 多个 请求，全部 结束后 恢复 协程（结果 为 std::array<sample, N>，顺序 与 参数 相同）。
+ */
+template <std::size_t N>
+class when_all_awaitable
+{
+public:
+    template <class... R>
+    explicit when_all_awaitable(R &&... xreqs) noexcept
+        : xreq_list{ { std::forward<R>(xreqs)... } }
+    {
+    }
+
+    when_all_awaitable(const when_all_awaitable &) = delete;
+    when_all_awaitable & operator=(const when_all_awaitable &) = delete;
+
+    bool await_ready(void) noexcept
+    {
+        xut_left = 0;
+        for (request & xreq : xreq_list)
+        {
+            if (xreq.start())
+            {
+                xreq.xut_left = &xut_left;
+                xut_left += 1;
+            }
+        }
+
+        return (0 == xut_left);
+    }
+
+    void await_suspend(std::coroutine_handle<> xco_wait) noexcept
+    {
+        for (request & xreq : xreq_list)
+        {
+            if (xreq.pending())
+                xreq.xco_wait = xco_wait;
+        }
+    }
+
+    std::array<sample, N> await_resume(void) const noexcept
+    {
+        std::array<sample, N> xsamples;
+        for (std::size_t xst_iter = 0; xst_iter < N; ++xst_iter)
+            xsamples[xst_iter] = xreq_list[xst_iter].result();
+        return xsamples;
+    }
+
+private:
+    std::array<request, N> xreq_list;  ///< 各个 请求
+    x_uint32_t             xut_left = 0; ///< 尚未结束的 请求 计数
+};
+
+/**********************************************************/
+/**
+ * @brief 并发请求：co_await xntp::when_all(c1.query(loop, dl), c2.query(loop, dl), ...)。
+ */
+template <class... R>
+when_all_awaitable<sizeof...(R)> when_all(R &&... xreqs) noexcept
+{
+    return when_all_awaitable<sizeof...(R)>(std::forward<R>(xreqs)...);
+}
+
+} // namespace xntp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_CLIENT_HPP__
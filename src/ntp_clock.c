@@ -0,0 +1,449 @@
+﻿/**
+ * @file ntp_clock.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 以 NTP 结果 校准的 TSC 时钟 的实现。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_clock.h"
+#include "xatomic.h"
+
+#include <string.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 内部相关的数据类型与常量
+//
+
+/** 相位调整 的 最短、最长 时长（秒） */
+#define XNTP_CLK_SLEW_MIN   1
+#define XNTP_CLK_SLEW_MAX   64
+
+/** 32.32 定点数 的 比例因子 */
+#define XNTP_CLK_FIXED      4294967296.0
+
+/**
+ * @struct xntp_clock_t
+ * @brief  进程内的 TSC 时钟。
+ * @note
+ * 模型 由 读取方 无锁访问；其余字段 只由 持有 序列锁（模型的 序列号 为奇数）的 校准方 读写，
+ * 校准状态 xstat 的 读取 也经 序列锁 保证 一致性。
+ */
+typedef struct xntp_clock_t
+{
+    xntp_clkmodel_t xclk_model;     ///< TSC → UTC 模型
+    x_uint64_t      xut_ref_tsc;    ///< 频率基线 的 起点：TSC 读数
+    x_uint64_t      xut_ref_nsec;   ///< 频率基线 的 起点：UTC 纳秒数
+    x_uint64_t      xut_last_tsc;   ///< 上次校准 的 TSC 读数
+    x_bool_t        xbt_based;      ///< 频率 是否 已由 基线 估计
+    x_bool_t        xbt_hint;       ///< 是否 预设了 频率偏差
+    x_int64_t       xit_hint;       ///< 预设的 频率偏差（ppb，参看 ntpclk_warm()）
+    xntp_clkstat_t  xstat;          ///< 校准状态
+} xntp_clock_t;
+
+/** 进程内 唯一的 TSC 时钟 */
+static xntp_clock_t g_xntp_clock;
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 按 模型参数 换算 TSC 读数（参看 xntp_clkmodel_t 的 公式）。
+ * @note
+ * 频率项 以 32 位 拆分 TSC 差值，避免 64 位乘法 溢出；
+ * 相位项 的 乘积 不超过 |相位误差| * 2^32（相位误差 小于 XNTP_CLK_STEP），不会溢出。
+ */
+static inline x_uint64_t ntpclk_calc(
+                            x_uint64_t xut_base,
+                            x_uint64_t xut_nsec,
+                            x_uint64_t xut_mult,
+                            x_int64_t  xit_slew,
+                            x_uint64_t xut_span,
+                            x_uint64_t xut_tsc)
+{
+    x_bool_t   xbt_after = (xut_tsc >= xut_base);
+    x_uint64_t xut_diff  = xbt_after ? (xut_tsc - xut_base) : (xut_base - xut_tsc);
+    x_uint64_t xut_freq  = ((xut_diff >> 32) * xut_mult) + (((xut_diff & 0xFFFFFFFFULL) * xut_mult) >> 32);
+    x_int64_t  xit_ramp  = xbt_after ? (x_int64_t)((xut_diff < xut_span) ? xut_diff : xut_span) : 0;
+
+    return (xbt_after ? (xut_nsec + xut_freq) : (xut_nsec - xut_freq)) +
+           (x_uint64_t)((xit_ramp * xit_slew) / 4294967296LL);
+}
+
+/**********************************************************/
+/**
+ * @brief 将 TSC 标称频率（Hz）转为 每个周期 的 纳秒数（32.32 定点数）。
+ */
+static inline x_uint64_t ntpclk_nominal(x_uint64_t xut_freq)
+{
+    return (x_uint64_t)(1.0e9 * XNTP_CLK_FIXED / (double)xut_freq);
+}
+
+/**********************************************************/
+/**
+ * @brief 尚无 基线估计 时 所用的 频率（32.32 定点数）：标称频率，及 预设的 频率偏差。
+ */
+static inline x_uint64_t ntpclk_rate(xntp_clock_t * xclk_this, x_uint64_t xut_freq)
+{
+    if (!xclk_this->xbt_hint)
+    {
+        return ntpclk_nominal(xut_freq);
+    }
+
+    return (x_uint64_t)((double)ntpclk_nominal(xut_freq) * (1.0 + (double)xclk_this->xit_hint * 1.0e-9));
+}
+
+//====================================================================
+
+//
+// 外部相关操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 按 模型 换算 TSC 读数（序列锁 的 读取方）。
+ * @note
+ * 只读取 模型 与 执行 乘法，不经 系统调用；模型 未校准 时，返回 0。
+ *
+ * @param [in ] xclk_model : TSC → UTC 模型（可位于 共享内存）。
+ * @param [in ] xut_tsc    : TSC 读数（参看 time_tsc()）。
+ *
+ * @return x_uint64_t : 返回 UTC（自 1970 年起的 纳秒数）。
+ */
+x_uint64_t ntpclk_model_ns(const xntp_clkmodel_t * xclk_model, x_uint64_t xut_tsc)
+{
+    x_uint32_t xut_seqn  = 0;
+    x_uint32_t xut_valid = 0;
+    x_uint64_t xut_base  = 0;
+    x_uint64_t xut_nsec  = 0;
+    x_uint64_t xut_mult  = 0;
+    x_int64_t  xit_slew  = 0;
+    x_uint64_t xut_span  = 0;
+
+    for (;;)
+    {
+        xut_seqn = XATOMIC_LOAD32(&xclk_model->xut_seqn);
+        if (xut_seqn & 1)
+        {
+            XATOMIC_PAUSE();
+            continue;
+        }
+
+        xut_valid = XATOMIC_LOAD32(&xclk_model->xut_valid);
+        xut_base  = XATOMIC_LOAD64(&xclk_model->xut_tsc );
+        xut_nsec  = XATOMIC_LOAD64(&xclk_model->xut_nsec);
+        xut_mult  = XATOMIC_LOAD64(&xclk_model->xut_mult);
+        xit_slew  = (x_int64_t)XATOMIC_LOAD64(&xclk_model->xit_slew);
+        xut_span  = XATOMIC_LOAD64(&xclk_model->xut_span);
+
+        if (xut_seqn == XATOMIC_LOAD32(&xclk_model->xut_seqn))
+            break;
+    }
+
+    if (!xut_valid)
+    {
+        return 0;
+    }
+
+    return ntpclk_calc(xut_base, xut_nsec, xut_mult, xit_slew, xut_span, xut_tsc);
+}
+
+/**********************************************************/
+/**
+ * @brief 以 一次 NTP 结果 校准 进程内的 TSC 时钟。
+ * @note
+ * 调用时 成对采集 系统时间 与 TSC（参看 time_pair()），系统时间 加上 偏移量，即为 该 TSC 时刻 的 UTC：
+ * 首次校准，或 模型 与之相差 超过 XNTP_CLK_STEP 时，模型 直接跳变；
+ * 否则 以 当前时刻 的 模型值 为 新基点（读数 连续、单调），
+ * 在 距上次校准 的 时长（1 ~ 64 秒）内 平滑地 消除 误差；
+ * 频率 由 跨度 XNTP_CLK_BASE_MIN ~ XNTP_CLK_BASE_MAX 秒 的 两个样本 估计，NTP 的 频率变化 因而 会被 自动跟踪。
+ * 并发的 校准 只有一个 生效，其余 返回 EBUSY。
+ * ntpcli_clock() 开启后，客户端 每次 成功的 ntpcli_req_time() 都会 调用该接口。
+ *
+ * @param [in ] xit_offset : NTP 偏移量（UTC 减去 本地系统时间，以 100纳秒 为单位）。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；TSC 不可用（参看 time_tsc_freq()），返回 ENOTSUP；正在被 其他线程 校准，返回 EBUSY。
+ */
+x_int32_t ntpclk_update(x_int64_t xit_offset)
+{
+    xntp_clock_t    * xclk_this = &g_xntp_clock;
+    xntp_clkmodel_t * xclk_mptr = &g_xntp_clock.xclk_model;
+    x_uint64_t        xut_freq  = time_tsc_freq();
+    x_uint32_t        xut_seqn  = 0;
+    x_uint64_t        xut_tsc   = 0;
+    x_uint64_t        xut_utc   = 0;
+    x_uint64_t        xut_pred  = 0;
+    x_uint64_t        xut_base  = 0;
+    x_uint64_t        xut_span  = 0;
+    x_int64_t         xit_phase = 0;
+    xtime_pair_t      xtm_pair;
+
+    if (0 == xut_freq)
+    {
+        return ENOTSUP;
+    }
+
+    xut_seqn = XATOMIC_LOAD32(&xclk_mptr->xut_seqn);
+    if ((xut_seqn & 1) || !XATOMIC_CAS32(&xclk_mptr->xut_seqn, xut_seqn, xut_seqn + 1))
+    {
+        return EBUSY;
+    }
+
+    //======================================
+    // 该 TSC 时刻 的 UTC
+
+    xtm_pair = time_pair();
+    xut_tsc  = xtm_pair.xut_tsc;
+    xut_utc  = (x_uint64_t)((x_int64_t)xtm_pair.xtm_real + xit_offset) * 100ULL;
+
+    if (0 == xut_tsc)
+    {
+        XATOMIC_STORE32(&xclk_mptr->xut_seqn, xut_seqn + 2);
+        return ENOTSUP;
+    }
+
+    if (xclk_mptr->xut_valid)
+    {
+        xut_pred  = ntpclk_calc(xclk_mptr->xut_tsc, xclk_mptr->xut_nsec, xclk_mptr->xut_mult,
+                                xclk_mptr->xit_slew, xclk_mptr->xut_span, xut_tsc);
+        xit_phase = (x_int64_t)(xut_utc - xut_pred);
+    }
+
+    //======================================
+
+    if (!xclk_mptr->xut_valid || (xit_phase > XNTP_CLK_STEP) || (xit_phase < -XNTP_CLK_STEP))
+    {
+        // 跳变：以 该样本 为 基点 与 频率基线 的 起点；已有的 频率估计 仍然有效，否则 取 标称频率
+        XATOMIC_STORE64(&xclk_mptr->xut_tsc , xut_tsc);
+        XATOMIC_STORE64(&xclk_mptr->xut_nsec, xut_utc);
+        if (!xclk_this->xbt_based)
+        {
+            XATOMIC_STORE64(&xclk_mptr->xut_mult, ntpclk_rate(xclk_this, xut_freq));
+        }
+        XATOMIC_STORE64(&xclk_mptr->xit_slew, 0);
+        XATOMIC_STORE64(&xclk_mptr->xut_span, 0);
+
+        xclk_this->xut_ref_tsc   = xut_tsc;
+        xclk_this->xut_ref_nsec  = xut_utc;
+        xclk_this->xstat.xut_steps += 1;
+    }
+    else
+    {
+        // 频率：基线 足够长 时，以 两个样本 的 UTC 之差 与 TSC 之差 估计；
+        // 此前 跟随 标称频率 与 预设偏差（进程启动 之初，TSC 的 自动校准 仍在 逐步提高 其精度）
+        xut_base = xut_tsc - xclk_this->xut_ref_tsc;
+        if (xut_base >= (x_uint64_t)XNTP_CLK_BASE_MIN * xut_freq)
+        {
+            XATOMIC_STORE64(&xclk_mptr->xut_mult,
+                            (x_uint64_t)((double)(xut_utc - xclk_this->xut_ref_nsec) * XNTP_CLK_FIXED / (double)xut_base));
+            xclk_this->xbt_based = X_TRUE;
+        }
+        else if (!xclk_this->xbt_based)
+        {
+            XATOMIC_STORE64(&xclk_mptr->xut_mult, ntpclk_rate(xclk_this, xut_freq));
+        }
+
+        if (xut_base >= (x_uint64_t)XNTP_CLK_BASE_MAX * xut_freq)
+        {
+            xclk_this->xut_ref_tsc  = xut_tsc;
+            xclk_this->xut_ref_nsec = xut_utc;
+        }
+
+        // 相位：以 模型值 为 新基点，在 距上次校准 的 时长 内 消除 误差
+        xut_span = xut_tsc - xclk_this->xut_last_tsc;
+        xut_span = (xut_span < XNTP_CLK_SLEW_MIN * xut_freq) ? (XNTP_CLK_SLEW_MIN * xut_freq) : xut_span;
+        xut_span = (xut_span > XNTP_CLK_SLEW_MAX * xut_freq) ? (XNTP_CLK_SLEW_MAX * xut_freq) : xut_span;
+
+        XATOMIC_STORE64(&xclk_mptr->xut_tsc , xut_tsc);
+        XATOMIC_STORE64(&xclk_mptr->xut_nsec, xut_pred);
+        XATOMIC_STORE64(&xclk_mptr->xit_slew, (x_uint64_t)((xit_phase * 4294967296LL) / (x_int64_t)xut_span));
+        XATOMIC_STORE64(&xclk_mptr->xut_span, xut_span);
+    }
+
+    xclk_this->xut_last_tsc     = xut_tsc;
+    xclk_this->xstat.xbt_valid  = X_TRUE;
+    xclk_this->xstat.xut_updates += 1;
+    xclk_this->xstat.xit_phase  = xit_phase;
+    xclk_this->xstat.xbt_freq   = xclk_this->xbt_based || xclk_this->xbt_hint;
+    xclk_this->xstat.xit_freq   = (x_int64_t)(((double)xclk_mptr->xut_mult / (double)ntpclk_nominal(xut_freq) - 1.0) * 1.0e9);
+    xclk_this->xstat.xtm_update = time_mono();
+
+    XATOMIC_STORE32(&xclk_mptr->xut_valid, 1);
+    XATOMIC_STORE32(&xclk_mptr->xut_seqn, xut_seqn + 2);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 预设 频率偏差（通常 取自 上次运行 保存的 状态，参看 ntpcli_state()）。
+ * @note
+ * 在 基线 达到 XNTP_CLK_BASE_MIN 秒 之前，以 预设值 代替 TSC 的 标称频率，
+ * 重启后的 首次校准 即可 使用 上次运行 估计的 频率，而 无须 再等待 基线。
+ *
+ * @param [in ] xit_freq : 频率偏差（ppb，参看 xntp_clkstat_t 的 xit_freq）。
+ *
+ * @return x_int32_t : 成功，返回 0；超出 ±XNTP_CLK_FREQ_MAX，返回 ERANGE。
+ */
+x_int32_t ntpclk_warm(x_int64_t xit_freq)
+{
+    xntp_clkmodel_t * xclk_mptr = &g_xntp_clock.xclk_model;
+    x_uint32_t        xut_seqn  = 0;
+
+    if ((xit_freq > XNTP_CLK_FREQ_MAX) || (xit_freq < -XNTP_CLK_FREQ_MAX))
+    {
+        return ERANGE;
+    }
+
+    for (;;)
+    {
+        xut_seqn = XATOMIC_LOAD32(&xclk_mptr->xut_seqn);
+        if (!(xut_seqn & 1) && XATOMIC_CAS32(&xclk_mptr->xut_seqn, xut_seqn, xut_seqn + 1))
+            break;
+        XATOMIC_PAUSE();
+    }
+
+    // 只影响 此后的 校准；已有的 模型 保持不变，读数 因而 连续
+    g_xntp_clock.xbt_hint = X_TRUE;
+    g_xntp_clock.xit_hint = xit_freq;
+
+    XATOMIC_STORE32(&xclk_mptr->xut_seqn, xut_seqn + 2);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 清除 TSC 时钟 的 校准状态 与 预设的 频率偏差（此后 ntpclk_now() 返回 无效值，直至 再次校准）。
+ */
+x_void_t ntpclk_reset(void)
+{
+    xntp_clkmodel_t * xclk_mptr = &g_xntp_clock.xclk_model;
+    x_uint32_t        xut_seqn  = 0;
+
+    for (;;)
+    {
+        xut_seqn = XATOMIC_LOAD32(&xclk_mptr->xut_seqn);
+        if (!(xut_seqn & 1) && XATOMIC_CAS32(&xclk_mptr->xut_seqn, xut_seqn, xut_seqn + 1))
+            break;
+        XATOMIC_PAUSE();
+    }
+
+    XATOMIC_STORE32(&xclk_mptr->xut_valid, 0);
+    memset(&g_xntp_clock.xstat, 0, sizeof(xntp_clkstat_t));
+    g_xntp_clock.xut_last_tsc = 0;
+    g_xntp_clock.xbt_based    = X_FALSE;
+    g_xntp_clock.xbt_hint     = X_FALSE;
+    g_xntp_clock.xit_hint     = 0;
+
+    XATOMIC_STORE32(&xclk_mptr->xut_seqn, xut_seqn + 2);
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 TSC 时钟 的 UTC（以 100纳秒 为单位）；尚未校准 时，返回 XTIME_INVALID_VNSEC。
+ */
+xtime_vnsec_t ntpclk_now(void)
+{
+    x_uint64_t xut_nsec = ntpclk_model_ns(&g_xntp_clock.xclk_model, time_tsc());
+
+    return (0 != xut_nsec) ? (xtime_vnsec_t)(xut_nsec / 100ULL) : XTIME_INVALID_VNSEC;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 TSC 时钟 的 UTC（自 1970 年起的 纳秒数）；尚未校准 时，返回 0。
+ */
+x_uint64_t ntpclk_now_ns(void)
+{
+    return ntpclk_model_ns(&g_xntp_clock.xclk_model, time_tsc());
+}
+
+/**********************************************************/
+/**
+ * @brief 获取 TSC 时钟 的 校准状态。
+ */
+x_void_t ntpclk_stat(xntp_clkstat_t * xstat_ptr)
+{
+    xntp_clkmodel_t * xclk_mptr = &g_xntp_clock.xclk_model;
+    x_uint32_t        xut_seqn  = 0;
+
+    if (X_NULL == xstat_ptr)
+    {
+        return;
+    }
+
+    do
+    {
+        while ((xut_seqn = XATOMIC_LOAD32(&xclk_mptr->xut_seqn)) & 1)
+            XATOMIC_PAUSE();
+
+        memcpy(xstat_ptr, &g_xntp_clock.xstat, sizeof(xntp_clkstat_t));
+        XATOMIC_FENCE();
+    } while (xut_seqn != XATOMIC_LOAD32(&xclk_mptr->xut_seqn));
+}
+
+/**********************************************************/
+/**
+ * @brief 拷贝 进程内 TSC 时钟 的 模型（序列锁 保证 拷贝的一致性），可用于 向 其他进程 发布。
+ */
+x_void_t ntpclk_model(xntp_clkmodel_t * xclk_model)
+{
+    xntp_clkmodel_t * xclk_mptr = &g_xntp_clock.xclk_model;
+    x_uint32_t        xut_seqn  = 0;
+
+    if (X_NULL == xclk_model)
+    {
+        return;
+    }
+
+    do
+    {
+        while ((xut_seqn = XATOMIC_LOAD32(&xclk_mptr->xut_seqn)) & 1)
+            XATOMIC_PAUSE();
+
+        xclk_model->xut_seqn  = 0;
+        xclk_model->xut_valid = XATOMIC_LOAD32(&xclk_mptr->xut_valid);
+        xclk_model->xut_tsc   = XATOMIC_LOAD64(&xclk_mptr->xut_tsc );
+        xclk_model->xut_nsec  = XATOMIC_LOAD64(&xclk_mptr->xut_nsec);
+        xclk_model->xut_mult  = XATOMIC_LOAD64(&xclk_mptr->xut_mult);
+        xclk_model->xit_slew  = (x_int64_t)XATOMIC_LOAD64(&xclk_mptr->xit_slew);
+        xclk_model->xut_span  = XATOMIC_LOAD64(&xclk_mptr->xut_span);
+    } while (xut_seqn != XATOMIC_LOAD32(&xclk_mptr->xut_seqn));
+}
+
+////////////////////////////////////////////////////////////////////////////////
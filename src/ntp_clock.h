@@ -0,0 +1,178 @@
+﻿/**
+ * @file ntp_clock.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 以 NTP 结果 校准的 TSC 时钟（进程内 唯一的 TSC → UTC 线性模型，读取 无系统调用）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_CLOCK_H__
+#define __NTP_CLOCK_H__
+
+#include "xtime.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 偏移量 的 跳变门限（纳秒）：模型 与 NTP 结果 相差 超过该值 时，直接跳变，否则 平滑调整 */
+#define XNTP_CLK_STEP       128000000LL
+
+/** 估计 频率 所需的 最短基线（秒）：此前 沿用 TSC 的 标称频率（参看 time_tsc_freq()） */
+#define XNTP_CLK_BASE_MIN   8
+
+/** 估计 频率 的 最长基线（秒）：超过后 以 当前样本 为 新的起点，以跟踪 频率 的 缓慢变化 */
+#define XNTP_CLK_BASE_MAX   4096
+
+/** 频率偏差 的 合理上限（ppb）：超出的 预设频率（参看 ntpclk_warm()）被拒绝 */
+#define XNTP_CLK_FREQ_MAX   500000LL
+
+/**
+ * @struct xntp_clkmodel_t
+ * @brief  TSC → UTC 的 线性模型（纳秒）：
+ *         utc = xut_nsec + (tsc - xut_tsc) * xut_mult / 2^32 + min(max(tsc - xut_tsc, 0), xut_span) * xit_slew / 2^32。
+ * @note
+ * 第二项 为 频率，第三项 在 xut_span 个周期内 平滑地 消除 上次校准时的 相位误差（之后 保持不变）。
+ * 换算所用的 字段 由 序列锁 保护：xut_seqn 为奇数 时，正在更新。
+ * 结构体 只含 定长的 整数字段，可直接 放置于 共享内存 中 供 其他进程 读取。
+ */
+typedef struct xntp_clkmodel_t
+{
+    x_uint32_t xut_seqn;    ///< 序列号
+    x_uint32_t xut_valid;   ///< 是否 已校准
+    x_uint64_t xut_tsc;     ///< 基点 的 TSC 读数
+    x_uint64_t xut_nsec;    ///< 基点 的 UTC（自 1970 年起的 纳秒数）
+    x_uint64_t xut_mult;    ///< 每个 TSC 周期 的 纳秒数（32.32 定点数）
+    x_int64_t  xit_slew;    ///< 相位调整 的 速率（每个 TSC 周期 的 纳秒数，32.32 定点数，有符号）
+    x_uint64_t xut_span;    ///< 相位调整 持续的 TSC 周期数
+} xntp_clkmodel_t;
+
+/**
+ * @struct xntp_clkstat_t
+ * @brief  TSC 时钟 的 校准状态。
+ */
+typedef struct xntp_clkstat_t
+{
+    x_bool_t      xbt_valid;    ///< 是否 已校准
+    x_uint32_t    xut_updates;  ///< 校准次数
+    x_uint32_t    xut_steps;    ///< 其中 跳变的 次数（含 首次校准）
+    x_int64_t     xit_phase;    ///< 最近一次 校准时，模型 相对于 NTP 结果 的 误差（纳秒，正值 表示 模型 偏慢）
+    x_bool_t      xbt_freq;     ///< xit_freq 是否 来自 频率估计（基线 足够长，或 ntpclk_warm() 预设）
+    x_int64_t     xit_freq;     ///< 估计的 UTC 频率 相对于 TSC 标称频率 的 偏差（十亿分之一，ppb）
+    xtime_vnsec_t xtm_update;   ///< 最近一次 校准 的 时刻（time_mono() 单调时钟）
+} xntp_clkstat_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 按 模型 换算 TSC 读数（序列锁 的 读取方）。
+ * @note
+ * 只读取 模型 与 执行 乘法，不经 系统调用；模型 未校准 时，返回 0。
+ *
+ * @param [in ] xclk_model : TSC → UTC 模型（可位于 共享内存）。
+ * @param [in ] xut_tsc    : TSC 读数（参看 time_tsc()）。
+ *
+ * @return x_uint64_t : 返回 UTC（自 1970 年起的 纳秒数）。
+ */
+x_uint64_t ntpclk_model_ns(const xntp_clkmodel_t * xclk_model, x_uint64_t xut_tsc);
+
+/**********************************************************/
+/**
+ * @brief 以 一次 NTP 结果 校准 进程内的 TSC 时钟。
+ * @note
+ * 调用时 成对采集 系统时间 与 TSC（参看 time_pair()），系统时间 加上 偏移量，即为 该 TSC 时刻 的 UTC：
+ * 首次校准，或 模型 与之相差 超过 XNTP_CLK_STEP 时，模型 直接跳变；
+ * 否则 以 当前时刻 的 模型值 为 新基点（读数 连续、单调），
+ * 在 距上次校准 的 时长（1 ~ 64 秒）内 平滑地 消除 误差；
+ * 频率 由 跨度 XNTP_CLK_BASE_MIN ~ XNTP_CLK_BASE_MAX 秒 的 两个样本 估计，NTP 的 频率变化 因而 会被 自动跟踪。
+ * 并发的 校准 只有一个 生效，其余 返回 EBUSY。
+ * ntpcli_clock() 开启后，客户端 每次 成功的 ntpcli_req_time() 都会 调用该接口。
+ *
+ * @param [in ] xit_offset : NTP 偏移量（UTC 减去 本地系统时间，以 100纳秒 为单位）。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；TSC 不可用（参看 time_tsc_freq()），返回 ENOTSUP；正在被 其他线程 校准，返回 EBUSY。
+ */
+x_int32_t ntpclk_update(x_int64_t xit_offset);
+
+/**********************************************************/
+/**
+ * @brief 预设 频率偏差（通常 取自 上次运行 保存的 状态，参看 ntpcli_state()）。
+ * @note
+ * 在 基线 达到 XNTP_CLK_BASE_MIN 秒 之前，以 预设值 代替 TSC 的 标称频率，
+ * 重启后的 首次校准 即可 使用 上次运行 估计的 频率，而 无须 再等待 基线。
+ *
+ * @param [in ] xit_freq : 频率偏差（ppb，参看 xntp_clkstat_t 的 xit_freq）。
+ *
+ * @return x_int32_t : 成功，返回 0；超出 ±XNTP_CLK_FREQ_MAX，返回 ERANGE。
+ */
+x_int32_t ntpclk_warm(x_int64_t xit_freq);
+
+/**********************************************************/
+/**
+ * @brief 清除 TSC 时钟 的 校准状态 与 预设的 频率偏差（此后 ntpclk_now() 返回 无效值，直至 再次校准）。
+ */
+x_void_t ntpclk_reset(void);
+
+/**********************************************************/
+/**
+ * @brief 读取 TSC 时钟 的 UTC（以 100纳秒 为单位）；尚未校准 时，返回 XTIME_INVALID_VNSEC。
+ */
+xtime_vnsec_t ntpclk_now(void);
+
+/**********************************************************/
+/**
+ * @brief 读取 TSC 时钟 的 UTC（自 1970 年起的 纳秒数）；尚未校准 时，返回 0。
+ */
+x_uint64_t ntpclk_now_ns(void);
+
+/**********************************************************/
+/**
+ * @brief 获取 TSC 时钟 的 校准状态。
+ */
+x_void_t ntpclk_stat(xntp_clkstat_t * xstat_ptr);
+
+/**********************************************************/
+/**
+ * @brief 拷贝 进程内 TSC 时钟 的 模型（序列锁 保证 拷贝的一致性），可用于 向 其他进程 发布。
+ */
+x_void_t ntpclk_model(xntp_clkmodel_t * xclk_model);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_CLOCK_H__
@@ -0,0 +1,362 @@
+﻿/**
+ * @file ntp_cmac.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : AES-128-CMAC（RFC 4493）与 AES-SIV-CMAC-256（RFC 5297）的 内部实现。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_CMAC_H__
+#define __NTP_CMAC_H__
+
+#include "xtypes.h"
+
+#include <string.h>
+
+#ifdef XNTP_OPENSSL
+
+#ifndef OPENSSL_SUPPRESS_DEPRECATED
+#define OPENSSL_SUPPRESS_DEPRECATED
+#endif // OPENSSL_SUPPRESS_DEPRECATED
+#include <openssl/aes.h>
+#include <openssl/crypto.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * 本文件只供库的内部实现使用：
+ * 轮密钥 与 子密钥 在设置密钥时 一次算好，计算时 只读访问，
+ * 因此 同一个 xntp_cmac_t 可被多个线程 并发使用，也可 按值复制。
+ */
+
+/** AES 分组 的 字节数 */
+#define XCMAC_BLOCK     16
+
+/**
+ * @struct xntp_cmac_t
+ * @brief  AES-128-CMAC 的 预计算密钥。
+ */
+typedef struct xntp_cmac_t
+{
+    AES_KEY   xaes_key;             ///< AES-128 的 轮密钥
+    x_uchar_t xbt_k1[XCMAC_BLOCK];  ///< 子密钥 K1
+    x_uchar_t xbt_k2[XCMAC_BLOCK];  ///< 子密钥 K2
+} xntp_cmac_t;
+
+/**********************************************************/
+/**
+ * @brief GF(2^128) 上的 倍乘（左移一位，最高位为 1 时 异或 0x87），
+ *        用于 推导 CMAC 子密钥 与 AES-SIV 的 S2V 计算。
+ */
+static inline x_void_t ntp_cmac_dbl(const x_uchar_t xbt_src[XCMAC_BLOCK], x_uchar_t xbt_dst[XCMAC_BLOCK])
+{
+    x_int32_t xit_iter = 0;
+    x_uchar_t xct_msb  = (x_uchar_t)(xbt_src[0] & 0x80);
+
+    for (xit_iter = 0; xit_iter < XCMAC_BLOCK - 1; ++xit_iter)
+    {
+        xbt_dst[xit_iter] = (x_uchar_t)((xbt_src[xit_iter] << 1) | (xbt_src[xit_iter + 1] >> 7));
+    }
+
+    xbt_dst[XCMAC_BLOCK - 1] = (x_uchar_t)(xbt_src[XCMAC_BLOCK - 1] << 1);
+    if (0 != xct_msb)
+    {
+        xbt_dst[XCMAC_BLOCK - 1] ^= 0x87;
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 设置 CMAC 的密钥（计算 轮密钥 与 子密钥 K1、K2）。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；失败，返回 X_FALSE。
+ */
+static inline x_bool_t ntp_cmac_init(xntp_cmac_t * xcmac_ptr, const x_uchar_t xbt_key[XCMAC_BLOCK])
+{
+    x_uchar_t xbt_lkey[XCMAC_BLOCK];
+
+    if (0 != AES_set_encrypt_key(xbt_key, 128, &xcmac_ptr->xaes_key))
+    {
+        return X_FALSE;
+    }
+
+    memset(xbt_lkey, 0, XCMAC_BLOCK);
+    AES_encrypt(xbt_lkey, xbt_lkey, &xcmac_ptr->xaes_key);
+    ntp_cmac_dbl(xbt_lkey, xcmac_ptr->xbt_k1);
+    ntp_cmac_dbl(xcmac_ptr->xbt_k1, xcmac_ptr->xbt_k2);
+    memset(xbt_lkey, 0, XCMAC_BLOCK);
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 计算 AES-128-CMAC（RFC 4493）。
+ */
+static inline x_void_t ntp_cmac_calc(
+                            const xntp_cmac_t * xcmac_ptr,
+                            const x_uchar_t * xbt_data,
+                            x_uint32_t xut_dlen,
+                            x_uchar_t xbt_mac[XCMAC_BLOCK])
+{
+    x_uint32_t        xut_iter = 0;
+    x_uint32_t        xut_left = xut_dlen;
+    const x_uchar_t * xbt_skey = X_NULL;
+    x_uchar_t         xbt_xblk[XCMAC_BLOCK];
+
+    memset(xbt_xblk, 0, XCMAC_BLOCK);
+
+    // 除最后一个分组外，依次 异或 并 加密
+    while (xut_left > XCMAC_BLOCK)
+    {
+        for (xut_iter = 0; xut_iter < XCMAC_BLOCK; ++xut_iter)
+            xbt_xblk[xut_iter] ^= xbt_data[xut_iter];
+        AES_encrypt(xbt_xblk, xbt_xblk, &xcmac_ptr->xaes_key);
+
+        xbt_data += XCMAC_BLOCK;
+        xut_left -= XCMAC_BLOCK;
+    }
+
+    // 最后一个分组：完整时 异或 K1，否则 填充 10...0 后 异或 K2
+    if (XCMAC_BLOCK == xut_left)
+    {
+        xbt_skey = xcmac_ptr->xbt_k1;
+        for (xut_iter = 0; xut_iter < XCMAC_BLOCK; ++xut_iter)
+            xbt_xblk[xut_iter] ^= xbt_data[xut_iter];
+    }
+    else
+    {
+        xbt_skey = xcmac_ptr->xbt_k2;
+        for (xut_iter = 0; xut_iter < xut_left; ++xut_iter)
+            xbt_xblk[xut_iter] ^= xbt_data[xut_iter];
+        xbt_xblk[xut_left] ^= 0x80;
+    }
+
+    for (xut_iter = 0; xut_iter < XCMAC_BLOCK; ++xut_iter)
+        xbt_xblk[xut_iter] ^= xbt_skey[xut_iter];
+    AES_encrypt(xbt_xblk, xbt_mac, &xcmac_ptr->xaes_key);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// AES-SIV-CMAC-256（RFC 5297，NTS 所使用的 AEAD 算法）
+// 
+
+/** AES-SIV 的 密钥字节数（前 16 字节用于 S2V，后 16 字节用于 CTR 加密） */
+#define XSIV_KEY_LEN    32
+
+/** AES-SIV 的 认证标签（合成 IV）字节数 */
+#define XSIV_TAG_LEN    16
+
+/** S2V 最多可输入的 关联数据 分量数 */
+#define XSIV_AD_MAX     4
+
+/**
+ * @struct xntp_siv_t
+ * @brief  AES-SIV-CMAC-256 的 预计算密钥。
+ */
+typedef struct xntp_siv_t
+{
+    xntp_cmac_t xcmac;      ///< S2V 所用的 CMAC 密钥
+    AES_KEY     xctr_key;   ///< CTR 加密 所用的 轮密钥
+} xntp_siv_t;
+
+/**
+ * @struct xntp_siv_ad_t
+ * @brief  S2V 的 一个 关联数据 分量（NTS 中 依次为 报文头部与扩展字段、nonce）。
+ */
+typedef struct xntp_siv_ad_t
+{
+    const x_uchar_t * xbt_data;
+    x_uint32_t        xut_size;
+} xntp_siv_ad_t;
+
+/**********************************************************/
+/**
+ * @brief 设置 AES-SIV 的密钥。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；失败，返回 X_FALSE。
+ */
+static inline x_bool_t ntp_siv_init(xntp_siv_t * xsiv_ptr, const x_uchar_t xbt_key[XSIV_KEY_LEN])
+{
+    if (!ntp_cmac_init(&xsiv_ptr->xcmac, xbt_key))
+        return X_FALSE;
+    return (0 == AES_set_encrypt_key(xbt_key + XCMAC_BLOCK, 128, &xsiv_ptr->xctr_key)) ? X_TRUE : X_FALSE;
+}
+
+/**********************************************************/
+/**
+ * @brief S2V：由 关联数据 各分量 与 明文 计算 合成 IV。
+ *
+ * @param [in ] xsiv_ptr : 密钥。
+ * @param [in ] xsiv_ad  : 关联数据 分量数组。
+ * @param [in ] xut_nads : 关联数据 分量数（不超过 XSIV_AD_MAX）。
+ * @param [in ] xbt_text : 明文。
+ * @param [in ] xut_tlen : 明文字节数（不超过 2048，内部 在栈上暂存）。
+ * @param [out] xbt_siv  : 返回 合成 IV。
+ */
+static inline x_void_t ntp_siv_s2v(
+                            const xntp_siv_t * xsiv_ptr,
+                            const xntp_siv_ad_t * xsiv_ad,
+                            x_uint32_t xut_nads,
+                            const x_uchar_t * xbt_text,
+                            x_uint32_t xut_tlen,
+                            x_uchar_t xbt_siv[XSIV_TAG_LEN])
+{
+    x_uint32_t xut_iter = 0;
+    x_uint32_t xut_ipos = 0;
+    x_uchar_t  xbt_dval[XCMAC_BLOCK];
+    x_uchar_t  xbt_cval[XCMAC_BLOCK];
+    x_uchar_t  xbt_last[2048];
+
+    // D = CMAC(K, <zero>)
+    memset(xbt_cval, 0, XCMAC_BLOCK);
+    ntp_cmac_calc(&xsiv_ptr->xcmac, xbt_cval, XCMAC_BLOCK, xbt_dval);
+
+    // D = dbl(D) xor CMAC(K, Si)
+    for (xut_iter = 0; xut_iter < xut_nads; ++xut_iter)
+    {
+        ntp_cmac_dbl(xbt_dval, xbt_dval);
+        ntp_cmac_calc(&xsiv_ptr->xcmac, xsiv_ad[xut_iter].xbt_data, xsiv_ad[xut_iter].xut_size, xbt_cval);
+        for (xut_ipos = 0; xut_ipos < XCMAC_BLOCK; ++xut_ipos)
+            xbt_dval[xut_ipos] ^= xbt_cval[xut_ipos];
+    }
+
+    if ((xut_tlen >= XCMAC_BLOCK) && (xut_tlen <= sizeof(xbt_last)))
+    {
+        // T = Sn xorend D
+        memcpy(xbt_last, xbt_text, xut_tlen);
+        for (xut_ipos = 0; xut_ipos < XCMAC_BLOCK; ++xut_ipos)
+            xbt_last[xut_tlen - XCMAC_BLOCK + xut_ipos] ^= xbt_dval[xut_ipos];
+        ntp_cmac_calc(&xsiv_ptr->xcmac, xbt_last, xut_tlen, xbt_siv);
+        memset(xbt_last, 0, xut_tlen);
+    }
+    else
+    {
+        // T = dbl(D) xor pad(Sn)
+        ntp_cmac_dbl(xbt_dval, xbt_dval);
+        for (xut_ipos = 0; (xut_ipos < xut_tlen) && (xut_ipos < XCMAC_BLOCK); ++xut_ipos)
+            xbt_dval[xut_ipos] ^= xbt_text[xut_ipos];
+        xbt_dval[xut_ipos] ^= 0x80;
+        ntp_cmac_calc(&xsiv_ptr->xcmac, xbt_dval, XCMAC_BLOCK, xbt_siv);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 以 合成 IV（清除 第 63、31 位）为 初始计数器，做 AES-CTR 加密/解密。
+ */
+static inline x_void_t ntp_siv_ctr(
+                            const xntp_siv_t * xsiv_ptr,
+                            const x_uchar_t xbt_siv[XSIV_TAG_LEN],
+                            const x_uchar_t * xbt_src,
+                            x_uchar_t * xbt_dst,
+                            x_uint32_t xut_size)
+{
+    x_uint32_t xut_iter = 0;
+    x_int32_t  xit_ipos = 0;
+    x_uchar_t  xbt_ctr[XCMAC_BLOCK];
+    x_uchar_t  xbt_key[XCMAC_BLOCK];
+
+    memcpy(xbt_ctr, xbt_siv, XCMAC_BLOCK);
+    xbt_ctr[ 8] &= 0x7F;
+    xbt_ctr[12] &= 0x7F;
+
+    for (xut_iter = 0; xut_iter < xut_size; ++xut_iter)
+    {
+        if (0 == (xut_iter % XCMAC_BLOCK))
+        {
+            AES_encrypt(xbt_ctr, xbt_key, &xsiv_ptr->xctr_key);
+            for (xit_ipos = XCMAC_BLOCK - 1; xit_ipos >= 0; --xit_ipos)
+            {
+                if (0 != ++xbt_ctr[xit_ipos])
+                    break;
+            }
+        }
+
+        xbt_dst[xut_iter] = xbt_src[xut_iter] ^ xbt_key[xut_iter % XCMAC_BLOCK];
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief AES-SIV 加密：输出 合成 IV（XSIV_TAG_LEN 字节）+ 密文（与明文 等长）。
+ * @note  xbt_text 与 xbt_dst 不可重叠。
+ */
+static inline x_void_t ntp_siv_seal(
+                            const xntp_siv_t * xsiv_ptr,
+                            const xntp_siv_ad_t * xsiv_ad,
+                            x_uint32_t xut_nads,
+                            const x_uchar_t * xbt_text,
+                            x_uint32_t xut_tlen,
+                            x_uchar_t * xbt_dst)
+{
+    ntp_siv_s2v(xsiv_ptr, xsiv_ad, xut_nads, xbt_text, xut_tlen, xbt_dst);
+    ntp_siv_ctr(xsiv_ptr, xbt_dst, xbt_text, xbt_dst + XSIV_TAG_LEN, xut_tlen);
+}
+
+/**********************************************************/
+/**
+ * @brief AES-SIV 解密 并 校验（以常量时间比较 合成 IV）。
+ *
+ * @param [in ] xbt_data : 合成 IV + 密文。
+ * @param [in ] xut_dlen : 合成 IV + 密文 的 字节数（不小于 XSIV_TAG_LEN）。
+ * @param [out] xbt_text : 返回 明文（xut_dlen - XSIV_TAG_LEN 字节）。
+ *
+ * @return x_bool_t : 校验通过，返回 X_TRUE；否则返回 X_FALSE（明文缓存 被清零）。
+ */
+static inline x_bool_t ntp_siv_open(
+                            const xntp_siv_t * xsiv_ptr,
+                            const xntp_siv_ad_t * xsiv_ad,
+                            x_uint32_t xut_nads,
+                            const x_uchar_t * xbt_data,
+                            x_uint32_t xut_dlen,
+                            x_uchar_t * xbt_text)
+{
+    x_uchar_t xbt_siv[XSIV_TAG_LEN];
+
+    if (xut_dlen < XSIV_TAG_LEN)
+        return X_FALSE;
+
+    ntp_siv_ctr(xsiv_ptr, xbt_data, xbt_data + XSIV_TAG_LEN, xbt_text, xut_dlen - XSIV_TAG_LEN);
+    ntp_siv_s2v(xsiv_ptr, xsiv_ad, xut_nads, xbt_text, xut_dlen - XSIV_TAG_LEN, xbt_siv);
+
+    if (0 != CRYPTO_memcmp(xbt_siv, xbt_data, XSIV_TAG_LEN))
+    {
+        memset(xbt_text, 0, xut_dlen - XSIV_TAG_LEN);
+        return X_FALSE;
+    }
+
+    return X_TRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // XNTP_OPENSSL
+
+#endif // __NTP_CMAC_H__
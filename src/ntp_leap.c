@@ -0,0 +1,457 @@
+﻿/**
+ * @file ntp_leap.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 闰秒表（leap-seconds.list）、闰秒计划 与 24 小时线性平滑（leap smear）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_leap.h"
+#include "ntp_packet.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <ctype.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 内部相关的数据类型与常量
+//
+
+/**
+ * @struct xntp_leapent_t
+ * @brief  闰秒表 的 表项。
+ */
+typedef struct xntp_leapent_t
+{
+    x_int64_t xit_when;         ///< 生效时刻（UNIX 秒数）
+    x_int32_t xit_tai;          ///< 生效后的 TAI - UTC（秒）
+} xntp_leapent_t;
+
+/**
+ * @struct xntp_leaptab_t
+ * @brief  闰秒表（按 生效时刻 升序排列）。
+ */
+typedef struct xntp_leaptab_t
+{
+    xntp_leapent_t * xent_list;     ///< 表项数组
+    x_uint32_t       xut_count;     ///< 表项数量
+    x_uint32_t       xut_capacity;  ///< 表项数组 的 容量
+    xtime_vnsec_t    xtm_expire;    ///< 过期时刻（XTIME_INVALID_VNSEC 表示 永不过期）
+} xntp_leaptab_t;
+
+/** 一天的 秒数 */
+#define XLEAP_DAY_SEC   86400LL
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 公历日期（UTC）转换为 自 1970-01-01 起的 天数。
+ */
+static x_int64_t ntpleap_days_from_civil(x_int64_t xit_year, x_uint32_t xut_month, x_uint32_t xut_day)
+{
+    x_int64_t xit_era = 0;
+    x_int64_t xit_yoe = 0;
+    x_int64_t xit_doy = 0;
+    x_int64_t xit_doe = 0;
+
+    // 以 3 月 为 一年之始，闰日 落在 年末
+    xit_year -= (xut_month <= 2) ? 1 : 0;
+    xit_era   = ((xit_year >= 0) ? xit_year : (xit_year - 399)) / 400;
+    xit_yoe   = xit_year - xit_era * 400;
+    xit_doy   = (153 * ((x_int64_t)xut_month + ((xut_month > 2) ? -3 : 9)) + 2) / 5 + xut_day - 1;
+    xit_doe   = xit_yoe * 365 + xit_yoe / 4 - xit_yoe / 100 + xit_doy;
+
+    return xit_era * 146097 + xit_doe - 719468;
+}
+
+/**********************************************************/
+/**
+ * @brief 自 1970-01-01 起的 天数 转换为 公历的 年、月（UTC）。
+ */
+static x_void_t ntpleap_civil_from_days(x_int64_t xit_days, x_int64_t * xit_year, x_uint32_t * xut_month)
+{
+    x_int64_t xit_era = 0;
+    x_int64_t xit_doe = 0;
+    x_int64_t xit_yoe = 0;
+    x_int64_t xit_doy = 0;
+    x_int64_t xit_mp  = 0;
+
+    xit_days += 719468;
+    xit_era   = ((xit_days >= 0) ? xit_days : (xit_days - 146096)) / 146097;
+    xit_doe   = xit_days - xit_era * 146097;
+    xit_yoe   = (xit_doe - xit_doe / 1460 + xit_doe / 36524 - xit_doe / 146096) / 365;
+    xit_doy   = xit_doe - (365 * xit_yoe + xit_yoe / 4 - xit_yoe / 100);
+    xit_mp    = (5 * xit_doy + 2) / 153;
+
+    *xut_month = (x_uint32_t)((xit_mp < 10) ? (xit_mp + 3) : (xit_mp - 9));
+    *xit_year  = xit_yoe + xit_era * 400 + ((*xut_month <= 2) ? 1 : 0);
+}
+
+/**********************************************************/
+/**
+ * @brief 求取 xit_tsec（UNIX 秒数）所在月份 之后的 下个月 1 日 00:00:00 UTC（UNIX 秒数）。
+ */
+static x_int64_t ntpleap_month_next(x_int64_t xit_tsec)
+{
+    x_int64_t  xit_year  = 0;
+    x_uint32_t xut_month = 0;
+    x_int64_t  xit_days  = xit_tsec / XLEAP_DAY_SEC;
+
+    if ((xit_tsec < 0) && (0 != (xit_tsec % XLEAP_DAY_SEC)))
+        xit_days -= 1;
+
+    ntpleap_civil_from_days(xit_days, &xit_year, &xut_month);
+    if (12 == xut_month)
+    {
+        xit_year += 1;
+        xut_month = 1;
+    }
+    else
+    {
+        xut_month += 1;
+    }
+
+    return ntpleap_days_from_civil(xit_year, xut_month, 1) * XLEAP_DAY_SEC;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 创建 闰秒表。
+ *
+ * @return xntp_leapptr_t : 成功，返回 闰秒表；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_leapptr_t ntpleap_create(void)
+{
+    xntp_leapptr_t xleap_tab = (xntp_leapptr_t)calloc(1, sizeof(xntp_leaptab_t));
+    if (X_NULL == xleap_tab)
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    xleap_tab->xtm_expire = XTIME_INVALID_VNSEC;
+
+    return xleap_tab;
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁 闰秒表。
+ */
+x_void_t ntpleap_destroy(xntp_leapptr_t xleap_tab)
+{
+    if (X_NULL == xleap_tab)
+    {
+        return;
+    }
+
+    if (X_NULL != xleap_tab->xent_list)
+    {
+        free(xleap_tab->xent_list);
+        xleap_tab->xent_list = X_NULL;
+    }
+
+    free(xleap_tab);
+}
+
+/**********************************************************/
+/**
+ * @brief 向 闰秒表 添加（或替换）一项：自 xtm_when 起，TAI - UTC 为 xit_tai 秒。
+ *
+ * @param [in ] xleap_tab : 闰秒表。
+ * @param [in ] xtm_when  : 生效时刻（须为 整秒；通常为 1 月 或 7 月 1 日 00:00:00 UTC）。
+ * @param [in ] xit_tai   : 生效后的 TAI - UTC（秒）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpleap_add(xntp_leapptr_t xleap_tab, xtime_vnsec_t xtm_when, x_int32_t xit_tai)
+{
+    x_uint32_t       xut_iter  = 0;
+    x_int64_t        xit_when  = 0;
+    xntp_leapent_t * xent_list = X_NULL;
+
+    if ((X_NULL == xleap_tab) ||
+        !XTMVNSEC_IS_VALID(xtm_when) ||
+        (0 != (xtm_when % XTIME_100NS_BASE)))
+    {
+        return EINVAL;
+    }
+
+    xit_when = (x_int64_t)(xtm_when / XTIME_100NS_BASE);
+
+    //======================================
+    // 按 生效时刻 查找 插入位置（相同时刻 则替换）
+
+    for (xut_iter = 0; xut_iter < xleap_tab->xut_count; ++xut_iter)
+    {
+        if (xleap_tab->xent_list[xut_iter].xit_when >= xit_when)
+            break;
+    }
+
+    if ((xut_iter < xleap_tab->xut_count) && (xleap_tab->xent_list[xut_iter].xit_when == xit_when))
+    {
+        xleap_tab->xent_list[xut_iter].xit_tai = xit_tai;
+        return 0;
+    }
+
+    //======================================
+
+    if (xleap_tab->xut_count >= xleap_tab->xut_capacity)
+    {
+        xent_list = (xntp_leapent_t *)realloc(
+                            xleap_tab->xent_list,
+                            (xleap_tab->xut_capacity + 32) * sizeof(xntp_leapent_t));
+        if (X_NULL == xent_list)
+        {
+            return ENOMEM;
+        }
+
+        xleap_tab->xent_list     = xent_list;
+        xleap_tab->xut_capacity += 32;
+    }
+
+    memmove(&xleap_tab->xent_list[xut_iter + 1],
+            &xleap_tab->xent_list[xut_iter],
+            (xleap_tab->xut_count - xut_iter) * sizeof(xntp_leapent_t));
+    xleap_tab->xent_list[xut_iter].xit_when = xit_when;
+    xleap_tab->xent_list[xut_iter].xit_tai  = xit_tai;
+    xleap_tab->xut_count += 1;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 从 IERS/NIST 发布的 leap-seconds.list 文件 加载 闰秒表。
+ *
+ * @param [in ] xleap_tab : 闰秒表。
+ * @param [in ] xszt_path : 文件路径。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码（格式错误为 EINVAL）。
+ */
+x_int32_t ntpleap_load(xntp_leapptr_t xleap_tab, x_cstring_t xszt_path)
+{
+    x_int32_t   xit_errno = 0;
+    FILE      * xfile_ptr = X_NULL;
+    x_char_t  * xszt_iter = X_NULL;
+    x_char_t  * xszt_next = X_NULL;
+    x_uint64_t  xut_ntpsec = 0;
+    x_int64_t   xit_tai   = 0;
+    x_char_t    xszt_line[TEXT_LEN_256];
+
+    if ((X_NULL == xleap_tab) || (X_NULL == xszt_path))
+    {
+        return EINVAL;
+    }
+
+#ifdef _MSC_VER
+    if (0 != fopen_s(&xfile_ptr, xszt_path, "r"))
+        xfile_ptr = X_NULL;
+#else // !_MSC_VER
+    xfile_ptr = fopen(xszt_path, "r");
+#endif // _MSC_VER
+    if (X_NULL == xfile_ptr)
+    {
+        return errno;
+    }
+
+    while ((0 == xit_errno) && (X_NULL != fgets(xszt_line, TEXT_LEN_256, xfile_ptr)))
+    {
+        //======================================
+        // “#@” 行 为 过期时刻，其他 '#' 之后 为注释
+
+        if (('#' == xszt_line[0]) && ('@' == xszt_line[1]))
+        {
+            xut_ntpsec = (x_uint64_t)strtoull(xszt_line + 2, &xszt_next, 10);
+            if ((xszt_next == xszt_line + 2) || (xut_ntpsec <= XTIME_SEC_1900_1970))
+            {
+                xit_errno = EINVAL;
+                break;
+            }
+
+            xleap_tab->xtm_expire = (xut_ntpsec - XTIME_SEC_1900_1970) * XTIME_100NS_BASE;
+            continue;
+        }
+
+        for (xszt_iter = xszt_line; '\0' != *xszt_iter; ++xszt_iter)
+        {
+            if (('#' == *xszt_iter) || ('\r' == *xszt_iter) || ('\n' == *xszt_iter))
+            {
+                *xszt_iter = '\0';
+                break;
+            }
+        }
+
+        xszt_iter = xszt_line;
+        while (isspace((x_uchar_t)*xszt_iter))
+            ++xszt_iter;
+        if ('\0' == *xszt_iter)
+            continue;
+
+        //======================================
+        // 数据行：NTP 秒数 与 TAI-UTC
+
+        xut_ntpsec = (x_uint64_t)strtoull(xszt_iter, &xszt_next, 10);
+        if ((xszt_next == xszt_iter) || (xut_ntpsec <= XTIME_SEC_1900_1970))
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        xszt_iter = xszt_next;
+        xit_tai   = (x_int64_t)strtoll(xszt_iter, &xszt_next, 10);
+        if ((xszt_next == xszt_iter) || (xit_tai < -1000) || (xit_tai > 1000))
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        xit_errno = ntpleap_add(xleap_tab,
+                                (xut_ntpsec - XTIME_SEC_1900_1970) * XTIME_100NS_BASE,
+                                (x_int32_t)xit_tai);
+    }
+
+    fclose(xfile_ptr);
+
+    if ((0 == xit_errno) && (0 == xleap_tab->xut_count))
+    {
+        xit_errno = EINVAL;
+    }
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 闰秒表 的 过期时刻（未指定时，返回 XTIME_INVALID_VNSEC，即 永不过期）。
+ */
+xtime_vnsec_t ntpleap_expire(xntp_leapptr_t xleap_tab)
+{
+    return (X_NULL != xleap_tab) ? xleap_tab->xtm_expire : XTIME_INVALID_VNSEC;
+}
+
+/**********************************************************/
+/**
+ * @brief 查询 xtm_vnsec 时刻的 TAI - UTC（秒）；早于 闰秒表 首项 时，返回 0。
+ */
+x_int32_t ntpleap_tai(xntp_leapptr_t xleap_tab, xtime_vnsec_t xtm_vnsec)
+{
+    x_uint32_t xut_iter = 0;
+    x_int64_t  xit_tsec = (x_int64_t)(xtm_vnsec / XTIME_100NS_BASE);
+
+    if (X_NULL == xleap_tab)
+    {
+        return 0;
+    }
+
+    for (xut_iter = xleap_tab->xut_count; xut_iter > 0; --xut_iter)
+    {
+        if (xleap_tab->xent_list[xut_iter - 1].xit_when <= xit_tsec)
+            return xleap_tab->xent_list[xut_iter - 1].xit_tai;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 计算 xtm_vnsec 时刻 所适用的 闰秒计划。
+ *
+ * @param [in ] xleap_tab : 闰秒表（可为 X_NULL）。
+ * @param [in ] xleap_old : 当前的 闰秒计划（取 0 表示 没有）。
+ * @param [in ] xtm_vnsec : 当前时间（UTC）。
+ * @param [in ] xut_leap  : 服务端应答的 LI（0 ~ 3，3 表示 服务端未同步，按 0 处理）。
+ *
+ * @return xntp_leapplan_t : 返回 新的 闰秒计划。
+ */
+xntp_leapplan_t ntpleap_plan(
+                    xntp_leapptr_t xleap_tab,
+                    xntp_leapplan_t xleap_old,
+                    xtime_vnsec_t xtm_vnsec,
+                    x_uint32_t xut_leap)
+{
+    x_uint32_t xut_iter = 0;
+    x_int64_t  xit_tsec = (x_int64_t)(xtm_vnsec / XTIME_100NS_BASE);
+    x_int32_t  xit_diff = 0;
+
+    xut_leap = (3 == xut_leap) ? 0 : (xut_leap & 3);
+
+    //======================================
+    // 平滑窗口 已开始 的 闰秒计划，在窗口结束前 保持不变
+
+    if ((0 != XNTP_LEAPPLAN_LI(xleap_old)) &&
+        (xtm_vnsec < XNTP_LEAPPLAN_UNTIL(xleap_old)) &&
+        (xit_tsec >= XNTP_LEAPPLAN_SEC(xleap_old) - XNTP_LEAP_SMEAR / 2))
+    {
+        return xleap_old;
+    }
+
+    //======================================
+    // 有效的 闰秒表：取 平滑窗口 尚未结束的 下一个闰秒
+
+    if ((X_NULL != xleap_tab) && (xleap_tab->xut_count > 0) &&
+        (!XTMVNSEC_IS_VALID(xleap_tab->xtm_expire) || (xtm_vnsec < xleap_tab->xtm_expire)))
+    {
+        for (xut_iter = 1; xut_iter < xleap_tab->xut_count; ++xut_iter)
+        {
+            if (xit_tsec < xleap_tab->xent_list[xut_iter].xit_when + XNTP_LEAP_SMEAR / 2)
+            {
+                xit_diff = xleap_tab->xent_list[xut_iter].xit_tai - xleap_tab->xent_list[xut_iter - 1].xit_tai;
+                return XNTP_LEAPPLAN(xleap_tab->xent_list[xut_iter].xit_when,
+                                     (xit_diff > 0) ? 1 : ((xit_diff < 0) ? 2 : 0));
+            }
+        }
+
+        // 没有 后续的闰秒：一天之后 重新计算
+        return XNTP_LEAPPLAN(xit_tsec + XNTP_LEAP_SMEAR / 2, 0);
+    }
+
+    //======================================
+    // 依据 LI：闰秒 位于 当月 最后一秒 之后
+
+    if (0 != xut_leap)
+    {
+        return XNTP_LEAPPLAN(ntpleap_month_next(xit_tsec), xut_leap);
+    }
+
+    return XNTP_LEAPPLAN(xit_tsec + XNTP_LEAP_SMEAR / 2, 0);
+
+    //======================================
+}
@@ -0,0 +1,197 @@
+﻿/**
+ * @file ntp_leap.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 闰秒表（leap-seconds.list）、闰秒计划 与 24 小时线性平滑（leap smear）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_LEAP_H__
+#define __NTP_LEAP_H__
+
+#include "xtime.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @enum  xntp_leapmode_t
+ * @brief 闰秒 的 处理方式（作用于 ntpcli_req_time() 等接口 返回的 校正时间）。
+ */
+typedef enum xntp_leapmode_t
+{
+    ntp_leap_step  = 0,  ///< 跳变：与 UNIX 时间 相同，闰秒处 时间 回退（或 前跳）1 秒
+    ntp_leap_smear = 1,  ///< 平滑：以 闰秒时刻 为中心的 24 小时内，线性地 分摊 这 1 秒
+} xntp_leapmode_t;
+
+/** 平滑窗口 的 时长（秒）：闰秒时刻 前后 各 12 小时 */
+#define XNTP_LEAP_SMEAR     86400LL
+
+/**
+ * 闰秒计划：打包为 一个 64 位整数，可整体 原子读写；
+ * 高 62 位 为 闰秒时刻（闰秒之后 次日 00:00:00 UTC 的 UNIX 秒数），
+ * 低 2 位 为 闰秒类型（与 NTP 报文 的 LI 取值相同：0 无闰秒，1 插入，2 删除）；
+ * 取 0 表示 尚无计划（须重新计算）。
+ */
+typedef x_uint64_t xntp_leapplan_t;
+
+/** 由 闰秒时刻（UNIX 秒数）与 闰秒类型 组成 闰秒计划 */
+#define XNTP_LEAPPLAN(xsec, xli)    ((((xntp_leapplan_t)(xsec)) << 2) | ((xntp_leapplan_t)(xli) & 3))
+
+/** 闰秒计划 的 闰秒时刻（UNIX 秒数） */
+#define XNTP_LEAPPLAN_SEC(xplan)    ((x_int64_t)((xplan) >> 2))
+
+/** 闰秒计划 的 闰秒类型（0 无闰秒，1 插入，2 删除） */
+#define XNTP_LEAPPLAN_LI(xplan)     ((x_uint32_t)((xplan) & 3))
+
+/** 闰秒计划 的 有效截止时间（时间计量值）：平滑窗口 结束时，须重新计算 */
+#define XNTP_LEAPPLAN_UNTIL(xplan)  \
+    ((xtime_vnsec_t)(XNTP_LEAPPLAN_SEC(xplan) + XNTP_LEAP_SMEAR / 2) * 10000000ULL)
+
+/** 定义 闰秒表 的 指针类型 */
+typedef struct xntp_leaptab_t * xntp_leapptr_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 创建 闰秒表。
+ * @note
+ * 与 密钥表 相同，闰秒表 在加载完后 只被读取，可由多个线程 共用；
+ * 添加、加载 不是线程安全的，应在共用之前完成。
+ *
+ * @return xntp_leapptr_t : 成功，返回 闰秒表；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_leapptr_t ntpleap_create(void);
+
+/**********************************************************/
+/**
+ * @brief 销毁 闰秒表。
+ */
+x_void_t ntpleap_destroy(xntp_leapptr_t xleap_tab);
+
+/**********************************************************/
+/**
+ * @brief 向 闰秒表 添加（或替换）一项：自 xtm_when 起，TAI - UTC 为 xit_tai 秒。
+ *
+ * @param [in ] xleap_tab : 闰秒表。
+ * @param [in ] xtm_when  : 生效时刻（须为 整秒；通常为 1 月 或 7 月 1 日 00:00:00 UTC）。
+ * @param [in ] xit_tai   : 生效后的 TAI - UTC（秒）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpleap_add(xntp_leapptr_t xleap_tab, xtime_vnsec_t xtm_when, x_int32_t xit_tai);
+
+/**********************************************************/
+/**
+ * @brief 从 IERS/NIST 发布的 leap-seconds.list 文件 加载 闰秒表。
+ * @note
+ * 数据行 格式为 “NTP 秒数（自 1900 年起） TAI-UTC”，'#' 之后为注释；
+ * “#@” 行 为 过期时刻（NTP 秒数），过期后 闰秒表 不再用于 计算闰秒计划；
+ * 不校验 “#h” 行 的 散列值。
+ *
+ * @param [in ] xleap_tab : 闰秒表。
+ * @param [in ] xszt_path : 文件路径。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码（格式错误为 EINVAL）。
+ */
+x_int32_t ntpleap_load(xntp_leapptr_t xleap_tab, x_cstring_t xszt_path);
+
+/**********************************************************/
+/**
+ * @brief 闰秒表 的 过期时刻（未指定时，返回 XTIME_INVALID_VNSEC，即 永不过期）。
+ */
+xtime_vnsec_t ntpleap_expire(xntp_leapptr_t xleap_tab);
+
+/**********************************************************/
+/**
+ * @brief 查询 xtm_vnsec 时刻的 TAI - UTC（秒）；早于 闰秒表 首项 时，返回 0。
+ */
+x_int32_t ntpleap_tai(xntp_leapptr_t xleap_tab, xtime_vnsec_t xtm_vnsec);
+
+/**********************************************************/
+/**
+ * @brief 计算 xtm_vnsec 时刻 所适用的 闰秒计划。
+ * @note
+ * 闰秒表 有效（非空 且 未过期）时，取 平滑窗口 尚未结束的 下一个闰秒；
+ * 否则 依据 服务端应答的 LI（1 插入，2 删除），闰秒 位于 当月 最后一秒（UTC）之后。
+ * 平滑窗口 已开始 的 旧计划，在窗口结束前 保持不变（服务端 在闰秒之后 即清除 LI）。
+ * 该接口 开销较大（查表、日期计算），只在 LI 变化 或 计划过期（XNTP_LEAPPLAN_UNTIL()）时 调用。
+ *
+ * @param [in ] xleap_tab : 闰秒表（可为 X_NULL）。
+ * @param [in ] xleap_old : 当前的 闰秒计划（取 0 表示 没有）。
+ * @param [in ] xtm_vnsec : 当前时间（UTC）。
+ * @param [in ] xut_leap  : 服务端应答的 LI（0 ~ 3，3 表示 服务端未同步，按 0 处理）。
+ *
+ * @return xntp_leapplan_t : 返回 新的 闰秒计划。
+ */
+xntp_leapplan_t ntpleap_plan(
+                    xntp_leapptr_t xleap_tab,
+                    xntp_leapplan_t xleap_old,
+                    xtime_vnsec_t xtm_vnsec,
+                    x_uint32_t xut_leap);
+
+/**********************************************************/
+/**
+ * @brief 按 闰秒计划，对 时间计量值（UNIX 时间，闰秒处 跳变）做 24 小时线性平滑。
+ * @note
+ * 平滑时间 s 与 输入时间 t 的关系为 s = t + sign * (step - ramp)：
+ * sign 为 +1（插入）或 -1（删除），step 在 闰秒时刻 之后 为 1 秒、之前 为 0，
+ * ramp 在 平滑窗口 内 由 0 线性增至 1 秒、窗口之外 保持端点值；
+ * 即 插入闰秒 时，平滑时间 每秒 慢 1/86400 秒，窗口结束时 恢复一致。
+ * 每个 校正时间 都要经过该计算，故 只用 比较、截取（可编译为 条件传送）与 乘法，没有分支跳转；
+ * 无闰秒 的计划（sign 为 0）原样返回 输入时间。
+ * 闰秒 当中（插入时 UNIX 时间 重复的那一秒），输入时间 本身 已无法区分，不做特别处理。
+ */
+static inline xtime_vnsec_t ntpleap_smear(xntp_leapplan_t xleap_plan, xtime_vnsec_t xtm_vnsec)
+{
+    x_int64_t xit_time = (x_int64_t)xtm_vnsec;
+    x_int64_t xit_leap = XNTP_LEAPPLAN_SEC(xleap_plan) * 10000000LL;
+    x_int64_t xit_sign = (x_int64_t)(xleap_plan & 1) - (x_int64_t)((xleap_plan >> 1) & 1);
+    x_int64_t xit_ramp = xit_time - (xit_leap - (XNTP_LEAP_SMEAR / 2) * 10000000LL);
+
+    xit_ramp = (xit_ramp < 0) ? 0 : xit_ramp;
+    xit_ramp = (xit_ramp > XNTP_LEAP_SMEAR * 10000000LL) ? (XNTP_LEAP_SMEAR * 10000000LL) : xit_ramp;
+
+    return (xtime_vnsec_t)(xit_time +
+        xit_sign * ((x_int64_t)(xit_time >= xit_leap) * 10000000LL - xit_ramp / XNTP_LEAP_SMEAR));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_LEAP_H__
@@ -0,0 +1,1187 @@
+﻿/**
+ * @file ntp_nts.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTS（Network Time Security，RFC 8915）客户端会话：NTS-KE 握手、cookie 缓存 与 AEAD 保护的 NTP 请求。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_nts.h"
+#include "ntp_client.h"
+#include "ntp_packet.h"
+#include "ntp_cmac.h"
+#include "xatomic.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if (defined(_WIN32) || defined(_WIN64))
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <windows.h>
+#elif (defined(__linux__) || defined(__unix__))
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+#ifdef XNTP_OPENSSL
+#include <openssl/ssl.h>
+#include <openssl/rand.h>
+#include <openssl/x509v3.h>
+#endif // XNTP_OPENSSL
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 协议常量（RFC 8915）
+//
+
+/** NTS-KE 记录类型 */
+#define XNTS_KE_EOM         0       ///< End of Message
+#define XNTS_KE_NEXTPROTO   1       ///< NTS Next Protocol Negotiation
+#define XNTS_KE_ERROR       2       ///< Error
+#define XNTS_KE_WARNING     3       ///< Warning
+#define XNTS_KE_AEAD        4       ///< AEAD Algorithm Negotiation
+#define XNTS_KE_COOKIE      5       ///< New Cookie for NTPv4
+#define XNTS_KE_SERVER      6       ///< NTPv4 Server Negotiation
+#define XNTS_KE_PORT        7       ///< NTPv4 Port Negotiation
+
+/** NTS-KE 记录类型 的 critical 标识位 */
+#define XNTS_KE_CRITICAL    0x8000
+
+/** NTS-KE 记录 主体数据 的 最大字节数（超过时 视为 协议错误） */
+#define XNTS_KE_BODY_MAX    1024
+
+/** Next Protocol：NTPv4 */
+#define XNTS_PROTO_NTPV4    0x0000
+
+/** AEAD 算法：AEAD_AES_SIV_CMAC_256 */
+#define XNTS_AEAD_SIV256    0x000F
+
+/** NTS-KE 的 ALPN 协议标识 */
+#define XNTS_ALPN           "\x07ntske/1"
+
+/** 导出 会话密钥 所用的 TLS exporter 标签 */
+#define XNTS_EXPORTER       "EXPORTER-network-time-security"
+
+/** NTP 扩展字段 类型 */
+#define XNTS_EF_UID         0x0104  ///< Unique Identifier
+#define XNTS_EF_COOKIE      0x0204  ///< NTS Cookie
+#define XNTS_EF_PLACEHOLDER 0x0304  ///< NTS Cookie Placeholder
+#define XNTS_EF_AUTH        0x0404  ///< NTS Authenticator and Encrypted Extension Fields
+
+/** 请求 所用 nonce 的 字节数 */
+#define XNTS_NONCE_LEN      16
+
+/** 请求中 NTS Authenticator 的 字节数（类型与长度、nonce 与 密文 的长度、nonce、只有认证标签的 密文） */
+#define XNTS_AUTH_LEN       (4 + 4 + XNTS_NONCE_LEN + 16)
+
+/** NTS NAK 的 kiss code（“NTSN”） */
+#define XNTS_KISS_NTSN      0x4E54534E
+
+/** 按 4 字节 对齐 */
+#define XNTS_PAD4(xsize)    (((xsize) + 3) & ~3U)
+
+//====================================================================
+
+//
+// 内部相关的数据类型
+//
+
+/**
+ * @struct xntp_cookie_t
+ * @brief  cookie 数据。
+ */
+typedef struct xntp_cookie_t
+{
+    x_uint32_t xut_size;                    ///< 字节数
+    x_uchar_t  xbt_data[XNTS_COOKIE_LEN];   ///< 数据
+} xntp_cookie_t;
+
+/**
+ * @struct xntp_ntskey_t
+ * @brief  一次 NTS-KE 握手 的结果（握手在此结构体上完成，成功后 整体替换 会话中的 旧结果）。
+ */
+typedef struct xntp_ntskey_t
+{
+    x_char_t      xszt_host[TEXT_LEN_256];      ///< NTP 服务端的 域名 或 IP
+    x_uint16_t    xut_port;                     ///< NTP 服务端的 端口号
+#ifdef XNTP_OPENSSL
+    xntp_siv_t    xsiv_c2s;                     ///< 客户端 → 服务端 的 AEAD 密钥
+    xntp_siv_t    xsiv_s2c;                     ///< 服务端 → 客户端 的 AEAD 密钥
+#endif // XNTP_OPENSSL
+    x_uint32_t    xut_count;                    ///< 缓存的 cookie 数量
+    xntp_cookie_t xcookie[XNTS_COOKIE_MAX];     ///< cookie 缓存（后进先出）
+} xntp_ntskey_t;
+
+/**
+ * @struct xntp_nts_t
+ * @brief  NTS 会话。
+ * @note
+ * 会话密钥 与 cookie 缓存 由 自旋锁 xut_lock 保护，锁内 只做 少量的数据复制；
+ * 握手（TLS 网络交互）与 AEAD 计算 均在锁外进行，握手 以 xut_kebusy 保证 同一时刻 只有一个线程执行。
+ */
+typedef struct xntp_nts_t
+{
+    x_char_t      xszt_host[TEXT_LEN_256];      ///< NTS-KE 服务端的 域名 或 IP
+    x_uint16_t    xut_port;                     ///< NTS-KE 服务端的 端口号
+    x_char_t    * xszt_cafile;                  ///< CA 证书文件（可为 X_NULL）
+    x_uint32_t    xut_lock;                     ///< 自旋锁
+    x_uint32_t    xut_kebusy;                   ///< 是否 正在握手
+    x_uint32_t    xut_epoch;                    ///< 已成功完成的 握手次数（0 表示 尚未握手）
+    xntp_ntskey_t xnts_key;                     ///< 当前的 握手结果
+} xntp_nts_t;
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 会话 加锁。
+ */
+static inline x_void_t ntpnts_lock(xntp_ntsptr_t xnts_this)
+{
+    while (!XATOMIC_CAS32(&xnts_this->xut_lock, 0, 1))
+    {
+        XATOMIC_PAUSE();
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 会话 解锁。
+ */
+static inline x_void_t ntpnts_unlock(xntp_ntsptr_t xnts_this)
+{
+    XATOMIC_STORE32(&xnts_this->xut_lock, 0);
+}
+
+#ifdef XNTP_OPENSSL
+
+/**********************************************************/
+/**
+ * @brief 让出 CPU（等待 其他线程 完成握手 时使用）。
+ */
+static x_void_t ntpnts_yield(x_void_t)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    Sleep(1);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    sched_yield();
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 向 报文缓存 写入 扩展字段 的 类型与长度。
+ */
+static inline x_void_t ntpnts_ef_head(x_uchar_t * xbt_pack, x_uint16_t xut_type, x_uint32_t xut_size)
+{
+    ntp_store32(xbt_pack, ((x_uint32_t)xut_type << 16) | (xut_size & 0x0000FFFF));
+}
+
+//====================================================================
+
+//
+// NTS-KE 的 网络交互
+//
+
+/**********************************************************/
+/**
+ * @brief 关闭套接字。
+ */
+static x_void_t ntpnts_sock_close(x_sockfd_t xfdt_sockfd)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    closesocket(xfdt_sockfd);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    close(xfdt_sockfd);
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 设置套接字的 阻塞模式。
+ */
+static x_void_t ntpnts_sock_nbio(x_sockfd_t xfdt_sockfd, x_bool_t xbt_nbio)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    x_ulong_t xult_mode = xbt_nbio;
+    ioctlsocket(xfdt_sockfd, FIONBIO, &xult_mode);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    x_int32_t xit_flag = fcntl(xfdt_sockfd, F_GETFL, 0);
+    fcntl(xfdt_sockfd, F_SETFL, xbt_nbio ? (xit_flag | O_NONBLOCK) : (xit_flag & ~O_NONBLOCK));
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 计算距离 截止时间 的 剩余毫秒数（无限等待 返回 0，已超时 返回 -1）。
+ */
+static x_int32_t ntpnts_dline_msec(xtime_vnsec_t xtm_dline)
+{
+    xtime_vnsec_t xtm_mono = XTIME_INVALID_VNSEC;
+
+    if (!XTMVNSEC_IS_VALID(xtm_dline))
+        return 0;
+
+    xtm_mono = time_mono();
+    if ((xtm_mono + XTIME_VNSEC_MSEC) > xtm_dline)
+        return -1;
+
+    return (x_int32_t)((xtm_dline - xtm_mono) / XTIME_VNSEC_MSEC);
+}
+
+/**********************************************************/
+/**
+ * @brief 在 截止时间 前，与 NTS-KE 服务端 建立 TCP 连接（连接后 为阻塞模式，收发超时 取剩余时间）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpnts_ke_connect(
+                    x_cstring_t xszt_host,
+                    x_uint16_t xut_port,
+                    xtime_vnsec_t xtm_dline,
+                    x_sockfd_t * xfdt_sockfd)
+{
+    x_int32_t         xit_errno = EHOSTUNREACH;
+    x_int32_t         xit_msec  = 0;
+    x_sockfd_t        xfdt_sock = X_INVALID_SOCKFD;
+    struct addrinfo   xai_hint;
+    struct addrinfo * xai_rptr  = X_NULL;
+    struct addrinfo * xai_iptr  = X_NULL;
+    fd_set            xfds_write;
+    struct timeval    xtm_value;
+
+#if (defined(_WIN32) || defined(_WIN64))
+    x_int32_t         xit_elen  = sizeof(x_int32_t);
+    DWORD             xdw_tmout = 0;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t         xit_elen  = sizeof(x_int32_t);
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    memset(&xai_hint, 0, sizeof(xai_hint));
+    xai_hint.ai_family   = AF_INET;
+    xai_hint.ai_socktype = SOCK_STREAM;
+
+    if (0 != getaddrinfo(xszt_host, X_NULL, &xai_hint, &xai_rptr))
+    {
+        return EHOSTUNREACH;
+    }
+
+    for (xai_iptr = xai_rptr; X_NULL != xai_iptr; xai_iptr = xai_iptr->ai_next)
+    {
+        xit_msec = ntpnts_dline_msec(xtm_dline);
+        if (xit_msec < 0)
+        {
+            xit_errno = ETIMEDOUT;
+            break;
+        }
+
+        xfdt_sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (X_INVALID_SOCKFD == xfdt_sock)
+        {
+            continue;
+        }
+
+        ((struct sockaddr_in *)xai_iptr->ai_addr)->sin_port = htons(xut_port);
+
+        // 以 非阻塞方式 连接，select() 等待 至截止时间
+        ntpnts_sock_nbio(xfdt_sock, X_TRUE);
+        if (0 != connect(xfdt_sock, xai_iptr->ai_addr, (x_int32_t)xai_iptr->ai_addrlen))
+        {
+            FD_ZERO(&xfds_write);
+            FD_SET(xfdt_sock, &xfds_write);
+            xtm_value.tv_sec  = xit_msec / 1000;
+            xtm_value.tv_usec = (xit_msec % 1000) * 1000;
+
+            xit_errno = ETIMEDOUT;
+            if ((select((x_int32_t)(xfdt_sock + 1), X_NULL, &xfds_write, X_NULL,
+                        (0 == xit_msec) ? X_NULL : &xtm_value) > 0) &&
+                (0 == getsockopt(xfdt_sock, SOL_SOCKET, SO_ERROR, (x_char_t *)&xit_errno, &xit_elen)) &&
+                (0 == xit_errno))
+            {
+                xit_errno = 0;
+            }
+            else if (0 == xit_errno)
+            {
+                xit_errno = ECONNREFUSED;
+            }
+        }
+        else
+        {
+            xit_errno = 0;
+        }
+
+        if (0 != xit_errno)
+        {
+            ntpnts_sock_close(xfdt_sock);
+            xfdt_sock = X_INVALID_SOCKFD;
+            continue;
+        }
+
+        // TLS 交互 使用阻塞模式，收发超时 取 剩余时间
+        ntpnts_sock_nbio(xfdt_sock, X_FALSE);
+        if (xit_msec > 0)
+        {
+#if (defined(_WIN32) || defined(_WIN64))
+            xdw_tmout = (DWORD)xit_msec;
+            setsockopt(xfdt_sock, SOL_SOCKET, SO_RCVTIMEO, (x_char_t *)&xdw_tmout, sizeof(DWORD));
+            setsockopt(xfdt_sock, SOL_SOCKET, SO_SNDTIMEO, (x_char_t *)&xdw_tmout, sizeof(DWORD));
+#else // !(defined(_WIN32) || defined(_WIN64))
+            xtm_value.tv_sec  = xit_msec / 1000;
+            xtm_value.tv_usec = (xit_msec % 1000) * 1000;
+            setsockopt(xfdt_sock, SOL_SOCKET, SO_RCVTIMEO, (x_char_t *)&xtm_value, sizeof(struct timeval));
+            setsockopt(xfdt_sock, SOL_SOCKET, SO_SNDTIMEO, (x_char_t *)&xtm_value, sizeof(struct timeval));
+#endif // (defined(_WIN32) || defined(_WIN64))
+        }
+
+        break;
+    }
+
+    freeaddrinfo(xai_rptr);
+
+    *xfdt_sockfd = xfdt_sock;
+    return (X_INVALID_SOCKFD == xfdt_sock) ? xit_errno : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 从 TLS 连接中 读取 指定字节数 的数据。
+ *
+ * @return x_int32_t : 成功，返回 0；连接关闭 或 超时，返回 错误码。
+ */
+static x_int32_t ntpnts_ssl_read(SSL * xssl_ptr, x_uchar_t * xbt_data, x_uint32_t xut_size)
+{
+    x_int32_t xit_rlen = 0;
+
+    while (xut_size > 0)
+    {
+        xit_rlen = SSL_read(xssl_ptr, xbt_data, (x_int32_t)xut_size);
+        if (xit_rlen <= 0)
+        {
+            return (SSL_ERROR_ZERO_RETURN == SSL_get_error(xssl_ptr, xit_rlen)) ? ECONNRESET : ETIMEDOUT;
+        }
+
+        xbt_data += xit_rlen;
+        xut_size -= (x_uint32_t)xit_rlen;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 在已建立的 TLS 连接上，完成 NTS-KE 的 请求与应答，并导出 会话密钥。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpnts_ke_exchange(SSL * xssl_ptr, xntp_ntskey_t * xnts_key)
+{
+    x_int32_t  xit_errno = 0;
+    x_uint32_t xut_type  = 0;
+    x_uint32_t xut_blen  = 0;
+    x_bool_t   xbt_proto = X_FALSE;
+    x_bool_t   xbt_aead  = X_FALSE;
+    x_uchar_t  xbt_head[4];
+    x_uchar_t  xbt_body[XNTS_KE_BODY_MAX];
+    x_uchar_t  xbt_ekey[XSIV_KEY_LEN];
+    x_uchar_t  xbt_ectx[5] = { 0x00, 0x00, 0x00, 0x0F, 0x00 };
+
+    // 请求：NTPv4、AEAD_AES_SIV_CMAC_256、End of Message
+    static const x_uchar_t XNTS_KE_REQUEST[16] =
+    {
+        0x80, XNTS_KE_NEXTPROTO, 0x00, 0x02, 0x00, 0x00,
+        0x80, XNTS_KE_AEAD     , 0x00, 0x02, 0x00, 0x0F,
+        0x80, XNTS_KE_EOM      , 0x00, 0x00
+    };
+
+    if (SSL_write(xssl_ptr, XNTS_KE_REQUEST, sizeof(XNTS_KE_REQUEST)) != (x_int32_t)sizeof(XNTS_KE_REQUEST))
+    {
+        return ECONNRESET;
+    }
+
+    //======================================
+    // 依次读取 应答记录，直到 End of Message
+
+    for (;;)
+    {
+        xit_errno = ntpnts_ssl_read(xssl_ptr, xbt_head, 4);
+        if (0 != xit_errno)
+            return xit_errno;
+
+        xut_type = ((x_uint32_t)xbt_head[0] << 8) | xbt_head[1];
+        xut_blen = ((x_uint32_t)xbt_head[2] << 8) | xbt_head[3];
+        if (xut_blen > XNTS_KE_BODY_MAX)
+            return EPROTO;
+
+        xit_errno = ntpnts_ssl_read(xssl_ptr, xbt_body, xut_blen);
+        if (0 != xit_errno)
+            return xit_errno;
+
+        switch (xut_type & ~XNTS_KE_CRITICAL)
+        {
+        case XNTS_KE_EOM:
+            break;
+
+        case XNTS_KE_NEXTPROTO:
+            for (; xut_blen >= 2; xut_blen -= 2)
+            {
+                if (XNTS_PROTO_NTPV4 == (((x_uint32_t)xbt_body[xut_blen - 2] << 8) | xbt_body[xut_blen - 1]))
+                    xbt_proto = X_TRUE;
+            }
+            continue;
+
+        case XNTS_KE_AEAD:
+            xbt_aead = ((2 == xut_blen) && (XNTS_AEAD_SIV256 == (((x_uint32_t)xbt_body[0] << 8) | xbt_body[1])));
+            continue;
+
+        case XNTS_KE_ERROR:
+            return EPROTO;
+
+        case XNTS_KE_COOKIE:
+            if ((xut_blen > 0) && (xut_blen <= XNTS_COOKIE_LEN) && (xnts_key->xut_count < XNTS_COOKIE_MAX))
+            {
+                xnts_key->xcookie[xnts_key->xut_count].xut_size = xut_blen;
+                memcpy(xnts_key->xcookie[xnts_key->xut_count].xbt_data, xbt_body, xut_blen);
+                xnts_key->xut_count += 1;
+            }
+            continue;
+
+        case XNTS_KE_SERVER:
+            if ((0 == xut_blen) || (xut_blen >= TEXT_LEN_256))
+                return EPROTO;
+            memcpy(xnts_key->xszt_host, xbt_body, xut_blen);
+            xnts_key->xszt_host[xut_blen] = '\0';
+            continue;
+
+        case XNTS_KE_PORT:
+            if (2 != xut_blen)
+                return EPROTO;
+            xnts_key->xut_port = (x_uint16_t)(((x_uint32_t)xbt_body[0] << 8) | xbt_body[1]);
+            continue;
+
+        default:
+            // 不认识的 critical 记录 须视为 错误，其余的 忽略（含 Warning）
+            if (0 != (xut_type & XNTS_KE_CRITICAL))
+                return EPROTO;
+            continue;
+        }
+
+        break;
+    }
+
+    if (!xbt_proto || !xbt_aead || (0 == xnts_key->xut_count))
+    {
+        return EPROTO;
+    }
+
+    //======================================
+    // 导出 C2S（上下文末字节 0x00）与 S2C（0x01）密钥
+
+    if ((1 != SSL_export_keying_material(xssl_ptr, xbt_ekey, XSIV_KEY_LEN,
+                                         XNTS_EXPORTER, sizeof(XNTS_EXPORTER) - 1,
+                                         xbt_ectx, sizeof(xbt_ectx), 1)) ||
+        !ntp_siv_init(&xnts_key->xsiv_c2s, xbt_ekey))
+    {
+        xit_errno = EPROTO;
+    }
+
+    xbt_ectx[4] = 0x01;
+    if ((0 == xit_errno) &&
+        ((1 != SSL_export_keying_material(xssl_ptr, xbt_ekey, XSIV_KEY_LEN,
+                                          XNTS_EXPORTER, sizeof(XNTS_EXPORTER) - 1,
+                                          xbt_ectx, sizeof(xbt_ectx), 1)) ||
+         !ntp_siv_init(&xnts_key->xsiv_s2c, xbt_ekey)))
+    {
+        xit_errno = EPROTO;
+    }
+
+    OPENSSL_cleanse(xbt_ekey, sizeof(xbt_ekey));
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 执行一次 NTS-KE 握手（TCP 连接、TLS 1.3 握手、证书校验、NTS-KE 交互）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpnts_ke_run(xntp_ntsptr_t xnts_this, xntp_ntskey_t * xnts_key, xtime_vnsec_t xtm_dline)
+{
+    x_int32_t           xit_errno = EPERM;
+    x_sockfd_t          xfdt_sock = X_INVALID_SOCKFD;
+    SSL_CTX           * xctx_ptr  = X_NULL;
+    SSL               * xssl_ptr  = X_NULL;
+    X509_VERIFY_PARAM * xvfy_ptr  = X_NULL;
+    const x_uchar_t   * xbt_alpn  = X_NULL;
+    x_uint32_t          xut_alen  = 0;
+    struct in_addr      xin_addr;
+
+    do
+    {
+        //======================================
+
+        xctx_ptr = SSL_CTX_new(TLS_client_method());
+        if (X_NULL == xctx_ptr)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        SSL_CTX_set_min_proto_version(xctx_ptr, TLS1_3_VERSION);
+        SSL_CTX_set_verify(xctx_ptr, SSL_VERIFY_PEER, X_NULL);
+        if (0 != SSL_CTX_set_alpn_protos(xctx_ptr, (const x_uchar_t *)XNTS_ALPN, sizeof(XNTS_ALPN) - 1))
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        if (1 != ((X_NULL != xnts_this->xszt_cafile) ?
+                  SSL_CTX_load_verify_locations(xctx_ptr, xnts_this->xszt_cafile, X_NULL) :
+                  SSL_CTX_set_default_verify_paths(xctx_ptr)))
+        {
+            xit_errno = ENOENT;
+            break;
+        }
+
+        //======================================
+
+        xit_errno = ntpnts_ke_connect(xnts_this->xszt_host, xnts_this->xut_port, xtm_dline, &xfdt_sock);
+        if (0 != xit_errno)
+        {
+            break;
+        }
+
+        xssl_ptr = SSL_new(xctx_ptr);
+        if ((X_NULL == xssl_ptr) || (1 != SSL_set_fd(xssl_ptr, (x_int32_t)xfdt_sock)))
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        // 证书 须与 服务端 名称（或 IP 地址）相符
+        xvfy_ptr = SSL_get0_param(xssl_ptr);
+        if (1 == inet_pton(AF_INET, xnts_this->xszt_host, &xin_addr))
+        {
+            X509_VERIFY_PARAM_set1_ip_asc(xvfy_ptr, xnts_this->xszt_host);
+        }
+        else
+        {
+            SSL_set_tlsext_host_name(xssl_ptr, xnts_this->xszt_host);
+            X509_VERIFY_PARAM_set_hostflags(xvfy_ptr, X509_CHECK_FLAG_NO_PARTIAL_WILDCARDS);
+            X509_VERIFY_PARAM_set1_host(xvfy_ptr, xnts_this->xszt_host, 0);
+        }
+
+        if (1 != SSL_connect(xssl_ptr))
+        {
+            xit_errno = (X509_V_OK != SSL_get_verify_result(xssl_ptr)) ? EACCES : ECONNRESET;
+            break;
+        }
+
+        SSL_get0_alpn_selected(xssl_ptr, &xbt_alpn, &xut_alen);
+        if ((xut_alen != sizeof(XNTS_ALPN) - 2) || (0 != memcmp(xbt_alpn, XNTS_ALPN + 1, xut_alen)))
+        {
+            xit_errno = EPROTO;
+            break;
+        }
+
+        //======================================
+
+        // NTP 服务端 默认 与 NTS-KE 服务端 相同
+        memcpy(xnts_key->xszt_host, xnts_this->xszt_host, TEXT_LEN_256);
+        xnts_key->xut_port  = NTP_PORT;
+        xnts_key->xut_count = 0;
+
+        xit_errno = ntpnts_ke_exchange(xssl_ptr, xnts_key);
+        if (0 == xit_errno)
+        {
+            SSL_shutdown(xssl_ptr);
+        }
+
+        //======================================
+    } while (0);
+
+    if (X_NULL != xssl_ptr)
+    {
+        SSL_free(xssl_ptr);
+        xssl_ptr = X_NULL;
+    }
+
+    if (X_NULL != xctx_ptr)
+    {
+        SSL_CTX_free(xctx_ptr);
+        xctx_ptr = X_NULL;
+    }
+
+    if (X_INVALID_SOCKFD != xfdt_sock)
+    {
+        ntpnts_sock_close(xfdt_sock);
+        xfdt_sock = X_INVALID_SOCKFD;
+    }
+
+    return xit_errno;
+}
+
+#endif // XNTP_OPENSSL
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 对外的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 创建 NTS 会话（此时 不进行握手）。
+ *
+ * @param [in ] xszt_host   : NTS-KE 服务端的 域名 或 IP（同时用于 证书校验）。
+ * @param [in ] xut_port    : NTS-KE 服务端的 端口号（可取 NTS_KE_PORT）。
+ * @param [in ] xszt_cafile : 校验服务端证书 所用的 CA 证书文件（PEM）；取 X_NULL 时 使用系统默认的 CA。
+ *
+ * @return xntp_ntsptr_t : 成功，返回 会话对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_ntsptr_t ntpnts_create(x_cstring_t xszt_host, x_uint16_t xut_port, x_cstring_t xszt_cafile)
+{
+    xntp_ntsptr_t xnts_this = X_NULL;
+    x_size_t      xst_flen  = 0;
+
+    if ((X_NULL == xszt_host) || ('\0' == xszt_host[0]) || (strlen(xszt_host) >= TEXT_LEN_256))
+    {
+        errno = EINVAL;
+        return X_NULL;
+    }
+
+    xst_flen  = (X_NULL != xszt_cafile) ? (strlen(xszt_cafile) + 1) : 0;
+    xnts_this = (xntp_ntsptr_t)calloc(1, sizeof(xntp_nts_t) + xst_flen);
+    if (X_NULL == xnts_this)
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    memcpy(xnts_this->xszt_host, xszt_host, strlen(xszt_host) + 1);
+    xnts_this->xut_port = xut_port;
+
+    // CA 证书文件路径 紧随 结构体之后存放
+    if (X_NULL != xszt_cafile)
+    {
+        xnts_this->xszt_cafile = (x_char_t *)(xnts_this + 1);
+        memcpy(xnts_this->xszt_cafile, xszt_cafile, xst_flen);
+    }
+
+    return xnts_this;
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁 NTS 会话（清除 密钥 与 cookie）。
+ */
+x_void_t ntpnts_destroy(xntp_ntsptr_t xnts_this)
+{
+    if (X_NULL == xnts_this)
+    {
+        return;
+    }
+
+#ifdef XNTP_OPENSSL
+    OPENSSL_cleanse(&xnts_this->xnts_key, sizeof(xntp_ntskey_t));
+#endif // XNTP_OPENSSL
+
+    free(xnts_this);
+}
+
+/**********************************************************/
+/**
+ * @brief 执行 NTS-KE 握手（TLS 1.3，ALPN 为 “ntske/1”），更新 会话密钥 与 cookie 缓存。
+ * @note
+ * 多个线程 同时发起时，只有一个线程 进行握手，其余线程 等待其完成。
+ *
+ * @param [in ] xnts_this : NTS 会话。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码（服务端拒绝为 EPROTO，证书校验失败为 EACCES）。
+ */
+x_int32_t ntpnts_handshake(xntp_ntsptr_t xnts_this, xtime_vnsec_t xtm_dline)
+{
+#ifdef XNTP_OPENSSL
+    x_int32_t       xit_errno = 0;
+    x_uint32_t      xut_epoch = 0;
+    xntp_ntskey_t * xnts_key  = X_NULL;
+
+    if (X_NULL == xnts_this)
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 已有线程 正在握手时，等待其完成，并直接使用 其握手结果
+
+    xut_epoch = XATOMIC_LOAD32(&xnts_this->xut_epoch);
+    while (!XATOMIC_CAS32(&xnts_this->xut_kebusy, 0, 1))
+    {
+        if (XTMVNSEC_IS_VALID(xtm_dline) && (time_mono() >= xtm_dline))
+            return ETIMEDOUT;
+        ntpnts_yield();
+    }
+
+    if (xut_epoch != XATOMIC_LOAD32(&xnts_this->xut_epoch))
+    {
+        XATOMIC_STORE32(&xnts_this->xut_kebusy, 0);
+        return 0;
+    }
+
+    //======================================
+    // 握手 在 临时的结构体 上进行，成功后 再整体替换
+
+    xnts_key = (xntp_ntskey_t *)calloc(1, sizeof(xntp_ntskey_t));
+    if (X_NULL == xnts_key)
+    {
+        XATOMIC_STORE32(&xnts_this->xut_kebusy, 0);
+        return ENOMEM;
+    }
+
+    xit_errno = ntpnts_ke_run(xnts_this, xnts_key, xtm_dline);
+    if (0 == xit_errno)
+    {
+        ntpnts_lock(xnts_this);
+        memcpy(&xnts_this->xnts_key, xnts_key, sizeof(xntp_ntskey_t));
+        XATOMIC_ADD32(&xnts_this->xut_epoch, 1);
+        ntpnts_unlock(xnts_this);
+    }
+
+    OPENSSL_cleanse(xnts_key, sizeof(xntp_ntskey_t));
+    free(xnts_key);
+
+    XATOMIC_STORE32(&xnts_this->xut_kebusy, 0);
+
+    return xit_errno;
+#else // !XNTP_OPENSSL
+    (x_void_t)xnts_this;
+    (x_void_t)xtm_dline;
+    return ENOTSUP;
+#endif // XNTP_OPENSSL
+}
+
+/**********************************************************/
+/**
+ * @brief 确保 会话 可以发送请求（无可用 cookie 时，执行握手）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpnts_ready(xntp_ntsptr_t xnts_this, xtime_vnsec_t xtm_dline)
+{
+    if (X_NULL == xnts_this)
+    {
+        return EINVAL;
+    }
+
+    if (ntpnts_cookies(xnts_this) > 0)
+    {
+        return 0;
+    }
+
+    return ntpnts_handshake(xnts_this, xtm_dline);
+}
+
+/**********************************************************/
+/**
+ * @brief 取得 握手协商的 NTP 服务端 地址 与 端口号（须在 握手成功 之后调用）。
+ *
+ * @param [in ] xnts_this : NTS 会话。
+ * @param [out] xszt_host : 返回 NTP 服务端的 域名 或 IP。
+ * @param [in ] xut_size  : xszt_host 缓存的 字节数。
+ * @param [out] xut_port  : 返回 NTP 服务端的 端口号。
+ *
+ * @return x_int32_t : 成功，返回 0；尚未握手，返回 ENOTCONN。
+ */
+x_int32_t ntpnts_server(
+                xntp_ntsptr_t xnts_this,
+                x_char_t * xszt_host,
+                x_uint32_t xut_size,
+                x_uint16_t * xut_port)
+{
+    x_int32_t xit_errno = 0;
+
+    if ((X_NULL == xnts_this) || (X_NULL == xszt_host) || (0 == xut_size) || (X_NULL == xut_port))
+    {
+        return EINVAL;
+    }
+
+    ntpnts_lock(xnts_this);
+    if (0 == xnts_this->xut_epoch)
+    {
+        xit_errno = ENOTCONN;
+    }
+    else if (strlen(xnts_this->xnts_key.xszt_host) >= xut_size)
+    {
+        xit_errno = ENOBUFS;
+    }
+    else
+    {
+        memcpy(xszt_host, xnts_this->xnts_key.xszt_host, strlen(xnts_this->xnts_key.xszt_host) + 1);
+        *xut_port = xnts_this->xnts_key.xut_port;
+    }
+    ntpnts_unlock(xnts_this);
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 会话中 当前缓存的 cookie 数量。
+ */
+x_uint32_t ntpnts_cookies(xntp_ntsptr_t xnts_this)
+{
+    x_uint32_t xut_count = 0;
+
+    if (X_NULL != xnts_this)
+    {
+        ntpnts_lock(xnts_this);
+        xut_count = xnts_this->xnts_key.xut_count;
+        ntpnts_unlock(xnts_this);
+    }
+
+    return xut_count;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 会话 已成功完成的 握手次数。
+ */
+x_uint32_t ntpnts_handshakes(xntp_ntsptr_t xnts_this)
+{
+    return (X_NULL != xnts_this) ? XATOMIC_LOAD32(&xnts_this->xut_epoch) : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 为 已写好头部的 NTP 请求报文 追加 NTS 扩展字段（取出一个 cookie）。
+ * @note
+ * 依次追加 Unique Identifier、NTS Cookie、若干 NTS Cookie Placeholder
+ * 与 NTS Authenticator（AES-SIV-CMAC-256，关联数据 为 其前面的全部报文数据）；
+ * 头部的 transmit 字段 被改写为 随机值（不暴露 本地时间，且 应答 以此匹配），
+ * 因此 调用方 应在本接口返回后 再记录 T1，加密耗时 也就不计入 往返时延。
+ *
+ * @param [in    ] xnts_this : NTS 会话。
+ * @param [out   ] xnts_req  : 返回 本次请求的 上下文。
+ * @param [in,out] xbt_pack  : 报文缓存（前 48 字节 为已写好的 头部）。
+ * @param [in    ] xut_pmax  : 报文缓存的 字节数。
+ * @param [out   ] xut_plen  : 返回 报文长度。
+ *
+ * @return x_int32_t : 成功，返回 0；没有可用的 cookie，返回 ENOTCONN；缓存不足，返回 ENOBUFS。
+ */
+x_int32_t ntpnts_seal(
+                xntp_ntsptr_t xnts_this,
+                xntp_ntsreq_t * xnts_req,
+                x_uchar_t * xbt_pack,
+                x_uint32_t xut_pmax,
+                x_uint32_t * xut_plen)
+{
+#ifdef XNTP_OPENSSL
+    x_uint32_t    xut_left  = 0;
+    x_uint32_t    xut_want  = 0;
+    x_uint32_t    xut_elen  = 0;
+    x_uint32_t    xut_mpos  = XNTP_PKT_LEN;
+    xntp_siv_t    xsiv_c2s;
+    xntp_cookie_t xcookie;
+    xntp_siv_ad_t xsiv_ad[2];
+
+    if ((X_NULL == xnts_this) || (X_NULL == xnts_req) || (X_NULL == xbt_pack) || (X_NULL == xut_plen))
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 取出 一个 cookie 与 C2S 密钥
+
+    ntpnts_lock(xnts_this);
+    if (0 == xnts_this->xnts_key.xut_count)
+    {
+        ntpnts_unlock(xnts_this);
+        return ENOTCONN;
+    }
+
+    xut_left = --xnts_this->xnts_key.xut_count;
+    memcpy(&xcookie, &xnts_this->xnts_key.xcookie[xut_left], sizeof(xntp_cookie_t));
+    memcpy(&xsiv_c2s, &xnts_this->xnts_key.xsiv_c2s, sizeof(xntp_siv_t));
+    xnts_req->xut_epoch = xnts_this->xut_epoch;
+    ntpnts_unlock(xnts_this);
+
+    //======================================
+
+    xut_elen = 4 + XNTS_PAD4(xcookie.xut_size);
+    if ((XNTP_PKT_LEN + (4 + XNTS_UID_LEN) + xut_elen + XNTS_AUTH_LEN) > xut_pmax)
+    {
+        OPENSSL_cleanse(&xsiv_c2s, sizeof(xntp_siv_t));
+        return ENOBUFS;
+    }
+
+    // 随机的 transmit 字段 与 Unique Identifier
+    if ((1 != RAND_bytes((x_uchar_t *)&xnts_req->xut_xmt, sizeof(x_uint64_t))) ||
+        (1 != RAND_bytes(xnts_req->xbt_uid, XNTS_UID_LEN)))
+    {
+        OPENSSL_cleanse(&xsiv_c2s, sizeof(xntp_siv_t));
+        return EAGAIN;
+    }
+    ntp_store64(xbt_pack + XNTP_OFF_TRANSMIT, xnts_req->xut_xmt);
+
+    ntpnts_ef_head(xbt_pack + xut_mpos, XNTS_EF_UID, 4 + XNTS_UID_LEN);
+    memcpy(xbt_pack + xut_mpos + 4, xnts_req->xbt_uid, XNTS_UID_LEN);
+    xut_mpos += 4 + XNTS_UID_LEN;
+
+    ntpnts_ef_head(xbt_pack + xut_mpos, XNTS_EF_COOKIE, xut_elen);
+    memcpy(xbt_pack + xut_mpos + 4, xcookie.xbt_data, xcookie.xut_size);
+    memset(xbt_pack + xut_mpos + 4 + xcookie.xut_size, 0, xut_elen - 4 - xcookie.xut_size);
+    xut_mpos += xut_elen;
+
+    // 以 占位字段 索取 补足缓存 所需的 cookie（受 报文长度 限制）
+    for (xut_want = XNTS_COOKIE_MAX - 1 - xut_left;
+         (xut_want > 0) && ((xut_mpos + xut_elen + XNTS_AUTH_LEN) <= xut_pmax);
+         --xut_want)
+    {
+        ntpnts_ef_head(xbt_pack + xut_mpos, XNTS_EF_PLACEHOLDER, xut_elen);
+        memset(xbt_pack + xut_mpos + 4, 0, xut_elen - 4);
+        xut_mpos += xut_elen;
+    }
+
+    //======================================
+    // NTS Authenticator：nonce 长度、密文 长度、nonce、密文（无加密的扩展字段，只有 认证标签）
+
+    ntpnts_ef_head(xbt_pack + xut_mpos, XNTS_EF_AUTH, XNTS_AUTH_LEN);
+    ntp_store32(xbt_pack + xut_mpos + 4, (XNTS_NONCE_LEN << 16) | XSIV_TAG_LEN);
+    if (1 != RAND_bytes(xbt_pack + xut_mpos + 8, XNTS_NONCE_LEN))
+    {
+        OPENSSL_cleanse(&xsiv_c2s, sizeof(xntp_siv_t));
+        return EAGAIN;
+    }
+
+    xsiv_ad[0].xbt_data = xbt_pack;
+    xsiv_ad[0].xut_size = xut_mpos;
+    xsiv_ad[1].xbt_data = xbt_pack + xut_mpos + 8;
+    xsiv_ad[1].xut_size = XNTS_NONCE_LEN;
+    ntp_siv_seal(&xsiv_c2s, xsiv_ad, 2, X_NULL, 0, xbt_pack + xut_mpos + 8 + XNTS_NONCE_LEN);
+
+    *xut_plen = xut_mpos + XNTS_AUTH_LEN;
+
+    OPENSSL_cleanse(&xsiv_c2s, sizeof(xntp_siv_t));
+    OPENSSL_cleanse(&xcookie, sizeof(xntp_cookie_t));
+
+    return 0;
+#else // !XNTP_OPENSSL
+    (x_void_t)xnts_this;
+    (x_void_t)xnts_req;
+    (x_void_t)xbt_pack;
+    (x_void_t)xut_pmax;
+    (x_void_t)xut_plen;
+    return ENOTSUP;
+#endif // XNTP_OPENSSL
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 NTS 应答（Unique Identifier 与 NTS Authenticator），并收取 应答中 加密携带的 新 cookie。
+ * @note
+ * 收到 Unique Identifier 相符的 NTS NAK（kiss code 为 “NTSN”）时，清空 cookie 缓存，
+ * 下次请求 将重新握手。
+ *
+ * @param [in ] xnts_this : NTS 会话。
+ * @param [in ] xnts_req  : 请求的 上下文。
+ * @param [in ] xbt_data  : 应答报文。
+ * @param [in ] xut_dlen  : 应答报文长度。
+ *
+ * @return x_int32_t : 校验通过，返回 0；否则返回 EACCES。
+ */
+x_int32_t ntpnts_open(
+                xntp_ntsptr_t xnts_this,
+                const xntp_ntsreq_t * xnts_req,
+                const x_uchar_t * xbt_data,
+                x_uint32_t xut_dlen)
+{
+#ifdef XNTP_OPENSSL
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_apos  = 0;
+    x_uint32_t    xut_nlen  = 0;
+    x_uint32_t    xut_clen  = 0;
+    x_bool_t      xbt_uid   = X_FALSE;
+    x_bool_t      xbt_okay  = X_FALSE;
+    xntp_view_t   xview_pk;
+    xntp_view_t   xview_pt;
+    xntp_ext_t    xext_this;
+    xntp_ext_t    xext_auth;
+    xntp_siv_t    xsiv_s2c;
+    xntp_siv_ad_t xsiv_ad[2];
+    x_uchar_t     xbt_text[XNTP_PKT_LEN + XNTP_PKT_MAX];
+
+    if ((X_NULL == xnts_this) || (X_NULL == xnts_req) || (X_NULL == xbt_data) ||
+        (0 != ntpv_init(&xview_pk, xbt_data, (x_int32_t)xut_dlen)) ||
+        ntpv_has_mac(&xview_pk))
+    {
+        return EACCES;
+    }
+
+    //======================================
+    // Unique Identifier 须与请求相同，NTS Authenticator 须为 最后一个扩展字段
+
+    memset(&xext_auth, 0, sizeof(xntp_ext_t));
+    while (ntpv_ext_next(&xview_pk, &xut_iter, &xext_this))
+    {
+        if (0 != xext_auth.xut_type)
+        {
+            return EACCES;
+        }
+
+        if (XNTS_EF_UID == xext_this.xut_type)
+        {
+            xbt_uid = ((XNTS_UID_LEN == xext_this.xut_vlen) &&
+                       (0 == CRYPTO_memcmp(xext_this.xbt_value, xnts_req->xbt_uid, XNTS_UID_LEN)));
+        }
+        else if (XNTS_EF_AUTH == xext_this.xut_type)
+        {
+            xext_auth = xext_this;
+            xut_apos  = (x_uint32_t)(xext_this.xbt_value - 4 - xbt_data);
+        }
+    }
+
+    if (!xbt_uid)
+    {
+        return EACCES;
+    }
+
+    // NTS NAK：未经认证，只在 Unique Identifier 相符时 放弃现有的 cookie
+    if ((0 == xext_auth.xut_type) || (xext_auth.xut_vlen < 4))
+    {
+        if ((0 == ntpv_stratum(&xview_pk)) && (XNTS_KISS_NTSN == ntpv_refid(&xview_pk)))
+        {
+            ntpnts_lock(xnts_this);
+            if (xnts_req->xut_epoch == xnts_this->xut_epoch)
+                xnts_this->xnts_key.xut_count = 0;
+            ntpnts_unlock(xnts_this);
+        }
+
+        return EACCES;
+    }
+
+    xut_nlen = ((x_uint32_t)xext_auth.xbt_value[0] << 8) | xext_auth.xbt_value[1];
+    xut_clen = ((x_uint32_t)xext_auth.xbt_value[2] << 8) | xext_auth.xbt_value[3];
+    if ((xut_clen < XSIV_TAG_LEN) ||
+        ((4 + XNTS_PAD4(xut_nlen) + XNTS_PAD4(xut_clen)) > xext_auth.xut_vlen) ||
+        ((xut_clen - XSIV_TAG_LEN) > (sizeof(xbt_text) - XNTP_PKT_LEN)))
+    {
+        return EACCES;
+    }
+
+    //======================================
+    // 解密 并 校验（密钥 须仍为 请求时的 握手结果）
+
+    ntpnts_lock(xnts_this);
+    if (xnts_req->xut_epoch == xnts_this->xut_epoch)
+    {
+        memcpy(&xsiv_s2c, &xnts_this->xnts_key.xsiv_s2c, sizeof(xntp_siv_t));
+        xbt_okay = X_TRUE;
+    }
+    ntpnts_unlock(xnts_this);
+
+    if (!xbt_okay)
+    {
+        return EACCES;
+    }
+
+    xsiv_ad[0].xbt_data = xbt_data;
+    xsiv_ad[0].xut_size = xut_apos;
+    xsiv_ad[1].xbt_data = xext_auth.xbt_value + 4;
+    xsiv_ad[1].xut_size = xut_nlen;
+
+    // 明文 放在 一个 虚拟的 48 字节 头部 之后，以便 复用 扩展字段 的遍历
+    memset(xbt_text, 0, XNTP_PKT_LEN);
+    xbt_okay = ntp_siv_open(&xsiv_s2c, xsiv_ad, 2,
+                            xext_auth.xbt_value + 4 + XNTS_PAD4(xut_nlen), xut_clen,
+                            xbt_text + XNTP_PKT_LEN);
+    OPENSSL_cleanse(&xsiv_s2c, sizeof(xntp_siv_t));
+    if (!xbt_okay)
+    {
+        return EACCES;
+    }
+
+    //======================================
+    // 收取 加密扩展字段 中的 新 cookie
+
+    if ((xut_clen > XSIV_TAG_LEN) &&
+        (0 == ntpv_init(&xview_pt, xbt_text, (x_int32_t)(XNTP_PKT_LEN + xut_clen - XSIV_TAG_LEN))))
+    {
+        ntpnts_lock(xnts_this);
+        for (xut_iter = 0; ntpv_ext_next(&xview_pt, &xut_iter, &xext_this); )
+        {
+            if ((XNTS_EF_COOKIE != xext_this.xut_type) ||
+                (0 == xext_this.xut_vlen) ||
+                (xext_this.xut_vlen > XNTS_COOKIE_LEN) ||
+                (xnts_req->xut_epoch != xnts_this->xut_epoch) ||
+                (xnts_this->xnts_key.xut_count >= XNTS_COOKIE_MAX))
+            {
+                continue;
+            }
+
+            xnts_this->xnts_key.xcookie[xnts_this->xnts_key.xut_count].xut_size = xext_this.xut_vlen;
+            memcpy(xnts_this->xnts_key.xcookie[xnts_this->xnts_key.xut_count].xbt_data,
+                   xext_this.xbt_value,
+                   xext_this.xut_vlen);
+            xnts_this->xnts_key.xut_count += 1;
+        }
+        ntpnts_unlock(xnts_this);
+    }
+
+    OPENSSL_cleanse(xbt_text, sizeof(xbt_text));
+
+    return 0;
+#else // !XNTP_OPENSSL
+    (x_void_t)xnts_this;
+    (x_void_t)xnts_req;
+    (x_void_t)xbt_data;
+    (x_void_t)xut_dlen;
+    return EACCES;
+#endif // XNTP_OPENSSL
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,205 @@
+﻿/**
+ * @file ntp_nts.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTS（Network Time Security，RFC 8915）客户端会话：NTS-KE 握手、cookie 缓存 与 AEAD 保护的 NTP 请求。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_NTS_H__
+#define __NTP_NTS_H__
+
+#include "xtime.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * NTS 依赖 OpenSSL（libssl、libcrypto），由 CMake 选项 XNTP_OPENSSL 控制；
+ * 未启用时，本文件的接口依然可用，但 握手 会返回 ENOTSUP。
+ *
+ * 一个 NTS 会话 对应一个 NTS-KE 服务端：首次请求时 经 TLS 1.3 完成 NTS-KE 握手，
+ * 得到 C2S/S2C 密钥 与 一组 cookie（最多 XNTS_COOKIE_MAX 个）；
+ * 此后的每次 NTP 请求 消耗一个 cookie，并以 占位字段 向服务端 索取补充，
+ * 应答中 加密携带的 新 cookie 放回缓存，因此 TLS 握手 只在 会话建立、
+ * cookie 耗尽（连续丢包）或 服务端 回复 NTS NAK 时 才会重新进行。
+ */
+
+/** NTS-KE 服务的 默认端口号 */
+#define NTS_KE_PORT         4460
+
+/** 会话缓存的 cookie 的 最大数量 */
+#define XNTS_COOKIE_MAX     8
+
+/** 单个 cookie 的 最大字节数 */
+#define XNTS_COOKIE_LEN     256
+
+/** NTS 请求 所使用的 Unique Identifier 扩展字段 的 字节数 */
+#define XNTS_UID_LEN        32
+
+/** 定义 NTS 会话 的 指针类型 */
+typedef struct xntp_nts_t * xntp_ntsptr_t;
+
+/**
+ * @struct xntp_ntsreq_t
+ * @brief  一次 NTS 请求 的 上下文（由 ntpnts_seal() 填写，供 ntpnts_open() 校验应答）。
+ */
+typedef struct xntp_ntsreq_t
+{
+    x_uchar_t  xbt_uid[XNTS_UID_LEN];   ///< 请求的 Unique Identifier
+    x_uint64_t xut_xmt;                 ///< 请求报文的 transmit 字段（随机值，应答的 originate 须与之相同）
+    x_uint32_t xut_epoch;               ///< 请求所用密钥 对应的 握手序号
+} xntp_ntsreq_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 创建 NTS 会话（此时 不进行握手）。
+ *
+ * @param [in ] xszt_host   : NTS-KE 服务端的 域名 或 IP（同时用于 证书校验）。
+ * @param [in ] xut_port    : NTS-KE 服务端的 端口号（可取 NTS_KE_PORT）。
+ * @param [in ] xszt_cafile : 校验服务端证书 所用的 CA 证书文件（PEM）；取 X_NULL 时 使用系统默认的 CA。
+ *
+ * @return xntp_ntsptr_t : 成功，返回 会话对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_ntsptr_t ntpnts_create(x_cstring_t xszt_host, x_uint16_t xut_port, x_cstring_t xszt_cafile);
+
+/**********************************************************/
+/**
+ * @brief 销毁 NTS 会话（清除 密钥 与 cookie）。
+ */
+x_void_t ntpnts_destroy(xntp_ntsptr_t xnts_this);
+
+/**********************************************************/
+/**
+ * @brief 执行 NTS-KE 握手（TLS 1.3，ALPN 为 “ntske/1”），更新 会话密钥 与 cookie 缓存。
+ * @note
+ * 多个线程 同时发起时，只有一个线程 进行握手，其余线程 等待其完成。
+ *
+ * @param [in ] xnts_this : NTS 会话。
+ * @param [in ] xtm_dline : 单调时钟的截止时间；取 XTIME_INVALID_VNSEC 时，表示无限等待。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码（服务端拒绝为 EPROTO，证书校验失败为 EACCES）。
+ */
+x_int32_t ntpnts_handshake(xntp_ntsptr_t xnts_this, xtime_vnsec_t xtm_dline);
+
+/**********************************************************/
+/**
+ * @brief 确保 会话 可以发送请求（无可用 cookie 时，执行握手）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpnts_ready(xntp_ntsptr_t xnts_this, xtime_vnsec_t xtm_dline);
+
+/**********************************************************/
+/**
+ * @brief 取得 握手协商的 NTP 服务端 地址 与 端口号（须在 握手成功 之后调用）。
+ *
+ * @param [in ] xnts_this : NTS 会话。
+ * @param [out] xszt_host : 返回 NTP 服务端的 域名 或 IP。
+ * @param [in ] xut_size  : xszt_host 缓存的 字节数。
+ * @param [out] xut_port  : 返回 NTP 服务端的 端口号。
+ *
+ * @return x_int32_t : 成功，返回 0；尚未握手，返回 ENOTCONN。
+ */
+x_int32_t ntpnts_server(
+                xntp_ntsptr_t xnts_this,
+                x_char_t * xszt_host,
+                x_uint32_t xut_size,
+                x_uint16_t * xut_port);
+
+/**********************************************************/
+/**
+ * @brief 返回 会话中 当前缓存的 cookie 数量。
+ */
+x_uint32_t ntpnts_cookies(xntp_ntsptr_t xnts_this);
+
+/**********************************************************/
+/**
+ * @brief 返回 会话 已成功完成的 握手次数。
+ */
+x_uint32_t ntpnts_handshakes(xntp_ntsptr_t xnts_this);
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 为 已写好头部的 NTP 请求报文 追加 NTS 扩展字段（取出一个 cookie）。
+ * @note
+ * 依次追加 Unique Identifier、NTS Cookie、若干 NTS Cookie Placeholder
+ * 与 NTS Authenticator（AES-SIV-CMAC-256，关联数据 为 其前面的全部报文数据）；
+ * 头部的 transmit 字段 被改写为 随机值（不暴露 本地时间，且 应答 以此匹配），
+ * 因此 调用方 应在本接口返回后 再记录 T1，加密耗时 也就不计入 往返时延。
+ *
+ * @param [in    ] xnts_this : NTS 会话。
+ * @param [out   ] xnts_req  : 返回 本次请求的 上下文。
+ * @param [in,out] xbt_pack  : 报文缓存（前 48 字节 为已写好的 头部）。
+ * @param [in    ] xut_pmax  : 报文缓存的 字节数。
+ * @param [out   ] xut_plen  : 返回 报文长度。
+ *
+ * @return x_int32_t : 成功，返回 0；没有可用的 cookie，返回 ENOTCONN；缓存不足，返回 ENOBUFS。
+ */
+x_int32_t ntpnts_seal(
+                xntp_ntsptr_t xnts_this,
+                xntp_ntsreq_t * xnts_req,
+                x_uchar_t * xbt_pack,
+                x_uint32_t xut_pmax,
+                x_uint32_t * xut_plen);
+
+/**********************************************************/
+/**
+ * @brief 校验 NTS 应答（Unique Identifier 与 NTS Authenticator），并收取 应答中 加密携带的 新 cookie。
+ * @note
+ * 收到 Unique Identifier 相符的 NTS NAK（kiss code 为 “NTSN”）时，清空 cookie 缓存，
+ * 下次请求 将重新握手。
+ *
+ * @param [in ] xnts_this : NTS 会话。
+ * @param [in ] xnts_req  : 请求的 上下文。
+ * @param [in ] xbt_data  : 应答报文。
+ * @param [in ] xut_dlen  : 应答报文长度。
+ *
+ * @return x_int32_t : 校验通过，返回 0；否则返回 EACCES。
+ */
+x_int32_t ntpnts_open(
+                xntp_ntsptr_t xnts_this,
+                const xntp_ntsreq_t * xnts_req,
+                const x_uchar_t * xbt_data,
+                x_uint32_t xut_dlen);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+#endif // __NTP_NTS_H__
@@ -0,0 +1,525 @@
+﻿/**
+ * @file ntp_packet.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 报文（网络字节序的原始缓存）的 零拷贝 访问视图 与 请求模板。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_PACKET_H__
+#define __NTP_PACKET_H__
+
+#include "xtime.h"
+
+#include <string.h>
+#include <errno.h>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif // defined(_MSC_VER)
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * 本文件只供库的内部实现使用：
+ * 报文始终以 网络字节序 的原始缓存形式存在，访问接口 只解码 所访问到的字段，
+ * 不再对整个报文 做 拷贝 与 字节序转换。
+ */
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 报文布局
+// 
+
+/** NTP 报文头部（不含 扩展字段 与 MAC）的 字节数 */
+#define XNTP_PKT_LEN        48
+
+/** 可接收的 NTP 报文 的 最大字节数（单个以太网帧 可承载的 UDP 负载） */
+#define XNTP_PKT_MAX        1472
+
+/** 扩展字段 的 最小字节数（RFC 7822，含 4 字节的 类型与长度） */
+#define XNTP_EXT_MIN        16
+
+/** MAC 的 最大字节数（4 字节的 key ID + 20 字节的 SHA1 摘要） */
+#define XNTP_MAC_MAX        24
+
+/** MAC 中 key ID 的 字节数（只有 key ID 的 MAC 为 crypto-NAK） */
+#define XNTP_MAC_KEYID      4
+
+#define XNTP_OFF_LVM        0   ///< 2 bits，飞跃指示器；3 bits，版本号；3 bits，NTP工作模式（参看 xntp_mode_t 相关枚举值）
+#define XNTP_OFF_STRATUM    1   ///< 系统时钟的层数（1 ~ 16，16 表示未同步）
+#define XNTP_OFF_POLL       2   ///< 轮询时间，即两个连续NTP报文之间的时间间隔（log2 秒）
+#define XNTP_OFF_PRECISION  3   ///< 系统时钟的精度（log2 秒）
+#define XNTP_OFF_ROOTDELAY  4   ///< 本地到主参考时钟源的往返时间（16.16 定点数）
+#define XNTP_OFF_ROOTDISP   8   ///< 系统时钟相对于主参考时钟的最大误差（16.16 定点数）
+#define XNTP_OFF_REFID      12  ///< 参考时钟源的标识
+/**
+ * T1，客户端发送请求时的 本地系统时间戳；
+ * T2，服务端接收到客户端请求时的 本地系统时间戳；
+ * T3，服务端发送应答数据包时的 本地系统时间戳；
+ * T4，客户端接收到服务端应答数据包时的 本地系统时间戳。
+ */
+#define XNTP_OFF_REFERENCE  16  ///< 系统时钟最后一次被设定或更新的时间
+#define XNTP_OFF_ORIGINATE  24  ///< 服务端应答时，将客户端请求时的 T1 返送回去
+#define XNTP_OFF_RECEIVE    32  ///< 服务端接收到客户端请求时的 本地系统时间戳 T2
+#define XNTP_OFF_TRANSMIT   40  ///< 客户端请求时 发送 T1，服务端应答时 回复 T3
+
+/**
+ * @enum  xntp_mode_t
+ * @brief NTP工作模式的相关枚举值。
+ */
+typedef enum xntp_mode_t
+{
+    ntp_mode_unknow     = 0,  ///< 未定义
+    ntp_mode_initiative = 1,  ///< 主动对等体模式
+    ntp_mode_passive    = 2,  ///< 被动对等体模式
+    ntp_mode_client     = 3,  ///< 客户端模式
+    ntp_mode_server     = 4,  ///< 服务器模式
+    ntp_mode_broadcast  = 5,  ///< 广播模式或组播模式
+    ntp_mode_control    = 6,  ///< 报文为 NTP 控制报文
+    ntp_mode_reserved   = 7,  ///< 预留给内部使用
+} xntp_mode_t;
+
+/** 组合 飞跃指示器、版本号、工作模式 字段 */
+#define XNTP_LI_VN_MODE(l, v, m) ((x_uchar_t)((((l) & 3) << 6) | (((v) & 7) << 3) | ((m) & 7)))
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 大端序 的 读写（编译为 bswap/movbe，不做逐字节拼接）
+// 
+
+#if defined(_MSC_VER)
+#define XNTP_BSWAP32(x)     _byteswap_ulong(x)
+#define XNTP_BSWAP64(x)     _byteswap_uint64(x)
+#define XNTP_LITTLE_ENDIAN  1
+#else // !defined(_MSC_VER)
+#define XNTP_BSWAP32(x)     __builtin_bswap32(x)
+#define XNTP_BSWAP64(x)     __builtin_bswap64(x)
+#define XNTP_LITTLE_ENDIAN  (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#endif // defined(_MSC_VER)
+
+/**********************************************************/
+/**
+ * @brief 从（可能未对齐的）缓存中 读取 大端序 的 32 位整数。
+ */
+static inline x_uint32_t ntp_load32(const x_uchar_t * xbt_mptr)
+{
+    x_uint32_t xut_value;
+    memcpy(&xut_value, xbt_mptr, sizeof(x_uint32_t));
+#if XNTP_LITTLE_ENDIAN
+    xut_value = XNTP_BSWAP32(xut_value);
+#endif // XNTP_LITTLE_ENDIAN
+    return xut_value;
+}
+
+/**********************************************************/
+/**
+ * @brief 从（可能未对齐的）缓存中 读取 大端序 的 64 位整数。
+ */
+static inline x_uint64_t ntp_load64(const x_uchar_t * xbt_mptr)
+{
+    x_uint64_t xut_value;
+    memcpy(&xut_value, xbt_mptr, sizeof(x_uint64_t));
+#if XNTP_LITTLE_ENDIAN
+    xut_value = XNTP_BSWAP64(xut_value);
+#endif // XNTP_LITTLE_ENDIAN
+    return xut_value;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 大端序 向（可能未对齐的）缓存中 写入 32 位整数。
+ */
+static inline x_void_t ntp_store32(x_uchar_t * xbt_mptr, x_uint32_t xut_value)
+{
+#if XNTP_LITTLE_ENDIAN
+    xut_value = XNTP_BSWAP32(xut_value);
+#endif // XNTP_LITTLE_ENDIAN
+    memcpy(xbt_mptr, &xut_value, sizeof(x_uint32_t));
+}
+
+/**********************************************************/
+/**
+ * @brief 以 大端序 向（可能未对齐的）缓存中 写入 64 位整数。
+ */
+static inline x_void_t ntp_store64(x_uchar_t * xbt_mptr, x_uint64_t xut_value)
+{
+#if XNTP_LITTLE_ENDIAN
+    xut_value = XNTP_BSWAP64(xut_value);
+#endif // XNTP_LITTLE_ENDIAN
+    memcpy(xbt_mptr, &xut_value, sizeof(x_uint64_t));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// NTP 时间戳（高 32 位为 纪元内的秒数（纪元 0 自 1900 年起），低 32 位为 秒的小数部分）
+// 
+
+/**
+ * 1900-01-01 00:00:00 ~ 1970-01-01 00:00:00 之间的时间 秒数。
+ * Time of day conversion constant.  Ntp's time scale starts in 1900,
+ * Unix in 1970.  The value is 1970 - 1900 in seconds, 0x83aa7e80 or
+ * 2208988800.  This is larger than 32-bit INT_MAX, so unsigned
+ * type is forced.
+ */
+#define XTIME_SEC_1900_1970 0x83AA7E80
+
+/** 百纳秒 的进位基数 10^7 */
+#define XTIME_100NS_BASE    10000000ULL
+
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 转为 NTP 时间戳。
+ */
+static inline x_uint64_t ntp_stamp_from_vnsec(xtime_vnsec_t xtm_vnsec)
+{
+    x_uint64_t xut_seconds  = (x_uint32_t)((xtm_vnsec / XTIME_100NS_BASE) + XTIME_SEC_1900_1970);
+    x_uint64_t xut_fraction = (x_uint32_t)(((xtm_vnsec % XTIME_100NS_BASE) << 32) / XTIME_100NS_BASE);
+
+    return (xut_seconds << 32) | xut_fraction;
+}
+
+/**
+ * NTP 时间戳 的 秒数 只有 32 位，每 2^32 秒（约 136 年）为一个 纪元（era）：
+ * 纪元 0 始于 1900-01-01 00:00:00，纪元 1 始于 2036-02-07 06:28:16 UTC。
+ * 报文中 不携带 纪元号，转换时 以 本地时间 为参照（pivot），取 与之相距 不足 2^31 秒（约 68 年）的 纪元；
+ * 参照 以 “带纪元的 NTP 秒数”（高 32 位 为 纪元号，低 32 位 为 纪元内的秒数）表示，
+ * 由 ntp_era_seconds() 求得，同一报文的 多个时间戳 可共用，热点路径上 只多一次 32 位减法 与 符号扩展。
+ */
+
+/** 带纪元的 NTP 秒数 的 纪元号 */
+#define XNTP_ERA(xut_esec)  ((x_uint32_t)((xut_esec) >> 32))
+
+/**********************************************************/
+/**
+ * @brief 求取 时间计量值 对应的 带纪元的 NTP 秒数（用作 ntp_stamp_to_vnsec() 的 参照）。
+ */
+static inline x_uint64_t ntp_era_seconds(xtime_vnsec_t xtm_vnsec)
+{
+    return (xtm_vnsec / XTIME_100NS_BASE) + XTIME_SEC_1900_1970;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 NTP 时间戳 转为 时间计量值（以 xut_pivot 为参照 确定纪元）。
+ * @note
+ * 结果的 秒数 落在 [xut_pivot - 2^31, xut_pivot + 2^31 - 1] 之内；
+ * 时间戳 为 0（未设置），或 结果 不晚于 1970-01-01 00:00:00 时，返回 XTIME_INVALID_VNSEC。
+ *
+ * @param [in ] xut_stamp : NTP 时间戳。
+ * @param [in ] xut_pivot : 参照时间 的 带纪元的 NTP 秒数（参看 ntp_era_seconds()）。
+ */
+static inline xtime_vnsec_t ntp_stamp_to_vnsec(x_uint64_t xut_stamp, x_uint64_t xut_pivot)
+{
+    x_uint64_t xut_seconds  = xut_pivot + (x_uint64_t)(x_int64_t)(x_int32_t)
+                                  ((x_uint32_t)(xut_stamp >> 32) - (x_uint32_t)xut_pivot);
+    x_uint64_t xut_fraction = xut_stamp & 0xFFFFFFFFULL;
+    xtime_vnsec_t xtm_vnsec = ((xut_seconds - XTIME_SEC_1900_1970) * XTIME_100NS_BASE) +
+                              ((xut_fraction * XTIME_100NS_BASE) >> 32);
+
+    return ((xut_seconds <= XTIME_SEC_1900_1970) || (0 == xut_stamp)) ? XTIME_INVALID_VNSEC : xtm_vnsec;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 NTP 时间戳 转为 时间计量值（指定 纪元号）。
+ */
+static inline xtime_vnsec_t ntp_stamp_to_vnsec_era(x_uint64_t xut_stamp, x_uint32_t xut_era)
+{
+    return ntp_stamp_to_vnsec(xut_stamp, ((x_uint64_t)xut_era << 32) | (xut_stamp >> 32));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 只读视图
+// 
+
+/**
+ * @struct xntp_view_t
+ * @brief  接收到的 NTP 报文 的 只读视图（直接引用 接收缓存，不做拷贝）。
+ * @note
+ * 报文布局为：48 字节的头部 + 若干 扩展字段（可无）+ MAC（可无）。
+ * 视图建立时 已校验 各扩展字段 的边界，并定位出 MAC 的位置。
+ */
+typedef struct xntp_view_t
+{
+    const x_uchar_t * xbt_data;  ///< 报文数据（网络字节序）
+    x_uint32_t        xut_size;  ///< 报文长度
+    x_uint32_t        xut_mpos;  ///< MAC 的偏移位置（即 扩展字段区 的结束位置；无 MAC 时 等于 xut_size）
+} xntp_view_t;
+
+/**
+ * @struct xntp_ext_t
+ * @brief  NTP 报文中的 一个扩展字段（值数据 直接引用 接收缓存）。
+ */
+typedef struct xntp_ext_t
+{
+    x_uint16_t        xut_type;  ///< 字段类型
+    x_uint16_t        xut_size;  ///< 字段总长度（含 4 字节的 类型与长度）
+    const x_uchar_t * xbt_value; ///< 字段值
+    x_uint32_t        xut_vlen;  ///< 字段值的 字节数（xut_size - 4）
+} xntp_ext_t;
+
+/**********************************************************/
+/**
+ * @brief 在 接收缓存 上建立 报文视图，并校验 扩展字段 与 MAC 的布局。
+ * @note
+ * 按 RFC 7822 的规则 区分 扩展字段 与 MAC：剩余长度 不超过 XNTP_MAC_MAX 时，
+ * 剩余部分为 MAC（只能是 4、20 或 24 字节），否则 为扩展字段
+ * （长度 为 4 的倍数，不小于 XNTP_EXT_MIN，且 不越过报文末尾）。
+ * 整个过程只读取 各扩展字段的 长度值，不做任何内存分配。
+ *
+ * @param [out] xview_ptr : 所建立的 报文视图。
+ * @param [in ] xbt_data  : 报文数据（网络字节序）。
+ * @param [in ] xit_dlen  : 报文长度（可大于 实际的缓存长度，此时 以 EMSGSIZE 拒绝，不访问数据）。
+ *
+ * @return x_int32_t : 
+ * 成功，返回 0；报文不足 48 字节，返回 ENODATA；
+ * 超过 XNTP_PKT_MAX，返回 EMSGSIZE；扩展字段 或 MAC 的布局无效，返回 EBADMSG。
+ */
+static inline x_int32_t ntpv_init(xntp_view_t * xview_ptr, const x_uchar_t * xbt_data, x_int32_t xit_dlen)
+{
+    x_uint32_t xut_offs = XNTP_PKT_LEN;
+    x_uint32_t xut_left = 0;
+    x_uint32_t xut_elen = 0;
+
+    xview_ptr->xbt_data = xbt_data;
+    xview_ptr->xut_size = 0;
+    xview_ptr->xut_mpos = 0;
+
+    if (xit_dlen < XNTP_PKT_LEN)
+        return ENODATA;
+    if (xit_dlen > XNTP_PKT_MAX)
+        return EMSGSIZE;
+
+    xview_ptr->xut_size = (x_uint32_t)xit_dlen;
+    xview_ptr->xut_mpos = (x_uint32_t)xit_dlen;
+
+    while (xut_offs < xview_ptr->xut_size)
+    {
+        xut_left = xview_ptr->xut_size - xut_offs;
+
+        if (xut_left <= XNTP_MAC_MAX)
+        {
+            if ((XNTP_MAC_KEYID != xut_left) && (20 != xut_left) && (24 != xut_left))
+                return EBADMSG;
+
+            xview_ptr->xut_mpos = xut_offs;
+            break;
+        }
+
+        xut_elen = ntp_load32(xbt_data + xut_offs) & 0x0000FFFF;
+        if ((xut_elen < XNTP_EXT_MIN) || (0 != (xut_elen & 3)) || (xut_elen > xut_left))
+            return EBADMSG;
+
+        xut_offs += xut_elen;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 依次遍历 报文视图 中的 扩展字段。
+ *
+ * @param [in    ] xview_ptr : 已成功建立的 报文视图。
+ * @param [in,out] xut_iter  : 遍历位置（首次调用前 置 0）。
+ * @param [out   ] xext_ptr  : 返回的 扩展字段。
+ *
+ * @return x_bool_t : 取到扩展字段，返回 X_TRUE；已遍历完，返回 X_FALSE。
+ */
+static inline x_bool_t ntpv_ext_next(const xntp_view_t * xview_ptr, x_uint32_t * xut_iter, xntp_ext_t * xext_ptr)
+{
+    x_uint32_t xut_head = 0;
+
+    if (*xut_iter < XNTP_PKT_LEN)
+        *xut_iter = XNTP_PKT_LEN;
+    if (*xut_iter >= xview_ptr->xut_mpos)
+        return X_FALSE;
+
+    xut_head = ntp_load32(xview_ptr->xbt_data + *xut_iter);
+    xext_ptr->xut_type  = (x_uint16_t)(xut_head >> 16);
+    xext_ptr->xut_size  = (x_uint16_t)(xut_head & 0x0000FFFF);
+    xext_ptr->xbt_value = xview_ptr->xbt_data + *xut_iter + 4;
+    xext_ptr->xut_vlen  = xext_ptr->xut_size - 4;
+
+    *xut_iter += xext_ptr->xut_size;
+
+    return X_TRUE;
+}
+
+/** 报文是否携带 MAC（含 crypto-NAK） */
+static inline x_bool_t ntpv_has_mac(const xntp_view_t * xview_ptr)
+{
+    return (xview_ptr->xut_mpos < xview_ptr->xut_size) ? X_TRUE : X_FALSE;
+}
+
+/** MAC 的 key ID（无 MAC 时，返回 0） */
+static inline x_uint32_t ntpv_keyid(const xntp_view_t * xview_ptr)
+{
+    return ntpv_has_mac(xview_ptr) ? ntp_load32(xview_ptr->xbt_data + xview_ptr->xut_mpos) : 0;
+}
+
+/** MAC 的 摘要数据 */
+static inline const x_uchar_t * ntpv_digest(const xntp_view_t * xview_ptr)
+{
+    return xview_ptr->xbt_data + xview_ptr->xut_mpos + XNTP_MAC_KEYID;
+}
+
+/** MAC 的 摘要字节数（无 MAC 或 为 crypto-NAK 时，返回 0） */
+static inline x_uint32_t ntpv_digest_len(const xntp_view_t * xview_ptr)
+{
+    return ntpv_has_mac(xview_ptr) ? (xview_ptr->xut_size - xview_ptr->xut_mpos - XNTP_MAC_KEYID) : 0;
+}
+
+/** 飞跃指示器 */
+static inline x_uint32_t ntpv_leap(const xntp_view_t * xview_ptr)
+{
+    return (xview_ptr->xbt_data[XNTP_OFF_LVM] >> 6) & 3;
+}
+
+/** 版本号 */
+static inline x_uint32_t ntpv_version(const xntp_view_t * xview_ptr)
+{
+    return (xview_ptr->xbt_data[XNTP_OFF_LVM] >> 3) & 7;
+}
+
+/** 工作模式（参看 xntp_mode_t 相关枚举值） */
+static inline x_uint32_t ntpv_mode(const xntp_view_t * xview_ptr)
+{
+    return xview_ptr->xbt_data[XNTP_OFF_LVM] & 7;
+}
+
+/** 系统时钟的层数 */
+static inline x_uint32_t ntpv_stratum(const xntp_view_t * xview_ptr)
+{
+    return xview_ptr->xbt_data[XNTP_OFF_STRATUM];
+}
+
+/** 轮询时间（log2 秒） */
+static inline x_int32_t ntpv_poll(const xntp_view_t * xview_ptr)
+{
+    return (x_int32_t)(signed char)xview_ptr->xbt_data[XNTP_OFF_POLL];
+}
+
+/** 系统时钟的精度（log2 秒） */
+static inline x_int32_t ntpv_precision(const xntp_view_t * xview_ptr)
+{
+    return (x_int32_t)(signed char)xview_ptr->xbt_data[XNTP_OFF_PRECISION];
+}
+
+/** 根延迟（16.16 定点数，单位为 秒） */
+static inline x_uint32_t ntpv_rootdelay(const xntp_view_t * xview_ptr)
+{
+    return ntp_load32(xview_ptr->xbt_data + XNTP_OFF_ROOTDELAY);
+}
+
+/** 根离散度（16.16 定点数，单位为 秒） */
+static inline x_uint32_t ntpv_rootdisp(const xntp_view_t * xview_ptr)
+{
+    return ntp_load32(xview_ptr->xbt_data + XNTP_OFF_ROOTDISP);
+}
+
+/** 参考时钟源的标识 */
+static inline x_uint32_t ntpv_refid(const xntp_view_t * xview_ptr)
+{
+    return ntp_load32(xview_ptr->xbt_data + XNTP_OFF_REFID);
+}
+
+/** 参考时间戳 */
+static inline x_uint64_t ntpv_reference(const xntp_view_t * xview_ptr)
+{
+    return ntp_load64(xview_ptr->xbt_data + XNTP_OFF_REFERENCE);
+}
+
+/** 原始时间戳（应答中 为 请求的 T1） */
+static inline x_uint64_t ntpv_originate(const xntp_view_t * xview_ptr)
+{
+    return ntp_load64(xview_ptr->xbt_data + XNTP_OFF_ORIGINATE);
+}
+
+/** 接收时间戳（T2） */
+static inline x_uint64_t ntpv_receive(const xntp_view_t * xview_ptr)
+{
+    return ntp_load64(xview_ptr->xbt_data + XNTP_OFF_RECEIVE);
+}
+
+/** 发送时间戳（应答中 为 T3） */
+static inline x_uint64_t ntpv_transmit(const xntp_view_t * xview_ptr)
+{
+    return ntp_load64(xview_ptr->xbt_data + XNTP_OFF_TRANSMIT);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 请求模板
+// 
+
+/**
+ * 客户端请求报文 的 预构建模板（网络字节序）：
+ * LI = 0，VN = 3，Mode = 3（客户端），Poll = 4，Precision = -6，
+ * Root Delay = Root Dispersion = 1.0 秒，其余字段为 0；
+ * 构建请求时，只需 拷贝模板，再写入 8 字节的 发送时间戳（T1）。
+ */
+static const x_uchar_t XNTP_REQ_TEMPLATE[XNTP_PKT_LEN] =
+{
+    XNTP_LI_VN_MODE(0, 3, ntp_mode_client), 0x00, 0x04, 0xFA,
+    0x00, 0x01, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+/**********************************************************/
+/**
+ * @brief 以 请求模板 初始化 请求报文缓存（同一缓存 重复发送时，只需初始化一次）。
+ */
+static inline x_void_t ntp_req_init(x_uchar_t * xbt_pack)
+{
+    memcpy(xbt_pack, XNTP_REQ_TEMPLATE, XNTP_PKT_LEN);
+}
+
+/**********************************************************/
+/**
+ * @brief 向 已初始化的 请求报文缓存 写入 发送时间戳（T1）。
+ */
+static inline x_void_t ntp_req_stamp(x_uchar_t * xbt_pack, xtime_vnsec_t xtm_T1)
+{
+    ntp_store64(xbt_pack + XNTP_OFF_TRANSMIT, ntp_stamp_from_vnsec(xtm_T1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_PACKET_H__
@@ -0,0 +1,274 @@
+﻿/**
+ * @file ntp_peer.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 对称模式（主动/被动 对等体）的 关联状态机。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_peer.h"
+
+#include <string.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 内部数据类型
+// 
+
+/** 本端 通告的 时钟精度（log2 秒，约 1 微秒） */
+#define XASC_PRECISION      (-20)
+
+/** 本端 通告的 轮询间隔 的 默认值（log2 秒） */
+#define XASC_POLL_DEF       6
+
+/** 未同步 的 层数 */
+#define XASC_STRATUM_UNSYNC 16
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 外部接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 初始化 关联。
+ *
+ * @param [out] xasc_ptr    : 关联。
+ * @param [in ] xut_hmode   : 本端 模式（ntp_mode_initiative 或 ntp_mode_passive）。
+ * @param [in ] xut_stratum : 本端 通告的 层数（取 0 时 为 16，即 未同步）。
+ * @param [in ] xut_keyid   : 认证 所用的 key ID（0 表示 不认证）。
+ *
+ * @return x_int32_t : 成功，返回 0；参数无效，返回 EINVAL。
+ */
+x_int32_t ntpasc_init(
+                xntp_assoc_t * xasc_ptr,
+                x_uint32_t xut_hmode,
+                x_uint32_t xut_stratum,
+                x_uint32_t xut_keyid)
+{
+    if ((X_NULL == xasc_ptr) ||
+        ((ntp_mode_initiative != xut_hmode) && (ntp_mode_passive != xut_hmode)) ||
+        (xut_stratum > XASC_STRATUM_UNSYNC))
+    {
+        return EINVAL;
+    }
+
+    memset(xasc_ptr, 0, sizeof(xntp_assoc_t));
+    xasc_ptr->xut_hmode   = xut_hmode;
+    xasc_ptr->xut_stratum = (0 != xut_stratum) ? xut_stratum : XASC_STRATUM_UNSYNC;
+    xasc_ptr->xit_poll    = XASC_POLL_DEF;
+    xasc_ptr->xut_keyid   = xut_keyid;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 构建 发往 对等体 的 下一个报文，并 记录 其 发送时间戳（T1）。
+ * @note
+ * 报文 应在 构建之后 立即发出；发送时间戳 严格递增，可供 对端 剔除 重复报文。
+ *
+ * @param [in,out] xasc_ptr   : 关联。
+ * @param [in    ] xkey_table : 密钥表（不认证时 可为 X_NULL）。
+ * @param [out   ] xbt_pack   : 报文缓存（不少于 XNTP_ASSOC_PKT_MAX 字节）。
+ * @param [out   ] xut_plen   : 返回 报文长度。
+ *
+ * @return x_int32_t : 成功，返回 0；key ID 不存在，返回 ENOENT；其他失败，返回 错误码。
+ */
+x_int32_t ntpasc_build(
+                xntp_assoc_t * xasc_ptr,
+                xntp_keyptr_t xkey_table,
+                x_uchar_t * xbt_pack,
+                x_uint32_t * xut_plen)
+{
+    x_int32_t     xit_errno = 0;
+    x_uint32_t    xut_mlen  = 0;
+    x_uint64_t    xut_xmt   = 0;
+    xtime_vnsec_t xtm_T1    = 0;
+
+    if ((X_NULL == xasc_ptr) || (X_NULL == xbt_pack) || (X_NULL == xut_plen))
+    {
+        return EINVAL;
+    }
+
+    memset(xbt_pack, 0, XNTP_PKT_LEN);
+    xbt_pack[XNTP_OFF_LVM      ] = XNTP_LI_VN_MODE(
+                                        (XASC_STRATUM_UNSYNC == xasc_ptr->xut_stratum) ? 3 : 0,
+                                        4,
+                                        xasc_ptr->xut_hmode);
+    xbt_pack[XNTP_OFF_STRATUM  ] = (x_uchar_t)xasc_ptr->xut_stratum;
+    xbt_pack[XNTP_OFF_POLL     ] = (x_uchar_t)xasc_ptr->xit_poll;
+    xbt_pack[XNTP_OFF_PRECISION] = (x_uchar_t)XASC_PRECISION;
+
+    // 回送 对端 上一个报文 的 发送时间戳，以及 收到它的 本地时间
+    ntp_store64(xbt_pack + XNTP_OFF_ORIGINATE, xasc_ptr->xut_org);
+    ntp_store64(xbt_pack + XNTP_OFF_RECEIVE  , xasc_ptr->xut_rec);
+
+    // 时钟分辨率 不足 或 时钟回拨 时，仍保证 发送时间戳 严格递增
+    xtm_T1  = time_vnsec();
+    xut_xmt = ntp_stamp_from_vnsec(xtm_T1);
+    if ((0 != xasc_ptr->xut_xmt) && (xut_xmt <= xasc_ptr->xut_xmt))
+    {
+        xut_xmt = xasc_ptr->xut_xmt + 1;
+    }
+
+    ntp_store64(xbt_pack + XNTP_OFF_TRANSMIT, xut_xmt);
+
+    *xut_plen = XNTP_PKT_LEN;
+    if (0 != xasc_ptr->xut_keyid)
+    {
+        xit_errno = ntpkey_sign(xkey_table, xasc_ptr->xut_keyid, xbt_pack, XNTP_PKT_LEN, &xut_mlen);
+        if (0 != xit_errno)
+        {
+            return xit_errno;
+        }
+
+        *xut_plen += xut_mlen;
+    }
+
+    xasc_ptr->xut_xmt   = xut_xmt;
+    xasc_ptr->xtm_xmt   = xtm_T1;
+    xasc_ptr->xut_reach = (xasc_ptr->xut_reach << 1) & 0xFF;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 处理 对等体 发来的 报文。
+ * @note
+ * 按 RFC 5905 的 检查顺序：
+ * 模式、版本 或 认证 不符 的报文 直接丢弃；发送时间戳 与 上一个报文 相同 的 为 重复报文，亦丢弃；
+ * 其余报文 均更新 originate/receive 记录，但 originate 为 0（对端 尚未收到 本端报文）
+ * 或 与 本端 上一个报文 的 发送时间戳 不同（过期 或 伪造）时，不产生样本。
+ *
+ * @param [in,out] xasc_ptr   : 关联。
+ * @param [in    ] xkey_table : 密钥表（不认证时 可为 X_NULL）。
+ * @param [in    ] xview_ptr  : 报文视图。
+ * @param [in    ] xtm_T4     : 报文的 接收时间（T4）。
+ * @param [out   ] xtm_4time  : 得到样本 时，返回 T1、T2、T3、T4。
+ *
+ * @return x_int32_t :
+ * 得到样本，返回 0；模式 或 版本 不符，返回 EBADMSG；认证失败，返回 EACCES；
+ * 重复报文，返回 EALREADY；尚未同步（originate 为 0），返回 EAGAIN；originate 不符，返回 EPROTO。
+ */
+x_int32_t ntpasc_recv(
+                xntp_assoc_t * xasc_ptr,
+                xntp_keyptr_t xkey_table,
+                const xntp_view_t * xview_ptr,
+                xtime_vnsec_t xtm_T4,
+                xtime_vnsec_t xtm_4time[4])
+{
+    x_uint32_t    xut_pmode = 0;
+    x_uint64_t    xut_porg  = 0;
+    x_uint64_t    xut_prec  = 0;
+    x_uint64_t    xut_pxmt  = 0;
+    x_uint64_t    xut_pivot = 0;
+    xtime_vnsec_t xtm_T2    = 0;
+    xtime_vnsec_t xtm_T3    = 0;
+
+    if ((X_NULL == xasc_ptr) || (X_NULL == xview_ptr) || (X_NULL == xtm_4time))
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 模式、版本 与 认证
+
+    xut_pmode = ntpv_mode(xview_ptr);
+    xut_pxmt  = ntpv_transmit(xview_ptr);
+
+    // 被动对等体 之间 不能 相互关联
+    if (((ntp_mode_initiative != xut_pmode) && (ntp_mode_passive != xut_pmode)) ||
+        ((ntp_mode_passive == xut_pmode) && (ntp_mode_passive == xasc_ptr->xut_hmode)) ||
+        (ntpv_version(xview_ptr) < 3) || (ntpv_version(xview_ptr) > 4) ||
+        (0 == xut_pxmt))
+    {
+        return EBADMSG;
+    }
+
+    if (0 != xasc_ptr->xut_keyid)
+    {
+        if (!ntpv_has_mac(xview_ptr) ||
+            (xasc_ptr->xut_keyid != ntpv_keyid(xview_ptr)) ||
+            (0 != ntpkey_verify(xkey_table,
+                                xasc_ptr->xut_keyid,
+                                xview_ptr->xbt_data,
+                                xview_ptr->xut_mpos,
+                                ntpv_digest(xview_ptr),
+                                ntpv_digest_len(xview_ptr))))
+        {
+            return EACCES;
+        }
+    }
+
+    if (xut_pxmt == xasc_ptr->xut_org)
+    {
+        return EALREADY;
+    }
+
+    //======================================
+    // 更新 originate/receive 记录（即使 不产生样本，下一个报文 也须回送 本报文 的 时间戳）
+
+    xut_porg = ntpv_originate(xview_ptr);
+    xut_prec = ntpv_receive(xview_ptr);
+
+    xasc_ptr->xut_org      = xut_pxmt;
+    xasc_ptr->xut_rec      = ntp_stamp_from_vnsec(xtm_T4);
+    xasc_ptr->xut_pmode    = xut_pmode;
+    xasc_ptr->xut_pstratum = ntpv_stratum(xview_ptr);
+
+    if (0 == xut_porg)
+    {
+        return EAGAIN;
+    }
+
+    xut_pivot = ntp_era_seconds(xtm_T4);
+    xtm_T2    = ntp_stamp_to_vnsec(xut_prec, xut_pivot);
+    xtm_T3    = ntp_stamp_to_vnsec(xut_pxmt, xut_pivot);
+    if ((0 == xasc_ptr->xut_xmt) || (xut_porg != xasc_ptr->xut_xmt) ||
+        !XTMVNSEC_IS_VALID(xtm_T2) || !XTMVNSEC_IS_VALID(xtm_T3))
+    {
+        return EPROTO;
+    }
+
+    //======================================
+
+    xtm_4time[0] = xasc_ptr->xtm_xmt;
+    xtm_4time[1] = xtm_T2;
+    xtm_4time[2] = xtm_T3;
+    xtm_4time[3] = xtm_T4;
+
+    xasc_ptr->xut_reach |= 1;
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,154 @@
+﻿/**
+ * @file ntp_peer.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 对称模式（主动/被动 对等体）的 关联状态机。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_PEER_H__
+#define __NTP_PEER_H__
+
+#include "ntp_packet.h"
+#include "ntp_auth.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * 对称模式 下，两个节点 互为 对等体，各自 周期性地 发出报文，同时 也从 对方的报文 中 获得样本：
+ * 每个报文 的 originate 字段 回送 对方 上一个报文 的 发送时间戳，
+ * receive 字段 填写 收到 该报文 的 本地时间，transmit 字段 为 本报文 的 发送时间。
+ * 收到的报文 若 originate 与 本端 上一个报文 的 发送时间戳 相同，即得到
+ * T1（本端发送）、T2（对端接收）、T3（对端发送）、T4（本端接收）四个时间戳。
+ *
+ * 本文件 只维护 单个关联 的 时间戳记录 与 报文检查（RFC 5905 的 peer process），
+ * 不涉及 套接字；收发 与 定时 由 调用者（如 NTP 轮询器）驱动。
+ */
+
+/** 对称模式 报文 的 最大字节数（头部 + MAC） */
+#define XNTP_ASSOC_PKT_MAX  (XNTP_PKT_LEN + 4 + XNTP_AUTH_DIGEST_MAX)
+
+/**
+ * @struct xntp_assoc_t
+ * @brief  对称模式 的 关联（与 某个对等体 之间的 时间戳记录）。
+ */
+typedef struct xntp_assoc_t
+{
+    x_uint32_t    xut_hmode;    ///< 本端 模式（ntp_mode_initiative 或 ntp_mode_passive）
+    x_uint32_t    xut_stratum;  ///< 本端 通告的 层数（1 ~ 16，16 表示 未同步）
+    x_int32_t     xit_poll;     ///< 本端 通告的 轮询间隔（log2 秒）
+    x_uint32_t    xut_keyid;    ///< 认证 所用的 key ID（0 表示 不认证）
+
+    x_uint64_t    xut_org;      ///< 对端 最近一个报文 的 发送时间戳（本端 下一个报文 的 originate）
+    x_uint64_t    xut_rec;      ///< 收到 该报文 的 本地时间戳（本端 下一个报文 的 receive）
+    x_uint64_t    xut_xmt;      ///< 本端 最近一个报文 的 发送时间戳（对端报文 的 originate 须与之相同）
+    xtime_vnsec_t xtm_xmt;      ///< 本端 最近一个报文 的 发送时间（T1）
+
+    x_uint32_t    xut_reach;    ///< 可达寄存器（每发出一个报文 左移一位，得到样本 时 置最低位）
+    x_uint32_t    xut_pmode;    ///< 对端 最近一个报文 的 模式
+    x_uint32_t    xut_pstratum; ///< 对端 最近一个报文 的 层数
+} xntp_assoc_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 初始化 关联。
+ *
+ * @param [out] xasc_ptr    : 关联。
+ * @param [in ] xut_hmode   : 本端 模式（ntp_mode_initiative 或 ntp_mode_passive）。
+ * @param [in ] xut_stratum : 本端 通告的 层数（取 0 时 为 16，即 未同步）。
+ * @param [in ] xut_keyid   : 认证 所用的 key ID（0 表示 不认证）。
+ *
+ * @return x_int32_t : 成功，返回 0；参数无效，返回 EINVAL。
+ */
+x_int32_t ntpasc_init(
+                xntp_assoc_t * xasc_ptr,
+                x_uint32_t xut_hmode,
+                x_uint32_t xut_stratum,
+                x_uint32_t xut_keyid);
+
+/**********************************************************/
+/**
+ * @brief 构建 发往 对等体 的 下一个报文，并 记录 其 发送时间戳（T1）。
+ * @note
+ * 报文 应在 构建之后 立即发出；发送时间戳 严格递增，可供 对端 剔除 重复报文。
+ *
+ * @param [in,out] xasc_ptr   : 关联。
+ * @param [in    ] xkey_table : 密钥表（不认证时 可为 X_NULL）。
+ * @param [out   ] xbt_pack   : 报文缓存（不少于 XNTP_ASSOC_PKT_MAX 字节）。
+ * @param [out   ] xut_plen   : 返回 报文长度。
+ *
+ * @return x_int32_t : 成功，返回 0；key ID 不存在，返回 ENOENT；其他失败，返回 错误码。
+ */
+x_int32_t ntpasc_build(
+                xntp_assoc_t * xasc_ptr,
+                xntp_keyptr_t xkey_table,
+                x_uchar_t * xbt_pack,
+                x_uint32_t * xut_plen);
+
+/**********************************************************/
+/**
+ * @brief 处理 对等体 发来的 报文。
+ * @note
+ * 按 RFC 5905 的 检查顺序：
+ * 模式、版本 或 认证 不符 的报文 直接丢弃；发送时间戳 与 上一个报文 相同 的 为 重复报文，亦丢弃；
+ * 其余报文 均更新 originate/receive 记录，但 originate 为 0（对端 尚未收到 本端报文）
+ * 或 与 本端 上一个报文 的 发送时间戳 不同（过期 或 伪造）时，不产生样本。
+ *
+ * @param [in,out] xasc_ptr   : 关联。
+ * @param [in    ] xkey_table : 密钥表（不认证时 可为 X_NULL）。
+ * @param [in    ] xview_ptr  : 报文视图。
+ * @param [in    ] xtm_T4     : 报文的 接收时间（T4）。
+ * @param [out   ] xtm_4time  : 得到样本 时，返回 T1、T2、T3、T4。
+ *
+ * @return x_int32_t :
+ * 得到样本，返回 0；模式 或 版本 不符，返回 EBADMSG；认证失败，返回 EACCES；
+ * 重复报文，返回 EALREADY；尚未同步（originate 为 0），返回 EAGAIN；originate 不符，返回 EPROTO。
+ */
+x_int32_t ntpasc_recv(
+                xntp_assoc_t * xasc_ptr,
+                xntp_keyptr_t xkey_table,
+                const xntp_view_t * xview_ptr,
+                xtime_vnsec_t xtm_T4,
+                xtime_vnsec_t xtm_4time[4]);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_PEER_H__
@@ -0,0 +1,1689 @@
+﻿/**
+ * @file ntp_poller.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 多核分片的 NTP 轮询器（大量服务端 的 周期性监测）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif // defined(__linux__) && !defined(_GNU_SOURCE)
+
+#include "ntp_poller.h"
+#include "xatomic.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if (defined(_WIN32) || defined(_WIN64))
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <windows.h>
+#elif (defined(__linux__) || defined(__unix__))
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 内部数据类型
+// 
+
+/** 单个分片 每轮最多轮询的 对端数量（一次批量请求） */
+#define XPOLL_BATCH         1024
+
+/** 分片空闲时，单次休眠的 最长时长（100 纳秒） */
+#define XPOLL_IDLE          (10 * XTIME_VNSEC_MSEC)
+
+/** 单次迁移的 最大对端数量 */
+#define XPOLL_STEAL_MAX     4096
+
+/** 对端尚未归属任何分片 */
+#define XPOLL_NO_OWNER      0xFFFFFFFF
+
+/** 对称模式 的 关联 所归属的 分片（持有 对称模式 的 套接字） */
+#define XPOLL_SYM_SHARD     0
+
+/** 每轮 最多处理的 对称模式 报文 数量（余下的 留待下一轮） */
+#define XPOLL_SYM_RECV      256
+
+/** 被动关联 沉默 超过 多少个 轮询周期 后 被撤销 */
+#define XPOLL_SYM_IDLE      8
+
+/**
+ * @struct xntp_symm_t
+ * @brief  对称模式 的 关联 在 轮询器中的 附加信息。
+ */
+typedef struct xntp_symm_t
+{
+    xntp_assoc_t  xassoc;      ///< 关联状态
+    x_bool_t      xbt_noted;   ///< 自 本端 上一个报文 发出以来，是否 已回调过 结果（样本 或 错误）
+    xtime_vnsec_t xtm_heard;   ///< 最近一次 收到 有效报文 的 时间（单调时钟）
+} xntp_symm_t;
+
+/**
+ * @struct xntp_peer_t
+ * @brief  被轮询的 对端（同一时刻只归属一个分片，只由该分片线程访问）。
+ */
+typedef struct xntp_peer_t
+{
+    struct xntp_peer_t * xpeer_next; ///< 分片收件栈 的 后继节点
+    x_uint32_t    xut_peer;          ///< 对端标识
+    x_uint32_t    xut_ipv4;          ///< 对端的 IPv4 地址（主机字节序）
+    x_uint16_t    xut_port;          ///< 对端的 端口号
+    x_uint32_t    xut_owner;         ///< 所归属的 分片索引号
+    x_int32_t     xit_errno;         ///< 最近一次轮询的 错误码
+    xtime_vnsec_t xtm_due;           ///< 下次轮询的 到期时间（单调时钟；被动关联 不主动发送）
+    xntp_symm_t * xsym_ptr;          ///< 对称模式 的 关联（客户端轮询 的 对端 为 X_NULL）
+} xntp_peer_t;
+
+/**
+ * @struct xntp_shard_t
+ * @brief  轮询器的 分片（一个工作线程，一个套接字，一个对端集合）。
+ * @note
+ * 结构体的字段 按访问者 分为三组，各组之间以 缓存行 隔开：
+ * 分片线程私有的字段、其他线程写入的字段（收件栈、迁移请求）、分片线程发布的统计信息。
+ */
+typedef struct xntp_shard_t
+{
+    xntp_pollptr_t    xpoll_ptr;      ///< 所属的 轮询器
+    x_uint32_t        xut_index;      ///< 分片索引号
+    x_int32_t         xit_cpu;        ///< 绑定的 CPU 编号（-1 表示不绑定）
+    xntp_cliptr_t     xntp_this;      ///< 分片独占的 NTP 客户端对象（单个工作通道）
+    xntp_peer_t    ** xpeer_list;     ///< 对端集合
+    x_uint32_t        xut_count;      ///< 对端数量
+    x_uint32_t        xut_capacity;   ///< 对端集合的 容量
+    xntp_sweep_t    * xsw_list;       ///< 每轮批量请求的 请求项列表
+    xntp_peer_t    ** xsw_peer;       ///< 请求项 所对应的 对端
+    x_sockfd_t        xfdt_symm;      ///< 对称模式 的 套接字（只有 第 XPOLL_SYM_SHARD 个分片 持有）
+    xntp_peer_t    ** xsym_list;      ///< 对称模式 的 关联集合
+    x_uint32_t        xut_nsym;       ///< 对称模式 的 关联数量
+    x_uint32_t        xut_csym;       ///< 对称模式 的 关联集合 的 容量
+    x_bool_t          xbt_running;    ///< 分片线程 是否已启动
+#if (defined(_WIN32) || defined(_WIN64))
+    HANDLE            xthd_handle;    ///< 分片线程
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_t         xthd_handle;    ///< 分片线程
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    x_uint8_t         xbt_pad0[XCACHE_LINE];
+
+    xntp_peer_t     * xpeer_inbox;    ///< 收件栈（新加入的 或 迁入的 对端，无锁压栈）
+    x_uint32_t        xut_steal;      ///< 迁移请求：((窃取者索引号 + 1) << 16) | 数量
+
+    x_uint8_t         xbt_pad1[XCACHE_LINE];
+
+    xtime_vnsec_t     xtm_wait;       ///< 分片 最早需要再次处理对端的时刻（无对端时为 XTIME_INVALID_VNSEC）
+    xntp_poll_stat_t  xstat;          ///< 统计信息
+
+    x_uint8_t         xbt_pad2[XCACHE_LINE];
+} xntp_shard_t;
+
+/** 每个分片所占用的 字节数 */
+#define XPOLL_SHARD_SIZE    XCACHE_ALIGN(sizeof(xntp_shard_t))
+
+/** 访问 轮询器 的 第 xindex 个分片 */
+#define XPOLL_SHARD(xpoll, xindex) \
+    ((xntp_shard_t *)((xpoll)->xbt_shards + (x_size_t)(xindex) * XPOLL_SHARD_SIZE))
+
+/**
+ * @struct xntp_poller_t
+ * @brief  NTP 轮询器 的结构体描述信息。
+ */
+typedef struct xntp_poller_t
+{
+    xntp_poll_conf_t xconf;        ///< 工作参数
+    x_bptr_t         xbt_shards;   ///< 分片数组（按缓存行对齐）
+    x_bool_t         xbt_started;  ///< 是否已启动
+    x_uint32_t       xut_stop;     ///< 通知 分片线程 退出 的标识
+
+    x_uint8_t        xbt_pad0[XCACHE_LINE];
+
+    x_uint32_t       xut_next;     ///< 下一个 对端标识
+    x_uint32_t       xut_rrobin;   ///< 新对端 轮转分配 的计数
+} xntp_poller_t;
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 内部相关操作接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 休眠指定时长（单位为 100 纳秒）。
+ */
+static x_void_t ntp_poll_sleep(xtime_vnsec_t xtm_vnsec)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    Sleep((DWORD)((xtm_vnsec + XTIME_VNSEC_MSEC - 1) / XTIME_VNSEC_MSEC));
+#else // !(defined(_WIN32) || defined(_WIN64))
+    struct timespec xtm_value;
+    xtm_value.tv_sec  = (time_t)(xtm_vnsec / 10000000ULL);
+    xtm_value.tv_nsec = (long)((xtm_vnsec % 10000000ULL) * 100ULL);
+    nanosleep(&xtm_value, X_NULL);
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 等待 指定时长（单位为 100 纳秒），对称模式 的 套接字 可读时 提前返回。
+ */
+static x_void_t ntp_poll_wait(x_sockfd_t xfdt_symm, xtime_vnsec_t xtm_vnsec)
+{
+    fd_set         xfds_rset;
+    struct timeval xtm_value;
+
+    if (X_INVALID_SOCKFD == xfdt_symm)
+    {
+        ntp_poll_sleep(xtm_vnsec);
+        return;
+    }
+
+    xtm_value.tv_sec  = (x_long_t)(xtm_vnsec / XTIME_100NS_BASE);
+    xtm_value.tv_usec = (x_long_t)((xtm_vnsec % XTIME_100NS_BASE) / 10ULL);
+
+    FD_ZERO(&xfds_rset);
+    FD_SET(xfdt_symm, &xfds_rset);
+    select((x_int32_t)(xfdt_symm + 1), &xfds_rset, X_NULL, X_NULL, &xtm_value);
+}
+
+/**********************************************************/
+/**
+ * @brief 获取 当前进程可用的 CPU 编号列表。
+ *
+ * @param [out] xit_list : 返回的 CPU 编号列表。
+ * @param [in ] xut_size : 列表容量。
+ *
+ * @return x_uint32_t : 返回 可用的 CPU 数量（至少为 1）。
+ */
+static x_uint32_t ntp_poll_cpus(x_int32_t * xit_list, x_uint32_t xut_size)
+{
+    x_uint32_t xut_count = 0;
+    x_uint32_t xut_iter  = 0;
+
+#if (defined(_WIN32) || defined(_WIN64))
+    DWORD_PTR xdw_proc = 0;
+    DWORD_PTR xdw_syst = 0;
+
+    if (GetProcessAffinityMask(GetCurrentProcess(), &xdw_proc, &xdw_syst))
+    {
+        for (xut_iter = 0; (xut_iter < 8 * sizeof(DWORD_PTR)) && (xut_count < xut_size); ++xut_iter)
+        {
+            if (xdw_proc & ((DWORD_PTR)1 << xut_iter))
+                xit_list[xut_count++] = (x_int32_t)xut_iter;
+        }
+    }
+#elif defined(__linux__)
+    cpu_set_t xcpu_set;
+
+    CPU_ZERO(&xcpu_set);
+    if (0 == sched_getaffinity(0, sizeof(cpu_set_t), &xcpu_set))
+    {
+        for (xut_iter = 0; (xut_iter < CPU_SETSIZE) && (xut_count < xut_size); ++xut_iter)
+        {
+            if (CPU_ISSET(xut_iter, &xcpu_set))
+                xit_list[xut_count++] = (x_int32_t)xut_iter;
+        }
+    }
+#else // !__linux__
+    x_int32_t xit_online = (x_int32_t)sysconf(_SC_NPROCESSORS_ONLN);
+    for (xut_iter = 0; ((x_int32_t)xut_iter < xit_online) && (xut_count < xut_size); ++xut_iter)
+    {
+        xit_list[xut_count++] = (x_int32_t)xut_iter;
+    }
+#endif // PLATFORM
+
+    if (0 == xut_count)
+    {
+        xit_list[0] = -1;
+        xut_count   = 1;
+    }
+
+    return xut_count;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 调用线程 绑定到指定的 CPU 上。
+ */
+static x_void_t ntp_poll_bind(x_int32_t xit_cpu)
+{
+    if (xit_cpu < 0)
+    {
+        return;
+    }
+
+#if (defined(_WIN32) || defined(_WIN64))
+    SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << xit_cpu);
+#elif defined(__linux__)
+    {
+        cpu_set_t xcpu_set;
+        CPU_ZERO(&xcpu_set);
+        CPU_SET(xit_cpu, &xcpu_set);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &xcpu_set);
+    }
+#endif // PLATFORM
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 最近一次 套接字操作 的 错误码。
+ */
+static x_int32_t ntp_poll_sock_errno(x_void_t)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    return (x_int32_t)WSAGetLastError();
+#else // !(defined(_WIN32) || defined(_WIN64))
+    return errno;
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 关闭套接字。
+ */
+static x_void_t ntp_poll_sock_close(x_sockfd_t xfdt_sockfd)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    closesocket(xfdt_sockfd);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    close(xfdt_sockfd);
+#endif // (defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 对称模式 的 套接字（非阻塞模式，绑定 指定的 本地端口）。
+ *
+ * @param [in ] xut_port    : 本地端口。
+ * @param [out] xfdt_sockfd : 操作成功时，返回 套接字。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntp_poll_sock_open(x_uint16_t xut_port, x_sockfd_t * xfdt_sockfd)
+{
+    x_int32_t          xit_errno  = 0;
+    x_sockfd_t         xfdt_symm  = X_INVALID_SOCKFD;
+    struct sockaddr_in xin_addr;
+#if (defined(_WIN32) || defined(_WIN64))
+    x_ulong_t          xult_mode  = X_TRUE;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    x_int32_t          xit_option = 1;
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    xfdt_symm = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (X_INVALID_SOCKFD == xfdt_symm)
+    {
+        return ntp_poll_sock_errno();
+    }
+
+    do
+    {
+#if (defined(_WIN32) || defined(_WIN64))
+        if (0 != ioctlsocket(xfdt_symm, FIONBIO, &xult_mode))
+#else // !(defined(_WIN32) || defined(_WIN64))
+        if (fcntl(xfdt_symm, F_SETFL, fcntl(xfdt_symm, F_GETFL, 0) | O_NONBLOCK) < 0)
+#endif // (defined(_WIN32) || defined(_WIN64))
+        {
+            xit_errno = ntp_poll_sock_errno();
+            break;
+        }
+
+#ifdef __linux__
+        // 以 内核接收时间戳 作为 T4，分片线程 忙于 批量请求 时 积压的报文 也不受影响
+        setsockopt(xfdt_symm, SOL_SOCKET, SO_TIMESTAMPNS, &xit_option, sizeof(x_int32_t));
+#endif // __linux__
+
+        memset(&xin_addr, 0, sizeof(struct sockaddr_in));
+        xin_addr.sin_family      = AF_INET;
+        xin_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        xin_addr.sin_port        = htons(xut_port);
+        if (0 != bind(xfdt_symm, (struct sockaddr *)&xin_addr, sizeof(struct sockaddr_in)))
+        {
+            xit_errno = ntp_poll_sock_errno();
+            break;
+        }
+    } while (0);
+
+    if (0 != xit_errno)
+    {
+        ntp_poll_sock_close(xfdt_symm);
+        return xit_errno;
+    }
+
+    *xfdt_sockfd = xfdt_symm;
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 从 对称模式 的 套接字 接收一个报文（非阻塞）。
+ *
+ * @param [in ] xfdt_sockfd : 套接字。
+ * @param [out] xbt_pack    : 报文缓存。
+ * @param [in ] xut_size    : 报文缓存 的 容量。
+ * @param [out] xut_ipv4    : 返回 发送方的 IPv4 地址（主机字节序）。
+ * @param [out] xut_port    : 返回 发送方的 端口号。
+ * @param [out] xtm_T4      : 返回 报文的 接收时间（优先取 内核接收时间戳）。
+ *
+ * @return x_int32_t : 成功，返回 报文长度；无报文 或 失败，返回 -1。
+ */
+static x_int32_t ntp_poll_sock_recv(
+                        x_sockfd_t xfdt_sockfd,
+                        x_uchar_t * xbt_pack,
+                        x_uint32_t xut_size,
+                        x_uint32_t * xut_ipv4,
+                        x_uint16_t * xut_port,
+                        xtime_vnsec_t * xtm_T4)
+{
+    x_int32_t          xit_dlen = -1;
+    struct sockaddr_in xin_addr;
+
+#ifdef __linux__
+    struct msghdr      xmsg_recv;
+    struct iovec       xiov_data;
+    struct cmsghdr   * xcmsg    = X_NULL;
+    struct timespec  * xtms_rcv = X_NULL;
+    union
+    {
+        struct cmsghdr xcmsg_align;
+        x_uchar_t      xbt_ctrl[CMSG_SPACE(sizeof(struct timespec))];
+    } xctl_buf;
+
+    xiov_data.iov_base = xbt_pack;
+    xiov_data.iov_len  = xut_size;
+
+    memset(&xmsg_recv, 0, sizeof(struct msghdr));
+    xmsg_recv.msg_name       = &xin_addr;
+    xmsg_recv.msg_namelen    = sizeof(struct sockaddr_in);
+    xmsg_recv.msg_iov        = &xiov_data;
+    xmsg_recv.msg_iovlen     = 1;
+    xmsg_recv.msg_control    = xctl_buf.xbt_ctrl;
+    xmsg_recv.msg_controllen = sizeof(xctl_buf.xbt_ctrl);
+
+    xit_dlen = (x_int32_t)recvmsg(xfdt_sockfd, &xmsg_recv, 0);
+    if (xit_dlen < 0)
+    {
+        return -1;
+    }
+
+    *xtm_T4 = XTIME_INVALID_VNSEC;
+    for (xcmsg = CMSG_FIRSTHDR(&xmsg_recv); X_NULL != xcmsg; xcmsg = CMSG_NXTHDR(&xmsg_recv, xcmsg))
+    {
+        if ((SOL_SOCKET == xcmsg->cmsg_level) && (SCM_TIMESTAMPNS == xcmsg->cmsg_type))
+        {
+            xtms_rcv = (struct timespec *)CMSG_DATA(xcmsg);
+            *xtm_T4  = (xtime_vnsec_t)(xtms_rcv->tv_sec * 10000000ULL + xtms_rcv->tv_nsec / 100ULL);
+            break;
+        }
+    }
+
+    if (!XTMVNSEC_IS_VALID(*xtm_T4))
+    {
+        *xtm_T4 = time_vnsec();
+    }
+#else // !__linux__
+#if (defined(_WIN32) || defined(_WIN64))
+    x_int32_t          xit_alen = sizeof(struct sockaddr_in);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = sizeof(struct sockaddr_in);
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+    xit_dlen = (x_int32_t)recvfrom(xfdt_sockfd,
+                                   (x_char_t *)xbt_pack,
+                                   (x_int32_t)xut_size,
+                                   0,
+                                   (struct sockaddr *)&xin_addr,
+                                   &xit_alen);
+    if (xit_dlen < 0)
+    {
+        return -1;
+    }
+
+    *xtm_T4 = time_vnsec();
+#endif // __linux__
+
+    *xut_ipv4 = ntohl(xin_addr.sin_addr.s_addr);
+    *xut_port = ntohs(xin_addr.sin_port);
+
+    return xit_dlen;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 将 对端 压入 分片的收件栈（可由任意线程调用）。
+ */
+static x_void_t ntp_shard_push(xntp_shard_t * xshard_ptr, xntp_peer_t * xpeer_ptr)
+{
+    xntp_peer_t * xpeer_head = X_NULL;
+
+    do
+    {
+        xpeer_head = (xntp_peer_t *)XATOMIC_LOADPTR(&xshard_ptr->xpeer_inbox);
+        xpeer_ptr->xpeer_next = xpeer_head;
+    } while (!XATOMIC_CASPTR(&xshard_ptr->xpeer_inbox, xpeer_head, xpeer_ptr));
+}
+
+/**********************************************************/
+/**
+ * @brief 扩充 对端集合 的 容量。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；内存不足，返回 X_FALSE。
+ */
+static x_bool_t ntp_peer_list_grow(xntp_peer_t *** xpeer_list, x_uint32_t * xut_capacity)
+{
+    xntp_peer_t ** xpeer_vect = (xntp_peer_t **)realloc(
+                                    *xpeer_list, 2 * (*xut_capacity + 32) * sizeof(xntp_peer_t *));
+    if (X_NULL == xpeer_vect)
+    {
+        return X_FALSE;
+    }
+
+    *xpeer_list   = xpeer_vect;
+    *xut_capacity = 2 * (*xut_capacity + 32);
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 对称模式 的 关联 并入 分片的 关联集合。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；内存不足，返回 X_FALSE。
+ */
+static x_bool_t ntp_symm_append(xntp_shard_t * xshard_ptr, xntp_peer_t * xpeer_ptr)
+{
+    if ((xshard_ptr->xut_nsym == xshard_ptr->xut_csym) &&
+        !ntp_peer_list_grow(&xshard_ptr->xsym_list, &xshard_ptr->xut_csym))
+    {
+        return X_FALSE;
+    }
+
+    xpeer_ptr->xut_owner = xshard_ptr->xut_index;
+    xshard_ptr->xsym_list[xshard_ptr->xut_nsym++] = xpeer_ptr;
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 取出 收件栈 中的所有对端，并入 分片的对端集合（对称模式 的 关联 并入 关联集合）。
+ */
+static x_void_t ntp_shard_drain(xntp_shard_t * xshard_ptr, xtime_vnsec_t xtm_mono)
+{
+    xntp_peer_t  * xpeer_ptr  = X_NULL;
+    xntp_peer_t  * xpeer_next = X_NULL;
+    x_uint32_t     xut_stolen = 0;
+    x_bool_t       xbt_okay   = X_TRUE;
+
+    if (X_NULL == XATOMIC_LOADPTR(&xshard_ptr->xpeer_inbox))
+    {
+        return;
+    }
+
+    xpeer_ptr = (xntp_peer_t *)XATOMIC_XCHGPTR(&xshard_ptr->xpeer_inbox, X_NULL);
+    for (; X_NULL != xpeer_ptr; xpeer_ptr = xpeer_next)
+    {
+        xpeer_next = xpeer_ptr->xpeer_next;
+
+        if (!XTMVNSEC_IS_VALID(xpeer_ptr->xtm_due))
+        {
+            xpeer_ptr->xtm_due = xtm_mono;
+        }
+
+        if (X_NULL != xpeer_ptr->xsym_ptr)
+            xbt_okay = ntp_symm_append(xshard_ptr, xpeer_ptr);
+        else if (xshard_ptr->xut_count == xshard_ptr->xut_capacity)
+            xbt_okay = ntp_peer_list_grow(&xshard_ptr->xpeer_list, &xshard_ptr->xut_capacity);
+
+        if (!xbt_okay)
+        {
+            // 内存不足时，余下的对端 留待下一轮 再并入
+            for (; X_NULL != xpeer_ptr; xpeer_ptr = xpeer_next)
+            {
+                xpeer_next = xpeer_ptr->xpeer_next;
+                ntp_shard_push(xshard_ptr, xpeer_ptr);
+            }
+            break;
+        }
+
+        if (X_NULL != xpeer_ptr->xsym_ptr)
+        {
+            continue;
+        }
+
+        if ((XPOLL_NO_OWNER != xpeer_ptr->xut_owner) &&
+            (xshard_ptr->xut_index != xpeer_ptr->xut_owner))
+        {
+            xut_stolen += 1;
+        }
+
+        xpeer_ptr->xut_owner = xshard_ptr->xut_index;
+        xshard_ptr->xpeer_list[xshard_ptr->xut_count++] = xpeer_ptr;
+    }
+
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_stolen, xshard_ptr->xstat.xut_stolen + xut_stolen);
+    XATOMIC_STORE32(&xshard_ptr->xstat.xut_peers, xshard_ptr->xut_count);
+}
+
+/**********************************************************/
+/**
+ * @brief 响应其他分片的 迁移请求，将部分对端 迁出。
+ * @note
+ * 优先迁出 已到期而仍在等待的 正常对端，其次为 其他正常对端；
+ * 最近一次轮询失败（如 无应答）的对端 留在本分片，以免 拖慢窃取者。
+ */
+static x_void_t ntp_shard_give(xntp_shard_t * xshard_ptr, xtime_vnsec_t xtm_mono)
+{
+    x_uint32_t     xut_steal  = XATOMIC_LOAD32(&xshard_ptr->xut_steal);
+    x_uint32_t     xut_want   = 0;
+    x_uint32_t     xut_given  = 0;
+    x_uint32_t     xut_pass   = 0;
+    x_uint32_t     xut_iter   = 0;
+    xntp_shard_t * xshard_dst = X_NULL;
+    xntp_peer_t  * xpeer_ptr  = X_NULL;
+
+    if (0 == xut_steal)
+    {
+        return;
+    }
+
+    xshard_dst = XPOLL_SHARD(xshard_ptr->xpoll_ptr, (xut_steal >> 16) - 1);
+    xut_want   = xut_steal & 0xFFFF;
+
+    for (xut_pass = 0; (xut_pass < 2) && (xut_given < xut_want); ++xut_pass)
+    {
+        for (xut_iter = xshard_ptr->xut_count; (xut_iter > 0) && (xut_given < xut_want); )
+        {
+            xpeer_ptr = xshard_ptr->xpeer_list[--xut_iter];
+            if ((0 != xpeer_ptr->xit_errno) ||
+                ((0 == xut_pass) && (xpeer_ptr->xtm_due > xtm_mono)))
+            {
+                continue;
+            }
+
+            xshard_ptr->xpeer_list[xut_iter] = xshard_ptr->xpeer_list[--xshard_ptr->xut_count];
+            ntp_shard_push(xshard_dst, xpeer_ptr);
+            xut_given += 1;
+        }
+    }
+
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_given, xshard_ptr->xstat.xut_given + xut_given);
+    XATOMIC_STORE32(&xshard_ptr->xstat.xut_peers, xshard_ptr->xut_count);
+    XATOMIC_STORE32(&xshard_ptr->xut_steal, 0);
+}
+
+/**********************************************************/
+/**
+ * @brief 空闲的分片，向 滞后最严重 的分片 发出迁移请求（窃取其一部分对端）。
+ * @note
+ * 被窃取的分片 在其下一轮开始时 才迁出对端，因此 对端集合 始终只由 所属分片线程 修改。
+ */
+static x_void_t ntp_shard_steal(xntp_shard_t * xshard_ptr, xtime_vnsec_t xtm_mono)
+{
+    xntp_pollptr_t xpoll_ptr  = xshard_ptr->xpoll_ptr;
+    xntp_shard_t * xshard_vic = X_NULL;
+    xntp_shard_t * xshard_itr = X_NULL;
+    xtime_vnsec_t  xtm_wait   = 0;
+    xtime_vnsec_t  xtm_lag    = 0;
+    x_uint32_t     xut_iter   = 0;
+    x_uint32_t     xut_peers  = 0;
+    x_uint32_t     xut_want   = 0;
+
+    // 滞后超过 1/4 个轮询周期，才视为 跟不上进度（空闲分片 自身的滞后 总为 0）
+    xtm_lag = xpoll_ptr->xconf.xut_period * XTIME_VNSEC_MSEC / 4;
+
+    for (xut_iter = 0; xut_iter < xpoll_ptr->xconf.xut_shards; ++xut_iter)
+    {
+        xshard_itr = XPOLL_SHARD(xpoll_ptr, xut_iter);
+        if (xshard_itr == xshard_ptr)
+        {
+            continue;
+        }
+
+        xtm_wait = XATOMIC_LOAD64(&xshard_itr->xtm_wait);
+        if (XTMVNSEC_IS_VALID(xtm_wait) && (xtm_wait < xtm_mono) && ((xtm_mono - xtm_wait) > xtm_lag))
+        {
+            xtm_lag    = xtm_mono - xtm_wait;
+            xshard_vic = xshard_itr;
+        }
+    }
+
+    if (X_NULL == xshard_vic)
+    {
+        return;
+    }
+
+    // 窃取 滞后分片 的一半对端；若滞后仍持续，后续的窃取 会继续分流
+    xut_peers = XATOMIC_LOAD32(&xshard_vic->xstat.xut_peers);
+    if (xut_peers < 2)
+    {
+        return;
+    }
+
+    xut_want = xut_peers / 2;
+    if (xut_want > XPOLL_STEAL_MAX)
+        xut_want = XPOLL_STEAL_MAX;
+
+    XATOMIC_CAS32(&xshard_vic->xut_steal, 0, ((xshard_ptr->xut_index + 1) << 16) | xut_want);
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 对端（分配 对端标识）。
+ *
+ * @param [in ] xpoll_ptr : NTP 轮询器。
+ * @param [in ] xut_ipv4  : 对端的 IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 对端的 端口号。
+ * @param [in ] xut_hmode : 本端模式（ntp_mode_client 为 客户端轮询，否则 为 对称模式 的 关联）。
+ *
+ * @return xntp_peer_t * : 成功，返回 对端；内存不足，返回 X_NULL。
+ */
+static xntp_peer_t * ntp_peer_alloc(
+                            xntp_pollptr_t xpoll_ptr,
+                            x_uint32_t xut_ipv4,
+                            x_uint16_t xut_port,
+                            x_uint32_t xut_hmode)
+{
+    xntp_peer_t * xpeer_ptr  = X_NULL;
+    x_size_t      xst_size   = sizeof(xntp_peer_t);
+    xtime_vnsec_t xtm_mono   = 0;
+    xtime_vnsec_t xtm_period = 0;
+
+    // 对称模式 的 附加信息 紧随 对端结构体 之后，与之一同分配、一同释放
+    if (ntp_mode_client != xut_hmode)
+    {
+        xst_size += sizeof(xntp_symm_t);
+    }
+
+    xpeer_ptr = (xntp_peer_t *)malloc(xst_size);
+    if (X_NULL == xpeer_ptr)
+    {
+        return X_NULL;
+    }
+
+    xpeer_ptr->xpeer_next = X_NULL;
+    xpeer_ptr->xut_peer   = XATOMIC_ADD32(&xpoll_ptr->xut_next, 1);
+    xpeer_ptr->xut_ipv4   = xut_ipv4;
+    xpeer_ptr->xut_port   = xut_port;
+    xpeer_ptr->xut_owner  = XPOLL_NO_OWNER;
+    xpeer_ptr->xit_errno  = 0;
+    xpeer_ptr->xtm_due    = XTIME_INVALID_VNSEC;
+    xpeer_ptr->xsym_ptr   = X_NULL;
+
+    if (ntp_mode_client != xut_hmode)
+    {
+        // 对等的双方 若 同时发送，各自的报文 都回送不了 对方 刚发出的 时间戳，
+        // 因而 主动关联 的 首次发送 在 一个轮询周期内 随机错开
+        xtm_mono = time_mono();
+        xtm_period = xpoll_ptr->xconf.xut_period * XTIME_VNSEC_MSEC;
+        xpeer_ptr->xtm_due = xtm_mono + (xtm_mono * 2654435761ULL) % xtm_period;
+
+        xpeer_ptr->xsym_ptr = (xntp_symm_t *)(xpeer_ptr + 1);
+        xpeer_ptr->xsym_ptr->xbt_noted = X_TRUE;
+        xpeer_ptr->xsym_ptr->xtm_heard = xtm_mono;
+        ntpasc_init(&xpeer_ptr->xsym_ptr->xassoc,
+                    xut_hmode,
+                    xpoll_ptr->xconf.xut_stratum,
+                    xpoll_ptr->xconf.xut_keyid);
+    }
+
+    return xpeer_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 回调 对端 的 一次轮询结果。
+ *
+ * @param [in ] xshard_ptr : 分片。
+ * @param [in ] xpeer_ptr  : 对端。
+ * @param [in ] xut_mode   : 本端模式。
+ * @param [in ] xit_errno  : 错误码。
+ * @param [in ] xtm_4time  : 4 个相关时间戳。
+ * @param [in ] xit_offset : 本地时钟 相对于 对端 的偏差（成功时有效）。
+ */
+static x_void_t ntp_shard_notify(
+                    xntp_shard_t * xshard_ptr,
+                    xntp_peer_t * xpeer_ptr,
+                    x_uint32_t xut_mode,
+                    x_int32_t xit_errno,
+                    const xtime_vnsec_t xtm_4time[4],
+                    x_int64_t xit_offset)
+{
+    xntp_pollptr_t     xpoll_ptr = xshard_ptr->xpoll_ptr;
+    xntp_poll_result_t xres_this;
+
+    if (X_NULL == xpoll_ptr->xconf.xfunc_cbk)
+    {
+        return;
+    }
+
+    xres_this.xut_peer     = xpeer_ptr->xut_peer;
+    xres_this.xut_ipv4     = xpeer_ptr->xut_ipv4;
+    xres_this.xut_port     = xpeer_ptr->xut_port;
+    xres_this.xut_shard    = xshard_ptr->xut_index;
+    xres_this.xut_mode     = xut_mode;
+    xres_this.xit_errno    = xit_errno;
+    xres_this.xtm_4time[0] = xtm_4time[0];
+    xres_this.xtm_4time[1] = xtm_4time[1];
+    xres_this.xtm_4time[2] = xtm_4time[2];
+    xres_this.xtm_4time[3] = xtm_4time[3];
+
+    if (0 == xit_errno)
+    {
+        xres_this.xit_offset = xit_offset;
+        xres_this.xit_delay  = (x_int64_t)(xtm_4time[3] - xtm_4time[0]) -
+                               (x_int64_t)(xtm_4time[2] - xtm_4time[1]);
+    }
+    else
+    {
+        xres_this.xit_offset = 0;
+        xres_this.xit_delay  = 0;
+    }
+
+    xpoll_ptr->xconf.xfunc_cbk(xpoll_ptr->xconf.xpvt_ctxt, &xres_this);
+}
+
+/**********************************************************/
+/**
+ * @brief 按 地址 查找 对称模式 的 关联。
+ */
+static xntp_peer_t * ntp_symm_find(xntp_shard_t * xshard_ptr, x_uint32_t xut_ipv4, x_uint16_t xut_port)
+{
+    x_uint32_t    xut_iter  = 0;
+    xntp_peer_t * xpeer_ptr = X_NULL;
+
+    for (xut_iter = 0; xut_iter < xshard_ptr->xut_nsym; ++xut_iter)
+    {
+        xpeer_ptr = xshard_ptr->xsym_list[xut_iter];
+        if ((xut_ipv4 == xpeer_ptr->xut_ipv4) && (xut_port == xpeer_ptr->xut_port))
+        {
+            return xpeer_ptr;
+        }
+    }
+
+    return X_NULL;
+}
+
+/**********************************************************/
+/**
+ * @brief 向 对等体 发出 关联的 下一个报文。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntp_symm_send(xntp_shard_t * xshard_ptr, xntp_peer_t * xpeer_ptr)
+{
+    x_int32_t          xit_errno = 0;
+    x_uint32_t         xut_plen  = 0;
+    x_uchar_t          xbt_pack[XNTP_ASSOC_PKT_MAX];
+    struct sockaddr_in xin_addr;
+
+    memset(&xin_addr, 0, sizeof(struct sockaddr_in));
+    xin_addr.sin_family      = AF_INET;
+    xin_addr.sin_addr.s_addr = htonl(xpeer_ptr->xut_ipv4);
+    xin_addr.sin_port        = htons(xpeer_ptr->xut_port);
+
+    xit_errno = ntpasc_build(&xpeer_ptr->xsym_ptr->xassoc,
+                             xshard_ptr->xpoll_ptr->xconf.xkey_table,
+                             xbt_pack,
+                             &xut_plen);
+    if (0 != xit_errno)
+    {
+        return xit_errno;
+    }
+
+    xpeer_ptr->xsym_ptr->xbt_noted = X_FALSE;
+
+    if (sendto(xshard_ptr->xfdt_symm,
+               (const x_char_t *)xbt_pack,
+               (x_int32_t)xut_plen,
+               0,
+               (struct sockaddr *)&xin_addr,
+               sizeof(struct sockaddr_in)) < 0)
+    {
+        return ntp_poll_sock_errno();
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 处理 分片的 对称模式 关联：接收 并 处理 积压的报文，向 已到期的 主动关联 发出报文。
+ * @note
+ * 来自 未配置对端 的 主动模式 报文，先以 临时关联 检查（含 认证），通过后 才建立 被动关联，
+ * 以免 伪造的报文 占用资源；被动关联 不主动发送，只对 每个有效报文 回送一个报文，
+ * 对端 沉默 超过 XPOLL_SYM_IDLE 个 轮询周期 后 被撤销。
+ *
+ * @param [in ] xshard_ptr : 分片。
+ * @param [in ] xtm_mono   : 本轮开始时的 单调时钟时间。
+ *
+ * @return xtime_vnsec_t : 返回 主动关联 最早的 下次到期时间（无主动关联时 为 XTIME_INVALID_VNSEC）。
+ */
+static xtime_vnsec_t ntp_shard_symm(xntp_shard_t * xshard_ptr, xtime_vnsec_t xtm_mono)
+{
+    xntp_pollptr_t xpoll_ptr  = xshard_ptr->xpoll_ptr;
+    xtime_vnsec_t  xtm_period = xpoll_ptr->xconf.xut_period * XTIME_VNSEC_MSEC;
+    xtime_vnsec_t  xtm_next   = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t  xtm_T4     = 0;
+    x_int32_t      xit_errno  = 0;
+    x_int32_t      xit_dlen   = 0;
+    x_uint32_t     xut_iter   = 0;
+    x_uint32_t     xut_ipv4   = 0;
+    x_uint16_t     xut_port   = 0;
+    x_uint64_t     xut_pkts   = 0;
+    x_uint64_t     xut_drop   = 0;
+    x_uint64_t     xut_polls  = 0;
+    x_uint64_t     xut_okay   = 0;
+    x_uint64_t     xut_fail   = 0;
+    xntp_peer_t  * xpeer_ptr  = X_NULL;
+    xntp_symm_t  * xsym_ptr   = X_NULL;
+    xntp_view_t    xview_pk;
+    xntp_assoc_t   xasc_temp;
+    xtime_vnsec_t  xtm_4time[4];
+    x_uchar_t      xbt_pack[XNTP_PKT_MAX + 4];
+
+    if (X_INVALID_SOCKFD == xshard_ptr->xfdt_symm)
+    {
+        return XTIME_INVALID_VNSEC;
+    }
+
+    //======================================
+    // 接收报文
+
+    for (xut_iter = 0; xut_iter < XPOLL_SYM_RECV; ++xut_iter)
+    {
+        xit_dlen = ntp_poll_sock_recv(xshard_ptr->xfdt_symm,
+                                      xbt_pack,
+                                      sizeof(xbt_pack),
+                                      &xut_ipv4,
+                                      &xut_port,
+                                      &xtm_T4);
+        if (xit_dlen < 0)
+        {
+            break;
+        }
+
+        xut_pkts += 1;
+
+        // 缓存 比 XNTP_PKT_MAX 多留几个字节，被截断的 超长报文 因而会被判为 EMSGSIZE
+        if (0 != ntpv_init(&xview_pk, xbt_pack, xit_dlen))
+        {
+            xut_drop += 1;
+            continue;
+        }
+
+        xpeer_ptr = ntp_symm_find(xshard_ptr, xut_ipv4, xut_port);
+        if (X_NULL != xpeer_ptr)
+        {
+            xit_errno = ntpasc_recv(&xpeer_ptr->xsym_ptr->xassoc,
+                                    xpoll_ptr->xconf.xkey_table,
+                                    &xview_pk,
+                                    xtm_T4,
+                                    xtm_4time);
+        }
+        else if (xpoll_ptr->xconf.xbt_passive && (ntp_mode_initiative == ntpv_mode(&xview_pk)))
+        {
+            ntpasc_init(&xasc_temp, ntp_mode_passive, xpoll_ptr->xconf.xut_stratum, xpoll_ptr->xconf.xut_keyid);
+            xit_errno = ntpasc_recv(&xasc_temp, xpoll_ptr->xconf.xkey_table, &xview_pk, xtm_T4, xtm_4time);
+            if ((0 == xit_errno) || (EAGAIN == xit_errno) || (EPROTO == xit_errno))
+            {
+                xpeer_ptr = ntp_peer_alloc(xpoll_ptr, xut_ipv4, xut_port, ntp_mode_passive);
+                if ((X_NULL != xpeer_ptr) && !ntp_symm_append(xshard_ptr, xpeer_ptr))
+                {
+                    free(xpeer_ptr);
+                    xpeer_ptr = X_NULL;
+                }
+
+                if (X_NULL != xpeer_ptr)
+                {
+                    xpeer_ptr->xsym_ptr->xassoc = xasc_temp;
+                }
+            }
+        }
+
+        // 无效、认证失败、重复 的报文，以及 未知对端（或 无法建立 被动关联）的报文
+        if ((X_NULL == xpeer_ptr) ||
+            ((0 != xit_errno) && (EAGAIN != xit_errno) && (EPROTO != xit_errno)))
+        {
+            xut_drop += 1;
+            continue;
+        }
+
+        xsym_ptr = xpeer_ptr->xsym_ptr;
+        xsym_ptr->xtm_heard = xtm_mono;
+
+        if (0 == xit_errno)
+        {
+            if (!xsym_ptr->xbt_noted && (ntp_mode_initiative == xsym_ptr->xassoc.xut_hmode))
+            {
+                xut_okay += 1;
+            }
+
+            xsym_ptr->xbt_noted  = X_TRUE;
+            xpeer_ptr->xit_errno = 0;
+
+            // offset = ((T2 - T1) + (T3 - T4)) / 2
+            ntp_shard_notify(xshard_ptr,
+                             xpeer_ptr,
+                             xsym_ptr->xassoc.xut_hmode,
+                             0,
+                             xtm_4time,
+                             ((x_int64_t)(xtm_4time[1] - xtm_4time[0]) +
+                              (x_int64_t)(xtm_4time[2] - xtm_4time[3])) / 2);
+        }
+
+        if (ntp_mode_passive == xsym_ptr->xassoc.xut_hmode)
+        {
+            ntp_symm_send(xshard_ptr, xpeer_ptr);
+        }
+    }
+
+    //======================================
+    // 主动关联 到期发送；撤销 沉默过久的 被动关联
+
+    for (xut_iter = 0; xut_iter < xshard_ptr->xut_nsym; )
+    {
+        xpeer_ptr = xshard_ptr->xsym_list[xut_iter];
+        xsym_ptr  = xpeer_ptr->xsym_ptr;
+
+        if (ntp_mode_passive == xsym_ptr->xassoc.xut_hmode)
+        {
+            if ((xtm_mono - xsym_ptr->xtm_heard) > (XPOLL_SYM_IDLE * xtm_period))
+            {
+                xshard_ptr->xsym_list[xut_iter] = xshard_ptr->xsym_list[--xshard_ptr->xut_nsym];
+                free(xpeer_ptr);
+                continue;
+            }
+
+            xut_iter += 1;
+            continue;
+        }
+
+        if (xpeer_ptr->xtm_due <= xtm_mono)
+        {
+            memset(xtm_4time, 0, sizeof(xtm_4time));
+
+            // 上一个周期 未得到样本
+            if (!xsym_ptr->xbt_noted)
+            {
+                xtm_4time[0] = xsym_ptr->xassoc.xtm_xmt;
+                xpeer_ptr->xit_errno = ETIMEDOUT;
+                ntp_shard_notify(xshard_ptr, xpeer_ptr, ntp_mode_initiative, ETIMEDOUT, xtm_4time, 0);
+                xut_fail += 1;
+            }
+
+            xut_polls += 1;
+            xit_errno = ntp_symm_send(xshard_ptr, xpeer_ptr);
+            if (0 != xit_errno)
+            {
+                xsym_ptr->xbt_noted  = X_TRUE;
+                xpeer_ptr->xit_errno = xit_errno;
+                ntp_shard_notify(xshard_ptr, xpeer_ptr, ntp_mode_initiative, xit_errno, xtm_4time, 0);
+                xut_fail += 1;
+            }
+
+            // 严重滞后时，不再补发 已错过的轮询，而是从本轮开始时刻 重新计时
+            xpeer_ptr->xtm_due += xtm_period;
+            if (xpeer_ptr->xtm_due < xtm_mono)
+            {
+                xpeer_ptr->xtm_due = xtm_mono;
+            }
+        }
+
+        if (xpeer_ptr->xtm_due < xtm_next)
+        {
+            xtm_next = xpeer_ptr->xtm_due;
+        }
+
+        xut_iter += 1;
+    }
+
+    //======================================
+
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_sympkts, xshard_ptr->xstat.xut_sympkts + xut_pkts );
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_symdrop, xshard_ptr->xstat.xut_symdrop + xut_drop );
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_polls  , xshard_ptr->xstat.xut_polls   + xut_polls);
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_replies, xshard_ptr->xstat.xut_replies + xut_okay );
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_errors , xshard_ptr->xstat.xut_errors  + xut_fail );
+
+    return xtm_next;
+}
+
+/**********************************************************/
+/**
+ * @brief 执行 分片 的一轮轮询：批量请求所有已到期的对端，回调结果，并安排下次到期时间
+ *        （持有 对称模式 套接字 的分片，同时 处理 对称模式 的 关联）。
+ *
+ * @param [in ] xshard_ptr : 分片。
+ * @param [out] xtm_next   : 返回 最早的 下次到期时间（无对端时为 XTIME_INVALID_VNSEC）。
+ *
+ * @return x_bool_t : 本轮有对端被轮询，返回 X_TRUE；否则（空闲），返回 X_FALSE。
+ */
+static x_bool_t ntp_shard_round(xntp_shard_t * xshard_ptr, xtime_vnsec_t * xtm_next)
+{
+    xntp_pollptr_t     xpoll_ptr = xshard_ptr->xpoll_ptr;
+    xtime_vnsec_t      xtm_mono  = time_mono();
+    xtime_vnsec_t      xtm_due   = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t      xtm_wait  = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t      xtm_redo  = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t      xtm_symm  = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t      xtm_period = xpoll_ptr->xconf.xut_period * XTIME_VNSEC_MSEC;
+    x_uint32_t         xut_batch = 0;
+    x_uint32_t         xut_iter  = 0;
+    x_uint32_t         xut_okay  = 0;
+    x_int32_t          xit_errno = 0;
+    xntp_peer_t      * xpeer_ptr = X_NULL;
+    xntp_sweep_t     * xsw_item  = X_NULL;
+
+    ntp_shard_drain(xshard_ptr, xtm_mono);
+    ntp_shard_give(xshard_ptr, xtm_mono);
+
+    xtm_symm = ntp_shard_symm(xshard_ptr, xtm_mono);
+
+    //======================================
+    // 收集已到期的对端
+
+    *xtm_next = XTIME_INVALID_VNSEC;
+
+    for (xut_iter = 0; xut_iter < xshard_ptr->xut_count; ++xut_iter)
+    {
+        xpeer_ptr = xshard_ptr->xpeer_list[xut_iter];
+
+        if ((xpeer_ptr->xtm_due <= xtm_mono) && (xut_batch < XPOLL_BATCH))
+        {
+            if (xpeer_ptr->xtm_due < xtm_due)
+                xtm_due = xpeer_ptr->xtm_due;
+            if (xpeer_ptr->xtm_due + xtm_period < xtm_redo)
+                xtm_redo = xpeer_ptr->xtm_due + xtm_period;
+
+            xshard_ptr->xsw_peer[xut_batch] = xpeer_ptr;
+            xshard_ptr->xsw_list[xut_batch].xut_ipv4  = xpeer_ptr->xut_ipv4;
+            xshard_ptr->xsw_list[xut_batch].xut_port  = xpeer_ptr->xut_port;
+            xshard_ptr->xsw_list[xut_batch].xut_keyid = xpoll_ptr->xconf.xut_keyid;
+            xut_batch += 1;
+        }
+        else if (xpeer_ptr->xtm_due < xtm_wait)
+        {
+            xtm_wait = xpeer_ptr->xtm_due;
+        }
+    }
+
+    // 发布 本分片最早需要再次处理对端的时刻（未入本轮的对端 的到期时间，或 本轮对端 的下次到期时间），
+    // 若本轮的批量请求 迟迟未能完成（如 等待无应答的对端 直至超时），其他分片 据此判断本分片已滞后
+    XATOMIC_STORE64(&xshard_ptr->xtm_wait, (xtm_redo < xtm_wait) ? xtm_redo : xtm_wait);
+
+    if (0 == xut_batch)
+    {
+        XATOMIC_STORE64(&xshard_ptr->xstat.xut_lag, 0);
+        *xtm_next = (xtm_symm < xtm_wait) ? xtm_symm : xtm_wait;
+        return X_FALSE;
+    }
+
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_lag, xtm_mono - xtm_due);
+
+    //======================================
+
+    xit_errno = ntpcli_req_sweep(
+                    xshard_ptr->xntp_this,
+                    xshard_ptr->xsw_list,
+                    xut_batch,
+                    xtm_mono + xpoll_ptr->xconf.xut_tmout * XTIME_VNSEC_MSEC);
+
+    for (xut_iter = 0; xut_iter < xut_batch; ++xut_iter)
+    {
+        xpeer_ptr = xshard_ptr->xsw_peer[xut_iter];
+        xsw_item  = &xshard_ptr->xsw_list[xut_iter];
+
+        if (0 != xit_errno)
+        {
+            xsw_item->xit_errno = xit_errno;
+        }
+
+        xpeer_ptr->xit_errno = xsw_item->xit_errno;
+
+        if (0 == xsw_item->xit_errno)
+        {
+            xut_okay += 1;
+        }
+
+        ntp_shard_notify(xshard_ptr,
+                         xpeer_ptr,
+                         ntp_mode_client,
+                         xsw_item->xit_errno,
+                         xsw_item->xtm_4time,
+                         (x_int64_t)(xsw_item->xtm_vnsec - xsw_item->xtm_4time[3]));
+
+        // 严重滞后时，不再补发 已错过的轮询，而是从本轮开始时刻 重新计时
+        xpeer_ptr->xtm_due += xtm_period;
+        if (xpeer_ptr->xtm_due < xtm_mono)
+        {
+            xpeer_ptr->xtm_due = xtm_mono;
+        }
+
+        if (xpeer_ptr->xtm_due < *xtm_next)
+        {
+            *xtm_next = xpeer_ptr->xtm_due;
+        }
+    }
+
+    if (xtm_wait < *xtm_next)
+    {
+        *xtm_next = xtm_wait;
+    }
+
+    if (xtm_symm < *xtm_next)
+    {
+        *xtm_next = xtm_symm;
+    }
+
+    //======================================
+
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_polls  , xshard_ptr->xstat.xut_polls   + xut_batch);
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_replies, xshard_ptr->xstat.xut_replies + xut_okay);
+    XATOMIC_STORE64(&xshard_ptr->xstat.xut_errors , xshard_ptr->xstat.xut_errors  + (xut_batch - xut_okay));
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 分片线程 的 工作流程。
+ */
+static x_void_t ntp_shard_run(xntp_shard_t * xshard_ptr)
+{
+    xntp_pollptr_t xpoll_ptr = xshard_ptr->xpoll_ptr;
+    xtime_vnsec_t  xtm_next  = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t  xtm_mono  = 0;
+
+    ntp_poll_bind(xshard_ptr->xit_cpu);
+
+    while (0 == XATOMIC_LOAD32(&xpoll_ptr->xut_stop))
+    {
+        if (ntp_shard_round(xshard_ptr, &xtm_next))
+        {
+            continue;
+        }
+
+        xtm_mono = time_mono();
+        ntp_shard_steal(xshard_ptr, xtm_mono);
+
+        if (!XTMVNSEC_IS_VALID(xtm_next) || (xtm_next > xtm_mono + XPOLL_IDLE))
+            xtm_next = xtm_mono + XPOLL_IDLE;
+
+        if (xtm_next > xtm_mono)
+            ntp_poll_wait(xshard_ptr->xfdt_symm, xtm_next - xtm_mono);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 分片线程 的 入口函数。
+ */
+#if (defined(_WIN32) || defined(_WIN64))
+static DWORD WINAPI ntp_shard_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_pvoid_t ntp_shard_proc(x_pvoid_t xpvt_param)
+#endif // (defined(_WIN32) || defined(_WIN64))
+{
+    ntp_shard_run((xntp_shard_t *)xpvt_param);
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 外部相关操作接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 创建 NTP 轮询器（分片线程 在 ntppoll_start() 时启动）。
+ *
+ * @param [in ] xconf_ptr : 工作参数。
+ *
+ * @return xntp_pollptr_t :
+ * 成功，返回 轮询器；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_pollptr_t ntppoll_create(const xntp_poll_conf_t * xconf_ptr)
+{
+    x_int32_t      xit_errno  = EPERM;
+    xntp_pollptr_t xpoll_ptr  = X_NULL;
+    xntp_shard_t * xshard_ptr = X_NULL;
+    x_uint32_t     xut_iter   = 0;
+    x_uint32_t     xut_ncpu   = 0;
+    x_int32_t      xit_cpus[256];
+
+    do
+    {
+        //======================================
+
+        if ((X_NULL == xconf_ptr) ||
+            (0 == xconf_ptr->xut_period) ||
+            (0 == xconf_ptr->xut_tmout) ||
+            (xconf_ptr->xut_shards > 0xFFFE) ||
+            (xconf_ptr->xut_stratum > 16) ||
+            ((0 != xconf_ptr->xut_keyid) && (X_NULL == xconf_ptr->xkey_table)))
+        {
+            xit_errno = EINVAL;
+            break;
+        }
+
+        xpoll_ptr = (xntp_pollptr_t)calloc(1, sizeof(xntp_poller_t));
+        if (X_NULL == xpoll_ptr)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        xpoll_ptr->xconf = *xconf_ptr;
+
+        xut_ncpu = ntp_poll_cpus(xit_cpus, sizeof(xit_cpus) / sizeof(xit_cpus[0]));
+        if (0 == xpoll_ptr->xconf.xut_shards)
+        {
+            xpoll_ptr->xconf.xut_shards = xut_ncpu;
+        }
+
+        //======================================
+
+        xpoll_ptr->xbt_shards = (x_bptr_t)xcache_alloc(xpoll_ptr->xconf.xut_shards * XPOLL_SHARD_SIZE);
+        if (X_NULL == xpoll_ptr->xbt_shards)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        memset(xpoll_ptr->xbt_shards, 0, xpoll_ptr->xconf.xut_shards * XPOLL_SHARD_SIZE);
+
+        for (xut_iter = 0; xut_iter < xpoll_ptr->xconf.xut_shards; ++xut_iter)
+        {
+            XPOLL_SHARD(xpoll_ptr, xut_iter)->xfdt_symm = X_INVALID_SOCKFD;
+        }
+
+        for (xut_iter = 0; xut_iter < xpoll_ptr->xconf.xut_shards; ++xut_iter)
+        {
+            xshard_ptr = XPOLL_SHARD(xpoll_ptr, xut_iter);
+            xshard_ptr->xpoll_ptr = xpoll_ptr;
+            xshard_ptr->xut_index = xut_iter;
+            xshard_ptr->xit_cpu   = xpoll_ptr->xconf.xbt_affinity ? xit_cpus[xut_iter % xut_ncpu] : -1;
+            xshard_ptr->xtm_wait  = XTIME_INVALID_VNSEC;
+
+            xshard_ptr->xsw_list = (xntp_sweep_t *)malloc(XPOLL_BATCH * sizeof(xntp_sweep_t));
+            xshard_ptr->xsw_peer = (xntp_peer_t **)malloc(XPOLL_BATCH * sizeof(xntp_peer_t *));
+            if ((X_NULL == xshard_ptr->xsw_list) || (X_NULL == xshard_ptr->xsw_peer))
+            {
+                xit_errno = ENOMEM;
+                break;
+            }
+
+            // 每个分片 独占一个套接字（各自的临时端口），应答 直接回到 发出请求的分片
+            xshard_ptr->xntp_this = ntpcli_open_ex(1);
+            if (X_NULL == xshard_ptr->xntp_this)
+            {
+                xit_errno = errno;
+                break;
+            }
+
+            xit_errno = ntpcli_auth(xshard_ptr->xntp_this, xpoll_ptr->xconf.xkey_table, xpoll_ptr->xconf.xut_keyid);
+            if (0 != xit_errno)
+            {
+                break;
+            }
+
+            // 对称模式 的 关联 集中于 一个分片，以 固定的 本地端口 收发
+            if ((XPOLL_SYM_SHARD == xut_iter) && (0 != xpoll_ptr->xconf.xut_sport))
+            {
+                xit_errno = ntp_poll_sock_open(xpoll_ptr->xconf.xut_sport, &xshard_ptr->xfdt_symm);
+                if (0 != xit_errno)
+                {
+                    break;
+                }
+            }
+        }
+
+        if (xut_iter < xpoll_ptr->xconf.xut_shards)
+        {
+            break;
+        }
+
+        //======================================
+        xit_errno = 0;
+    } while (0);
+
+    if (0 != xit_errno)
+    {
+        ntppoll_destroy(xpoll_ptr);
+        xpoll_ptr = X_NULL;
+        errno = xit_errno;
+    }
+
+    return xpoll_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 停止并销毁 NTP 轮询器。
+ */
+x_void_t ntppoll_destroy(xntp_pollptr_t xpoll_ptr)
+{
+    x_uint32_t     xut_iter   = 0;
+    x_uint32_t     xut_peer   = 0;
+    xntp_shard_t * xshard_ptr = X_NULL;
+    xntp_peer_t  * xpeer_ptr  = X_NULL;
+    xntp_peer_t  * xpeer_next = X_NULL;
+
+    if (X_NULL == xpoll_ptr)
+    {
+        return;
+    }
+
+    //======================================
+    // 通知并等待 分片线程 退出
+
+    XATOMIC_STORE32(&xpoll_ptr->xut_stop, 1);
+
+    if (X_NULL != xpoll_ptr->xbt_shards)
+    {
+        for (xut_iter = 0; xut_iter < xpoll_ptr->xconf.xut_shards; ++xut_iter)
+        {
+            xshard_ptr = XPOLL_SHARD(xpoll_ptr, xut_iter);
+            if (!xshard_ptr->xbt_running)
+            {
+                continue;
+            }
+
+#if (defined(_WIN32) || defined(_WIN64))
+            WaitForSingleObject(xshard_ptr->xthd_handle, INFINITE);
+            CloseHandle(xshard_ptr->xthd_handle);
+#else // !(defined(_WIN32) || defined(_WIN64))
+            pthread_join(xshard_ptr->xthd_handle, X_NULL);
+#endif // (defined(_WIN32) || defined(_WIN64))
+            xshard_ptr->xbt_running = X_FALSE;
+        }
+
+        //======================================
+        // 释放 分片资源 与 对端
+
+        for (xut_iter = 0; xut_iter < xpoll_ptr->xconf.xut_shards; ++xut_iter)
+        {
+            xshard_ptr = XPOLL_SHARD(xpoll_ptr, xut_iter);
+
+            for (xut_peer = 0; xut_peer < xshard_ptr->xut_count; ++xut_peer)
+            {
+                free(xshard_ptr->xpeer_list[xut_peer]);
+            }
+
+            for (xut_peer = 0; xut_peer < xshard_ptr->xut_nsym; ++xut_peer)
+            {
+                free(xshard_ptr->xsym_list[xut_peer]);
+            }
+
+            for (xpeer_ptr = xshard_ptr->xpeer_inbox; X_NULL != xpeer_ptr; xpeer_ptr = xpeer_next)
+            {
+                xpeer_next = xpeer_ptr->xpeer_next;
+                free(xpeer_ptr);
+            }
+
+            if (X_NULL != xshard_ptr->xpeer_list)
+                free(xshard_ptr->xpeer_list);
+            if (X_NULL != xshard_ptr->xsym_list)
+                free(xshard_ptr->xsym_list);
+            if (X_INVALID_SOCKFD != xshard_ptr->xfdt_symm)
+                ntp_poll_sock_close(xshard_ptr->xfdt_symm);
+            if (X_NULL != xshard_ptr->xsw_list)
+                free(xshard_ptr->xsw_list);
+            if (X_NULL != xshard_ptr->xsw_peer)
+                free(xshard_ptr->xsw_peer);
+            if (X_NULL != xshard_ptr->xntp_this)
+                ntpcli_close(xshard_ptr->xntp_this);
+        }
+
+        xcache_free(xpoll_ptr->xbt_shards);
+    }
+
+    free(xpoll_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 添加 需要轮询的对端（可在 启动前 或 运行中 调用，线程安全）。
+ * @note
+ * 新对端按 轮转方式 分配到各个分片，此后 各分片会根据负载 相互迁移对端。
+ *
+ * @param [in ] xpoll_ptr : NTP 轮询器。
+ * @param [in ] xut_ipv4  : 对端的 IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 对端的 端口号。
+ * @param [out] xut_peer  : 返回 对端标识（可为 X_NULL）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_add(
+                xntp_pollptr_t xpoll_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port,
+                x_uint32_t * xut_peer)
+{
+    xntp_peer_t * xpeer_ptr = X_NULL;
+
+    if (X_NULL == xpoll_ptr)
+    {
+        return EINVAL;
+    }
+
+    xpeer_ptr = ntp_peer_alloc(xpoll_ptr, xut_ipv4, xut_port, ntp_mode_client);
+    if (X_NULL == xpeer_ptr)
+    {
+        return ENOMEM;
+    }
+
+    if (X_NULL != xut_peer)
+    {
+        *xut_peer = xpeer_ptr->xut_peer;
+    }
+
+    ntp_shard_push(
+        XPOLL_SHARD(xpoll_ptr, XATOMIC_ADD32(&xpoll_ptr->xut_rrobin, 1) % xpoll_ptr->xconf.xut_shards),
+        xpeer_ptr);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 添加 对称模式（主动对等体）的 关联（可在 启动前 或 运行中 调用，线程安全）。
+ * @note
+ * 对称模式 的 关联 均由 第 0 个分片 经 对称模式 的 本地端口 收发，不参与 分片间的 迁移；
+ * 对端 应以 同样的方式 将 本端 配置为 对等体（或 启用 被动关联）。
+ * 每个轮询周期 发出一个报文，期间 收到的 每个 有效应答 各回调一次 样本；
+ * 整个周期 未得到样本 时，以 ETIMEDOUT 回调一次。
+ *
+ * @param [in ] xpoll_ptr : NTP 轮询器（须 已启用 对称模式，即 xut_sport 不为 0）。
+ * @param [in ] xut_ipv4  : 对等体的 IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 对等体的 对称模式 端口号。
+ * @param [out] xut_peer  : 返回 对端标识（可为 X_NULL）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_add_peer(
+                xntp_pollptr_t xpoll_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port,
+                x_uint32_t * xut_peer)
+{
+    xntp_peer_t * xpeer_ptr = X_NULL;
+
+    if ((X_NULL == xpoll_ptr) || (0 == xpoll_ptr->xconf.xut_sport) || (0 == xut_port))
+    {
+        return EINVAL;
+    }
+
+    xpeer_ptr = ntp_peer_alloc(xpoll_ptr, xut_ipv4, xut_port, ntp_mode_initiative);
+    if (X_NULL == xpeer_ptr)
+    {
+        return ENOMEM;
+    }
+
+    if (X_NULL != xut_peer)
+    {
+        *xut_peer = xpeer_ptr->xut_peer;
+    }
+
+    ntp_shard_push(XPOLL_SHARD(xpoll_ptr, XPOLL_SYM_SHARD), xpeer_ptr);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 启动 各个分片线程。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_start(xntp_pollptr_t xpoll_ptr)
+{
+    x_int32_t      xit_errno  = 0;
+    x_uint32_t     xut_iter   = 0;
+    xntp_shard_t * xshard_ptr = X_NULL;
+
+    if (X_NULL == xpoll_ptr)
+    {
+        return EINVAL;
+    }
+
+    if (xpoll_ptr->xbt_started)
+    {
+        return EALREADY;
+    }
+
+    for (xut_iter = 0; xut_iter < xpoll_ptr->xconf.xut_shards; ++xut_iter)
+    {
+        xshard_ptr = XPOLL_SHARD(xpoll_ptr, xut_iter);
+
+#if (defined(_WIN32) || defined(_WIN64))
+        xshard_ptr->xthd_handle = CreateThread(X_NULL, 0, ntp_shard_proc, xshard_ptr, 0, X_NULL);
+        if (X_NULL == xshard_ptr->xthd_handle)
+        {
+            xit_errno = (x_int32_t)GetLastError();
+            return xit_errno;
+        }
+#else // !(defined(_WIN32) || defined(_WIN64))
+        xit_errno = pthread_create(&xshard_ptr->xthd_handle, X_NULL, ntp_shard_proc, xshard_ptr);
+        if (0 != xit_errno)
+        {
+            return xit_errno;
+        }
+#endif // (defined(_WIN32) || defined(_WIN64))
+
+        xshard_ptr->xbt_running = X_TRUE;
+    }
+
+    xpoll_ptr->xbt_started = X_TRUE;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 获取 统计信息。
+ * @note
+ * 各分片的统计信息 只由 分片线程 自身写入，读取时 不会与之竞争缓存行的所有权。
+ *
+ * @param [in ] xpoll_ptr : NTP 轮询器。
+ * @param [in ] xit_shard : 分片索引号；取 -1 时，返回所有分片的 汇总信息。
+ * @param [out] xstat_ptr : 返回的 统计信息。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_stat(
+                xntp_pollptr_t xpoll_ptr,
+                x_int32_t xit_shard,
+                xntp_poll_stat_t * xstat_ptr)
+{
+    x_uint32_t         xut_iter = 0;
+    x_uint64_t         xut_lag  = 0;
+    xntp_poll_stat_t * xstat_src = X_NULL;
+
+    if ((X_NULL == xpoll_ptr) || (X_NULL == xstat_ptr) ||
+        (xit_shard < -1) || (xit_shard >= (x_int32_t)xpoll_ptr->xconf.xut_shards))
+    {
+        return EINVAL;
+    }
+
+    memset(xstat_ptr, 0, sizeof(xntp_poll_stat_t));
+
+    for (xut_iter = 0; xut_iter < xpoll_ptr->xconf.xut_shards; ++xut_iter)
+    {
+        if ((xit_shard >= 0) && ((x_uint32_t)xit_shard != xut_iter))
+        {
+            continue;
+        }
+
+        xstat_src = &XPOLL_SHARD(xpoll_ptr, xut_iter)->xstat;
+
+        xstat_ptr->xut_polls   += XATOMIC_LOAD64(&xstat_src->xut_polls  );
+        xstat_ptr->xut_replies += XATOMIC_LOAD64(&xstat_src->xut_replies);
+        xstat_ptr->xut_errors  += XATOMIC_LOAD64(&xstat_src->xut_errors );
+        xstat_ptr->xut_stolen  += XATOMIC_LOAD64(&xstat_src->xut_stolen );
+        xstat_ptr->xut_given   += XATOMIC_LOAD64(&xstat_src->xut_given  );
+        xstat_ptr->xut_sympkts += XATOMIC_LOAD64(&xstat_src->xut_sympkts);
+        xstat_ptr->xut_symdrop += XATOMIC_LOAD64(&xstat_src->xut_symdrop);
+        xstat_ptr->xut_peers   += XATOMIC_LOAD32(&xstat_src->xut_peers  );
+
+        xut_lag = XATOMIC_LOAD64(&xstat_src->xut_lag);
+        if (xut_lag > xstat_ptr->xut_lag)
+            xstat_ptr->xut_lag = xut_lag;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 分片数量。
+ */
+x_uint32_t ntppoll_shards(xntp_pollptr_t xpoll_ptr)
+{
+    return (X_NULL != xpoll_ptr) ? xpoll_ptr->xconf.xut_shards : 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,208 @@
+﻿/**
+ * @file ntp_poller.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 多核分片的 NTP 轮询器（大量服务端 的 周期性监测）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_POLLER_H__
+#define __NTP_POLLER_H__
+
+#include "ntp_client.h"
+#include "ntp_peer.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 定义 NTP 轮询器 的 指针类型 */
+typedef struct xntp_poller_t * xntp_pollptr_t;
+
+/**
+ * @struct xntp_poll_result_t
+ * @brief  单个服务端（对端）的一次 轮询结果。
+ */
+typedef struct xntp_poll_result_t
+{
+    x_uint32_t    xut_peer;      ///< 对端标识（ntppoll_add()、ntppoll_add_peer() 所返回的值，或 被动关联 的 新标识）
+    x_uint32_t    xut_ipv4;      ///< 对端的 IPv4 地址（主机字节序）
+    x_uint16_t    xut_port;      ///< 对端的 端口号
+    x_uint32_t    xut_shard;     ///< 执行本次轮询的 分片索引号
+    x_uint32_t    xut_mode;      ///< 本端模式（客户端轮询 为 ntp_mode_client，对称模式 为 ntp_mode_initiative 或 ntp_mode_passive）
+    x_int32_t     xit_errno;     ///< 本次轮询的 错误码（0 表示成功）
+    x_int64_t     xit_offset;    ///< 本地时钟 相对于 对端 的偏差（单位为 100 纳秒，成功时有效）
+    x_int64_t     xit_delay;     ///< 往返时延（单位为 100 纳秒，成功时有效）
+    xtime_vnsec_t xtm_4time[4];  ///< 本次轮询的 4 个相关时间戳
+} xntp_poll_result_t;
+
+/**
+ * @brief 轮询结果的 回调函数类型。
+ * @note
+ * 回调函数在 分片线程 中执行，同一对端的结果 同一时刻只会由一个分片回调，
+ * 但不同对端的结果 可能在多个线程中 并发回调；回调函数中 应避免长时间阻塞。
+ */
+typedef x_void_t (* xntp_poll_cbk_t)(x_pvoid_t xpvt_ctxt, const xntp_poll_result_t * xres_ptr);
+
+/**
+ * @struct xntp_poll_conf_t
+ * @brief  NTP 轮询器 的 工作参数。
+ */
+typedef struct xntp_poll_conf_t
+{
+    x_uint32_t      xut_shards;   ///< 分片（工作线程）数量，取 0 时为 在线的 CPU 核数
+    x_uint32_t      xut_period;   ///< 每个对端的 轮询周期（毫秒）
+    x_uint32_t      xut_tmout;    ///< 单次轮询的 超时时间（毫秒）
+    x_bool_t        xbt_affinity; ///< 是否将 分片线程 绑定到 各自的 CPU 核
+    xntp_poll_cbk_t xfunc_cbk;    ///< 轮询结果的 回调函数（可为 X_NULL）
+    x_pvoid_t       xpvt_ctxt;    ///< 回调函数的 上下文参数
+    xntp_keyptr_t   xkey_table;   ///< 密钥表（不认证时 可为 X_NULL）
+    x_uint32_t      xut_keyid;    ///< 认证所用的 key ID（客户端轮询 与 对称模式 共用；0 表示 不认证）
+    x_uint16_t      xut_sport;    ///< 对称模式 的 本地端口（取 0 时 不启用 对称模式）
+    x_bool_t        xbt_passive;  ///< 是否为 未配置的 主动对等体 建立 被动关联（并 回送报文）
+    x_uint32_t      xut_stratum;  ///< 对称模式 报文 所通告的 层数（取 0 时 为 16，即 未同步）
+} xntp_poll_conf_t;
+
+/**
+ * @struct xntp_poll_stat_t
+ * @brief  NTP 轮询器（或 其某个分片）的 统计信息。
+ */
+typedef struct xntp_poll_stat_t
+{
+    x_uint64_t xut_polls;    ///< 已发出的 轮询请求 数量
+    x_uint64_t xut_replies;  ///< 成功收到应答的 数量
+    x_uint64_t xut_errors;   ///< 失败（超时 等）的 数量
+    x_uint64_t xut_stolen;   ///< 从其他分片 迁入的 对端数量
+    x_uint64_t xut_given;    ///< 迁出到其他分片的 对端数量
+    x_uint64_t xut_lag;      ///< 最近一轮 最早到期的对端 的 滞后时长（100 纳秒；汇总时取最大值）
+    x_uint64_t xut_sympkts;  ///< 收到的 对称模式 报文 数量
+    x_uint64_t xut_symdrop;  ///< 被丢弃的 对称模式 报文 数量（无效、认证失败、重复、未知对端 等）
+    x_uint32_t xut_peers;    ///< 当前持有的 对端数量（不含 对称模式 的 关联）
+} xntp_poll_stat_t;
+
+/**********************************************************/
+/**
+ * @brief 创建 NTP 轮询器（分片线程 在 ntppoll_start() 时启动）。
+ *
+ * @param [in ] xconf_ptr : 工作参数。
+ *
+ * @return xntp_pollptr_t :
+ * 成功，返回 轮询器；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_pollptr_t ntppoll_create(const xntp_poll_conf_t * xconf_ptr);
+
+/**********************************************************/
+/**
+ * @brief 停止并销毁 NTP 轮询器。
+ */
+x_void_t ntppoll_destroy(xntp_pollptr_t xpoll_ptr);
+
+/**********************************************************/
+/**
+ * @brief 添加 需要轮询的对端（可在 启动前 或 运行中 调用，线程安全）。
+ * @note
+ * 新对端按 轮转方式 分配到各个分片，此后 各分片会根据负载 相互迁移对端。
+ *
+ * @param [in ] xpoll_ptr : NTP 轮询器。
+ * @param [in ] xut_ipv4  : 对端的 IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 对端的 端口号。
+ * @param [out] xut_peer  : 返回 对端标识（可为 X_NULL）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_add(
+                xntp_pollptr_t xpoll_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port,
+                x_uint32_t * xut_peer);
+
+/**********************************************************/
+/**
+ * @brief 添加 对称模式（主动对等体）的 关联（可在 启动前 或 运行中 调用，线程安全）。
+ * @note
+ * 对称模式 的 关联 均由 第 0 个分片 经 对称模式 的 本地端口 收发，不参与 分片间的 迁移；
+ * 对端 应以 同样的方式 将 本端 配置为 对等体（或 启用 被动关联）。
+ * 每个轮询周期 发出一个报文，期间 收到的 每个 有效应答 各回调一次 样本；
+ * 整个周期 未得到样本 时，以 ETIMEDOUT 回调一次。
+ *
+ * @param [in ] xpoll_ptr : NTP 轮询器（须 已启用 对称模式，即 xut_sport 不为 0）。
+ * @param [in ] xut_ipv4  : 对等体的 IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 对等体的 对称模式 端口号。
+ * @param [out] xut_peer  : 返回 对端标识（可为 X_NULL）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_add_peer(
+                xntp_pollptr_t xpoll_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port,
+                x_uint32_t * xut_peer);
+
+/**********************************************************/
+/**
+ * @brief 启动 各个分片线程。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_start(xntp_pollptr_t xpoll_ptr);
+
+/**********************************************************/
+/**
+ * @brief 获取 统计信息。
+ * @note
+ * 各分片的统计信息 只由 分片线程 自身写入，读取时 不会与之竞争缓存行的所有权。
+ *
+ * @param [in ] xpoll_ptr : NTP 轮询器。
+ * @param [in ] xit_shard : 分片索引号；取 -1 时，返回所有分片的 汇总信息。
+ * @param [out] xstat_ptr : 返回的 统计信息。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppoll_stat(
+                xntp_pollptr_t xpoll_ptr,
+                x_int32_t xit_shard,
+                xntp_poll_stat_t * xstat_ptr);
+
+/**********************************************************/
+/**
+ * @brief 返回 分片数量。
+ */
+x_uint32_t ntppoll_shards(xntp_pollptr_t xpoll_ptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_POLLER_H__
@@ -0,0 +1,1041 @@
+﻿/**
+ * @file ntp_pool.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 服务端池（候选地址 的 评分、择优 与 自动替换）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+#if (defined(_WIN32) || defined(_WIN64))
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <windows.h>
+#elif (defined(__linux__) || defined(__unix__))
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 内部数据类型
+// 
+
+/** 每轮 探测的 其他候选地址（非 活跃、非 备用）的 最大数量 */
+#define XPOOL_PROBE         32
+
+/** 单次批量请求 的 最大请求项 数量（活跃集合 + 备用集合 + 其他候选地址） */
+#define XPOOL_BATCH         (2 * XNTP_POOL_KMAX + XPOOL_PROBE)
+
+/** 挑战者 替换 活跃成员 所需的 最少 探测次数（预热） */
+#define XPOOL_WARM          4
+
+/** 判定 合格 的 可达性 掩码（最近 3 次 探测 至少 成功 1 次） */
+#define XPOOL_FIT_MASK      0x07
+
+/** 评分中，每一层数、每一次 探测失败 折算的 时间量 */
+#define XPOOL_STRATUM_COST  (1 * XTIME_VNSEC_MSEC)
+#define XPOOL_LOSS_COST     (20 * XTIME_VNSEC_MSEC)
+
+/** 重新解析 域名 的 最小间隔（5 分钟） */
+#define XPOOL_RESOLVE       (300 * 1000 * XTIME_VNSEC_MSEC)
+
+/** 候选地址 的 最大容量 */
+#define XPOOL_CAPACITY_MAX  (1 << 24)
+
+/** 登记的 域名 的 最大长度（含 编号前缀 与 结束符） */
+#define XPOOL_NAME_LEN      256
+
+/** 无效的 候选地址 索引号 */
+#define XPOOL_NONE          0xFFFFFFFF
+
+/** 候选地址 索引表 的 散列函数（与 批量请求 的 索引表 相同） */
+#define XPOOL_HASH(xipv4, xport, xmask) \
+    ((((x_uint32_t)(xipv4) * 0x9E3779B1U) ^ ((x_uint32_t)(xport) * 0x85EBCA6BU)) & (xmask))
+
+/**
+ * @struct xpool_host_t
+ * @brief  登记的 域名（用于 重新解析）。
+ */
+typedef struct xpool_host_t
+{
+    x_char_t   xszt_host[XPOOL_NAME_LEN]; ///< 域名
+    x_uint16_t xut_port;                  ///< 端口号
+    x_uint32_t xut_expand;                ///< 编号子域名 的 数量
+} xpool_host_t;
+
+/**
+ * @struct xntp_pool_t
+ * @brief  NTP 服务端池。
+ * @note
+ * 候选地址 以 紧凑数组 存放，按 (地址, 端口) 经 开放寻址 的 索引表（存放 索引号 + 1）查找；
+ * 活跃集合、备用集合 只记录 索引号，数组 整理（清理 不可达 的 候选地址）后 依 状态标识 重建。
+ */
+struct xntp_pool_t
+{
+    xntp_cliptr_t  xntp_this;                       ///< 用于 探测的 NTP 客户端工作对象
+    x_uint32_t     xut_kactive;                     ///< 活跃集合 的 大小 K
+    x_uint32_t     xut_capacity;                    ///< 候选地址 的 容量
+    x_uint32_t     xut_count;                       ///< 候选地址 的 数量
+    x_uint32_t     xut_cursor;                      ///< 轮转探测 的 游标
+    xntp_cand_t  * xcand_list;                      ///< 候选地址 数组
+    x_uint32_t     xut_hmask;                       ///< 索引表 容量 的 掩码
+    x_uint32_t   * xut_htable;                      ///< 索引表
+
+    x_uint32_t     xut_nactive;                     ///< 活跃成员 的 数量
+    x_uint32_t     xut_alist[XNTP_POOL_KMAX];       ///< 活跃成员 的 索引号
+    x_uint32_t     xut_nstandby;                    ///< 备用成员 的 数量
+    x_uint32_t     xut_slist[XNTP_POOL_KMAX];       ///< 备用成员 的 索引号
+
+    x_uint32_t     xut_heap[2 * XNTP_POOL_KMAX];    ///< 择优时 的 候选 索引号（最大堆，排序后 由优到劣）
+    x_uint32_t     xut_hscore[2 * XNTP_POOL_KMAX];  ///< 与 xut_heap 对应的 评分
+
+    x_uint32_t     xut_slot[XPOOL_BATCH];           ///< 批量请求项 对应的 候选地址 索引号
+    xntp_sweep_t   xsw_list[XPOOL_BATCH];           ///< 批量请求项
+
+    x_uint32_t     xut_nhost;                       ///< 登记的 域名 数量
+    xtime_vnsec_t  xtm_resolve;                     ///< 最近一次 解析 域名 的 时间（单调时钟）
+    xpool_host_t   xhost_list[XNTP_POOL_HOSTS];     ///< 登记的 域名
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 内部相关操作接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 判断 候选地址 是否合格（已有样本，最近 3 次 探测 至少 成功 1 次，且 层数 有效）。
+ */
+static inline x_bool_t ntppool_fit(const xntp_cand_t * xcand_ptr)
+{
+    return (0 != (xcand_ptr->xut_flags & XNTP_CAND_SAMPLED)) &&
+           (0 != (xcand_ptr->xut_reach & XPOOL_FIT_MASK)) &&
+           (xcand_ptr->xut_stratum >= 1) && (xcand_ptr->xut_stratum <= 15);
+}
+
+/**********************************************************/
+/**
+ * @brief 查找 候选地址 的 索引号（不存在 时 返回 XPOOL_NONE）。
+ */
+static x_uint32_t ntppool_lookup(xntp_poolptr_t xpool_ptr, x_uint32_t xut_ipv4, x_uint16_t xut_port)
+{
+    x_uint32_t    xut_hpos  = XPOOL_HASH(xut_ipv4, xut_port, xpool_ptr->xut_hmask);
+    xntp_cand_t * xcand_ptr = X_NULL;
+
+    while (0 != xpool_ptr->xut_htable[xut_hpos])
+    {
+        xcand_ptr = &xpool_ptr->xcand_list[xpool_ptr->xut_htable[xut_hpos] - 1];
+        if ((xcand_ptr->xut_ipv4 == xut_ipv4) && (xcand_ptr->xut_port == xut_port))
+        {
+            return (xpool_ptr->xut_htable[xut_hpos] - 1);
+        }
+
+        xut_hpos = (xut_hpos + 1) & xpool_ptr->xut_hmask;
+    }
+
+    return XPOOL_NONE;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 候选地址 的 索引号 加入 索引表。
+ */
+static x_void_t ntppool_hash_put(xntp_poolptr_t xpool_ptr, x_uint32_t xut_index)
+{
+    x_uint32_t xut_hpos = XPOOL_HASH(xpool_ptr->xcand_list[xut_index].xut_ipv4,
+                                     xpool_ptr->xcand_list[xut_index].xut_port,
+                                     xpool_ptr->xut_hmask);
+
+    while (0 != xpool_ptr->xut_htable[xut_hpos])
+    {
+        xut_hpos = (xut_hpos + 1) & xpool_ptr->xut_hmask;
+    }
+
+    xpool_ptr->xut_htable[xut_hpos] = xut_index + 1;
+}
+
+/**********************************************************/
+/**
+ * @brief 清理 持续不可达 的 候选地址（非 活跃、非 备用，已探测过 且 最近的 探测 全部失败），
+ *        然后 重建 索引表 与 活跃、备用集合 的 索引号。
+ *
+ * @return x_uint32_t : 返回 清理的 数量。
+ */
+static x_uint32_t ntppool_compact(xntp_poolptr_t xpool_ptr)
+{
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_keep  = 0;
+    x_uint32_t    xut_drop  = 0;
+    xntp_cand_t * xcand_ptr = X_NULL;
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_count; ++xut_iter)
+    {
+        xcand_ptr = &xpool_ptr->xcand_list[xut_iter];
+        if ((0 == (xcand_ptr->xut_flags & (XNTP_CAND_ACTIVE | XNTP_CAND_STANDBY))) &&
+            (0 != xcand_ptr->xut_probes) &&
+            (0 == xcand_ptr->xut_reach))
+        {
+            continue;
+        }
+
+        if (xut_keep != xut_iter)
+        {
+            xpool_ptr->xcand_list[xut_keep] = *xcand_ptr;
+        }
+        xut_keep += 1;
+    }
+
+    xut_drop = xpool_ptr->xut_count - xut_keep;
+    if (0 == xut_drop)
+    {
+        return 0;
+    }
+
+    //======================================
+
+    xpool_ptr->xut_count    = xut_keep;
+    xpool_ptr->xut_cursor   = 0;
+    xpool_ptr->xut_nactive  = 0;
+    xpool_ptr->xut_nstandby = 0;
+    memset(xpool_ptr->xut_htable, 0, (xpool_ptr->xut_hmask + 1) * sizeof(x_uint32_t));
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_count; ++xut_iter)
+    {
+        ntppool_hash_put(xpool_ptr, xut_iter);
+
+        if (0 != (xpool_ptr->xcand_list[xut_iter].xut_flags & XNTP_CAND_ACTIVE))
+            xpool_ptr->xut_alist[xpool_ptr->xut_nactive++] = xut_iter;
+        else if (0 != (xpool_ptr->xcand_list[xut_iter].xut_flags & XNTP_CAND_STANDBY))
+            xpool_ptr->xut_slist[xpool_ptr->xut_nstandby++] = xut_iter;
+    }
+
+    return xut_drop;
+}
+
+/**********************************************************/
+/**
+ * @brief 添加 候选地址（内部接口，不检查 参数）。
+ *
+ * @return x_int32_t : 成功，返回 0；已存在 返回 EEXIST；容量已满 返回 ENOSPC。
+ */
+static x_int32_t ntppool_insert(xntp_poolptr_t xpool_ptr, x_uint32_t xut_ipv4, x_uint16_t xut_port)
+{
+    xntp_cand_t * xcand_ptr = X_NULL;
+
+    if (XPOOL_NONE != ntppool_lookup(xpool_ptr, xut_ipv4, xut_port))
+    {
+        return EEXIST;
+    }
+
+    if ((xpool_ptr->xut_count >= xpool_ptr->xut_capacity) &&
+        (0 == ntppool_compact(xpool_ptr)))
+    {
+        return ENOSPC;
+    }
+
+    xcand_ptr = &xpool_ptr->xcand_list[xpool_ptr->xut_count];
+    memset(xcand_ptr, 0, sizeof(xntp_cand_t));
+    xcand_ptr->xut_ipv4 = xut_ipv4;
+    xcand_ptr->xut_port = xut_port;
+
+    ntppool_hash_put(xpool_ptr, xpool_ptr->xut_count);
+    xpool_ptr->xut_count += 1;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 单个域名，将 其 全部 IPv4 地址 添加为 候选地址。
+ *
+ * @param [in    ] xpool_ptr : NTP 服务端池。
+ * @param [in    ] xszt_name : 域名。
+ * @param [in    ] xut_port  : 端口号。
+ * @param [in,out] xut_added : 累加 新增的 候选地址 数量。
+ * @param [in,out] xbt_full  : 有 地址 因 容量已满 而 未能添加 时，置为 X_TRUE。
+ *
+ * @return x_int32_t : 解析成功，返回 0；否则 返回 EHOSTUNREACH。
+ */
+static x_int32_t ntppool_resolve(
+                    xntp_poolptr_t xpool_ptr,
+                    x_cstring_t xszt_name,
+                    x_uint16_t xut_port,
+                    x_uint32_t * xut_added,
+                    x_bool_t * xbt_full)
+{
+    struct addrinfo   xai_hint;
+    struct addrinfo * xai_rptr = X_NULL;
+    struct addrinfo * xai_iptr = X_NULL;
+
+    memset(&xai_hint, 0, sizeof(xai_hint));
+    xai_hint.ai_family   = AF_INET;
+    xai_hint.ai_socktype = SOCK_DGRAM;
+
+    if (0 != getaddrinfo(xszt_name, X_NULL, &xai_hint, &xai_rptr))
+    {
+        return EHOSTUNREACH;
+    }
+
+    for (xai_iptr = xai_rptr; X_NULL != xai_iptr; xai_iptr = xai_iptr->ai_next)
+    {
+        if (AF_INET != xai_iptr->ai_family)
+        {
+            continue;
+        }
+
+        switch (ntppool_insert(xpool_ptr,
+                               ntohl(((struct sockaddr_in *)(xai_iptr->ai_addr))->sin_addr.s_addr),
+                               xut_port))
+        {
+        case 0      : *xut_added += 1;     break;
+        case ENOSPC : *xbt_full = X_TRUE; break;
+        default     :                      break;
+        }
+    }
+
+    freeaddrinfo(xai_rptr);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 登记的 域名 及其 编号子域名。
+ *
+ * @return x_int32_t : 参看 ntppool_add_host() 的 返回值。
+ */
+static x_int32_t ntppool_resolve_host(
+                    xntp_poolptr_t xpool_ptr,
+                    const xpool_host_t * xhost_ptr,
+                    x_uint32_t * xut_added)
+{
+    x_char_t   xszt_name[XPOOL_NAME_LEN + 16];
+    x_uint32_t xut_iter  = 0;
+    x_uint32_t xut_okay  = 0;
+    x_bool_t   xbt_full  = X_FALSE;
+
+    *xut_added = 0;
+
+    if (0 == ntppool_resolve(xpool_ptr, xhost_ptr->xszt_host, xhost_ptr->xut_port, xut_added, &xbt_full))
+    {
+        xut_okay += 1;
+    }
+
+    for (xut_iter = 0; xut_iter < xhost_ptr->xut_expand; ++xut_iter)
+    {
+        snprintf(xszt_name, sizeof(xszt_name), "%u.%s", xut_iter, xhost_ptr->xszt_host);
+        if (0 == ntppool_resolve(xpool_ptr, xszt_name, xhost_ptr->xut_port, xut_added, &xbt_full))
+        {
+            xut_okay += 1;
+        }
+    }
+
+    if (0 == xut_okay)
+    {
+        return EHOSTUNREACH;
+    }
+
+    return ((0 == *xut_added) && xbt_full) ? ENOSPC : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 一次探测的 结果 更新 候选地址 的 统计信息。
+ */
+static x_void_t ntppool_sample(xntp_cand_t * xcand_ptr, const xntp_sweep_t * xsw_item)
+{
+    x_bool_t  xbt_good   = X_FALSE;
+    x_int64_t xit_delay  = 0;
+    x_int64_t xit_offset = 0;
+    x_int64_t xit_diff   = 0;
+
+    if (xcand_ptr->xut_probes < 0xFF)
+    {
+        xcand_ptr->xut_probes += 1;
+    }
+
+    if (0 == xsw_item->xit_errno)
+    {
+        xcand_ptr->xut_stratum = (x_uint8_t)xsw_item->xut_stratum;
+        xbt_good = (xsw_item->xut_stratum >= 1) && (xsw_item->xut_stratum <= 15) && (3 != xsw_item->xut_leap);
+    }
+
+    xcand_ptr->xut_reach = (x_uint8_t)((xcand_ptr->xut_reach << 1) | (xbt_good ? 1 : 0));
+    if (!xbt_good)
+    {
+        return;
+    }
+
+    //======================================
+
+    xit_delay  = (x_int64_t)(xsw_item->xtm_4time[3] - xsw_item->xtm_4time[0]) -
+                 (x_int64_t)(xsw_item->xtm_4time[2] - xsw_item->xtm_4time[1]);
+    xit_offset = ((x_int64_t)(xsw_item->xtm_4time[1] - xsw_item->xtm_4time[0]) +
+                  (x_int64_t)(xsw_item->xtm_4time[2] - xsw_item->xtm_4time[3])) / 2;
+
+    if (xit_delay < 0)
+        xit_delay = 0;
+    else if (xit_delay > 0x7FFFFFFF)
+        xit_delay = 0x7FFFFFFF;
+
+    if (xit_offset > 0x7FFFFFFF)
+        xit_offset = 0x7FFFFFFF;
+    else if (xit_offset < -0x7FFFFFFF)
+        xit_offset = -0x7FFFFFFF;
+
+    if (0 == (xcand_ptr->xut_flags & XNTP_CAND_SAMPLED))
+    {
+        xcand_ptr->xut_flags  |= XNTP_CAND_SAMPLED;
+        xcand_ptr->xut_delay   = (x_uint32_t)xit_delay;
+        xcand_ptr->xut_jitter  = 0;
+        xcand_ptr->xit_offset  = (x_int32_t)xit_offset;
+        return;
+    }
+
+    // 时延 与 抖动 均以 1/4 的 增益 做 指数平滑
+    xit_diff = xit_offset - xcand_ptr->xit_offset;
+    if (xit_diff < 0)
+        xit_diff = -xit_diff;
+
+    xcand_ptr->xut_delay  = (x_uint32_t)((x_int64_t)xcand_ptr->xut_delay +
+                                         (xit_delay - (x_int64_t)xcand_ptr->xut_delay) / 4);
+    xcand_ptr->xut_jitter = (x_uint32_t)((x_int64_t)xcand_ptr->xut_jitter +
+                                         (xit_diff - (x_int64_t)xcand_ptr->xut_jitter) / 4);
+    xcand_ptr->xit_offset = (x_int32_t)xit_offset;
+}
+
+/**********************************************************/
+/**
+ * @brief 比较 两个 候选地址 的 优劣（评分 相同 时，索引号 小者 为优）。
+ *
+ * @return x_bool_t : 前者 劣于 后者 时，返回 X_TRUE。
+ */
+static inline x_bool_t ntppool_worse(
+                            x_uint32_t xut_lscore,
+                            x_uint32_t xut_lindex,
+                            x_uint32_t xut_rscore,
+                            x_uint32_t xut_rindex)
+{
+    return (xut_lscore > xut_rscore) || ((xut_lscore == xut_rscore) && (xut_lindex > xut_rindex));
+}
+
+/**********************************************************/
+/**
+ * @brief 选出 评分 最优 的 至多 xut_limit 个 合格候选地址，由优到劣 存放于 xut_heap、xut_hscore。
+ * @note
+ * 以 大小为 xut_limit 的 最大堆 遍历 全部候选地址，时间复杂度 为 O(n log K)。
+ *
+ * @return x_uint32_t : 返回 选出的 数量。
+ */
+static x_uint32_t ntppool_best(xntp_poolptr_t xpool_ptr, x_uint32_t xut_limit)
+{
+    x_uint32_t * xut_heap   = xpool_ptr->xut_heap;
+    x_uint32_t * xut_hscore = xpool_ptr->xut_hscore;
+    x_uint32_t   xut_nheap  = 0;
+    x_uint32_t   xut_iter   = 0;
+    x_uint32_t   xut_score  = 0;
+    x_uint32_t   xut_ipos   = 0;
+    x_uint32_t   xut_next   = 0;
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_count; ++xut_iter)
+    {
+        xut_score = ntppool_score(&xpool_ptr->xcand_list[xut_iter]);
+        if (XNTP_POOL_UNFIT == xut_score)
+        {
+            continue;
+        }
+
+        if (xut_nheap < xut_limit)
+        {
+            // 上浮
+            for (xut_ipos = xut_nheap++; xut_ipos > 0; xut_ipos = xut_next)
+            {
+                xut_next = (xut_ipos - 1) / 2;
+                if (!ntppool_worse(xut_score, xut_iter, xut_hscore[xut_next], xut_heap[xut_next]))
+                    break;
+                xut_heap  [xut_ipos] = xut_heap  [xut_next];
+                xut_hscore[xut_ipos] = xut_hscore[xut_next];
+            }
+        }
+        else if (ntppool_worse(xut_hscore[0], xut_heap[0], xut_score, xut_iter))
+        {
+            // 替换 堆顶（当前 最劣者）后 下沉
+            for (xut_ipos = 0; (2 * xut_ipos + 1) < xut_nheap; xut_ipos = xut_next)
+            {
+                xut_next = 2 * xut_ipos + 1;
+                if (((xut_next + 1) < xut_nheap) &&
+                    ntppool_worse(xut_hscore[xut_next + 1], xut_heap[xut_next + 1],
+                                  xut_hscore[xut_next], xut_heap[xut_next]))
+                {
+                    xut_next += 1;
+                }
+
+                if (!ntppool_worse(xut_hscore[xut_next], xut_heap[xut_next], xut_score, xut_iter))
+                    break;
+                xut_heap  [xut_ipos] = xut_heap  [xut_next];
+                xut_hscore[xut_ipos] = xut_hscore[xut_next];
+            }
+        }
+        else
+        {
+            continue;
+        }
+
+        xut_heap  [xut_ipos] = xut_iter;
+        xut_hscore[xut_ipos] = xut_score;
+    }
+
+    //======================================
+    // 至多 2 * XNTP_POOL_KMAX 项，插入排序 即可
+
+    for (xut_iter = 1; xut_iter < xut_nheap; ++xut_iter)
+    {
+        xut_score = xut_hscore[xut_iter];
+        xut_next  = xut_heap[xut_iter];
+
+        for (xut_ipos = xut_iter;
+             (xut_ipos > 0) &&
+             ntppool_worse(xut_hscore[xut_ipos - 1], xut_heap[xut_ipos - 1], xut_score, xut_next);
+             --xut_ipos)
+        {
+            xut_heap  [xut_ipos] = xut_heap  [xut_ipos - 1];
+            xut_hscore[xut_ipos] = xut_hscore[xut_ipos - 1];
+        }
+
+        xut_heap  [xut_ipos] = xut_next;
+        xut_hscore[xut_ipos] = xut_score;
+    }
+
+    return xut_nheap;
+}
+
+/**********************************************************/
+/**
+ * @brief 重新选择 活跃集合 与 备用集合。
+ * @note
+ * 1. 移出 不合格 的 活跃成员；
+ * 2. 以 最优的 非活跃 合格候选地址 补足 K 个；
+ * 3. 最优的 已预热 挑战者 优于 最劣的 活跃成员 25% 以上 时，二者 交换（重复 至 不再满足）；
+ * 4. 其余 最优的 至多 K 个 合格候选地址 作为 备用集合。
+ */
+static x_void_t ntppool_select(xntp_poolptr_t xpool_ptr)
+{
+    xntp_cand_t * xcand_list = xpool_ptr->xcand_list;
+    x_uint32_t    xut_nbest  = 0;
+    x_uint32_t    xut_iter   = 0;
+    x_uint32_t    xut_keep   = 0;
+    x_uint32_t    xut_worst  = 0;
+    x_uint32_t    xut_wscore = 0;
+    x_uint32_t    xut_score  = 0;
+
+    xut_nbest = ntppool_best(xpool_ptr, 2 * xpool_ptr->xut_kactive);
+
+    //======================================
+    // 移出 不合格 的 活跃成员
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_nactive; ++xut_iter)
+    {
+        if (ntppool_fit(&xcand_list[xpool_ptr->xut_alist[xut_iter]]))
+            xpool_ptr->xut_alist[xut_keep++] = xpool_ptr->xut_alist[xut_iter];
+        else
+            xcand_list[xpool_ptr->xut_alist[xut_iter]].xut_flags &= ~XNTP_CAND_ACTIVE;
+    }
+
+    xpool_ptr->xut_nactive = xut_keep;
+
+    //======================================
+    // 补足 活跃集合
+
+    for (xut_iter = 0;
+         (xut_iter < xut_nbest) && (xpool_ptr->xut_nactive < xpool_ptr->xut_kactive);
+         ++xut_iter)
+    {
+        if (0 == (xcand_list[xpool_ptr->xut_heap[xut_iter]].xut_flags & XNTP_CAND_ACTIVE))
+        {
+            xcand_list[xpool_ptr->xut_heap[xut_iter]].xut_flags |= XNTP_CAND_ACTIVE;
+            xpool_ptr->xut_alist[xpool_ptr->xut_nactive++] = xpool_ptr->xut_heap[xut_iter];
+        }
+    }
+
+    //======================================
+    // 带 滞后 的 替换
+
+    for (;;)
+    {
+        xut_wscore = 0;
+        for (xut_keep = 0; xut_keep < xpool_ptr->xut_nactive; ++xut_keep)
+        {
+            xut_score = ntppool_score(&xcand_list[xpool_ptr->xut_alist[xut_keep]]);
+            if ((0 == xut_keep) || (xut_score > xut_wscore))
+            {
+                xut_worst  = xut_keep;
+                xut_wscore = xut_score;
+            }
+        }
+
+        for (xut_iter = 0; xut_iter < xut_nbest; ++xut_iter)
+        {
+            if ((0 == (xcand_list[xpool_ptr->xut_heap[xut_iter]].xut_flags & XNTP_CAND_ACTIVE)) &&
+                (xcand_list[xpool_ptr->xut_heap[xut_iter]].xut_probes >= XPOOL_WARM))
+            {
+                break;
+            }
+        }
+
+        if ((0 == xpool_ptr->xut_nactive) || (xut_iter >= xut_nbest) ||
+            ((x_uint64_t)xpool_ptr->xut_hscore[xut_iter] * 4 >= (x_uint64_t)xut_wscore * 3))
+        {
+            break;
+        }
+
+        xcand_list[xpool_ptr->xut_alist[xut_worst]].xut_flags &= ~XNTP_CAND_ACTIVE;
+        xcand_list[xpool_ptr->xut_heap[xut_iter]].xut_flags   |= XNTP_CAND_ACTIVE;
+        xpool_ptr->xut_alist[xut_worst] = xpool_ptr->xut_heap[xut_iter];
+    }
+
+    //======================================
+    // 备用集合
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_nstandby; ++xut_iter)
+    {
+        xcand_list[xpool_ptr->xut_slist[xut_iter]].xut_flags &= ~XNTP_CAND_STANDBY;
+    }
+
+    xpool_ptr->xut_nstandby = 0;
+    for (xut_iter = 0;
+         (xut_iter < xut_nbest) && (xpool_ptr->xut_nstandby < xpool_ptr->xut_kactive);
+         ++xut_iter)
+    {
+        if (0 == (xcand_list[xpool_ptr->xut_heap[xut_iter]].xut_flags & XNTP_CAND_ACTIVE))
+        {
+            xcand_list[xpool_ptr->xut_heap[xut_iter]].xut_flags |= XNTP_CAND_STANDBY;
+            xpool_ptr->xut_slist[xpool_ptr->xut_nstandby++] = xpool_ptr->xut_heap[xut_iter];
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// 
+// 外部相关操作接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 创建 NTP 服务端池。
+ */
+xntp_poolptr_t ntppool_create(
+                    xntp_cliptr_t xntp_this,
+                    x_uint32_t xut_active,
+                    x_uint32_t xut_capacity)
+{
+    x_int32_t      xit_errno = EPERM;
+    xntp_poolptr_t xpool_ptr = X_NULL;
+
+    if (0 == xut_active)
+        xut_active = XNTP_POOL_ACTIVE;
+    if (0 == xut_capacity)
+        xut_capacity = XNTP_POOL_CAPACITY;
+
+    if ((X_NULL == xntp_this) ||
+        (xut_active > XNTP_POOL_KMAX) ||
+        (xut_capacity > XPOOL_CAPACITY_MAX))
+    {
+        errno = EINVAL;
+        return X_NULL;
+    }
+
+    do
+    {
+        xpool_ptr = (xntp_poolptr_t)calloc(1, sizeof(struct xntp_pool_t));
+        if (X_NULL == xpool_ptr)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        xpool_ptr->xntp_this    = xntp_this;
+        xpool_ptr->xut_kactive  = xut_active;
+        xpool_ptr->xut_capacity = xut_capacity;
+        xpool_ptr->xtm_resolve  = XTIME_INVALID_VNSEC;
+
+        xpool_ptr->xcand_list = (xntp_cand_t *)malloc(xut_capacity * sizeof(xntp_cand_t));
+        if (X_NULL == xpool_ptr->xcand_list)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        // 索引表的容量 取 不小于 2 倍容量 的 2 的幂
+        for (xpool_ptr->xut_hmask = 1; xpool_ptr->xut_hmask < (xut_capacity * 2); xpool_ptr->xut_hmask <<= 1)
+        {
+        }
+
+        xpool_ptr->xut_htable = (x_uint32_t *)calloc(xpool_ptr->xut_hmask, sizeof(x_uint32_t));
+        if (X_NULL == xpool_ptr->xut_htable)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        xpool_ptr->xut_hmask -= 1;
+
+        //======================================
+        xit_errno = 0;
+    } while (0);
+
+    if (0 != xit_errno)
+    {
+        ntppool_destroy(xpool_ptr);
+        xpool_ptr = X_NULL;
+        errno = xit_errno;
+    }
+
+    return xpool_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁 NTP 服务端池。
+ */
+x_void_t ntppool_destroy(xntp_poolptr_t xpool_ptr)
+{
+    if (X_NULL == xpool_ptr)
+    {
+        return;
+    }
+
+    if (X_NULL != xpool_ptr->xut_htable)
+    {
+        free(xpool_ptr->xut_htable);
+        xpool_ptr->xut_htable = X_NULL;
+    }
+
+    if (X_NULL != xpool_ptr->xcand_list)
+    {
+        free(xpool_ptr->xcand_list);
+        xpool_ptr->xcand_list = X_NULL;
+    }
+
+    free(xpool_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 域名 并 添加 其 全部 IPv4 地址 为 候选地址。
+ */
+x_int32_t ntppool_add_host(
+                xntp_poolptr_t xpool_ptr,
+                x_cstring_t xszt_host,
+                x_uint16_t xut_port,
+                x_uint32_t xut_expand,
+                x_uint32_t * xut_added)
+{
+    xpool_host_t   xhost_temp;
+    x_uint32_t     xut_iter  = 0;
+    x_uint32_t     xut_count = 0;
+    x_int32_t      xit_errno = 0;
+
+    if ((X_NULL == xpool_ptr) || (X_NULL == xszt_host) || ('\0' == xszt_host[0]) ||
+        (strlen(xszt_host) >= XPOOL_NAME_LEN) || (0 == xut_port) || (xut_expand > 100))
+    {
+        return EINVAL;
+    }
+
+    memset(&xhost_temp, 0, sizeof(xpool_host_t));
+    strcpy(xhost_temp.xszt_host, xszt_host);
+    xhost_temp.xut_port   = xut_port;
+    xhost_temp.xut_expand = xut_expand;
+
+    xit_errno = ntppool_resolve_host(xpool_ptr, &xhost_temp, &xut_count);
+    xpool_ptr->xtm_resolve = time_mono();
+
+    if (X_NULL != xut_added)
+    {
+        *xut_added = xut_count;
+    }
+
+    if (EHOSTUNREACH == xit_errno)
+    {
+        return xit_errno;
+    }
+
+    //======================================
+    // 登记 域名（已登记 的 更新 编号子域名 的 数量）
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_nhost; ++xut_iter)
+    {
+        if ((xut_port == xpool_ptr->xhost_list[xut_iter].xut_port) &&
+            (0 == strcmp(xszt_host, xpool_ptr->xhost_list[xut_iter].xszt_host)))
+        {
+            xpool_ptr->xhost_list[xut_iter].xut_expand = xut_expand;
+            break;
+        }
+    }
+
+    if ((xut_iter >= xpool_ptr->xut_nhost) && (xpool_ptr->xut_nhost < XNTP_POOL_HOSTS))
+    {
+        xpool_ptr->xhost_list[xpool_ptr->xut_nhost++] = xhost_temp;
+    }
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 添加 候选地址。
+ */
+x_int32_t ntppool_add_addr(
+                xntp_poolptr_t xpool_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port)
+{
+    if ((X_NULL == xpool_ptr) || (0 == xut_ipv4) || (0 == xut_port))
+    {
+        return EINVAL;
+    }
+
+    return ntppool_insert(xpool_ptr, xut_ipv4, xut_port);
+}
+
+/**********************************************************/
+/**
+ * @brief 执行 一轮 探测，更新 各候选地址 的 统计信息，并 重新选择 活跃集合。
+ */
+x_int32_t ntppool_update(xntp_poolptr_t xpool_ptr, xtime_vnsec_t xtm_dline)
+{
+    x_int32_t  xit_errno = 0;
+    x_uint32_t xut_batch = 0;
+    x_uint32_t xut_probe = 0;
+    x_uint32_t xut_iter  = 0;
+    x_uint32_t xut_added = 0;
+
+    if (X_NULL == xpool_ptr)
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 活跃集合、备用集合，以及 自游标起 轮转选取的 其他候选地址
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_nactive; ++xut_iter)
+        xpool_ptr->xut_slot[xut_batch++] = xpool_ptr->xut_alist[xut_iter];
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_nstandby; ++xut_iter)
+        xpool_ptr->xut_slot[xut_batch++] = xpool_ptr->xut_slist[xut_iter];
+
+    for (xut_iter = 0; (xut_iter < xpool_ptr->xut_count) && (xut_probe < XPOOL_PROBE); ++xut_iter)
+    {
+        if (xpool_ptr->xut_cursor >= xpool_ptr->xut_count)
+        {
+            xpool_ptr->xut_cursor = 0;
+        }
+
+        if (0 == (xpool_ptr->xcand_list[xpool_ptr->xut_cursor].xut_flags &
+                  (XNTP_CAND_ACTIVE | XNTP_CAND_STANDBY)))
+        {
+            xpool_ptr->xut_slot[xut_batch++] = xpool_ptr->xut_cursor;
+            xut_probe += 1;
+        }
+
+        xpool_ptr->xut_cursor += 1;
+    }
+
+    //======================================
+
+    if (xut_batch > 0)
+    {
+        for (xut_iter = 0; xut_iter < xut_batch; ++xut_iter)
+        {
+            xpool_ptr->xsw_list[xut_iter].xut_ipv4  = xpool_ptr->xcand_list[xpool_ptr->xut_slot[xut_iter]].xut_ipv4;
+            xpool_ptr->xsw_list[xut_iter].xut_port  = xpool_ptr->xcand_list[xpool_ptr->xut_slot[xut_iter]].xut_port;
+            xpool_ptr->xsw_list[xut_iter].xut_keyid = 0;
+        }
+
+        xit_errno = ntpcli_req_sweep(xpool_ptr->xntp_this, xpool_ptr->xsw_list, xut_batch, xtm_dline);
+        if (0 != xit_errno)
+        {
+            return xit_errno;
+        }
+
+        for (xut_iter = 0; xut_iter < xut_batch; ++xut_iter)
+        {
+            ntppool_sample(&xpool_ptr->xcand_list[xpool_ptr->xut_slot[xut_iter]], &xpool_ptr->xsw_list[xut_iter]);
+        }
+    }
+
+    ntppool_select(xpool_ptr);
+
+    //======================================
+    // 活跃集合 不足 K 个 时，重新解析 登记的 域名（新地址 在 后续各轮 中 探测）
+
+    if ((xpool_ptr->xut_nactive < xpool_ptr->xut_kactive) &&
+        (xpool_ptr->xut_nhost > 0) &&
+        (!XTMVNSEC_IS_VALID(xpool_ptr->xtm_resolve) ||
+         ((time_mono() - xpool_ptr->xtm_resolve) >= XPOOL_RESOLVE)))
+    {
+        for (xut_iter = 0; xut_iter < xpool_ptr->xut_nhost; ++xut_iter)
+        {
+            ntppool_resolve_host(xpool_ptr, &xpool_ptr->xhost_list[xut_iter], &xut_added);
+        }
+
+        xpool_ptr->xtm_resolve = time_mono();
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 获取 活跃集合（按 评分 由优到劣 排列）。
+ */
+x_uint32_t ntppool_active(
+                xntp_poolptr_t xpool_ptr,
+                xntp_cand_t * xcand_list,
+                x_uint32_t xut_count)
+{
+    x_uint32_t  xut_iter  = 0;
+    x_uint32_t  xut_ipos  = 0;
+    x_uint32_t  xut_score = 0;
+    xntp_cand_t xcand_temp;
+
+    if ((X_NULL == xpool_ptr) || (X_NULL == xcand_list))
+    {
+        return 0;
+    }
+
+    if (xut_count > xpool_ptr->xut_nactive)
+    {
+        xut_count = xpool_ptr->xut_nactive;
+    }
+
+    //======================================
+    // 活跃成员 至多 XNTP_POOL_KMAX 个，插入排序 即可（只保留 前 xut_count 个）
+
+    for (xut_iter = 0; xut_iter < xpool_ptr->xut_nactive; ++xut_iter)
+    {
+        xcand_temp = xpool_ptr->xcand_list[xpool_ptr->xut_alist[xut_iter]];
+        xut_score  = ntppool_score(&xcand_temp);
+
+        xut_ipos = (xut_iter < xut_count) ? xut_iter : xut_count;
+        while ((xut_ipos > 0) && (ntppool_score(&xcand_list[xut_ipos - 1]) > xut_score))
+        {
+            if (xut_ipos < xut_count)
+                xcand_list[xut_ipos] = xcand_list[xut_ipos - 1];
+            xut_ipos -= 1;
+        }
+
+        if (xut_ipos < xut_count)
+        {
+            xcand_list[xut_ipos] = xcand_temp;
+        }
+    }
+
+    return xut_count;
+}
+
+/**********************************************************/
+/**
+ * @brief 查找 候选地址。
+ */
+x_int32_t ntppool_find(
+                xntp_poolptr_t xpool_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port,
+                xntp_cand_t * xcand_ptr)
+{
+    x_uint32_t xut_index = XPOOL_NONE;
+
+    if ((X_NULL == xpool_ptr) || (X_NULL == xcand_ptr))
+    {
+        return EINVAL;
+    }
+
+    xut_index = ntppool_lookup(xpool_ptr, xut_ipv4, xut_port);
+    if (XPOOL_NONE == xut_index)
+    {
+        return ENOENT;
+    }
+
+    *xcand_ptr = xpool_ptr->xcand_list[xut_index];
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 候选地址 的 数量。
+ */
+x_uint32_t ntppool_count(xntp_poolptr_t xpool_ptr)
+{
+    return (X_NULL != xpool_ptr) ? xpool_ptr->xut_count : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 计算 候选地址 的 评分（越小越优）。
+ */
+x_uint32_t ntppool_score(const xntp_cand_t * xcand_ptr)
+{
+    x_uint32_t xut_window = 0;
+    x_uint32_t xut_lost   = 0;
+    x_uint32_t xut_reach  = 0;
+    x_uint64_t xut_score  = 0;
+
+    if ((X_NULL == xcand_ptr) || !ntppool_fit(xcand_ptr))
+    {
+        return XNTP_POOL_UNFIT;
+    }
+
+    // 统计 窗口内（最近 至多 8 次 探测）失败的 次数
+    xut_window = (xcand_ptr->xut_probes < 8) ? xcand_ptr->xut_probes : 8;
+    xut_reach  = xcand_ptr->xut_reach & ((1U << xut_window) - 1);
+    for (xut_lost = xut_window; 0 != xut_reach; xut_reach &= (xut_reach - 1))
+    {
+        xut_lost -= 1;
+    }
+
+    xut_score = (x_uint64_t)xcand_ptr->xut_delay / 2 +
+                (x_uint64_t)xcand_ptr->xut_jitter * 4 +
+                (x_uint64_t)xcand_ptr->xut_stratum * XPOOL_STRATUM_COST +
+                (x_uint64_t)xut_lost * XPOOL_LOSS_COST;
+
+    return (xut_score < XNTP_POOL_UNFIT) ? (x_uint32_t)xut_score : (XNTP_POOL_UNFIT - 1);
+}
@@ -0,0 +1,229 @@
+﻿/**
+ * @file ntp_pool.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : NTP 服务端池（候选地址 的 评分、择优 与 自动替换）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __NTP_POOL_H__
+#define __NTP_POOL_H__
+
+#include "ntp_client.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 定义 NTP 服务端池 的 指针类型 */
+typedef struct xntp_pool_t * xntp_poolptr_t;
+
+/** 活跃集合 的 默认大小 与 上限 */
+#define XNTP_POOL_ACTIVE    4
+#define XNTP_POOL_KMAX      32
+
+/** 候选地址 的 默认容量 */
+#define XNTP_POOL_CAPACITY  4096
+
+/** 可登记的 域名 数量（用于 活跃集合 不足时 重新解析） */
+#define XNTP_POOL_HOSTS     8
+
+/** 不合格（不可用）候选地址 的 评分 */
+#define XNTP_POOL_UNFIT     0xFFFFFFFF
+
+/** 候选地址 的 状态标识 */
+#define XNTP_CAND_ACTIVE    0x01    ///< 属于 活跃集合
+#define XNTP_CAND_STANDBY   0x02    ///< 属于 备用集合（每轮 与 活跃集合 一同 探测）
+#define XNTP_CAND_SAMPLED   0x04    ///< 已有 有效样本（时延、偏移量 有效）
+
+/**
+ * @struct xntp_cand_t
+ * @brief  候选地址 及其 统计信息（紧凑布局，24 字节；时间量 的 单位 均为 100 纳秒）。
+ */
+typedef struct xntp_cand_t
+{
+    x_uint32_t xut_ipv4;     ///< IPv4 地址（主机字节序）
+    x_uint16_t xut_port;     ///< 端口号
+    x_uint8_t  xut_reach;    ///< 可达性 移位寄存器（最近 8 次探测，最低位 为 最近一次）
+    x_uint8_t  xut_stratum;  ///< 最近一次 应答的 层数（尚无应答 时 为 0）
+    x_uint8_t  xut_flags;    ///< 状态标识（XNTP_CAND_*）
+    x_uint8_t  xut_probes;   ///< 已探测的 次数（饱和于 255）
+    x_uint16_t xut_resv;     ///< 保留
+    x_uint32_t xut_delay;    ///< 往返时延 的 平滑值
+    x_uint32_t xut_jitter;   ///< 抖动（相邻 偏移量 之差 的 平滑值）
+    x_int32_t  xit_offset;   ///< 最近一次 样本 的 偏移量（超出 x_int32_t 范围 时 截断）
+} xntp_cand_t;
+
+/**********************************************************/
+/**
+ * @brief 创建 NTP 服务端池。
+ * @note
+ * 服务端池 借用 xntp_this 的 工作通道 进行 批量探测（参看 ntpcli_req_sweep()），
+ * 并不持有 xntp_this，销毁 服务端池 之前 xntp_this 须保持有效。
+ * 服务端池 不是 线程安全 的，其 各个接口 应由 同一线程（或 外部加锁）调用。
+ *
+ * @param [in ] xntp_this    : NTP 客户端工作对象（其 认证、NTS 等 设置 不作用于 探测）。
+ * @param [in ] xut_active   : 活跃集合 的 大小 K（取 0 时 为 XNTP_POOL_ACTIVE，至多 XNTP_POOL_KMAX）。
+ * @param [in ] xut_capacity : 候选地址 的 容量（取 0 时 为 XNTP_POOL_CAPACITY）。
+ *
+ * @return xntp_poolptr_t :
+ * 成功，返回 服务端池；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_poolptr_t ntppool_create(
+                    xntp_cliptr_t xntp_this,
+                    x_uint32_t xut_active,
+                    x_uint32_t xut_capacity);
+
+/**********************************************************/
+/**
+ * @brief 销毁 NTP 服务端池。
+ */
+x_void_t ntppool_destroy(xntp_poolptr_t xpool_ptr);
+
+/**********************************************************/
+/**
+ * @brief 解析 域名 并 添加 其 全部 IPv4 地址 为 候选地址。
+ * @note
+ * xut_expand 不为 0 时，另外 解析 "0.<xszt_host>" 至 "<xut_expand - 1>.<xszt_host>"
+ * （如 pool.ntp.org 的 编号子域名），以 得到 更多的 候选地址；
+ * 域名 会被 登记（至多 XNTP_POOL_HOSTS 个），活跃集合 不足 K 个 时 由 ntppool_update() 重新解析。
+ * 域名解析（getaddrinfo()）为 阻塞操作。
+ *
+ * @param [in ] xpool_ptr  : NTP 服务端池。
+ * @param [in ] xszt_host  : 域名（或 IPv4 地址 字符串）。
+ * @param [in ] xut_port   : 端口号。
+ * @param [in ] xut_expand : 编号子域名 的 数量（0 表示 只解析 xszt_host 本身）。
+ * @param [out] xut_added  : 返回 新增的 候选地址 数量（可为 X_NULL）。
+ *
+ * @return x_int32_t :
+ * 至少 一个 域名 解析成功 时，返回 0（已存在的 地址 不重复添加）；
+ * 全部 解析失败 返回 EHOSTUNREACH；容量已满、无法 添加 任何地址 时 返回 ENOSPC；
+ * 其他值 为 参数错误 等 错误码。
+ */
+x_int32_t ntppool_add_host(
+                xntp_poolptr_t xpool_ptr,
+                x_cstring_t xszt_host,
+                x_uint16_t xut_port,
+                x_uint32_t xut_expand,
+                x_uint32_t * xut_added);
+
+/**********************************************************/
+/**
+ * @brief 添加 候选地址。
+ * @note
+ * 容量已满 时，先 清理 持续不可达 的 候选地址（非 活跃、非 备用，
+ * 已探测过 且 最近的 探测 全部失败），仍无空位 时 返回 ENOSPC。
+ *
+ * @param [in ] xpool_ptr : NTP 服务端池。
+ * @param [in ] xut_ipv4  : IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 端口号。
+ *
+ * @return x_int32_t : 成功，返回 0；已存在 返回 EEXIST；容量已满 返回 ENOSPC。
+ */
+x_int32_t ntppool_add_addr(
+                xntp_poolptr_t xpool_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port);
+
+/**********************************************************/
+/**
+ * @brief 执行 一轮 探测，更新 各候选地址 的 统计信息，并 重新选择 活跃集合。
+ * @note
+ * 每轮 以 一次 批量请求 探测 活跃集合、备用集合，以及 轮转选取的 一批（至多 32 个）其他候选地址；
+ * 无应答、层数 为 0 或 不小于 16、LI 为 3（服务端未同步）的 探测 均视为 失败。
+ * 最近 3 次 探测 均失败，或 层数 无效 的 候选地址 为 不合格，将被 移出 活跃集合，
+ * 由 评分 最优 的 合格候选地址 补足；合格的 活跃成员 只在 挑战者 已完成 预热（至少 4 次 探测）、
+ * 且 评分 优于 其 25% 以上 时 才被 替换，以免 活跃集合 频繁 抖动。
+ * 合格候选地址 不足 K 个，且 登记有 域名 时，重新解析 域名（至多 每 5 分钟 一次，阻塞操作）。
+ *
+ * @param [in ] xpool_ptr : NTP 服务端池。
+ * @param [in ] xtm_dline : 单调时钟的 截止时间（参看 ntpcli_req_sweep()）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntppool_update(xntp_poolptr_t xpool_ptr, xtime_vnsec_t xtm_dline);
+
+/**********************************************************/
+/**
+ * @brief 获取 活跃集合（按 评分 由优到劣 排列）。
+ *
+ * @param [in ] xpool_ptr : NTP 服务端池。
+ * @param [out] xcand_list : 接收 活跃成员 的 数组。
+ * @param [in ] xut_count  : 数组 的 容量。
+ *
+ * @return x_uint32_t : 返回 写入的 数量。
+ */
+x_uint32_t ntppool_active(
+                xntp_poolptr_t xpool_ptr,
+                xntp_cand_t * xcand_list,
+                x_uint32_t xut_count);
+
+/**********************************************************/
+/**
+ * @brief 查找 候选地址。
+ *
+ * @param [in ] xpool_ptr : NTP 服务端池。
+ * @param [in ] xut_ipv4  : IPv4 地址（主机字节序）。
+ * @param [in ] xut_port  : 端口号。
+ * @param [out] xcand_ptr : 返回 候选地址 的 副本。
+ *
+ * @return x_int32_t : 成功，返回 0；不存在 返回 ENOENT。
+ */
+x_int32_t ntppool_find(
+                xntp_poolptr_t xpool_ptr,
+                x_uint32_t xut_ipv4,
+                x_uint16_t xut_port,
+                xntp_cand_t * xcand_ptr);
+
+/**********************************************************/
+/**
+ * @brief 返回 候选地址 的 数量。
+ */
+x_uint32_t ntppool_count(xntp_poolptr_t xpool_ptr);
+
+/**********************************************************/
+/**
+ * @brief 计算 候选地址 的 评分（越小越优）。
+ * @note
+ * 评分 = 时延 / 2 + 抖动 * 4 + 层数 * 1 毫秒 + 最近 8 次 探测中 失败的次数 * 20 毫秒，
+ * 即 以 时间量 衡量 各项指标 对 同步精度 的 影响；不合格 时 返回 XNTP_POOL_UNFIT。
+ */
+x_uint32_t ntppool_score(const xntp_cand_t * xcand_ptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_POOL_H__
@@ -0,0 +1,482 @@
+﻿/**
+ * @file ntp_shm.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 以 共享内存 发布 校正时间 的 实现。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_shm.h"
+#include "xatomic.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 内部相关的数据类型与常量
+//
+
+/** 读取方 等待 奇数序列号 的 最大重试次数（发布方 在更新中途 退出 时，不致 一直等待） */
+#define XNTP_SHM_RETRY      1000000
+
+/**
+ * @struct xntp_shm_t
+ * @brief  共享内存段 的 句柄。
+ */
+typedef struct xntp_shm_t
+{
+    xntp_shmseg_t * xseg_ptr;   ///< 映射的 共享内存段
+    x_bool_t        xbt_owner;  ///< 是否为 发布方（可写）
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE          xhdl_map;   ///< 文件映射对象
+#endif // defined(_WIN32) || defined(_WIN64)
+} xntp_shm_t;
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 当前进程 的 ID。
+ */
+static inline x_uint32_t ntpshm_pid(void)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return (x_uint32_t)GetCurrentProcessId();
+#else // !(defined(_WIN32) || defined(_WIN64))
+    return (x_uint32_t)getpid();
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 映射 共享内存段。
+ *
+ * @param [out] xshm_ptr  : 句柄（成功时 填写 xseg_ptr 等字段）。
+ * @param [in ] xszt_name : 段 的 名称。
+ * @param [in ] xbt_owner : 是否为 发布方（创建 并 以 读写方式 映射），否则 以 只读方式 打开 已有的段。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static x_int32_t ntpshm_map(xntp_shm_t * xshm_ptr, x_cstring_t xszt_name, x_bool_t xbt_owner)
+{
+#if defined(_WIN32) || defined(_WIN64)
+
+    if (xbt_owner)
+        xshm_ptr->xhdl_map = CreateFileMappingA(INVALID_HANDLE_VALUE, X_NULL, PAGE_READWRITE,
+                                                0, sizeof(xntp_shmseg_t), xszt_name);
+    else
+        xshm_ptr->xhdl_map = OpenFileMappingA(FILE_MAP_READ, FALSE, xszt_name);
+
+    if (X_NULL == xshm_ptr->xhdl_map)
+    {
+        return (ERROR_FILE_NOT_FOUND == GetLastError()) ? ENOENT : EACCES;
+    }
+
+    xshm_ptr->xseg_ptr = (xntp_shmseg_t *)MapViewOfFile(xshm_ptr->xhdl_map,
+                                                       xbt_owner ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ,
+                                                       0, 0, sizeof(xntp_shmseg_t));
+    if (X_NULL == xshm_ptr->xseg_ptr)
+    {
+        CloseHandle(xshm_ptr->xhdl_map);
+        xshm_ptr->xhdl_map = X_NULL;
+        return ENOMEM;
+    }
+
+#else // !(defined(_WIN32) || defined(_WIN64))
+
+    x_int32_t   xit_errno = 0;
+    int         xfd_shm   = -1;
+    x_pvoid_t   xpvt_mptr = MAP_FAILED;
+    struct stat xstat_shm;
+
+    xfd_shm = xbt_owner ? shm_open(xszt_name, O_CREAT | O_RDWR, 0644) : shm_open(xszt_name, O_RDONLY, 0);
+    if (-1 == xfd_shm)
+    {
+        return errno;
+    }
+
+    do
+    {
+        if (0 != fstat(xfd_shm, &xstat_shm))
+        {
+            xit_errno = errno;
+            break;
+        }
+
+        if ((x_uint64_t)xstat_shm.st_size < sizeof(xntp_shmseg_t))
+        {
+            if (!xbt_owner)
+            {
+                xit_errno = EPROTO;
+                break;
+            }
+
+            if (0 != ftruncate(xfd_shm, sizeof(xntp_shmseg_t)))
+            {
+                xit_errno = errno;
+                break;
+            }
+        }
+
+        xpvt_mptr = mmap(X_NULL, sizeof(xntp_shmseg_t),
+                         xbt_owner ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                         MAP_SHARED, xfd_shm, 0);
+        if (MAP_FAILED == xpvt_mptr)
+        {
+            xit_errno = errno;
+            break;
+        }
+
+        xshm_ptr->xseg_ptr = (xntp_shmseg_t *)xpvt_mptr;
+    } while (0);
+
+    close(xfd_shm);
+
+    if (0 != xit_errno)
+    {
+        return xit_errno;
+    }
+
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    xshm_ptr->xbt_owner = xbt_owner;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 解除 共享内存段 的 映射。
+ */
+static x_void_t ntpshm_unmap(xntp_shm_t * xshm_ptr)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    if (X_NULL != xshm_ptr->xseg_ptr)
+        UnmapViewOfFile(xshm_ptr->xseg_ptr);
+    if (X_NULL != xshm_ptr->xhdl_map)
+        CloseHandle(xshm_ptr->xhdl_map);
+    xshm_ptr->xhdl_map = X_NULL;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    if (X_NULL != xshm_ptr->xseg_ptr)
+        munmap(xshm_ptr->xseg_ptr, sizeof(xntp_shmseg_t));
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    xshm_ptr->xseg_ptr = X_NULL;
+}
+
+//====================================================================
+
+//
+// 外部相关操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 创建（或 重新打开）共享内存段，作为 发布方。
+ * @note
+ * 段 已存在 且 版本一致 时，沿用 其中的 序列号（已映射的 读取方 无须 重新打开），并 标记为 未发布；
+ * 否则 重新初始化。上一个 发布方 在更新中途 退出 而遗留的 奇数序列号，也在此 恢复。
+ * 同一名称 应只有 一个 发布方。
+ *
+ * @param [in ] xszt_name : 段 的 名称（X_NULL 时 取 XNTP_SHM_NAME；POSIX 下 须以 '/' 开头）。
+ *
+ * @return xntp_shmptr_t : 成功，返回 句柄；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_shmptr_t ntpshm_create(x_cstring_t xszt_name)
+{
+    xntp_shm_t    * xshm_ptr  = X_NULL;
+    xntp_shmseg_t * xseg_ptr  = X_NULL;
+    x_int32_t       xit_errno = 0;
+    x_uint32_t      xut_seqn  = 0;
+
+    xshm_ptr = (xntp_shm_t *)calloc(1, sizeof(xntp_shm_t));
+    if (X_NULL == xshm_ptr)
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    xit_errno = ntpshm_map(xshm_ptr, (X_NULL != xszt_name) ? xszt_name : XNTP_SHM_NAME, X_TRUE);
+    if (0 != xit_errno)
+    {
+        free(xshm_ptr);
+        errno = xit_errno;
+        return X_NULL;
+    }
+
+    //======================================
+
+    xseg_ptr = xshm_ptr->xseg_ptr;
+
+    if ((XNTP_SHM_MAGIC   != xseg_ptr->xut_magic  ) ||
+        (XNTP_SHM_VERSION != xseg_ptr->xut_version) ||
+        (sizeof(xntp_shmseg_t) > xseg_ptr->xut_size))
+    {
+        memset(xseg_ptr, 0, sizeof(xntp_shmseg_t));
+    }
+
+    // 加锁（遗留的 奇数序列号 视为 已加锁），重置 发布状态
+    xut_seqn = XATOMIC_LOAD32(&xseg_ptr->xut_seqn) | 1;
+    XATOMIC_STORE32(&xseg_ptr->xut_seqn, xut_seqn);
+
+    xseg_ptr->xut_pid    = ntpshm_pid();
+    xseg_ptr->xut_valid  = 0;
+    xseg_ptr->xut_count  = 0;
+    xseg_ptr->xit_offset = 0;
+    xseg_ptr->xtm_update = 0;
+    xseg_ptr->xleap_plan = 0;
+    memset(&xseg_ptr->xclk_model, 0, sizeof(xntp_clkmodel_t));
+
+    xseg_ptr->xut_magic   = XNTP_SHM_MAGIC;
+    xseg_ptr->xut_version = XNTP_SHM_VERSION;
+    xseg_ptr->xut_size    = (x_uint32_t)sizeof(xntp_shmseg_t);
+
+    XATOMIC_STORE32(&xseg_ptr->xut_seqn, xut_seqn + 1);
+
+    //======================================
+
+    return xshm_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 只读方式 打开 共享内存段，作为 读取方。
+ *
+ * @param [in ] xszt_name : 段 的 名称（X_NULL 时 取 XNTP_SHM_NAME）。
+ *
+ * @return xntp_shmptr_t :
+ * 成功，返回 句柄；失败，返回 X_NULL，可通过 errno 查看错误码（段 不存在 为 ENOENT，版本 不一致 为 EPROTO）。
+ */
+xntp_shmptr_t ntpshm_open(x_cstring_t xszt_name)
+{
+    xntp_shm_t * xshm_ptr  = X_NULL;
+    x_int32_t    xit_errno = 0;
+
+    xshm_ptr = (xntp_shm_t *)calloc(1, sizeof(xntp_shm_t));
+    if (X_NULL == xshm_ptr)
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    xit_errno = ntpshm_map(xshm_ptr, (X_NULL != xszt_name) ? xszt_name : XNTP_SHM_NAME, X_FALSE);
+    if ((0 == xit_errno) &&
+        ((XNTP_SHM_MAGIC   != XATOMIC_LOAD32(&xshm_ptr->xseg_ptr->xut_magic  )) ||
+         (XNTP_SHM_VERSION != XATOMIC_LOAD32(&xshm_ptr->xseg_ptr->xut_version)) ||
+         (sizeof(xntp_shmseg_t) > XATOMIC_LOAD32(&xshm_ptr->xseg_ptr->xut_size))))
+    {
+        ntpshm_unmap(xshm_ptr);
+        xit_errno = EPROTO;
+    }
+
+    if (0 != xit_errno)
+    {
+        free(xshm_ptr);
+        errno = xit_errno;
+        return X_NULL;
+    }
+
+    return xshm_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 关闭 共享内存段 的 句柄（只解除映射，段 本身 保留，参看 ntpshm_unlink()）。
+ */
+x_void_t ntpshm_close(xntp_shmptr_t xshm_ptr)
+{
+    if (X_NULL == xshm_ptr)
+    {
+        return;
+    }
+
+    ntpshm_unmap(xshm_ptr);
+    free(xshm_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 删除 共享内存段 的 名称（已映射的 进程 不受影响；Windows 下 随 最后一个句柄 关闭 而释放，无须调用）。
+ */
+x_int32_t ntpshm_unlink(x_cstring_t xszt_name)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return 0;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    return (0 == shm_unlink((X_NULL != xszt_name) ? xszt_name : XNTP_SHM_NAME)) ? 0 : errno;
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 发布 当前的 时间模型（只能 由 ntpshm_create() 的 句柄 调用）。
+ * @note
+ * 拷贝 进程内 TSC 时钟 的 模型（参看 ntpclk_model()，未校准 时 读取方 改用 偏移量）；
+ * ntpcli_publish() 设置后，客户端 每次 成功的 ntpcli_req_time() 都会 调用该接口。
+ *
+ * @param [in ] xshm_ptr   : 共享内存段 的 句柄。
+ * @param [in ] xit_offset : NTP 偏移量（UTC 减去 本地系统时间，以 100纳秒 为单位）。
+ * @param [in ] xleap_plan : 读取方 据以 平滑 的 闰秒计划（参看 ntpcli_leap_plan()；0 表示 不平滑）。
+ *
+ * @return x_int32_t : 成功，返回 0；只读 句柄，返回 EPERM；其他值 为 错误码。
+ */
+x_int32_t ntpshm_publish(xntp_shmptr_t xshm_ptr, x_int64_t xit_offset, xntp_leapplan_t xleap_plan)
+{
+    xntp_shmseg_t * xseg_ptr = X_NULL;
+    x_uint32_t      xut_seqn = 0;
+    xntp_clkmodel_t xclk_model;
+
+    if (X_NULL == xshm_ptr)
+    {
+        return EINVAL;
+    }
+
+    if (!xshm_ptr->xbt_owner)
+    {
+        return EPERM;
+    }
+
+    // 在 加锁之前 拷贝模型，缩短 读取方 的 等待
+    ntpclk_model(&xclk_model);
+
+    xseg_ptr = xshm_ptr->xseg_ptr;
+    xut_seqn = XATOMIC_LOAD32(&xseg_ptr->xut_seqn);
+    if ((xut_seqn & 1) || !XATOMIC_CAS32(&xseg_ptr->xut_seqn, xut_seqn, xut_seqn + 1))
+    {
+        return EBUSY;
+    }
+
+    XATOMIC_STORE64(&xseg_ptr->xut_count , xseg_ptr->xut_count + 1);
+    XATOMIC_STORE64(&xseg_ptr->xit_offset, xit_offset);
+    XATOMIC_STORE64(&xseg_ptr->xtm_update, (x_int64_t)time_vnsec() + xit_offset);
+    XATOMIC_STORE64(&xseg_ptr->xleap_plan, xleap_plan);
+    memcpy(&xseg_ptr->xclk_model, &xclk_model, sizeof(xntp_clkmodel_t));
+    XATOMIC_STORE32(&xseg_ptr->xut_valid, 1);
+
+    XATOMIC_STORE32(&xseg_ptr->xut_seqn, xut_seqn + 2);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 共享内存段 的 一致拷贝（序列锁 的 读取方）。
+ * @note
+ * 发布方 在更新中途 退出 时，序列号 停留在 奇数：读取方 有限次 重试后 返回 EAGAIN，而不会 一直等待。
+ *
+ * @param [in ] xshm_ptr : 共享内存段 的 句柄。
+ * @param [out] xseg_ptr : 返回 拷贝（可检查 xtm_update、xut_pid 等，判断 发布方 是否 仍在工作）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpshm_read(xntp_shmptr_t xshm_ptr, xntp_shmseg_t * xseg_ptr)
+{
+    const xntp_shmseg_t * xseg_shm  = X_NULL;
+    x_uint32_t            xut_seqn  = 0;
+    x_uint32_t            xut_retry = 0;
+
+    if ((X_NULL == xshm_ptr) || (X_NULL == xseg_ptr))
+    {
+        return EINVAL;
+    }
+
+    xseg_shm = xshm_ptr->xseg_ptr;
+
+    for (xut_retry = 0; xut_retry < XNTP_SHM_RETRY; ++xut_retry)
+    {
+        xut_seqn = XATOMIC_LOAD32(&xseg_shm->xut_seqn);
+        if (xut_seqn & 1)
+        {
+            XATOMIC_PAUSE();
+            continue;
+        }
+
+        // 只读映射 上 不能使用 原子的 读-改-写 指令（MSVC 的 64 位读取），故 整体拷贝 后 校验序列号
+        memcpy(xseg_ptr, xseg_shm, sizeof(xntp_shmseg_t));
+        XATOMIC_ACQUIRE();
+
+        if (xut_seqn == XATOMIC_LOAD32(&xseg_shm->xut_seqn))
+        {
+            return 0;
+        }
+    }
+
+    return EAGAIN;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 校正后的 时间（以 100纳秒 为单位）。
+ * @note
+ * 发布的 TSC 模型 有效 时，只读取 TSC 与 共享内存，不经 系统调用 与 套接字；
+ * 否则 以 系统时间 加上 发布的 偏移量；最后 按 发布的 闰秒计划 平滑。
+ * 尚未发布 或 读取失败 时，返回 XTIME_INVALID_VNSEC。
+ */
+xtime_vnsec_t ntpshm_now(xntp_shmptr_t xshm_ptr)
+{
+    xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
+    x_uint64_t    xut_nsec  = 0;
+    xntp_shmseg_t xseg_copy;
+
+    if ((0 != ntpshm_read(xshm_ptr, &xseg_copy)) || !xseg_copy.xut_valid)
+    {
+        return XTIME_INVALID_VNSEC;
+    }
+
+    if (xseg_copy.xclk_model.xut_valid)
+    {
+        xseg_copy.xclk_model.xut_seqn = 0;
+        xut_nsec = ntpclk_model_ns(&xseg_copy.xclk_model, time_tsc());
+    }
+
+    if (0 != xut_nsec)
+        xtm_vnsec = (xtime_vnsec_t)(xut_nsec / 100ULL);
+    else
+        xtm_vnsec = (xtime_vnsec_t)((x_int64_t)time_vnsec() + xseg_copy.xit_offset);
+
+    return ntpleap_smear(xseg_copy.xleap_plan, xtm_vnsec);
+}
+
+////////////////////////////////////////////////////////////////////////////////
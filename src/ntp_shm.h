@@ -0,0 +1,176 @@
+﻿/**
+ * @file ntp_shm.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 以 共享内存 向 同一主机 的 多个进程 发布 校正时间 的 模型（序列锁 保护，读取 无系统调用、无套接字）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __NTP_SHM_H__
+#define __NTP_SHM_H__
+
+#include "xtime.h"
+#include "ntp_leap.h"
+#include "ntp_clock.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 共享内存段 的 默认名称 */
+#if defined(_WIN32) || defined(_WIN64)
+#define XNTP_SHM_NAME       "Local\\xntp_clock"
+#else // !(defined(_WIN32) || defined(_WIN64))
+#define XNTP_SHM_NAME       "/xntp_clock"
+#endif // defined(_WIN32) || defined(_WIN64)
+
+/** 共享内存段 的 标识（"NSHM"） */
+#define XNTP_SHM_MAGIC      0x4D48534EU
+
+/**
+ * 共享内存段 的 布局版本：
+ * 只在 段尾 追加字段 时，版本号 不变（xut_size 随之增大，旧的 读取方 仍可使用）；
+ * 修改 已有字段 时，版本号 加 1，读取方 打开 不同版本 的 段 时 返回 EPROTO。
+ */
+#define XNTP_SHM_VERSION    1
+
+/**
+ * @struct xntp_shmseg_t
+ * @brief  共享内存段 的 布局（只含 定长的 整数字段，与 进程的 地址空间 无关）。
+ * @note
+ * xut_seqn 之后的 字段 由 序列锁 保护：xut_seqn 为奇数 时，发布方 正在更新；
+ * 读取方 应使用 ntpshm_read() 取得 一致的 拷贝，而 不要 直接访问。
+ */
+typedef struct xntp_shmseg_t
+{
+    x_uint32_t      xut_magic;      ///< 标识（XNTP_SHM_MAGIC）
+    x_uint32_t      xut_version;    ///< 布局版本（XNTP_SHM_VERSION）
+    x_uint32_t      xut_size;       ///< 段 的 有效字节数
+    x_uint32_t      xut_pid;        ///< 发布方 的 进程 ID
+    x_uint32_t      xut_seqn;       ///< 序列号
+    x_uint32_t      xut_valid;      ///< 是否 已发布
+    x_uint64_t      xut_count;      ///< 发布次数
+    x_int64_t       xit_offset;     ///< NTP 偏移量（UTC 减去 系统时间，100纳秒）：TSC 模型 无效时 使用
+    xtime_vnsec_t   xtm_update;     ///< 最近一次 发布时 的 UTC（100纳秒）
+    xntp_leapplan_t xleap_plan;     ///< 读取方 据以 平滑 的 闰秒计划（0 表示 不平滑）
+    xntp_clkmodel_t xclk_model;     ///< TSC → UTC 模型（其 xut_seqn 不使用，恒为 0）
+} xntp_shmseg_t;
+
+/** 定义 共享内存段 的 句柄类型 */
+typedef struct xntp_shm_t * xntp_shmptr_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 创建（或 重新打开）共享内存段，作为 发布方。
+ * @note
+ * 段 已存在 且 版本一致 时，沿用 其中的 序列号（已映射的 读取方 无须 重新打开），并 标记为 未发布；
+ * 否则 重新初始化。上一个 发布方 在更新中途 退出 而遗留的 奇数序列号，也在此 恢复。
+ * 同一名称 应只有 一个 发布方。
+ *
+ * @param [in ] xszt_name : 段 的 名称（X_NULL 时 取 XNTP_SHM_NAME；POSIX 下 须以 '/' 开头）。
+ *
+ * @return xntp_shmptr_t : 成功，返回 句柄；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xntp_shmptr_t ntpshm_create(x_cstring_t xszt_name);
+
+/**********************************************************/
+/**
+ * @brief 以 只读方式 打开 共享内存段，作为 读取方。
+ *
+ * @param [in ] xszt_name : 段 的 名称（X_NULL 时 取 XNTP_SHM_NAME）。
+ *
+ * @return xntp_shmptr_t :
+ * 成功，返回 句柄；失败，返回 X_NULL，可通过 errno 查看错误码（段 不存在 为 ENOENT，版本 不一致 为 EPROTO）。
+ */
+xntp_shmptr_t ntpshm_open(x_cstring_t xszt_name);
+
+/**********************************************************/
+/**
+ * @brief 关闭 共享内存段 的 句柄（只解除映射，段 本身 保留，参看 ntpshm_unlink()）。
+ */
+x_void_t ntpshm_close(xntp_shmptr_t xshm_ptr);
+
+/**********************************************************/
+/**
+ * @brief 删除 共享内存段 的 名称（已映射的 进程 不受影响；Windows 下 随 最后一个句柄 关闭 而释放，无须调用）。
+ */
+x_int32_t ntpshm_unlink(x_cstring_t xszt_name);
+
+/**********************************************************/
+/**
+ * @brief 发布 当前的 时间模型（只能 由 ntpshm_create() 的 句柄 调用）。
+ * @note
+ * 拷贝 进程内 TSC 时钟 的 模型（参看 ntpclk_model()，未校准 时 读取方 改用 偏移量）；
+ * ntpcli_publish() 设置后，客户端 每次 成功的 ntpcli_req_time() 都会 调用该接口。
+ *
+ * @param [in ] xshm_ptr   : 共享内存段 的 句柄。
+ * @param [in ] xit_offset : NTP 偏移量（UTC 减去 本地系统时间，以 100纳秒 为单位）。
+ * @param [in ] xleap_plan : 读取方 据以 平滑 的 闰秒计划（参看 ntpcli_leap_plan()；0 表示 不平滑）。
+ *
+ * @return x_int32_t : 成功，返回 0；只读 句柄，返回 EPERM；其他值 为 错误码。
+ */
+x_int32_t ntpshm_publish(xntp_shmptr_t xshm_ptr, x_int64_t xit_offset, xntp_leapplan_t xleap_plan);
+
+/**********************************************************/
+/**
+ * @brief 读取 共享内存段 的 一致拷贝（序列锁 的 读取方）。
+ * @note
+ * 发布方 在更新中途 退出 时，序列号 停留在 奇数：读取方 有限次 重试后 返回 EAGAIN，而不会 一直等待。
+ *
+ * @param [in ] xshm_ptr : 共享内存段 的 句柄。
+ * @param [out] xseg_ptr : 返回 拷贝（可检查 xtm_update、xut_pid 等，判断 发布方 是否 仍在工作）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpshm_read(xntp_shmptr_t xshm_ptr, xntp_shmseg_t * xseg_ptr);
+
+/**********************************************************/
+/**
+ * @brief 读取 校正后的 时间（以 100纳秒 为单位）。
+ * @note
+ * 发布的 TSC 模型 有效 时，只读取 TSC 与 共享内存，不经 系统调用 与 套接字；
+ * 否则 以 系统时间 加上 发布的 偏移量；最后 按 发布的 闰秒计划 平滑。
+ * 尚未发布 或 读取失败 时，返回 XTIME_INVALID_VNSEC。
+ */
+xtime_vnsec_t ntpshm_now(xntp_shmptr_t xshm_ptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_SHM_H__
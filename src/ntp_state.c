@@ -0,0 +1,352 @@
+﻿/**
+ * @file ntp_state.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 客户端 热启动状态文件 的 读写。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_state.h"
+#include "ntp_packet.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 内部相关的数据类型与常量
+//
+
+/**
+ * 状态文件 的 布局（整数 均为 大端序）：
+ * 头部 16 字节：标识、版本、数据长度、数据 的 校验和（FNV-1a），各 4 字节；
+ * 数据：保存时刻（8 字节），其后 为 若干条 记录，每条 以 类型、长度（各 4 字节）开头。
+ */
+#define XNTP_STATE_HEAD     16
+
+/** 状态文件 的 最大长度 */
+#define XNTP_STATE_MAXLEN   TEXT_LEN_768
+
+/** 记录类型：频率估计（8 字节，有符号 ppb） */
+#define XNTP_STREC_FREQ     1
+
+/** 记录类型：域名解析结果（过期时刻 8 字节、端口号 4 字节、地址数量 4 字节、各地址 4 字节，余下 为 域名） */
+#define XNTP_STREC_ADDR     2
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 计算 数据 的 FNV-1a 校验和（32 位）。
+ */
+static x_uint32_t ntpstate_fnv1a(const x_uchar_t * xbt_data, x_uint32_t xut_dlen)
+{
+    x_uint32_t xut_hash = 0x811C9DC5U;
+    x_uint32_t xut_iter = 0;
+
+    for (xut_iter = 0; xut_iter < xut_dlen; ++xut_iter)
+    {
+        xut_hash ^= xbt_data[xut_iter];
+        xut_hash *= 0x01000193U;
+    }
+
+    return xut_hash;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 一条 记录（未知的 类型 被跳过）。
+ *
+ * @return x_int32_t : 成功，返回 0；记录 格式错误，返回 EPROTO。
+ */
+static x_int32_t ntpstate_record(
+                    xntp_state_t * xstate_ptr,
+                    x_uint32_t xut_type,
+                    const x_uchar_t * xbt_data,
+                    x_uint32_t xut_dlen)
+{
+    x_uint32_t xut_iter = 0;
+    x_uint32_t xut_hlen = 0;
+
+    switch (xut_type)
+    {
+    case XNTP_STREC_FREQ:
+        if (8 != xut_dlen)
+            return EPROTO;
+        xstate_ptr->xbt_freq = X_TRUE;
+        xstate_ptr->xit_freq = (x_int64_t)ntp_load64(xbt_data);
+        break;
+
+    case XNTP_STREC_ADDR:
+        if (xut_dlen < 16)
+            return EPROTO;
+
+        xstate_ptr->xtm_expire = (xtime_vnsec_t)ntp_load64(xbt_data);
+        xstate_ptr->xut_port   = (x_uint16_t)ntp_load32(xbt_data + 8);
+        xstate_ptr->xut_naddr  = ntp_load32(xbt_data + 12);
+        if ((xstate_ptr->xut_naddr > XNTP_STATE_ADDRS) || (xut_dlen < 16 + 4 * xstate_ptr->xut_naddr))
+            return EPROTO;
+
+        for (xut_iter = 0; xut_iter < xstate_ptr->xut_naddr; ++xut_iter)
+            xstate_ptr->xut_addrs[xut_iter] = ntp_load32(xbt_data + 16 + 4 * xut_iter);
+
+        xut_hlen = xut_dlen - 16 - 4 * xstate_ptr->xut_naddr;
+        if (xut_hlen >= TEXT_LEN_256)
+            return EPROTO;
+        memcpy(xstate_ptr->xszt_host, xbt_data + 16 + 4 * xstate_ptr->xut_naddr, xut_hlen);
+        xstate_ptr->xszt_host[xut_hlen] = '\0';
+        break;
+
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+//====================================================================
+
+//
+// 外部相关操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 从 状态文件 加载 热启动状态。
+ * @note
+ * 文件 由 头部（标识、版本、长度、校验和）与 若干条 记录（类型、长度、数据）组成，整数 均为 大端序；
+ * 校验和 不符（文件 损坏 或 被截断）时 整体拒绝；未知的 记录 被跳过，新版本 写出的 文件 因而 仍可读取。
+ *
+ * @param [in ] xszt_path : 文件路径。
+ * @param [out] xstate_ptr : 返回 热启动状态（文件 中 没有的 记录，对应字段 为 0）。
+ *
+ * @return x_int32_t : 成功，返回 0；文件 不存在，返回 ENOENT；格式 或 校验和 错误，返回 EPROTO。
+ */
+x_int32_t ntpstate_load(x_cstring_t xszt_path, xntp_state_t * xstate_ptr)
+{
+    x_int32_t  xit_errno = 0;
+    FILE     * xfile_ptr = X_NULL;
+    x_uint32_t xut_flen  = 0;
+    x_uint32_t xut_dlen  = 0;
+    x_uint32_t xut_iter  = 0;
+    x_uint32_t xut_type  = 0;
+    x_uint32_t xut_rlen  = 0;
+    x_uchar_t  xbt_file[XNTP_STATE_MAXLEN];
+
+    if ((X_NULL == xszt_path) || (X_NULL == xstate_ptr))
+    {
+        return EINVAL;
+    }
+
+    memset(xstate_ptr, 0, sizeof(xntp_state_t));
+
+#ifdef _MSC_VER
+    if (0 != fopen_s(&xfile_ptr, xszt_path, "rb"))
+        xfile_ptr = X_NULL;
+#else // !_MSC_VER
+    xfile_ptr = fopen(xszt_path, "rb");
+#endif // _MSC_VER
+    if (X_NULL == xfile_ptr)
+    {
+        return errno;
+    }
+
+    xut_flen = (x_uint32_t)fread(xbt_file, 1, XNTP_STATE_MAXLEN, xfile_ptr);
+    fclose(xfile_ptr);
+
+    //======================================
+    // 头部
+
+    if (xut_flen < XNTP_STATE_HEAD + 8)
+    {
+        return EPROTO;
+    }
+
+    xut_dlen = ntp_load32(xbt_file + 8);
+    if ((XNTP_STATE_MAGIC   != ntp_load32(xbt_file    )) ||
+        (XNTP_STATE_VERSION != ntp_load32(xbt_file + 4)) ||
+        (xut_dlen != xut_flen - XNTP_STATE_HEAD) ||
+        (ntp_load32(xbt_file + 12) != ntpstate_fnv1a(xbt_file + XNTP_STATE_HEAD, xut_dlen)))
+    {
+        return EPROTO;
+    }
+
+    //======================================
+    // 记录
+
+    xstate_ptr->xtm_saved = (xtime_vnsec_t)ntp_load64(xbt_file + XNTP_STATE_HEAD);
+
+    for (xut_iter = XNTP_STATE_HEAD + 8; (0 == xit_errno) && (xut_iter < xut_flen); xut_iter += 8 + xut_rlen)
+    {
+        if (xut_iter + 8 > xut_flen)
+        {
+            xit_errno = EPROTO;
+            break;
+        }
+
+        xut_type = ntp_load32(xbt_file + xut_iter);
+        xut_rlen = ntp_load32(xbt_file + xut_iter + 4);
+        if (xut_rlen > xut_flen - xut_iter - 8)
+        {
+            xit_errno = EPROTO;
+            break;
+        }
+
+        xit_errno = ntpstate_record(xstate_ptr, xut_type, xbt_file + xut_iter + 8, xut_rlen);
+    }
+
+    if (0 != xit_errno)
+    {
+        memset(xstate_ptr, 0, sizeof(xntp_state_t));
+    }
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 热启动状态 保存到 状态文件。
+ * @note
+ * 先写入 临时文件（路径 加 “.tmp” 后缀），再 整体替换，进程 中途退出 不会 留下 残缺的 文件。
+ *
+ * @param [in ] xszt_path  : 文件路径。
+ * @param [in ] xstate_ptr : 热启动状态。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpstate_save(x_cstring_t xszt_path, const xntp_state_t * xstate_ptr)
+{
+    x_int32_t  xit_errno = 0;
+    FILE     * xfile_ptr = X_NULL;
+    x_uint32_t xut_flen  = 0;
+    x_uint32_t xut_hlen  = 0;
+    x_uint32_t xut_iter  = 0;
+    x_uchar_t  xbt_file[XNTP_STATE_MAXLEN];
+    x_char_t   xszt_temp[TEXT_LEN_256 + 8];
+
+    if ((X_NULL == xszt_path) || (X_NULL == xstate_ptr) || (strlen(xszt_path) >= TEXT_LEN_256))
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 数据：保存时刻 与 各条记录
+
+    xut_flen = XNTP_STATE_HEAD;
+    ntp_store64(xbt_file + xut_flen, (x_uint64_t)xstate_ptr->xtm_saved);
+    xut_flen += 8;
+
+    if (xstate_ptr->xbt_freq)
+    {
+        ntp_store32(xbt_file + xut_flen    , XNTP_STREC_FREQ);
+        ntp_store32(xbt_file + xut_flen + 4, 8);
+        ntp_store64(xbt_file + xut_flen + 8, (x_uint64_t)xstate_ptr->xit_freq);
+        xut_flen += 16;
+    }
+
+    xut_hlen = (x_uint32_t)strlen(xstate_ptr->xszt_host);
+    if ((xut_hlen > 0) && (xut_hlen < TEXT_LEN_256) &&
+        (xstate_ptr->xut_naddr > 0) && (xstate_ptr->xut_naddr <= XNTP_STATE_ADDRS))
+    {
+        ntp_store32(xbt_file + xut_flen     , XNTP_STREC_ADDR);
+        ntp_store32(xbt_file + xut_flen +  4, 16 + 4 * xstate_ptr->xut_naddr + xut_hlen);
+        ntp_store64(xbt_file + xut_flen +  8, (x_uint64_t)xstate_ptr->xtm_expire);
+        ntp_store32(xbt_file + xut_flen + 16, xstate_ptr->xut_port);
+        ntp_store32(xbt_file + xut_flen + 20, xstate_ptr->xut_naddr);
+        xut_flen += 24;
+
+        for (xut_iter = 0; xut_iter < xstate_ptr->xut_naddr; ++xut_iter)
+        {
+            ntp_store32(xbt_file + xut_flen, xstate_ptr->xut_addrs[xut_iter]);
+            xut_flen += 4;
+        }
+
+        memcpy(xbt_file + xut_flen, xstate_ptr->xszt_host, xut_hlen);
+        xut_flen += xut_hlen;
+    }
+
+    //======================================
+    // 头部
+
+    ntp_store32(xbt_file     , XNTP_STATE_MAGIC);
+    ntp_store32(xbt_file +  4, XNTP_STATE_VERSION);
+    ntp_store32(xbt_file +  8, xut_flen - XNTP_STATE_HEAD);
+    ntp_store32(xbt_file + 12, ntpstate_fnv1a(xbt_file + XNTP_STATE_HEAD, xut_flen - XNTP_STATE_HEAD));
+
+    //======================================
+    // 写入 临时文件，再 替换
+
+    snprintf(xszt_temp, sizeof(xszt_temp), "%s.tmp", xszt_path);
+
+#ifdef _MSC_VER
+    if (0 != fopen_s(&xfile_ptr, xszt_temp, "wb"))
+        xfile_ptr = X_NULL;
+#else // !_MSC_VER
+    xfile_ptr = fopen(xszt_temp, "wb");
+#endif // _MSC_VER
+    if (X_NULL == xfile_ptr)
+    {
+        return errno;
+    }
+
+    if ((xut_flen != (x_uint32_t)fwrite(xbt_file, 1, xut_flen, xfile_ptr)) || (0 != fflush(xfile_ptr)))
+    {
+        xit_errno = EIO;
+    }
+
+    fclose(xfile_ptr);
+
+#if defined(_WIN32) || defined(_WIN64)
+    if ((0 == xit_errno) && !MoveFileExA(xszt_temp, xszt_path, MOVEFILE_REPLACE_EXISTING))
+        xit_errno = EACCES;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    if ((0 == xit_errno) && (0 != rename(xszt_temp, xszt_path)))
+        xit_errno = errno;
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    if (0 != xit_errno)
+    {
+        remove(xszt_temp);
+    }
+
+    return xit_errno;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,117 @@
+﻿/**
+ * @file ntp_state.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 客户端 的 热启动状态文件（频率估计、域名解析结果 及其 过期时刻）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef __NTP_STATE_H__
+#define __NTP_STATE_H__
+
+#include "xtime.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 状态文件 的 标识（"XNST"） */
+#define XNTP_STATE_MAGIC    0x584E5354U
+
+/** 状态文件 的 格式版本（记录 的 增加 不改变 版本号，读取时 跳过 未知的 记录） */
+#define XNTP_STATE_VERSION  1
+
+/** 缓存的 域名解析地址 的 数量上限 */
+#define XNTP_STATE_ADDRS    8
+
+/** 域名解析结果 的 有效时长（秒）：getaddrinfo() 不提供 TTL，取 固定值 */
+#define XNTP_STATE_ADDR_TTL 3600
+
+/** 两次 自动保存 的 最短间隔（秒，参看 ntpcli_state()） */
+#define XNTP_STATE_PERIOD   64
+
+/**
+ * @struct xntp_state_t
+ * @brief  客户端 的 热启动状态（对应 状态文件 中的 各类 记录）。
+ */
+typedef struct xntp_state_t
+{
+    xtime_vnsec_t xtm_saved;                    ///< 保存 的 时刻（UTC）
+
+    x_bool_t      xbt_freq;                     ///< 是否 含有 频率估计
+    x_int64_t     xit_freq;                     ///< TSC 时钟 的 频率偏差（ppb，参看 xntp_clkstat_t）
+
+    x_char_t      xszt_host[TEXT_LEN_256];      ///< 已解析的 域名（空串 表示 没有）
+    x_uint16_t    xut_port;                     ///< 服务端 的 端口号
+    x_uint32_t    xut_naddr;                    ///< 解析所得的 地址数量
+    x_uint32_t    xut_addrs[XNTP_STATE_ADDRS];  ///< 解析所得的 IPv4 地址（主机字节序；首项 为 最近一次 成功请求 的 地址）
+    xtime_vnsec_t xtm_expire;                   ///< 解析结果 的 过期时刻（UTC）
+} xntp_state_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 从 状态文件 加载 热启动状态。
+ * @note
+ * 文件 由 头部（标识、版本、长度、校验和）与 若干条 记录（类型、长度、数据）组成，整数 均为 大端序；
+ * 校验和 不符（文件 损坏 或 被截断）时 整体拒绝；未知的 记录 被跳过，新版本 写出的 文件 因而 仍可读取。
+ *
+ * @param [in ] xszt_path : 文件路径。
+ * @param [out] xstate_ptr : 返回 热启动状态（文件 中 没有的 记录，对应字段 为 0）。
+ *
+ * @return x_int32_t : 成功，返回 0；文件 不存在，返回 ENOENT；格式 或 校验和 错误，返回 EPROTO。
+ */
+x_int32_t ntpstate_load(x_cstring_t xszt_path, xntp_state_t * xstate_ptr);
+
+/**********************************************************/
+/**
+ * @brief 将 热启动状态 保存到 状态文件。
+ * @note
+ * 先写入 临时文件（路径 加 “.tmp” 后缀），再 整体替换，进程 中途退出 不会 留下 残缺的 文件。
+ *
+ * @param [in ] xszt_path  : 文件路径。
+ * @param [in ] xstate_ptr : 热启动状态。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t ntpstate_save(x_cstring_t xszt_path, const xntp_state_t * xstate_ptr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __NTP_STATE_H__
@@ -0,0 +1,184 @@
+﻿/**
+ * @file xatomic.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 原子操作 与 线程局部存储 的 跨平台（GCC/Clang、MSVC）宏定义。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __XATOMIC_H__
+#define __XATOMIC_H__
+
+#include "xtypes.h"
+
+#include <stdlib.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <malloc.h>
+#endif // defined(_MSC_VER)
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 缓存行 的 字节数 */
+#define XCACHE_LINE     64
+
+/** 将 字节数 向上对齐到 缓存行 的整数倍 */
+#define XCACHE_ALIGN(xsize) \
+    (((x_size_t)(xsize) + XCACHE_LINE - 1) & ~((x_size_t)XCACHE_LINE - 1))
+
+/** 线程局部存储 的 变量修饰符 */
+#if defined(_MSC_VER)
+#define XTLS_VAR        __declspec(thread)
+#else // !defined(_MSC_VER)
+#define XTLS_VAR        __thread
+#endif // defined(_MSC_VER)
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+
+/** 读取（acquire 语义） */
+#define XATOMIC_LOAD32(xptr)                (*(volatile x_uint32_t *)(xptr))
+#define XATOMIC_LOAD64(xptr)                ((x_uint64_t)_InterlockedOr64((volatile __int64 *)(xptr), 0))
+#define XATOMIC_LOADPTR(xptr)               (*(PVOID volatile *)(xptr))
+
+/** 写入（release 语义） */
+#define XATOMIC_STORE32(xptr, xval)         _InterlockedExchange((volatile long *)(xptr), (long)(xval))
+#define XATOMIC_STORE64(xptr, xval)         _InterlockedExchange64((volatile __int64 *)(xptr), (__int64)(xval))
+#define XATOMIC_STOREPTR(xptr, xval)        ((x_void_t)_InterlockedExchangePointer((PVOID volatile *)(xptr), (PVOID)(xval)))
+
+/** 加法，返回 相加之前 的值 */
+#define XATOMIC_ADD32(xptr, xval)           ((x_uint32_t)_InterlockedExchangeAdd((volatile long *)(xptr), (long)(xval)))
+#define XATOMIC_ADD64(xptr, xval)           ((x_uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)(xptr), (__int64)(xval)))
+
+/** 比较并交换，成功时返回 非 0 */
+#define XATOMIC_CAS32(xptr, xcmp, xval)     \
+    ((long)(xcmp) == _InterlockedCompareExchange((volatile long *)(xptr), (long)(xval), (long)(xcmp)))
+#define XATOMIC_CASPTR(xptr, xcmp, xval)    \
+    ((PVOID)(xcmp) == _InterlockedCompareExchangePointer((PVOID volatile *)(xptr), (PVOID)(xval), (PVOID)(xcmp)))
+
+/** 交换，返回 交换之前 的值 */
+#define XATOMIC_XCHGPTR(xptr, xval)         _InterlockedExchangePointer((PVOID volatile *)(xptr), (PVOID)(xval))
+
+/** 完整的 内存屏障 */
+#define XATOMIC_FENCE()                     MemoryBarrier()
+
+/** 读取屏障：之后的 读取 不会 被提前到 之前的 读取 之前（x86 上 只约束 编译器） */
+#if defined(_M_X64) || defined(_M_IX86)
+#define XATOMIC_ACQUIRE()                   _ReadWriteBarrier()
+#else // !(defined(_M_X64) || defined(_M_IX86))
+#define XATOMIC_ACQUIRE()                   MemoryBarrier()
+#endif // defined(_M_X64) || defined(_M_IX86)
+
+/** 自旋等待时的 CPU 暂停提示 */
+#define XATOMIC_PAUSE()                     YieldProcessor()
+
+#else // !defined(_MSC_VER)
+
+/** 读取（acquire 语义） */
+#define XATOMIC_LOAD32(xptr)                __atomic_load_n((x_uint32_t *)(xptr), __ATOMIC_ACQUIRE)
+#define XATOMIC_LOAD64(xptr)                __atomic_load_n((x_uint64_t *)(xptr), __ATOMIC_ACQUIRE)
+#define XATOMIC_LOADPTR(xptr)               __atomic_load_n((x_pvoid_t *)(xptr), __ATOMIC_ACQUIRE)
+
+/** 写入（release 语义） */
+#define XATOMIC_STORE32(xptr, xval)         __atomic_store_n((x_uint32_t *)(xptr), (x_uint32_t)(xval), __ATOMIC_RELEASE)
+#define XATOMIC_STORE64(xptr, xval)         __atomic_store_n((x_uint64_t *)(xptr), (x_uint64_t)(xval), __ATOMIC_RELEASE)
+#define XATOMIC_STOREPTR(xptr, xval)        __atomic_store_n((x_pvoid_t *)(xptr), (x_pvoid_t)(xval), __ATOMIC_RELEASE)
+
+/** 加法，返回 相加之前 的值 */
+#define XATOMIC_ADD32(xptr, xval)           __atomic_fetch_add((x_uint32_t *)(xptr), (x_uint32_t)(xval), __ATOMIC_ACQ_REL)
+#define XATOMIC_ADD64(xptr, xval)           __atomic_fetch_add((x_uint64_t *)(xptr), (x_uint64_t)(xval), __ATOMIC_ACQ_REL)
+
+/** 比较并交换，成功时返回 非 0 */
+#define XATOMIC_CAS32(xptr, xcmp, xval)     __xatomic_cas32((x_uint32_t *)(xptr), (x_uint32_t)(xcmp), (x_uint32_t)(xval))
+#define XATOMIC_CASPTR(xptr, xcmp, xval)    __xatomic_casptr((x_pvoid_t *)(xptr), (x_pvoid_t)(xcmp), (x_pvoid_t)(xval))
+
+/** 交换，返回 交换之前 的值 */
+#define XATOMIC_XCHGPTR(xptr, xval)         __atomic_exchange_n((x_pvoid_t *)(xptr), (x_pvoid_t)(xval), __ATOMIC_ACQ_REL)
+
+static inline int __xatomic_cas32(x_uint32_t * xptr, x_uint32_t xcmp, x_uint32_t xval)
+{
+    return __atomic_compare_exchange_n(xptr, &xcmp, xval, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static inline int __xatomic_casptr(x_pvoid_t * xptr, x_pvoid_t xcmp, x_pvoid_t xval)
+{
+    return __atomic_compare_exchange_n(xptr, &xcmp, xval, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+/** 完整的 内存屏障 */
+#define XATOMIC_FENCE()                     __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/** 读取屏障：之后的 读取 不会 被提前到 之前的 读取 之前（x86 上 只约束 编译器） */
+#define XATOMIC_ACQUIRE()                   __atomic_thread_fence(__ATOMIC_ACQUIRE)
+
+/** 自旋等待时的 CPU 暂停提示 */
+#if defined(__x86_64__) || defined(__i386__)
+#define XATOMIC_PAUSE()                     __builtin_ia32_pause()
+#else // !(defined(__x86_64__) || defined(__i386__))
+#define XATOMIC_PAUSE()                     __asm__ __volatile__("" ::: "memory")
+#endif // defined(__x86_64__) || defined(__i386__)
+
+#endif // defined(_MSC_VER)
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 分配 首地址按缓存行对齐 的内存块（使用 xcache_free() 释放）。
+ */
+static inline x_pvoid_t xcache_alloc(x_size_t xst_size)
+{
+    x_pvoid_t xpvt_mptr = X_NULL;
+
+#if defined(_MSC_VER)
+    xpvt_mptr = _aligned_malloc(xst_size, XCACHE_LINE);
+#else // !defined(_MSC_VER)
+    if (0 != posix_memalign(&xpvt_mptr, XCACHE_LINE, xst_size))
+        xpvt_mptr = X_NULL;
+#endif // defined(_MSC_VER)
+
+    return xpvt_mptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 释放 xcache_alloc() 分配的内存块。
+ */
+static inline x_void_t xcache_free(x_pvoid_t xpvt_mptr)
+{
+#if defined(_MSC_VER)
+    _aligned_free(xpvt_mptr);
+#else // !defined(_MSC_VER)
+    free(xpvt_mptr);
+#endif // defined(_MSC_VER)
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XATOMIC_H__
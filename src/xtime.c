@@ -31,7 +31,10 @@
  */
 
 #include "xtime.h"
+#include "xatomic.h"
 #include <time.h>
+#include <string.h>
+#include <errno.h>
 
 #if (defined(_WIN32) || defined(_WIN64))
 #include <windows.h>
@@ -41,6 +44,10 @@
 #error "unknow platform!"
 #endif // PLATFORM
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#endif // defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef __GNUC__
@@ -59,105 +66,1004 @@
 /** 1601 ~ 1970 年之间的时间 百纳秒数 */
 #define XTIME_VNSEC_1601_1970 116444736000000000LL
 
+/** 首次校准 TSC 的 默认测量时长（毫秒） */
+#define XTIME_TSC_CALIB_MSEC  2
+
+/** 自动校准 的 最长间隔（秒） */
+#define XTIME_TSC_SPAN_MAX    1024
+
+/** 重新估计的 TSC 频率 偏离 超过该比例（1/N）时，放弃 原有的 校准起点（如 虚拟机迁移） */
+#define XTIME_TSC_DRIFT_MAX   1000
+
+/** TSC 换算关系 的 状态 */
+#define XTIME_TSC_NONE        0   ///< 尚未校准
+#define XTIME_TSC_BUSY        1   ///< 正在 首次校准
+#define XTIME_TSC_READY       2   ///< 可用
+#define XTIME_TSC_NOTSUP      3   ///< 不可用
+
+/**
+ * @struct xtime_tscmodel_t
+ * @brief  TSC 与 原始单调时钟 的 换算关系：ns = xut_nsec + (tsc - xut_tsc) * xut_mult / 2^32。
+ * @note
+ * 换算所用的 三个字段 由 序列锁 保护：xut_seqn 为奇数 时，正在更新（同时 起到 写者互斥 的作用）。
+ */
+typedef struct xtime_tscmodel_t
+{
+    x_uint32_t xut_seqn;      ///< 序列号
+    x_uint32_t xut_state;     ///< 状态（XTIME_TSC_*）
+    x_uint64_t xut_tsc;       ///< 换算基点 的 TSC 读数
+    x_uint64_t xut_nsec;      ///< 换算基点 的 纳秒数
+    x_uint64_t xut_mult;      ///< 每个 TSC 周期 的 纳秒数（32.32 定点数）
+    x_uint64_t xut_next;      ///< 下一次 自动校准 的 TSC 读数
+    x_uint64_t xut_freq;      ///< 估计的 TSC 频率（Hz）
+    x_uint32_t xut_span;      ///< 自动校准 的 间隔（秒，逐次倍增）
+    x_uint64_t xut_ref_tsc;   ///< 频率估计 的 起点：TSC 读数
+    x_uint64_t xut_ref_nsec;  ///< 频率估计 的 起点：原始单调时钟 的 纳秒数
+    x_uint64_t xut_half;      ///< 读取一次 系统时钟 所需 TSC 周期数 的一半（time_pair() 据此 推算 读取时刻）
+} xtime_tscmodel_t;
+
+/** 进程内 唯一的 TSC 换算关系 */
+static xtime_tscmodel_t g_xtm_tsc = { 0 };
+
+/** time_vtod() 缓存 每次 确认 时区偏移 不变的 时长（秒） */
+#define XTIME_VTOD_SPAN       3600
+
+/**
+ * @struct xtime_vtodcache_t
+ * @brief  time_vtod() 的 线程内缓存：最近一次 转换的 整秒，以及 已确认 时区偏移 不变的 时间段。
+ */
+typedef struct xtime_vtodcache_t
+{
+    x_uint64_t    xut_second;   ///< 缓存的 整秒（UTC 秒数，~0 表示 无效）
+    x_uint64_t    xut_from;     ///< 时区偏移 不变的 时间段 起点（UTC 秒数）
+    x_uint64_t    xut_until;    ///< 时区偏移 不变的 时间段 终点（UTC 秒数，不含；与 起点 相同 表示 无）
+    x_int64_t     xit_offset;   ///< 时区偏移（本地时间 减去 UTC，秒）
+    xtime_descr_t xtm_descr;    ///< xut_second 对应的 时间描述信息（毫秒 为 0）
+} xtime_vtodcache_t;
+
+/** 每个线程 的 time_vtod() 缓存 */
+static XTLS_VAR xtime_vtodcache_t g_xtm_vtod = { ~0ULL, 0, 0, 0, { 0 } };
+
+/** 1970-01-01 至 10000-01-01 的 天数（时间文本 的 年份 只有 4 位） */
+#define XTIME_TEXT_DAYS       2932897U
+
+/** 可格式化为 时间文本 的 时间计量值 上限（不含） */
+#define XTIME_TEXT_VNSEC      (XTIME_TEXT_DAYS * 86400ULL * 10000000ULL)
+
+/** 判断 时间文本 的 精度 是否有效（0、3、6、9） */
+#define XTIME_PREC_VALID(xprec) (((x_uint32_t)(xprec) <= 9) && (0 == (x_uint32_t)(xprec) % 3))
+
+/** 两位十进制数 00 ~ 99 的 字符表（格式化时 查表 一次写入 两个字符） */
+static const x_char_t XTIME_DIGITS2[200] =
+    "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+    "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+/** 平年 各月的 天数 */
+static const x_uint8_t XTIME_MONTH_DAYS[13] = { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
 //====================================================================
 
 // 
 // 内部相关的操作接口
 // 
 
+/**********************************************************/
+/**
+ * @brief 读取 原始单调时钟 的 纳秒数。
+ */
+static inline x_uint64_t time_raw_nsec(void)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    return time_mono_raw() * 100ULL;
+#elif (defined(__linux__) || defined(__unix__))
+    struct timespec xtm_value;
+#ifdef CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC_RAW, &xtm_value);
+#else // !CLOCK_MONOTONIC_RAW
+    clock_gettime(CLOCK_MONOTONIC, &xtm_value);
+#endif // CLOCK_MONOTONIC_RAW
+    return (x_uint64_t)xtm_value.tv_sec * 1000000000ULL + (x_uint64_t)xtm_value.tv_nsec;
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+}
+
+/**********************************************************/
+/**
+ * @brief 判断 TSC 是否为 恒定频率（x86 的 invariant TSC；ARM64 的 通用计时器 总是恒定频率）。
+ */
+static x_bool_t time_tsc_invariant(x_void_t)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    x_int32_t xit_regs[4] = { 0 };
+
+    __cpuid(xit_regs, 0x80000000);
+    if ((x_uint32_t)xit_regs[0] < 0x80000007)
+        return X_FALSE;
+    __cpuid(xit_regs, 0x80000007);
+    return (0 != (xit_regs[3] & (1 << 8)));
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    x_uint32_t xut_eax = 0;
+    x_uint32_t xut_ebx = 0;
+    x_uint32_t xut_ecx = 0;
+    x_uint32_t xut_edx = 0;
+
+    if (!__get_cpuid(0x80000007, &xut_eax, &xut_ebx, &xut_ecx, &xut_edx))
+        return X_FALSE;
+    return (0 != (xut_edx & (1 << 8)));
+#elif defined(__GNUC__) && defined(__aarch64__)
+    return X_TRUE;
+#else // UNKNOW
+    return X_FALSE;
+#endif // PLATFORM
+}
+
+/**********************************************************/
+/**
+ * @brief 紧凑地 采集一对 (TSC, 原始单调时钟) 读数：取 5 次中 前后两次 TSC 间隔 最短的一次，TSC 取其中点。
+ *
+ * @return x_uint64_t : 返回 最短的 TSC 间隔（即 读取一次 系统时钟 的 开销）。
+ */
+static x_uint64_t time_tsc_sample(x_uint64_t * xut_tsc, x_uint64_t * xut_nsec)
+{
+    x_uint32_t xut_iter = 0;
+    x_uint64_t xut_tsc0 = 0;
+    x_uint64_t xut_tsc1 = 0;
+    x_uint64_t xut_raw  = 0;
+    x_uint64_t xut_best = ~0ULL;
+
+    for (xut_iter = 0; xut_iter < 5; ++xut_iter)
+    {
+        xut_tsc0 = time_tsc();
+        xut_raw  = time_raw_nsec();
+        xut_tsc1 = time_tsc();
+
+        if ((xut_tsc1 - xut_tsc0) < xut_best)
+        {
+            xut_best  = xut_tsc1 - xut_tsc0;
+            *xut_tsc  = xut_tsc0 + (xut_best / 2);
+            *xut_nsec = xut_raw;
+        }
+    }
+
+    return xut_best;
+}
+
+/**********************************************************/
+/**
+ * @brief 按 给定的 换算关系，将 TSC 读数 换算为 纳秒数。
+ * @note
+ * 以 32 位 拆分 TSC 差值，避免 64 位乘法 溢出（差值 不超过 2^64 / 2^32 个周期 即可，远超 实际需要）。
+ */
+static inline x_uint64_t time_tsc_conv(x_uint64_t xut_tsc, x_uint64_t xut_base, x_uint64_t xut_nsec, x_uint64_t xut_mult)
+{
+    x_uint64_t xut_diff = (xut_tsc >= xut_base) ? (xut_tsc - xut_base) : (xut_base - xut_tsc);
+    x_uint64_t xut_span = ((xut_diff >> 32) * xut_mult) + (((xut_diff & 0xFFFFFFFFULL) * xut_mult) >> 32);
+
+    return (xut_tsc >= xut_base) ? (xut_nsec + xut_span) : (xut_nsec - xut_span);
+}
+
+/**********************************************************/
+/**
+ * @brief 在 序列锁 的保护下，发布 新的 换算关系（调用方 须已将 序列号 置为 奇数 xut_seqn）。
+ */
+static x_void_t time_tsc_publish(x_uint32_t xut_seqn, x_uint64_t xut_tsc, x_uint64_t xut_nsec, x_uint64_t xut_freq)
+{
+    x_uint32_t xut_span = XATOMIC_LOAD32(&g_xtm_tsc.xut_span);
+
+    xut_span = (0 == xut_span) ? 1 : ((xut_span < XTIME_TSC_SPAN_MAX) ? (xut_span * 2) : XTIME_TSC_SPAN_MAX);
+
+    XATOMIC_STORE64(&g_xtm_tsc.xut_tsc , xut_tsc);
+    XATOMIC_STORE64(&g_xtm_tsc.xut_nsec, xut_nsec);
+    XATOMIC_STORE64(&g_xtm_tsc.xut_mult, (x_uint64_t)(1000000000.0 * 4294967296.0 / (double)xut_freq));
+    XATOMIC_STORE64(&g_xtm_tsc.xut_freq, xut_freq);
+    XATOMIC_STORE64(&g_xtm_tsc.xut_next, xut_tsc + xut_freq * xut_span);
+    XATOMIC_STORE32(&g_xtm_tsc.xut_span, xut_span);
+    XATOMIC_STORE32(&g_xtm_tsc.xut_seqn, xut_seqn + 1);
+}
+
+/**********************************************************/
+/**
+ * @brief 首次校准：确认 TSC 可用，并在 xut_msec 毫秒内 测量 TSC 频率。
+ */
+static x_int32_t time_tsc_first(x_uint32_t xut_msec)
+{
+    x_uint32_t xut_seqn  = 0;
+    x_uint64_t xut_tsc0  = 0;
+    x_uint64_t xut_nsec0 = 0;
+    x_uint64_t xut_tsc1  = 0;
+    x_uint64_t xut_nsec1 = 0;
+    x_uint64_t xut_width = 0;
+    x_uint64_t xut_best  = 0;
+
+    if (!XATOMIC_CAS32(&g_xtm_tsc.xut_state, XTIME_TSC_NONE, XTIME_TSC_BUSY))
+    {
+        return (XTIME_TSC_NOTSUP == XATOMIC_LOAD32(&g_xtm_tsc.xut_state)) ? ENOTSUP : EBUSY;
+    }
+
+    if (!time_tsc_invariant() || (0 == time_tsc()))
+    {
+        XATOMIC_STORE32(&g_xtm_tsc.xut_state, XTIME_TSC_NOTSUP);
+        return ENOTSUP;
+    }
+
+    xut_width = time_tsc_sample(&xut_tsc0, &xut_nsec0);
+    do
+    {
+        XATOMIC_PAUSE();
+        xut_best  = time_tsc_sample(&xut_tsc1, &xut_nsec1);
+        xut_width = (xut_best < xut_width) ? xut_best : xut_width;
+    } while ((xut_nsec1 - xut_nsec0) < (x_uint64_t)xut_msec * 1000000ULL);
+
+    if (xut_tsc1 <= xut_tsc0)
+    {
+        XATOMIC_STORE32(&g_xtm_tsc.xut_state, XTIME_TSC_NOTSUP);
+        return ENOTSUP;
+    }
+
+    xut_seqn = XATOMIC_LOAD32(&g_xtm_tsc.xut_seqn);
+    XATOMIC_STORE32(&g_xtm_tsc.xut_seqn, xut_seqn + 1);
+    XATOMIC_STORE64(&g_xtm_tsc.xut_ref_tsc , xut_tsc0);
+    XATOMIC_STORE64(&g_xtm_tsc.xut_ref_nsec, xut_nsec0);
+    XATOMIC_STORE64(&g_xtm_tsc.xut_half    , xut_width / 2);
+    time_tsc_publish(xut_seqn + 1, xut_tsc1, xut_nsec1,
+                     (x_uint64_t)((double)(xut_tsc1 - xut_tsc0) * 1.0e9 / (double)(xut_nsec1 - xut_nsec0)));
+    XATOMIC_STORE32(&g_xtm_tsc.xut_state, XTIME_TSC_READY);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 重新校准：以 首次校准点 为起点 重新估计频率，换算基点 取 旧关系 在当前时刻的 换算值。
+ */
+static x_int32_t time_tsc_refine(x_void_t)
+{
+    x_uint32_t xut_seqn = XATOMIC_LOAD32(&g_xtm_tsc.xut_seqn);
+    x_uint64_t xut_tsc  = 0;
+    x_uint64_t xut_nsec = 0;
+    x_uint64_t xut_conv = 0;
+    x_uint64_t xut_freq = 0;
+    x_uint64_t xut_old  = 0;
+
+    if ((xut_seqn & 1) || !XATOMIC_CAS32(&g_xtm_tsc.xut_seqn, xut_seqn, xut_seqn + 1))
+    {
+        return EBUSY;
+    }
+
+    xut_seqn += 1;
+
+    time_tsc_sample(&xut_tsc, &xut_nsec);
+    xut_conv = time_tsc_conv(xut_tsc, g_xtm_tsc.xut_tsc, g_xtm_tsc.xut_nsec, g_xtm_tsc.xut_mult);
+    xut_old  = g_xtm_tsc.xut_freq;
+    xut_freq = (x_uint64_t)((double)(xut_tsc - g_xtm_tsc.xut_ref_tsc) * 1.0e9 /
+                            (double)(xut_nsec - g_xtm_tsc.xut_ref_nsec));
+
+    // 频率 突变（如 虚拟机迁移）时，以 当前 为 新的起点，并从 1 秒 的间隔 重新开始
+    if ((xut_freq > xut_old + xut_old / XTIME_TSC_DRIFT_MAX) ||
+        (xut_freq < xut_old - xut_old / XTIME_TSC_DRIFT_MAX))
+    {
+        XATOMIC_STORE64(&g_xtm_tsc.xut_ref_tsc , xut_tsc);
+        XATOMIC_STORE64(&g_xtm_tsc.xut_ref_nsec, xut_nsec);
+        XATOMIC_STORE32(&g_xtm_tsc.xut_span, 0);
+        xut_freq = xut_old;
+    }
+
+    time_tsc_publish(xut_seqn, xut_tsc, xut_conv, xut_freq);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 换算 TSC 读数（序列锁 的 读取方），TSC 尚未校准时 先做 首次校准。
+ *
+ * @param [in ] xut_tsc  : TSC 读数。
+ * @param [out] xut_nsec : 返回 换算所得的 纳秒数。
+ *
+ * @return x_bool_t : TSC 可用，返回 X_TRUE；否则 返回 X_FALSE。
+ */
+static inline x_bool_t time_tsc_read(x_uint64_t xut_tsc, x_uint64_t * xut_nsec)
+{
+    x_uint32_t xut_seqn = 0;
+    x_uint64_t xut_base = 0;
+    x_uint64_t xut_bns  = 0;
+    x_uint64_t xut_mult = 0;
+    x_uint64_t xut_next = 0;
+
+    if (XTIME_TSC_READY != XATOMIC_LOAD32(&g_xtm_tsc.xut_state))
+    {
+        if ((0 != time_tsc_first(XTIME_TSC_CALIB_MSEC)) &&
+            (XTIME_TSC_READY != XATOMIC_LOAD32(&g_xtm_tsc.xut_state)))
+        {
+            return X_FALSE;
+        }
+    }
+
+    for (;;)
+    {
+        xut_seqn = XATOMIC_LOAD32(&g_xtm_tsc.xut_seqn);
+        if (xut_seqn & 1)
+        {
+            XATOMIC_PAUSE();
+            continue;
+        }
+
+        xut_base = XATOMIC_LOAD64(&g_xtm_tsc.xut_tsc );
+        xut_bns  = XATOMIC_LOAD64(&g_xtm_tsc.xut_nsec);
+        xut_mult = XATOMIC_LOAD64(&g_xtm_tsc.xut_mult);
+        xut_next = XATOMIC_LOAD64(&g_xtm_tsc.xut_next);
+
+        if (xut_seqn == XATOMIC_LOAD32(&g_xtm_tsc.xut_seqn))
+            break;
+    }
+
+    *xut_nsec = time_tsc_conv(xut_tsc, xut_base, xut_bns, xut_mult);
+
+    if (xut_tsc >= xut_next)
+    {
+        time_tsc_refine();
+    }
+
+    return X_TRUE;
+}
+
+
+/**********************************************************/
+/**
+ * @brief 将 1970-01-01 以来的 天数 换算为 公历日期（年、月、日）。
+ * @note
+ * 以 3 月 1 日 为 一年之始（闰日 落在 年末），先按 400 年 周期 求出 世纪，
+ * 再以 定点乘法 代替除法 求出 世纪内的 年份、年内的 天数 与 月、日（Neri-Schneider 算法），不经 gmtime()。
+ */
+static inline x_void_t time_civil(
+                            x_uint32_t xut_days,
+                            x_uint32_t * xut_year,
+                            x_uint32_t * xut_month,
+                            x_uint32_t * xut_day)
+{
+    x_uint32_t xut_n1   = 4 * (xut_days + 719468) + 3;      // 0000-03-01 以来的 天数（乘 4 加 3）
+    x_uint32_t xut_cent = xut_n1 / 146097;
+    x_uint32_t xut_n2   = (xut_n1 % 146097) | 3;            // 世纪内的 天数（乘 4 加 3）
+    x_uint64_t xut_p2   = 2939745ULL * xut_n2;
+    x_uint32_t xut_doy  = (x_uint32_t)(xut_p2 & 0xFFFFFFFFULL) / 2939745 / 4;
+    x_uint32_t xut_n3   = 2141 * xut_doy + 197913;
+    x_uint32_t xut_jan  = (xut_doy >= 306) ? 1 : 0;         // 1、2 月 属于 下一年
+
+    *xut_year  = 100 * xut_cent + (x_uint32_t)(xut_p2 >> 32) + xut_jan;
+    *xut_month = (xut_n3 >> 16) - 12 * xut_jan;
+    *xut_day   = (xut_n3 & 0xFFFF) / 2141 + 1;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 公历日期 换算为 1970-01-01 以来的 天数（time_civil() 的 逆运算，年份 不小于 1）。
+ */
+static inline x_int64_t time_days(x_uint32_t xut_year, x_uint32_t xut_month, x_uint32_t xut_day)
+{
+    x_uint32_t xut_yadj = xut_year - ((xut_month <= 2) ? 1 : 0);
+    x_uint32_t xut_era  = xut_yadj / 400;
+    x_uint32_t xut_yoe  = xut_yadj - xut_era * 400;
+    x_uint32_t xut_doy  = (153 * ((xut_month > 2) ? (xut_month - 3) : (xut_month + 9)) + 2) / 5 + xut_day - 1;
+    x_uint32_t xut_doe  = xut_yoe * 365 + xut_yoe / 4 - xut_yoe / 100 + xut_doy;
+
+    return (x_int64_t)xut_era * 146097 + (x_int64_t)xut_doe - 719468;
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 两位十进制数（0 ~ 99）。
+ */
+static inline x_void_t time_put2(x_char_t * xszt_text, x_uint32_t xut_value)
+{
+    memcpy(xszt_text, XTIME_DIGITS2 + 2 * xut_value, 2);
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 日期部分 “YYYY-MM-DD”（10 个字符）。
+ */
+static inline x_void_t time_put_date(
+                            x_char_t * xszt_text,
+                            x_uint32_t xut_year,
+                            x_uint32_t xut_month,
+                            x_uint32_t xut_day)
+{
+    time_put2(xszt_text + 0, xut_year / 100);
+    time_put2(xszt_text + 2, xut_year % 100);
+    xszt_text[4] = '-';
+    time_put2(xszt_text + 5, xut_month);
+    xszt_text[7] = '-';
+    time_put2(xszt_text + 8, xut_day);
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 时间部分 “THH:MM:SS”（9 个字符）。
+ */
+static inline x_void_t time_put_clock(
+                            x_char_t * xszt_text,
+                            x_uint32_t xut_hour,
+                            x_uint32_t xut_minute,
+                            x_uint32_t xut_second)
+{
+    xszt_text[0] = 'T';
+    time_put2(xszt_text + 1, xut_hour);
+    xszt_text[3] = ':';
+    time_put2(xszt_text + 4, xut_minute);
+    xszt_text[6] = ':';
+    time_put2(xszt_text + 7, xut_second);
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 小数部分 “.fffffffff”（截取为 xut_prec 位，0 位时 不写入 小数点）、时区标识 与 结尾的 '\0'。
+ * @note
+ * 先以 定长方式 写满 9 位（无分支），再在 截取处 写入 时区标识，故 须有 12 个字符的 空间。
+ *
+ * @param [out] xszt_text : 写入位置。
+ * @param [in ] xut_frac  : 秒的小数部分（以 100纳秒 为单位，0 ~ 9999999）。
+ * @param [in ] xut_prec  : 小数位数（0、3、6、9）。
+ * @param [in ] xch_zone  : 时区标识（'Z'，或 '\0' 表示 不带时区）。
+ *
+ * @return x_uint32_t : 返回 写入的 字符数（不含 '\0'）。
+ */
+static inline x_uint32_t time_put_frac(
+                            x_char_t * xszt_text,
+                            x_uint32_t xut_frac,
+                            x_uint32_t xut_prec,
+                            x_char_t xch_zone)
+{
+    x_uint32_t xut_tlen = (0 == xut_prec) ? 0 : (xut_prec + 1);
+
+    xszt_text[0] = '.';
+    time_put2(xszt_text + 1, xut_frac / 100000);
+    time_put2(xszt_text + 3, (xut_frac / 1000) % 100);
+    time_put2(xszt_text + 5, (xut_frac / 10) % 100);
+    xszt_text[7] = (x_char_t)('0' + xut_frac % 10);
+    xszt_text[8] = '0';
+    xszt_text[9] = '0';
+
+    xszt_text[xut_tlen    ] = xch_zone;
+    xszt_text[xut_tlen + 1] = '\0';
+
+    return xut_tlen + (('\0' != xch_zone) ? 1 : 0);
+}
+
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 格式化为 “YYYY-MM-DDTHH:MM:SS[.f...]Z”，time_vtos() 与 time_vtos_batch() 共用。
+ * @note
+ * 调用方 须确保 xtm_vnsec 小于 XTIME_TEXT_VNSEC；xszt_date 不为 X_NULL 时，
+ * 作为 日期部分 的 缓存：*xut_last 与 当天的 天数 相同，直接拷贝，否则 换算后 更新缓存。
+ */
+static inline x_uint32_t time_vtos_fill(
+                            xtime_vnsec_t xtm_vnsec,
+                            x_uint32_t xut_prec,
+                            x_char_t * xszt_text,
+                            x_char_t * xszt_date,
+                            x_uint32_t * xut_last)
+{
+    x_uint64_t xut_secs  = xtm_vnsec / 10000000ULL;
+    x_uint32_t xut_days  = (x_uint32_t)(xut_secs / 86400);
+    x_uint32_t xut_sod   = (x_uint32_t)(xut_secs - xut_days * 86400ULL);
+    x_uint32_t xut_year  = 0;
+    x_uint32_t xut_month = 0;
+    x_uint32_t xut_day   = 0;
+
+    if ((X_NULL == xszt_date) || (xut_days != *xut_last))
+    {
+        time_civil(xut_days, &xut_year, &xut_month, &xut_day);
+        time_put_date(xszt_text, xut_year, xut_month, xut_day);
+
+        if (X_NULL != xszt_date)
+        {
+            memcpy(xszt_date, xszt_text, 10);
+            *xut_last = xut_days;
+        }
+    }
+    else
+    {
+        memcpy(xszt_text, xszt_date, 10);
+    }
+
+    time_put_clock(xszt_text + 10, xut_sod / 3600, (xut_sod / 60) % 60, xut_sod % 60);
+
+    return 19 + time_put_frac(xszt_text + 19,
+                              (x_uint32_t)(xtm_vnsec - xut_secs * 10000000ULL),
+                              xut_prec,
+                              'Z');
+}
+
+/**********************************************************/
+/**
+ * @brief 求取 某年某月 的 天数。
+ */
+static inline x_uint32_t time_mdays(x_uint32_t xut_year, x_uint32_t xut_month)
+{
+#define IS_LEAP_YEAR(Y) ((0 == (Y) % 400) || ((0 == (Y) % 4) && (0 != (Y) % 100)))
+    return XTIME_MONTH_DAYS[xut_month] + (((2 == xut_month) && IS_LEAP_YEAR(xut_year)) ? 1 : 0);
+#undef IS_LEAP_YEAR
+}
+
+/**********************************************************/
+/**
+ * @brief 将 时间描述信息 的 整秒部分 按 UTC 换算为 1970 年以来的 秒数（与 实际的 UTC 秒数 之差 即为 时区偏移）。
+ */
+static inline x_int64_t time_descr_secs(xtime_descr_t xtm_descr)
+{
+    return time_days(xtm_descr.ctx_year, xtm_descr.ctx_month, xtm_descr.ctx_day) * 86400LL +
+           (x_int64_t)(xtm_descr.ctx_hour * 3600 + xtm_descr.ctx_minute * 60 + xtm_descr.ctx_second);
+}
+
+/**********************************************************/
+/**
+ * @brief 按 已知的 时区偏移，以 算术方式 将 UTC 秒数 换算为 时间描述信息（毫秒 为 0）。
+ */
+static inline xtime_descr_t time_vtod_arith(x_uint64_t xut_second, x_int64_t xit_offset)
+{
+    xtime_descr_t xtm_descr = { 0 };
+    x_uint64_t    xut_local = (x_uint64_t)((x_int64_t)xut_second + xit_offset);
+    x_uint32_t    xut_days  = (x_uint32_t)(xut_local / 86400);
+    x_uint32_t    xut_sod   = (x_uint32_t)(xut_local - xut_days * 86400ULL);
+    x_uint32_t    xut_year  = 0;
+    x_uint32_t    xut_month = 0;
+    x_uint32_t    xut_day   = 0;
+
+    time_civil(xut_days, &xut_year, &xut_month, &xut_day);
+
+    xtm_descr.ctx_year   = xut_year;
+    xtm_descr.ctx_month  = xut_month;
+    xtm_descr.ctx_day    = xut_day;
+    xtm_descr.ctx_week   = (xut_days + 4) % 7;  // 1970-01-01 为 星期四
+    xtm_descr.ctx_hour   = xut_sod / 3600;
+    xtm_descr.ctx_minute = (xut_sod / 60) % 60;
+    xtm_descr.ctx_second = xut_sod % 60;
+
+    return xtm_descr;
+}
+
+/**********************************************************/
+/**
+ * @brief 调用 系统接口（localtime_r() 等）将 时间计量值 转换为 时间描述信息（不经 线程内缓存）。
+ */
+static xtime_descr_t time_vtod_sys(xtime_vnsec_t xtm_vnsec)
+{
+    xtime_descr_t xtm_descr = { 0 };
+
+#if (defined(_WIN32) || defined(_WIN64))
+
+    ULARGE_INTEGER xtm_value;
+    FILETIME       xtm_sfile;
+    FILETIME       xtm_lfile;
+    SYSTEMTIME     xtm_local;
+
+    xtm_value.QuadPart       = xtm_vnsec + XTIME_VNSEC_1601_1970;
+    xtm_sfile.dwLowDateTime  = xtm_value.LowPart;
+    xtm_sfile.dwHighDateTime = xtm_value.HighPart;
+    if (FileTimeToLocalFileTime(&xtm_sfile, &xtm_lfile))
+    {
+        if (FileTimeToSystemTime(&xtm_lfile, &xtm_local))
+        {
+            xtm_descr.ctx_year   = xtm_local.wYear        ;
+            xtm_descr.ctx_month  = xtm_local.wMonth       ;
+            xtm_descr.ctx_day    = xtm_local.wDay         ;
+            xtm_descr.ctx_week   = xtm_local.wDayOfWeek   ;
+            xtm_descr.ctx_hour   = xtm_local.wHour        ;
+            xtm_descr.ctx_minute = xtm_local.wMinute      ;
+            xtm_descr.ctx_second = xtm_local.wSecond      ;
+            xtm_descr.ctx_msec   = xtm_local.wMilliseconds;
+        }
+    }
+
+#elif (defined(__linux__) || defined(__unix__))
+
+    struct tm xtm_local;
+    time_t xtm_time = (time_t)(xtm_vnsec / 10000000ULL);
+    if (X_NULL == localtime_r(&xtm_time, &xtm_local))
+        return xtm_descr;
+
+    xtm_descr.ctx_year   = xtm_local.tm_year + 1900;
+    xtm_descr.ctx_month  = xtm_local.tm_mon  + 1   ;
+    xtm_descr.ctx_day    = xtm_local.tm_mday       ;
+    xtm_descr.ctx_week   = xtm_local.tm_wday       ;
+    xtm_descr.ctx_hour   = xtm_local.tm_hour       ;
+    xtm_descr.ctx_minute = xtm_local.tm_min        ;
+    xtm_descr.ctx_second = xtm_local.tm_sec        ;
+    xtm_descr.ctx_msec   = (x_uint32_t)((xtm_vnsec % 10000000ULL) / 10000L);
+
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+    return xtm_descr;
+}
+
+/**********************************************************/
+/**
+ * @brief 判断 时间描述信息 的 各个字段 是否 在 取值范围 内（年份 1970 ~ 9999，不校验 星期）。
+ */
+static inline x_bool_t time_descr_fields_valid(xtime_descr_t xtm_descr)
+{
+    return ((xtm_descr.ctx_year   >= 1970) && (xtm_descr.ctx_year   <= 9999) &&
+            (xtm_descr.ctx_month  >=    1) && (xtm_descr.ctx_month  <=   12) &&
+            (xtm_descr.ctx_day    >=    1) &&
+            (xtm_descr.ctx_day    <= time_mdays(xtm_descr.ctx_year, xtm_descr.ctx_month)) &&
+            (xtm_descr.ctx_hour   <=   23) && (xtm_descr.ctx_minute <=   59) &&
+            (xtm_descr.ctx_second <=   60) && (xtm_descr.ctx_msec   <=  999));
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 两位十进制数；含有 非数字字符 时，返回 100（超出 所有字段的 取值范围）。
+ */
+static inline x_uint32_t time_get2(x_cstring_t xszt_text)
+{
+    x_uint32_t xut_hi = (x_uint32_t)(x_uchar_t)xszt_text[0] - '0';
+    x_uint32_t xut_lo = (x_uint32_t)(x_uchar_t)xszt_text[1] - '0';
+
+    return ((xut_hi > 9) || (xut_lo > 9)) ? 100 : (xut_hi * 10 + xut_lo);
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 时间文本 的 “YYYY-MM-DDTHH:MM:SS[.f...]” 部分（不含 时区）。
+ *
+ * @param [in ] xszt_text : 文本。
+ * @param [in ] xut_tlen  : 文本长度。
+ * @param [out] xut_field : 依次为 年、月、日、时、分、秒、秒的小数部分（以 100纳秒 为单位）。
+ *
+ * @return x_uint32_t : 成功，返回 已解析的 字符数；格式错误、字段越界，返回 0。
+ */
+static x_uint32_t time_parse_fields(x_cstring_t xszt_text, x_uint32_t xut_tlen, x_uint32_t xut_field[7])
+{
+    x_uint32_t xut_hi   = 0;
+    x_uint32_t xut_lo   = 0;
+    x_uint32_t xut_tpos = 19;
+    x_uint32_t xut_ndig = 0;
+
+    if ((X_NULL == xszt_text) || (xut_tlen < 19) ||
+        ('-' != xszt_text[4]) || ('-' != xszt_text[7]) ||
+        (('T' != xszt_text[10]) && ('t' != xszt_text[10]) && (' ' != xszt_text[10])) ||
+        (':' != xszt_text[13]) || (':' != xszt_text[16]))
+    {
+        return 0;
+    }
+
+    xut_hi = time_get2(xszt_text + 0);
+    xut_lo = time_get2(xszt_text + 2);
+    if ((xut_hi > 99) || (xut_lo > 99))
+        return 0;
+
+    xut_field[0] = xut_hi * 100 + xut_lo;
+    xut_field[1] = time_get2(xszt_text +  5);
+    xut_field[2] = time_get2(xszt_text +  8);
+    xut_field[3] = time_get2(xszt_text + 11);
+    xut_field[4] = time_get2(xszt_text + 14);
+    xut_field[5] = time_get2(xszt_text + 17);
+    xut_field[6] = 0;
+
+    if ((xut_field[0] < 1) || (xut_field[1] < 1) || (xut_field[1] > 12) ||
+        (xut_field[3] > 23) || (xut_field[4] > 59) || (xut_field[5] > 60))
+    {
+        return 0;
+    }
+
+    if ((xut_field[2] < 1) || (xut_field[2] > time_mdays(xut_field[0], xut_field[1])))
+        return 0;
+
+    //======================================
+    // 小数部分：1 ~ 9 位，只保留 前 7 位（100纳秒）
+
+    if ((xut_tpos < xut_tlen) && ('.' == xszt_text[xut_tpos]))
+    {
+        for (xut_tpos += 1; xut_tpos < xut_tlen; ++xut_tpos, ++xut_ndig)
+        {
+            xut_lo = (x_uint32_t)(x_uchar_t)xszt_text[xut_tpos] - '0';
+            if (xut_lo > 9)
+                break;
+            if (xut_ndig < 7)
+                xut_field[6] = xut_field[6] * 10 + xut_lo;
+        }
+
+        if ((xut_ndig < 1) || (xut_ndig > 9))
+            return 0;
+
+        for (; xut_ndig < 7; ++xut_ndig)
+            xut_field[6] *= 10;
+    }
+
+    return xut_tpos;
+}
 
 //====================================================================
 
-// 
-// 外部相关操作接口
-// 
+// 
+// 外部相关操作接口
+// 
+
+/**********************************************************/
+/**
+ * @brief 获取当前系统的 时间计量值。
+ */
+xtime_vnsec_t time_vnsec(void)
+{
+    xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
+
+#if (defined(_WIN32) || defined(_WIN64))
+
+    FILETIME       xtm_sfile;
+    ULARGE_INTEGER xtm_value;
+
+    GetSystemTimeAsFileTime(&xtm_sfile);
+    xtm_value.LowPart  = xtm_sfile.dwLowDateTime;
+    xtm_value.HighPart = xtm_sfile.dwHighDateTime;
+
+    xtm_vnsec = (xtime_vnsec_t)(xtm_value.QuadPart - XTIME_VNSEC_1601_1970);
+
+#elif (defined(__linux__) || defined(__unix__))
+
+    struct timeval xtm_value;
+    gettimeofday(&xtm_value, X_NULL);
+
+    xtm_vnsec = (xtime_vnsec_t)(xtm_value.tv_sec * 10000000ULL + xtm_value.tv_usec * 10ULL);
+
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+    return xtm_vnsec;
+}
+
+/**********************************************************/
+/**
+ * @brief 获取当前系统的 时间描述信息。
+ */
+xtime_descr_t time_descr(void)
+{
+    xtime_descr_t xtm_descr = { 0 };
+
+#if (defined(_WIN32) || defined(_WIN64))
+
+    SYSTEMTIME xtm_local;
+
+    GetLocalTime(&xtm_local);
+
+    xtm_descr.ctx_year   = xtm_local.wYear        ;
+    xtm_descr.ctx_month  = xtm_local.wMonth       ;
+    xtm_descr.ctx_day    = xtm_local.wDay         ;
+    xtm_descr.ctx_week   = xtm_local.wDayOfWeek   ;
+    xtm_descr.ctx_hour   = xtm_local.wHour        ;
+    xtm_descr.ctx_minute = xtm_local.wMinute      ;
+    xtm_descr.ctx_second = xtm_local.wSecond      ;
+    xtm_descr.ctx_msec   = xtm_local.wMilliseconds;
+
+#elif (defined(__linux__) || defined(__unix__))
+
+    time_t         xtm_time;
+    struct tm      xtm_local;
+    struct timeval xtm_value;
+
+    gettimeofday(&xtm_value, X_NULL);
+
+    xtm_time = (time_t)(xtm_value.tv_sec);
+    localtime_r(&xtm_time, &xtm_local);
+
+    xtm_descr.ctx_year   = xtm_local.tm_year + 1900;
+    xtm_descr.ctx_month  = xtm_local.tm_mon  + 1   ;
+    xtm_descr.ctx_day    = xtm_local.tm_mday       ;
+    xtm_descr.ctx_week   = xtm_local.tm_wday       ;
+    xtm_descr.ctx_hour   = xtm_local.tm_hour       ;
+    xtm_descr.ctx_minute = xtm_local.tm_min        ;
+    xtm_descr.ctx_second = xtm_local.tm_sec        ;
+    xtm_descr.ctx_msec   = (x_uint32_t)(xtm_value.tv_usec / 1000);
+
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+    return xtm_descr;
+}
+
+/**********************************************************/
+/**
+ * @brief 获取系统 单调时钟 的 时间计量值（以 100纳秒 为单位）。
+ * @note
+ * 单调时钟的起点未定义，不受系统时间调整（校时、跳变）的影响，
+ * 只适用于计算 时间间隔 或 截止时间（deadline）。
+ */
+xtime_vnsec_t time_mono(void)
+{
+    xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
+
+#if (defined(_WIN32) || defined(_WIN64))
+
+    LARGE_INTEGER xtm_count;
+    LARGE_INTEGER xtm_freqs;
+
+    QueryPerformanceCounter(&xtm_count);
+    QueryPerformanceFrequency(&xtm_freqs);
+
+    xtm_vnsec = (xtime_vnsec_t)(
+                    (xtm_count.QuadPart / xtm_freqs.QuadPart) * 10000000ULL +
+                    (xtm_count.QuadPart % xtm_freqs.QuadPart) * 10000000ULL / xtm_freqs.QuadPart);
+
+#elif (defined(__linux__) || defined(__unix__))
+
+    struct timespec xtm_value;
+    clock_gettime(CLOCK_MONOTONIC, &xtm_value);
+
+    xtm_vnsec = (xtime_vnsec_t)(xtm_value.tv_sec * 10000000ULL + xtm_value.tv_nsec / 100ULL);
+
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+
+    return xtm_vnsec;
+}
+
+/**********************************************************/
+/**
+ * @brief 获取 原始单调时钟 的 时间计量值（以 100纳秒 为单位）。
+ * @note
+ * Linux 上 为 CLOCK_MONOTONIC_RAW：不受 校时 的 频率微调（adjtime/NTP slew）影响，
+ * 适合 作为 测量 往返时延 等 短时间间隔 的基准；Windows 上 与 time_mono() 相同。
+ */
+xtime_vnsec_t time_mono_raw(void)
+{
+#if (defined(_WIN32) || defined(_WIN64))
+    return time_mono();
+#elif (defined(__linux__) || defined(__unix__))
+    return (xtime_vnsec_t)(time_raw_nsec() / 100ULL);
+#else // UNKNOW
+#error "unknow platform!"
+#endif // PLATFORM
+}
+
+/**********************************************************/
+/**
+ * @brief 校准 TSC 与 原始单调时钟 的 换算关系。
+ * @note
+ * 首次调用 在 xut_msec 毫秒内 自旋测量 TSC 频率（首次使用 time_tsc_to_ns() 等接口 时，会以 2 毫秒 自动执行）；
+ * 此后 每次调用，以 首次校准点 为起点 重新估计频率（基线越长，精度越高），
+ * 且 换算结果 连续、单调（新的 换算基点 取 旧关系 在当前时刻的 换算值）。
+ * 换算时 也会 按 1、2、4 ... 1024 秒 的 间隔 自动校准，通常 无须 显式调用。
+ * 换算关系 以 序列锁（seqlock）发布，读取方 无锁；并发的 校准 只有一个 生效。
+ *
+ * @param [in ] xut_msec : 首次校准 的 测量时长（毫秒），取 0 时 使用 默认值。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；TSC 不可用（非 恒定频率，或 平台不支持），返回 ENOTSUP；正被 其他线程 校准，返回 EBUSY。
+ */
+x_int32_t time_tsc_calibrate(x_uint32_t xut_msec)
+{
+    switch (XATOMIC_LOAD32(&g_xtm_tsc.xut_state))
+    {
+    case XTIME_TSC_NONE  : return time_tsc_first((0 != xut_msec) ? xut_msec : XTIME_TSC_CALIB_MSEC);
+    case XTIME_TSC_READY : return time_tsc_refine();
+    case XTIME_TSC_BUSY  : return EBUSY;
+    default              : break;
+    }
+
+    return ENOTSUP;
+}
 
 /**********************************************************/
 /**
- * @brief 获取当前系统的 时间计量值。
+ * @brief 返回 校准所得的 TSC 频率（Hz）；TSC 不可用 时，返回 0。
  */
-xtime_vnsec_t time_vnsec(void)
+x_uint64_t time_tsc_freq(void)
 {
-    xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
-
-#if (defined(_WIN32) || defined(_WIN64))
-
-    FILETIME       xtm_sfile;
-    ULARGE_INTEGER xtm_value;
-
-    GetSystemTimeAsFileTime(&xtm_sfile);
-    xtm_value.LowPart  = xtm_sfile.dwLowDateTime;
-    xtm_value.HighPart = xtm_sfile.dwHighDateTime;
+    x_uint64_t xut_nsec = 0;
 
-    xtm_vnsec = (xtime_vnsec_t)(xtm_value.QuadPart - XTIME_VNSEC_1601_1970);
-
-#elif (defined(__linux__) || defined(__unix__))
+    if (!time_tsc_read(time_tsc(), &xut_nsec))
+    {
+        return 0;
+    }
 
-    struct timeval xtm_value;
-    gettimeofday(&xtm_value, X_NULL);
+    return XATOMIC_LOAD64(&g_xtm_tsc.xut_freq);
+}
 
-    xtm_vnsec = (xtime_vnsec_t)(xtm_value.tv_sec * 10000000ULL + xtm_value.tv_usec * 10ULL);
+/**********************************************************/
+/**
+ * @brief 将 TSC 读数 换算为 原始单调时钟 的 纳秒数（TSC 不可用 时，返回 0）。
+ * @note
+ * 换算结果 与 CLOCK_MONOTONIC_RAW 起点相同，两者之差 随 校准 缓慢变化（通常 在微秒级）；
+ * 只应 与 同样由该接口（或 time_mono_fast()、time_pair()）得到的值 相比较。
+ */
+x_uint64_t time_tsc_to_ns(x_uint64_t xut_tsc)
+{
+    x_uint64_t xut_nsec = 0;
 
-#else // UNKNOW
-#error "unknow platform!"
-#endif // PLATFORM
+    if (!time_tsc_read(xut_tsc, &xut_nsec))
+    {
+        return 0;
+    }
 
-    return xtm_vnsec;
+    return xut_nsec;
 }
 
 /**********************************************************/
 /**
- * @brief 获取当前系统的 时间描述信息。
+ * @brief 获取 原始单调时钟 的 时间计量值（以 100纳秒 为单位），TSC 可用时 不经 系统调用。
+ * @note
+ * TSC 可用时，为 time_tsc_to_ns(time_tsc()) 的换算值；否则 与 time_mono_raw() 相同。
+ * 两种情况下的 取值 都与 time_pair() 的 xtm_mono 同一基准，可相互比较。
  */
-xtime_descr_t time_descr(void)
+xtime_vnsec_t time_mono_fast(void)
 {
-    xtime_descr_t xtm_descr = { 0 };
+    x_uint64_t xut_nsec = 0;
 
-#if (defined(_WIN32) || defined(_WIN64))
+    if (!time_tsc_read(time_tsc(), &xut_nsec))
+    {
+        return time_mono_raw();
+    }
 
-    SYSTEMTIME xtm_local;
+    return (xtime_vnsec_t)(xut_nsec / 100ULL);
+}
 
-    GetLocalTime(&xtm_local);
+/**********************************************************/
+/**
+ * @brief 紧凑地 成对采集 原始单调时钟 与 系统时间。
+ * @note
+ * TSC 可用时，先读一次 TSC，再读一次 系统时间，TSC 加上 校准时测得的 半个 系统时钟读取开销，
+ * 即为 系统时间 的 读取时刻，换算为 单调时钟（开销 小于 两次 clock_gettime()）；
+ * 否则 以 前后两次 原始单调时钟 的中点 夹住 系统时间。
+ * 典型用法：在 一次测量 开始时 采集一对读数，此后 只用 time_mono_fast() 计时，
+ * 最后 按 xtm_real + (mono - xtm_mono) 换算为 系统时间，测量过程中的 系统时间跳变 因而 不影响 结果。
+ *
+ * @return xtime_pair_t : 返回 采集所得的 读数。
+ */
+xtime_pair_t time_pair(void)
+{
+    xtime_pair_t xtm_pair;
+    x_uint64_t   xut_tsc0 = 0;
+    x_uint64_t   xut_nsec = 0;
+#if (defined(__linux__) || defined(__unix__))
+    struct timespec xtm_value;
+#endif // (defined(__linux__) || defined(__unix__))
+
+    // 首次调用时 先完成校准（失败时 走 无 TSC 的分支）
+    if (XTIME_TSC_NONE == XATOMIC_LOAD32(&g_xtm_tsc.xut_state))
+    {
+        time_tsc_first(XTIME_TSC_CALIB_MSEC);
+    }
 
-    xtm_descr.ctx_year   = xtm_local.wYear        ;
-    xtm_descr.ctx_month  = xtm_local.wMonth       ;
-    xtm_descr.ctx_day    = xtm_local.wDay         ;
-    xtm_descr.ctx_week   = xtm_local.wDayOfWeek   ;
-    xtm_descr.ctx_hour   = xtm_local.wHour        ;
-    xtm_descr.ctx_minute = xtm_local.wMinute      ;
-    xtm_descr.ctx_second = xtm_local.wSecond      ;
-    xtm_descr.ctx_msec   = xtm_local.wMilliseconds;
+    xut_tsc0 = (XTIME_TSC_READY == XATOMIC_LOAD32(&g_xtm_tsc.xut_state)) ? time_tsc() : 0;
+    if (0 == xut_tsc0)
+    {
+        xut_nsec = time_raw_nsec();
+    }
 
+#if (defined(_WIN32) || defined(_WIN64))
+    xtm_pair.xtm_real = time_vnsec();
 #elif (defined(__linux__) || defined(__unix__))
-
-    time_t         xtm_time;
-    struct tm      xtm_local;
-    struct timeval xtm_value;
-
-    gettimeofday(&xtm_value, X_NULL);
-
-    xtm_time = (time_t)(xtm_value.tv_sec);
-    localtime_r(&xtm_time, &xtm_local);
-
-    xtm_descr.ctx_year   = xtm_local.tm_year + 1900;
-    xtm_descr.ctx_month  = xtm_local.tm_mon  + 1   ;
-    xtm_descr.ctx_day    = xtm_local.tm_mday       ;
-    xtm_descr.ctx_week   = xtm_local.tm_wday       ;
-    xtm_descr.ctx_hour   = xtm_local.tm_hour       ;
-    xtm_descr.ctx_minute = xtm_local.tm_min        ;
-    xtm_descr.ctx_second = xtm_local.tm_sec        ;
-    xtm_descr.ctx_msec   = (x_uint32_t)(xtm_value.tv_usec / 1000);
-
+    clock_gettime(CLOCK_REALTIME, &xtm_value);
+    xtm_pair.xtm_real = (xtime_vnsec_t)(xtm_value.tv_sec * 10000000ULL + xtm_value.tv_nsec / 100ULL);
 #else // UNKNOW
 #error "unknow platform!"
 #endif // PLATFORM
 
-    return xtm_descr;
+    if (0 != xut_tsc0)
+    {
+        xtm_pair.xut_tsc  = xut_tsc0 + g_xtm_tsc.xut_half;
+        time_tsc_read(xtm_pair.xut_tsc, &xut_nsec);
+        xtm_pair.xtm_mono = (xtime_vnsec_t)(xut_nsec / 100ULL);
+    }
+    else
+    {
+        xtm_pair.xut_tsc  = 0;
+        xtm_pair.xtm_mono = (xtime_vnsec_t)((xut_nsec + (time_raw_nsec() - xut_nsec) / 2) / 100ULL);
+    }
+
+    return xtm_pair;
 }
 
 /**********************************************************/
 /**
  * @brief 将 时间描述信息 转换为 时间计量值。
+ * @note
+ * 秒 为 60（闰秒）时，返回值 与 下一分钟的 第 0 秒 相同（时间计量值 与 UNIX 时间 一样 不计闰秒）。
  * 
  * @param [in ] xtm_descr : 待转换的 时间描述信息。
  * 
@@ -168,6 +1074,14 @@ xtime_vnsec_t time_dtov(xtime_descr_t xtm_descr)
 {
     xtime_vnsec_t xtm_vnsec = XTIME_INVALID_VNSEC;
 
+    // 闰秒：按 第 59 秒 转换后 再加 1 秒（SystemTimeToFileTime() 不接受 第 60 秒）
+    if (60 == xtm_descr.ctx_second)
+    {
+        xtm_descr.ctx_second = 59;
+        xtm_vnsec = time_dtov(xtm_descr);
+        return XTMVNSEC_IS_VALID(xtm_vnsec) ? (xtm_vnsec + 10000000ULL) : xtm_vnsec;
+    }
+
 #if 0
     if ((xtm_descr.ctx_year   < 1970) ||
         (xtm_descr.ctx_month  <    1) || (xtm_descr.ctx_month > 12) ||
@@ -240,6 +1154,9 @@ xtime_vnsec_t time_dtov(xtime_descr_t xtm_descr)
 /**********************************************************/
 /**
  * @brief 将 时间计量值 转换为 时间描述信息。
+ * @note
+ * 整秒 与 上一次调用 相同 时，只更新 毫秒；落在 已确认 时区偏移 不变的 时间段 内 时，以 算术方式 换算；
+ * 否则 才调用 系统接口，并 确认 其后 XTIME_VTOD_SPAN 秒 的 时区偏移。
  * 
  * @param [in ] xtm_vnsec : 待转换的 时间计量值。
  * 
@@ -248,55 +1165,131 @@ xtime_vnsec_t time_dtov(xtime_descr_t xtm_descr)
  */
 xtime_descr_t time_vtod(xtime_vnsec_t xtm_vnsec)
 {
-    xtime_descr_t xtm_descr = { 0 };
-
-#if (defined(_WIN32) || defined(_WIN64))
-
-    ULARGE_INTEGER xtm_value;
-    FILETIME       xtm_sfile;
-    FILETIME       xtm_lfile;
-    SYSTEMTIME     xtm_local;
+    xtime_vtodcache_t * xcache_ptr = &g_xtm_vtod;
+    x_uint64_t          xut_second = xtm_vnsec / 10000000ULL;
+    xtime_descr_t       xtm_descr;
+    xtime_descr_t       xtm_probe;
 
-    xtm_value.QuadPart       = xtm_vnsec + XTIME_VNSEC_1601_1970;
-    xtm_sfile.dwLowDateTime  = xtm_value.LowPart;
-    xtm_sfile.dwHighDateTime = xtm_value.HighPart;
-    if (FileTimeToLocalFileTime(&xtm_sfile, &xtm_lfile))
+    if (xut_second != xcache_ptr->xut_second)
     {
-        if (FileTimeToSystemTime(&xtm_lfile, &xtm_local))
+        if ((xut_second >= xcache_ptr->xut_from) && (xut_second < xcache_ptr->xut_until))
         {
-            xtm_descr.ctx_year   = xtm_local.wYear        ;
-            xtm_descr.ctx_month  = xtm_local.wMonth       ;
-            xtm_descr.ctx_day    = xtm_local.wDay         ;
-            xtm_descr.ctx_week   = xtm_local.wDayOfWeek   ;
-            xtm_descr.ctx_hour   = xtm_local.wHour        ;
-            xtm_descr.ctx_minute = xtm_local.wMinute      ;
-            xtm_descr.ctx_second = xtm_local.wSecond      ;
-            xtm_descr.ctx_msec   = xtm_local.wMilliseconds;
+            xtm_descr = time_vtod_arith(xut_second, xcache_ptr->xit_offset);
+        }
+        else
+        {
+            xcache_ptr->xut_second = ~0ULL;
+            xcache_ptr->xut_from   = 0;
+            xcache_ptr->xut_until  = 0;
+
+            xtm_descr = time_vtod_sys(xtm_vnsec);
+            if ((xtm_descr.ctx_year < 1970) || (xtm_descr.ctx_year > 9999))
+            {
+                return xtm_descr;
+            }
+
+            xtm_descr.ctx_msec     = 0;
+            xcache_ptr->xit_offset = time_descr_secs(xtm_descr) - (x_int64_t)xut_second;
+
+            // 其后 XTIME_VTOD_SPAN 秒 处的 时区偏移 相同，即认为 其间 没有 偏移变化（夏令时 切换 等）；
+            // 闰秒（秒 为 60，“right/” 时区）前后 的 偏移 不连续，不做 算术换算
+            if (60 != xtm_descr.ctx_second)
+            {
+                xtm_probe = time_vtod_sys((xut_second + XTIME_VTOD_SPAN) * 10000000ULL);
+                if ((0 != xtm_probe.ctx_year) &&
+                    (time_descr_secs(xtm_probe) - (x_int64_t)(xut_second + XTIME_VTOD_SPAN) == xcache_ptr->xit_offset))
+                {
+                    xcache_ptr->xut_from  = xut_second;
+                    xcache_ptr->xut_until = xut_second + XTIME_VTOD_SPAN;
+                }
+            }
         }
+
+        xcache_ptr->xtm_descr  = xtm_descr;
+        xcache_ptr->xut_second = xut_second;
     }
 
-#elif (defined(__linux__) || defined(__unix__))
+    xtm_descr = xcache_ptr->xtm_descr;
+    xtm_descr.ctx_msec = (x_uint32_t)((xtm_vnsec - xut_second * 10000000ULL) / 10000L);
 
-    struct tm xtm_local;
-    time_t xtm_time = (time_t)(xtm_vnsec / 10000000ULL);
-    localtime_r(&xtm_time, &xtm_local);
+    return xtm_descr;
+}
 
-    xtm_descr.ctx_year   = xtm_local.tm_year + 1900;
-    xtm_descr.ctx_month  = xtm_local.tm_mon  + 1   ;
-    xtm_descr.ctx_day    = xtm_local.tm_mday       ;
-    xtm_descr.ctx_week   = xtm_local.tm_wday       ;
-    xtm_descr.ctx_hour   = xtm_local.tm_hour       ;
-    xtm_descr.ctx_minute = xtm_local.tm_min        ;
-    xtm_descr.ctx_second = xtm_local.tm_sec        ;
-    xtm_descr.ctx_msec   = (x_uint32_t)((xtm_vnsec % 10000000ULL) / 10000L);
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 转换为 UTC 的 时间描述信息（纯算术换算，不经 系统接口，与 进程的 时区 无关）。
+ * 
+ * @param [in ] xtm_vnsec : 待转换的 时间计量值。
+ * 
+ * @return xtime_descr_t : 
+ * 返回 时间描述信息；晚于 9999 年 时，返回 无效值（ctx_value 为 0）。
+ */
+xtime_descr_t time_vtod_utc(xtime_vnsec_t xtm_vnsec)
+{
+    xtime_descr_t xtm_descr = { 0 };
+    x_uint64_t    xut_second = xtm_vnsec / 10000000ULL;
 
-#else // UNKNOW
-#error "unknow platform!"
-#endif // PLATFORM
+    if (xtm_vnsec >= XTIME_TEXT_VNSEC)
+    {
+        return xtm_descr;
+    }
+
+    xtm_descr = time_vtod_arith(xut_second, 0);
+    xtm_descr.ctx_msec = (x_uint32_t)((xtm_vnsec - xut_second * 10000000ULL) / 10000L);
 
     return xtm_descr;
 }
 
+/**********************************************************/
+/**
+ * @brief 将 UTC 的 时间描述信息 转换为 时间计量值（time_vtod_utc() 的 逆操作）。
+ * 
+ * @param [in ] xtm_descr : 待转换的 时间描述信息。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断其是否为有效。
+ */
+xtime_vnsec_t time_dtov_utc(xtime_descr_t xtm_descr)
+{
+    if (!time_descr_fields_valid(xtm_descr))
+    {
+        return XTIME_INVALID_VNSEC;
+    }
+
+    return (xtime_vnsec_t)time_descr_secs(xtm_descr) * 10000000ULL +
+           (xtime_vnsec_t)xtm_descr.ctx_msec * 10000ULL;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 转换为 时间描述信息（可表示 闰秒 23:59:60）。
+ * @note
+ * xbt_leap 为 X_TRUE，且 xtm_vnsec 落在 某一分钟的 第 0 秒 时，返回 前一分钟的 第 60 秒，
+ * 其他情况 与 time_vtod() 相同。
+ * 
+ * @param [in ] xtm_vnsec : 待转换的 时间计量值。
+ * @param [in ] xbt_leap  : xtm_vnsec 是否处于 插入的闰秒 当中。
+ * 
+ * @return xtime_descr_t : 
+ * 返回 时间描述信息，可用 XTMDESCR_IS_VALID() 判断其是否为有效。
+ */
+xtime_descr_t time_vtod_leap(xtime_vnsec_t xtm_vnsec, x_bool_t xbt_leap)
+{
+    xtime_descr_t xtm_descr = { 0 };
+
+    if (xbt_leap && (xtm_vnsec >= 10000000ULL))
+    {
+        xtm_descr = time_vtod(xtm_vnsec - 10000000ULL);
+        if (59 == xtm_descr.ctx_second)
+        {
+            xtm_descr.ctx_second = 60;
+            return xtm_descr;
+        }
+    }
+
+    return time_vtod(xtm_vnsec);
+}
+
 /**********************************************************/
 /**
  * @brief 判断 时间描述信息 是否有效。
@@ -405,6 +1398,220 @@ x_uint32_t time_week(x_uint32_t xut_year, x_uint32_t xut_month, x_uint32_t xut_d
     return (x_uint32_t)((xit_w < 0) ? (xit_w + 7) : xit_w);
 }
 
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 格式化为 RFC 3339 文本（UTC），如 “2026-10-18T08:30:00.123Z”。
+ *
+ * @param [in ] xtm_vnsec : 时间计量值。
+ * @param [in ] xprec     : 小数部分 的 精度。
+ * @param [out] xszt_text : 文本的 输出缓存（至少 XTIME_TEXT_LEN 字节），以 '\0' 结尾。
+ *
+ * @return x_uint32_t :
+ * 成功，返回 文本长度（不含 '\0'）；时间计量值 无效（或 晚于 9999 年）、精度 无效，返回 0。
+ */
+x_uint32_t time_vtos(xtime_vnsec_t xtm_vnsec, xtime_prec_t xprec, x_char_t * xszt_text)
+{
+    /** 线程内 缓存的 日期部分（相邻的 调用 通常 处于 同一天，命中时 无须 换算日期） */
+    static XTLS_VAR x_uint32_t xut_last = ~0U;
+    static XTLS_VAR x_char_t   xszt_date[12];
+
+    if (X_NULL == xszt_text)
+    {
+        return 0;
+    }
+
+    if ((xtm_vnsec >= XTIME_TEXT_VNSEC) || !XTIME_PREC_VALID(xprec))
+    {
+        xszt_text[0] = '\0';
+        return 0;
+    }
+
+    return time_vtos_fill(xtm_vnsec, (x_uint32_t)xprec, xszt_text, xszt_date, &xut_last);
+}
+
+/**********************************************************/
+/**
+ * @brief 批量 格式化 时间计量值（参看 time_vtos()）。
+ * @note
+ * 相邻的 时间计量值 处于 同一天 时，沿用 上一条的 日期部分，无须 重新换算。
+ *
+ * @param [in ] xtm_vnsec  : 时间计量值 数组。
+ * @param [in ] xut_count  : 数组的 元素数量。
+ * @param [in ] xprec      : 小数部分 的 精度。
+ * @param [out] xszt_text  : 文本的 输出缓存（xut_count * xut_stride 字节）。
+ * @param [in ] xut_stride : 每条文本 占用的 字节数（不小于 XTIME_TEXT_LEN）。
+ *
+ * @return x_uint32_t : 返回 成功格式化的 数量；参数 无效 时，返回 0。
+ */
+x_uint32_t time_vtos_batch(
+                const xtime_vnsec_t * xtm_vnsec,
+                x_uint32_t xut_count,
+                xtime_prec_t xprec,
+                x_char_t * xszt_text,
+                x_uint32_t xut_stride)
+{
+    x_uint32_t xut_iter = 0;
+    x_uint32_t xut_okay = 0;
+    x_uint32_t xut_last = ~0U;
+    x_char_t   xszt_date[12];
+
+    if ((X_NULL == xtm_vnsec) || (X_NULL == xszt_text) ||
+        (xut_stride < XTIME_TEXT_LEN) || !XTIME_PREC_VALID(xprec))
+    {
+        return 0;
+    }
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter, xszt_text += xut_stride)
+    {
+        if (xtm_vnsec[xut_iter] >= XTIME_TEXT_VNSEC)
+        {
+            xszt_text[0] = '\0';
+            continue;
+        }
+
+        time_vtos_fill(xtm_vnsec[xut_iter], (x_uint32_t)xprec, xszt_text, xszt_date, &xut_last);
+        xut_okay += 1;
+    }
+
+    return xut_okay;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 时间描述信息 格式化为 ISO 8601 文本（本地时间，不带时区），如 “2026-10-18T16:30:00.123”。
+ *
+ * @param [in ] xtm_descr : 时间描述信息。
+ * @param [out] xszt_text : 文本的 输出缓存（至少 XTIME_TEXT_LEN 字节），以 '\0' 结尾。
+ *
+ * @return x_uint32_t : 成功，返回 文本长度（不含 '\0'）；字段 越界（或 年份 超出 1970 ~ 9999），返回 0。
+ */
+x_uint32_t time_dtos(xtime_descr_t xtm_descr, x_char_t * xszt_text)
+{
+    if (X_NULL == xszt_text)
+    {
+        return 0;
+    }
+
+    // 只校验 输出的 各个字段（星期 不在 输出之列，不经 Zeller 公式 校验）
+    if (!time_descr_fields_valid(xtm_descr))
+    {
+        xszt_text[0] = '\0';
+        return 0;
+    }
+
+    time_put_date(xszt_text, xtm_descr.ctx_year, xtm_descr.ctx_month, xtm_descr.ctx_day);
+    time_put_clock(xszt_text + 10, xtm_descr.ctx_hour, xtm_descr.ctx_minute, xtm_descr.ctx_second);
+
+    return 19 + time_put_frac(xszt_text + 19, xtm_descr.ctx_msec * 10000, xtime_prec_msec, '\0');
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 RFC 3339 文本 为 时间计量值。
+ *
+ * @param [in ] xszt_text : 文本（无须 以 '\0' 结尾）。
+ * @param [in ] xut_tlen  : 文本长度（须 恰好 为 完整的 时间文本，不可带有 其他字符）。
+ * @param [out] xtm_vnsec : 操作成功 返回的 时间计量值。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；格式错误、字段越界，返回 EINVAL；早于 1970-01-01T00:00:00Z，返回 ERANGE。
+ */
+x_int32_t time_stov(x_cstring_t xszt_text, x_uint32_t xut_tlen, xtime_vnsec_t * xtm_vnsec)
+{
+    x_uint32_t xut_field[7] = { 0 };
+    x_uint32_t xut_tpos = 0;
+    x_uint32_t xut_zhor = 0;
+    x_uint32_t xut_zmin = 0;
+    x_int64_t  xit_zone = 0;
+    x_int64_t  xit_secs = 0;
+
+    if (X_NULL == xtm_vnsec)
+    {
+        return EINVAL;
+    }
+
+    xut_tpos = time_parse_fields(xszt_text, xut_tlen, xut_field);
+    if ((0 == xut_tpos) || (xut_tpos >= xut_tlen))
+    {
+        return EINVAL;
+    }
+
+    //======================================
+    // 时区
+
+    switch (xszt_text[xut_tpos])
+    {
+    case 'Z': case 'z':
+        if (xut_tpos + 1 != xut_tlen)
+            return EINVAL;
+        break;
+
+    case '+': case '-':
+        if ((xut_tpos + 6 != xut_tlen) || (':' != xszt_text[xut_tpos + 3]))
+            return EINVAL;
+
+        xut_zhor = time_get2(xszt_text + xut_tpos + 1);
+        xut_zmin = time_get2(xszt_text + xut_tpos + 4);
+        if ((xut_zhor > 23) || (xut_zmin > 59))
+            return EINVAL;
+
+        xit_zone = (x_int64_t)(xut_zhor * 3600 + xut_zmin * 60);
+        if ('-' == xszt_text[xut_tpos])
+            xit_zone = -xit_zone;
+        break;
+
+    default:
+        return EINVAL;
+    }
+
+    //======================================
+
+    xit_secs = time_days(xut_field[0], xut_field[1], xut_field[2]) * 86400LL +
+               (x_int64_t)(xut_field[3] * 3600 + xut_field[4] * 60 + xut_field[5]) - xit_zone;
+    if (xit_secs < 0)
+    {
+        return ERANGE;
+    }
+
+    *xtm_vnsec = (xtime_vnsec_t)xit_secs * 10000000ULL + xut_field[6];
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 ISO 8601 文本（本地时间，不带时区）为 时间描述信息（time_dtos() 的 逆操作）。
+ *
+ * @param [in ] xszt_text : 文本（无须 以 '\0' 结尾）。
+ * @param [in ] xut_tlen  : 文本长度。
+ * @param [out] xtm_descr : 操作成功 返回的 时间描述信息。
+ *
+ * @return x_int32_t : 成功，返回 0；格式错误、字段越界（含 早于 1970 年），返回 EINVAL。
+ */
+x_int32_t time_stod(x_cstring_t xszt_text, x_uint32_t xut_tlen, xtime_descr_t * xtm_descr)
+{
+    x_uint32_t xut_field[7] = { 0 };
+
+    if ((X_NULL == xtm_descr) ||
+        (xut_tlen != time_parse_fields(xszt_text, xut_tlen, xut_field)) ||
+        (xut_field[0] < 1970))
+    {
+        return EINVAL;
+    }
+
+    xtm_descr->ctx_value  = 0;
+    xtm_descr->ctx_year   = xut_field[0];
+    xtm_descr->ctx_month  = xut_field[1];
+    xtm_descr->ctx_day    = xut_field[2];
+    xtm_descr->ctx_week   = time_week(xut_field[0], xut_field[1], xut_field[2]);
+    xtm_descr->ctx_hour   = xut_field[3];
+    xtm_descr->ctx_minute = xut_field[4];
+    xtm_descr->ctx_second = xut_field[5];
+    xtm_descr->ctx_msec   = xut_field[6] / 10000;
+
+    return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef __GNUC__
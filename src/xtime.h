@@ -35,6 +35,10 @@
 
 #include "xtypes.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif // defined(_MSC_VER)
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef __cplusplus
@@ -76,6 +80,17 @@ typedef union xtime_descr_t
     };
 } xtime_descr_t;
 
+/**
+ * @struct xtime_pair_t
+ * @brief  成对采集的 时钟读数（参看 time_pair()）。
+ */
+typedef struct xtime_pair_t
+{
+    xtime_vnsec_t xtm_mono;  ///< 原始单调时钟（与 time_mono_fast() 同一基准）
+    xtime_vnsec_t xtm_real;  ///< 系统时间（与 time_vnsec() 同一时钟）
+    x_uint64_t    xut_tsc;   ///< 采集时的 TSC 读数（TSC 不可用时 为 0）
+} xtime_pair_t;
+
 /** 定义无效的 时间计量值 */
 #define XTIME_INVALID_VNSEC         ((xtime_vnsec_t)~0ULL)
 
@@ -85,6 +100,24 @@ typedef union xtime_descr_t
 /** 判断 时间描述信息 是否为 有效 */
 #define XTMDESCR_IS_VALID(xdescr)   time_descr_valid(xdescr)
 
+/** 1 毫秒 对应的 时间计量值（百纳秒数） */
+#define XTIME_VNSEC_MSEC            10000ULL
+
+/** 时间文本 的 缓存长度（含 结尾的 '\0'），足以容纳 time_vtos() 等接口 输出的 最长文本 */
+#define XTIME_TEXT_LEN              32
+
+/**
+ * @enum  xtime_prec_t
+ * @brief 时间文本 中 秒的小数部分 的 精度（取值 即为 小数位数）。
+ */
+typedef enum xtime_prec_t
+{
+    xtime_prec_sec  = 0,  ///< 整秒（无小数部分）
+    xtime_prec_msec = 3,  ///< 毫秒
+    xtime_prec_usec = 6,  ///< 微秒
+    xtime_prec_nsec = 9,  ///< 纳秒（时间计量值 只精确到 100纳秒，末两位 恒为 0）
+} xtime_prec_t;
+
 //====================================================================
 
 // 
@@ -103,9 +136,105 @@ xtime_vnsec_t time_vnsec(void);
  */
 xtime_descr_t time_descr(void);
 
+/**********************************************************/
+/**
+ * @brief 获取系统 单调时钟 的 时间计量值（以 100纳秒 为单位）。
+ * @note
+ * 单调时钟的起点未定义，不受系统时间调整（校时、跳变）的影响，
+ * 只适用于计算 时间间隔 或 截止时间（deadline）。
+ */
+xtime_vnsec_t time_mono(void);
+
+/**********************************************************/
+/**
+ * @brief 获取 原始单调时钟 的 时间计量值（以 100纳秒 为单位）。
+ * @note
+ * Linux 上 为 CLOCK_MONOTONIC_RAW：不受 校时 的 频率微调（adjtime/NTP slew）影响，
+ * 适合 作为 测量 往返时延 等 短时间间隔 的基准；Windows 上 与 time_mono() 相同。
+ */
+xtime_vnsec_t time_mono_raw(void);
+
+/**********************************************************/
+/**
+ * @brief 读取 CPU 的 时间戳计数器（x86 的 TSC，ARM64 的 CNTVCT），不支持的平台 返回 0。
+ * @note
+ * 只是 原始的 计数值，须经 time_tsc_to_ns() 换算；计数器 是否 恒定频率，参看 time_tsc_freq()。
+ */
+static inline x_uint64_t time_tsc(void)
+{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return (x_uint64_t)__rdtsc();
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    return (x_uint64_t)__builtin_ia32_rdtsc();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    x_uint64_t xut_tick;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(xut_tick));
+    return xut_tick;
+#else // UNKNOW
+    return 0;
+#endif // PLATFORM
+}
+
+/**********************************************************/
+/**
+ * @brief 校准 TSC 与 原始单调时钟 的 换算关系。
+ * @note
+ * 首次调用 在 xut_msec 毫秒内 自旋测量 TSC 频率（首次使用 time_tsc_to_ns() 等接口 时，会以 2 毫秒 自动执行）；
+ * 此后 每次调用，以 首次校准点 为起点 重新估计频率（基线越长，精度越高），
+ * 且 换算结果 连续、单调（新的 换算基点 取 旧关系 在当前时刻的 换算值）。
+ * 换算时 也会 按 1、2、4 ... 1024 秒 的 间隔 自动校准，通常 无须 显式调用。
+ * 换算关系 以 序列锁（seqlock）发布，读取方 无锁；并发的 校准 只有一个 生效。
+ *
+ * @param [in ] xut_msec : 首次校准 的 测量时长（毫秒），取 0 时 使用 默认值。
+ *
+ * @return x_int32_t :
+ * 成功，返回 0；TSC 不可用（非 恒定频率，或 平台不支持），返回 ENOTSUP；正被 其他线程 校准，返回 EBUSY。
+ */
+x_int32_t time_tsc_calibrate(x_uint32_t xut_msec);
+
+/**********************************************************/
+/**
+ * @brief 返回 校准所得的 TSC 频率（Hz）；TSC 不可用 时，返回 0。
+ */
+x_uint64_t time_tsc_freq(void);
+
+/**********************************************************/
+/**
+ * @brief 将 TSC 读数 换算为 原始单调时钟 的 纳秒数（TSC 不可用 时，返回 0）。
+ * @note
+ * 换算结果 与 CLOCK_MONOTONIC_RAW 起点相同，两者之差 随 校准 缓慢变化（通常 在微秒级）；
+ * 只应 与 同样由该接口（或 time_mono_fast()、time_pair()）得到的值 相比较。
+ */
+x_uint64_t time_tsc_to_ns(x_uint64_t xut_tsc);
+
+/**********************************************************/
+/**
+ * @brief 获取 原始单调时钟 的 时间计量值（以 100纳秒 为单位），TSC 可用时 不经 系统调用。
+ * @note
+ * TSC 可用时，为 time_tsc_to_ns(time_tsc()) 的换算值；否则 与 time_mono_raw() 相同。
+ * 两种情况下的 取值 都与 time_pair() 的 xtm_mono 同一基准，可相互比较。
+ */
+xtime_vnsec_t time_mono_fast(void);
+
+/**********************************************************/
+/**
+ * @brief 紧凑地 成对采集 原始单调时钟 与 系统时间。
+ * @note
+ * TSC 可用时，先读一次 TSC，再读一次 系统时间，TSC 加上 校准时测得的 半个 系统时钟读取开销，
+ * 即为 系统时间 的 读取时刻，换算为 单调时钟（开销 小于 两次 clock_gettime()）；
+ * 否则 以 前后两次 原始单调时钟 的中点 夹住 系统时间。
+ * 典型用法：在 一次测量 开始时 采集一对读数，此后 只用 time_mono_fast() 计时，
+ * 最后 按 xtm_real + (mono - xtm_mono) 换算为 系统时间，测量过程中的 系统时间跳变 因而 不影响 结果。
+ *
+ * @return xtime_pair_t : 返回 采集所得的 读数。
+ */
+xtime_pair_t time_pair(void);
+
 /**********************************************************/
 /**
  * @brief 将 时间描述信息 转换为 时间计量值。
+ * @note
+ * 秒 为 60（闰秒）时，返回值 与 下一分钟的 第 0 秒 相同（时间计量值 与 UNIX 时间 一样 不计闰秒）。
  * 
  * @param [in ] xtm_descr : 待转换的 时间描述信息。
  * 
@@ -117,6 +246,11 @@ xtime_vnsec_t time_dtov(xtime_descr_t xtm_descr);
 /**********************************************************/
 /**
  * @brief 将 时间计量值 转换为 时间描述信息。
+ * @note
+ * 每个线程 缓存 最近一次 转换的 整秒：整秒 相同 时 只更新 毫秒（日志 等场景 的 常见情形）；
+ * 调用 系统接口（localtime_r() 等）时，同时 确认 其后 1 小时 的 时区偏移 是否不变，
+ * 不变 则 该时间段内的 其他整秒 以 算术方式 换算（跨越 分、时、日 亦然），无须 再调用 系统接口。
+ * 进程 修改 时区（TZ）后，已缓存的 时间段 仍沿用 原有的 时区偏移，直至 转换 该时间段 之外的 时刻。
  * 
  * @param [in ] xtm_vnsec : 待转换的 时间计量值。
  * 
@@ -125,6 +259,47 @@ xtime_vnsec_t time_dtov(xtime_descr_t xtm_descr);
  */
 xtime_descr_t time_vtod(xtime_vnsec_t xtm_vnsec);
 
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 转换为 UTC 的 时间描述信息（纯算术换算，不经 系统接口，与 进程的 时区 无关）。
+ * 
+ * @param [in ] xtm_vnsec : 待转换的 时间计量值。
+ * 
+ * @return xtime_descr_t : 
+ * 返回 时间描述信息；晚于 9999 年 时，返回 无效值（ctx_value 为 0）。
+ */
+xtime_descr_t time_vtod_utc(xtime_vnsec_t xtm_vnsec);
+
+/**********************************************************/
+/**
+ * @brief 将 UTC 的 时间描述信息 转换为 时间计量值（time_vtod_utc() 的 逆操作）。
+ * @note
+ * 只校验 年、月、日、时、分、秒、毫秒 的 取值范围，不校验 星期；
+ * 秒 为 60（闰秒）时，返回值 与 下一分钟的 第 0 秒 相同。
+ * 
+ * @param [in ] xtm_descr : 待转换的 时间描述信息。
+ * 
+ * @return xtime_vnsec_t : 
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断其是否为有效。
+ */
+xtime_vnsec_t time_dtov_utc(xtime_descr_t xtm_descr);
+
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 转换为 时间描述信息（可表示 闰秒 23:59:60）。
+ * @note
+ * 时间计量值 不计闰秒，插入的 闰秒 与 其后的 第 0 秒 取值相同，只能由调用方 指明（如 依据 NTP 应答 的 LI 标识）；
+ * xbt_leap 为 X_TRUE，且 xtm_vnsec 落在 某一分钟的 第 0 秒 时，返回 前一分钟的 第 60 秒，
+ * 其他情况 与 time_vtod() 相同；time_dtov() 可将 返回值 还原为 xtm_vnsec。
+ * 
+ * @param [in ] xtm_vnsec : 待转换的 时间计量值。
+ * @param [in ] xbt_leap  : xtm_vnsec 是否处于 插入的闰秒 当中。
+ * 
+ * @return xtime_descr_t : 
+ * 返回 时间描述信息，可用 XTMDESCR_IS_VALID() 判断其是否为有效。
+ */
+xtime_descr_t time_vtod_leap(xtime_vnsec_t xtm_vnsec, x_bool_t xbt_leap);
+
 /**********************************************************/
 /**
  * @brief 判断 时间描述信息 是否有效。
@@ -154,6 +329,91 @@ x_bool_t time_descr_valid(xtime_descr_t xtm_descr);
  */
 x_uint32_t time_week(x_uint32_t xut_year, x_uint32_t xut_month, x_uint32_t xut_day);
 
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 格式化为 RFC 3339 文本（UTC），如 “2026-10-18T08:30:00.123Z”。
+ * @note
+ * 查表 写入 两位数字，不经 printf/gmtime，不分配内存；小数部分 截取（不四舍五入）。
+ * 每个线程 缓存 上一次的 日期部分，相邻的 调用 处于 同一天 时，只需 写入 时间部分。
+ * 输出长度 固定：整秒 为 20 字符，其余 为 21 + 小数位数。
+ * 
+ * @param [in ] xtm_vnsec : 时间计量值。
+ * @param [in ] xprec     : 小数部分 的 精度。
+ * @param [out] xszt_text : 文本的 输出缓存（至少 XTIME_TEXT_LEN 字节），以 '\0' 结尾。
+ * 
+ * @return x_uint32_t :
+ * 成功，返回 文本长度（不含 '\0'）；时间计量值 无效（或 晚于 9999 年）、精度 无效，返回 0。
+ */
+x_uint32_t time_vtos(xtime_vnsec_t xtm_vnsec, xtime_prec_t xprec, x_char_t * xszt_text);
+
+/**********************************************************/
+/**
+ * @brief 批量 格式化 时间计量值（参看 time_vtos()）。
+ * @note
+ * 相邻的 时间计量值 处于 同一天 时，沿用 上一条的 日期部分，无须 重新换算（日志 等场景 的 常见情形）。
+ * 第 i 条 文本 写入 xszt_text + i * xut_stride，无效的 时间计量值 输出 空串。
+ * 
+ * @param [in ] xtm_vnsec  : 时间计量值 数组。
+ * @param [in ] xut_count  : 数组的 元素数量。
+ * @param [in ] xprec      : 小数部分 的 精度。
+ * @param [out] xszt_text  : 文本的 输出缓存（xut_count * xut_stride 字节）。
+ * @param [in ] xut_stride : 每条文本 占用的 字节数（不小于 XTIME_TEXT_LEN）。
+ * 
+ * @return x_uint32_t : 返回 成功格式化的 数量；参数 无效 时，返回 0。
+ */
+x_uint32_t time_vtos_batch(
+                const xtime_vnsec_t * xtm_vnsec,
+                x_uint32_t xut_count,
+                xtime_prec_t xprec,
+                x_char_t * xszt_text,
+                x_uint32_t xut_stride);
+
+/**********************************************************/
+/**
+ * @brief 将 时间描述信息 格式化为 ISO 8601 文本（本地时间，不带时区），如 “2026-10-18T16:30:00.123”。
+ * @note
+ * 时间描述信息 只精确到 毫秒，输出长度 固定为 23 字符；秒 为 60（闰秒）时 原样输出；
+ * 只校验 输出的 各个字段，不校验 星期（ctx_week）。
+ * 
+ * @param [in ] xtm_descr : 时间描述信息。
+ * @param [out] xszt_text : 文本的 输出缓存（至少 XTIME_TEXT_LEN 字节），以 '\0' 结尾。
+ * 
+ * @return x_uint32_t : 成功，返回 文本长度（不含 '\0'）；字段 越界（或 年份 超出 1970 ~ 9999），返回 0。
+ */
+x_uint32_t time_dtos(xtime_descr_t xtm_descr, x_char_t * xszt_text);
+
+/**********************************************************/
+/**
+ * @brief 解析 RFC 3339 文本 为 时间计量值。
+ * @note
+ * 格式为 “YYYY-MM-DDTHH:MM:SS[.f...](Z|+HH:MM|-HH:MM)”：
+ * 日期 与 时间 之间 可为 'T'、't' 或 空格，小数部分 1 ~ 9 位（超出 100纳秒 的部分 截取），
+ * 时区 'Z'、'z' 或 UTC 偏移 必须给出；秒 为 60（闰秒）时，与 下一分钟的 第 0 秒 取值相同。
+ * 
+ * @param [in ] xszt_text : 文本（无须 以 '\0' 结尾）。
+ * @param [in ] xut_tlen  : 文本长度（须 恰好 为 完整的 时间文本，不可带有 其他字符）。
+ * @param [out] xtm_vnsec : 操作成功 返回的 时间计量值。
+ * 
+ * @return x_int32_t :
+ * 成功，返回 0；格式错误、字段越界，返回 EINVAL；早于 1970-01-01T00:00:00Z，返回 ERANGE。
+ */
+x_int32_t time_stov(x_cstring_t xszt_text, x_uint32_t xut_tlen, xtime_vnsec_t * xtm_vnsec);
+
+/**********************************************************/
+/**
+ * @brief 解析 ISO 8601 文本（本地时间，不带时区）为 时间描述信息（time_dtos() 的 逆操作）。
+ * @note
+ * 格式为 “YYYY-MM-DDTHH:MM:SS[.f...]”，分隔符、小数部分 与 time_stov() 相同，小数部分 截取至 毫秒；
+ * 星期 由 日期 算出。
+ * 
+ * @param [in ] xszt_text : 文本（无须 以 '\0' 结尾）。
+ * @param [in ] xut_tlen  : 文本长度。
+ * @param [out] xtm_descr : 操作成功 返回的 时间描述信息。
+ * 
+ * @return x_int32_t : 成功，返回 0；格式错误、字段越界（含 早于 1970 年），返回 EINVAL。
+ */
+x_int32_t time_stod(x_cstring_t xszt_text, x_uint32_t xut_tlen, xtime_descr_t * xtm_descr);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef __cplusplus
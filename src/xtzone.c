@@ -0,0 +1,1126 @@
+﻿/**
+ * @file xtzone.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 进程内的 时区转换：加载 TZif 文件（RFC 8536）为 只读的 时区偏移变化表，按 指定时区 转换时间。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "xtzone.h"
+#include "xatomic.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 内部相关的数据类型与常量
+//
+
+/** TZif 文件头 的 字节数 */
+#define XTZONE_HEAD_SIZE    44
+
+/** 时区缩写字符表 的 最大字节数（含 POSIX TZ 规则 追加的 缩写） */
+#define XTZONE_CHARS_MAX    1024
+
+/** 时区偏移 的 取值范围（秒，RFC 8536 第 3.2 节） */
+#define XTZONE_UTOFF_MIN    (-89999)
+#define XTZONE_UTOFF_MAX    93599
+
+/** 按 POSIX TZ 规则 展开的 偏移变化 的 最大数量（每年 两次） */
+#define XTZONE_RULE_TRANS   (2 * (XTZONE_YEAR_END - 1970 + 2))
+
+/** 按 8 字节 对齐 */
+#define XTZONE_ALIGN8(xsize)    (((xsize) + 7) & ~((x_uint32_t)7))
+
+/**
+ * @struct xtzone_type_t
+ * @brief  本地时间类型（时区偏移、夏令时标识、时区缩写）。
+ */
+typedef struct xtzone_type_t
+{
+    x_int32_t  xit_utoff;   ///< 时区偏移（本地时间 减去 UTC，秒）
+    x_uint16_t xut_abbr;    ///< 时区缩写 在 缩写字符表 中的 位置
+    x_uint8_t  xut_isdst;   ///< 是否为 夏令时
+    x_uint8_t  xut_resv;    ///< 保留
+} xtzone_type_t;
+
+/**
+ * @struct xtime_zone_t
+ * @brief  时区对象：偏移变化表（按 变化时刻 升序排列）与 本地时间类型；
+ *         连同 各个数组 一次性分配，创建后 只读。
+ */
+struct xtime_zone_t
+{
+    xtime_zoneptr_t xzone_next;     ///< 共享的 时区对象 链表 的 下一项
+    x_bool_t        xbt_shared;     ///< 是否为 共享的 时区对象（tzone_load() 加载）
+    x_uint32_t      xut_count;      ///< 偏移变化 的 数量
+    x_uint32_t      xut_ntype;      ///< 本地时间类型 的 数量
+    x_uint32_t      xut_nchar;      ///< 缩写字符表 的 字节数
+    x_int64_t     * xit_when;       ///< 各个 偏移变化 的 时刻（UNIX 秒数）
+    x_uint8_t     * xut_index;      ///< 各个 偏移变化 之后的 本地时间类型（首个变化 之前 为 类型 0）
+    xtzone_type_t * xtz_types;      ///< 本地时间类型 数组
+    x_char_t      * xszt_chars;     ///< 缩写字符表（各个缩写 以 '\0' 结尾）
+    x_char_t        xszt_name[TEXT_LEN_256];  ///< 时区名称
+};
+
+/**
+ * @struct xtzone_build_t
+ * @brief  解析 TZif 数据 时 使用的 临时表。
+ */
+typedef struct xtzone_build_t
+{
+    x_int64_t     * xit_when;
+    x_uint8_t     * xut_index;
+    x_uint32_t      xut_count;
+    x_uint32_t      xut_ntype;
+    x_uint32_t      xut_nchar;
+    xtzone_type_t   xtz_types[256];
+    x_char_t        xszt_chars[XTZONE_CHARS_MAX];
+} xtzone_build_t;
+
+/**
+ * @struct xtzone_date_t
+ * @brief  POSIX TZ 规则 中的 日期 与 时刻：Jn（1 ~ 365，不计 闰日）、n（0 ~ 365）、Mm.w.d。
+ */
+typedef struct xtzone_date_t
+{
+    x_char_t   xct_kind;    ///< 'J'、'N'、'M'
+    x_uint32_t xut_day;     ///< Jn、n 的 日序号
+    x_uint32_t xut_month;   ///< Mm.w.d 的 月份（1 ~ 12）
+    x_uint32_t xut_week;    ///< Mm.w.d 的 第几周（1 ~ 5，5 表示 最后一周）
+    x_uint32_t xut_wday;    ///< Mm.w.d 的 星期（0 ~ 6，0 为 星期日）
+    x_int32_t  xit_time;    ///< 当日 的 本地时刻（秒，-167 ~ 167 小时，默认 02:00:00）
+} xtzone_date_t;
+
+/**
+ * @struct xtzone_rule_t
+ * @brief  TZif 文件末尾的 POSIX TZ 规则（如 “EST5EDT,M3.2.0,M11.1.0”）。
+ */
+typedef struct xtzone_rule_t
+{
+    x_char_t      xszt_std[TEXT_LEN_16];    ///< 标准时间 的 缩写
+    x_char_t      xszt_dst[TEXT_LEN_16];    ///< 夏令时 的 缩写（空字符串 表示 没有夏令时）
+    x_int32_t     xit_stdoff;               ///< 标准时间 的 时区偏移（东 为 正，秒）
+    x_int32_t     xit_dstoff;               ///< 夏令时 的 时区偏移（东 为 正，秒）
+    xtzone_date_t xdate_start;              ///< 夏令时 开始
+    xtzone_date_t xdate_end;                ///< 夏令时 结束
+} xtzone_rule_t;
+
+/** 共享的 时区对象 链表（只增不减，以 CAS 插入） */
+static xtime_zoneptr_t g_xtzone_shared = X_NULL;
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 读取 大端字节序 的 32 位 与 64 位 整数。
+ */
+static inline x_uint32_t tzone_be32(const x_uchar_t * xct_data)
+{
+    return ((x_uint32_t)xct_data[0] << 24) | ((x_uint32_t)xct_data[1] << 16) |
+           ((x_uint32_t)xct_data[2] <<  8) | ((x_uint32_t)xct_data[3]      );
+}
+
+static inline x_uint64_t tzone_be64(const x_uchar_t * xct_data)
+{
+    return ((x_uint64_t)tzone_be32(xct_data) << 32) | (x_uint64_t)tzone_be32(xct_data + 4);
+}
+
+/**********************************************************/
+/**
+ * @brief 公历日期 转换为 自 1970-01-01 起的 天数（年份 不早于 1970）。
+ */
+static x_int64_t tzone_days(x_uint32_t xut_year, x_uint32_t xut_month, x_uint32_t xut_day)
+{
+    x_uint32_t xut_yadj = xut_year - ((xut_month <= 2) ? 1 : 0);
+    x_uint32_t xut_era  = xut_yadj / 400;
+    x_uint32_t xut_yoe  = xut_yadj - xut_era * 400;
+    x_uint32_t xut_doy  = (153 * ((xut_month > 2) ? (xut_month - 3) : (xut_month + 9)) + 2) / 5 + xut_day - 1;
+    x_uint32_t xut_doe  = xut_yoe * 365 + xut_yoe / 4 - xut_yoe / 100 + xut_doy;
+
+    return (x_int64_t)xut_era * 146097 + (x_int64_t)xut_doe - 719468;
+}
+
+/**********************************************************/
+/**
+ * @brief 查找 xit_time 时刻 所在的 时间段：返回 不晚于 该时刻的 偏移变化 的 数量（0 ~ xut_count）。
+ * @note
+ * 二分查找 的 每一步 只 移动 区间起点（可编译为 条件传送），避免 随机时刻 下的 分支预测失败。
+ */
+static inline x_uint32_t tzone_seek(xtime_zoneptr_t xtzone_ptr, x_int64_t xit_time)
+{
+    const x_int64_t * xit_when  = xtzone_ptr->xit_when;
+    x_uint32_t        xut_lower = 0;
+    x_uint32_t        xut_range = xtzone_ptr->xut_count;
+    x_uint32_t        xut_half  = 0;
+
+    while (xut_range > 1)
+    {
+        xut_half   = xut_range >> 1;
+        xut_lower  = (xit_when[xut_lower + xut_half - 1] <= xit_time) ? (xut_lower + xut_half) : xut_lower;
+        xut_range -= xut_half;
+    }
+
+    return xut_lower + (((1 == xut_range) && (xit_when[xut_lower] <= xit_time)) ? 1 : 0);
+}
+
+/**********************************************************/
+/**
+ * @brief 时间段 xut_segm（参看 tzone_seek()）的 本地时间类型。
+ */
+static inline const xtzone_type_t * tzone_type(xtime_zoneptr_t xtzone_ptr, x_uint32_t xut_segm)
+{
+    return &xtzone_ptr->xtz_types[(0 == xut_segm) ? 0 : xtzone_ptr->xut_index[xut_segm - 1]];
+}
+
+//====================================================================
+
+//
+// POSIX TZ 规则 的 解析 与 展开
+//
+
+/**********************************************************/
+/**
+ * @brief 读取 十进制数（最多 3 位），并 校验 取值范围。
+ */
+static x_int32_t tzone_rule_num(
+                    x_cstring_t * xszt_iter,
+                    x_uint32_t xut_min,
+                    x_uint32_t xut_max,
+                    x_uint32_t * xut_value)
+{
+    x_cstring_t xszt_text = *xszt_iter;
+    x_uint32_t  xut_digit = 0;
+
+    for (*xut_value = 0; (xut_digit < 3) && (xszt_text[xut_digit] >= '0') && (xszt_text[xut_digit] <= '9'); ++xut_digit)
+    {
+        *xut_value = *xut_value * 10 + (x_uint32_t)(xszt_text[xut_digit] - '0');
+    }
+
+    if ((0 == xut_digit) || (*xut_value < xut_min) || (*xut_value > xut_max))
+    {
+        return EINVAL;
+    }
+
+    *xszt_iter = xszt_text + xut_digit;
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 [+|-]hh[:mm[:ss]] 形式的 时长（秒），小时数 不大于 xut_hmax。
+ */
+static x_int32_t tzone_rule_hms(x_cstring_t * xszt_iter, x_uint32_t xut_hmax, x_int32_t * xit_secs)
+{
+    x_int32_t  xit_sign  = 1;
+    x_uint32_t xut_hour  = 0;
+    x_uint32_t xut_min   = 0;
+    x_uint32_t xut_sec   = 0;
+
+    if (('+' == **xszt_iter) || ('-' == **xszt_iter))
+    {
+        xit_sign = ('-' == **xszt_iter) ? -1 : 1;
+        *xszt_iter += 1;
+    }
+
+    if (0 != tzone_rule_num(xszt_iter, 0, xut_hmax, &xut_hour))
+        return EINVAL;
+
+    if (':' == **xszt_iter)
+    {
+        *xszt_iter += 1;
+        if (0 != tzone_rule_num(xszt_iter, 0, 59, &xut_min))
+            return EINVAL;
+
+        if (':' == **xszt_iter)
+        {
+            *xszt_iter += 1;
+            if (0 != tzone_rule_num(xszt_iter, 0, 59, &xut_sec))
+                return EINVAL;
+        }
+    }
+
+    *xit_secs = xit_sign * (x_int32_t)(xut_hour * 3600 + xut_min * 60 + xut_sec);
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 时区缩写：字母（如 “EST”）或 尖括号 括起的 字母、数字、正负号（如 “<+0530>”），3 ~ 15 个字符。
+ */
+static x_int32_t tzone_rule_name(x_cstring_t * xszt_iter, x_char_t * xszt_name)
+{
+    x_cstring_t xszt_text = *xszt_iter;
+    x_uint32_t  xut_nlen  = 0;
+    x_bool_t    xbt_quote = ('<' == xszt_text[0]);
+    x_char_t    xct_char  = 0;
+
+    if (xbt_quote)
+        xszt_text += 1;
+
+    for (;; ++xut_nlen)
+    {
+        xct_char = xszt_text[xut_nlen];
+        if (((xct_char >= 'A') && (xct_char <= 'Z')) || ((xct_char >= 'a') && (xct_char <= 'z')))
+            continue;
+        if (xbt_quote && (((xct_char >= '0') && (xct_char <= '9')) || ('+' == xct_char) || ('-' == xct_char)))
+            continue;
+        break;
+    }
+
+    if ((xut_nlen < 3) || (xut_nlen >= TEXT_LEN_16) || (xbt_quote && ('>' != xct_char)))
+    {
+        return EINVAL;
+    }
+
+    memcpy(xszt_name, xszt_text, xut_nlen);
+    xszt_name[xut_nlen] = '\0';
+
+    *xszt_iter = xszt_text + xut_nlen + (xbt_quote ? 1 : 0);
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 规则中的 日期 与 时刻（“,date[/time]”）。
+ */
+static x_int32_t tzone_rule_date(x_cstring_t * xszt_iter, xtzone_date_t * xdate_ptr)
+{
+    x_int32_t xit_errno = 0;
+
+    if (',' != **xszt_iter)
+        return EINVAL;
+    *xszt_iter += 1;
+
+    memset(xdate_ptr, 0, sizeof(xtzone_date_t));
+    xdate_ptr->xit_time = 7200;
+
+    switch (**xszt_iter)
+    {
+    case 'J':
+        *xszt_iter += 1;
+        xdate_ptr->xct_kind = 'J';
+        xit_errno = tzone_rule_num(xszt_iter, 1, 365, &xdate_ptr->xut_day);
+        break;
+
+    case 'M':
+        *xszt_iter += 1;
+        xdate_ptr->xct_kind = 'M';
+        xit_errno = tzone_rule_num(xszt_iter, 1, 12, &xdate_ptr->xut_month);
+        if ((0 == xit_errno) && ('.' == *((*xszt_iter)++)))
+            xit_errno = tzone_rule_num(xszt_iter, 1, 5, &xdate_ptr->xut_week);
+        else
+            xit_errno = EINVAL;
+        if ((0 == xit_errno) && ('.' == *((*xszt_iter)++)))
+            xit_errno = tzone_rule_num(xszt_iter, 0, 6, &xdate_ptr->xut_wday);
+        else
+            xit_errno = EINVAL;
+        break;
+
+    default:
+        xdate_ptr->xct_kind = 'N';
+        xit_errno = tzone_rule_num(xszt_iter, 0, 365, &xdate_ptr->xut_day);
+        break;
+    }
+
+    if ((0 == xit_errno) && ('/' == **xszt_iter))
+    {
+        *xszt_iter += 1;
+        xit_errno = tzone_rule_hms(xszt_iter, 167, &xdate_ptr->xit_time);
+    }
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 POSIX TZ 规则（std offset [dst [offset] [,start[/time],end[/time]]]）。
+ * @note
+ * 有 夏令时、无 切换规则 时，按 “M3.2.0,M11.1.0” 处理（与 tzcode 相同）。
+ */
+static x_int32_t tzone_rule_parse(x_cstring_t xszt_text, xtzone_rule_t * xrule_ptr)
+{
+    x_int32_t xit_secs = 0;
+
+    memset(xrule_ptr, 0, sizeof(xtzone_rule_t));
+
+    if ((0 != tzone_rule_name(&xszt_text, xrule_ptr->xszt_std)) ||
+        (0 != tzone_rule_hms(&xszt_text, 24, &xit_secs)))
+    {
+        return EINVAL;
+    }
+
+    // POSIX TZ 的 偏移 以 西 为 正
+    xrule_ptr->xit_stdoff = -xit_secs;
+
+    if ('\0' == *xszt_text)
+    {
+        return 0;
+    }
+
+    //======================================
+    // 夏令时
+
+    if (0 != tzone_rule_name(&xszt_text, xrule_ptr->xszt_dst))
+    {
+        return EINVAL;
+    }
+
+    xrule_ptr->xit_dstoff = xrule_ptr->xit_stdoff + 3600;
+    if (('\0' != *xszt_text) && (',' != *xszt_text))
+    {
+        if (0 != tzone_rule_hms(&xszt_text, 24, &xit_secs))
+            return EINVAL;
+        xrule_ptr->xit_dstoff = -xit_secs;
+    }
+
+    if ('\0' == *xszt_text)
+    {
+        xszt_text = ",M3.2.0,M11.1.0";
+    }
+
+    if ((0 != tzone_rule_date(&xszt_text, &xrule_ptr->xdate_start)) ||
+        (0 != tzone_rule_date(&xszt_text, &xrule_ptr->xdate_end)) ||
+        ('\0' != *xszt_text))
+    {
+        return EINVAL;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 规则日期 在 xut_year 年 的 本地时刻（自 1970-01-01 00:00:00 起 的 秒数，按 UTC 换算）。
+ */
+static x_int64_t tzone_rule_when(const xtzone_date_t * xdate_ptr, x_uint32_t xut_year)
+{
+    x_int64_t xit_days = tzone_days(xut_year, 1, 1);
+    x_int64_t xit_next = 0;
+    x_bool_t  xbt_leap = (0 == xut_year % 400) || ((0 == xut_year % 4) && (0 != xut_year % 100));
+
+    switch (xdate_ptr->xct_kind)
+    {
+    case 'J':
+        xit_days += xdate_ptr->xut_day - 1 + ((xbt_leap && (xdate_ptr->xut_day >= 60)) ? 1 : 0);
+        break;
+
+    case 'N':
+        xit_days += xdate_ptr->xut_day;
+        break;
+
+    default:
+        // 当月 首个 指定星期 所在日，再加 若干周；第 5 周 表示 当月 最后一个 指定星期
+        xit_days = tzone_days(xut_year, xdate_ptr->xut_month, 1);
+        xit_next = (12 == xdate_ptr->xut_month) ?
+                   tzone_days(xut_year + 1, 1, 1) : tzone_days(xut_year, xdate_ptr->xut_month + 1, 1);
+        xit_days += (xdate_ptr->xut_wday + 7 - (x_uint32_t)((xit_days + 4) % 7)) % 7;
+        xit_days += (xdate_ptr->xut_week - 1) * 7;
+        while (xit_days >= xit_next)
+            xit_days -= 7;
+        break;
+    }
+
+    return xit_days * 86400LL + xdate_ptr->xit_time;
+}
+
+/**********************************************************/
+/**
+ * @brief 查找（或 添加）本地时间类型，返回其 索引；类型表、缩写字符表 已满 时，返回 -1。
+ */
+static x_int32_t tzone_build_type(
+                    xtzone_build_t * xbuild_ptr,
+                    x_int32_t xit_utoff,
+                    x_uint8_t xut_isdst,
+                    x_cstring_t xszt_abbr)
+{
+    x_uint32_t      xut_iter = 0;
+    x_uint32_t      xut_alen = (x_uint32_t)strlen(xszt_abbr) + 1;
+    xtzone_type_t * xtz_type = X_NULL;
+
+    for (xut_iter = 0; xut_iter < xbuild_ptr->xut_ntype; ++xut_iter)
+    {
+        xtz_type = &xbuild_ptr->xtz_types[xut_iter];
+        if ((xtz_type->xit_utoff == xit_utoff) && (xtz_type->xut_isdst == xut_isdst) &&
+            (0 == strcmp(xbuild_ptr->xszt_chars + xtz_type->xut_abbr, xszt_abbr)))
+        {
+            return (x_int32_t)xut_iter;
+        }
+    }
+
+    if ((xbuild_ptr->xut_ntype >= 256) || (xbuild_ptr->xut_nchar + xut_alen > XTZONE_CHARS_MAX))
+    {
+        return -1;
+    }
+
+    xtz_type = &xbuild_ptr->xtz_types[xbuild_ptr->xut_ntype];
+    xtz_type->xit_utoff = xit_utoff;
+    xtz_type->xut_isdst = xut_isdst;
+    xtz_type->xut_abbr  = (x_uint16_t)xbuild_ptr->xut_nchar;
+    memcpy(xbuild_ptr->xszt_chars + xbuild_ptr->xut_nchar, xszt_abbr, xut_alen);
+    xbuild_ptr->xut_nchar += xut_alen;
+
+    return (x_int32_t)(xbuild_ptr->xut_ntype++);
+}
+
+/**********************************************************/
+/**
+ * @brief 按 POSIX TZ 规则，将 夏令时 的 切换 展开为 偏移变化，追加至 XTZONE_YEAR_END 年 末。
+ */
+static x_int32_t tzone_build_rule(xtzone_build_t * xbuild_ptr, const xtzone_rule_t * xrule_ptr)
+{
+    x_int32_t     xit_std   = 0;
+    x_int32_t     xit_dst   = 0;
+    x_uint32_t    xut_year  = 1970;
+    x_uint32_t    xut_iter  = 0;
+    x_int64_t     xit_when[2];
+    x_uint8_t     xut_type[2];
+    xtime_descr_t xtm_descr;
+
+    if ('\0' == xrule_ptr->xszt_dst[0])
+    {
+        return 0;
+    }
+
+    xit_std = tzone_build_type(xbuild_ptr, xrule_ptr->xit_stdoff, 0, xrule_ptr->xszt_std);
+    xit_dst = tzone_build_type(xbuild_ptr, xrule_ptr->xit_dstoff, 1, xrule_ptr->xszt_dst);
+    if ((xit_std < 0) || (xit_dst < 0))
+    {
+        return EINVAL;
+    }
+
+    // 自 最后一个 偏移变化 所在的 年份 起 展开（早于 该时刻 的 不追加）
+    if ((xbuild_ptr->xut_count > 0) && (xbuild_ptr->xit_when[xbuild_ptr->xut_count - 1] > 0))
+    {
+        xtm_descr = time_vtod_utc((xtime_vnsec_t)xbuild_ptr->xit_when[xbuild_ptr->xut_count - 1] * 10000000ULL);
+        xut_year  = (0 != xtm_descr.ctx_value) ? xtm_descr.ctx_year : (XTZONE_YEAR_END + 1);
+    }
+
+    for (; xut_year <= XTZONE_YEAR_END; ++xut_year)
+    {
+        xit_when[0] = tzone_rule_when(&xrule_ptr->xdate_start, xut_year) - xrule_ptr->xit_stdoff;
+        xit_when[1] = tzone_rule_when(&xrule_ptr->xdate_end  , xut_year) - xrule_ptr->xit_dstoff;
+        xut_type[0] = (x_uint8_t)xit_dst;
+        xut_type[1] = (x_uint8_t)xit_std;
+
+        // 南半球：夏令时 跨年，结束 早于 开始
+        if (xit_when[1] < xit_when[0])
+        {
+            xit_when[0] ^= xit_when[1]; xit_when[1] ^= xit_when[0]; xit_when[0] ^= xit_when[1];
+            xut_type[0]  = (x_uint8_t)xit_std;
+            xut_type[1]  = (x_uint8_t)xit_dst;
+        }
+
+        for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+        {
+            if ((xbuild_ptr->xut_count > 0) &&
+                (xit_when[xut_iter] <= xbuild_ptr->xit_when[xbuild_ptr->xut_count - 1]))
+            {
+                continue;
+            }
+
+            xbuild_ptr->xit_when [xbuild_ptr->xut_count] = xit_when[xut_iter];
+            xbuild_ptr->xut_index[xbuild_ptr->xut_count] = xut_type[xut_iter];
+            xbuild_ptr->xut_count += 1;
+        }
+    }
+
+    return 0;
+}
+
+//====================================================================
+
+//
+// TZif 数据 的 解析
+//
+
+/**********************************************************/
+/**
+ * @brief 读取 TZif 文件头 的 各项计数：isutcnt、isstdcnt、leapcnt、timecnt、typecnt、charcnt。
+ */
+static x_int32_t tzone_head(const x_uchar_t * xct_data, x_uint32_t xut_size, x_uint32_t xut_offset, x_uint32_t xut_cnts[6])
+{
+    x_uint32_t xut_iter = 0;
+
+    if ((xut_size < XTZONE_HEAD_SIZE) || (xut_offset > xut_size - XTZONE_HEAD_SIZE) ||
+        (0 != memcmp(xct_data + xut_offset, "TZif", 4)))
+    {
+        return EINVAL;
+    }
+
+    for (xut_iter = 0; xut_iter < 6; ++xut_iter)
+    {
+        xut_cnts[xut_iter] = tzone_be32(xct_data + xut_offset + 20 + 4 * xut_iter);
+
+        // 避免 计算 数据块 大小 时 溢出
+        if (xut_cnts[xut_iter] > xut_size)
+            return EINVAL;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief TZif 数据块 的 字节数（xut_tsize 为 时刻 的 字节数：版本 1 为 4，版本 2 及以上 为 8）。
+ */
+static inline x_uint64_t tzone_block_size(const x_uint32_t xut_cnts[6], x_uint32_t xut_tsize)
+{
+    return (x_uint64_t)xut_cnts[3] * (xut_tsize + 1) + (x_uint64_t)xut_cnts[4] * 6 + xut_cnts[5] +
+           (x_uint64_t)xut_cnts[2] * (xut_tsize + 4) + xut_cnts[1] + xut_cnts[0];
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 TZif 数据（RFC 8536，版本 1 ~ 4）至 临时表。
+ */
+static x_int32_t tzone_parse(const x_uchar_t * xct_data, x_uint32_t xut_size, xtzone_build_t * xbuild_ptr)
+{
+    x_int32_t         xit_errno = 0;
+    x_uint32_t        xut_cnts[6];
+    x_uint32_t        xut_tsize = 4;
+    x_uint32_t        xut_iter  = 0;
+    x_uint64_t        xut_bsize = 0;
+    const x_uchar_t * xct_iter  = X_NULL;
+    const x_uchar_t * xct_tail  = X_NULL;
+    x_char_t          xszt_rule[TEXT_LEN_128];
+    xtzone_rule_t     xrule_ctx;
+
+    if ((X_NULL == xct_data) || (0 != tzone_head(xct_data, xut_size, 0, xut_cnts)))
+    {
+        return EINVAL;
+    }
+
+    xct_iter = xct_data + XTZONE_HEAD_SIZE;
+
+    // 版本 2 及以上：跳过 版本 1 的 数据块，使用 64 位时刻 的 数据块
+    if ('\0' != xct_data[4])
+    {
+        xut_bsize = XTZONE_HEAD_SIZE + tzone_block_size(xut_cnts, 4);
+        if ((xut_bsize > xut_size) || (0 != tzone_head(xct_data, xut_size, (x_uint32_t)xut_bsize, xut_cnts)))
+        {
+            return EINVAL;
+        }
+
+        xct_iter  = xct_data + xut_bsize + XTZONE_HEAD_SIZE;
+        xut_tsize = 8;
+    }
+
+    if (0 != xut_cnts[2])
+    {
+        return ENOTSUP;
+    }
+
+    if ((xut_cnts[4] < 1) || (xut_cnts[4] > 256) ||
+        (xut_cnts[5] < 1) || (xut_cnts[5] >= XTZONE_CHARS_MAX - 2 * TEXT_LEN_16) ||
+        ((0 != xut_cnts[1]) && (xut_cnts[1] != xut_cnts[4])) ||
+        ((0 != xut_cnts[0]) && (xut_cnts[0] != xut_cnts[4])) ||
+        ((x_uint64_t)(xct_iter - xct_data) + tzone_block_size(xut_cnts, xut_tsize) > xut_size))
+    {
+        return EINVAL;
+    }
+
+    xbuild_ptr->xut_count = xut_cnts[3];
+    xbuild_ptr->xut_ntype = xut_cnts[4];
+    xbuild_ptr->xut_nchar = xut_cnts[5];
+    xbuild_ptr->xit_when  = (x_int64_t *)malloc((xut_cnts[3] + XTZONE_RULE_TRANS) * (sizeof(x_int64_t) + 1));
+    if (X_NULL == xbuild_ptr->xit_when)
+    {
+        return ENOMEM;
+    }
+    xbuild_ptr->xut_index = (x_uint8_t *)(xbuild_ptr->xit_when + xut_cnts[3] + XTZONE_RULE_TRANS);
+
+    //======================================
+    // 偏移变化 的 时刻（严格递增）与 本地时间类型
+
+    for (xut_iter = 0; xut_iter < xut_cnts[3]; ++xut_iter, xct_iter += xut_tsize)
+    {
+        xbuild_ptr->xit_when[xut_iter] = (8 == xut_tsize) ?
+                                         (x_int64_t)tzone_be64(xct_iter) : (x_int64_t)(x_int32_t)tzone_be32(xct_iter);
+        if ((xut_iter > 0) && (xbuild_ptr->xit_when[xut_iter] <= xbuild_ptr->xit_when[xut_iter - 1]))
+            return EINVAL;
+    }
+
+    for (xut_iter = 0; xut_iter < xut_cnts[3]; ++xut_iter, ++xct_iter)
+    {
+        if (*xct_iter >= xut_cnts[4])
+            return EINVAL;
+        xbuild_ptr->xut_index[xut_iter] = *xct_iter;
+    }
+
+    for (xut_iter = 0; xut_iter < xut_cnts[4]; ++xut_iter, xct_iter += 6)
+    {
+        xbuild_ptr->xtz_types[xut_iter].xit_utoff = (x_int32_t)tzone_be32(xct_iter);
+        xbuild_ptr->xtz_types[xut_iter].xut_isdst = xct_iter[4];
+        xbuild_ptr->xtz_types[xut_iter].xut_abbr  = xct_iter[5];
+        xbuild_ptr->xtz_types[xut_iter].xut_resv  = 0;
+
+        if ((xbuild_ptr->xtz_types[xut_iter].xit_utoff < XTZONE_UTOFF_MIN) ||
+            (xbuild_ptr->xtz_types[xut_iter].xit_utoff > XTZONE_UTOFF_MAX) ||
+            (xct_iter[4] > 1) || (xct_iter[5] >= xut_cnts[5]))
+        {
+            return EINVAL;
+        }
+    }
+
+    memcpy(xbuild_ptr->xszt_chars, xct_iter, xut_cnts[5]);
+    if ('\0' != xbuild_ptr->xszt_chars[xut_cnts[5] - 1])
+    {
+        return EINVAL;
+    }
+
+    xct_iter += xut_cnts[5] + xut_cnts[1] + xut_cnts[0];
+
+    //======================================
+    // 末尾的 POSIX TZ 规则（“\n规则\n”，版本 2 及以上）
+
+    if ((8 != xut_tsize) || (xct_iter >= xct_data + xut_size))
+    {
+        return 0;
+    }
+
+    xct_tail = (const x_uchar_t *)memchr(xct_iter + 1, '\n', (x_size_t)(xct_data + xut_size - xct_iter - 1));
+    if (('\n' != *xct_iter) || (X_NULL == xct_tail) || (xct_tail - xct_iter > TEXT_LEN_128))
+    {
+        return EINVAL;
+    }
+
+    if (xct_tail == xct_iter + 1)
+    {
+        return 0;
+    }
+
+    memcpy(xszt_rule, xct_iter + 1, (x_size_t)(xct_tail - xct_iter - 1));
+    xszt_rule[xct_tail - xct_iter - 1] = '\0';
+
+    xit_errno = tzone_rule_parse(xszt_rule, &xrule_ctx);
+    if (0 == xit_errno)
+    {
+        xit_errno = tzone_build_rule(xbuild_ptr, &xrule_ctx);
+    }
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 TZif 数据，创建 时区对象（偏移变化表 与 各个数组 一次性分配）。
+ */
+static xtime_zoneptr_t tzone_build(const x_uchar_t * xct_data, x_uint32_t xut_size)
+{
+    x_int32_t        xit_errno  = 0;
+    x_uint32_t       xut_bytes  = 0;
+    xtime_zoneptr_t  xtzone_ptr = X_NULL;
+    xtzone_build_t * xbuild_ptr = (xtzone_build_t *)calloc(1, sizeof(xtzone_build_t));
+
+    if (X_NULL == xbuild_ptr)
+    {
+        errno = ENOMEM;
+        return X_NULL;
+    }
+
+    xit_errno = tzone_parse(xct_data, xut_size, xbuild_ptr);
+    if (0 != xit_errno)
+    {
+        if (X_NULL != xbuild_ptr->xit_when)
+            free(xbuild_ptr->xit_when);
+        free(xbuild_ptr);
+        errno = xit_errno;
+        return X_NULL;
+    }
+
+    //======================================
+    // 布局：对象 | 时刻数组 | 类型数组 | 类型索引 | 缩写字符表
+
+    xut_bytes = XTZONE_ALIGN8((x_uint32_t)sizeof(struct xtime_zone_t)) +
+                xbuild_ptr->xut_count * (x_uint32_t)(sizeof(x_int64_t) + 1) +
+                xbuild_ptr->xut_ntype * (x_uint32_t)sizeof(xtzone_type_t) + xbuild_ptr->xut_nchar;
+
+    xtzone_ptr = (xtime_zoneptr_t)calloc(1, xut_bytes);
+    if (X_NULL != xtzone_ptr)
+    {
+        xtzone_ptr->xut_count  = xbuild_ptr->xut_count;
+        xtzone_ptr->xut_ntype  = xbuild_ptr->xut_ntype;
+        xtzone_ptr->xut_nchar  = xbuild_ptr->xut_nchar;
+        xtzone_ptr->xit_when   = (x_int64_t *)((x_uchar_t *)xtzone_ptr + XTZONE_ALIGN8((x_uint32_t)sizeof(struct xtime_zone_t)));
+        xtzone_ptr->xtz_types  = (xtzone_type_t *)(xtzone_ptr->xit_when + xtzone_ptr->xut_count);
+        xtzone_ptr->xut_index  = (x_uint8_t *)(xtzone_ptr->xtz_types + xtzone_ptr->xut_ntype);
+        xtzone_ptr->xszt_chars = (x_char_t *)(xtzone_ptr->xut_index + xtzone_ptr->xut_count);
+
+        memcpy(xtzone_ptr->xit_when  , xbuild_ptr->xit_when , xtzone_ptr->xut_count * sizeof(x_int64_t));
+        memcpy(xtzone_ptr->xtz_types , xbuild_ptr->xtz_types, xtzone_ptr->xut_ntype * sizeof(xtzone_type_t));
+        memcpy(xtzone_ptr->xut_index , xbuild_ptr->xut_index, xtzone_ptr->xut_count);
+        memcpy(xtzone_ptr->xszt_chars, xbuild_ptr->xszt_chars, xtzone_ptr->xut_nchar);
+    }
+    else
+    {
+        errno = ENOMEM;
+    }
+
+    free(xbuild_ptr->xit_when);
+    free(xbuild_ptr);
+
+    return xtzone_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 时区文件 的 全部内容（不超过 XTZONE_FILE_MAX 字节）。
+ */
+static x_int32_t tzone_read(x_cstring_t xszt_path, x_uchar_t ** xct_data, x_uint32_t * xut_size)
+{
+    FILE     * xfile_ptr = X_NULL;
+    x_size_t   xst_size  = 0;
+    x_int32_t  xit_errno = 0;
+
+#ifdef _MSC_VER
+    if (0 != fopen_s(&xfile_ptr, xszt_path, "rb"))
+        xfile_ptr = X_NULL;
+#else // !_MSC_VER
+    xfile_ptr = fopen(xszt_path, "rb");
+#endif // _MSC_VER
+    if (X_NULL == xfile_ptr)
+    {
+        return (0 != errno) ? errno : ENOENT;
+    }
+
+    *xct_data = (x_uchar_t *)malloc(XTZONE_FILE_MAX + 1);
+    if (X_NULL == *xct_data)
+    {
+        fclose(xfile_ptr);
+        return ENOMEM;
+    }
+
+    xst_size = fread(*xct_data, 1, XTZONE_FILE_MAX + 1, xfile_ptr);
+    if (ferror(xfile_ptr))
+        xit_errno = EIO;
+    else if (xst_size > XTZONE_FILE_MAX)
+        xit_errno = EFBIG;
+    fclose(xfile_ptr);
+
+    if (0 != xit_errno)
+    {
+        free(*xct_data);
+        *xct_data = X_NULL;
+        return xit_errno;
+    }
+
+    *xut_size = (x_uint32_t)xst_size;
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 在 共享的 时区对象 链表 中 查找 同名的 时区。
+ */
+static xtime_zoneptr_t tzone_find(xtime_zoneptr_t xtzone_list, x_cstring_t xszt_name)
+{
+    for (; X_NULL != xtzone_list; xtzone_list = xtzone_list->xzone_next)
+    {
+        if (0 == strcmp(xtzone_list->xszt_name, xszt_name))
+            return xtzone_list;
+    }
+
+    return X_NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 加载 时区（进程内 共享）。
+ *
+ * @param [in ] xszt_name : 时区名称（如 “Asia/Shanghai”）或 绝对路径。
+ *
+ * @return xtime_zoneptr_t : 成功，返回 时区对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xtime_zoneptr_t tzone_load(x_cstring_t xszt_name)
+{
+    x_int32_t       xit_errno  = 0;
+    x_cstring_t     xszt_tzdir = X_NULL;
+    x_uchar_t     * xct_data   = X_NULL;
+    x_uint32_t      xut_size   = 0;
+    xtime_zoneptr_t xtzone_ptr = X_NULL;
+    xtime_zoneptr_t xtzone_top = X_NULL;
+    xtime_zoneptr_t xtzone_old = X_NULL;
+    x_char_t        xszt_path[TEXT_LEN_768];
+
+    if ((X_NULL == xszt_name) || ('\0' == xszt_name[0]) || (strlen(xszt_name) >= TEXT_LEN_256))
+    {
+        errno = EINVAL;
+        return X_NULL;
+    }
+
+    // 已加载 的 时区，直接返回
+    xtzone_ptr = tzone_find((xtime_zoneptr_t)XATOMIC_LOADPTR(&g_xtzone_shared), xszt_name);
+    if (X_NULL != xtzone_ptr)
+    {
+        return xtzone_ptr;
+    }
+
+    //======================================
+    // 时区文件 的 路径
+
+    if ('/' == xszt_name[0])
+    {
+        snprintf(xszt_path, sizeof(xszt_path), "%s", xszt_name);
+    }
+    else
+    {
+        if (X_NULL != strstr(xszt_name, ".."))
+        {
+            errno = EINVAL;
+            return X_NULL;
+        }
+
+        xszt_tzdir = getenv("TZDIR");
+        if ((X_NULL == xszt_tzdir) || ('\0' == xszt_tzdir[0]))
+            xszt_tzdir = XTZONE_DIR_DEFAULT;
+
+        if ((x_int32_t)sizeof(xszt_path) <= snprintf(xszt_path, sizeof(xszt_path), "%s/%s", xszt_tzdir, xszt_name))
+        {
+            errno = ENAMETOOLONG;
+            return X_NULL;
+        }
+    }
+
+    //======================================
+
+    xit_errno = tzone_read(xszt_path, &xct_data, &xut_size);
+    if (0 != xit_errno)
+    {
+        errno = xit_errno;
+        return X_NULL;
+    }
+
+    xtzone_ptr = tzone_build(xct_data, xut_size);
+    free(xct_data);
+    if (X_NULL == xtzone_ptr)
+    {
+        return X_NULL;
+    }
+
+    xtzone_ptr->xbt_shared = X_TRUE;
+    memcpy(xtzone_ptr->xszt_name, xszt_name, strlen(xszt_name) + 1);
+
+    //======================================
+    // 插入 共享链表：其他线程 同时 加载了 同名时区 时，使用 先插入的 对象
+
+    for (;;)
+    {
+        xtzone_top = (xtime_zoneptr_t)XATOMIC_LOADPTR(&g_xtzone_shared);
+        xtzone_old = tzone_find(xtzone_top, xszt_name);
+        if (X_NULL != xtzone_old)
+        {
+            free(xtzone_ptr);
+            return xtzone_old;
+        }
+
+        xtzone_ptr->xzone_next = xtzone_top;
+        if (XATOMIC_CASPTR(&g_xtzone_shared, xtzone_top, xtzone_ptr))
+            break;
+    }
+
+    return xtzone_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 内存中的 TZif 数据 创建 时区对象（不共享，须以 tzone_destroy() 销毁）。
+ *
+ * @param [in ] xct_data : TZif 数据。
+ * @param [in ] xut_size : 数据的 字节数。
+ *
+ * @return xtime_zoneptr_t : 成功，返回 时区对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xtime_zoneptr_t tzone_create(const x_uchar_t * xct_data, x_uint32_t xut_size)
+{
+    return tzone_build(xct_data, xut_size);
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁 tzone_create() 创建的 时区对象（共享的 时区对象 与 X_NULL 被忽略）。
+ */
+x_void_t tzone_destroy(xtime_zoneptr_t xtzone_ptr)
+{
+    if ((X_NULL != xtzone_ptr) && !xtzone_ptr->xbt_shared)
+    {
+        free(xtzone_ptr);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 时区对象 的 名称（tzone_create() 创建的 为 空字符串，X_NULL 为 “UTC”）。
+ */
+x_cstring_t tzone_name(xtime_zoneptr_t xtzone_ptr)
+{
+    return (X_NULL != xtzone_ptr) ? xtzone_ptr->xszt_name : "UTC";
+}
+
+/**********************************************************/
+/**
+ * @brief xtm_vnsec 时刻 的 时区偏移（本地时间 减去 UTC，秒）。
+ */
+x_int32_t tzone_offset(xtime_zoneptr_t xtzone_ptr, xtime_vnsec_t xtm_vnsec)
+{
+    if (X_NULL == xtzone_ptr)
+    {
+        return 0;
+    }
+
+    return tzone_type(xtzone_ptr, tzone_seek(xtzone_ptr, (x_int64_t)(xtm_vnsec / 10000000ULL)))->xit_utoff;
+}
+
+/**********************************************************/
+/**
+ * @brief xtm_vnsec 时刻 的 时区缩写（如 “EST”、“+0530”）。
+ */
+x_cstring_t tzone_abbr(xtime_zoneptr_t xtzone_ptr, xtime_vnsec_t xtm_vnsec)
+{
+    if (X_NULL == xtzone_ptr)
+    {
+        return "UTC";
+    }
+
+    return xtzone_ptr->xszt_chars +
+           tzone_type(xtzone_ptr, tzone_seek(xtzone_ptr, (x_int64_t)(xtm_vnsec / 10000000ULL)))->xut_abbr;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 转换为 指定时区 的 时间描述信息（与 进程的 时区 无关）。
+ *
+ * @param [in ] xtzone_ptr : 时区对象（X_NULL 表示 UTC）。
+ * @param [in ] xtm_vnsec  : 待转换的 时间计量值。
+ *
+ * @return xtime_descr_t : 返回 时间描述信息；本地时间 超出 1970 ~ 9999 年 时，返回 无效值。
+ */
+xtime_descr_t time_vtod_tz(xtime_zoneptr_t xtzone_ptr, xtime_vnsec_t xtm_vnsec)
+{
+    xtime_descr_t xtm_descr  = { 0 };
+    x_int64_t     xit_second = 0;
+
+    if ((X_NULL == xtzone_ptr) || !XTMVNSEC_IS_VALID(xtm_vnsec))
+    {
+        return time_vtod_utc(xtm_vnsec);
+    }
+
+    xit_second = (x_int64_t)(xtm_vnsec / 10000000ULL);
+    xit_second = xit_second + tzone_type(xtzone_ptr, tzone_seek(xtzone_ptr, xit_second))->xit_utoff;
+    if (xit_second < 0)
+    {
+        return xtm_descr;
+    }
+
+    return time_vtod_utc((xtime_vnsec_t)xit_second * 10000000ULL + xtm_vnsec % 10000000ULL);
+}
+
+/**********************************************************/
+/**
+ * @brief 将 指定时区 的 时间描述信息 转换为 时间计量值（time_vtod_tz() 的 逆操作）。
+ * @note
+ * 本地时间 L 在 时间段 s 内 对应的 时刻 为 L - off(s)，该时刻 须 落在 时间段 s 之内；
+ * 时区偏移 不超过 ±26 小时，只须 检查 [L - 26h, L + 25h] 所覆盖的 时间段。
+ *
+ * @param [in ] xtzone_ptr : 时区对象（X_NULL 表示 UTC）。
+ * @param [in ] xtm_descr  : 待转换的 时间描述信息。
+ *
+ * @return xtime_vnsec_t : 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断其是否为有效。
+ */
+xtime_vnsec_t time_dtov_tz(xtime_zoneptr_t xtzone_ptr, xtime_descr_t xtm_descr)
+{
+    xtime_vnsec_t xtm_local  = time_dtov_utc(xtm_descr);
+    x_int64_t     xit_local  = 0;
+    x_int64_t     xit_check  = 0;
+    x_int64_t     xit_found  = -1;
+    x_uint32_t    xut_segm   = 0;
+    x_uint32_t    xut_last   = 0;
+    x_bool_t      xbt_found  = X_FALSE;
+
+    if ((X_NULL == xtzone_ptr) || !XTMVNSEC_IS_VALID(xtm_local))
+    {
+        return xtm_local;
+    }
+
+    xit_local = (x_int64_t)(xtm_local / 10000000ULL);
+    xut_segm  = tzone_seek(xtzone_ptr, xit_local + XTZONE_UTOFF_MIN - 1);
+    xut_last  = tzone_seek(xtzone_ptr, xit_local + XTZONE_UTOFF_MAX + 1);
+
+    //======================================
+    // 落在 所属时间段 之内的 时刻（重复的 本地时间 取 较早者）
+
+    for (; xut_segm <= xut_last; ++xut_segm)
+    {
+        xit_check = xit_local - tzone_type(xtzone_ptr, xut_segm)->xit_utoff;
+        if (((0 == xut_segm) || (xit_check >= xtzone_ptr->xit_when[xut_segm - 1])) &&
+            ((xtzone_ptr->xut_count == xut_segm) || (xit_check < xtzone_ptr->xit_when[xut_segm])))
+        {
+            if (!xbt_found || (xit_check < xit_found))
+                xit_found = xit_check;
+            xbt_found = X_TRUE;
+        }
+    }
+
+    //======================================
+    // 跳过的 本地时间：按 前跳之前 的 时区偏移 换算
+
+    if (!xbt_found)
+    {
+        xut_segm  = tzone_seek(xtzone_ptr, xit_local + XTZONE_UTOFF_MIN - 1);
+        xit_found = xit_local - tzone_type(xtzone_ptr, tzone_seek(xtzone_ptr, xit_local))->xit_utoff;
+
+        for (; (xut_segm < xut_last) && (xut_segm < xtzone_ptr->xut_count); ++xut_segm)
+        {
+            xit_check = xit_local - tzone_type(xtzone_ptr, xut_segm)->xit_utoff;
+            if ((xit_check >= xtzone_ptr->xit_when[xut_segm]) &&
+                (xit_local - tzone_type(xtzone_ptr, xut_segm + 1)->xit_utoff < xtzone_ptr->xit_when[xut_segm]))
+            {
+                xit_found = xit_check;
+                break;
+            }
+        }
+    }
+
+    if (xit_found < 0)
+    {
+        return XTIME_INVALID_VNSEC;
+    }
+
+    return (xtime_vnsec_t)xit_found * 10000000ULL + xtm_local % 10000000ULL;
+}
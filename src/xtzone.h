@@ -0,0 +1,151 @@
+﻿/**
+ * @file xtzone.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 进程内的 时区转换：加载 TZif 文件（RFC 8536）为 只读的 时区偏移变化表，按 指定时区 转换时间。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __XTZONE_H__
+#define __XTZONE_H__
+
+#include "xtime.h"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 时区文件 的 默认目录（可由 环境变量 TZDIR 指定） */
+#define XTZONE_DIR_DEFAULT  "/usr/share/zoneinfo"
+
+/** 时区文件 的 最大字节数 */
+#define XTZONE_FILE_MAX     (256 * 1024)
+
+/** 按 TZif 文件末尾的 POSIX TZ 规则 展开 偏移变化 的 截止年份（其后 沿用 最后的 时区偏移） */
+#define XTZONE_YEAR_END     2200
+
+/** 定义 时区对象 的 指针类型（X_NULL 表示 UTC） */
+typedef struct xtime_zone_t * xtime_zoneptr_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 加载 时区（进程内 共享）。
+ * @note
+ * 时区对象 加载后 只被读取，可由多个线程 同时使用；
+ * 同名的 时区 只加载一次，之后的 调用（任意线程）返回 同一对象，共享的 时区对象 直至 进程结束 才释放。
+ * 相对名称（如 “Asia/Shanghai”）在 TZDIR（未设置时 为 XTZONE_DIR_DEFAULT）目录下 查找，不可含有 “..”；
+ * 亦可 使用 绝对路径。
+ *
+ * @param [in ] xszt_name : 时区名称。
+ *
+ * @return xtime_zoneptr_t :
+ * 成功，返回 时区对象；失败，返回 X_NULL，可通过 errno 查看错误码
+ * （文件不存在 为 ENOENT，格式错误 为 EINVAL，含有 闰秒（“right/” 时区）为 ENOTSUP，文件过大 为 EFBIG）。
+ */
+xtime_zoneptr_t tzone_load(x_cstring_t xszt_name);
+
+/**********************************************************/
+/**
+ * @brief 以 内存中的 TZif 数据 创建 时区对象（不共享，须以 tzone_destroy() 销毁）。
+ *
+ * @param [in ] xct_data : TZif 数据。
+ * @param [in ] xut_size : 数据的 字节数。
+ *
+ * @return xtime_zoneptr_t : 成功，返回 时区对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+xtime_zoneptr_t tzone_create(const x_uchar_t * xct_data, x_uint32_t xut_size);
+
+/**********************************************************/
+/**
+ * @brief 销毁 tzone_create() 创建的 时区对象（共享的 时区对象 与 X_NULL 被忽略）。
+ */
+x_void_t tzone_destroy(xtime_zoneptr_t xtzone_ptr);
+
+/**********************************************************/
+/**
+ * @brief 时区对象 的 名称（tzone_create() 创建的 为 空字符串，X_NULL 为 “UTC”）。
+ */
+x_cstring_t tzone_name(xtime_zoneptr_t xtzone_ptr);
+
+/**********************************************************/
+/**
+ * @brief xtm_vnsec 时刻 的 时区偏移（本地时间 减去 UTC，秒）。
+ */
+x_int32_t tzone_offset(xtime_zoneptr_t xtzone_ptr, xtime_vnsec_t xtm_vnsec);
+
+/**********************************************************/
+/**
+ * @brief xtm_vnsec 时刻 的 时区缩写（如 “EST”、“+0530”）。
+ */
+x_cstring_t tzone_abbr(xtime_zoneptr_t xtzone_ptr, xtime_vnsec_t xtm_vnsec);
+
+/**********************************************************/
+/**
+ * @brief 将 时间计量值 转换为 指定时区 的 时间描述信息（与 进程的 时区 无关）。
+ * @note
+ * 二分查找 偏移变化表，再以 算术方式 换算，不经 系统接口，可由多个线程 同时调用。
+ *
+ * @param [in ] xtzone_ptr : 时区对象（X_NULL 表示 UTC）。
+ * @param [in ] xtm_vnsec  : 待转换的 时间计量值。
+ *
+ * @return xtime_descr_t :
+ * 返回 时间描述信息；本地时间 早于 1970 年 或 晚于 9999 年 时，返回 无效值（ctx_value 为 0）。
+ */
+xtime_descr_t time_vtod_tz(xtime_zoneptr_t xtzone_ptr, xtime_vnsec_t xtm_vnsec);
+
+/**********************************************************/
+/**
+ * @brief 将 指定时区 的 时间描述信息 转换为 时间计量值（time_vtod_tz() 的 逆操作）。
+ * @note
+ * 时区偏移 回退（如 夏令时 结束）时 重复出现的 本地时间，取 较早的 时刻；
+ * 时区偏移 前跳（如 夏令时 开始）时 跳过的 本地时间，按 前跳之前 的 时区偏移 换算
+ * （如 纽约 2026-03-08 02:30 换算为 07:30Z，即 夏令时 03:30）。
+ * 不校验 星期。
+ *
+ * @param [in ] xtzone_ptr : 时区对象（X_NULL 表示 UTC）。
+ * @param [in ] xtm_descr  : 待转换的 时间描述信息。
+ *
+ * @return xtime_vnsec_t :
+ * 返回 时间计量值，可用 XTMVNSEC_IS_VALID() 判断其是否为有效。
+ */
+xtime_vnsec_t time_dtov_tz(xtime_zoneptr_t xtzone_ptr, xtime_descr_t xtm_descr);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XTZONE_H__
@@ -0,0 +1,574 @@
+﻿/**
+ * @file xuring.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 基于 io_uring 系统调用的 最小化封装（仅 Linux 平台，不依赖 liburing）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "xuring.h"
+
+#if defined(XNTP_IO_URING) && defined(__linux__)
+
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+//====================================================================
+
+//
+// 内部相关的数据类型与常量
+//
+
+/**
+ * @struct xuring_t
+ * @brief  io_uring 工作对象（提交队列、完成队列、提供缓存环 的映射信息）。
+ */
+typedef struct xuring_t
+{
+    x_int32_t             xit_ringfd;   ///< io_uring 的 文件描述符
+
+    x_uint32_t          * xut_sq_head;  ///< SQ 队列头（内核更新）
+    x_uint32_t          * xut_sq_tail;  ///< SQ 队列尾（用户更新）
+    x_uint32_t            xut_sq_mask;  ///< SQ 索引掩码
+    x_uint32_t            xut_sq_size;  ///< SQ 容量
+    x_uint32_t            xut_sq_local; ///< 本地已准备（尚未提交）的 SQ 队列尾
+    struct io_uring_sqe * xsqe_list;    ///< SQE 数组
+
+    x_uint32_t          * xut_cq_head;  ///< CQ 队列头（用户更新）
+    x_uint32_t          * xut_cq_tail;  ///< CQ 队列尾（内核更新）
+    x_uint32_t            xut_cq_mask;  ///< CQ 索引掩码
+    struct io_uring_cqe * xcqe_list;    ///< CQE 数组
+
+    x_mptr_t              xmpt_sqring;  ///< SQ 环的 映射地址
+    x_size_t              xst_sqring;   ///< SQ 环的 映射长度
+    x_mptr_t              xmpt_cqring;  ///< CQ 环的 映射地址（单次映射时，与 SQ 环相同）
+    x_size_t              xst_cqring;   ///< CQ 环的 映射长度
+    x_size_t              xst_sqelist;  ///< SQE 数组的 映射长度
+
+    struct io_uring_buf_ring * xbuf_ring; ///< 提供缓存环
+    x_bptr_t              xbuf_data;    ///< 提供缓存 的 数据区
+    x_uint16_t            xut_buf_tail; ///< 提供缓存环 的 本地队列尾
+
+    x_mptr_t              xmpt_scratch; ///< 临时缓存
+    x_size_t              xst_scratch;  ///< 临时缓存 的 字节数
+} xuring_t;
+
+/** 标识 io_uring 在本进程中 是否可用（0，未知；1，可用；-1，不可用） */
+static volatile x_int32_t xit_uring_state = 0;
+
+/** 线程私有的 io_uring 工作对象 的 存储键 */
+static pthread_key_t  xkey_uring_local;
+static pthread_once_t xonce_uring_key = PTHREAD_ONCE_INIT;
+
+/** 提供缓存环 占用的内存字节数 */
+#define XURING_BUF_RING_SIZE (XURING_BUF_COUNT * sizeof(struct io_uring_buf))
+
+//====================================================================
+
+//
+// 内部相关的操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief io_uring_setup() 系统调用。
+ */
+static x_int32_t xuring_sys_setup(x_uint32_t xut_entries, struct io_uring_params * xparams)
+{
+    return (x_int32_t)syscall(__NR_io_uring_setup, xut_entries, xparams);
+}
+
+/**********************************************************/
+/**
+ * @brief io_uring_enter() 系统调用。
+ */
+static x_int32_t xuring_sys_enter(
+                    x_int32_t xit_ringfd,
+                    x_uint32_t xut_submit,
+                    x_uint32_t xut_wait,
+                    x_uint32_t xut_flags)
+{
+    return (x_int32_t)syscall(
+                __NR_io_uring_enter, xit_ringfd, xut_submit, xut_wait, xut_flags, X_NULL, 0);
+}
+
+/**********************************************************/
+/**
+ * @brief io_uring_register() 系统调用。
+ */
+static x_int32_t xuring_sys_register(
+                    x_int32_t xit_ringfd,
+                    x_uint32_t xut_opcode,
+                    x_pvoid_t xpvt_arg,
+                    x_uint32_t xut_nargs)
+{
+    return (x_int32_t)syscall(__NR_io_uring_register, xit_ringfd, xut_opcode, xpvt_arg, xut_nargs);
+}
+
+/**********************************************************/
+/**
+ * @brief 销毁 io_uring 工作对象。
+ */
+static x_void_t xuring_close(xuring_ptr_t xring_ptr)
+{
+    if (X_NULL == xring_ptr)
+    {
+        return;
+    }
+
+    if (X_NULL != xring_ptr->xbuf_ring)
+        munmap(xring_ptr->xbuf_ring, XURING_BUF_RING_SIZE);
+    if (X_NULL != xring_ptr->xbuf_data)
+        free(xring_ptr->xbuf_data);
+    if (X_NULL != xring_ptr->xsqe_list)
+        munmap(xring_ptr->xsqe_list, xring_ptr->xst_sqelist);
+    if ((X_NULL != xring_ptr->xmpt_cqring) && (xring_ptr->xmpt_cqring != xring_ptr->xmpt_sqring))
+        munmap(xring_ptr->xmpt_cqring, xring_ptr->xst_cqring);
+    if (X_NULL != xring_ptr->xmpt_sqring)
+        munmap(xring_ptr->xmpt_sqring, xring_ptr->xst_sqring);
+    if (xring_ptr->xit_ringfd >= 0)
+        close(xring_ptr->xit_ringfd);
+    if (X_NULL != xring_ptr->xmpt_scratch)
+        free(xring_ptr->xmpt_scratch);
+
+    free(xring_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 io_uring 工作对象，并注册 提供缓存环。
+ *
+ * @return xuring_ptr_t : 成功，返回 工作对象；失败，返回 X_NULL，可通过 errno 查看错误码。
+ */
+static xuring_ptr_t xuring_open(void)
+{
+    x_int32_t    xit_errno = EPERM;
+    xuring_ptr_t xring_ptr = X_NULL;
+    x_uint8_t  * xbt_sqptr = X_NULL;
+    x_uint8_t  * xbt_cqptr = X_NULL;
+    x_uint32_t   xut_iter  = 0;
+
+    struct io_uring_params  xparams;
+    struct io_uring_buf_reg xbufreg;
+
+    do
+    {
+        //======================================
+
+        xring_ptr = (xuring_ptr_t)calloc(1, sizeof(xuring_t));
+        if (X_NULL == xring_ptr)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        xring_ptr->xit_ringfd = -1;
+
+        memset(&xparams, 0, sizeof(xparams));
+        xring_ptr->xit_ringfd = xuring_sys_setup(XURING_SQ_ENTRIES, &xparams);
+        if (xring_ptr->xit_ringfd < 0)
+        {
+            xit_errno = errno;
+            break;
+        }
+
+        // 不支持 NODROP 的内核（< 5.5），完成队列溢出时会丢失事件
+        if (0 == (xparams.features & IORING_FEAT_NODROP))
+        {
+            xit_errno = ENOSYS;
+            break;
+        }
+
+        //======================================
+        // 映射 SQ/CQ 环
+
+        xring_ptr->xst_sqring = xparams.sq_off.array + xparams.sq_entries * sizeof(x_uint32_t);
+        xring_ptr->xst_cqring = xparams.cq_off.cqes  + xparams.cq_entries * sizeof(struct io_uring_cqe);
+        if (xparams.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            if (xring_ptr->xst_cqring > xring_ptr->xst_sqring)
+                xring_ptr->xst_sqring = xring_ptr->xst_cqring;
+            xring_ptr->xst_cqring = xring_ptr->xst_sqring;
+        }
+
+        xring_ptr->xmpt_sqring = mmap(X_NULL, xring_ptr->xst_sqring,
+                                      PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                      xring_ptr->xit_ringfd, IORING_OFF_SQ_RING);
+        if (MAP_FAILED == xring_ptr->xmpt_sqring)
+        {
+            xring_ptr->xmpt_sqring = X_NULL;
+            xit_errno = errno;
+            break;
+        }
+
+        if (xparams.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            xring_ptr->xmpt_cqring = xring_ptr->xmpt_sqring;
+        }
+        else
+        {
+            xring_ptr->xmpt_cqring = mmap(X_NULL, xring_ptr->xst_cqring,
+                                          PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                          xring_ptr->xit_ringfd, IORING_OFF_CQ_RING);
+            if (MAP_FAILED == xring_ptr->xmpt_cqring)
+            {
+                xring_ptr->xmpt_cqring = X_NULL;
+                xit_errno = errno;
+                break;
+            }
+        }
+
+        xring_ptr->xst_sqelist = xparams.sq_entries * sizeof(struct io_uring_sqe);
+        xring_ptr->xsqe_list = (struct io_uring_sqe *)mmap(
+                                    X_NULL, xring_ptr->xst_sqelist,
+                                    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                    xring_ptr->xit_ringfd, IORING_OFF_SQES);
+        if (MAP_FAILED == (x_mptr_t)xring_ptr->xsqe_list)
+        {
+            xring_ptr->xsqe_list = X_NULL;
+            xit_errno = errno;
+            break;
+        }
+
+        xbt_sqptr = (x_uint8_t *)xring_ptr->xmpt_sqring;
+        xbt_cqptr = (x_uint8_t *)xring_ptr->xmpt_cqring;
+
+        xring_ptr->xut_sq_head  = (x_uint32_t *)(xbt_sqptr + xparams.sq_off.head);
+        xring_ptr->xut_sq_tail  = (x_uint32_t *)(xbt_sqptr + xparams.sq_off.tail);
+        xring_ptr->xut_sq_mask  = *(x_uint32_t *)(xbt_sqptr + xparams.sq_off.ring_mask);
+        xring_ptr->xut_sq_size  = xparams.sq_entries;
+        xring_ptr->xut_sq_local = *xring_ptr->xut_sq_tail;
+
+        xring_ptr->xut_cq_head  = (x_uint32_t *)(xbt_cqptr + xparams.cq_off.head);
+        xring_ptr->xut_cq_tail  = (x_uint32_t *)(xbt_cqptr + xparams.cq_off.tail);
+        xring_ptr->xut_cq_mask  = *(x_uint32_t *)(xbt_cqptr + xparams.cq_off.ring_mask);
+        xring_ptr->xcqe_list    = (struct io_uring_cqe *)(xbt_cqptr + xparams.cq_off.cqes);
+
+        // SQ 索引数组 固定为 恒等映射，此后只需更新 队列尾
+        for (xut_iter = 0; xut_iter < xparams.sq_entries; ++xut_iter)
+        {
+            ((x_uint32_t *)(xbt_sqptr + xparams.sq_off.array))[xut_iter] = xut_iter;
+        }
+
+        //======================================
+        // 注册 提供缓存环（内核 >= 5.19）
+
+        xring_ptr->xbuf_ring = (struct io_uring_buf_ring *)mmap(
+                                    X_NULL, XURING_BUF_RING_SIZE,
+                                    PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (MAP_FAILED == (x_mptr_t)xring_ptr->xbuf_ring)
+        {
+            xring_ptr->xbuf_ring = X_NULL;
+            xit_errno = errno;
+            break;
+        }
+
+        xring_ptr->xbuf_data = (x_bptr_t)malloc(XURING_BUF_COUNT * XURING_BUF_SIZE);
+        if (X_NULL == xring_ptr->xbuf_data)
+        {
+            xit_errno = ENOMEM;
+            break;
+        }
+
+        memset(&xbufreg, 0, sizeof(xbufreg));
+        xbufreg.ring_addr    = (x_uint64_t)(x_size_t)xring_ptr->xbuf_ring;
+        xbufreg.ring_entries = XURING_BUF_COUNT;
+        xbufreg.bgid         = XURING_BUF_GROUP;
+        if (xuring_sys_register(xring_ptr->xit_ringfd, IORING_REGISTER_PBUF_RING, &xbufreg, 1) < 0)
+        {
+            xit_errno = errno;
+            break;
+        }
+
+        xring_ptr->xut_buf_tail = 0;
+        for (xut_iter = 0; xut_iter < XURING_BUF_COUNT; ++xut_iter)
+        {
+            xuring_buf_recycle(xring_ptr, (x_uint16_t)xut_iter);
+        }
+
+        //======================================
+        xit_errno = 0;
+    } while (0);
+
+    if (0 != xit_errno)
+    {
+        xuring_close(xring_ptr);
+        xring_ptr = X_NULL;
+        errno = xit_errno;
+    }
+
+    return xring_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 线程退出时，销毁其 io_uring 工作对象 的回调函数。
+ */
+static x_void_t xuring_local_free(x_pvoid_t xpvt_value)
+{
+    xuring_close((xuring_ptr_t)xpvt_value);
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 线程私有数据 的存储键。
+ */
+static x_void_t xuring_key_init(void)
+{
+    if (0 != pthread_key_create(&xkey_uring_local, xuring_local_free))
+    {
+        xit_uring_state = -1;
+    }
+}
+
+//====================================================================
+
+//
+// 外部相关操作接口
+//
+
+/**********************************************************/
+/**
+ * @brief 获取 调用线程 所独占的 io_uring 工作对象（首次调用时创建）。
+ * @note
+ * 若内核不支持 io_uring（或 提供缓存环 等特性），或先前已调用 xuring_disable()，
+ * 则返回 X_NULL，调用方应回退到 select() 等常规方式。
+ * 线程退出时，其工作对象会被自动销毁。
+ */
+xuring_ptr_t xuring_local(void)
+{
+    xuring_ptr_t xring_ptr = X_NULL;
+
+    if (xit_uring_state < 0)
+    {
+        return X_NULL;
+    }
+
+    pthread_once(&xonce_uring_key, xuring_key_init);
+    if (xit_uring_state < 0)
+    {
+        return X_NULL;
+    }
+
+    xring_ptr = (xuring_ptr_t)pthread_getspecific(xkey_uring_local);
+    if (X_NULL != xring_ptr)
+    {
+        return xring_ptr;
+    }
+
+    xring_ptr = xuring_open();
+    if (X_NULL == xring_ptr)
+    {
+        // 创建失败（内核不支持、受 seccomp 限制 等），此后不再尝试
+        xit_uring_state = -1;
+        return X_NULL;
+    }
+
+    if (0 != pthread_setspecific(xkey_uring_local, xring_ptr))
+    {
+        xuring_close(xring_ptr);
+        return X_NULL;
+    }
+
+    xit_uring_state = 1;
+    return xring_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 在进程范围内禁用 io_uring（如 运行时发现内核不支持 多次接收 等操作）。
+ */
+x_void_t xuring_disable(void)
+{
+    xit_uring_state = -1;
+}
+
+/**********************************************************/
+/**
+ * @brief 从提交队列中获取一个空闲的 SQE（已清零）；队列已满时返回 X_NULL。
+ */
+struct io_uring_sqe * xuring_get_sqe(xuring_ptr_t xring_ptr)
+{
+    struct io_uring_sqe * xsqe_ptr = X_NULL;
+    x_uint32_t xut_head = __atomic_load_n(xring_ptr->xut_sq_head, __ATOMIC_ACQUIRE);
+
+    if ((xring_ptr->xut_sq_local - xut_head) >= xring_ptr->xut_sq_size)
+    {
+        return X_NULL;
+    }
+
+    xsqe_ptr = &xring_ptr->xsqe_list[xring_ptr->xut_sq_local & xring_ptr->xut_sq_mask];
+    xring_ptr->xut_sq_local += 1;
+
+    memset(xsqe_ptr, 0, sizeof(struct io_uring_sqe));
+    return xsqe_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 提交所有已准备好的 SQE，并（可选地）等待完成事件。
+ *
+ * @param [in ] xring_ptr : io_uring 工作对象。
+ * @param [in ] xut_wait  : 至少等待的 完成事件（CQE）数量，取 0 时不等待。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t xuring_submit(xuring_ptr_t xring_ptr, x_uint32_t xut_wait)
+{
+    x_int32_t  xit_errno  = 0;
+    x_uint32_t xut_submit = xring_ptr->xut_sq_local - *xring_ptr->xut_sq_tail;
+
+    __atomic_store_n(xring_ptr->xut_sq_tail, xring_ptr->xut_sq_local, __ATOMIC_RELEASE);
+
+    if ((0 == xut_submit) && (0 == xut_wait))
+    {
+        return 0;
+    }
+
+    for (;;)
+    {
+        if (xuring_sys_enter(xring_ptr->xit_ringfd, xut_submit, xut_wait,
+                             (xut_wait > 0) ? IORING_ENTER_GETEVENTS : 0) >= 0)
+        {
+            xit_errno = 0;
+            break;
+        }
+
+        xit_errno = errno;
+        if (EINTR != xit_errno)
+        {
+            break;
+        }
+
+        // 被信号中断时，提交操作已完成，只需继续等待
+        xut_submit = 0;
+        if (X_NULL != xuring_peek_cqe(xring_ptr))
+        {
+            xit_errno = 0;
+            break;
+        }
+    }
+
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 查看完成队列中的下一个 CQE；队列为空时返回 X_NULL。
+ */
+struct io_uring_cqe * xuring_peek_cqe(xuring_ptr_t xring_ptr)
+{
+    x_uint32_t xut_head = *xring_ptr->xut_cq_head;
+    x_uint32_t xut_tail = __atomic_load_n(xring_ptr->xut_cq_tail, __ATOMIC_ACQUIRE);
+
+    if (xut_head == xut_tail)
+    {
+        return X_NULL;
+    }
+
+    return &xring_ptr->xcqe_list[xut_head & xring_ptr->xut_cq_mask];
+}
+
+/**********************************************************/
+/**
+ * @brief 标记 xuring_peek_cqe() 返回的 CQE 已处理完毕。
+ */
+x_void_t xuring_cqe_seen(xuring_ptr_t xring_ptr)
+{
+    __atomic_store_n(xring_ptr->xut_cq_head, *xring_ptr->xut_cq_head + 1, __ATOMIC_RELEASE);
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 提供缓存 的 数据地址。
+ *
+ * @param [in ] xring_ptr : io_uring 工作对象。
+ * @param [in ] xut_bid   : 缓存编号（取自 CQE 的 flags >> IORING_CQE_BUFFER_SHIFT）。
+ */
+x_bptr_t xuring_buf_addr(xuring_ptr_t xring_ptr, x_uint16_t xut_bid)
+{
+    return (xring_ptr->xbuf_data + (x_size_t)(xut_bid % XURING_BUF_COUNT) * XURING_BUF_SIZE);
+}
+
+/**********************************************************/
+/**
+ * @brief 将使用完毕的 提供缓存 归还给内核。
+ */
+x_void_t xuring_buf_recycle(xuring_ptr_t xring_ptr, x_uint16_t xut_bid)
+{
+    struct io_uring_buf * xbuf_ptr =
+        &xring_ptr->xbuf_ring->bufs[xring_ptr->xut_buf_tail & (XURING_BUF_COUNT - 1)];
+
+    xbuf_ptr->addr = (x_uint64_t)(x_size_t)xuring_buf_addr(xring_ptr, xut_bid);
+    xbuf_ptr->len  = XURING_BUF_SIZE;
+    xbuf_ptr->bid  = xut_bid;
+
+    xring_ptr->xut_buf_tail += 1;
+    __atomic_store_n(&xring_ptr->xbuf_ring->tail, xring_ptr->xut_buf_tail, __ATOMIC_RELEASE);
+}
+
+/**********************************************************/
+/**
+ * @brief 获取 调用线程 的 io_uring 工作对象所附带的 临时缓存（供提交 SQE 时引用的参数数据）。
+ * @note  所返回的缓存，在下次调用本接口前有效，且调用方不得释放它。
+ *
+ * @param [in ] xring_ptr : io_uring 工作对象。
+ * @param [in ] xst_size  : 所需的缓存字节数。
+ *
+ * @return x_mptr_t : 成功，返回缓存地址；失败，返回 X_NULL。
+ */
+x_mptr_t xuring_scratch(xuring_ptr_t xring_ptr, x_size_t xst_size)
+{
+    x_mptr_t xmpt_data = X_NULL;
+
+    if (xst_size <= xring_ptr->xst_scratch)
+    {
+        return xring_ptr->xmpt_scratch;
+    }
+
+    xmpt_data = realloc(xring_ptr->xmpt_scratch, xst_size);
+    if (X_NULL == xmpt_data)
+    {
+        return X_NULL;
+    }
+
+    xring_ptr->xmpt_scratch = xmpt_data;
+    xring_ptr->xst_scratch  = xst_size;
+
+    return xmpt_data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // defined(XNTP_IO_URING) && defined(__linux__)
@@ -0,0 +1,151 @@
+﻿/**
+ * @file xuring.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 基于 io_uring 系统调用的 最小化封装（仅 Linux 平台，不依赖 liburing）。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __XURING_H__
+#define __XURING_H__
+
+#include "xtypes.h"
+
+/**
+ * 只有在定义 XNTP_IO_URING 宏（由 CMake 选项控制）的 Linux 平台上，
+ * 才启用 io_uring 传输后端；否则本文件中的接口均不可用。
+ */
+#if defined(XNTP_IO_URING) && defined(__linux__)
+
+#include <linux/io_uring.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 提交队列（SQ）的 容量 */
+#define XURING_SQ_ENTRIES   256
+
+/** 接收数据使用的 提供缓存（provided buffer ring）的 组号 */
+#define XURING_BUF_GROUP    0
+
+/** 提供缓存 的 个数（必须为 2 的幂） */
+#define XURING_BUF_COUNT    64
+
+/** 单个 提供缓存 的 字节数（除 报文头信息 外，须能容纳 最大的 NTP 报文：1472 字节） */
+#define XURING_BUF_SIZE     2048
+
+/** 定义 io_uring 工作对象的 指针类型 */
+typedef struct xuring_t * xuring_ptr_t;
+
+/**********************************************************/
+/**
+ * @brief 获取 调用线程 所独占的 io_uring 工作对象（首次调用时创建）。
+ * @note
+ * 若内核不支持 io_uring（或 提供缓存环 等特性），或先前已调用 xuring_disable()，
+ * 则返回 X_NULL，调用方应回退到 select() 等常规方式。
+ * 线程退出时，其工作对象会被自动销毁。
+ */
+xuring_ptr_t xuring_local(void);
+
+/**********************************************************/
+/**
+ * @brief 在进程范围内禁用 io_uring（如 运行时发现内核不支持 多次接收 等操作）。
+ */
+x_void_t xuring_disable(void);
+
+/**********************************************************/
+/**
+ * @brief 从提交队列中获取一个空闲的 SQE（已清零）；队列已满时返回 X_NULL。
+ */
+struct io_uring_sqe * xuring_get_sqe(xuring_ptr_t xring_ptr);
+
+/**********************************************************/
+/**
+ * @brief 提交所有已准备好的 SQE，并（可选地）等待完成事件。
+ *
+ * @param [in ] xring_ptr : io_uring 工作对象。
+ * @param [in ] xut_wait  : 至少等待的 完成事件（CQE）数量，取 0 时不等待。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+x_int32_t xuring_submit(xuring_ptr_t xring_ptr, x_uint32_t xut_wait);
+
+/**********************************************************/
+/**
+ * @brief 查看完成队列中的下一个 CQE；队列为空时返回 X_NULL。
+ */
+struct io_uring_cqe * xuring_peek_cqe(xuring_ptr_t xring_ptr);
+
+/**********************************************************/
+/**
+ * @brief 标记 xuring_peek_cqe() 返回的 CQE 已处理完毕。
+ */
+x_void_t xuring_cqe_seen(xuring_ptr_t xring_ptr);
+
+/**********************************************************/
+/**
+ * @brief 返回 提供缓存 的 数据地址。
+ *
+ * @param [in ] xring_ptr : io_uring 工作对象。
+ * @param [in ] xut_bid   : 缓存编号（取自 CQE 的 flags >> IORING_CQE_BUFFER_SHIFT）。
+ */
+x_bptr_t xuring_buf_addr(xuring_ptr_t xring_ptr, x_uint16_t xut_bid);
+
+/**********************************************************/
+/**
+ * @brief 将使用完毕的 提供缓存 归还给内核。
+ */
+x_void_t xuring_buf_recycle(xuring_ptr_t xring_ptr, x_uint16_t xut_bid);
+
+/**********************************************************/
+/**
+ * @brief 获取 调用线程 的 io_uring 工作对象所附带的 临时缓存（供提交 SQE 时引用的参数数据）。
+ * @note  所返回的缓存，在下次调用本接口前有效，且调用方不得释放它。
+ *
+ * @param [in ] xring_ptr : io_uring 工作对象。
+ * @param [in ] xst_size  : 所需的缓存字节数。
+ *
+ * @return x_mptr_t : 成功，返回缓存地址；失败，返回 X_NULL。
+ */
+x_mptr_t xuring_scratch(xuring_ptr_t xring_ptr, x_size_t xst_size);
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __cplusplus
+}; // extern "C"
+#endif // __cplusplus
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // defined(XNTP_IO_URING) && defined(__linux__)
+
+#endif // __XURING_H__
@@ -0,0 +1,614 @@
+﻿/**
+ * @file async_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 由 宿主事件循环 驱动的 异步请求（ntpcli_async_*()）。
+ * @note
+ * 整个测试 只有 一个线程：以 select() 模拟 宿主的 事件循环，同时 驱动 本机回环地址 上的
+ * 简易服务端 与 各个 异步请求。127.0.0.1 以 领先 5 秒 的 时钟 应答，
+ * 127.0.0.2 应答 无效的 时间戳（T2、T3 为 0），127.0.0.3 收到请求 后 不应答。
+ */
+
+#include "ntp_client.h"
+#include "ntp_state.h"
+#include "xtest_server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 毫秒、1 秒 对应的 时间计量值 */
+#define XAS_MSEC        ((x_int64_t)XTIME_VNSEC_MSEC)
+#define XAS_SEC         (1000 * XAS_MSEC)
+
+/** 服务端时钟 领先 本地时钟 的 偏差 */
+#define XAS_OFFSET      (5 * XAS_SEC)
+
+/** 偏移量 允许的 误差 */
+#define XAS_TOLERANCE   (20 * XAS_MSEC)
+
+/** 测试用的 状态文件 与 域名 */
+#define XAS_FILE        "async_test.dat"
+#define XAS_HOST        "xntp.async.invalid"
+
+/** 三个 服务端 地址 */
+#define XAS_ADDR_GOOD   0x7F000001
+#define XAS_ADDR_BAD    0x7F000002
+#define XAS_ADDR_MUTE   0x7F000003
+
+/** 同时进行的 异步请求 的 最大数量 */
+#define XAS_MAX_REQS    16
+
+static x_int32_t xit_fail = 0;
+
+#define XAS_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+/**
+ * @struct xas_result_t
+ * @brief  回调函数 记录的 结果。
+ */
+typedef struct xas_result_t
+{
+    x_uint32_t    xut_calls;    ///< 回调次数
+    x_uint32_t    xut_again;    ///< 回调中 以 同一 xasync 再次发起请求 的 剩余次数
+    xntp_cliptr_t xntp_this;    ///< 再次发起请求 所用的 客户端对象
+    xtime_vnsec_t xtm_done;     ///< 最后一次 回调 的 时刻（单调时钟）
+    xntp_sample_t xsample;      ///< 最后一次 回调 的 样本
+} xas_result_t;
+
+/** 所有的 服务端 */
+static xtest_server_t xsrv_list[3];
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 127.0.0.2 的 应答：T2、T3 为 0（无效的 时间戳）。
+ */
+static x_uint32_t bad_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    (x_void_t)xbt_rbuf;
+
+    xtest_server_reply(xsrv_ptr, xview_req, xbt_sbuf);
+    ntp_store64(xbt_sbuf + XNTP_OFF_RECEIVE , 0);
+    ntp_store64(xbt_sbuf + XNTP_OFF_TRANSMIT, 0);
+
+    return XNTP_PKT_LEN;
+}
+
+/**********************************************************/
+/**
+ * @brief 127.0.0.3 的 应答：收到请求 后 不应答。
+ */
+static x_uint32_t mute_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    (x_void_t)xsrv_ptr;
+    (x_void_t)xbt_rbuf;
+    (x_void_t)xview_req;
+    (x_void_t)xbt_sbuf;
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 只驱动 各个 服务端，至多等待 xut_msec 毫秒。
+ */
+static x_void_t server_poll(x_uint32_t xut_msec)
+{
+    x_sockfd_t     xfdt_max = 0;
+    x_uint32_t     xut_iter = 0;
+    fd_set         xfds_rset;
+    struct timeval xtm_value;
+
+    FD_ZERO(&xfds_rset);
+    for (xut_iter = 0; xut_iter < 3; ++xut_iter)
+    {
+        FD_SET(xsrv_list[xut_iter].xfdt_sockfd, &xfds_rset);
+        if (xsrv_list[xut_iter].xfdt_sockfd > xfdt_max)
+            xfdt_max = xsrv_list[xut_iter].xfdt_sockfd;
+    }
+
+    xtm_value.tv_sec  = (x_long_t)(xut_msec / 1000);
+    xtm_value.tv_usec = (x_long_t)((xut_msec % 1000) * 1000);
+    if (select((x_int32_t)(xfdt_max + 1), &xfds_rset, X_NULL, X_NULL, &xtm_value) <= 0)
+        return;
+
+    for (xut_iter = 0; xut_iter < 3; ++xut_iter)
+    {
+        if (FD_ISSET(xsrv_list[xut_iter].xfdt_sockfd, &xfds_rset))
+            xtest_server_serve(&xsrv_list[xut_iter]);
+    }
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 以 select() 模拟 宿主的 事件循环，驱动 服务端 与 各个 异步请求，直至 全部结束 或 超过 xut_msec 毫秒。
+ *
+ * @return x_uint32_t : 返回 仍在进行中的 请求数量。
+ */
+static x_uint32_t loop_run(xntp_async_t * xasync_list, x_uint32_t xut_count, x_uint32_t xut_msec)
+{
+    xtime_vnsec_t  xtm_limit = time_mono() + xut_msec * XAS_MSEC;
+    xtime_vnsec_t  xtm_wake  = 0;
+    xtime_vnsec_t  xtm_dline = 0;
+    x_sockfd_t     xfdt_max  = 0;
+    x_sockfd_t     xfdt_sock = X_INVALID_SOCKFD;
+    x_uint32_t     xut_iter  = 0;
+    x_uint32_t     xut_busy  = 0;
+    x_uint32_t     xut_event = 0;
+    fd_set         xfds_rset;
+    struct timeval xtm_value;
+
+    for (;;)
+    {
+        //======================================
+        // 注册 可读事件，取 最早的 截止时间 作为 定时器
+
+        FD_ZERO(&xfds_rset);
+        xfdt_max = 0;
+        xtm_wake = xtm_limit;
+        xut_busy = 0;
+
+        for (xut_iter = 0; xut_iter < 3; ++xut_iter)
+        {
+            FD_SET(xsrv_list[xut_iter].xfdt_sockfd, &xfds_rset);
+            if (xsrv_list[xut_iter].xfdt_sockfd > xfdt_max)
+                xfdt_max = xsrv_list[xut_iter].xfdt_sockfd;
+        }
+
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+        {
+            xfdt_sock = ntpcli_async_fd(&xasync_list[xut_iter]);
+            if (X_INVALID_SOCKFD == xfdt_sock)
+                continue;
+
+            xut_busy += 1;
+            FD_SET(xfdt_sock, &xfds_rset);
+            if (xfdt_sock > xfdt_max)
+                xfdt_max = xfdt_sock;
+
+            xtm_dline = ntpcli_async_deadline(&xasync_list[xut_iter]);
+            if (XTMVNSEC_IS_VALID(xtm_dline) && (xtm_dline < xtm_wake))
+                xtm_wake = xtm_dline;
+        }
+
+        if ((0 == xut_busy) || (time_mono() >= xtm_limit))
+            break;
+
+        xtm_dline = time_mono();
+        xtm_dline = (xtm_wake > xtm_dline) ? (xtm_wake - xtm_dline) : 0;
+        xtm_value.tv_sec  = (x_long_t)(xtm_dline / XAS_SEC);
+        xtm_value.tv_usec = (x_long_t)((xtm_dline % XAS_SEC) / 10);
+
+        if (select((x_int32_t)(xfdt_max + 1), &xfds_rset, X_NULL, X_NULL, &xtm_value) < 0)
+            continue;
+
+        //======================================
+        // 分派事件
+
+        for (xut_iter = 0; xut_iter < 3; ++xut_iter)
+        {
+            if (FD_ISSET(xsrv_list[xut_iter].xfdt_sockfd, &xfds_rset))
+                xtest_server_serve(&xsrv_list[xut_iter]);
+        }
+
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+        {
+            xfdt_sock = ntpcli_async_fd(&xasync_list[xut_iter]);
+            if (X_INVALID_SOCKFD == xfdt_sock)
+                continue;
+
+            xut_event = FD_ISSET(xfdt_sock, &xfds_rset) ? XNTP_ASYNC_READ : 0;
+            xtm_dline = ntpcli_async_deadline(&xasync_list[xut_iter]);
+            if (XTMVNSEC_IS_VALID(xtm_dline) && (time_mono() >= xtm_dline))
+                xut_event |= XNTP_ASYNC_TIMER;
+
+            if (0 != xut_event)
+                ntpcli_async_process(&xasync_list[xut_iter], xut_event);
+        }
+    }
+
+    return xut_busy;
+}
+
+/**********************************************************/
+/**
+ * @brief 异步请求 的 回调函数：记录 样本，按需 以 同一 xasync 再次发起请求。
+ */
+static x_void_t async_done(xntp_asyncptr_t xasync, const xntp_sample_t * xsample, x_pvoid_t xpvt_ctx)
+{
+    xas_result_t * xres_ptr = (xas_result_t *)xpvt_ctx;
+
+    XAS_CHECK(X_INVALID_SOCKFD == ntpcli_async_fd(xasync));
+
+    xres_ptr->xut_calls += 1;
+    xres_ptr->xtm_done   = time_mono();
+    xres_ptr->xsample    = *xsample;
+
+    if (xres_ptr->xut_again > 0)
+    {
+        xres_ptr->xut_again -= 1;
+        XAS_CHECK(0 == ntpcli_async_start(xasync, xres_ptr->xntp_this,
+                                          time_mono() + XAS_SEC, async_done, xpvt_ctx));
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 成功的 样本（服务端 为 127.0.0.1）。
+ */
+static x_bool_t sample_good(const xntp_sample_t * xsample)
+{
+    x_int64_t xit_error = (x_int64_t)xsample->xtm_vnsec - ((x_int64_t)time_vnsec() + XAS_OFFSET);
+
+    return ((0 == xsample->xit_errno) &&
+            (XAS_ADDR_GOOD == xsample->xut_ipv4) &&
+            (xsample->xit_offset > XAS_OFFSET - XAS_TOLERANCE) &&
+            (xsample->xit_offset < XAS_OFFSET + XAS_TOLERANCE) &&
+            (xsample->xit_delay >= 0) && (xsample->xit_delay < XAS_TOLERANCE) &&
+            (xit_error > -100 * XAS_MSEC) && (xit_error < 100 * XAS_MSEC));
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 状态文件：XAS_HOST 的 地址缓存。
+ */
+static x_void_t state_write(const x_uint32_t * xut_addrs, x_uint32_t xut_naddr)
+{
+    xntp_state_t xstate;
+
+    memset(&xstate, 0, sizeof(xntp_state_t));
+    xstate.xtm_saved  = time_vnsec();
+    strcpy(xstate.xszt_host, XAS_HOST);
+    xstate.xut_port   = xsrv_list[0].xut_port;
+    xstate.xut_naddr  = xut_naddr;
+    memcpy(xstate.xut_addrs, xut_addrs, xut_naddr * sizeof(x_uint32_t));
+    xstate.xtm_expire = xstate.xtm_saved + 3600 * XAS_SEC;
+
+    XAS_CHECK(0 == ntpstate_save(XAS_FILE, &xstate));
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 校验 参数、单个请求 与 在 回调中 再次发起请求。
+ */
+static x_void_t check_basic(xntp_cliptr_t xntp_this)
+{
+    xntp_async_t  xasync;
+    xas_result_t  xresult;
+    xtime_vnsec_t xtm_start = 0;
+
+    memset(&xasync, 0, sizeof(xntp_async_t));
+    memset(&xresult, 0, sizeof(xas_result_t));
+
+    XAS_CHECK(EINVAL == ntpcli_async_start(X_NULL, xntp_this, XTIME_INVALID_VNSEC, async_done, &xresult));
+    XAS_CHECK(EINVAL == ntpcli_async_start(&xasync, X_NULL, XTIME_INVALID_VNSEC, async_done, &xresult));
+    XAS_CHECK(EINVAL == ntpcli_async_start(&xasync, xntp_this, XTIME_INVALID_VNSEC, X_NULL, &xresult));
+    XAS_CHECK(EINVAL == ntpcli_async_process(X_NULL, XNTP_ASYNC_READ));
+    XAS_CHECK(0 == ntpcli_async_process(&xasync, XNTP_ASYNC_READ));
+    XAS_CHECK(X_INVALID_SOCKFD == ntpcli_async_fd(&xasync));
+    XAS_CHECK(!XTMVNSEC_IS_VALID(ntpcli_async_deadline(&xasync)));
+    ntpcli_async_close(&xasync);
+
+    //======================================
+    // 单个请求
+
+    XAS_CHECK(0 == ntpcli_config(xntp_this, "127.0.0.1", xsrv_list[0].xut_port));
+    XAS_CHECK(EINVAL == ntpcli_resolve_host(X_NULL));
+    XAS_CHECK(0 == ntpcli_resolve_host(xntp_this));
+
+    xtm_start = time_mono();
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, xtm_start + XAS_SEC, async_done, &xresult));
+    XAS_CHECK(X_INVALID_SOCKFD != ntpcli_async_fd(&xasync));
+    XAS_CHECK(xtm_start + XAS_SEC == ntpcli_async_deadline(&xasync));
+    XAS_CHECK(EBUSY == ntpcli_async_start(&xasync, xntp_this, XTIME_INVALID_VNSEC, async_done, &xresult));
+
+    // 没有 事件 时，请求 仍在进行中
+    XAS_CHECK(EINPROGRESS == ntpcli_async_process(&xasync, 0));
+    XAS_CHECK(0 == xresult.xut_calls);
+
+    XAS_CHECK(0 == loop_run(&xasync, 1, 2000));
+    XAS_CHECK(1 == xresult.xut_calls);
+    XAS_CHECK(sample_good(&xresult.xsample));
+    XAS_CHECK((xresult.xsample.xut_port == xsrv_list[0].xut_port) && (0 == xresult.xsample.xut_leap));
+    XAS_CHECK(0 == ntpcli_async_process(&xasync, XNTP_ASYNC_READ | XNTP_ASYNC_TIMER));
+    XAS_CHECK(1 == xresult.xut_calls);
+
+    printf("single request : offset %lld us, delay %lld us, elapsed %lld us\n",
+           (long long)(xresult.xsample.xit_offset - XAS_OFFSET) / 10,
+           (long long)xresult.xsample.xit_delay / 10,
+           (long long)(xresult.xtm_done - xtm_start) / 10);
+
+    //======================================
+    // 在 回调中 以 同一 xasync 再次发起请求（无限等待）
+
+    memset(&xresult, 0, sizeof(xas_result_t));
+    xresult.xut_again = 3;
+    xresult.xntp_this = xntp_this;
+
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, XTIME_INVALID_VNSEC, async_done, &xresult));
+    XAS_CHECK(!XTMVNSEC_IS_VALID(ntpcli_async_deadline(&xasync)));
+    XAS_CHECK(0 == loop_run(&xasync, 1, 2000));
+    XAS_CHECK((4 == xresult.xut_calls) && sample_good(&xresult.xsample));
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 多个 异步请求 同时进行（超出 工作通道 的 部分 借用 对象池 的 对象）。
+ */
+static x_void_t check_many(xntp_cliptr_t xntp_this)
+{
+    xntp_async_t  xasync_list[XAS_MAX_REQS];
+    xas_result_t  xresult_list[XAS_MAX_REQS];
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_jter  = 0;
+    x_uint32_t    xut_good  = 0;
+    x_uint32_t    xut_recvd = xsrv_list[0].xut_recvd;
+
+    memset(xasync_list, 0, sizeof(xasync_list));
+    memset(xresult_list, 0, sizeof(xresult_list));
+
+    XAS_CHECK(0 == ntpcli_config(xntp_this, "127.0.0.1", xsrv_list[0].xut_port));
+
+    for (xut_iter = 0; xut_iter < XAS_MAX_REQS; ++xut_iter)
+    {
+        XAS_CHECK(0 == ntpcli_async_start(&xasync_list[xut_iter], xntp_this,
+                                          time_mono() + 2 * XAS_SEC, async_done, &xresult_list[xut_iter]));
+    }
+
+    // 各个请求 占用 不同的 套接字
+    for (xut_iter = 0; xut_iter < XAS_MAX_REQS; ++xut_iter)
+    {
+        for (xut_jter = xut_iter + 1; xut_jter < XAS_MAX_REQS; ++xut_jter)
+        {
+            XAS_CHECK(ntpcli_async_fd(&xasync_list[xut_iter]) != ntpcli_async_fd(&xasync_list[xut_jter]));
+        }
+    }
+
+    XAS_CHECK(0 == loop_run(xasync_list, XAS_MAX_REQS, 3000));
+
+    for (xut_iter = 0; xut_iter < XAS_MAX_REQS; ++xut_iter)
+    {
+        if ((1 == xresult_list[xut_iter].xut_calls) && sample_good(&xresult_list[xut_iter].xsample))
+            xut_good += 1;
+    }
+
+    printf("concurrent requests : %u / %u good\n", xut_good, XAS_MAX_REQS);
+    XAS_CHECK(XAS_MAX_REQS == xut_good);
+    XAS_CHECK(XAS_MAX_REQS == xsrv_list[0].xut_recvd - xut_recvd);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 超时 与 取消。
+ */
+static x_void_t check_timeout(xntp_cliptr_t xntp_this)
+{
+    xntp_async_t  xasync;
+    xas_result_t  xresult;
+    xtime_vnsec_t xtm_start = 0;
+    x_uint32_t    xut_recvd = 0;
+    x_uint32_t    xut_iter  = 0;
+
+    memset(&xasync, 0, sizeof(xntp_async_t));
+    memset(&xresult, 0, sizeof(xas_result_t));
+
+    //======================================
+    // 不应答的 服务端：截止时间 到 后 以 ETIMEDOUT 回调
+
+    XAS_CHECK(0 == ntpcli_config(xntp_this, "127.0.0.3", xsrv_list[0].xut_port));
+
+    xtm_start = time_mono();
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, xtm_start + 200 * XAS_MSEC, async_done, &xresult));
+    XAS_CHECK(0 == loop_run(&xasync, 1, 2000));
+    XAS_CHECK((1 == xresult.xut_calls) && (ETIMEDOUT == xresult.xsample.xit_errno));
+    XAS_CHECK(XAS_ADDR_MUTE == xresult.xsample.xut_ipv4);
+    XAS_CHECK(!XTMVNSEC_IS_VALID(xresult.xsample.xtm_vnsec));
+    XAS_CHECK((xresult.xtm_done - xtm_start >= (xtime_vnsec_t)(200 * XAS_MSEC)) &&
+              (xresult.xtm_done - xtm_start <  (xtime_vnsec_t)(400 * XAS_MSEC)));
+
+    printf("timeout : elapsed %lld ms (deadline 200 ms)\n",
+           (long long)(xresult.xtm_done - xtm_start) / XAS_MSEC);
+
+    //======================================
+    // 取消：不再回调；其 迟到的 应答 不影响 之后的 请求
+
+    memset(&xresult, 0, sizeof(xas_result_t));
+    XAS_CHECK(0 == ntpcli_config(xntp_this, "127.0.0.1", xsrv_list[0].xut_port));
+
+    xut_recvd = xsrv_list[0].xut_recvd;
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, time_mono() + XAS_SEC, async_done, &xresult));
+    ntpcli_async_close(&xasync);
+    XAS_CHECK(X_INVALID_SOCKFD == ntpcli_async_fd(&xasync));
+    XAS_CHECK(0 == ntpcli_async_process(&xasync, XNTP_ASYNC_READ | XNTP_ASYNC_TIMER));
+    ntpcli_async_close(&xasync);
+
+    // 只驱动 服务端，使 应答 留在 客户端 的 套接字缓存 中
+    for (xut_iter = 0; (xut_iter < 100) && (xsrv_list[0].xut_recvd == xut_recvd); ++xut_iter)
+    {
+        server_poll(10);
+    }
+    XAS_CHECK((1 == xsrv_list[0].xut_recvd - xut_recvd) && (0 == xresult.xut_calls));
+
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, time_mono() + XAS_SEC, async_done, &xresult));
+    XAS_CHECK(0 == loop_run(&xasync, 1, 2000));
+    XAS_CHECK((1 == xresult.xut_calls) && sample_good(&xresult.xsample));
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 域名 的 地址缓存：失败的 地址 之后 改为 请求 下一个地址，成功的 地址 移到 缓存首位。
+ */
+static x_void_t check_cache(void)
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+    xntp_async_t  xasync;
+    xas_result_t  xresult;
+    x_uint32_t    xut_recvd = 0;
+    x_uint32_t    xut_addrs[2] = { XAS_ADDR_BAD, XAS_ADDR_GOOD };
+    xntp_state_t  xstate;
+
+    memset(&xasync, 0, sizeof(xntp_async_t));
+    memset(&xresult, 0, sizeof(xas_result_t));
+
+    //======================================
+
+    state_write(xut_addrs, 2);
+
+    xntp_this = ntpcli_open();
+    XAS_CHECK(X_NULL != xntp_this);
+    if (X_NULL == xntp_this)
+        return;
+
+    XAS_CHECK(0 == ntpcli_config(xntp_this, XAS_HOST, xsrv_list[0].xut_port));
+    XAS_CHECK(0 == ntpcli_state(xntp_this, XAS_FILE));
+
+    // 127.0.0.2 的 应答 无效（ETIME），随即 改为 请求 127.0.0.1
+    xut_recvd = xsrv_list[1].xut_recvd;
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, time_mono() + XAS_SEC, async_done, &xresult));
+    XAS_CHECK(0 == loop_run(&xasync, 1, 2000));
+    XAS_CHECK((1 == xresult.xut_calls) && sample_good(&xresult.xsample));
+    XAS_CHECK(1 == xsrv_list[1].xut_recvd - xut_recvd);
+
+    // 127.0.0.1 已 移到 缓存首位
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, time_mono() + XAS_SEC, async_done, &xresult));
+    XAS_CHECK(0 == loop_run(&xasync, 1, 2000));
+    XAS_CHECK((2 == xresult.xut_calls) && sample_good(&xresult.xsample));
+    XAS_CHECK(1 == xsrv_list[1].xut_recvd - xut_recvd);
+
+    // 异步请求 不写 状态文件，ntpcli_state_flush() 写入 调整后的 地址缓存
+    memset(&xstate, 0, sizeof(xntp_state_t));
+    XAS_CHECK((0 == ntpstate_load(XAS_FILE, &xstate)) && (XAS_ADDR_BAD == xstate.xut_addrs[0]));
+    XAS_CHECK(0 == ntpcli_state_flush(xntp_this));
+    memset(&xstate, 0, sizeof(xntp_state_t));
+    XAS_CHECK((0 == ntpstate_load(XAS_FILE, &xstate)) && (XAS_ADDR_GOOD == xstate.xut_addrs[0]));
+
+    ntpcli_close(xntp_this);
+
+    //======================================
+    // 缓存的 地址 全部失败：回调 最后的 错误码，并 清除 缓存（随后 不解析 域名，返回 EAGAIN）
+
+    xut_addrs[0] = XAS_ADDR_BAD;
+    state_write(xut_addrs, 1);
+
+    xntp_this = ntpcli_open();
+    XAS_CHECK(X_NULL != xntp_this);
+    if (X_NULL == xntp_this)
+        return;
+
+    XAS_CHECK(0 == ntpcli_config(xntp_this, XAS_HOST, xsrv_list[0].xut_port));
+    XAS_CHECK(0 == ntpcli_state(xntp_this, XAS_FILE));
+
+    memset(&xresult, 0, sizeof(xas_result_t));
+    XAS_CHECK(0 == ntpcli_async_start(&xasync, xntp_this, time_mono() + XAS_SEC, async_done, &xresult));
+    XAS_CHECK(0 == loop_run(&xasync, 1, 2000));
+    XAS_CHECK((1 == xresult.xut_calls) && (ETIME == xresult.xsample.xit_errno));
+    XAS_CHECK(XAS_ADDR_BAD == xresult.xsample.xut_ipv4);
+
+    XAS_CHECK(EAGAIN == ntpcli_async_start(&xasync, xntp_this, time_mono() + XAS_SEC, async_done, &xresult));
+    XAS_CHECK((1 == xresult.xut_calls) && (X_INVALID_SOCKFD == ntpcli_async_fd(&xasync)));
+
+    // 由 宿主 在 事件循环 之外 解析（此 域名 不可解析）
+    XAS_CHECK(0 != ntpcli_resolve_host(xntp_this));
+    XAS_CHECK(EAGAIN == ntpcli_async_start(&xasync, xntp_this, time_mono() + XAS_SEC, async_done, &xresult));
+
+    ntpcli_close(xntp_this);
+    remove(XAS_FILE);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+    x_uint32_t    xut_iter  = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA       xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    (x_void_t)argc;
+    (x_void_t)argv;
+
+    //======================================
+    // 三个 服务端 使用 同一端口
+
+    memset(xsrv_list, 0, sizeof(xsrv_list));
+    xsrv_list[0].xut_ipv4    = XAS_ADDR_GOOD;
+    xsrv_list[1].xut_ipv4    = XAS_ADDR_BAD;
+    xsrv_list[1].xfunc_reply = bad_reply;
+    xsrv_list[2].xut_ipv4    = XAS_ADDR_MUTE;
+    xsrv_list[2].xfunc_reply = mute_reply;
+
+    for (xut_iter = 0; xut_iter < 3; ++xut_iter)
+    {
+        xsrv_list[xut_iter].xit_offset = XAS_OFFSET;
+        xsrv_list[xut_iter].xut_port   = xsrv_list[0].xut_port;
+        if (0 != xtest_server_open(&xsrv_list[xut_iter]))
+        {
+            printf("xtest_server_open() failed, errno : %d\n", errno);
+            while (xut_iter-- > 0)
+                xtest_sockfd_close(xsrv_list[xut_iter].xfdt_sockfd);
+            return 1;
+        }
+    }
+
+    //======================================
+
+    xntp_this = ntpcli_open();
+    XAS_CHECK(X_NULL != xntp_this);
+    if (X_NULL != xntp_this)
+    {
+        check_basic(xntp_this);
+        check_many(xntp_this);
+        check_timeout(xntp_this);
+        ntpcli_close(xntp_this);
+    }
+
+    check_cache();
+
+    //======================================
+
+    for (xut_iter = 0; xut_iter < 3; ++xut_iter)
+        xtest_sockfd_close(xsrv_list[xut_iter].xfdt_sockfd);
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    return (0 == xit_fail) ? 0 : 1;
+}
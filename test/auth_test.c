@@ -0,0 +1,412 @@
+﻿/**
+ * @file auth_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 对称密钥认证（MD5、SHA1、AES-128-CMAC）请求 的程序。
+ * @note
+ * 程序在本机回环地址上 启动一个 简易的 NTP 服务端线程（与客户端 共用密钥），
+ * 先校验 各认证算法 及 失败情况 的结果，再对比 认证 与 非认证 的批量请求耗时。
+ */
+
+#include "ntp_client.h"
+#include "ntp_auth.h"
+#include "xtest_server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 批量请求 的最大请求项数量 */
+#define XAUTH_BATCH_MAX  1024
+
+/** 计时的 轮数（取 中位数；另有 一轮 预热 不计入） */
+#define XAUTH_PASSES     5
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 服务端 的 应答：校验请求的 MAC，并以 同一 key ID 签名应答（xpvt_ctx 为 服务端的 密钥表）；
+ *        校验失败时，回复 crypto-NAK（key ID 为 0，无摘要 的 MAC）。
+ */
+static x_uint32_t mac_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    xntp_keyptr_t xkey_table = (xntp_keyptr_t)xsrv_ptr->xpvt_ctx;
+    x_uint32_t    xut_slen   = xtest_server_reply(xsrv_ptr, xview_req, xbt_sbuf);
+    x_uint32_t    xut_mlen   = 0;
+    x_uint32_t    xut_keyid  = 0;
+
+    if (ntpv_has_mac(xview_req))
+    {
+        xut_keyid = ntpv_keyid(xview_req);
+        if ((0 == ntpkey_verify(xkey_table,
+                                xut_keyid,
+                                xbt_rbuf,
+                                xview_req->xut_mpos,
+                                ntpv_digest(xview_req),
+                                ntpv_digest_len(xview_req))) &&
+            (0 == ntpkey_sign(xkey_table, xut_keyid, xbt_sbuf, XNTP_PKT_LEN, &xut_mlen)))
+        {
+            xut_slen += xut_mlen;
+        }
+        else
+        {
+            ntp_store32(xbt_sbuf + XNTP_PKT_LEN, 0);
+            xut_slen += XNTP_MAC_KEYID;
+        }
+    }
+
+    return xut_slen;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 以批量请求 向 测试服务端 发送 xut_count 个请求（使用相同的 key ID）。
+ *
+ * @return x_uint32_t : 返回 结果 与 期望错误码 相符 的请求项数量。
+ */
+static x_uint32_t auth_sweep(
+                    xntp_cliptr_t xntp_this,
+                    xntp_sweep_t * xsw_list,
+                    x_uint32_t xut_count,
+                    x_uint16_t xut_port,
+                    x_uint32_t xut_keyid,
+                    x_int32_t xit_expect)
+{
+    x_uint32_t xut_iter = 0;
+    x_uint32_t xut_okay = 0;
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        memset(&xsw_list[xut_iter], 0, sizeof(xntp_sweep_t));
+        xsw_list[xut_iter].xut_ipv4  = 0x7F000001;
+        xsw_list[xut_iter].xut_port  = xut_port;
+        xsw_list[xut_iter].xut_keyid = xut_keyid;
+    }
+
+    if (0 != ntpcli_req_sweep(xntp_this, xsw_list, xut_count, time_mono() + 3000 * XTIME_VNSEC_MSEC))
+        return 0;
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        if ((xit_expect == xsw_list[xut_iter].xit_errno) &&
+            ((0 != xit_expect) || (xut_keyid == xsw_list[xut_iter].xut_mackey)))
+        {
+            xut_okay += 1;
+        }
+    }
+
+    return xut_okay;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回 各轮 耗时 的 中位数（会 重排 xtm_list）。
+ */
+static xtime_vnsec_t auth_median(xtime_vnsec_t * xtm_list, x_uint32_t xut_count)
+{
+    x_uint32_t    xut_iter = 0;
+    x_uint32_t    xut_ipos = 0;
+    xtime_vnsec_t xtm_temp = 0;
+
+    for (xut_iter = 1; xut_iter < xut_count; ++xut_iter)
+    {
+        xtm_temp = xtm_list[xut_iter];
+        for (xut_ipos = xut_iter; (xut_ipos > 0) && (xtm_list[xut_ipos - 1] > xtm_temp); --xut_ipos)
+        {
+            xtm_list[xut_ipos] = xtm_list[xut_ipos - 1];
+        }
+        xtm_list[xut_ipos] = xtm_temp;
+    }
+
+    return xtm_list[xut_count / 2];
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-n <rounds>] [-b <batch>] [-k <keyfile> <keyid>]\n", xszt_app);
+    printf("\t-n <rounds>          The rounds of bulk polling of each algorithm, default 200.\n");
+    printf("\t-b <batch>           The number of requests of each round, default 64.\n");
+    printf("\t-k <keyfile> <keyid> Also check the key <keyid> loaded from an ntp.keys file.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t      xit_iter   = 0;
+    x_uint32_t     xut_iter   = 0;
+    x_uint32_t     xut_rounds = 200;
+    x_uint32_t     xut_batch  = 64;
+    x_cstring_t    xszt_kfile = X_NULL;
+    x_uint32_t     xut_kfid   = 0;
+    x_uint32_t     xut_okay   = 0;
+    x_int32_t      xit_fail   = 0;
+    x_int32_t      xit_errno  = 0;
+    xntp_cliptr_t  xntp_this  = X_NULL;
+    xntp_keyptr_t  xkey_cli   = X_NULL;
+    xntp_keyptr_t  xkey_srv   = X_NULL;
+    xntp_sweep_t * xsw_list   = X_NULL;
+    x_uint32_t     xut_pass   = 0;
+    x_uint32_t     xut_total[4] = { 0, 0, 0, 0 };
+    xtime_vnsec_t  xtm_start  = 0;
+    xtime_vnsec_t  xtm_spent[4][XAUTH_PASSES];
+    xtime_vnsec_t  xtm_median[4];
+    xtime_vnsec_t  xtm_value  = XTIME_INVALID_VNSEC;
+
+    static const x_cstring_t XAUTH_NAME[4] = { "none", "MD5", "SHA1", "AES-CMAC" };
+
+    xtest_server_t xauth_srv;
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA        xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    memset(&xauth_srv, 0, sizeof(xtest_server_t));
+    xauth_srv.xfdt_sockfd = X_INVALID_SOCKFD;
+
+    //======================================
+
+    do
+    {
+        //======================================
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-n", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_rounds = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-b", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_batch = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-k", argv[xit_iter])) && ((xit_iter + 2) < argc))
+            {
+                xszt_kfile = argv[++xit_iter];
+                xut_kfid   = (x_uint32_t)atoi(argv[++xit_iter]);
+            }
+            else
+            {
+                usage(argv[0]);
+                return 0;
+            }
+        }
+
+        if ((0 == xut_rounds) || (0 == xut_batch) || (xut_batch > XAUTH_BATCH_MAX))
+        {
+            usage(argv[0]);
+            break;
+        }
+
+        //======================================
+        // 服务端 与 客户端 的密钥表：key ID 1 ~ 3 两端相同，key ID 4 仅客户端持有
+
+        xkey_srv = ntpkey_create();
+        xkey_cli = ntpkey_create();
+        if ((X_NULL == xkey_srv) || (X_NULL == xkey_cli))
+        {
+            printf("ntpkey_create() return X_NULL\n");
+            xit_fail += 1;
+            break;
+        }
+
+        for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+        {
+            xntp_keyptr_t xkey_table = (0 == xut_iter) ? xkey_srv : xkey_cli;
+
+            xit_errno = ntpkey_add(xkey_table, 1, ntp_auth_md5 , (const x_uchar_t *)"md5-secret", 10);
+            if (0 == xit_errno)
+                xit_errno = ntpkey_add(xkey_table, 2, ntp_auth_sha1, (const x_uchar_t *)"sha1-secret", 11);
+            if (0 == xit_errno)
+                xit_errno = ntpkey_add(xkey_table, 3, ntp_auth_cmac, (const x_uchar_t *)"0123456789abcdef", 16);
+            if (0 != xit_errno)
+                break;
+        }
+
+        if (0 == xit_errno)
+            xit_errno = ntpkey_add(xkey_cli, 4, ntp_auth_sha1, (const x_uchar_t *)"client-only", 11);
+
+        if (0 != xit_errno)
+        {
+            printf("ntpkey_add() return %d, authentication is unavailable in this build\n", xit_errno);
+            break;
+        }
+
+        if ((X_NULL != xszt_kfile) && (0 != (xit_errno = ntpkey_load(xkey_srv, xszt_kfile))))
+        {
+            printf("ntpkey_load(%s) return %d\n", xszt_kfile, xit_errno);
+            xit_fail += 1;
+            break;
+        }
+
+        if ((X_NULL != xszt_kfile) && (0 != (xit_errno = ntpkey_load(xkey_cli, xszt_kfile))))
+        {
+            printf("ntpkey_load(%s) return %d\n", xszt_kfile, xit_errno);
+            xit_fail += 1;
+            break;
+        }
+
+        //======================================
+
+        xauth_srv.xfunc_reply = mac_reply;
+        xauth_srv.xpvt_ctx    = xkey_srv;
+        if (0 != xtest_server_start(&xauth_srv))
+        {
+            printf("xtest_server_start() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+        xsw_list  = (xntp_sweep_t *)calloc(XAUTH_BATCH_MAX, sizeof(xntp_sweep_t));
+        xntp_this = ntpcli_open();
+        if ((X_NULL == xsw_list) || (X_NULL == xntp_this))
+        {
+            printf("ntpcli_open() or calloc() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+        //======================================
+        // 正确性校验
+
+#define XAUTH_CHECK(xcond)                                            \
+        do                                                            \
+        {                                                             \
+            if (!(xcond))                                             \
+            {                                                         \
+                printf("check failed at line %d : %s\n",              \
+                       __LINE__, #xcond);                             \
+                xit_fail += 1;                                        \
+            }                                                         \
+        } while (0)
+
+        ntpcli_config(xntp_this, "127.0.0.1", xauth_srv.xut_port);
+
+        XAUTH_CHECK(ENOENT == ntpcli_auth(xntp_this, xkey_cli, 9));
+        XAUTH_CHECK(0 == ntpcli_auth(xntp_this, xkey_cli, 0));
+
+        for (xut_iter = 0; xut_iter <= 3; ++xut_iter)
+        {
+            XAUTH_CHECK(xut_batch == auth_sweep(xntp_this, xsw_list, xut_batch, xauth_srv.xut_port, xut_iter, 0));
+        }
+
+        // 服务端不持有的 key ID：应答为 crypto-NAK
+        XAUTH_CHECK(xut_batch == auth_sweep(xntp_this, xsw_list, xut_batch, xauth_srv.xut_port, 4, EACCES));
+
+        // 客户端不持有的 key ID：不发送请求
+        XAUTH_CHECK(xut_batch == auth_sweep(xntp_this, xsw_list, xut_batch, xauth_srv.xut_port, 9, ENOENT));
+
+        // 单次请求
+        XAUTH_CHECK(0 == ntpcli_auth(xntp_this, xkey_cli, 3));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        XAUTH_CHECK(XTMVNSEC_IS_VALID(xtm_value));
+
+        XAUTH_CHECK(0 == ntpcli_auth(xntp_this, xkey_cli, 4));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        XAUTH_CHECK(!XTMVNSEC_IS_VALID(xtm_value));
+
+        if (X_NULL != xszt_kfile)
+        {
+            XAUTH_CHECK(xut_batch == auth_sweep(xntp_this, xsw_list, xut_batch, xauth_srv.xut_port, xut_kfid, 0));
+        }
+
+#undef XAUTH_CHECK
+
+        printf("checks : %s\n", (0 == xit_fail) ? "passed" : "FAILED");
+        if (0 != xit_fail)
+            break;
+
+        //======================================
+        // 批量请求的耗时：认证 与 非认证 对比（只输出，不作为 校验 条件；
+        // 各算法 交替计时 XAUTH_PASSES 轮，取 中位数，此前 先 预热 一轮）
+
+        for (xut_pass = 0; xut_pass <= XAUTH_PASSES; ++xut_pass)
+        {
+            for (xut_iter = 0; xut_iter <= 3; ++xut_iter)
+            {
+                x_uint32_t xut_round = 0;
+
+                xut_okay  = 0;
+                xtm_start = time_mono();
+                for (xut_round = 0; xut_round < xut_rounds; ++xut_round)
+                {
+                    xut_okay += auth_sweep(xntp_this, xsw_list, xut_batch, xauth_srv.xut_port, xut_iter, 0);
+                }
+
+                if (0 == xut_pass)
+                    continue;
+
+                xtm_spent[xut_iter][xut_pass - 1] = time_mono() - xtm_start;
+                xut_total[xut_iter] += xut_okay;
+            }
+        }
+
+        for (xut_iter = 0; xut_iter <= 3; ++xut_iter)
+        {
+            xtm_median[xut_iter] = auth_median(xtm_spent[xut_iter], XAUTH_PASSES);
+        }
+
+        for (xut_iter = 0; xut_iter <= 3; ++xut_iter)
+        {
+            printf("%-8s : %u/%u replies, median %llu us per %u rounds, %.2f us/req, ratio %.2f\n",
+                   XAUTH_NAME[xut_iter],
+                   xut_total[xut_iter],
+                   XAUTH_PASSES * xut_rounds * xut_batch,
+                   xtm_median[xut_iter] / 10ULL,
+                   xut_rounds,
+                   xtm_median[xut_iter] / (10.0 * xut_rounds * xut_batch),
+                   (0 == xtm_median[0]) ? 0.0 : (xtm_median[xut_iter] / (double)xtm_median[0]));
+        }
+
+        //======================================
+    } while (0);
+
+    if (X_INVALID_SOCKFD != xauth_srv.xfdt_sockfd)
+    {
+        xtest_server_stop(&xauth_srv);
+    }
+
+    if (X_NULL != xntp_this)
+    {
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+    }
+
+    if (X_NULL != xsw_list)
+    {
+        free(xsw_list);
+        xsw_list = X_NULL;
+    }
+
+    ntpkey_destroy(xkey_cli);
+    ntpkey_destroy(xkey_srv);
+
+    //======================================
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    return (0 == xit_fail) ? 0 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,585 @@
+﻿/**
+ * @file bcast_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 广播/组播 客户端（ntpbc_*）的程序。
+ * @note
+ * 程序在本机回环接口上 启动一个 简易的 组播服务端线程：周期发送 广播模式 的报文（每个报文 重复发送两次，
+ * 时间戳 比本地时钟 快 XBC_OFFSET），并 应答 客户端模式 的 校准请求；
+ * 多个 接收线程 同时 监听 同一组播组，校验 偏差、校准次数、重复报文、认证 等情况。
+ */
+
+#include "ntp_bcast.h"
+#include "xtest_server.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <WS2tcpip.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 测试所用的 组播组 */
+#define XBC_GROUP       "239.255.123.45"
+
+/** 服务端时钟 相对于 本地时钟 的 偏差（100 纳秒） */
+#define XBC_OFFSET      ((x_int64_t)(2500 * XTIME_VNSEC_MSEC))
+
+/** 接收结果 的 偏差 允许误差（100 纳秒） */
+#define XBC_TOLERANCE   ((x_int64_t)(20 * XTIME_VNSEC_MSEC))
+
+/** 服务端 发送 广播报文 的 周期（毫秒） */
+#define XBC_PERIOD      10
+
+/** 接收线程 的 最大数量 */
+#define XBC_RECV_MAX    64
+
+/**
+ * @struct xbc_server_t
+ * @brief  简易 组播服务端（测试用）的 工作参数。
+ */
+typedef struct xbc_server_t
+{
+    xtest_server_t      xsrv_base;  ///< 简易服务端（绑定 127.0.0.1 的随机端口，xut_recvd 为 收到的 校准请求 数量）
+    x_uint16_t          xut_gport;  ///< 组播组 的 端口号
+    xntp_keyptr_t       xkey_table; ///< 服务端的 密钥表
+    x_uint32_t          xut_keyid;  ///< 广播报文 签名 所用的 key ID
+    volatile x_uint32_t xut_sent;   ///< 发送的 广播报文 数量（不含 重复的）
+} xbc_server_t;
+
+/**
+ * @struct xbc_worker_t
+ * @brief  接收线程 的 工作参数 与 结果。
+ */
+typedef struct xbc_worker_t
+{
+    xntp_bcastptr_t   xbc_this;    ///< 广播/组播 客户端
+    x_uint32_t        xut_count;   ///< 接收次数
+    x_uint32_t        xut_okay;    ///< 偏差 在允许误差 之内的 次数
+    x_int32_t         xit_errno;   ///< 首个 失败的 错误码
+    x_int64_t         xit_maxerr;  ///< 偏差 的 最大误差（100 纳秒）
+    xntp_bcast_stat_t xstat;       ///< 结束时的 统计信息
+} xbc_worker_t;
+
+/**********************************************************/
+/**
+ * @brief 取得 一个 空闲的 UDP 端口号（绑定 随机端口 后 立即关闭）。
+ */
+static x_uint16_t free_port(x_void_t)
+{
+    x_sockfd_t         xfdt_sockfd = X_INVALID_SOCKFD;
+    x_uint16_t         xut_port = 0;
+    struct sockaddr_in xaddr_host;
+#if defined(_WIN32) || defined(_WIN64)
+    x_int32_t          xit_alen = sizeof(struct sockaddr_in);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = sizeof(struct sockaddr_in);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    xfdt_sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (X_INVALID_SOCKFD == xfdt_sockfd)
+        return 0;
+
+    memset(&xaddr_host, 0, sizeof(struct sockaddr_in));
+    xaddr_host.sin_family = AF_INET;
+    if ((0 == bind(xfdt_sockfd, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in))) &&
+        (0 == getsockname(xfdt_sockfd, (struct sockaddr *)&xaddr_host, &xit_alen)))
+    {
+        xut_port = ntohs(xaddr_host.sin_port);
+    }
+
+    xtest_sockfd_close(xfdt_sockfd);
+
+    return xut_port;
+}
+
+/**********************************************************/
+/**
+ * @brief 构建 服务端 的 报文（广播模式 或 服务器模式），并以 xut_keyid 签名（取 0 时 不签名）。
+ *
+ * @return x_uint32_t : 返回 报文长度。
+ */
+static x_uint32_t server_pack(
+                    xbc_server_t * xsrv_ptr,
+                    x_uchar_t * xbt_pack,
+                    x_uint32_t xut_mode,
+                    x_uint64_t xut_orig,
+                    x_uint64_t xut_recv,
+                    x_uint32_t xut_keyid)
+{
+    x_uint32_t xut_mlen  = 0;
+    x_uint64_t xut_stamp = xtest_server_stamp(&xsrv_ptr->xsrv_base);
+
+    ntp_req_init(xbt_pack);
+    xbt_pack[XNTP_OFF_LVM    ] = XNTP_LI_VN_MODE(0, 4, xut_mode);
+    xbt_pack[XNTP_OFF_STRATUM] = 2;
+    xbt_pack[XNTP_OFF_POLL   ] = 6;
+    ntp_store64(xbt_pack + XNTP_OFF_ORIGINATE, xut_orig);
+    ntp_store64(xbt_pack + XNTP_OFF_RECEIVE  , (0 != xut_recv) ? xut_recv : xut_stamp);
+    ntp_store64(xbt_pack + XNTP_OFF_TRANSMIT , xut_stamp);
+
+    if ((0 != xut_keyid) && (0 == ntpkey_sign(xsrv_ptr->xkey_table, xut_keyid, xbt_pack, XNTP_PKT_LEN, &xut_mlen)))
+        return XNTP_PKT_LEN + xut_mlen;
+
+    return XNTP_PKT_LEN;
+}
+
+/**********************************************************/
+/**
+ * @brief 服务端 的 周期回调：向 组播组 发送 一个 广播报文（重复两次，第二次 应被 接收方 当作 重复报文 丢弃）。
+ */
+static x_void_t bcast_tick(xtest_server_t * xsrv_ptr)
+{
+    xbc_server_t     * xbc_ptr  = (xbc_server_t *)xsrv_ptr->xpvt_ctx;
+    x_uint32_t         xut_slen = 0;
+    x_uchar_t          xbt_sbuf[XNTP_PKT_LEN + XNTP_MAC_MAX];
+    struct sockaddr_in xaddr_group;
+
+    memset(&xaddr_group, 0, sizeof(struct sockaddr_in));
+    xaddr_group.sin_family = AF_INET;
+    xaddr_group.sin_port   = htons(xbc_ptr->xut_gport);
+    inet_pton(AF_INET, XBC_GROUP, &xaddr_group.sin_addr);
+
+    xut_slen = server_pack(xbc_ptr, xbt_sbuf, ntp_mode_broadcast, 0, 0, xbc_ptr->xut_keyid);
+    sendto(xsrv_ptr->xfdt_sockfd, (const x_char_t *)xbt_sbuf, xut_slen, 0,
+           (struct sockaddr *)&xaddr_group, sizeof(struct sockaddr_in));
+    sendto(xsrv_ptr->xfdt_sockfd, (const x_char_t *)xbt_sbuf, xut_slen, 0,
+           (struct sockaddr *)&xaddr_group, sizeof(struct sockaddr_in));
+
+    xbc_ptr->xut_sent += 1;
+}
+
+/**********************************************************/
+/**
+ * @brief 服务端 的 应答：只 应答 客户端模式 的 校准请求（请求 带 MAC 时，以 同一 key ID 签名）。
+ */
+static x_uint32_t bcast_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    (x_void_t)xbt_rbuf;
+
+    if (ntp_mode_client != ntpv_mode(xview_req))
+        return 0;
+
+    return server_pack((xbc_server_t *)xsrv_ptr->xpvt_ctx,
+                       xbt_sbuf,
+                       ntp_mode_server,
+                       ntpv_transmit(xview_req),
+                       0,
+                       ntpv_has_mac(xview_req) ? ntpv_keyid(xview_req) : 0);
+}
+
+/**********************************************************/
+/**
+ * @brief 建立 服务端套接字（绑定 127.0.0.1 的随机端口，组播 经由 回环接口 发送）。
+ */
+static x_int32_t server_open(xbc_server_t * xsrv_ptr)
+{
+    x_sockfd_t     xfdt_sockfd = X_INVALID_SOCKFD;
+    x_uchar_t      xut_loop    = 1;
+    x_uchar_t      xut_ttl     = 1;
+    x_int32_t      xit_errno   = 0;
+    struct in_addr xaddr_iface;
+
+    xsrv_ptr->xsrv_base.xit_offset  = XBC_OFFSET;
+    xsrv_ptr->xsrv_base.xfunc_reply = bcast_reply;
+    xsrv_ptr->xsrv_base.xfunc_tick  = bcast_tick;
+    xsrv_ptr->xsrv_base.xut_tick    = XBC_PERIOD;
+    xsrv_ptr->xsrv_base.xpvt_ctx    = xsrv_ptr;
+
+    xit_errno = xtest_server_open(&xsrv_ptr->xsrv_base);
+    if (0 != xit_errno)
+        return xit_errno;
+
+    xfdt_sockfd        = xsrv_ptr->xsrv_base.xfdt_sockfd;
+    xaddr_iface.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ((0 != setsockopt(xfdt_sockfd, IPPROTO_IP, IP_MULTICAST_IF,
+                         (const x_char_t *)&xaddr_iface, sizeof(struct in_addr))) ||
+        (0 != setsockopt(xfdt_sockfd, IPPROTO_IP, IP_MULTICAST_LOOP,
+                         (const x_char_t *)&xut_loop, sizeof(x_uchar_t))) ||
+        (0 != setsockopt(xfdt_sockfd, IPPROTO_IP, IP_MULTICAST_TTL,
+                         (const x_char_t *)&xut_ttl, sizeof(x_uchar_t))))
+    {
+        xtest_sockfd_close(xfdt_sockfd);
+        xsrv_ptr->xsrv_base.xfdt_sockfd = X_INVALID_SOCKFD;
+        return errno;
+    }
+
+    return 0;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 接收线程：连续接收 xut_count 个 广播报文，校验 偏差。
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI worker_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_pvoid_t worker_proc(x_pvoid_t xpvt_param)
+#endif // defined(_WIN32) || defined(_WIN64)
+{
+    xbc_worker_t      * xwork_ptr = (xbc_worker_t *)xpvt_param;
+    x_uint32_t          xut_iter  = 0;
+    x_int32_t           xit_errno = 0;
+    x_int64_t           xit_error = 0;
+    xntp_bcast_result_t xres_this;
+
+    for (xut_iter = 0; xut_iter < xwork_ptr->xut_count; ++xut_iter)
+    {
+        xit_errno = ntpbc_recv(xwork_ptr->xbc_this, &xres_this, time_mono() + 1000 * XTIME_VNSEC_MSEC);
+        if (0 != xit_errno)
+        {
+            if (0 == xwork_ptr->xit_errno)
+                xwork_ptr->xit_errno = xit_errno;
+            continue;
+        }
+
+        xit_error = xres_this.xit_offset - XBC_OFFSET;
+        if (xit_error < 0)
+            xit_error = -xit_error;
+        if (xit_error > xwork_ptr->xit_maxerr)
+            xwork_ptr->xit_maxerr = xit_error;
+        if (xit_error <= XBC_TOLERANCE)
+            xwork_ptr->xut_okay += 1;
+    }
+
+    ntpbc_stat(xwork_ptr->xbc_this, &xwork_ptr->xstat);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 xut_count 个 接收线程 同时接收，等待 全部完成。
+ */
+static x_void_t run_workers(xbc_worker_t * xwork_list, x_uint32_t xut_count)
+{
+    x_uint32_t xut_iter = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE     xthd_list[XBC_RECV_MAX];
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_t  xthd_list[XBC_RECV_MAX];
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        xthd_list[xut_iter] = CreateThread(X_NULL, 0, worker_proc, &xwork_list[xut_iter], 0, X_NULL);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        pthread_create(&xthd_list[xut_iter], X_NULL, worker_proc, &xwork_list[xut_iter]);
+#endif // defined(_WIN32) || defined(_WIN64)
+    }
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        WaitForSingleObject(xthd_list[xut_iter], INFINITE);
+        CloseHandle(xthd_list[xut_iter]);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        pthread_join(xthd_list[xut_iter], X_NULL);
+#endif // defined(_WIN32) || defined(_WIN64)
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-n <updates>] [-r <receivers>]\n", xszt_app);
+    printf("\t-n <updates>   The number of updates of each receiver, default 100.\n");
+    printf("\t-r <receivers> The number of receivers listening to the group, default 8.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t         xit_iter   = 0;
+    x_uint32_t        xut_iter   = 0;
+    x_uint32_t        xut_count  = 100;
+    x_uint32_t        xut_recvs  = 8;
+    x_uint32_t        xut_okay   = 0;
+    x_uint32_t        xut_reqs   = 0;
+    x_int32_t         xit_fail   = 0;
+    x_int32_t         xit_errno  = 0;
+    x_int64_t         xit_maxerr = 0;
+    x_bool_t          xbt_srvrun = X_FALSE;
+    xntp_keyptr_t     xkey_cli   = X_NULL;
+    xntp_bcastptr_t   xbc_temp   = X_NULL;
+    xbc_worker_t    * xwork_list = X_NULL;
+    xntp_bcast_conf_t xconf_this;
+    xntp_bcast_stat_t xstat_this;
+    xntp_bcast_result_t xres_this;
+
+    xbc_server_t xbc_srv;
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA      xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    memset(&xbc_srv, 0, sizeof(xbc_server_t));
+    xbc_srv.xsrv_base.xfdt_sockfd = X_INVALID_SOCKFD;
+
+    //======================================
+
+    do
+    {
+        //======================================
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-n", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_count = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-r", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_recvs = (x_uint32_t)atoi(argv[++xit_iter]);
+            else
+            {
+                usage(argv[0]);
+                return 0;
+            }
+        }
+
+        if ((xut_count < 10) || (0 == xut_recvs) || (xut_recvs > XBC_RECV_MAX))
+        {
+            usage(argv[0]);
+            break;
+        }
+
+        xwork_list = (xbc_worker_t *)calloc(XBC_RECV_MAX, sizeof(xbc_worker_t));
+        if (X_NULL == xwork_list)
+        {
+            printf("calloc() return X_NULL\n");
+            xit_fail += 1;
+            break;
+        }
+
+        //======================================
+        // 服务端 以 key ID 1 签名 广播报文；key ID 2 只有 客户端 持有（认证 可用时）
+
+        xbc_srv.xkey_table = ntpkey_create();
+        xkey_cli = ntpkey_create();
+        if ((X_NULL == xbc_srv.xkey_table) || (X_NULL == xkey_cli))
+        {
+            printf("ntpkey_create() return X_NULL\n");
+            xit_fail += 1;
+            break;
+        }
+
+        if ((0 == ntpkey_add(xbc_srv.xkey_table, 1, ntp_auth_sha1, (const x_uchar_t *)"bcast-secret", 12)) &&
+            (0 == ntpkey_add(xkey_cli, 1, ntp_auth_sha1, (const x_uchar_t *)"bcast-secret", 12)) &&
+            (0 == ntpkey_add(xkey_cli, 2, ntp_auth_sha1, (const x_uchar_t *)"other-secret", 12)))
+        {
+            xbc_srv.xut_keyid = 1;
+        }
+
+        xbc_srv.xut_gport = free_port();
+        if ((0 == xbc_srv.xut_gport) || (0 != server_open(&xbc_srv)))
+        {
+            printf("free_port() or server_open() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+        memset(&xconf_this, 0, sizeof(xntp_bcast_conf_t));
+        xconf_this.xszt_group = XBC_GROUP;
+        xconf_this.xszt_iface = "127.0.0.1";
+        xconf_this.xut_port   = xbc_srv.xut_gport;
+        xconf_this.xut_tmout  = 1000;
+
+        //======================================
+
+#define XBC_CHECK(xcond)                                              \
+        do                                                            \
+        {                                                             \
+            if (!(xcond))                                             \
+            {                                                         \
+                printf("check failed at line %d : %s\n",              \
+                       __LINE__, #xcond);                             \
+                xit_fail += 1;                                        \
+            }                                                         \
+        } while (0)
+
+        // 无效的 参数
+        xconf_this.xszt_group = "10.0.0.1";
+        XBC_CHECK((X_NULL == ntpbc_open(&xconf_this)) && (EINVAL == errno));
+        xconf_this.xszt_group = XBC_GROUP;
+
+        xconf_this.xkey_table = xkey_cli;
+        xconf_this.xut_keyid  = 9;
+        XBC_CHECK((X_NULL == ntpbc_open(&xconf_this)) && ((ENOENT == errno) || (EINVAL == errno)));
+        xconf_this.xkey_table = X_NULL;
+        xconf_this.xut_keyid  = 0;
+
+        // 先加入 组播组，再启动 服务端，接收方 不会错过 首个报文
+        for (xut_iter = 0; xut_iter < xut_recvs; ++xut_iter)
+        {
+            xwork_list[xut_iter].xbc_this  = ntpbc_open(&xconf_this);
+            xwork_list[xut_iter].xut_count = xut_count;
+            if (X_NULL == xwork_list[xut_iter].xbc_this)
+            {
+                printf("ntpbc_open() return X_NULL, errno : %d\n", errno);
+                xit_fail += 1;
+                break;
+            }
+        }
+
+        if (0 != xit_fail)
+            break;
+
+        xtest_server_run(&xbc_srv.xsrv_base);
+        xbt_srvrun = X_TRUE;
+
+        //======================================
+        // 多个 接收方：每个 只校准一次，此后 不再发出请求
+
+        run_workers(xwork_list, xut_recvs);
+
+        for (xut_iter = 0, xut_okay = 0, xit_maxerr = 0; xut_iter < xut_recvs; ++xut_iter)
+        {
+            XBC_CHECK(0 == xwork_list[xut_iter].xit_errno);
+            XBC_CHECK(1 == xwork_list[xut_iter].xstat.xut_calibs);
+            XBC_CHECK(xut_count == xwork_list[xut_iter].xstat.xut_updates);
+            XBC_CHECK(xwork_list[xut_iter].xstat.xut_rejects >= (xut_count - 1));
+
+            xut_okay += xwork_list[xut_iter].xut_okay;
+            if (xwork_list[xut_iter].xit_maxerr > xit_maxerr)
+                xit_maxerr = xwork_list[xut_iter].xit_maxerr;
+
+            ntpbc_close(xwork_list[xut_iter].xbc_this);
+            xwork_list[xut_iter].xbc_this = X_NULL;
+        }
+
+        xut_reqs = xbc_srv.xsrv_base.xut_recvd;
+        XBC_CHECK(xut_okay == (xut_count * xut_recvs));
+        XBC_CHECK(xut_reqs == xut_recvs);
+
+        printf("multicast : %u receivers, %u/%u updates within %lld us, max error %lld us, %u requests\n",
+               xut_recvs,
+               xut_okay,
+               xut_count * xut_recvs,
+               XBC_TOLERANCE / 10LL,
+               xit_maxerr / 10LL,
+               xut_reqs);
+
+        //======================================
+        // 周期性的 重新校准
+
+        xconf_this.xut_recal = 20 * XBC_PERIOD;
+        xwork_list[0].xbc_this  = ntpbc_open(&xconf_this);
+        xwork_list[0].xut_okay  = 0;
+        xwork_list[0].xit_errno = 0;
+        XBC_CHECK(X_NULL != xwork_list[0].xbc_this);
+        if (X_NULL != xwork_list[0].xbc_this)
+        {
+            run_workers(xwork_list, 1);
+            XBC_CHECK(0 == xwork_list[0].xit_errno);
+            XBC_CHECK(xwork_list[0].xstat.xut_calibs > 1);
+            XBC_CHECK(xwork_list[0].xstat.xut_calibs < (xut_count / 10));
+            printf("recalibrate : %llu calibrations for %llu updates\n",
+                   xwork_list[0].xstat.xut_calibs, xwork_list[0].xstat.xut_updates);
+            ntpbc_close(xwork_list[0].xbc_this);
+            xwork_list[0].xbc_this = X_NULL;
+        }
+        xconf_this.xut_recal = 0;
+
+        //======================================
+        // 认证：key ID 相符 的 接收方 正常接收，不符的 丢弃 所有报文
+
+        if (0 != xbc_srv.xut_keyid)
+        {
+            xconf_this.xkey_table = xkey_cli;
+            xconf_this.xut_keyid  = 1;
+            xbc_temp = ntpbc_open(&xconf_this);
+            XBC_CHECK(X_NULL != xbc_temp);
+            for (xut_iter = 0, xut_okay = 0; (X_NULL != xbc_temp) && (xut_iter < 10); ++xut_iter)
+            {
+                if (0 == ntpbc_recv(xbc_temp, &xres_this, time_mono() + 1000 * XTIME_VNSEC_MSEC))
+                    xut_okay += 1;
+            }
+            XBC_CHECK(10 == xut_okay);
+            ntpbc_close(xbc_temp);
+
+            xconf_this.xut_keyid = 2;
+            xbc_temp = ntpbc_open(&xconf_this);
+            XBC_CHECK(X_NULL != xbc_temp);
+            if (X_NULL != xbc_temp)
+            {
+                xit_errno = ntpbc_recv(xbc_temp, &xres_this, time_mono() + 10 * XBC_PERIOD * XTIME_VNSEC_MSEC);
+                XBC_CHECK(ETIMEDOUT == xit_errno);
+                XBC_CHECK((0 == ntpbc_stat(xbc_temp, &xstat_this)) &&
+                          (xstat_this.xut_rejects > 0) && (0 == xstat_this.xut_calibs));
+            }
+            ntpbc_close(xbc_temp);
+            xbc_temp = X_NULL;
+
+            xconf_this.xkey_table = X_NULL;
+            xconf_this.xut_keyid  = 0;
+            printf("authentication : checked\n");
+        }
+        else
+        {
+            printf("authentication : unavailable in this build, skipped\n");
+        }
+
+#undef XBC_CHECK
+
+        printf("checks : %s\n", (0 == xit_fail) ? "passed" : "FAILED");
+
+        //======================================
+    } while (0);
+
+    if (xbt_srvrun)
+    {
+        xtest_server_stop(&xbc_srv.xsrv_base);
+    }
+    else if (X_INVALID_SOCKFD != xbc_srv.xsrv_base.xfdt_sockfd)
+    {
+        xtest_sockfd_close(xbc_srv.xsrv_base.xfdt_sockfd);
+        xbc_srv.xsrv_base.xfdt_sockfd = X_INVALID_SOCKFD;
+    }
+
+    if (X_NULL != xwork_list)
+    {
+        for (xut_iter = 0; xut_iter < XBC_RECV_MAX; ++xut_iter)
+        {
+            ntpbc_close(xwork_list[xut_iter].xbc_this);
+        }
+
+        free(xwork_list);
+        xwork_list = X_NULL;
+    }
+
+    ntpkey_destroy(xkey_cli);
+    ntpkey_destroy(xbc_srv.xkey_table);
+
+    //======================================
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    return (0 == xit_fail) ? 0 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
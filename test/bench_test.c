@@ -0,0 +1,1068 @@
+﻿/**
+ * @file bench_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 性能基准测试程序（NTP 报文的 解析、构建，时间文本的 格式化、解析 等热点路径）。
+ */
+
+#include "ntp_packet.h"
+#include "ntp_auth.h"
+#include "xtzone.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 基准测试项 的执行函数（返回值 用于防止 编译器 优化掉 被测代码） */
+typedef x_uint64_t (* xbench_func_t)(x_uint32_t xut_loops);
+
+/**
+ * @struct xbench_case_t
+ * @brief  基准测试项。
+ */
+typedef struct xbench_case_t
+{
+    x_cstring_t   xszt_name;    ///< 名称
+    x_cstring_t   xszt_desc;    ///< 描述
+    xbench_func_t xfunc_run;    ///< 执行函数
+} xbench_case_t;
+
+//====================================================================
+
+//
+// 测试用的 报文样本
+//
+
+/** 仅有 48 字节头部 的应答 */
+static x_uchar_t g_xbt_pkt48[XNTP_PKT_LEN];
+
+/** 头部 + 24 字节 MAC（key ID + SHA1 摘要）的应答 */
+static x_uchar_t g_xbt_pktmac[XNTP_PKT_LEN + 24];
+
+/** 头部 + 两个扩展字段（36、28 字节）+ 20 字节 MAC（key ID + MD5 摘要）的应答 */
+static x_uchar_t g_xbt_pktext[XNTP_PKT_LEN + 36 + 28 + 20];
+
+/** 解析应答 时 用作 纪元参照 的 本地时间 */
+static xtime_vnsec_t g_xtm_local = 0;
+
+/** 认证测试用的 密钥表（key ID 1 ~ 3 依次为 MD5、SHA1、AES-128-CMAC） */
+static xntp_keyptr_t g_xkey_table = X_NULL;
+
+/**********************************************************/
+/**
+ * @brief 构建 测试用的 应答报文样本。
+ */
+static x_void_t bench_samples(x_void_t)
+{
+    x_uint32_t xut_iter  = 0;
+    x_uint64_t xut_stamp = 0;
+
+    g_xtm_local = time_vnsec();
+    xut_stamp   = ntp_stamp_from_vnsec(g_xtm_local);
+
+    ntp_req_init(g_xbt_pkt48);
+    g_xbt_pkt48[XNTP_OFF_LVM] = XNTP_LI_VN_MODE(0, 4, ntp_mode_server);
+    ntp_store64(g_xbt_pkt48 + XNTP_OFF_ORIGINATE, xut_stamp);
+    ntp_store64(g_xbt_pkt48 + XNTP_OFF_RECEIVE  , xut_stamp + 1);
+    ntp_store64(g_xbt_pkt48 + XNTP_OFF_TRANSMIT , xut_stamp + 2);
+
+    memcpy(g_xbt_pktmac, g_xbt_pkt48, XNTP_PKT_LEN);
+    ntp_store32(g_xbt_pktmac + XNTP_PKT_LEN, 7);
+    for (xut_iter = XNTP_PKT_LEN + 4; xut_iter < sizeof(g_xbt_pktmac); ++xut_iter)
+        g_xbt_pktmac[xut_iter] = (x_uchar_t)xut_iter;
+
+    memcpy(g_xbt_pktext, g_xbt_pkt48, XNTP_PKT_LEN);
+    ntp_store32(g_xbt_pktext + XNTP_PKT_LEN          , (0x0104 << 16) | 36);
+    ntp_store32(g_xbt_pktext + XNTP_PKT_LEN + 36     , (0x0204 << 16) | 28);
+    ntp_store32(g_xbt_pktext + XNTP_PKT_LEN + 36 + 28, 9);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 报文视图 对 各种（含 畸形的）报文布局 的判断结果。
+ *
+ * @return x_int32_t : 返回 未通过的 校验项数量。
+ */
+static x_int32_t bench_check_view(x_void_t)
+{
+    x_int32_t   xit_fail = 0;
+    x_uint32_t  xut_iter = 0;
+    x_uint32_t  xut_nums = 0;
+    xntp_view_t xview_pk;
+    xntp_ext_t  xext_this;
+    x_uchar_t   xbt_pack[XNTP_PKT_LEN + 64];
+
+#define XBENCH_CHECK(xcond)                                           \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed [line %d] : %s\n", __LINE__, #xcond); \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+    XBENCH_CHECK(ENODATA  == ntpv_init(&xview_pk, g_xbt_pkt48, XNTP_PKT_LEN - 1));
+    XBENCH_CHECK(EMSGSIZE == ntpv_init(&xview_pk, g_xbt_pkt48, XNTP_PKT_MAX + 1));
+
+    XBENCH_CHECK(0 == ntpv_init(&xview_pk, g_xbt_pkt48, XNTP_PKT_LEN));
+    XBENCH_CHECK(!ntpv_has_mac(&xview_pk) && (0 == ntpv_keyid(&xview_pk)));
+    XBENCH_CHECK(ntp_mode_server == ntpv_mode(&xview_pk));
+    XBENCH_CHECK(4 == ntpv_version(&xview_pk));
+    XBENCH_CHECK(ntpv_receive(&xview_pk) + 1 == ntpv_transmit(&xview_pk));
+
+    XBENCH_CHECK(0 == ntpv_init(&xview_pk, g_xbt_pktmac, sizeof(g_xbt_pktmac)));
+    XBENCH_CHECK(7 == ntpv_keyid(&xview_pk) && (20 == ntpv_digest_len(&xview_pk)));
+    XBENCH_CHECK(XNTP_PKT_LEN + 4 == ntpv_digest(&xview_pk)[0]);
+
+    XBENCH_CHECK(0 == ntpv_init(&xview_pk, g_xbt_pktext, sizeof(g_xbt_pktext)));
+    XBENCH_CHECK(9 == ntpv_keyid(&xview_pk) && (16 == ntpv_digest_len(&xview_pk)));
+    for (xut_iter = 0, xut_nums = 0; ntpv_ext_next(&xview_pk, &xut_iter, &xext_this); ++xut_nums)
+    {
+        XBENCH_CHECK(((0 == xut_nums) && (0x0104 == xext_this.xut_type) && (32 == xext_this.xut_vlen)) ||
+                     ((1 == xut_nums) && (0x0204 == xext_this.xut_type) && (24 == xext_this.xut_vlen)));
+    }
+    XBENCH_CHECK(2 == xut_nums);
+
+    // crypto-NAK（只有 key ID）
+    memcpy(xbt_pack, g_xbt_pkt48, XNTP_PKT_LEN);
+    ntp_store32(xbt_pack + XNTP_PKT_LEN, 0);
+    XBENCH_CHECK(0 == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + 4));
+    XBENCH_CHECK(ntpv_has_mac(&xview_pk) && (0 == ntpv_digest_len(&xview_pk)));
+
+    // 无效的 MAC 长度
+    XBENCH_CHECK(EBADMSG == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + 8));
+    XBENCH_CHECK(EBADMSG == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + 2));
+
+    // 扩展字段：长度 越界、过小、非 4 的倍数
+    ntp_store32(xbt_pack + XNTP_PKT_LEN, (0x0104 << 16) | 64);
+    XBENCH_CHECK(EBADMSG == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + 32));
+    ntp_store32(xbt_pack + XNTP_PKT_LEN, (0x0104 << 16) | 0);
+    XBENCH_CHECK(EBADMSG == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + 32));
+    ntp_store32(xbt_pack + XNTP_PKT_LEN, (0x0104 << 16) | 30);
+    XBENCH_CHECK(EBADMSG == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + 32));
+
+    // 单个扩展字段 恰好占满剩余部分（无 MAC）
+    ntp_store32(xbt_pack + XNTP_PKT_LEN, (0x0104 << 16) | 32);
+    XBENCH_CHECK(0 == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + 32));
+    XBENCH_CHECK(!ntpv_has_mac(&xview_pk));
+
+#undef XBENCH_CHECK
+
+    return xit_fail;
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 NTP 时间戳 的 纪元处理（2036 年 纪元 0/1 边界 前后的 逐秒校验，以及 跨纪元的 随机校验）。
+ *
+ * @return x_int32_t : 返回 未通过的 校验项数量。
+ */
+static x_int32_t bench_check_era(x_void_t)
+{
+    x_int32_t     xit_fail  = 0;
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_fpos  = 0;
+    x_uint32_t    xut_dpos  = 0;
+    x_uint64_t    xut_esec  = 0;
+    x_uint64_t    xut_stamp = 0;
+    x_uint64_t    xut_rand  = 88172645463325252ULL;
+    xtime_vnsec_t xtm_vnsec = 0;
+    xtime_vnsec_t xtm_check = 0;
+
+    /** 秒的小数部分 的 取值 */
+    static const x_uint32_t xut_fracs[] = { 0, 1, 0x80000000, 0xFFFFFFFF };
+
+    /** 参照 与 时间戳（带纪元）的 距离（秒），均在 [-2^31 + 1, 2^31 - 1] 之内 */
+    static const x_int64_t xit_dists[] =
+    {
+        -2147483647LL, -1576800000LL, -86400LL, -1LL, 0LL, 1LL, 86400LL, 1576800000LL, 2147483647LL
+    };
+
+#define XBENCH_CHECK(xcond)                                           \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed [line %d] : %s\n", __LINE__, #xcond); \
+            xit_fail += 1;                                            \
+            if (xit_fail > 16) return xit_fail;                       \
+        }                                                             \
+    } while (0)
+
+#define XBENCH_ERA_VNSEC(xesec, xfrac)  \
+    ((xtime_vnsec_t)(((xesec) - XTIME_SEC_1900_1970) * XTIME_100NS_BASE + \
+                     ((((x_uint64_t)(xfrac)) * XTIME_100NS_BASE) >> 32)))
+
+    //======================================
+    // 纪元号
+
+    XBENCH_CHECK(0 == XNTP_ERA(ntp_era_seconds(0)));
+    XBENCH_CHECK(0 == XNTP_ERA(ntp_era_seconds((0x100000000LL - 1 - XTIME_SEC_1900_1970) * XTIME_100NS_BASE)));
+    XBENCH_CHECK(1 == XNTP_ERA(ntp_era_seconds((0x100000000LL - XTIME_SEC_1900_1970) * XTIME_100NS_BASE)));
+
+    //======================================
+    // 2036-02-07 06:28:16 UTC 前后 各 2 天，逐秒、逐个 小数部分、逐个 参照距离
+
+    for (xut_esec = 0x100000000ULL - 2 * 86400; xut_esec <= 0x100000000ULL + 2 * 86400; ++xut_esec)
+    {
+        for (xut_fpos = 0; xut_fpos < sizeof(xut_fracs) / sizeof(xut_fracs[0]); ++xut_fpos)
+        {
+            xut_stamp = (xut_esec << 32) | xut_fracs[xut_fpos];
+            xtm_check = XBENCH_ERA_VNSEC(xut_esec, xut_fracs[xut_fpos]);
+
+            // 纪元 1 的 起点（秒数、小数 均为 0）与 “未设置” 的 时间戳 无法区分
+            if (0 == xut_stamp)
+            {
+                XBENCH_CHECK(XTIME_INVALID_VNSEC == ntp_stamp_to_vnsec(xut_stamp, xut_esec));
+                continue;
+            }
+
+            for (xut_dpos = 0; xut_dpos < sizeof(xit_dists) / sizeof(xit_dists[0]); ++xut_dpos)
+            {
+                XBENCH_CHECK(xtm_check == ntp_stamp_to_vnsec(xut_stamp, xut_esec + xit_dists[xut_dpos]));
+            }
+
+            // 参照 相距 2^31 秒 时，落入 上一纪元（纪元 0 中 早于 1970 年的，为 无效值）
+            XBENCH_CHECK(((xut_esec - 0x100000000ULL <= XTIME_SEC_1900_1970) ? XTIME_INVALID_VNSEC :
+                          (xtm_check - 0x100000000LL * XTIME_100NS_BASE)) ==
+                         ntp_stamp_to_vnsec(xut_stamp, xut_esec - 0x80000000LL));
+
+            XBENCH_CHECK(xtm_check == ntp_stamp_to_vnsec_era(xut_stamp, XNTP_ERA(xut_esec)));
+        }
+
+        // 往返转换（ntp_stamp_from_vnsec() 截取 小数部分，误差 不超过 1 个 计量单位）
+        xtm_vnsec = XBENCH_ERA_VNSEC(xut_esec, 0) + (xtime_vnsec_t)(xut_esec % XTIME_100NS_BASE);
+        xtm_check = ntp_stamp_to_vnsec(ntp_stamp_from_vnsec(xtm_vnsec), ntp_era_seconds(xtm_vnsec));
+        XBENCH_CHECK((xtm_check == xtm_vnsec) || (xtm_check + 1 == xtm_vnsec));
+    }
+
+    //======================================
+    // 纪元 0 ~ 2 之内的 随机时刻（xorshift64）
+
+    for (xut_iter = 0; xut_iter < 1000000; ++xut_iter)
+    {
+        xut_rand ^= xut_rand << 13;
+        xut_rand ^= xut_rand >> 7;
+        xut_rand ^= xut_rand << 17;
+
+        xtm_vnsec = (xtime_vnsec_t)(xut_rand % (0x200000000ULL * XTIME_100NS_BASE)) + XTIME_100NS_BASE;
+        xut_esec  = ntp_era_seconds(xtm_vnsec);
+        xut_stamp = ntp_stamp_from_vnsec(xtm_vnsec);
+        xtm_check = ntp_stamp_to_vnsec(xut_stamp, xut_esec + xit_dists[xut_iter % (sizeof(xit_dists) / sizeof(xit_dists[0]))]);
+        XBENCH_CHECK((xtm_check == xtm_vnsec) || (xtm_check + 1 == xtm_vnsec));
+    }
+
+    //======================================
+    // 无效的 时间戳
+
+    XBENCH_CHECK(XTIME_INVALID_VNSEC == ntp_stamp_to_vnsec(0, ntp_era_seconds(g_xtm_local)));
+    XBENCH_CHECK(XTIME_INVALID_VNSEC == ntp_stamp_to_vnsec(0, 0x100000000ULL));
+    XBENCH_CHECK(XTIME_INVALID_VNSEC == ntp_stamp_to_vnsec((x_uint64_t)XTIME_SEC_1900_1970 << 32, XTIME_SEC_1900_1970));
+    XBENCH_CHECK(XTIME_INVALID_VNSEC == ntp_stamp_to_vnsec(1ULL << 32, 1));
+    XBENCH_CHECK(XTIME_INVALID_VNSEC != ntp_stamp_to_vnsec(1ULL << 32, 0x100000000ULL));
+
+#undef XBENCH_ERA_VNSEC
+#undef XBENCH_CHECK
+
+    return xit_fail;
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 时间文本 的 格式化 与 解析（1970 ~ 9999 年 逐日 对照 逐日递推的 日期，以及 各种 畸形文本）。
+ *
+ * @return x_int32_t : 返回 未通过的 校验项数量。
+ */
+static x_int32_t bench_check_text(x_void_t)
+{
+    x_int32_t     xit_fail  = 0;
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_days  = 0;
+    x_uint32_t    xut_year  = 1970;
+    x_uint32_t    xut_month = 1;
+    x_uint32_t    xut_day   = 1;
+    x_uint32_t    xut_mday  = 31;
+    x_uint32_t    xut_sod   = 0;
+    x_uint32_t    xut_frac  = 0;
+    xtime_vnsec_t xtm_vnsec = 0;
+    xtime_vnsec_t xtm_check = 0;
+    xtime_descr_t xtm_descr;
+    xtime_descr_t xtm_dback;
+    xtime_vnsec_t xtm_batch[4];
+    x_char_t      xszt_text[XTIME_TEXT_LEN];
+    x_char_t      xszt_refs[XTIME_TEXT_LEN + 8];
+    x_char_t      xszt_list[4][XTIME_TEXT_LEN];
+
+    /** 各种精度 对应的 截取单位（100纳秒） */
+    static const x_uint32_t xut_units[10] = { 10000000, 0, 0, 10000, 0, 0, 10, 0, 0, 1 };
+
+#define XBENCH_CHECK(xcond)                                           \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed [line %d] : %s\n", __LINE__, #xcond); \
+            xit_fail += 1;                                            \
+            if (xit_fail > 16) return xit_fail;                       \
+        }                                                             \
+    } while (0)
+
+#define XBENCH_STOV(xtext, xvnsec)  time_stov((xtext), (x_uint32_t)strlen(xtext), (xvnsec))
+
+    //======================================
+    // 逐日：日期部分 对照 逐日递推的 年、月、日，时间部分 与 小数部分 逐日变化，并 解析回 时间计量值
+
+    for (xut_days = 0; xut_days < 2932897U; ++xut_days)
+    {
+        xut_sod   = (xut_days * 7919U) % 86400U;
+        xut_frac  = (xut_days * 104729U) % 10000000U;
+        xtm_vnsec = ((x_uint64_t)xut_days * 86400ULL + xut_sod) * XTIME_100NS_BASE + xut_frac;
+
+        snprintf(xszt_refs, sizeof(xszt_refs), "%04u-%02u-%02uT%02u:%02u:%02u.%07u00Z",
+                 xut_year, xut_month, xut_day, xut_sod / 3600, (xut_sod / 60) % 60, xut_sod % 60, xut_frac);
+
+        XBENCH_CHECK((30 == time_vtos(xtm_vnsec, xtime_prec_nsec, xszt_text)) && (0 == strcmp(xszt_refs, xszt_text)));
+        XBENCH_CHECK((0 == time_stov(xszt_text, 30, &xtm_check)) && (xtm_check == xtm_vnsec));
+
+        // 较低的精度：截取 小数部分
+        xut_iter = (xut_days % 3 + 1) * 3 - 3;
+        XBENCH_CHECK((((0 == xut_iter) ? 20 : (21 + xut_iter)) == time_vtos(xtm_vnsec, (xtime_prec_t)xut_iter, xszt_text)) &&
+                     (0 == strncmp(xszt_refs, xszt_text, (0 == xut_iter) ? 19 : (20 + xut_iter))));
+        XBENCH_CHECK((0 == XBENCH_STOV(xszt_text, &xtm_check)) &&
+                     (xtm_check == xtm_vnsec - xtm_vnsec % xut_units[xut_iter]));
+
+        if (++xut_day > xut_mday)
+        {
+            xut_day = 1;
+            if (++xut_month > 12)
+            {
+                xut_month = 1;
+                xut_year += 1;
+            }
+
+            xut_mday = (2 != xut_month) ? (30U + ((xut_month + (xut_month >> 3)) & 1)) :
+                       (((0 == xut_year % 400) || ((0 == xut_year % 4) && (0 != xut_year % 100))) ? 29U : 28U);
+        }
+    }
+
+    XBENCH_CHECK((10000 == xut_year) && (1 == xut_month) && (1 == xut_day));
+
+    //======================================
+    // 格式化 的 边界
+
+    XBENCH_CHECK((24 == time_vtos(0, xtime_prec_msec, xszt_text)) && (0 == strcmp("1970-01-01T00:00:00.000Z", xszt_text)));
+    XBENCH_CHECK((20 == time_vtos(0, xtime_prec_sec , xszt_text)) && (0 == strcmp("1970-01-01T00:00:00Z", xszt_text)));
+    XBENCH_CHECK((27 == time_vtos(2932897ULL * 864000000000ULL - 1, xtime_prec_usec, xszt_text)) &&
+                 (0 == strcmp("9999-12-31T23:59:59.999999Z", xszt_text)));
+    XBENCH_CHECK((0 == time_vtos(2932897ULL * 864000000000ULL, xtime_prec_msec, xszt_text)) && ('\0' == xszt_text[0]));
+    XBENCH_CHECK(0 == time_vtos(XTIME_INVALID_VNSEC, xtime_prec_msec, xszt_text));
+    XBENCH_CHECK(0 == time_vtos(0, (xtime_prec_t)4, xszt_text));
+
+    // 批量：跨日、含 无效值
+    xtm_batch[0] = 864000000000ULL - 1;
+    xtm_batch[1] = 864000000000ULL;
+    xtm_batch[2] = XTIME_INVALID_VNSEC;
+    xtm_batch[3] = 864000000000ULL + 1;
+    XBENCH_CHECK(3 == time_vtos_batch(xtm_batch, 4, xtime_prec_nsec, xszt_list[0], XTIME_TEXT_LEN));
+    XBENCH_CHECK(0 == strcmp("1970-01-01T23:59:59.999999900Z", xszt_list[0]));
+    XBENCH_CHECK(0 == strcmp("1970-01-02T00:00:00.000000000Z", xszt_list[1]));
+    XBENCH_CHECK('\0' == xszt_list[2][0]);
+    XBENCH_CHECK(0 == strcmp("1970-01-02T00:00:00.000000100Z", xszt_list[3]));
+    XBENCH_CHECK(0 == time_vtos_batch(xtm_batch, 4, xtime_prec_nsec, xszt_list[0], XTIME_TEXT_LEN - 1));
+
+    //======================================
+    // 解析：时区、分隔符、闰秒、小数位数
+
+    XBENCH_CHECK((0 == XBENCH_STOV("2026-10-18T16:30:00.5+08:00", &xtm_vnsec)) &&
+                 (0 == XBENCH_STOV("2026-10-18t08:30:00.500z", &xtm_check)) && (xtm_vnsec == xtm_check));
+    XBENCH_CHECK((0 == XBENCH_STOV("2026-10-17 22:00:00.5-10:30", &xtm_vnsec)) && (xtm_vnsec == xtm_check));
+    XBENCH_CHECK((0 == XBENCH_STOV("2016-12-31T23:59:60Z", &xtm_vnsec)) &&
+                 (0 == XBENCH_STOV("2017-01-01T00:00:00Z", &xtm_check)) && (xtm_vnsec == xtm_check));
+    XBENCH_CHECK((0 == XBENCH_STOV("2024-02-29T00:00:00.123456789Z", &xtm_vnsec)) && (1234567 == xtm_vnsec % XTIME_100NS_BASE));
+    XBENCH_CHECK((0 == XBENCH_STOV("1970-01-01T00:00:00-00:01", &xtm_vnsec)) && (60 * XTIME_100NS_BASE == xtm_vnsec));
+
+    XBENCH_CHECK(ERANGE == XBENCH_STOV("1970-01-01T00:00:00+00:01", &xtm_vnsec));
+    XBENCH_CHECK(ERANGE == XBENCH_STOV("1969-12-31T23:59:59Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-02-29T00:00:00Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-13-01T00:00:00Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T24:00:00Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T08:30:61Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T08:30:00", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T08:30:00.Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T08:30:00.1234567890Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T08:30:00Z ", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T08:30:00+0800", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18T08:30:00+24:00", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18_08:30:00Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-1O-18T08:30:00Z", &xtm_vnsec));
+    XBENCH_CHECK(EINVAL == XBENCH_STOV("2026-10-18", &xtm_vnsec));
+
+    //======================================
+    // 时间描述信息（本地时间）：格式化 与 解析 互逆
+
+    for (xut_iter = 0, xtm_vnsec = g_xtm_local; xut_iter < 1000; ++xut_iter)
+    {
+        xtm_vnsec += 3599 * XTIME_100NS_BASE + 1234567;
+        xtm_descr  = time_vtod(xtm_vnsec);
+        XBENCH_CHECK((23 == time_dtos(xtm_descr, xszt_text)) &&
+                     (0 == time_stod(xszt_text, 23, &xtm_dback)) && (xtm_dback.ctx_value == xtm_descr.ctx_value));
+    }
+
+    XBENCH_CHECK((0 == time_stod("2016-12-31 23:59:60.999999", 26, &xtm_descr)) &&
+                 (60 == xtm_descr.ctx_second) && (999 == xtm_descr.ctx_msec) && (6 == xtm_descr.ctx_week));
+    XBENCH_CHECK((23 == time_dtos(xtm_descr, xszt_text)) && (0 == strcmp("2016-12-31T23:59:60.999", xszt_text)));
+    XBENCH_CHECK(EINVAL == time_stod("2026-10-18T08:30:00Z", 20, &xtm_descr));
+    XBENCH_CHECK(EINVAL == time_stod("1969-12-31T23:59:59", 19, &xtm_descr));
+
+    xtm_descr.ctx_day = 32;
+    XBENCH_CHECK((0 == time_dtos(xtm_descr, xszt_text)) && ('\0' == xszt_text[0]));
+
+#undef XBENCH_STOV
+#undef XBENCH_CHECK
+
+    return xit_fail;
+}
+
+//====================================================================
+
+//
+// 基准测试项
+//
+
+/**********************************************************/
+/**
+ * @brief 构建请求：拷贝请求模板，写入 transmit 时间戳。
+ */
+static x_uint64_t bench_req_build(x_uint32_t xut_loops)
+{
+    x_uchar_t  xbt_pack[XNTP_PKT_LEN];
+    x_uint64_t xut_sum = 0;
+
+    while (xut_loops-- > 0)
+    {
+        ntp_req_init(xbt_pack);
+        ntp_req_stamp(xbt_pack, (xtime_vnsec_t)xut_loops);
+        xut_sum += xbt_pack[XNTP_OFF_TRANSMIT + 7];
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析应答：建立视图，读取 originate、receive、transmit 与 key ID。
+ */
+static x_uint64_t bench_view_parse(const x_uchar_t * xbt_data, x_int32_t xit_dlen, x_uint32_t xut_loops)
+{
+    xntp_view_t xview_pk;
+    x_uint64_t  xut_pivot = 0;
+    x_uint64_t  xut_sum   = 0;
+
+    while (xut_loops-- > 0)
+    {
+        if (0 != ntpv_init(&xview_pk, xbt_data, xit_dlen))
+            continue;
+
+        xut_pivot = ntp_era_seconds(g_xtm_local + xut_loops);
+        xut_sum  += ntpv_originate(&xview_pk);
+        xut_sum  += ntp_stamp_to_vnsec(ntpv_receive (&xview_pk), xut_pivot);
+        xut_sum  += ntp_stamp_to_vnsec(ntpv_transmit(&xview_pk), xut_pivot);
+        xut_sum += ntpv_keyid(&xview_pk);
+    }
+
+    return xut_sum;
+}
+
+static x_uint64_t bench_parse_48(x_uint32_t xut_loops)
+{
+    return bench_view_parse(g_xbt_pkt48, sizeof(g_xbt_pkt48), xut_loops);
+}
+
+static x_uint64_t bench_parse_mac(x_uint32_t xut_loops)
+{
+    return bench_view_parse(g_xbt_pktmac, sizeof(g_xbt_pktmac), xut_loops);
+}
+
+static x_uint64_t bench_parse_ext(x_uint32_t xut_loops)
+{
+    return bench_view_parse(g_xbt_pktext, sizeof(g_xbt_pktext), xut_loops);
+}
+
+/**********************************************************/
+/**
+ * @brief 时间戳转换 的 对照基准：只处理 纪元 0 的 转换（引入 纪元处理 之前的 实现）。
+ */
+static inline xtime_vnsec_t bench_stamp_to_vnsec_e0(x_uint64_t xut_stamp)
+{
+    x_uint64_t xut_seconds  = xut_stamp >> 32;
+    x_uint64_t xut_fraction = xut_stamp & 0xFFFFFFFFULL;
+
+    if (xut_seconds <= XTIME_SEC_1900_1970)
+    {
+        return XTIME_INVALID_VNSEC;
+    }
+
+    return ((xut_seconds - XTIME_SEC_1900_1970) * XTIME_100NS_BASE) +
+           ((xut_fraction * XTIME_100NS_BASE) >> 32);
+}
+
+/**********************************************************/
+/**
+ * @brief 时间戳转换（纪元 0，对照基准）。
+ */
+static x_uint64_t bench_stamp_e0(x_uint32_t xut_loops)
+{
+    x_uint64_t xut_stamp = ntp_load64(g_xbt_pkt48 + XNTP_OFF_TRANSMIT);
+    x_uint64_t xut_sum   = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xut_sum += bench_stamp_to_vnsec_e0(xut_stamp + xut_loops);
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 时间戳转换（以 本地时间 为参照 确定纪元）。
+ */
+static x_uint64_t bench_stamp_era(x_uint32_t xut_loops)
+{
+    x_uint64_t xut_stamp = ntp_load64(g_xbt_pkt48 + XNTP_OFF_TRANSMIT);
+    x_uint64_t xut_pivot = ntp_era_seconds(g_xtm_local);
+    x_uint64_t xut_sum   = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xut_sum += ntp_stamp_to_vnsec(xut_stamp + xut_loops, xut_pivot);
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 分别读取 原始单调时钟 与 系统时间（两次 系统时钟读取，time_pair() 的 对照基准）。
+ */
+static x_uint64_t bench_clock_x2(x_uint32_t xut_loops)
+{
+    x_uint64_t xut_sum = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xut_sum += time_mono_raw();
+        xut_sum += time_vnsec();
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 成对采集 原始单调时钟 与 系统时间。
+ */
+static x_uint64_t bench_clock_pair(x_uint32_t xut_loops)
+{
+    xtime_pair_t xtm_pair;
+    x_uint64_t   xut_sum = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xtm_pair = time_pair();
+        xut_sum += xtm_pair.xtm_mono + xtm_pair.xtm_real;
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 读取 原始单调时钟（TSC 换算）。
+ */
+static x_uint64_t bench_clock_fast(x_uint32_t xut_loops)
+{
+    x_uint64_t xut_sum = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xut_sum += time_mono_fast();
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 转换 时间描述信息，时间计量值 逐次 递增 xut_step（以 100纳秒 为单位）。
+ */
+static x_uint64_t bench_vtod_walk(x_uint64_t xut_step, x_uint32_t xut_loops)
+{
+    xtime_descr_t xtm_descr;
+    xtime_vnsec_t xtm_vnsec = g_xtm_local;
+    x_uint64_t    xut_sum   = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xtm_descr  = time_vtod(xtm_vnsec);
+        xtm_vnsec += xut_step;
+        xut_sum   += xtm_descr.ctx_value;
+    }
+
+    return xut_sum;
+}
+
+/** 同一秒内（逐次 递增 1 微秒）：命中 线程内缓存，只更新 毫秒 */
+static x_uint64_t bench_vtod_hit(x_uint32_t xut_loops)
+{
+    return bench_vtod_walk(10ULL, xut_loops);
+}
+
+/** 逐次 递增 1.23 秒：整秒 每次 变化，以 算术方式 换算 */
+static x_uint64_t bench_vtod_step(x_uint32_t xut_loops)
+{
+    return bench_vtod_walk(12345670ULL, xut_loops);
+}
+
+/** 逐次 递增 2 小时：每次 都 调用 系统接口（即 未加缓存时 每次转换 的 开销，另加 1 次 时区偏移 确认） */
+static x_uint64_t bench_vtod_miss(x_uint32_t xut_loops)
+{
+    return bench_vtod_walk(72000000000ULL, xut_loops);
+}
+
+/**********************************************************/
+/**
+ * @brief 按 指定时区 转换（纽约，时刻 散布于 1970 ~ 2199 年，逐次 二分查找 偏移变化表；时区数据 缺失时 按 UTC）。
+ */
+static x_uint64_t bench_vtod_tz(x_uint32_t xut_loops)
+{
+    xtime_zoneptr_t xtzone_ptr = tzone_load("America/New_York");
+    xtime_descr_t   xtm_descr;
+    x_uint64_t      xut_sum    = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xtm_descr = time_vtod_tz(xtzone_ptr, (xut_loops * 2654435761ULL % 7258118400ULL) * 10000000ULL);
+        xut_sum  += xtm_descr.ctx_value;
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 按 指定时区 逆向转换（参看 bench_vtod_tz()）。
+ */
+static x_uint64_t bench_dtov_tz(x_uint32_t xut_loops)
+{
+    xtime_zoneptr_t xtzone_ptr = tzone_load("America/New_York");
+    xtime_descr_t   xtm_descr  = time_vtod_tz(xtzone_ptr, g_xtm_local);
+    x_uint64_t      xut_sum    = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xtm_descr.ctx_year = 1971 + xut_loops % 229;
+        xut_sum += time_dtov_tz(xtzone_ptr, xtm_descr);
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 格式化 时间文本 的 对照基准：time_vtod() + snprintf()（此前 各处 输出时间 的 做法）。
+ */
+static x_uint64_t bench_fmt_printf(x_uint32_t xut_loops)
+{
+    x_char_t      xszt_text[XTIME_TEXT_LEN];
+    xtime_descr_t xtm_descr;
+    x_uint64_t    xut_sum = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xtm_descr = time_vtod(g_xtm_local + xut_loops * 1234567ULL);
+        xut_sum  += (x_uint64_t)snprintf(xszt_text, sizeof(xszt_text),
+                                         "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                                         xtm_descr.ctx_year, xtm_descr.ctx_month, xtm_descr.ctx_day,
+                                         xtm_descr.ctx_hour, xtm_descr.ctx_minute, xtm_descr.ctx_second,
+                                         xtm_descr.ctx_msec);
+        xut_sum  += (x_uchar_t)xszt_text[22];
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 格式化 时间文本（时间计量值 逐次 递增 约 123 毫秒，约 每 70 万次 跨越 一天）。
+ */
+static x_uint64_t bench_fmt_vtos(xtime_prec_t xprec, x_uint32_t xut_loops)
+{
+    x_char_t   xszt_text[XTIME_TEXT_LEN];
+    x_uint64_t xut_sum = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xut_sum += time_vtos(g_xtm_local + xut_loops * 1234567ULL, xprec, xszt_text);
+        xut_sum += (x_uchar_t)xszt_text[22];
+    }
+
+    return xut_sum;
+}
+
+static x_uint64_t bench_fmt_ms(x_uint32_t xut_loops)
+{
+    return bench_fmt_vtos(xtime_prec_msec, xut_loops);
+}
+
+static x_uint64_t bench_fmt_us(x_uint32_t xut_loops)
+{
+    return bench_fmt_vtos(xtime_prec_usec, xut_loops);
+}
+
+static x_uint64_t bench_fmt_ns(x_uint32_t xut_loops)
+{
+    return bench_fmt_vtos(xtime_prec_nsec, xut_loops);
+}
+
+/**********************************************************/
+/**
+ * @brief 批量 格式化 时间文本（每批 64 条，耗时 按 单条 计）。
+ */
+static x_uint64_t bench_fmt_batch(x_uint32_t xut_loops)
+{
+    x_char_t      xszt_text[64][XTIME_TEXT_LEN];
+    xtime_vnsec_t xtm_vnsec[64];
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_count = 0;
+    x_uint64_t    xut_sum   = 0;
+
+    while (xut_loops > 0)
+    {
+        xut_count = (xut_loops < 64) ? xut_loops : 64;
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+            xtm_vnsec[xut_iter] = g_xtm_local + (xut_loops - xut_iter) * 1234567ULL;
+
+        xut_sum   += time_vtos_batch(xtm_vnsec, xut_count, xtime_prec_msec, xszt_text[0], XTIME_TEXT_LEN);
+        xut_sum   += (x_uchar_t)xszt_text[xut_count - 1][22];
+        xut_loops -= xut_count;
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 格式化 时间描述信息（本地时间）。
+ */
+static x_uint64_t bench_fmt_dtos(x_uint32_t xut_loops)
+{
+    x_char_t      xszt_text[XTIME_TEXT_LEN];
+    xtime_descr_t xtm_descr = time_vtod(g_xtm_local);
+    x_uint64_t    xut_sum   = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xtm_descr.ctx_msec = xut_loops % 1000;
+        xut_sum += time_dtos(xtm_descr, xszt_text);
+        xut_sum += (x_uchar_t)xszt_text[22];
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 解析 时间文本（纳秒精度，UTC 偏移）。
+ */
+static x_uint64_t bench_parse_stov(x_uint32_t xut_loops)
+{
+    x_char_t      xszt_text[] = "2026-10-18T16:30:00.123456789+08:00";
+    xtime_vnsec_t xtm_vnsec   = 0;
+    x_uint64_t    xut_sum     = 0;
+
+    while (xut_loops-- > 0)
+    {
+        xszt_text[26] = (x_char_t)('0' + xut_loops % 10);
+        if (0 == time_stov(xszt_text, sizeof(xszt_text) - 1, &xtm_vnsec))
+            xut_sum += xtm_vnsec;
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 遍历应答中的 扩展字段。
+ */
+static x_uint64_t bench_ext_walk(x_uint32_t xut_loops)
+{
+    xntp_view_t xview_pk;
+    xntp_ext_t  xext_this;
+    x_uint32_t  xut_iter = 0;
+    x_uint64_t  xut_sum  = 0;
+
+    while (xut_loops-- > 0)
+    {
+        if (0 != ntpv_init(&xview_pk, g_xbt_pktext, sizeof(g_xbt_pktext)))
+            continue;
+
+        for (xut_iter = 0; ntpv_ext_next(&xview_pk, &xut_iter, &xext_this); )
+            xut_sum += xext_this.xut_type;
+    }
+
+    return xut_sum;
+}
+
+/**********************************************************/
+/**
+ * @brief 认证请求：构建请求，追加 MAC，再建立视图 校验 MAC（即 一次请求 与 一次应答 的认证开销）。
+ * @note
+ * xut_keyid 为 0 时，只 构建请求 并 建立视图（不认证 的 对照基准）。
+ */
+static x_uint64_t bench_mac_round(x_uint32_t xut_keyid, x_uint32_t xut_loops)
+{
+    x_uchar_t   xbt_pack[XNTP_PKT_LEN + XNTP_MAC_MAX];
+    x_uint32_t  xut_mlen = 0;
+    xntp_view_t xview_pk;
+    x_uint64_t  xut_sum  = 0;
+
+    while (xut_loops-- > 0)
+    {
+        ntp_req_init(xbt_pack);
+        ntp_req_stamp(xbt_pack, (xtime_vnsec_t)xut_loops);
+        if ((0 != xut_keyid) && (0 != ntpkey_sign(g_xkey_table, xut_keyid, xbt_pack, XNTP_PKT_LEN, &xut_mlen)))
+            continue;
+
+        if (0 == xut_keyid)
+        {
+            if (0 == ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN))
+                xut_sum += ntpv_originate(&xview_pk);
+            continue;
+        }
+
+        if (0 != ntpv_init(&xview_pk, xbt_pack, XNTP_PKT_LEN + xut_mlen))
+            continue;
+
+        if (0 == ntpkey_verify(g_xkey_table,
+                               ntpv_keyid(&xview_pk),
+                               xbt_pack,
+                               xview_pk.xut_mpos,
+                               ntpv_digest(&xview_pk),
+                               ntpv_digest_len(&xview_pk)))
+        {
+            xut_sum += ntpv_originate(&xview_pk);
+        }
+    }
+
+    return xut_sum;
+}
+
+static x_uint64_t bench_mac_none(x_uint32_t xut_loops)
+{
+    return bench_mac_round(0, xut_loops);
+}
+
+static x_uint64_t bench_mac_md5(x_uint32_t xut_loops)
+{
+    return bench_mac_round(1, xut_loops);
+}
+
+static x_uint64_t bench_mac_sha1(x_uint32_t xut_loops)
+{
+    return bench_mac_round(2, xut_loops);
+}
+
+static x_uint64_t bench_mac_cmac(x_uint32_t xut_loops)
+{
+    return bench_mac_round(3, xut_loops);
+}
+
+/** 所有的 基准测试项 */
+static const xbench_case_t g_xbench_cases[] =
+{
+    { "req_build" , "build request (template + transmit stamp)"  , bench_req_build  },
+    { "parse_48"  , "parse 48-byte reply"                        , bench_parse_48   },
+    { "parse_mac" , "parse reply with MAC"                       , bench_parse_mac  },
+    { "parse_ext" , "parse reply with extension fields and MAC"  , bench_parse_ext  },
+    { "stamp_e0"  , "stamp to vnsec, era 0 only (baseline)"      , bench_stamp_e0   },
+    { "stamp_era" , "stamp to vnsec, era pivoted on local time"  , bench_stamp_era  },
+    { "clock_x2"  , "read raw monotonic clock, then wall clock"  , bench_clock_x2   },
+    { "clock_pair", "paired raw monotonic + wall clock capture"  , bench_clock_pair },
+    { "clock_fast", "raw monotonic clock from calibrated TSC"    , bench_clock_fast },
+    { "vtod_hit"  , "time_vtod, same second (per-thread cache hit)", bench_vtod_hit   },
+    { "vtod_step" , "time_vtod, new second each call (arithmetic)", bench_vtod_step  },
+    { "vtod_miss" , "time_vtod, 2 hours apart (localtime_r path)" , bench_vtod_miss  },
+    { "vtod_tz"   , "time_vtod_tz, New York, 1970 ~ 2199"        , bench_vtod_tz    },
+    { "dtov_tz"   , "time_dtov_tz, New York, 1971 ~ 2199"        , bench_dtov_tz    },
+    { "fmt_printf", "format time via time_vtod + snprintf (baseline)", bench_fmt_printf },
+    { "fmt_ms"    , "format RFC 3339 text, millisecond precision", bench_fmt_ms     },
+    { "fmt_us"    , "format RFC 3339 text, microsecond precision", bench_fmt_us     },
+    { "fmt_ns"    , "format RFC 3339 text, nanosecond precision" , bench_fmt_ns     },
+    { "fmt_batch" , "format RFC 3339 text in batches of 64, ms"  , bench_fmt_batch  },
+    { "fmt_dtos"  , "format time description, local ISO 8601"    , bench_fmt_dtos   },
+    { "parse_stov", "parse RFC 3339 text with offset, ns"        , bench_parse_stov },
+    { "ext_walk"  , "walk extension fields"                      , bench_ext_walk   },
+    { "mac_none"  , "build + parse request, no MAC (baseline)"   , bench_mac_none   },
+    { "mac_md5"   , "sign + verify request, MD5"                 , bench_mac_md5    },
+    { "mac_sha1"  , "sign + verify request, SHA1"                , bench_mac_sha1   },
+    { "mac_cmac"  , "sign + verify request, AES-128-CMAC"        , bench_mac_cmac   },
+};
+
+/** 基准测试项 的数量 */
+#define XBENCH_CASES  ((x_uint32_t)(sizeof(g_xbench_cases) / sizeof(g_xbench_cases[0])))
+
+/**********************************************************/
+/**
+ * @brief 执行 单个基准测试项，并输出 每次操作 的平均耗时。
+ *
+ * @return x_double_t : 返回 每次操作 的 平均耗时（纳秒）。
+ */
+static x_double_t bench_run(const xbench_case_t * xcase_ptr, x_uint32_t xut_loops)
+{
+    xtime_vnsec_t xtm_start = 0;
+    xtime_vnsec_t xtm_spent = 0;
+    x_uint64_t    xut_sink  = 0;
+
+    // 预热
+    xut_sink += xcase_ptr->xfunc_run(xut_loops / 10 + 1);
+
+    xtm_start = time_mono();
+    xut_sink += xcase_ptr->xfunc_run(xut_loops);
+    xtm_spent = time_mono() - xtm_start;
+
+    printf("%-12s : %10.2f ns/op  (%s) [%llu]\n",
+           xcase_ptr->xszt_name,
+           (xtm_spent * 100.0) / (double)xut_loops,
+           xcase_ptr->xszt_desc,
+           (unsigned long long)(xut_sink & 0xF));
+
+    return (xtm_spent * 100.0) / (double)xut_loops;
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    x_uint32_t xut_iter = 0;
+
+    printf("Usage:\n %s [-n <loops>] [<case> ...]\n", xszt_app);
+    printf("\t-n <loops> The number of loops of each case, default 10000000.\n");
+    printf("\t<case>     Run the given cases only, all cases by default :\n");
+    for (xut_iter = 0; xut_iter < XBENCH_CASES; ++xut_iter)
+        printf("\t             %-12s %s\n", g_xbench_cases[xut_iter].xszt_name, g_xbench_cases[xut_iter].xszt_desc);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t  xit_iter  = 0;
+    x_uint32_t xut_iter  = 0;
+    x_uint32_t xut_loops = 10000000;
+    x_bool_t   xbt_all   = X_TRUE;
+    x_int32_t  xit_fail  = 0;
+    x_double_t xlft_base  = 0.0;
+    x_double_t xlft_nsop[XBENCH_CASES];
+
+    for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+    {
+        if ((0 == strcmp("-n", argv[xit_iter])) && ((xit_iter + 1) < argc))
+            xut_loops = (x_uint32_t)atoi(argv[++xit_iter]);
+        else if ((0 == strcmp("-h", argv[xit_iter])) || (0 == strcmp("--help", argv[xit_iter])))
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        else
+            xbt_all = X_FALSE;
+    }
+
+    if (0 == xut_loops)
+        xut_loops = 1;
+
+    memset(xlft_nsop, 0, sizeof(xlft_nsop));
+
+    //======================================
+    // 先校验 被测接口 的正确性
+
+    bench_samples();
+
+    xit_fail = bench_check_view() + bench_check_era() + bench_check_text();
+    if (0 != xit_fail)
+    {
+        printf("%d check(s) failed\n", xit_fail);
+        return 1;
+    }
+
+    g_xkey_table = ntpkey_create();
+    if ((X_NULL == g_xkey_table) ||
+        (0 != ntpkey_add(g_xkey_table, 1, ntp_auth_md5 , (const x_uchar_t *)"bench-md5-key", 13)) ||
+        (0 != ntpkey_add(g_xkey_table, 2, ntp_auth_sha1, (const x_uchar_t *)"bench-sha1-key", 14)) ||
+        (0 != ntpkey_add(g_xkey_table, 3, ntp_auth_cmac, (const x_uchar_t *)"0123456789abcdef", 16)))
+    {
+        printf("authentication unavailable, the mac_* cases measure the failure path only\n");
+    }
+
+    //======================================
+
+    for (xut_iter = 0; xut_iter < XBENCH_CASES; ++xut_iter)
+    {
+        if (!xbt_all)
+        {
+            for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+            {
+                if (0 == strcmp(g_xbench_cases[xut_iter].xszt_name, argv[xit_iter]))
+                    break;
+            }
+
+            if (xit_iter >= argc)
+                continue;
+        }
+
+        xlft_nsop[xut_iter] = bench_run(&g_xbench_cases[xut_iter], xut_loops);
+    }
+
+    //======================================
+    // 认证 相对于 不认证 的 每请求 附加开销（auth_test 的 批量请求 对比 只输出 耗时，不作 校验）
+
+    for (xut_iter = 0; xut_iter < XBENCH_CASES; ++xut_iter)
+    {
+        if (0 == strcmp("mac_none", g_xbench_cases[xut_iter].xszt_name))
+            xlft_base = xlft_nsop[xut_iter];
+    }
+
+    for (xut_iter = 0; (xlft_base > 0.0) && (xut_iter < XBENCH_CASES); ++xut_iter)
+    {
+        if ((0 != strncmp("mac_", g_xbench_cases[xut_iter].xszt_name, 4)) ||
+            (0 == strcmp("mac_none", g_xbench_cases[xut_iter].xszt_name)) ||
+            (xlft_nsop[xut_iter] <= 0.0))
+        {
+            continue;
+        }
+
+        printf("%-12s : +%.2f ns per request over mac_none\n",
+               g_xbench_cases[xut_iter].xszt_name,
+               xlft_nsop[xut_iter] - xlft_base);
+    }
+
+    ntpkey_destroy(g_xkey_table);
+    g_xkey_table = X_NULL;
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,298 @@
+﻿/**
+ * @file clock_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 以 NTP 结果 校准的 TSC 时钟（ntp_clock.h）。
+ * @note
+ * 以 模拟的 NTP 偏移量 直接调用 ntpclk_update()，依次校验：
+ * 未校准时 返回 无效值；首次校准 后 与 “系统时间 + 偏移量” 一致；
+ * 小幅变化 平滑消除、读数 连续且单调；大幅变化 直接跳变；
+ * 模拟 +100ppm 的 频率偏差，校验 频率估计 与 外推误差；最后 测量 读取 的 耗时。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_clock.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 模型 与 “系统时间 + 偏移量” 之间 的 允许误差（100 纳秒） */
+#define XCK_TOLERANCE   50
+
+/** 计算 误差 时 的 读取次数（取 系统时间 读取间隔 最短 的 一次） */
+#define XCK_TRIES       16
+
+/** 模拟的 频率偏差（十亿分之一，ppb） */
+#define XCK_DRIFT       100000LL
+
+/** 频率估计 的 允许误差（ppb）：包含 TSC 标称频率 自身的 误差 */
+#define XCK_FREQ_TOL    5000LL
+
+/** 检查失败的次数 */
+static x_int32_t xit_fail = 0;
+
+#define XCK_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 休眠 指定的 毫秒数。
+ */
+static x_void_t sleep_msec(x_uint32_t xut_msecs)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    Sleep(xut_msecs);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    usleep(xut_msecs * 1000);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief TSC 时钟 相对于 “系统时间 + 偏移量” 的 误差（100 纳秒）。
+ * @note
+ * 以 前后 两次 读取的 系统时间 夹住 TSC 时钟 的 读数，参照值 取 二者 的 中点；
+ * 重复 XCK_TRIES 次，取 间隔 最短 的 一次，以免 两次读取 之间 被抢占 造成 误判。
+ */
+static x_int64_t clock_error(x_int64_t xit_offset)
+{
+    x_int64_t  xit_prev  = 0;
+    x_int64_t  xit_now   = 0;
+    x_int64_t  xit_next  = 0;
+    x_int64_t  xit_span  = 0;
+    x_int64_t  xit_error = 0;
+    x_uint32_t xut_iter  = 0;
+
+    for (xut_iter = 0; xut_iter < XCK_TRIES; ++xut_iter)
+    {
+        xit_prev = (x_int64_t)time_vnsec();
+        xit_now  = (x_int64_t)ntpclk_now();
+        xit_next = (x_int64_t)time_vnsec();
+
+        if ((0 == xut_iter) || ((xit_next - xit_prev) < xit_span))
+        {
+            xit_span  = xit_next - xit_prev;
+            xit_error = xit_now - (xit_prev + xit_span / 2 + xit_offset);
+        }
+    }
+
+    return xit_error;
+}
+
+/**********************************************************/
+/**
+ * @brief 在 xut_msecs 毫秒内 反复读取，校验 读数 单调不减；返回 读取次数（失败 返回 0）。
+ */
+static x_uint32_t clock_monotonic(x_uint32_t xut_msecs)
+{
+    xtime_vnsec_t xtm_until = time_mono() + xut_msecs * XTIME_VNSEC_MSEC;
+    x_uint64_t    xut_last  = ntpclk_now_ns();
+    x_uint64_t    xut_curr  = 0;
+    x_uint32_t    xut_count = 0;
+
+    while (time_mono() < xtm_until)
+    {
+        xut_curr = ntpclk_now_ns();
+        if (xut_curr < xut_last)
+        {
+            printf("clock goes back : %llu -> %llu\n", xut_last, xut_curr);
+            return 0;
+        }
+
+        xut_last   = xut_curr;
+        xut_count += 1;
+    }
+
+    return xut_count;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 校验 首次校准、平滑调整 与 跳变。
+ */
+static x_void_t check_phase(void)
+{
+    xntp_clkstat_t xstat;
+    x_int64_t      xit_offset = 5 * XTIME_VNSEC_MSEC;
+    x_uint64_t     xut_before = 0;
+    x_uint64_t     xut_after  = 0;
+
+    ntpclk_reset();
+    XCK_CHECK(XTIME_INVALID_VNSEC == ntpclk_now());
+    XCK_CHECK(0 == ntpclk_now_ns());
+
+    //======================================
+    // 首次校准：跳变
+
+    XCK_CHECK(0 == ntpclk_update(xit_offset));
+    ntpclk_stat(&xstat);
+    XCK_CHECK(xstat.xbt_valid && (1 == xstat.xut_updates) && (1 == xstat.xut_steps));
+    XCK_CHECK(llabs(clock_error(xit_offset)) < XCK_TOLERANCE);
+
+    //======================================
+    // 偏移量 增加 0.1 毫秒：读数 连续，约 1 秒后 消除误差
+
+    sleep_msec(200);
+    xit_offset += XTIME_VNSEC_MSEC / 10;
+    xut_before = ntpclk_now_ns();
+    XCK_CHECK(0 == ntpclk_update(xit_offset));
+    xut_after  = ntpclk_now_ns();
+    ntpclk_stat(&xstat);
+    XCK_CHECK((2 == xstat.xut_updates) && (1 == xstat.xut_steps));
+    XCK_CHECK((xstat.xit_phase > 90000) && (xstat.xit_phase < 110000));
+    XCK_CHECK((xut_after >= xut_before) && (xut_after - xut_before < 100000ULL));
+    XCK_CHECK(clock_error(xit_offset) < -(x_int64_t)(XTIME_VNSEC_MSEC / 20));
+
+    XCK_CHECK(0 != clock_monotonic(1100));
+    XCK_CHECK(llabs(clock_error(xit_offset)) < XCK_TOLERANCE);
+
+    //======================================
+    // 偏移量 减少 300 毫秒：直接跳变
+
+    xit_offset -= 300 * XTIME_VNSEC_MSEC;
+    XCK_CHECK(0 == ntpclk_update(xit_offset));
+    ntpclk_stat(&xstat);
+    XCK_CHECK((3 == xstat.xut_updates) && (2 == xstat.xut_steps));
+    XCK_CHECK(llabs(clock_error(xit_offset)) < XCK_TOLERANCE);
+
+    printf("phase : updates %u, steps %u, last phase %lld ns\n",
+           xstat.xut_updates, xstat.xut_steps, xstat.xit_phase);
+}
+
+/**********************************************************/
+/**
+ * @brief 模拟 +100ppm 的 频率偏差（偏移量 随时间 线性增长），校验 频率估计 与 外推误差。
+ */
+static x_void_t check_freq(void)
+{
+    xntp_clkstat_t xstat;
+    xtime_vnsec_t  xtm_start  = time_mono();
+    x_int64_t      xit_offset = 0;
+    x_int64_t      xit_error  = 0;
+    x_uint32_t     xut_iter   = 0;
+
+    ntpclk_reset();
+
+    for (xut_iter = 0; xut_iter < 40; ++xut_iter)
+    {
+        xit_offset = (x_int64_t)(time_mono() - xtm_start) * XCK_DRIFT / 1000000000LL;
+        XCK_CHECK(0 == ntpclk_update(xit_offset));
+        sleep_msec(250);
+    }
+
+    ntpclk_stat(&xstat);
+    printf("freq  : estimated %lld ppb, expected %lld ppb\n", xstat.xit_freq, XCK_DRIFT);
+    XCK_CHECK((xstat.xit_freq > XCK_DRIFT - XCK_FREQ_TOL) && (xstat.xit_freq < XCK_DRIFT + XCK_FREQ_TOL));
+
+    // 停止校准 1 秒后，外推误差 只来自 频率估计 的 误差
+    sleep_msec(1000);
+    xit_offset = (x_int64_t)(time_mono() - xtm_start) * XCK_DRIFT / 1000000000LL;
+    xit_error  = clock_error(xit_offset);
+    printf("freq  : error after 1 s without update %lld x 100 ns\n", xit_error);
+    XCK_CHECK(llabs(xit_error) < 100);
+}
+
+/**********************************************************/
+/**
+ * @brief 测量 ntpclk_now() 与 time_vnsec() 的 耗时。
+ */
+static x_void_t bench_read(x_uint32_t xut_count)
+{
+    x_uint32_t    xut_iter = 0;
+    x_uint64_t    xut_sum  = 0;
+    xtime_vnsec_t xtm_tsc  = 0;
+    xtime_vnsec_t xtm_sys  = 0;
+
+    xtm_tsc = time_mono();
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+        xut_sum += ntpclk_now();
+    xtm_tsc = time_mono() - xtm_tsc;
+
+    xtm_sys = time_mono();
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+        xut_sum += time_vnsec();
+    xtm_sys = time_mono() - xtm_sys;
+
+    printf("bench : ntpclk_now() %.2f ns, time_vnsec() %.2f ns [%llu]\n",
+           xtm_tsc * 100.0 / xut_count,
+           xtm_sys * 100.0 / xut_count,
+           xut_sum & 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_uint32_t xut_count = 10000000;
+
+    if (argc > 1)
+    {
+        xut_count = (x_uint32_t)atoi(argv[1]);
+    }
+
+    if (0 == time_tsc_freq())
+    {
+        printf("TSC is not available, skipped.\n");
+        return 0;
+    }
+
+    XCK_CHECK(ENOTSUP != ntpclk_update(0));
+
+    check_phase();
+    check_freq();
+    bench_read(xut_count);
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+    return (0 == xit_fail) ? 0 : 1;
+}
@@ -0,0 +1,413 @@
+﻿/**
+ * @file cxx_test.cpp
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 C++20 封装（ntp_client.hpp）：RAII 客户端对象、co_await 请求、when_all()、取消 与 std::future。
+ * @note
+ * 简易服务端 在 独立的 线程 中 运行：127.0.0.1 以 领先 5 秒 的 时钟 应答，127.0.0.3 收到请求 后 不应答；
+ * 各个 协程 与 select_loop 在 主线程 中 运行。
+ */
+
+#include "ntp_client.hpp"
+#include "xtest_server.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 毫秒、1 秒 对应的 时间计量值 */
+#define XCX_MSEC        ((x_int64_t)XTIME_VNSEC_MSEC)
+#define XCX_SEC         (1000 * XCX_MSEC)
+
+/** 服务端时钟 领先 本地时钟 的 偏差 */
+#define XCX_OFFSET      (5 * XCX_SEC)
+
+/** 偏移量 允许的 误差 */
+#define XCX_TOLERANCE   (20 * XCX_MSEC)
+
+/** 两个 服务端 地址 */
+#define XCX_ADDR_GOOD   0x7F000001
+#define XCX_ADDR_MUTE   0x7F000003
+
+/** 检查 内存分配 的 循环次数 */
+#define XCX_LOOPS       64
+
+static x_int32_t xit_fail = 0;
+
+#define XCX_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+// 替换的 operator new/delete 以 malloc()/free() 实现，GCC 内联后 会误报 二者 不匹配
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+
+/** operator new 的 调用次数 */
+static std::atomic<x_uint32_t> xut_news{ 0 };
+
+void * operator new(std::size_t xst_size)
+{
+    xut_news.fetch_add(1, std::memory_order_relaxed);
+    void * xpvt_mptr = std::malloc((0 != xst_size) ? xst_size : 1);
+    if (nullptr == xpvt_mptr)
+        throw std::bad_alloc();
+    return xpvt_mptr;
+}
+
+void operator delete(void * xpvt_mptr) noexcept
+{
+    std::free(xpvt_mptr);
+}
+
+void operator delete(void * xpvt_mptr, std::size_t) noexcept
+{
+    std::free(xpvt_mptr);
+}
+
+//====================================================================
+
+/** 所有的 服务端 */
+static xtest_server_t xsrv_list[2];
+
+/**********************************************************/
+/**
+ * @brief 127.0.0.3 的 应答：收到请求 后 不应答。
+ */
+static x_uint32_t mute_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    (x_void_t)xsrv_ptr;
+    (x_void_t)xbt_rbuf;
+    (x_void_t)xview_req;
+    (x_void_t)xbt_sbuf;
+
+    return 0;
+}
+
+//====================================================================
+
+/**
+ * @struct xcx_task_t
+ * @brief  测试用的 协程类型：立即执行，结束后 自行销毁（不返回 结果）。
+ */
+struct xcx_task_t
+{
+    struct promise_type
+    {
+        xcx_task_t get_return_object(void) noexcept { return {}; }
+        std::suspend_never initial_suspend(void) noexcept { return {}; }
+        std::suspend_never final_suspend(void) noexcept { return {}; }
+        void return_void(void) noexcept { }
+        void unhandled_exception(void) noexcept { std::abort(); }
+    };
+};
+
+/**********************************************************/
+/**
+ * @brief 判断 样本 是否 为 127.0.0.1 的 正常结果。
+ */
+static bool sample_good(const xntp::sample & xsample)
+{
+    return ((0 == xsample.xit_errno) &&
+            (XCX_ADDR_GOOD == xsample.xut_ipv4) &&
+            XTMVNSEC_IS_VALID(xsample.xtm_vnsec) &&
+            (xsample.xit_offset > XCX_OFFSET - XCX_TOLERANCE) &&
+            (xsample.xit_offset < XCX_OFFSET + XCX_TOLERANCE));
+}
+
+/**********************************************************/
+/**
+ * @brief 协程：单个请求。
+ */
+static xcx_task_t task_single(xntp::client & xcli_this, xntp::select_loop & xloop, xntp::sample & xsample, bool & xbt_done)
+{
+    xsample  = co_await xcli_this.query(xloop, time_mono() + XCX_SEC);
+    xbt_done = true;
+}
+
+/**********************************************************/
+/**
+ * @brief 协程：同时 向 三个 服务端 请求（其中 一个 不应答）。
+ */
+static xcx_task_t task_all(xntp::client & xcli_good,
+                           xntp::client & xcli_mute,
+                           xntp::client & xcli_next,
+                           xntp::select_loop & xloop,
+                           std::array<xntp::sample, 3> & xsamples,
+                           bool & xbt_done)
+{
+    xtime_vnsec_t xtm_dline = time_mono() + 300 * XCX_MSEC;
+
+    xsamples = co_await xntp::when_all(xcli_good.query(xloop, xtm_dline),
+                                       xcli_mute.query(xloop, xtm_dline),
+                                       xcli_next.query(xloop, xtm_dline));
+    xbt_done = true;
+}
+
+/**********************************************************/
+/**
+ * @brief 协程：可取消的 请求。
+ */
+static xcx_task_t task_cancel(xntp::client & xcli_this,
+                              xntp::select_loop & xloop,
+                              std::stop_token xstop_tok,
+                              xntp::sample & xsample,
+                              bool & xbt_done)
+{
+    xsample  = co_await xcli_this.query(xloop, time_mono() + 5 * XCX_SEC, std::move(xstop_tok));
+    xbt_done = true;
+}
+
+/**********************************************************/
+/**
+ * @brief 协程：循环 请求，统计 循环期间 operator new 的 调用次数。
+ */
+static xcx_task_t task_loop(xntp::client & xcli_this,
+                            xntp::select_loop & xloop,
+                            x_uint32_t & xut_good,
+                            x_uint32_t & xut_allocs,
+                            bool & xbt_done)
+{
+    x_uint32_t xut_start = xut_news.load();
+
+    for (x_uint32_t xut_iter = 0; xut_iter < XCX_LOOPS; ++xut_iter)
+    {
+        if (sample_good(co_await xcli_this.query(xloop, time_mono() + XCX_SEC)))
+            xut_good += 1;
+    }
+
+    xut_allocs = xut_news.load() - xut_start;
+    xbt_done   = true;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 检查 RAII 客户端对象。
+ */
+static x_void_t check_client(void)
+{
+    bool              xbt_thrown = false;
+    xntp::select_loop xloop;
+    x_char_t          xszt_host[300];
+
+    // 设置 失败 时 抛出 异常
+    std::memset(xszt_host, 'x', sizeof(xszt_host) - 1);
+    xszt_host[sizeof(xszt_host) - 1] = '\0';
+
+    try
+    {
+        xntp::client xcli_long(xszt_host, NTP_PORT);
+        (x_void_t)xcli_long;
+    }
+    catch (const std::system_error & xerr)
+    {
+        xbt_thrown = (EINVAL == xerr.code().value());
+    }
+    XCX_CHECK(xbt_thrown);
+
+    // 域名 在 请求 时 才 解析：解析失败 以 错误码 结束
+    {
+        xntp::client  xcli_bad("xntp.cxx.invalid", NTP_PORT);
+        xntp::request xreq = xcli_bad.query(xloop, time_mono() + XCX_SEC);
+        XCX_CHECK(0 != xloop.wait(xreq).xit_errno);
+        XCX_CHECK(xloop.empty());
+    }
+
+    xntp::client xcli_this("127.0.0.1", xsrv_list[0].xut_port);
+    XCX_CHECK(nullptr != xcli_this.get());
+
+    xntp::client xcli_move(std::move(xcli_this));
+    XCX_CHECK(nullptr == xcli_this.get());
+    XCX_CHECK(nullptr != xcli_move.get());
+
+    xcli_this = std::move(xcli_move);
+    XCX_CHECK(nullptr != xcli_this.get());
+    XCX_CHECK(nullptr == xcli_move.get());
+}
+
+/**********************************************************/
+/**
+ * @brief 检查 单个 co_await 请求 与 when_all()。
+ */
+static x_void_t check_await(xntp::client & xcli_good, xntp::client & xcli_mute)
+{
+    xntp::select_loop           xloop;
+    xntp::client                xcli_next("127.0.0.1", xsrv_list[0].xut_port);
+    xntp::sample                xsample;
+    std::array<xntp::sample, 3> xsamples;
+    bool                        xbt_done = false;
+    xtime_vnsec_t               xtm_start = XTIME_INVALID_VNSEC;
+
+    task_single(xcli_good, xloop, xsample, xbt_done);
+    XCX_CHECK(!xbt_done);
+    XCX_CHECK(!xloop.empty());
+    xloop.run();
+    XCX_CHECK(xbt_done);
+    XCX_CHECK(sample_good(xsample));
+
+    //======================================
+    // when_all()：结束于 不应答 的 服务端 的 截止时间，结果 与 参数 顺序 相同
+
+    xbt_done  = false;
+    xtm_start = time_mono();
+    task_all(xcli_good, xcli_mute, xcli_next, xloop, xsamples, xbt_done);
+    xloop.run();
+    XCX_CHECK(xbt_done);
+    XCX_CHECK(time_mono() - xtm_start >= 250 * XCX_MSEC);
+    XCX_CHECK(sample_good(xsamples[0]));
+    XCX_CHECK(ETIMEDOUT == xsamples[1].xit_errno);
+    XCX_CHECK(sample_good(xsamples[2]));
+}
+
+/**********************************************************/
+/**
+ * @brief 检查 std::stop_token 取消。
+ */
+static x_void_t check_cancel(xntp::client & xcli_mute)
+{
+    xntp::select_loop xloop;
+    xntp::sample      xsample;
+    bool              xbt_done = false;
+
+    // 进行中的 请求 被 取消：立即 恢复 协程
+    {
+        std::stop_source xstop_src;
+
+        task_cancel(xcli_mute, xloop, xstop_src.get_token(), xsample, xbt_done);
+        xloop.run_once(50 * XCX_MSEC);
+        XCX_CHECK(!xbt_done);
+
+        xstop_src.request_stop();
+        XCX_CHECK(xbt_done);
+        XCX_CHECK(ECANCELED == xsample.xit_errno);
+        XCX_CHECK(xloop.empty());
+    }
+
+    // 开始之前 已被 取消：不挂起
+    {
+        std::stop_source xstop_src;
+
+        xstop_src.request_stop();
+        xbt_done = false;
+        task_cancel(xcli_mute, xloop, xstop_src.get_token(), xsample, xbt_done);
+        XCX_CHECK(xbt_done);
+        XCX_CHECK(ECANCELED == xsample.xit_errno);
+        XCX_CHECK(xloop.empty());
+    }
+
+    // 客户端对象 的 工作通道 已 归还：仍可 正常请求
+    {
+        xntp::request xreq = xcli_mute.query(xloop, time_mono() + 100 * XCX_MSEC);
+        XCX_CHECK(ETIMEDOUT == xloop.wait(xreq).xit_errno);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 检查 std::future 形式的 请求，与 循环请求 的 内存分配。
+ */
+static x_void_t check_future(xntp::client & xcli_good)
+{
+    xntp::select_loop   xloop;
+    x_uint32_t          xut_good   = 0;
+    x_uint32_t          xut_allocs = 0;
+    bool                xbt_done   = false;
+    std::future<xntp::sample> xfut_this = xcli_good.query_future(time_mono() + XCX_SEC);
+
+    XCX_CHECK(xfut_this.valid());
+    XCX_CHECK(sample_good(xfut_this.get()));
+
+    task_loop(xcli_good, xloop, xut_good, xut_allocs, xbt_done);
+    xloop.run();
+    XCX_CHECK(xbt_done);
+    XCX_CHECK(XCX_LOOPS == xut_good);
+    XCX_CHECK(0 == xut_allocs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_uint32_t xut_iter = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA    xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    (x_void_t)argc;
+    (x_void_t)argv;
+
+    //======================================
+
+    std::memset(xsrv_list, 0, sizeof(xsrv_list));
+    xsrv_list[0].xut_ipv4    = XCX_ADDR_GOOD;
+    xsrv_list[1].xut_ipv4    = XCX_ADDR_MUTE;
+    xsrv_list[1].xfunc_reply = mute_reply;
+
+    for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+    {
+        xsrv_list[xut_iter].xit_offset = XCX_OFFSET;
+        if (0 != xtest_server_start(&xsrv_list[xut_iter]))
+        {
+            printf("xtest_server_start() failed, errno : %d\n", errno);
+            while (xut_iter-- > 0)
+                xtest_server_stop(&xsrv_list[xut_iter]);
+            return 1;
+        }
+    }
+
+    //======================================
+
+    try
+    {
+        xntp::client xcli_good("127.0.0.1", xsrv_list[0].xut_port);
+        xntp::client xcli_mute("127.0.0.3", xsrv_list[1].xut_port);
+
+        check_client();
+        check_await(xcli_good, xcli_mute);
+        check_cancel(xcli_mute);
+        check_future(xcli_good);
+    }
+    catch (const std::system_error & xerr)
+    {
+        printf("unexpected exception : %s\n", xerr.what());
+        xit_fail += 1;
+    }
+
+    //======================================
+
+    for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+        xtest_server_stop(&xsrv_list[xut_iter]);
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    return (0 == xit_fail) ? 0 : 1;
+}
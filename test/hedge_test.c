@@ -0,0 +1,437 @@
+﻿/**
+ * @file hedge_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 对冲请求（hedged request）的 尾延迟、预算 与 往返时延 统计。
+ * @note
+ * 在 本机回环地址 上 启动 两个 时钟 领先 5 秒 的 简易服务端（同一端口）：127.0.0.1 与 127.0.0.2，
+ * 各自 可设置 T2 与 T3 之间的 固定延迟 与 随机延迟；127.0.0.3 没有 服务端。
+ * 各个地址 经 状态文件 作为 同一域名 的 地址缓存 载入，缓存中的 首个地址 即为 主请求 的 地址。
+ */
+
+#include "ntp_client.h"
+#include "ntp_state.h"
+#include "xtest_server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 毫秒、1 秒 对应的 时间计量值 */
+#define XHG_MSEC        ((x_int64_t)XTIME_VNSEC_MSEC)
+#define XHG_SEC         (1000 * XHG_MSEC)
+
+/** 服务端时钟 领先 本地时钟 的 偏差 */
+#define XHG_OFFSET      (5 * XHG_SEC)
+
+/** 测试用的 状态文件 与 域名 */
+#define XHG_FILE        "hedge_test.dat"
+#define XHG_HOST        "xntp.hedge.invalid"
+
+/** 三个 服务端 地址 */
+#define XHG_ADDR_A      0x7F000001
+#define XHG_ADDR_B      0x7F000002
+#define XHG_ADDR_DEAD   0x7F000003
+
+/** 校验 预算 的 请求数量 */
+#define XHG_LOOPS       200
+
+static x_int32_t xit_fail = 0;
+
+#define XHG_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+/**
+ * @struct xhg_server_t
+ * @brief  简易 NTP 服务端 与 其 应答延迟。
+ */
+typedef struct xhg_server_t
+{
+    xtest_server_t      xsrv_base;  ///< 简易服务端（时钟 领先 XHG_OFFSET）
+    volatile x_uint32_t xut_delay;  ///< 应答前的 固定延迟（毫秒，在 T2 与 T3 之间）
+    volatile x_uint32_t xut_jitter; ///< 应答前的 随机延迟 上限（毫秒，0 表示 无）
+} xhg_server_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 服务端 的 应答：记录 T2 后 延迟，再 记录 T3。
+ */
+static x_uint32_t delay_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    xhg_server_t * xhg_ptr  = (xhg_server_t *)xsrv_ptr->xpvt_ctx;
+    x_uint64_t     xut_recv = xtest_server_stamp(xsrv_ptr);
+    x_uint32_t     xut_wait = xhg_ptr->xut_delay;
+
+    (x_void_t)xbt_rbuf;
+
+    // 延迟 发生在 T2 与 T3 之间（服务端 处理慢），不影响 偏移量
+    if (0 != xhg_ptr->xut_jitter)
+        xut_wait += (x_uint32_t)(rand() % (xhg_ptr->xut_jitter + 1));
+    if (0 != xut_wait)
+        xtest_sleep_msec(xut_wait);
+
+    xtest_server_reply(xsrv_ptr, xview_req, xbt_sbuf);
+    ntp_store64(xbt_sbuf + XNTP_OFF_RECEIVE, xut_recv);
+
+    return XNTP_PKT_LEN;
+}
+
+/**********************************************************/
+/**
+ * @brief 建立 服务端 并 在 独立的 线程 中 运行（xut_port 取 0 时 为 随机端口）。
+ */
+static x_int32_t server_start(xhg_server_t * xsrv_ptr, x_uint32_t xut_ipv4, x_uint16_t xut_port)
+{
+    memset(xsrv_ptr, 0, sizeof(xhg_server_t));
+    xsrv_ptr->xsrv_base.xut_ipv4    = xut_ipv4;
+    xsrv_ptr->xsrv_base.xut_port    = xut_port;
+    xsrv_ptr->xsrv_base.xit_offset  = XHG_OFFSET;
+    xsrv_ptr->xsrv_base.xfunc_reply = delay_reply;
+    xsrv_ptr->xsrv_base.xpvt_ctx    = xsrv_ptr;
+
+    return xtest_server_start(&xsrv_ptr->xsrv_base);
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 打开 客户端：XHG_HOST 的 地址缓存 为 xut_addrs（经 状态文件 载入），并 设置 对冲预算。
+ */
+static xntp_cliptr_t client_open(x_uint16_t xut_port, x_uint32_t xut_addr0, x_uint32_t xut_addr1, x_uint32_t xut_budget)
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+    xntp_state_t  xstate;
+
+    memset(&xstate, 0, sizeof(xntp_state_t));
+    xstate.xtm_saved    = time_vnsec();
+    strcpy(xstate.xszt_host, XHG_HOST);
+    xstate.xut_port     = xut_port;
+    xstate.xut_naddr    = 2;
+    xstate.xut_addrs[0] = xut_addr0;
+    xstate.xut_addrs[1] = xut_addr1;
+    xstate.xtm_expire   = xstate.xtm_saved + 3600 * XHG_SEC;
+    XHG_CHECK(0 == ntpstate_save(XHG_FILE, &xstate));
+
+    xntp_this = ntpcli_open();
+    if (X_NULL == xntp_this)
+    {
+        XHG_CHECK(X_NULL != xntp_this);
+        return X_NULL;
+    }
+
+    XHG_CHECK(0 == ntpcli_config(xntp_this, XHG_HOST, xut_port));
+    XHG_CHECK(0 == ntpcli_state(xntp_this, XHG_FILE));
+    XHG_CHECK(0 == ntpcli_hedge(xntp_this, xut_budget));
+
+    return xntp_this;
+}
+
+/**********************************************************/
+/**
+ * @brief 请求 一次，返回 耗时（毫秒）；xbt_valid 返回 是否 得到 有效的 时间戳。
+ */
+static x_uint32_t client_req(xntp_cliptr_t xntp_this, x_uint32_t xut_tmout, x_bool_t * xbt_valid)
+{
+    xtime_vnsec_t xtm_start = time_mono();
+    xtime_vnsec_t xtm_value = ntpcli_req_time(xntp_this, xut_tmout);
+    x_int64_t     xit_error = (x_int64_t)xtm_value - ((x_int64_t)time_vnsec() + XHG_OFFSET);
+
+    *xbt_valid = XTMVNSEC_IS_VALID(xtm_value) && (xit_error > -50 * XHG_MSEC) && (xit_error < 50 * XHG_MSEC);
+
+    return (x_uint32_t)((time_mono() - xtm_start) / XTIME_VNSEC_MSEC);
+}
+
+/**********************************************************/
+/**
+ * @brief 查找 地址 的 往返时延 统计。
+ */
+static const xntp_rtt_t * rtt_find(const xntp_hedge_t * xhedge_ptr, x_uint32_t xut_ipv4)
+{
+    x_uint32_t xut_iter = 0;
+
+    for (xut_iter = 0; xut_iter < XNTP_STATE_ADDRS; ++xut_iter)
+    {
+        if (xut_ipv4 == xhedge_ptr->xrtt_list[xut_iter].xut_ipv4)
+            return &xhedge_ptr->xrtt_list[xut_iter];
+    }
+
+    return X_NULL;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 校验 参数检查，以及 未开启 对冲 时 与 原有行为 一致（依次请求）。
+ */
+static x_void_t check_basic(xhg_server_t * xsrv_a)
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+    xntp_hedge_t  xhedge;
+    x_uint32_t    xut_msec  = 0;
+    x_bool_t      xbt_valid = X_FALSE;
+
+    XHG_CHECK(EINVAL == ntpcli_hedge(X_NULL, XNTP_HEDGE_BUDGET));
+    XHG_CHECK(EINVAL == ntpcli_hedge_stat(X_NULL, &xhedge));
+
+    xntp_this = client_open(xsrv_a->xsrv_base.xut_port, XHG_ADDR_A, XHG_ADDR_B, 0);
+    if (X_NULL == xntp_this)
+        return;
+
+    XHG_CHECK(EINVAL == ntpcli_hedge(xntp_this, 1001));
+    XHG_CHECK(EINVAL == ntpcli_hedge_stat(xntp_this, X_NULL));
+
+    // 主请求 的 地址 延迟 300 毫秒：未开启 对冲，等待 其应答
+    xsrv_a->xut_delay = 300;
+    xut_msec = client_req(xntp_this, 2000, &xbt_valid);
+    xsrv_a->xut_delay = 0;
+    printf("hedge off, slow primary : %u ms\n", xut_msec);
+    XHG_CHECK(xbt_valid && (xut_msec >= 290));
+
+    XHG_CHECK(0 == ntpcli_hedge_stat(xntp_this, &xhedge));
+    XHG_CHECK((0 == xhedge.xut_requests) && (0 == xhedge.xut_hedges) && (0 == xhedge.xut_wins));
+    XHG_CHECK(X_NULL == rtt_find(&xhedge, XHG_ADDR_A));
+
+    ntpcli_close(xntp_this);
+
+    // 主请求 的 地址 不应答：未开启 对冲，等满 一半的 超时时间 后 请求 第二个地址
+    xntp_this = client_open(xsrv_a->xsrv_base.xut_port, XHG_ADDR_DEAD, XHG_ADDR_B, 0);
+    if (X_NULL == xntp_this)
+        return;
+
+    xut_msec = client_req(xntp_this, 600, &xbt_valid);
+    printf("hedge off, dead primary : %u ms\n", xut_msec);
+    XHG_CHECK(xbt_valid && (xut_msec >= 290) && (xut_msec < 590));
+
+    ntpcli_close(xntp_this);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 对冲 消除 主请求 的 尾延迟，并 在线更新 往返时延 统计。
+ */
+static x_void_t check_tail(xhg_server_t * xsrv_a, xhg_server_t * xsrv_b)
+{
+    xntp_cliptr_t      xntp_this = X_NULL;
+    xntp_hedge_t       xhedge;
+    const xntp_rtt_t * xrtt_a    = X_NULL;
+    x_uint32_t         xut_msec  = 0;
+    x_uint32_t         xut_iter  = 0;
+    x_uint32_t         xut_good  = 0;
+    x_uint32_t         xut_a     = 0;
+    x_uint32_t         xut_b     = 0;
+    x_bool_t           xbt_valid = X_FALSE;
+
+    //======================================
+    // 主请求 的 地址 不应答：尚无 统计，XNTP_HEDGE_INIT（250 毫秒）后 对冲
+
+    xntp_this = client_open(xsrv_a->xsrv_base.xut_port, XHG_ADDR_DEAD, XHG_ADDR_B, XNTP_HEDGE_BUDGET);
+    if (X_NULL == xntp_this)
+        return;
+
+    xut_msec = client_req(xntp_this, 2000, &xbt_valid);
+    printf("hedge on, dead primary : %u ms\n", xut_msec);
+    XHG_CHECK(xbt_valid && (xut_msec >= 240) && (xut_msec < 1000));
+
+    XHG_CHECK(0 == ntpcli_hedge_stat(xntp_this, &xhedge));
+    XHG_CHECK((1 == xhedge.xut_requests) && (1 == xhedge.xut_hedges) && (1 == xhedge.xut_wins));
+    XHG_CHECK((X_NULL != rtt_find(&xhedge, XHG_ADDR_B)) && (1 == rtt_find(&xhedge, XHG_ADDR_B)->xut_count));
+    XHG_CHECK(X_NULL == rtt_find(&xhedge, XHG_ADDR_DEAD));
+
+    // 先应答的 地址 移到 缓存首位：此后 的 主请求 即为 该地址，不再 对冲
+    xut_b    = xsrv_b->xsrv_base.xut_recvd;
+    xut_msec = client_req(xntp_this, 2000, &xbt_valid);
+    XHG_CHECK(xbt_valid && (xut_msec < 100) && (1 == xsrv_b->xsrv_base.xut_recvd - xut_b));
+
+    ntpcli_close(xntp_this);
+
+    //======================================
+    // 预热 往返时延 统计，之后 主请求 的 地址 突然 变慢
+
+    xntp_this = client_open(xsrv_a->xsrv_base.xut_port, XHG_ADDR_A, XHG_ADDR_B, XNTP_HEDGE_BUDGET);
+    if (X_NULL == xntp_this)
+        return;
+
+    for (xut_iter = 0, xut_good = 0; xut_iter < 20; ++xut_iter)
+    {
+        client_req(xntp_this, 2000, &xbt_valid);
+        xut_good += xbt_valid ? 1 : 0;
+    }
+
+    XHG_CHECK(20 == xut_good);
+    XHG_CHECK(0 == ntpcli_hedge_stat(xntp_this, &xhedge));
+    xrtt_a = rtt_find(&xhedge, XHG_ADDR_A);
+    XHG_CHECK((20 == xhedge.xut_requests) && (xhedge.xut_hedges <= 2));
+    XHG_CHECK((X_NULL != xrtt_a) && (xrtt_a->xut_count >= 4) && (xrtt_a->xut_srtt < 10 * XHG_MSEC));
+    if (X_NULL != xrtt_a)
+    {
+        printf("warm rtt of A : %u samples, srtt %u us, rttvar %u us\n",
+               xrtt_a->xut_count, xrtt_a->xut_srtt / 10, xrtt_a->xut_rttvar / 10);
+    }
+
+    xsrv_a->xut_delay = 300;
+    xut_a    = xsrv_a->xsrv_base.xut_recvd;
+    xut_b    = xsrv_b->xsrv_base.xut_recvd;
+    xut_msec = client_req(xntp_this, 2000, &xbt_valid);
+    printf("hedge on, slow primary : %u ms\n", xut_msec);
+    XHG_CHECK(xbt_valid && (xut_msec < 100));
+    XHG_CHECK((1 == xsrv_b->xsrv_base.xut_recvd - xut_b) && (xsrv_a->xsrv_base.xut_recvd - xut_a <= 1));
+
+    // 之后的 请求 主请求 为 先应答的 地址
+    xut_msec = client_req(xntp_this, 2000, &xbt_valid);
+    XHG_CHECK(xbt_valid && (xut_msec < 100));
+    xtest_sleep_msec(350);
+    xsrv_a->xut_delay = 0;
+
+    ntpcli_close(xntp_this);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 预算：对冲请求 不超过 请求数量 的 预算比例 加 1 次。
+ */
+static x_void_t check_budget(xhg_server_t * xsrv_a, xhg_server_t * xsrv_b)
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+    xntp_hedge_t  xhedge;
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_good  = 0;
+    x_uint32_t    xut_a     = 0;
+    x_uint32_t    xut_b     = 0;
+    x_bool_t      xbt_valid = X_FALSE;
+
+    //======================================
+    // 两个地址 均 随机延迟 0 ~ 10 毫秒：p95 之外 的 尾部 按预算 对冲
+
+    xsrv_a->xut_jitter = 10;
+    xsrv_b->xut_jitter = 10;
+
+    xntp_this = client_open(xsrv_a->xsrv_base.xut_port, XHG_ADDR_A, XHG_ADDR_B, XNTP_HEDGE_BUDGET);
+    if (X_NULL == xntp_this)
+        return;
+
+    for (xut_iter = 0; xut_iter < XHG_LOOPS; ++xut_iter)
+    {
+        client_req(xntp_this, 2000, &xbt_valid);
+        xut_good += xbt_valid ? 1 : 0;
+    }
+
+    XHG_CHECK(0 == ntpcli_hedge_stat(xntp_this, &xhedge));
+    printf("jitter : %u requests, %u hedges, %u wins\n", xhedge.xut_requests, xhedge.xut_hedges, xhedge.xut_wins);
+    XHG_CHECK(XHG_LOOPS == xut_good);
+    XHG_CHECK(XHG_LOOPS == xhedge.xut_requests);
+    XHG_CHECK(xhedge.xut_hedges <= XHG_LOOPS * XNTP_HEDGE_BUDGET / 1000 + 1);
+    XHG_CHECK(xhedge.xut_wins <= xhedge.xut_hedges);
+
+    ntpcli_close(xntp_this);
+
+    xsrv_a->xut_jitter = 0;
+    xsrv_b->xut_jitter = 0;
+    xtest_sleep_msec(50);
+
+    //======================================
+    // 预算 用尽：两个地址 均 延迟 300 毫秒，只有 首次请求 对冲
+
+    xsrv_a->xut_delay = 300;
+    xsrv_b->xut_delay = 300;
+
+    xntp_this = client_open(xsrv_a->xsrv_base.xut_port, XHG_ADDR_A, XHG_ADDR_B, 1);
+    if (X_NULL == xntp_this)
+        return;
+
+    xut_a = xsrv_a->xsrv_base.xut_recvd;
+    xut_b = xsrv_b->xsrv_base.xut_recvd;
+    client_req(xntp_this, 2000, &xbt_valid);
+    XHG_CHECK(xbt_valid && (1 == xsrv_a->xsrv_base.xut_recvd - xut_a) && (1 == xsrv_b->xsrv_base.xut_recvd - xut_b));
+
+    xtest_sleep_msec(350);
+    xut_a = xsrv_a->xsrv_base.xut_recvd;
+    xut_b = xsrv_b->xsrv_base.xut_recvd;
+    client_req(xntp_this, 2000, &xbt_valid);
+    XHG_CHECK(xbt_valid && (1 == xsrv_a->xsrv_base.xut_recvd - xut_a) && (0 == xsrv_b->xsrv_base.xut_recvd - xut_b));
+
+    XHG_CHECK(0 == ntpcli_hedge_stat(xntp_this, &xhedge));
+    XHG_CHECK((2 == xhedge.xut_requests) && (1 == xhedge.xut_hedges) && (0 == xhedge.xut_wins));
+
+    ntpcli_close(xntp_this);
+
+    xtest_sleep_msec(350);
+    xsrv_a->xut_delay = 0;
+    xsrv_b->xut_delay = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    xhg_server_t xsrv_a;
+    xhg_server_t xsrv_b;
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA      xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    (x_void_t)argc;
+    (x_void_t)argv;
+
+    //======================================
+    // 两个 服务端 使用 同一端口
+
+    if (0 != server_start(&xsrv_a, XHG_ADDR_A, 0))
+    {
+        printf("server_start() failed, errno : %d\n", errno);
+        return 1;
+    }
+
+    if (0 != server_start(&xsrv_b, XHG_ADDR_B, xsrv_a.xsrv_base.xut_port))
+    {
+        printf("server_start() failed, errno : %d\n", errno);
+        xtest_server_stop(&xsrv_a.xsrv_base);
+        return 1;
+    }
+
+    //======================================
+
+    check_basic(&xsrv_a);
+    check_tail(&xsrv_a, &xsrv_b);
+    check_budget(&xsrv_a, &xsrv_b);
+    remove(XHG_FILE);
+
+    //======================================
+
+    xtest_server_stop(&xsrv_a.xsrv_base);
+    xtest_server_stop(&xsrv_b.xsrv_base);
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    return (0 == xit_fail) ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+﻿/**
+ * @file iburst_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 突发请求（iburst）的 最小时延选取 与 快速初始同步。
+ * @note
+ * 在 本机回环地址 上 启动 两个 时钟 领先 5 秒 的 简易服务端（同一端口）：
+ * 127.0.0.1 立即应答，127.0.0.2 在 收到请求 后 随机延迟 2 ~ 12 毫秒 才 记录 T2、T3（模拟 单向 排队），
+ * 127.0.0.3 没有 服务端；三个地址 经 状态文件 作为 同一域名 的 地址缓存 载入。
+ * 校验 突发请求 选中 127.0.0.1 的 最小时延 样本、不应答的 地址 只在 首轮 等待、选中的 地址 移到 缓存首位，
+ * 以及 ntpcli_iburst() 开启后 只有 首次请求 为 突发请求。
+ */
+
+#include "ntp_client.h"
+#include "ntp_state.h"
+#include "xtest_server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 毫秒、1 秒 对应的 时间计量值 */
+#define XIB_MSEC        ((x_int64_t)XTIME_VNSEC_MSEC)
+#define XIB_SEC         (1000 * XIB_MSEC)
+
+/** 服务端时钟 领先 本地时钟 的 偏差 */
+#define XIB_OFFSET      (5 * XIB_SEC)
+
+/** 选中样本 的 偏移量 允许的 误差 */
+#define XIB_TOLERANCE   (2 * XIB_MSEC)
+
+/** 测试用的 状态文件 与 域名 */
+#define XIB_FILE        "iburst_test.dat"
+#define XIB_HOST        "xntp.iburst.invalid"
+
+/** 三个 服务端 地址 */
+#define XIB_ADDR_FAST   0x7F000001
+#define XIB_ADDR_SLOW   0x7F000002
+#define XIB_ADDR_DEAD   0x7F000003
+
+static x_int32_t xit_fail = 0;
+
+#define XIB_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 慢速 服务端 的 应答：随机延迟 2 ~ 12 毫秒 后 才 记录 T2、T3，相当于 请求方向 的 网络排队。
+ */
+static x_uint32_t slow_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    (x_void_t)xbt_rbuf;
+
+    xtest_sleep_msec(2 + (x_uint32_t)(rand() % 11));
+    return xtest_server_reply(xsrv_ptr, xview_req, xbt_sbuf);
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 写入 状态文件：XIB_HOST 的 地址缓存。
+ */
+static x_void_t state_write(x_uint16_t xut_port, const x_uint32_t * xut_addrs, x_uint32_t xut_naddr)
+{
+    xntp_state_t xstate;
+
+    memset(&xstate, 0, sizeof(xntp_state_t));
+    xstate.xtm_saved  = time_vnsec();
+    strcpy(xstate.xszt_host, XIB_HOST);
+    xstate.xut_port   = xut_port;
+    xstate.xut_naddr  = xut_naddr;
+    memcpy(xstate.xut_addrs, xut_addrs, xut_naddr * sizeof(x_uint32_t));
+    xstate.xtm_expire = xstate.xtm_saved + 3600 * XIB_SEC;
+
+    XIB_CHECK(0 == ntpstate_save(XIB_FILE, &xstate));
+}
+
+/**********************************************************/
+/**
+ * @brief 打开 客户端，以 XIB_HOST 与 状态文件 中的 地址缓存 为 服务端。
+ */
+static xntp_cliptr_t client_open(x_uint16_t xut_port)
+{
+    xntp_cliptr_t xntp_this = ntpcli_open();
+
+    if (X_NULL != xntp_this)
+    {
+        XIB_CHECK(0 == ntpcli_config(xntp_this, XIB_HOST, xut_port));
+        XIB_CHECK(0 == ntpcli_state(xntp_this, XIB_FILE));
+    }
+    else
+    {
+        XIB_CHECK(X_NULL != xntp_this);
+    }
+
+    return xntp_this;
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 突发请求 的 样本选取。
+ */
+static x_void_t check_burst(xtest_server_t * xsrv_fast, xtest_server_t * xsrv_slow)
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+    xntp_burst_t  xburst;
+    xntp_state_t  xstate;
+    xtime_vnsec_t xtm_value = XTIME_INVALID_VNSEC;
+    x_int64_t     xit_error = 0;
+    x_uint32_t    xut_fast  = 0;
+    x_uint32_t    xut_slow  = 0;
+    x_uint32_t    xut_addrs[3] = { XIB_ADDR_DEAD, XIB_ADDR_SLOW, XIB_ADDR_FAST };
+
+    //======================================
+    // 三个地址：不应答的 地址 只在 首轮 等待
+
+    state_write(xsrv_fast->xut_port, xut_addrs, 3);
+    xntp_this = client_open(xsrv_fast->xut_port);
+    if (X_NULL == xntp_this)
+        return;
+
+    XIB_CHECK(!XTMVNSEC_IS_VALID(ntpcli_req_burst(xntp_this, 0, 0, X_NULL, XTIME_INVALID_VNSEC)) && (EINVAL == errno));
+    XIB_CHECK(!XTMVNSEC_IS_VALID(ntpcli_req_burst(xntp_this, XNTP_IBURST_MAX + 1, 0, X_NULL, XTIME_INVALID_VNSEC)) && (EINVAL == errno));
+
+    xut_fast  = xsrv_fast->xut_recvd;
+    xut_slow  = xsrv_slow->xut_recvd;
+    xtm_value = ntpcli_req_burst(xntp_this, XNTP_IBURST_COUNT, 0, &xburst, time_mono() + 3 * XIB_SEC);
+    xit_error = (x_int64_t)xtm_value - ((x_int64_t)time_vnsec() + XIB_OFFSET);
+
+    printf("burst (3 addresses) : %u replies, selected %08X with %u samples, "
+           "offset error %lld us, delay %lld us, spread %lld us, elapsed %llu ms\n",
+           xburst.xut_replies, xburst.xut_ipv4, xburst.xut_samples,
+           (xburst.xit_offset - XIB_OFFSET) / 10, xburst.xit_delay / 10,
+           xburst.xit_spread / 10, xburst.xtm_elapsed / XTIME_VNSEC_MSEC);
+
+    XIB_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (xit_error > -50 * XIB_MSEC) && (xit_error < 50 * XIB_MSEC));
+    XIB_CHECK((3 == xburst.xut_servers) && (2 * XNTP_IBURST_COUNT == xburst.xut_replies));
+    XIB_CHECK((XIB_ADDR_FAST == xburst.xut_ipv4) && (XNTP_IBURST_COUNT == xburst.xut_samples));
+    XIB_CHECK((xburst.xit_offset > XIB_OFFSET - XIB_TOLERANCE) && (xburst.xit_offset < XIB_OFFSET + XIB_TOLERANCE));
+    XIB_CHECK(xburst.xit_delay < XIB_TOLERANCE);
+    XIB_CHECK(xburst.xtm_elapsed < (xtime_vnsec_t)(1500 * XIB_MSEC));
+    XIB_CHECK(XNTP_IBURST_COUNT == xsrv_fast->xut_recvd - xut_fast);
+    XIB_CHECK(XNTP_IBURST_COUNT == xsrv_slow->xut_recvd - xut_slow);
+
+    ntpcli_close(xntp_this);
+
+    // 选中的 地址 移到 缓存 首位，并随 状态 保存
+    XIB_CHECK(0 == ntpstate_load(XIB_FILE, &xstate));
+    XIB_CHECK((3 == xstate.xut_naddr) && (XIB_ADDR_FAST == xstate.xut_addrs[0]));
+
+    //======================================
+    // 两个地址 均应答：耗时 约为 各轮 往返时延 之和
+
+    xut_addrs[0] = XIB_ADDR_SLOW;
+    xut_addrs[1] = XIB_ADDR_FAST;
+    state_write(xsrv_fast->xut_port, xut_addrs, 2);
+    xntp_this = client_open(xsrv_fast->xut_port);
+    if (X_NULL == xntp_this)
+        return;
+
+    xtm_value = ntpcli_req_burst(xntp_this, XNTP_IBURST_COUNT, 0, &xburst, time_mono() + 3 * XIB_SEC);
+    printf("burst (2 addresses) : %u replies, selected %08X, delay %lld us, elapsed %llu ms\n",
+           xburst.xut_replies, xburst.xut_ipv4, xburst.xit_delay / 10,
+           xburst.xtm_elapsed / XTIME_VNSEC_MSEC);
+
+    XIB_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (XIB_ADDR_FAST == xburst.xut_ipv4));
+    XIB_CHECK(xburst.xtm_elapsed < (xtime_vnsec_t)(500 * XIB_MSEC));
+
+    // 轮间隔
+    xtm_value = ntpcli_req_burst(xntp_this, 3, 100, &xburst, time_mono() + 3 * XIB_SEC);
+    XIB_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (3 == xburst.xut_samples));
+    XIB_CHECK((xburst.xtm_elapsed >= (xtime_vnsec_t)(200 * XIB_MSEC)) &&
+              (xburst.xtm_elapsed <  (xtime_vnsec_t)(700 * XIB_MSEC)));
+
+    ntpcli_close(xntp_this);
+
+    //======================================
+    // 只有 不应答的 地址：首轮 等待 后 失败
+
+    xut_addrs[0] = XIB_ADDR_DEAD;
+    state_write(xsrv_fast->xut_port, xut_addrs, 1);
+    xntp_this = client_open(xsrv_fast->xut_port);
+    if (X_NULL == xntp_this)
+        return;
+
+    xtm_value = ntpcli_req_burst(xntp_this, XNTP_IBURST_COUNT, 0, &xburst, time_mono() + 3 * XIB_SEC);
+    XIB_CHECK(!XTMVNSEC_IS_VALID(xtm_value) && (ETIMEDOUT == errno));
+    XIB_CHECK((0 == xburst.xut_replies) && (xburst.xtm_elapsed < (xtime_vnsec_t)(1500 * XIB_MSEC)));
+
+    ntpcli_close(xntp_this);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 快速初始同步：只有 首次 成功的 请求 为 突发请求。
+ */
+static x_void_t check_mode(xtest_server_t * xsrv_fast)
+{
+    xntp_cliptr_t xntp_this = X_NULL;
+    xtime_vnsec_t xtm_value = XTIME_INVALID_VNSEC;
+    x_uint32_t    xut_fast  = 0;
+
+    xntp_this = ntpcli_open();
+    if (X_NULL == xntp_this)
+    {
+        XIB_CHECK(X_NULL != xntp_this);
+        return;
+    }
+
+    XIB_CHECK(EINVAL == ntpcli_iburst(X_NULL, X_TRUE));
+    XIB_CHECK(0 == ntpcli_config(xntp_this, "127.0.0.1", xsrv_fast->xut_port));
+    XIB_CHECK(0 == ntpcli_iburst(xntp_this, X_TRUE));
+
+    xut_fast  = xsrv_fast->xut_recvd;
+    xtm_value = ntpcli_req_time(xntp_this, 3000);
+    XIB_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (XNTP_IBURST_COUNT == xsrv_fast->xut_recvd - xut_fast));
+
+    xut_fast  = xsrv_fast->xut_recvd;
+    xtm_value = ntpcli_req_time(xntp_this, 3000);
+    XIB_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (1 == xsrv_fast->xut_recvd - xut_fast));
+
+    // 再次 开启
+    XIB_CHECK(0 == ntpcli_iburst(xntp_this, X_TRUE));
+    xut_fast  = xsrv_fast->xut_recvd;
+    xtm_value = ntpcli_req_time(xntp_this, 3000);
+    XIB_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (XNTP_IBURST_COUNT == xsrv_fast->xut_recvd - xut_fast));
+
+    // 关闭
+    XIB_CHECK(0 == ntpcli_iburst(xntp_this, X_TRUE));
+    XIB_CHECK(0 == ntpcli_iburst(xntp_this, X_FALSE));
+    xut_fast  = xsrv_fast->xut_recvd;
+    xtm_value = ntpcli_req_time(xntp_this, 3000);
+    XIB_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (1 == xsrv_fast->xut_recvd - xut_fast));
+
+    ntpcli_close(xntp_this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    xtest_server_t xsrv_fast;
+    xtest_server_t xsrv_slow;
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA        xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    (x_void_t)argc;
+    (x_void_t)argv;
+
+    //======================================
+    // 两个 服务端 使用 同一端口
+
+    memset(&xsrv_fast, 0, sizeof(xtest_server_t));
+    memset(&xsrv_slow, 0, sizeof(xtest_server_t));
+    xsrv_fast.xut_ipv4    = XIB_ADDR_FAST;
+    xsrv_fast.xit_offset  = XIB_OFFSET;
+    xsrv_slow.xut_ipv4    = XIB_ADDR_SLOW;
+    xsrv_slow.xit_offset  = XIB_OFFSET;
+    xsrv_slow.xfunc_reply = slow_reply;
+
+    if (0 != xtest_server_start(&xsrv_fast))
+    {
+        printf("xtest_server_start() failed, errno : %d\n", errno);
+        return 1;
+    }
+
+    xsrv_slow.xut_port = xsrv_fast.xut_port;
+    if (0 != xtest_server_start(&xsrv_slow))
+    {
+        printf("xtest_server_start() failed, errno : %d\n", errno);
+        xtest_server_stop(&xsrv_fast);
+        return 1;
+    }
+
+    //======================================
+
+    check_burst(&xsrv_fast, &xsrv_slow);
+    check_mode(&xsrv_fast);
+    remove(XIB_FILE);
+
+    //======================================
+
+    xtest_server_stop(&xsrv_fast);
+    xtest_server_stop(&xsrv_slow);
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    return (0 == xit_fail) ? 0 : 1;
+}
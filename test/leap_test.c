@@ -0,0 +1,582 @@
+﻿/**
+ * @file leap_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 闰秒表、闰秒计划、24 小时线性平滑 与 客户端的 LI 跟踪。
+ * @note
+ * 先校验 leap-seconds.list 的加载、TAI - UTC 查询、依据 闰秒表 或 LI 计算的 闰秒计划，
+ * 再 按 真实时间 逐步推进，校验 插入/删除 闰秒 时 平滑时间 与 理想的 线性平滑 之间的误差，
+ * 以及 time_vtod_leap()/time_dtov() 对 23:59:60 的表示；
+ * 然后 在本机回环地址上 启动一个 时钟位于 2016-12-31 18:00:00 UTC、LI 为 1 的 简易服务端，
+ * 校验 ntpcli_req_time() 的 跳变 与 平滑 两种方式；最后 测量 平滑计算 的 耗时。
+ */
+
+#include "ntp_client.h"
+#include "ntp_leap.h"
+#include "xtest_server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 秒 对应的 时间计量值 */
+#define XLP_SEC         ((x_int64_t)XTIME_100NS_BASE)
+
+/** 2017-01-01 00:00:00 UTC（2016 年末 插入闰秒 之后）的 UNIX 秒数 */
+#define XLP_LEAP_2017   1483228800LL
+
+/** 平滑时间 与 理想线性平滑 之间 的 允许误差（100 纳秒） */
+#define XLP_TOLERANCE   200
+
+/** 客户端请求 的 允许误差（100 纳秒） */
+#define XLP_NET_TOL     ((x_int64_t)(50 * XTIME_VNSEC_MSEC))
+
+/** 测试用的 leap-seconds.list 文件 */
+#define XLP_LIST_FILE   "leap_test.list"
+
+/** IERS leap-seconds.list 的 数据（过期时刻 为 2028-06-28） */
+static const x_cstring_t XLP_LIST_TEXT =
+    "#\tUpdated through IERS Bulletin C\n"
+    "#$\t 3929093563\n"
+    "#@\t 4054924800\n"
+    "#\n"
+    "2272060800\t10\t# 1 Jan 1972\n"
+    "2287785600\t11\t# 1 Jul 1972\n"
+    "2303683200\t12\t# 1 Jan 1973\n"
+    "2335219200\t13\t# 1 Jan 1974\n"
+    "2366755200\t14\t# 1 Jan 1975\n"
+    "2398291200\t15\t# 1 Jan 1976\n"
+    "2429913600\t16\t# 1 Jan 1977\n"
+    "2461449600\t17\t# 1 Jan 1978\n"
+    "2492985600\t18\t# 1 Jan 1979\n"
+    "2524521600\t19\t# 1 Jan 1980\n"
+    "2571782400\t20\t# 1 Jul 1981\n"
+    "2603318400\t21\t# 1 Jul 1982\n"
+    "2634854400\t22\t# 1 Jul 1983\n"
+    "2698012800\t23\t# 1 Jul 1985\n"
+    "2776982400\t24\t# 1 Jan 1988\n"
+    "2840140800\t25\t# 1 Jan 1990\n"
+    "2871676800\t26\t# 1 Jan 1991\n"
+    "2918937600\t27\t# 1 Jul 1992\n"
+    "2950473600\t28\t# 1 Jul 1993\n"
+    "2982009600\t29\t# 1 Jul 1994\n"
+    "3029443200\t30\t# 1 Jan 1996\n"
+    "3076704000\t31\t# 1 Jul 1997\n"
+    "3124137600\t32\t# 1 Jan 1999\n"
+    "3345062400\t33\t# 1 Jan 2006\n"
+    "3439756800\t34\t# 1 Jan 2009\n"
+    "3550089600\t35\t# 1 Jul 2012\n"
+    "3644697600\t36\t# 1 Jul 2015\n"
+    "3692217600\t37\t# 1 Jan 2017\n"
+    "#h\t16edd0f0 3666784f 37db6bdd e74ced87 59af48f1\n";
+
+/** 检查失败的次数 */
+static x_int32_t xit_fail = 0;
+
+#define XLP_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+/** UNIX 秒数 转换为 时间计量值 */
+#define XLP_VNSEC(xsec) ((xtime_vnsec_t)((x_int64_t)(xsec) * XLP_SEC))
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 校验 闰秒表 的 加载、TAI - UTC 查询 与 闰秒计划。
+ */
+static x_void_t check_table(xntp_leapptr_t xleap_tab)
+{
+    xntp_leapplan_t xleap_plan = 0;
+    xntp_leapptr_t  xleap_exp  = X_NULL;
+    FILE          * xfile_ptr  = X_NULL;
+
+    XLP_CHECK(ntpleap_expire(xleap_tab) == XLP_VNSEC(4054924800LL - XTIME_SEC_1900_1970));
+
+    XLP_CHECK(0  == ntpleap_tai(xleap_tab, XLP_VNSEC(0)));
+    XLP_CHECK(10 == ntpleap_tai(xleap_tab, XLP_VNSEC(2272060800LL - XTIME_SEC_1900_1970)));
+    XLP_CHECK(36 == ntpleap_tai(xleap_tab, XLP_VNSEC(XLP_LEAP_2017 - 1)));
+    XLP_CHECK(37 == ntpleap_tai(xleap_tab, XLP_VNSEC(XLP_LEAP_2017)));
+    XLP_CHECK(37 == ntpleap_tai(xleap_tab, XLP_VNSEC(XLP_LEAP_2017 + 86400 * 3650LL)));
+
+    XLP_CHECK(EINVAL == ntpleap_add(xleap_tab, XLP_VNSEC(XLP_LEAP_2017) + 1, 37));
+
+    //======================================
+    // 闰秒表：平滑窗口 尚未结束的 下一个闰秒
+
+    xleap_plan = ntpleap_plan(xleap_tab, 0, XLP_VNSEC(XLP_LEAP_2017 - 86400 * 30LL), 0);
+    XLP_CHECK(XNTP_LEAPPLAN(XLP_LEAP_2017, 1) == xleap_plan);
+
+    xleap_plan = ntpleap_plan(xleap_tab, 0, XLP_VNSEC(XLP_LEAP_2017 + 43199), 0);
+    XLP_CHECK(XNTP_LEAPPLAN(XLP_LEAP_2017, 1) == xleap_plan);
+
+    xleap_plan = ntpleap_plan(xleap_tab, 0, XLP_VNSEC(XLP_LEAP_2017 + 43200), 1);
+    XLP_CHECK((0 == XNTP_LEAPPLAN_LI(xleap_plan)) &&
+              (XNTP_LEAPPLAN_UNTIL(xleap_plan) > XLP_VNSEC(XLP_LEAP_2017 + 43200)));
+
+    // 2015-06-30 的 插入闰秒
+    xleap_plan = ntpleap_plan(xleap_tab, 0, XLP_VNSEC(1435708800LL - 3600), 0);
+    XLP_CHECK(XNTP_LEAPPLAN(1435708800LL, 1) == xleap_plan);
+
+    //======================================
+    // 过期的 闰秒表：改为 依据 LI
+
+    xleap_exp = ntpleap_create();
+    xfile_ptr = fopen(XLP_LIST_FILE, "w");
+    if ((X_NULL == xleap_exp) || (X_NULL == xfile_ptr))
+    {
+        XLP_CHECK(X_NULL != xleap_exp);
+        XLP_CHECK(X_NULL != xfile_ptr);
+    }
+    else
+    {
+        fputs("#@ 3660249600\n3644697600 36\n3692217600 37\n", xfile_ptr); // 过期于 2015-12-28
+        fclose(xfile_ptr);
+        xfile_ptr = X_NULL;
+
+        XLP_CHECK(0 == ntpleap_load(xleap_exp, XLP_LIST_FILE));
+        XLP_CHECK(37 == ntpleap_tai(xleap_exp, XLP_VNSEC(XLP_LEAP_2017)));
+
+        xleap_plan = ntpleap_plan(xleap_exp, 0, XLP_VNSEC(XLP_LEAP_2017 - 86400), 0);
+        XLP_CHECK(0 == XNTP_LEAPPLAN_LI(xleap_plan));
+        xleap_plan = ntpleap_plan(xleap_exp, 0, XLP_VNSEC(XLP_LEAP_2017 - 86400), 1);
+        XLP_CHECK(XNTP_LEAPPLAN(XLP_LEAP_2017, 1) == xleap_plan);
+
+        // 格式错误
+        xfile_ptr = fopen(XLP_LIST_FILE, "w");
+        if (X_NULL != xfile_ptr)
+        {
+            fputs("3644697600 thirty-six\n", xfile_ptr);
+            fclose(xfile_ptr);
+            xfile_ptr = X_NULL;
+            XLP_CHECK(EINVAL == ntpleap_load(xleap_exp, XLP_LIST_FILE));
+        }
+
+        remove(XLP_LIST_FILE);
+    }
+
+    if (X_NULL != xleap_exp)
+    {
+        ntpleap_destroy(xleap_exp);
+        xleap_exp = X_NULL;
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 没有 闰秒表 时，依据 LI 计算的 闰秒计划。
+ */
+static x_void_t check_indicator(x_void_t)
+{
+    xntp_leapplan_t xleap_plan = 0;
+
+    // 插入：当月 最后一秒 之后（跨年）
+    xleap_plan = ntpleap_plan(X_NULL, 0, XLP_VNSEC(XLP_LEAP_2017 - 6 * 3600), 1);
+    XLP_CHECK(XNTP_LEAPPLAN(XLP_LEAP_2017, 1) == xleap_plan);
+
+    // 删除：2016-06-15 → 2016-07-01
+    xleap_plan = ntpleap_plan(X_NULL, 0, XLP_VNSEC(1465948800LL), 2);
+    XLP_CHECK(XNTP_LEAPPLAN(1467331200LL, 2) == xleap_plan);
+
+    // 闰年 2 月：2016-02-29 → 2016-03-01
+    xleap_plan = ntpleap_plan(X_NULL, 0, XLP_VNSEC(1456704000LL + 100), 1);
+    XLP_CHECK(XNTP_LEAPPLAN(1456790400LL, 1) == xleap_plan);
+
+    // 未同步（LI 为 3）按 0 处理
+    xleap_plan = ntpleap_plan(X_NULL, 0, XLP_VNSEC(XLP_LEAP_2017 - 6 * 3600), 3);
+    XLP_CHECK(0 == XNTP_LEAPPLAN_LI(xleap_plan));
+
+    // 闰秒之后 服务端清除 LI：平滑窗口 结束前 保持原计划
+    xleap_plan = ntpleap_plan(X_NULL, 0, XLP_VNSEC(XLP_LEAP_2017 - 6 * 3600), 1);
+    xleap_plan = ntpleap_plan(X_NULL, xleap_plan, XLP_VNSEC(XLP_LEAP_2017 + 3600), 0);
+    XLP_CHECK(XNTP_LEAPPLAN(XLP_LEAP_2017, 1) == xleap_plan);
+    xleap_plan = ntpleap_plan(X_NULL, xleap_plan, XLP_VNSEC(XLP_LEAP_2017 + 43200), 0);
+    XLP_CHECK(0 == XNTP_LEAPPLAN_LI(xleap_plan));
+
+    // 平滑窗口 开始前 撤销的 LI：不再保持
+    xleap_plan = ntpleap_plan(X_NULL, 0, XLP_VNSEC(XLP_LEAP_2017 - 86400 * 20LL), 1);
+    xleap_plan = ntpleap_plan(X_NULL, xleap_plan, XLP_VNSEC(XLP_LEAP_2017 - 86400 * 19LL), 0);
+    XLP_CHECK(0 == XNTP_LEAPPLAN_LI(xleap_plan));
+}
+
+/**********************************************************/
+/**
+ * @brief 按 真实时间 逐步推进，校验 平滑时间 与 理想的 线性平滑 之间的误差。
+ * @note
+ * 真实时间 u 自 平滑窗口 开始前 推进到 结束后；插入闰秒 时，UNIX 时间 在闰秒当中 重复 前一秒，
+ * 删除闰秒 时，跳过 闰秒时刻的 前一秒；理想的 平滑时间 在窗口内 以 86400 / (86400 + sign) 的速率 走时。
+ * 插入的 闰秒 当中，UNIX 时间 已无法区分，跳过 误差校验。
+ *
+ * @param [in ] xleap_plan : 闰秒计划。
+ * @param [in ] xit_sign   : 1 插入，-1 删除。
+ */
+static x_void_t check_smear(xntp_leapplan_t xleap_plan, x_int64_t xit_sign)
+{
+    x_int64_t xit_leap  = XNTP_LEAPPLAN_SEC(xleap_plan) * XLP_SEC;
+    x_int64_t xit_begin = xit_leap - 43200 * XLP_SEC;
+    x_int64_t xit_span  = (86400 + xit_sign) * XLP_SEC;
+    x_int64_t xit_real  = 0;
+    x_int64_t xit_unix  = 0;
+    x_int64_t xit_ideal = 0;
+    x_int64_t xit_smear = 0;
+    x_int64_t xit_last  = 0;
+    x_int64_t xit_error = 0;
+    x_int64_t xit_emax  = 0;
+
+    //======================================
+    // 端点 与 闰秒时刻 的 取值
+
+    XLP_CHECK(ntpleap_smear(xleap_plan, (xtime_vnsec_t)xit_begin) == (xtime_vnsec_t)xit_begin);
+    XLP_CHECK(ntpleap_smear(xleap_plan, (xtime_vnsec_t)(xit_leap - 21600 * XLP_SEC)) ==
+              (xtime_vnsec_t)(xit_leap - 21600 * XLP_SEC - xit_sign * XLP_SEC / 4));
+    XLP_CHECK(ntpleap_smear(xleap_plan, (xtime_vnsec_t)xit_leap) ==
+              (xtime_vnsec_t)(xit_leap + xit_sign * XLP_SEC / 2));
+    XLP_CHECK(ntpleap_smear(xleap_plan, (xtime_vnsec_t)(xit_leap + 43200 * XLP_SEC)) ==
+              (xtime_vnsec_t)(xit_leap + 43200 * XLP_SEC));
+    XLP_CHECK(ntpleap_smear(xleap_plan, (xtime_vnsec_t)(xit_leap + 86400 * XLP_SEC)) ==
+              (xtime_vnsec_t)(xit_leap + 86400 * XLP_SEC));
+    XLP_CHECK(ntpleap_smear(xleap_plan, XTIME_INVALID_VNSEC) == XTIME_INVALID_VNSEC);
+
+    //======================================
+
+    xit_last = 0;
+    for (xit_real = xit_begin - 60 * XLP_SEC; xit_real < xit_begin + xit_span + 60 * XLP_SEC; xit_real += 997 * XTIME_VNSEC_MSEC + 3)
+    {
+        // 真实时间 对应的 UNIX 时间
+        if (xit_real < xit_leap - ((xit_sign < 0) ? XLP_SEC : 0))
+            xit_unix = xit_real;
+        else if (xit_sign > 0)
+            xit_unix = xit_real - XLP_SEC;
+        else
+            xit_unix = xit_real + XLP_SEC;
+
+        // 理想的 线性平滑
+        if (xit_real <= xit_begin)
+            xit_ideal = xit_real;
+        else if (xit_real >= xit_begin + xit_span)
+            xit_ideal = xit_real - xit_sign * XLP_SEC;
+        else
+            xit_ideal = xit_begin + (x_int64_t)((double)(xit_real - xit_begin) * 86400.0 / (86400 + xit_sign));
+
+        xit_smear = (x_int64_t)ntpleap_smear(xleap_plan, (xtime_vnsec_t)xit_unix);
+
+        if ((xit_sign > 0) && (xit_real >= xit_leap) && (xit_real < xit_leap + XLP_SEC))
+            continue;
+
+        xit_error = (xit_smear > xit_ideal) ? (xit_smear - xit_ideal) : (xit_ideal - xit_smear);
+        xit_emax  = (xit_error > xit_emax) ? xit_error : xit_emax;
+
+        XLP_CHECK((0 == xit_last) || (xit_smear > xit_last));
+        xit_last = xit_smear;
+    }
+
+    printf("smear %s : max error %lld ns\n", (xit_sign > 0) ? "insert" : "delete", xit_emax * 100LL);
+    XLP_CHECK(xit_emax <= XLP_TOLERANCE);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 time_vtod_leap()、time_dtov() 对 闰秒（第 60 秒）的表示。
+ */
+static x_void_t check_descr(x_void_t)
+{
+    xtime_descr_t xtm_descr;
+    xtime_vnsec_t xtm_vnsec = XLP_VNSEC(XLP_LEAP_2017) + 500 * XTIME_VNSEC_MSEC;
+
+    xtm_descr = time_vtod_leap(xtm_vnsec, X_TRUE);
+    XLP_CHECK((2016 == xtm_descr.ctx_year) && (12 == xtm_descr.ctx_month) && (31 == xtm_descr.ctx_day));
+    XLP_CHECK((23 == xtm_descr.ctx_hour) && (59 == xtm_descr.ctx_minute) && (60 == xtm_descr.ctx_second));
+    XLP_CHECK(500 == xtm_descr.ctx_msec);
+    XLP_CHECK(time_descr_valid(xtm_descr));
+    XLP_CHECK(time_dtov(xtm_descr) == xtm_vnsec);
+
+    xtm_descr = time_vtod_leap(xtm_vnsec, X_FALSE);
+    XLP_CHECK((2017 == xtm_descr.ctx_year) && (0 == xtm_descr.ctx_hour) && (0 == xtm_descr.ctx_second));
+    XLP_CHECK(time_dtov(xtm_descr) == xtm_vnsec);
+
+    // 不在 分钟 起始的 时间，与 time_vtod() 相同
+    xtm_descr = time_vtod_leap(xtm_vnsec + 5 * XLP_SEC, X_TRUE);
+    XLP_CHECK(xtm_descr.ctx_value == time_vtod(xtm_vnsec + 5 * XLP_SEC).ctx_value);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 客户端 的 LI 跟踪、跳变 与 平滑 两种方式。
+ */
+static x_void_t check_client(xntp_leapptr_t xleap_tab)
+{
+    xtest_server_t xlp_srv;
+    xntp_cliptr_t  xntp_this = X_NULL;
+    xntp_sweep_t   xsw_item;
+    xtime_vnsec_t  xtm_value = XTIME_INVALID_VNSEC;
+    x_int64_t      xit_error = 0;
+
+    // 服务端时钟 位于 2017 年 闰秒 前 6 小时，并 通告 LI
+    memset(&xlp_srv, 0, sizeof(xtest_server_t));
+    xlp_srv.xit_offset = XLP_VNSEC(XLP_LEAP_2017 - 6 * 3600) - (x_int64_t)time_vnsec();
+    xlp_srv.xut_leap   = 1;
+
+    if (0 != xtest_server_start(&xlp_srv))
+    {
+        printf("xtest_server_start() failed, errno : %d\n", errno);
+        xit_fail += 1;
+        return;
+    }
+
+    do
+    {
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XLP_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        ntpcli_config(xntp_this, "127.0.0.1", xlp_srv.xut_port);
+        XLP_CHECK(EINVAL == ntpcli_leap(xntp_this, X_NULL, (xntp_leapmode_t)7));
+
+        //======================================
+        // 跳变（默认）：与 服务端 相同
+
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        xit_error = (x_int64_t)xtm_value - ((x_int64_t)time_vnsec() + xlp_srv.xit_offset);
+        XLP_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (xit_error > -XLP_NET_TOL) && (xit_error < XLP_NET_TOL));
+        XLP_CHECK(1 == ntpcli_leap_ind(xntp_this));
+
+        //======================================
+        // 平滑（只依据 LI）：闰秒前 6 小时，慢 0.25 秒
+
+        XLP_CHECK(0 == ntpcli_leap(xntp_this, X_NULL, ntp_leap_smear));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        xit_error = (x_int64_t)xtm_value - ((x_int64_t)time_vnsec() + xlp_srv.xit_offset - XLP_SEC / 4);
+        XLP_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (xit_error > -XLP_NET_TOL) && (xit_error < XLP_NET_TOL));
+        XLP_CHECK(XNTP_LEAPPLAN(XLP_LEAP_2017, 1) == ntpcli_leap_plan(xntp_this));
+
+        // 平滑（闰秒表），服务端 未通告 LI
+        xlp_srv.xut_leap = 0;
+        XLP_CHECK(0 == ntpcli_leap(xntp_this, xleap_tab, ntp_leap_smear));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        xit_error = (x_int64_t)xtm_value - ((x_int64_t)time_vnsec() + xlp_srv.xit_offset - XLP_SEC / 4);
+        XLP_CHECK(XTMVNSEC_IS_VALID(xtm_value) && (xit_error > -XLP_NET_TOL) && (xit_error < XLP_NET_TOL));
+        XLP_CHECK(0 == ntpcli_leap_ind(xntp_this));
+
+        //======================================
+        // 批量请求：记录 LI，不做平滑
+
+        xlp_srv.xut_leap = 2;
+        memset(&xsw_item, 0, sizeof(xntp_sweep_t));
+        xsw_item.xut_ipv4 = 0x7F000001;
+        xsw_item.xut_port = xlp_srv.xut_port;
+        XLP_CHECK(0 == ntpcli_req_sweep(xntp_this, &xsw_item, 1, time_mono() + 3000 * XTIME_VNSEC_MSEC));
+        xit_error = (x_int64_t)xsw_item.xtm_vnsec - ((x_int64_t)time_vnsec() + xlp_srv.xit_offset);
+        XLP_CHECK((0 == xsw_item.xit_errno) && (2 == xsw_item.xut_leap));
+        XLP_CHECK((xit_error > -XLP_NET_TOL) && (xit_error < XLP_NET_TOL));
+    } while (0);
+
+    if (X_NULL != xntp_this)
+    {
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+    }
+
+    xtest_server_stop(&xlp_srv);
+}
+
+/**********************************************************/
+/**
+ * @brief 测量 平滑计算 的 耗时（与 只累加时间戳 的 空循环 对比）。
+ */
+static x_void_t bench_smear(x_uint32_t xut_count)
+{
+    xntp_leapplan_t xleap_plan = XNTP_LEAPPLAN(XLP_LEAP_2017, 1);
+    xtime_vnsec_t   xtm_value  = XLP_VNSEC(XLP_LEAP_2017 - 86400);
+    xtime_vnsec_t   xtm_start  = 0;
+    xtime_vnsec_t   xtm_base   = 0;
+    xtime_vnsec_t   xtm_smear  = 0;
+    volatile x_uint64_t xut_sink = 0;
+    x_uint64_t      xut_sum    = 0;
+    x_uint32_t      xut_iter   = 0;
+
+    // 时间戳 步进 约 17 毫秒，覆盖 平滑窗口 之前、之中、之后 三个区段
+    xtm_start = time_mono();
+    for (xut_iter = 0, xut_sum = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xut_sum += xtm_value + (x_uint64_t)xut_iter * 172800ULL;
+    }
+    xut_sink = xut_sum;
+    xtm_base = time_mono() - xtm_start;
+
+    xtm_start = time_mono();
+    for (xut_iter = 0, xut_sum = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xut_sum += ntpleap_smear(xleap_plan, xtm_value + (x_uint64_t)xut_iter * 172800ULL);
+    }
+    xut_sink = xut_sum;
+    xtm_smear = time_mono() - xtm_start;
+
+    (x_void_t)xut_sink;
+    printf("smear bench : %u timestamps, base %.2f ns/op, smear %.2f ns/op\n",
+           xut_count,
+           xtm_base  * 100.0 / xut_count,
+           xtm_smear * 100.0 / xut_count);
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-f <leap-seconds.list>] [-n <count>]\n", xszt_app);
+    printf("\t-f <file>  Also load and print a leap-seconds.list file.\n");
+    printf("\t-n <count> The number of timestamps of the smear benchmark, default 50000000.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t      xit_iter   = 0;
+    x_int32_t      xit_errno  = 0;
+    x_uint32_t     xut_count  = 50000000;
+    x_cstring_t    xszt_file  = X_NULL;
+    xntp_leapptr_t xleap_tab  = X_NULL;
+    xntp_leapptr_t xleap_neg  = X_NULL;
+    FILE         * xfile_ptr  = X_NULL;
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+    _putenv("TZ=UTC0");
+    _tzset();
+#else // !(defined(_WIN32) || defined(_WIN64))
+    setenv("TZ", "UTC0", 1);
+    tzset();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    do
+    {
+        //======================================
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-f", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xszt_file = argv[++xit_iter];
+            else if ((0 == strcmp("-n", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_count = (x_uint32_t)atoi(argv[++xit_iter]);
+            else
+            {
+                usage(argv[0]);
+                return 0;
+            }
+        }
+
+        //======================================
+
+        xleap_tab = ntpleap_create();
+        xleap_neg = ntpleap_create();
+        xfile_ptr = fopen(XLP_LIST_FILE, "w");
+        if ((X_NULL == xleap_tab) || (X_NULL == xleap_neg) || (X_NULL == xfile_ptr))
+        {
+            printf("ntpleap_create() or fopen() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+        fputs(XLP_LIST_TEXT, xfile_ptr);
+        fclose(xfile_ptr);
+        xfile_ptr = X_NULL;
+
+        xit_errno = ntpleap_load(xleap_tab, XLP_LIST_FILE);
+        remove(XLP_LIST_FILE);
+        if (0 != xit_errno)
+        {
+            printf("ntpleap_load() return %d\n", xit_errno);
+            xit_fail += 1;
+            break;
+        }
+
+        if (X_NULL != xszt_file)
+        {
+            xntp_leapptr_t xleap_usr = ntpleap_create();
+
+            xit_errno = ntpleap_load(xleap_usr, xszt_file);
+            printf("%s : errno %d, TAI - UTC now %d s, expire %llu\n",
+                   xszt_file, xit_errno,
+                   ntpleap_tai(xleap_usr, time_vnsec()),
+                   ntpleap_expire(xleap_usr) / XTIME_100NS_BASE);
+            ntpleap_destroy(xleap_usr);
+        }
+
+        //======================================
+
+        check_table(xleap_tab);
+        check_indicator();
+        check_descr();
+
+        check_smear(ntpleap_plan(xleap_tab, 0, XLP_VNSEC(XLP_LEAP_2017 - 86400), 0), 1);
+
+        // 删除闰秒（虚构）：2017-01-01 TAI - UTC 由 36 变为 35
+        ntpleap_add(xleap_neg, XLP_VNSEC(1435708800LL), 36);
+        ntpleap_add(xleap_neg, XLP_VNSEC(XLP_LEAP_2017), 35);
+        XLP_CHECK(XNTP_LEAPPLAN(XLP_LEAP_2017, 2) == ntpleap_plan(xleap_neg, 0, XLP_VNSEC(XLP_LEAP_2017 - 86400), 0));
+        check_smear(ntpleap_plan(xleap_neg, 0, XLP_VNSEC(XLP_LEAP_2017 - 86400), 0), -1);
+
+        // 无闰秒 的计划：原样返回
+        XLP_CHECK(ntpleap_smear(XNTP_LEAPPLAN(XLP_LEAP_2017, 0), XLP_VNSEC(XLP_LEAP_2017)) == XLP_VNSEC(XLP_LEAP_2017));
+
+        check_client(xleap_tab);
+
+        printf("checks : %s\n", (0 == xit_fail) ? "passed" : "FAILED");
+        if (0 != xit_fail)
+            break;
+
+        //======================================
+
+        if (xut_count > 0)
+        {
+            bench_smear(xut_count);
+        }
+
+        //======================================
+    } while (0);
+
+    if (X_NULL != xleap_tab)
+    {
+        ntpleap_destroy(xleap_tab);
+        xleap_tab = X_NULL;
+    }
+
+    if (X_NULL != xleap_neg)
+    {
+        ntpleap_destroy(xleap_neg);
+        xleap_neg = X_NULL;
+    }
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    return (0 == xit_fail) ? 0 : 1;
+}
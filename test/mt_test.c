@@ -0,0 +1,213 @@
+﻿/**
+ * @file mt_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 多个线程 共用同一 NTP 客户端对象 并发请求 的程序。
+ */
+
+#include "ntp_client.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <WinSock2.h>
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <pthread.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 工作线程的最大数量 */
+#define XMT_MAX_THREADS  256
+
+/**
+ * @struct xmt_worker_t
+ * @brief  工作线程的 参数 与 统计结果。
+ */
+typedef struct xmt_worker_t
+{
+    xntp_cliptr_t xntp_this;    ///< 所有线程共用的 NTP 客户端对象
+    x_uint32_t    xut_count;    ///< 请求次数
+    x_uint32_t    xut_tmout;    ///< 单次请求的超时时间（毫秒）
+    x_uint32_t    xut_okay;     ///< 成功次数
+    x_int32_t     xit_errno;    ///< 最后一次失败的错误码
+} xmt_worker_t;
+
+/**********************************************************/
+/**
+ * @brief 工作线程：使用共用的客户端对象，连续执行 NTP 请求。
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI worker_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_pvoid_t worker_proc(x_pvoid_t xpvt_param)
+#endif // defined(_WIN32) || defined(_WIN64)
+{
+    xmt_worker_t * xwork_ptr = (xmt_worker_t *)xpvt_param;
+    x_uint32_t     xut_iter  = 0;
+
+    for (xut_iter = 0; xut_iter < xwork_ptr->xut_count; ++xut_iter)
+    {
+        if (XTMVNSEC_IS_VALID(ntpcli_req_time(xwork_ptr->xntp_this, xwork_ptr->xut_tmout)))
+            xwork_ptr->xut_okay += 1;
+        else
+            xwork_ptr->xit_errno = errno;
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-j <threads>] [-n <number>] [-p <port>] [-t <msec>] <host>\n", xszt_app);
+    printf("\t-j <threads> The number of threads sharing one client, default 4.\n");
+    printf("\t-n <number>  The number of requests of each thread, default 1000.\n");
+    printf("\t-p <port>    The port of NTP server, default 123.\n");
+    printf("\t-t <msec>    Timeout of each request in milliseconds, default 1000.\n");
+    printf("\t<host>       The IPv4 address or domain name of NTP server.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t     xit_iter    = 0;
+    x_uint32_t    xut_threads = 4;
+    x_uint32_t    xut_count   = 1000;
+    x_uint32_t    xut_tmout   = 1000;
+    x_uint16_t    xut_port    = NTP_PORT;
+    x_cstring_t   xszt_host   = X_NULL;
+    x_uint32_t    xut_iter    = 0;
+    x_uint32_t    xut_okay    = 0;
+    xntp_cliptr_t xntp_this   = X_NULL;
+    xtime_vnsec_t xtm_start   = 0;
+    xtime_vnsec_t xtm_spent   = 0;
+
+    static xmt_worker_t xwork_list[XMT_MAX_THREADS];
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE    xthd_list[XMT_MAX_THREADS];
+    WSADATA   xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_t xthd_list[XMT_MAX_THREADS];
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    do
+    {
+        //======================================
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-j", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_threads = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-n", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_count = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-p", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_port = (x_uint16_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-t", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_tmout = (x_uint32_t)atoi(argv[++xit_iter]);
+            else
+                xszt_host = argv[xit_iter];
+        }
+
+        if ((X_NULL == xszt_host) || (0 == xut_threads) || (xut_threads > XMT_MAX_THREADS))
+        {
+            usage(argv[0]);
+            break;
+        }
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            printf("ntpcli_open() return X_NULL, errno : %d\n", errno);
+            break;
+        }
+
+        ntpcli_config(xntp_this, xszt_host, xut_port);
+
+        //======================================
+
+        xtm_start = time_mono();
+
+        for (xut_iter = 0; xut_iter < xut_threads; ++xut_iter)
+        {
+            memset(&xwork_list[xut_iter], 0, sizeof(xmt_worker_t));
+            xwork_list[xut_iter].xntp_this = xntp_this;
+            xwork_list[xut_iter].xut_count = xut_count;
+            xwork_list[xut_iter].xut_tmout = xut_tmout;
+
+#if defined(_WIN32) || defined(_WIN64)
+            xthd_list[xut_iter] = CreateThread(X_NULL, 0, worker_proc, &xwork_list[xut_iter], 0, X_NULL);
+#else // !(defined(_WIN32) || defined(_WIN64))
+            pthread_create(&xthd_list[xut_iter], X_NULL, worker_proc, &xwork_list[xut_iter]);
+#endif // defined(_WIN32) || defined(_WIN64)
+        }
+
+        for (xut_iter = 0; xut_iter < xut_threads; ++xut_iter)
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            WaitForSingleObject(xthd_list[xut_iter], INFINITE);
+            CloseHandle(xthd_list[xut_iter]);
+#else // !(defined(_WIN32) || defined(_WIN64))
+            pthread_join(xthd_list[xut_iter], X_NULL);
+#endif // defined(_WIN32) || defined(_WIN64)
+        }
+
+        xtm_spent = time_mono() - xtm_start;
+
+        //======================================
+
+        for (xut_iter = 0; xut_iter < xut_threads; ++xut_iter)
+        {
+            xut_okay += xwork_list[xut_iter].xut_okay;
+            printf("[%u] : %u/%u, errno = %d\n",
+                   xut_iter,
+                   xwork_list[xut_iter].xut_okay,
+                   xut_count,
+                   xwork_list[xut_iter].xit_errno);
+        }
+
+        printf("total : %u/%u in %llu us, %.1f req/s\n",
+               xut_okay,
+               xut_count * xut_threads,
+               xtm_spent / 10ULL,
+               (0 == xtm_spent) ? 0.0 : (xut_okay * 1.0e7 / (double)xtm_spent));
+
+        //======================================
+    } while (0);
+
+    if (X_NULL != xntp_this)
+    {
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+    }
+
+    //======================================
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
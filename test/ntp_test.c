@@ -194,6 +194,8 @@ int main(int argc, char * argv[])
     xtime_vnsec_t xtm_ltime = XTIME_INVALID_VNSEC;
     xtime_descr_t xtm_descr = { 0 };
     xtime_descr_t xtm_local = { 0 };
+    x_char_t      xszt_ntime[XTIME_TEXT_LEN];
+    x_char_t      xszt_ltime[XTIME_TEXT_LEN];
 
 #if defined(_WIN32) || defined(_WIN64)
     WSADATA xwsa_data;
@@ -242,25 +244,10 @@ int main(int argc, char * argv[])
                        xit_iter + 1,
                        xopt_args.xntp_host,
                        xopt_args.xut_port);
-                printf("\tNTP response : [ %04d-%02d-%02d %d %02d:%02d:%02d.%03d ]\n",
-                       xtm_descr.ctx_year  ,
-                       xtm_descr.ctx_month ,
-                       xtm_descr.ctx_day   ,
-                       xtm_descr.ctx_week  ,
-                       xtm_descr.ctx_hour  ,
-                       xtm_descr.ctx_minute,
-                       xtm_descr.ctx_second,
-                       xtm_descr.ctx_msec  );
-
-                printf("\tLocal time   : [ %04d-%02d-%02d %d %02d:%02d:%02d.%03d ]\n",
-                       xtm_local.ctx_year  ,
-                       xtm_local.ctx_month ,
-                       xtm_local.ctx_day   ,
-                       xtm_local.ctx_week  ,
-                       xtm_local.ctx_hour  ,
-                       xtm_local.ctx_minute,
-                       xtm_local.ctx_second,
-                       xtm_local.ctx_msec  );
+                time_dtos(xtm_descr, xszt_ntime);
+                time_dtos(xtm_local, xszt_ltime);
+                printf("\tNTP response : [ %s %d ]\n", xszt_ntime, xtm_descr.ctx_week);
+                printf("\tLocal time   : [ %s %d ]\n", xszt_ltime, xtm_local.ctx_week);
 
                 printf("\tDeviation    : %lld us\n",
                        ((x_int64_t)(xtm_ltime - xtm_vnsec)) / 10LL);
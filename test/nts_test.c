@@ -0,0 +1,1217 @@
+﻿/**
+ * @file nts_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 NTS（Network Time Security，RFC 8915）请求 的程序。
+ * @note
+ * 先以 RFC 4493、RFC 5297 的 测试向量 校验 AES-CMAC 与 AES-SIV，
+ * 再在本机回环地址上 启动 简易的 NTS-KE 服务端（TLS 1.3，运行时生成 自签名证书）
+ * 与 NTS-NTP 服务端 线程，校验 握手、cookie 续取、篡改、NAK、丢包 等情况，
+ * 并对比 TLS 握手 与 单次 NTS 请求 的耗时。
+ */
+
+#include "ntp_client.h"
+#include "ntp_nts.h"
+#include "ntp_packet.h"
+#include "ntp_cmac.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <WinSock2.h>
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#ifdef XNTP_OPENSSL
+#include <openssl/ssl.h>
+#include <openssl/rand.h>
+#include <openssl/x509v3.h>
+#include <openssl/pem.h>
+#endif // XNTP_OPENSSL
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef XNTP_OPENSSL
+
+/** 测试服务端 所用的 CA 证书文件（运行时生成，结束时删除） */
+#define XNTS_CA_FILE     "nts_test_ca.pem"
+
+/** 与服务端证书 无关的 CA 证书文件（用于 校验失败 的情况） */
+#define XNTS_BAD_FILE    "nts_test_bad.pem"
+
+/** 测试服务端 cookie 的 nonce 字节数 */
+#define XNTS_CK_NONCE    16
+
+/** 测试服务端 cookie 的 字节数：nonce + 合成 IV + C2S/S2C 密钥的密文 */
+#define XNTS_CK_LEN      (XNTS_CK_NONCE + XSIV_TAG_LEN + 2 * XSIV_KEY_LEN)
+
+/** 共用 NTS 会话 的 并发线程数量 */
+#define XNTS_THREADS     4
+
+/**
+ * @enum  xnts_mode_t
+ * @brief NTS-NTP 服务端 的 应答方式。
+ */
+typedef enum xnts_mode_t
+{
+    xnts_mode_normal = 0,   ///< 正常应答
+    xnts_mode_tamper = 1,   ///< 篡改 应答的 密文
+    xnts_mode_nak    = 2,   ///< 回复 NTS NAK
+    xnts_mode_drop   = 3,   ///< 丢弃 请求
+} xnts_mode_t;
+
+/**
+ * @struct xnts_server_t
+ * @brief  简易 NTS 服务端（测试用）的 工作参数。
+ */
+typedef struct xnts_server_t
+{
+    x_sockfd_t    xfdt_tcpfd;   ///< NTS-KE 服务端 的 监听套接字
+    x_sockfd_t    xfdt_udpfd;   ///< NTS-NTP 服务端 的 套接字
+    x_uint16_t    xut_keport;   ///< NTS-KE 服务端 的 端口号
+    x_uint16_t    xut_ntport;   ///< NTS-NTP 服务端 的 端口号
+    SSL_CTX     * xctx_ptr;     ///< NTS-KE 服务端 的 TLS 上下文
+    xntp_siv_t    xsiv_master;  ///< 加密 cookie 所用的 主密钥
+    volatile x_int32_t xit_mode;   ///< NTS-NTP 服务端 的 应答方式（xnts_mode_t）
+    volatile x_uint32_t xut_kecount; ///< NTS-KE 服务端 完成的 握手次数
+    volatile x_bool_t  xbt_stop;   ///< 停止标识
+} xnts_server_t;
+
+/**
+ * @struct xnts_worker_t
+ * @brief  并发请求 线程 的 工作参数。
+ */
+typedef struct xnts_worker_t
+{
+    xntp_ntsptr_t xnts_sess;    ///< 共用的 NTS 会话
+    x_uint32_t    xut_count;    ///< 请求次数
+    x_uint32_t    xut_okay;     ///< 成功次数
+} xnts_worker_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 关闭套接字。
+ */
+static x_void_t sockfd_close(x_sockfd_t xfdt_sockfd)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    closesocket(xfdt_sockfd);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    close(xfdt_sockfd);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 将 十六进制字符串 转换为 字节数组（忽略空格）。
+ *
+ * @return x_uint32_t : 返回 字节数。
+ */
+static x_uint32_t hex_to_bytes(x_cstring_t xszt_hex, x_uchar_t * xbt_data)
+{
+    x_uint32_t xut_size = 0;
+    x_uint32_t xut_half = 0;
+    x_uint32_t xut_byte = 0;
+    x_char_t   xct_char = 0;
+
+    for (; '\0' != (xct_char = *xszt_hex); ++xszt_hex)
+    {
+        if ((xct_char >= '0') && (xct_char <= '9'))
+            xut_byte = (xut_byte << 4) | (x_uint32_t)(xct_char - '0');
+        else if ((xct_char >= 'a') && (xct_char <= 'f'))
+            xut_byte = (xut_byte << 4) | (x_uint32_t)(xct_char - 'a' + 10);
+        else
+            continue;
+
+        if (0 != (++xut_half & 1))
+            continue;
+
+        xbt_data[xut_size++] = (x_uchar_t)xut_byte;
+        xut_byte = 0;
+    }
+
+    return xut_size;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 以 RFC 4493 的 测试向量 校验 AES-128-CMAC。
+ *
+ * @return x_int32_t : 返回 失败的 向量数量。
+ */
+static x_int32_t kat_cmac(x_void_t)
+{
+    static const x_cstring_t XCMAC_KEY = "2b7e1516 28aed2a6 abf71588 09cf4f3c";
+    static const x_cstring_t XCMAC_MSG =
+        "6bc1bee2 2e409f96 e93d7e11 7393172a ae2d8a57 1e03ac9c 9eb76fac 45af8e51"
+        "30c81c46 a35ce411 e5fbc119 1a0a52ef f69f2445 df4f9b17 ad2b417b e66c3710";
+
+    static const struct
+    {
+        x_uint32_t  xut_mlen;
+        x_cstring_t xszt_mac;
+    } XCMAC_VECTOR[4] =
+    {
+        {  0, "bb1d6929 e9593728 7fa37d12 9b756746" },
+        { 16, "070a16b4 6b4d4144 f79bdd9d d04a287c" },
+        { 40, "dfa66747 de9ae630 30ca3261 1497c827" },
+        { 64, "51f0bebf 7e3b9d92 fc497417 79363cfe" },
+    };
+
+    x_int32_t   xit_fail = 0;
+    x_uint32_t  xut_iter = 0;
+    xntp_cmac_t xcmac;
+    x_uchar_t   xbt_key[XCMAC_BLOCK];
+    x_uchar_t   xbt_msg[64];
+    x_uchar_t   xbt_mac[XCMAC_BLOCK];
+    x_uchar_t   xbt_exp[XCMAC_BLOCK];
+
+    hex_to_bytes(XCMAC_KEY, xbt_key);
+    hex_to_bytes(XCMAC_MSG, xbt_msg);
+    if (!ntp_cmac_init(&xcmac, xbt_key))
+        return 4;
+
+    for (xut_iter = 0; xut_iter < 4; ++xut_iter)
+    {
+        hex_to_bytes(XCMAC_VECTOR[xut_iter].xszt_mac, xbt_exp);
+        ntp_cmac_calc(&xcmac, xbt_msg, XCMAC_VECTOR[xut_iter].xut_mlen, xbt_mac);
+        if (0 != memcmp(xbt_mac, xbt_exp, XCMAC_BLOCK))
+        {
+            printf("AES-CMAC vector %u (%u bytes) mismatched\n", xut_iter, XCMAC_VECTOR[xut_iter].xut_mlen);
+            xit_fail += 1;
+        }
+    }
+
+    return xit_fail;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 RFC 5297 附录 A 的 测试向量 校验 AES-SIV（加密、解密 以及 篡改后的 解密）。
+ *
+ * @return x_int32_t : 返回 失败的 向量数量。
+ */
+static x_int32_t kat_siv(x_void_t)
+{
+    static const struct
+    {
+        x_cstring_t xszt_key;
+        x_cstring_t xszt_ad[3];
+        x_cstring_t xszt_text;
+        x_cstring_t xszt_out;
+    } XSIV_VECTOR[2] =
+    {
+        {
+            "fffefdfc fbfaf9f8 f7f6f5f4 f3f2f1f0 f0f1f2f3 f4f5f6f7 f8f9fafb fcfdfeff",
+            {
+                "10111213 14151617 18191a1b 1c1d1e1f 20212223 24252627",
+                X_NULL,
+                X_NULL
+            },
+            "11223344 55667788 99aabbcc ddee",
+            "85632d07 c6e8f37f 950acd32 0a2ecc93 40c02b96 90c4dc04 daef7f6a fe5c"
+        },
+        {
+            "7f7e7d7c 7b7a7978 77767574 73727170 40414243 44454647 48494a4b 4c4d4e4f",
+            {
+                "00112233 44556677 8899aabb ccddeeff deaddada deaddada ffeeddcc bbaa9988 77665544 33221100",
+                "10203040 50607080 90a0",
+                "09f91102 9d74e35b d84156c5 635688c0"
+            },
+            "74686973 20697320 736f6d65 20706c61 696e7465 78742074 6f20656e 63727970"
+            "74207573 696e6720 5349562d 414553",
+            "7bdb6e3b 432667eb 06f4d14b ff2fbd0f cb900f2f ddbe4043 26601965 c889bf17"
+            "dba77ceb 094fa663 b7a3f748 ba8af829 ea64ad54 4a272e9c 485b62a3 fd5c0d"
+        },
+    };
+
+    x_int32_t     xit_fail = 0;
+    x_uint32_t    xut_iter = 0;
+    x_uint32_t    xut_nads = 0;
+    x_uint32_t    xut_tlen = 0;
+    xntp_siv_t    xsiv_this;
+    xntp_siv_ad_t xsiv_ad[3];
+    x_uchar_t     xbt_key[XSIV_KEY_LEN];
+    x_uchar_t     xbt_ad[3][64];
+    x_uchar_t     xbt_text[64];
+    x_uchar_t     xbt_exp[XSIV_TAG_LEN + 64];
+    x_uchar_t     xbt_out[XSIV_TAG_LEN + 64];
+    x_uchar_t     xbt_back[64];
+
+    for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+    {
+        hex_to_bytes(XSIV_VECTOR[xut_iter].xszt_key, xbt_key);
+        for (xut_nads = 0; (xut_nads < 3) && (X_NULL != XSIV_VECTOR[xut_iter].xszt_ad[xut_nads]); ++xut_nads)
+        {
+            xsiv_ad[xut_nads].xbt_data = xbt_ad[xut_nads];
+            xsiv_ad[xut_nads].xut_size = hex_to_bytes(XSIV_VECTOR[xut_iter].xszt_ad[xut_nads], xbt_ad[xut_nads]);
+        }
+        xut_tlen = hex_to_bytes(XSIV_VECTOR[xut_iter].xszt_text, xbt_text);
+        hex_to_bytes(XSIV_VECTOR[xut_iter].xszt_out, xbt_exp);
+
+        if (!ntp_siv_init(&xsiv_this, xbt_key))
+        {
+            xit_fail += 1;
+            continue;
+        }
+
+        ntp_siv_seal(&xsiv_this, xsiv_ad, xut_nads, xbt_text, xut_tlen, xbt_out);
+        if (0 != memcmp(xbt_out, xbt_exp, XSIV_TAG_LEN + xut_tlen))
+        {
+            printf("AES-SIV vector A.%u : seal mismatched\n", xut_iter + 1);
+            xit_fail += 1;
+        }
+
+        if (!ntp_siv_open(&xsiv_this, xsiv_ad, xut_nads, xbt_exp, XSIV_TAG_LEN + xut_tlen, xbt_back) ||
+            (0 != memcmp(xbt_back, xbt_text, xut_tlen)))
+        {
+            printf("AES-SIV vector A.%u : open failed\n", xut_iter + 1);
+            xit_fail += 1;
+        }
+
+        xbt_exp[XSIV_TAG_LEN + xut_tlen - 1] ^= 0x01;
+        if (ntp_siv_open(&xsiv_this, xsiv_ad, xut_nads, xbt_exp, XSIV_TAG_LEN + xut_tlen, xbt_back))
+        {
+            printf("AES-SIV vector A.%u : tampered ciphertext accepted\n", xut_iter + 1);
+            xit_fail += 1;
+        }
+    }
+
+    return xit_fail;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 生成 一个 自签名证书（EC P-256，适用于 localhost 与 127.0.0.1）。
+ *
+ * @param [out] xpkey_ptr : 返回 私钥。
+ * @param [out] xcert_ptr : 返回 证书。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；失败，返回 X_FALSE。
+ */
+static x_bool_t cert_create(EVP_PKEY ** xpkey_ptr, X509 ** xcert_ptr)
+{
+    x_bool_t       xbt_okay = X_FALSE;
+    EVP_PKEY_CTX * xpctx    = X_NULL;
+    EVP_PKEY     * xpkey    = X_NULL;
+    X509         * xcert    = X_NULL;
+    X509_NAME    * xname    = X_NULL;
+    X509_EXTENSION * xext   = X_NULL;
+    X509V3_CTX     xv3ctx;
+
+    do
+    {
+        xpctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, X_NULL);
+        if ((X_NULL == xpctx) ||
+            (EVP_PKEY_keygen_init(xpctx) <= 0) ||
+            (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(xpctx, NID_X9_62_prime256v1) <= 0) ||
+            (EVP_PKEY_keygen(xpctx, &xpkey) <= 0))
+        {
+            break;
+        }
+
+        xcert = X509_new();
+        if (X_NULL == xcert)
+            break;
+
+        X509_set_version(xcert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(xcert), (long)(time_vnsec() & 0x7FFFFFFF));
+        X509_gmtime_adj(X509_getm_notBefore(xcert), -3600L);
+        X509_gmtime_adj(X509_getm_notAfter(xcert), 24L * 3600L);
+        X509_set_pubkey(xcert, xpkey);
+
+        xname = X509_get_subject_name(xcert);
+        X509_NAME_add_entry_by_txt(xname, "CN", MBSTRING_ASC, (const x_uchar_t *)"localhost", -1, -1, 0);
+        X509_set_issuer_name(xcert, xname);
+
+        X509V3_set_ctx(&xv3ctx, xcert, xcert, X_NULL, X_NULL, 0);
+        xext = X509V3_EXT_conf_nid(X_NULL, &xv3ctx, NID_subject_alt_name, "DNS:localhost,IP:127.0.0.1");
+        if ((X_NULL == xext) || (1 != X509_add_ext(xcert, xext, -1)))
+            break;
+        X509_EXTENSION_free(xext);
+
+        xext = X509V3_EXT_conf_nid(X_NULL, &xv3ctx, NID_basic_constraints, "critical,CA:TRUE");
+        if ((X_NULL == xext) || (1 != X509_add_ext(xcert, xext, -1)))
+            break;
+
+        if (X509_sign(xcert, xpkey, EVP_sha256()) <= 0)
+            break;
+
+        *xpkey_ptr = xpkey;
+        *xcert_ptr = xcert;
+        xpkey = X_NULL;
+        xcert = X_NULL;
+        xbt_okay = X_TRUE;
+    } while (0);
+
+    if (X_NULL != xext ) X509_EXTENSION_free(xext);
+    if (X_NULL != xcert) X509_free(xcert);
+    if (X_NULL != xpkey) EVP_PKEY_free(xpkey);
+    if (X_NULL != xpctx) EVP_PKEY_CTX_free(xpctx);
+
+    return xbt_okay;
+}
+
+/**********************************************************/
+/**
+ * @brief 将 证书 以 PEM 格式 写入文件。
+ */
+static x_bool_t cert_write(X509 * xcert, x_cstring_t xszt_file)
+{
+    x_bool_t xbt_okay = X_FALSE;
+    FILE   * xfile    = X_NULL;
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4996)
+#endif // _MSC_VER
+    xfile = fopen(xszt_file, "w");
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+
+    if (X_NULL == xfile)
+        return X_FALSE;
+
+    xbt_okay = (1 == PEM_write_X509(xfile, xcert));
+    fclose(xfile);
+
+    return xbt_okay;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 建立 绑定 127.0.0.1 随机端口 的 套接字（TCP 时 同时开始监听）。
+ */
+static x_sockfd_t server_socket(x_int32_t xit_type, x_uint16_t * xut_port)
+{
+    x_sockfd_t         xfdt_sockfd = X_INVALID_SOCKFD;
+    struct sockaddr_in xaddr_host;
+#if defined(_WIN32) || defined(_WIN64)
+    x_int32_t          xit_alen = sizeof(struct sockaddr_in);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = sizeof(struct sockaddr_in);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    xfdt_sockfd = socket(AF_INET, xit_type, 0);
+    if (X_INVALID_SOCKFD == xfdt_sockfd)
+        return X_INVALID_SOCKFD;
+
+    memset(&xaddr_host, 0, sizeof(struct sockaddr_in));
+    xaddr_host.sin_family      = AF_INET;
+    xaddr_host.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    xaddr_host.sin_port        = 0;
+
+    if ((0 != bind(xfdt_sockfd, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in))) ||
+        (0 != getsockname(xfdt_sockfd, (struct sockaddr *)&xaddr_host, &xit_alen)) ||
+        ((SOCK_STREAM == xit_type) && (0 != listen(xfdt_sockfd, 8))))
+    {
+        sockfd_close(xfdt_sockfd);
+        return X_INVALID_SOCKFD;
+    }
+
+    *xut_port = ntohs(xaddr_host.sin_port);
+
+    return xfdt_sockfd;
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 一条 NTS-KE 记录。
+ */
+static x_uint32_t ke_record(x_uchar_t * xbt_dst, x_uint16_t xut_type, const x_uchar_t * xbt_body, x_uint32_t xut_blen)
+{
+    xbt_dst[0] = (x_uchar_t)(xut_type >> 8);
+    xbt_dst[1] = (x_uchar_t)(xut_type & 0xFF);
+    xbt_dst[2] = (x_uchar_t)(xut_blen >> 8);
+    xbt_dst[3] = (x_uchar_t)(xut_blen & 0xFF);
+    if (xut_blen > 0)
+        memcpy(xbt_dst + 4, xbt_body, xut_blen);
+
+    return 4 + xut_blen;
+}
+
+/**********************************************************/
+/**
+ * @brief 以 主密钥 加密 C2S/S2C 密钥，生成 一个 cookie（nonce + 合成 IV + 密文）。
+ */
+static x_void_t ck_make(const xntp_siv_t * xsiv_master, const x_uchar_t xbt_keys[2 * XSIV_KEY_LEN], x_uchar_t * xbt_cookie)
+{
+    xntp_siv_ad_t xsiv_ad;
+
+    RAND_bytes(xbt_cookie, XNTS_CK_NONCE);
+    xsiv_ad.xbt_data = xbt_cookie;
+    xsiv_ad.xut_size = XNTS_CK_NONCE;
+    ntp_siv_seal(xsiv_master, &xsiv_ad, 1, xbt_keys, 2 * XSIV_KEY_LEN, xbt_cookie + XNTS_CK_NONCE);
+}
+
+/**********************************************************/
+/**
+ * @brief NTS-KE 服务端 的 ALPN 选择回调（只接受 “ntske/1”）。
+ */
+static int alpn_select(SSL * xssl_ptr,
+                       const x_uchar_t ** xbt_out,
+                       x_uchar_t * xut_olen,
+                       const x_uchar_t * xbt_in,
+                       x_uint32_t xut_ilen,
+                       x_pvoid_t xpvt_arg)
+{
+    (x_void_t)xssl_ptr;
+    (x_void_t)xpvt_arg;
+
+    if (OPENSSL_NPN_NEGOTIATED != SSL_select_next_proto((x_uchar_t **)xbt_out, xut_olen,
+                                                       (const x_uchar_t *)"\x07ntske/1", 8,
+                                                       xbt_in, xut_ilen))
+    {
+        return SSL_TLSEXT_ERR_ALERT_FATAL;
+    }
+
+    return SSL_TLSEXT_ERR_OK;
+}
+
+/**********************************************************/
+/**
+ * @brief NTS-KE 服务端线程：逐个接受 TLS 连接，回复 协商结果、8 个 cookie 以及 NTS-NTP 服务端 的 地址。
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI ke_server_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_pvoid_t ke_server_proc(x_pvoid_t xpvt_param)
+#endif // defined(_WIN32) || defined(_WIN64)
+{
+    xnts_server_t * xsrv_ptr = (xnts_server_t *)xpvt_param;
+    x_sockfd_t      xfdt_conn = X_INVALID_SOCKFD;
+    SSL           * xssl_ptr = X_NULL;
+    x_uint32_t      xut_iter = 0;
+    x_uint32_t      xut_rlen = 0;
+    x_uint32_t      xut_slen = 0;
+    x_int32_t       xit_size = 0;
+    x_uchar_t       xbt_rbuf[256];
+    x_uchar_t       xbt_sbuf[1024];
+    x_uchar_t       xbt_keys[2 * XSIV_KEY_LEN];
+    x_uchar_t       xbt_cookie[XNTS_CK_LEN];
+    x_uchar_t       xbt_ectx[5] = { 0x00, 0x00, 0x00, 0x0F, 0x00 };
+    x_uchar_t       xbt_port[2];
+
+    static const x_uchar_t XNTS_PROTO[2] = { 0x00, 0x00 };
+    static const x_uchar_t XNTS_AEAD [2] = { 0x00, 0x0F };
+
+    while (!xsrv_ptr->xbt_stop)
+    {
+        xfdt_conn = accept(xsrv_ptr->xfdt_tcpfd, X_NULL, X_NULL);
+        if (X_INVALID_SOCKFD == xfdt_conn)
+            continue;
+
+        xssl_ptr = SSL_new(xsrv_ptr->xctx_ptr);
+        if ((X_NULL == xssl_ptr) || xsrv_ptr->xbt_stop)
+        {
+            if (X_NULL != xssl_ptr)
+                SSL_free(xssl_ptr);
+            sockfd_close(xfdt_conn);
+            continue;
+        }
+
+        SSL_set_fd(xssl_ptr, (x_int32_t)xfdt_conn);
+
+        do
+        {
+            if (1 != SSL_accept(xssl_ptr))
+                break;
+
+            // 读取 请求，直到 End of Message 记录（请求较短，忽略其内容）
+            for (xut_rlen = 0; xut_rlen < sizeof(xbt_rbuf); xut_rlen += (x_uint32_t)xit_size)
+            {
+                xit_size = SSL_read(xssl_ptr, xbt_rbuf + xut_rlen, (x_int32_t)(sizeof(xbt_rbuf) - xut_rlen));
+                if (xit_size <= 0)
+                    break;
+                if ((xut_rlen + (x_uint32_t)xit_size >= 4) &&
+                    (0 == memcmp(xbt_rbuf + xut_rlen + xit_size - 4, "\x80\x00\x00\x00", 4)))
+                {
+                    break;
+                }
+            }
+
+            if (xit_size <= 0)
+                break;
+
+            // C2S（上下文末字节 0x00）与 S2C（0x01）密钥
+            for (xut_iter = 0; xut_iter < 2; ++xut_iter)
+            {
+                xbt_ectx[4] = (x_uchar_t)xut_iter;
+                if (1 != SSL_export_keying_material(xssl_ptr, xbt_keys + xut_iter * XSIV_KEY_LEN, XSIV_KEY_LEN,
+                                                    "EXPORTER-network-time-security", 30,
+                                                    xbt_ectx, sizeof(xbt_ectx), 1))
+                {
+                    break;
+                }
+            }
+
+            if (xut_iter < 2)
+                break;
+
+            xbt_port[0] = (x_uchar_t)(xsrv_ptr->xut_ntport >> 8);
+            xbt_port[1] = (x_uchar_t)(xsrv_ptr->xut_ntport & 0xFF);
+
+            xut_slen  = ke_record(xbt_sbuf, 0x8001, XNTS_PROTO, 2);
+            xut_slen += ke_record(xbt_sbuf + xut_slen, 0x8004, XNTS_AEAD, 2);
+            for (xut_iter = 0; xut_iter < XNTS_COOKIE_MAX; ++xut_iter)
+            {
+                ck_make(&xsrv_ptr->xsiv_master, xbt_keys, xbt_cookie);
+                xut_slen += ke_record(xbt_sbuf + xut_slen, 0x0005, xbt_cookie, XNTS_CK_LEN);
+            }
+            xut_slen += ke_record(xbt_sbuf + xut_slen, 0x0006, (const x_uchar_t *)"127.0.0.1", 9);
+            xut_slen += ke_record(xbt_sbuf + xut_slen, 0x0007, xbt_port, 2);
+            xut_slen += ke_record(xbt_sbuf + xut_slen, 0x8000, X_NULL, 0);
+
+            if (SSL_write(xssl_ptr, xbt_sbuf, (x_int32_t)xut_slen) == (x_int32_t)xut_slen)
+                xsrv_ptr->xut_kecount += 1;
+
+            SSL_shutdown(xssl_ptr);
+        } while (0);
+
+        SSL_free(xssl_ptr);
+        sockfd_close(xfdt_conn);
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief NTS-NTP 服务端线程：以 cookie 恢复 会话密钥，校验 请求，
+ *        回复 Unique Identifier 以及 加密携带 新 cookie 的 NTS Authenticator。
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI ntp_server_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_pvoid_t ntp_server_proc(x_pvoid_t xpvt_param)
+#endif // defined(_WIN32) || defined(_WIN64)
+{
+    xnts_server_t    * xsrv_ptr  = (xnts_server_t *)xpvt_param;
+    x_int32_t          xit_rlen  = 0;
+    x_uint32_t         xut_iter  = 0;
+    x_uint32_t         xut_apos  = 0;
+    x_uint32_t         xut_want  = 0;
+    x_uint32_t         xut_tlen  = 0;
+    x_uint32_t         xut_slen  = 0;
+    x_uint64_t         xut_stamp = 0;
+    x_bool_t           xbt_okay  = X_FALSE;
+    const x_uchar_t  * xbt_uid   = X_NULL;
+    const x_uchar_t  * xbt_ck    = X_NULL;
+    xntp_view_t        xview_pk;
+    xntp_ext_t         xext_this;
+    xntp_ext_t         xext_auth;
+    xntp_siv_t         xsiv_c2s;
+    xntp_siv_t         xsiv_s2c;
+    xntp_siv_ad_t      xsiv_ad[2];
+    x_uchar_t          xbt_keys[2 * XSIV_KEY_LEN];
+    x_uchar_t          xbt_text[XNTS_COOKIE_MAX * (4 + XNTS_CK_LEN)];
+    x_uchar_t          xbt_rbuf[XNTP_PKT_MAX];
+    x_uchar_t          xbt_sbuf[XNTP_PKT_MAX];
+    struct sockaddr_in xaddr_peer;
+#if defined(_WIN32) || defined(_WIN64)
+    x_int32_t          xit_alen = 0;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = 0;
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    while (!xsrv_ptr->xbt_stop)
+    {
+        xit_alen = sizeof(struct sockaddr_in);
+        xit_rlen = (x_int32_t)recvfrom(xsrv_ptr->xfdt_udpfd,
+                                       (x_char_t *)xbt_rbuf,
+                                       sizeof(xbt_rbuf),
+                                       0,
+                                       (struct sockaddr *)&xaddr_peer,
+                                       &xit_alen);
+        if ((xit_rlen <= 0) || (0 != ntpv_init(&xview_pk, xbt_rbuf, xit_rlen)))
+            continue;
+
+        if (xnts_mode_drop == xsrv_ptr->xit_mode)
+            continue;
+
+        xut_stamp = ntp_stamp_from_vnsec(time_vnsec());
+
+        //======================================
+        // 解析 扩展字段
+
+        xbt_uid  = X_NULL;
+        xbt_ck   = X_NULL;
+        xut_want = 1;
+        memset(&xext_auth, 0, sizeof(xntp_ext_t));
+        for (xut_iter = 0; ntpv_ext_next(&xview_pk, &xut_iter, &xext_this); )
+        {
+            if ((0x0104 == xext_this.xut_type) && (XNTS_UID_LEN == xext_this.xut_vlen))
+                xbt_uid = xext_this.xbt_value;
+            else if ((0x0204 == xext_this.xut_type) && (XNTS_CK_LEN == xext_this.xut_vlen))
+                xbt_ck = xext_this.xbt_value;
+            else if ((0x0304 == xext_this.xut_type) && (xut_want < XNTS_COOKIE_MAX))
+                xut_want += 1;
+            else if (0x0404 == xext_this.xut_type)
+            {
+                xext_auth = xext_this;
+                xut_apos  = (x_uint32_t)(xext_this.xbt_value - 4 - xbt_rbuf);
+            }
+        }
+
+        if ((X_NULL == xbt_uid) || (X_NULL == xbt_ck) || (0 == xext_auth.xut_type))
+            continue;
+
+        //======================================
+        // 恢复 会话密钥，校验 请求
+
+        xsiv_ad[0].xbt_data = xbt_ck;
+        xsiv_ad[0].xut_size = XNTS_CK_NONCE;
+        xbt_okay = ntp_siv_open(&xsrv_ptr->xsiv_master, xsiv_ad, 1,
+                                xbt_ck + XNTS_CK_NONCE, XNTS_CK_LEN - XNTS_CK_NONCE, xbt_keys) &&
+                   ntp_siv_init(&xsiv_c2s, xbt_keys) &&
+                   ntp_siv_init(&xsiv_s2c, xbt_keys + XSIV_KEY_LEN);
+        if (xbt_okay)
+        {
+            xsiv_ad[0].xbt_data = xbt_rbuf;
+            xsiv_ad[0].xut_size = xut_apos;
+            xsiv_ad[1].xbt_data = xext_auth.xbt_value + 4;
+            xsiv_ad[1].xut_size = 16;
+            xbt_okay = (xext_auth.xut_vlen >= 4 + 16 + XSIV_TAG_LEN) &&
+                       ntp_siv_open(&xsiv_c2s, xsiv_ad, 2, xext_auth.xbt_value + 4 + 16, XSIV_TAG_LEN, xbt_text);
+        }
+
+        //======================================
+        // 应答 头部 与 Unique Identifier
+
+        ntp_req_init(xbt_sbuf);
+        xbt_sbuf[XNTP_OFF_LVM    ] = XNTP_LI_VN_MODE(0, 4, ntp_mode_server);
+        xbt_sbuf[XNTP_OFF_STRATUM] = 2;
+        ntp_store64(xbt_sbuf + XNTP_OFF_ORIGINATE, ntpv_transmit(&xview_pk));
+        ntp_store64(xbt_sbuf + XNTP_OFF_RECEIVE  , xut_stamp);
+        ntp_store64(xbt_sbuf + XNTP_OFF_TRANSMIT , xut_stamp);
+
+        ntp_store32(xbt_sbuf + XNTP_PKT_LEN, (0x0104 << 16) | (4 + XNTS_UID_LEN));
+        memcpy(xbt_sbuf + XNTP_PKT_LEN + 4, xbt_uid, XNTS_UID_LEN);
+        xut_slen = XNTP_PKT_LEN + 4 + XNTS_UID_LEN;
+
+        if (!xbt_okay || (xnts_mode_nak == xsrv_ptr->xit_mode))
+        {
+            // NTS NAK
+            xbt_sbuf[XNTP_OFF_STRATUM] = 0;
+            ntp_store32(xbt_sbuf + XNTP_OFF_REFID, 0x4E54534E);
+        }
+        else
+        {
+            // 新 cookie（数量 与 请求中的 cookie 加 占位字段 相同），经 S2C 密钥 加密
+            for (xut_iter = 0, xut_tlen = 0; xut_iter < xut_want; ++xut_iter)
+            {
+                ntp_store32(xbt_text + xut_tlen, (0x0204 << 16) | (4 + XNTS_CK_LEN));
+                ck_make(&xsrv_ptr->xsiv_master, xbt_keys, xbt_text + xut_tlen + 4);
+                xut_tlen += 4 + XNTS_CK_LEN;
+            }
+
+            ntp_store32(xbt_sbuf + xut_slen, (0x0404 << 16) | (4 + 4 + 16 + XSIV_TAG_LEN + xut_tlen));
+            ntp_store32(xbt_sbuf + xut_slen + 4, (16 << 16) | (XSIV_TAG_LEN + xut_tlen));
+            RAND_bytes(xbt_sbuf + xut_slen + 8, 16);
+
+            xsiv_ad[0].xbt_data = xbt_sbuf;
+            xsiv_ad[0].xut_size = xut_slen;
+            xsiv_ad[1].xbt_data = xbt_sbuf + xut_slen + 8;
+            xsiv_ad[1].xut_size = 16;
+            ntp_siv_seal(&xsiv_s2c, xsiv_ad, 2, xbt_text, xut_tlen, xbt_sbuf + xut_slen + 8 + 16);
+
+            if (xnts_mode_tamper == xsrv_ptr->xit_mode)
+                xbt_sbuf[xut_slen + 8 + 16 + XSIV_TAG_LEN] ^= 0x01;
+
+            xut_slen += 4 + 4 + 16 + XSIV_TAG_LEN + xut_tlen;
+        }
+
+        sendto(xsrv_ptr->xfdt_udpfd,
+               (const x_char_t *)xbt_sbuf,
+               xut_slen,
+               0,
+               (struct sockaddr *)&xaddr_peer,
+               sizeof(struct sockaddr_in));
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 通知 服务端线程 退出（置停止标识后，以 一个 TCP 连接 与 一个 空报文 唤醒 accept() 与 recvfrom()）。
+ */
+static x_void_t server_stop(xnts_server_t * xsrv_ptr)
+{
+    x_sockfd_t         xfdt_sockfd = X_INVALID_SOCKFD;
+    struct sockaddr_in xaddr_host;
+
+    memset(&xaddr_host, 0, sizeof(struct sockaddr_in));
+    xaddr_host.sin_family      = AF_INET;
+    xaddr_host.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    xsrv_ptr->xbt_stop = X_TRUE;
+
+    xaddr_host.sin_port = htons(xsrv_ptr->xut_ntport);
+    sendto(xsrv_ptr->xfdt_udpfd, "", 1, 0, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in));
+
+    xfdt_sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (X_INVALID_SOCKFD != xfdt_sockfd)
+    {
+        xaddr_host.sin_port = htons(xsrv_ptr->xut_keport);
+        connect(xfdt_sockfd, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in));
+        sockfd_close(xfdt_sockfd);
+    }
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 并发请求 线程：以 独立的 客户端对象、共用的 NTS 会话 逐个发送请求。
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI worker_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_pvoid_t worker_proc(x_pvoid_t xpvt_param)
+#endif // defined(_WIN32) || defined(_WIN64)
+{
+    xnts_worker_t * xwork_ptr = (xnts_worker_t *)xpvt_param;
+    xntp_cliptr_t   xntp_this = ntpcli_open();
+    x_uint32_t      xut_iter  = 0;
+
+    if (X_NULL == xntp_this)
+        return 0;
+
+    ntpcli_nts(xntp_this, xwork_ptr->xnts_sess);
+    for (xut_iter = 0; xut_iter < xwork_ptr->xut_count; ++xut_iter)
+    {
+        if (XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 3000)))
+            xwork_ptr->xut_okay += 1;
+    }
+
+    ntpcli_close(xntp_this);
+
+    return 0;
+}
+
+#endif // XNTP_OPENSSL
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-n <count>] [-s <host> [<port>]]\n", xszt_app);
+    printf("\t-n <count>         The number of requests for timing, default 200.\n");
+    printf("\t-s <host> [<port>] Query a real NTS-KE server (e.g. time.cloudflare.com) instead.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+#ifdef XNTP_OPENSSL
+    x_int32_t      xit_iter   = 0;
+    x_uint32_t     xut_iter   = 0;
+    x_uint32_t     xut_count  = 200;
+    x_uint32_t     xut_okay   = 0;
+    x_cstring_t    xszt_real  = X_NULL;
+    x_uint16_t     xut_rport  = NTS_KE_PORT;
+    x_int32_t      xit_fail   = 0;
+    x_uint16_t     xut_port   = 0;
+    xntp_cliptr_t  xntp_this  = X_NULL;
+    xntp_ntsptr_t  xnts_sess  = X_NULL;
+    xntp_ntsptr_t  xnts_temp  = X_NULL;
+    EVP_PKEY     * xpkey_srv  = X_NULL;
+    X509         * xcert_srv  = X_NULL;
+    EVP_PKEY     * xpkey_bad  = X_NULL;
+    X509         * xcert_bad  = X_NULL;
+    xtime_vnsec_t  xtm_start  = 0;
+    xtime_vnsec_t  xtm_kecost = 0;
+    xtime_vnsec_t  xtm_rqcost = 0;
+    xtime_vnsec_t  xtm_value  = XTIME_INVALID_VNSEC;
+    x_char_t       xszt_host[TEXT_LEN_256];
+    x_uchar_t      xbt_master[XSIV_KEY_LEN];
+    xnts_worker_t  xwork_list[XNTS_THREADS];
+
+    xnts_server_t  xnts_srv;
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE    xthd_ke  = X_NULL;
+    HANDLE    xthd_ntp = X_NULL;
+    HANDLE    xthd_work[XNTS_THREADS];
+    WSADATA   xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_t xthd_ke;
+    pthread_t xthd_ntp;
+    pthread_t xthd_work[XNTS_THREADS];
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    memset(&xnts_srv, 0, sizeof(xnts_server_t));
+    xnts_srv.xfdt_tcpfd = X_INVALID_SOCKFD;
+    xnts_srv.xfdt_udpfd = X_INVALID_SOCKFD;
+
+    //======================================
+
+    do
+    {
+        //======================================
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-n", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_count = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-s", argv[xit_iter])) && ((xit_iter + 1) < argc))
+            {
+                xszt_real = argv[++xit_iter];
+                if (((xit_iter + 1) < argc) && ('-' != argv[xit_iter + 1][0]))
+                    xut_rport = (x_uint16_t)atoi(argv[++xit_iter]);
+            }
+            else
+            {
+                usage(argv[0]);
+                return 0;
+            }
+        }
+
+        if (0 == xut_count)
+        {
+            usage(argv[0]);
+            break;
+        }
+
+        //======================================
+        // 查询 真实的 NTS 服务端
+
+        if (X_NULL != xszt_real)
+        {
+            xnts_sess = ntpnts_create(xszt_real, xut_rport, X_NULL);
+            xntp_this = ntpcli_open();
+            if ((X_NULL == xnts_sess) || (X_NULL == xntp_this))
+            {
+                printf("ntpnts_create() or ntpcli_open() failed, errno : %d\n", errno);
+                xit_fail += 1;
+                break;
+            }
+
+            ntpcli_nts(xntp_this, xnts_sess);
+            for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+            {
+                xtm_start = time_mono();
+                xtm_value = ntpcli_req_time(xntp_this, 3000);
+                printf("[%u] %s : errno = %d, offset = %lld us, spent = %llu us, cookies = %u, handshakes = %u\n",
+                       xut_iter,
+                       xszt_real,
+                       XTMVNSEC_IS_VALID(xtm_value) ? 0 : errno,
+                       XTMVNSEC_IS_VALID(xtm_value) ? ((x_int64_t)(xtm_value - time_vnsec())) / 10LL : 0LL,
+                       (time_mono() - xtm_start) / 10ULL,
+                       ntpnts_cookies(xnts_sess),
+                       ntpnts_handshakes(xnts_sess));
+            }
+            break;
+        }
+
+        //======================================
+        // 测试向量
+
+        xit_fail += kat_cmac();
+        xit_fail += kat_siv();
+        printf("vectors : %s\n", (0 == xit_fail) ? "passed" : "FAILED");
+        if (0 != xit_fail)
+            break;
+
+        //======================================
+        // 证书、TLS 上下文、主密钥
+
+        if (!cert_create(&xpkey_srv, &xcert_srv) || !cert_write(xcert_srv, XNTS_CA_FILE) ||
+            !cert_create(&xpkey_bad, &xcert_bad) || !cert_write(xcert_bad, XNTS_BAD_FILE))
+        {
+            printf("cert_create() or cert_write() failed\n");
+            xit_fail += 1;
+            break;
+        }
+
+        xnts_srv.xctx_ptr = SSL_CTX_new(TLS_server_method());
+        if ((X_NULL == xnts_srv.xctx_ptr) ||
+            (1 != SSL_CTX_set_min_proto_version(xnts_srv.xctx_ptr, TLS1_3_VERSION)) ||
+            (1 != SSL_CTX_use_certificate(xnts_srv.xctx_ptr, xcert_srv)) ||
+            (1 != SSL_CTX_use_PrivateKey(xnts_srv.xctx_ptr, xpkey_srv)))
+        {
+            printf("SSL_CTX_new() or the certificate setting failed\n");
+            xit_fail += 1;
+            break;
+        }
+        SSL_CTX_set_alpn_select_cb(xnts_srv.xctx_ptr, alpn_select, X_NULL);
+
+        if ((1 != RAND_bytes(xbt_master, XSIV_KEY_LEN)) || !ntp_siv_init(&xnts_srv.xsiv_master, xbt_master))
+        {
+            printf("the master key is unavailable\n");
+            xit_fail += 1;
+            break;
+        }
+
+        //======================================
+        // 服务端线程
+
+        xnts_srv.xfdt_tcpfd = server_socket(SOCK_STREAM, &xnts_srv.xut_keport);
+        xnts_srv.xfdt_udpfd = server_socket(SOCK_DGRAM, &xnts_srv.xut_ntport);
+        if ((X_INVALID_SOCKFD == xnts_srv.xfdt_tcpfd) || (X_INVALID_SOCKFD == xnts_srv.xfdt_udpfd))
+        {
+            printf("server_socket() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+#if defined(_WIN32) || defined(_WIN64)
+        xthd_ke  = CreateThread(X_NULL, 0, ke_server_proc, &xnts_srv, 0, X_NULL);
+        xthd_ntp = CreateThread(X_NULL, 0, ntp_server_proc, &xnts_srv, 0, X_NULL);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        pthread_create(&xthd_ke, X_NULL, ke_server_proc, &xnts_srv);
+        pthread_create(&xthd_ntp, X_NULL, ntp_server_proc, &xnts_srv);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+        xnts_sess = ntpnts_create("localhost", xnts_srv.xut_keport, XNTS_CA_FILE);
+        xntp_this = ntpcli_open();
+        if ((X_NULL == xnts_sess) || (X_NULL == xntp_this))
+        {
+            printf("ntpnts_create() or ntpcli_open() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+        //======================================
+        // 正确性校验
+
+#define XNTS_CHECK(xcond)                                             \
+        do                                                            \
+        {                                                             \
+            if (!(xcond))                                             \
+            {                                                         \
+                printf("check failed at line %d : %s\n",              \
+                       __LINE__, #xcond);                             \
+                xit_fail += 1;                                        \
+            }                                                         \
+        } while (0)
+
+        // 握手之前
+        XNTS_CHECK(0 == ntpnts_cookies(xnts_sess));
+        XNTS_CHECK(0 == ntpnts_handshakes(xnts_sess));
+        XNTS_CHECK(ENOTCONN == ntpnts_server(xnts_sess, xszt_host, TEXT_LEN_256, &xut_port));
+        XNTS_CHECK(EINVAL == ntpcli_nts(X_NULL, xnts_sess));
+
+        // 配置的 服务端 不被使用（取 一个 不可达的 端口）
+        ntpcli_config(xntp_this, "127.0.0.1", 9);
+        XNTS_CHECK(0 == ntpcli_nts(xntp_this, xnts_sess));
+
+        // 正常请求：只握手一次，cookie 每次 消耗一个 并 补回一个
+        for (xut_iter = 0, xut_okay = 0; xut_iter < 16; ++xut_iter)
+        {
+            xtm_value = ntpcli_req_time(xntp_this, 3000);
+            if (XTMVNSEC_IS_VALID(xtm_value) &&
+                ((x_int64_t)(xtm_value - time_vnsec()) < 10000000LL) &&
+                ((x_int64_t)(xtm_value - time_vnsec()) > -10000000LL))
+            {
+                xut_okay += 1;
+            }
+        }
+        XNTS_CHECK(16 == xut_okay);
+        XNTS_CHECK(1 == ntpnts_handshakes(xnts_sess));
+        XNTS_CHECK(1 == xnts_srv.xut_kecount);
+        XNTS_CHECK(XNTS_COOKIE_MAX == ntpnts_cookies(xnts_sess));
+        XNTS_CHECK(0 == ntpnts_server(xnts_sess, xszt_host, TEXT_LEN_256, &xut_port));
+        XNTS_CHECK((0 == strcmp("127.0.0.1", xszt_host)) && (xnts_srv.xut_ntport == xut_port));
+
+        // 篡改的 应答：请求失败，cookie 少一个，不重新握手
+        xnts_srv.xit_mode = xnts_mode_tamper;
+        xtm_value = ntpcli_req_time(xntp_this, 1000);
+        XNTS_CHECK(!XTMVNSEC_IS_VALID(xtm_value) && (EACCES == errno));
+        XNTS_CHECK((XNTS_COOKIE_MAX - 1) == ntpnts_cookies(xnts_sess));
+
+        // 丢包：每次 消耗一个 cookie；恢复后，一次应答 即可 补满
+        xnts_srv.xit_mode = xnts_mode_drop;
+        for (xut_iter = 0; xut_iter < 3; ++xut_iter)
+        {
+            XNTS_CHECK(!XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 100)));
+        }
+        XNTS_CHECK((XNTS_COOKIE_MAX - 4) == ntpnts_cookies(xnts_sess));
+
+        xnts_srv.xit_mode = xnts_mode_normal;
+        XNTS_CHECK(XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 3000)));
+        XNTS_CHECK(XNTS_COOKIE_MAX == ntpnts_cookies(xnts_sess));
+        XNTS_CHECK(1 == ntpnts_handshakes(xnts_sess));
+
+        // cookie 耗尽 后，重新握手
+        xnts_srv.xit_mode = xnts_mode_drop;
+        for (xut_iter = 0; xut_iter < XNTS_COOKIE_MAX; ++xut_iter)
+        {
+            XNTS_CHECK(!XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 100)));
+        }
+        XNTS_CHECK(0 == ntpnts_cookies(xnts_sess));
+
+        xnts_srv.xit_mode = xnts_mode_normal;
+        XNTS_CHECK(XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 3000)));
+        XNTS_CHECK(2 == ntpnts_handshakes(xnts_sess));
+        XNTS_CHECK(XNTS_COOKIE_MAX == ntpnts_cookies(xnts_sess));
+
+        // NTS NAK：清空 cookie，下次请求 重新握手
+        xnts_srv.xit_mode = xnts_mode_nak;
+        XNTS_CHECK(!XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 1000)));
+        XNTS_CHECK(0 == ntpnts_cookies(xnts_sess));
+
+        xnts_srv.xit_mode = xnts_mode_normal;
+        XNTS_CHECK(XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 3000)));
+        XNTS_CHECK(3 == ntpnts_handshakes(xnts_sess));
+
+        // 多个线程 共用 一个会话：不额外握手
+        for (xut_iter = 0; xut_iter < XNTS_THREADS; ++xut_iter)
+        {
+            xwork_list[xut_iter].xnts_sess = xnts_sess;
+            xwork_list[xut_iter].xut_count = 64;
+            xwork_list[xut_iter].xut_okay  = 0;
+#if defined(_WIN32) || defined(_WIN64)
+            xthd_work[xut_iter] = CreateThread(X_NULL, 0, worker_proc, &xwork_list[xut_iter], 0, X_NULL);
+#else // !(defined(_WIN32) || defined(_WIN64))
+            pthread_create(&xthd_work[xut_iter], X_NULL, worker_proc, &xwork_list[xut_iter]);
+#endif // defined(_WIN32) || defined(_WIN64)
+        }
+
+        for (xut_iter = 0, xut_okay = 0; xut_iter < XNTS_THREADS; ++xut_iter)
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            WaitForSingleObject(xthd_work[xut_iter], INFINITE);
+            CloseHandle(xthd_work[xut_iter]);
+#else // !(defined(_WIN32) || defined(_WIN64))
+            pthread_join(xthd_work[xut_iter], X_NULL);
+#endif // defined(_WIN32) || defined(_WIN64)
+            xut_okay += xwork_list[xut_iter].xut_okay;
+        }
+        XNTS_CHECK((XNTS_THREADS * 64) == xut_okay);
+        XNTS_CHECK(3 == ntpnts_handshakes(xnts_sess));
+
+        // 证书 不受信任
+        xnts_temp = ntpnts_create("localhost", xnts_srv.xut_keport, XNTS_BAD_FILE);
+        XNTS_CHECK((X_NULL != xnts_temp) && (EACCES == ntpnts_handshake(xnts_temp, XTIME_INVALID_VNSEC)));
+        XNTS_CHECK(0 == ntpcli_nts(xntp_this, xnts_temp));
+        XNTS_CHECK(!XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 3000)) && (EACCES == errno));
+        ntpnts_destroy(xnts_temp);
+
+        // 证书 与 主机名 不符
+        xnts_temp = ntpnts_create("127.0.0.2", xnts_srv.xut_keport, XNTS_CA_FILE);
+        XNTS_CHECK((X_NULL != xnts_temp) && (0 != ntpnts_handshake(xnts_temp, time_mono() + 1000 * XTIME_VNSEC_MSEC)));
+        ntpnts_destroy(xnts_temp);
+        xnts_temp = X_NULL;
+
+        XNTS_CHECK(0 == ntpcli_nts(xntp_this, xnts_sess));
+
+#undef XNTS_CHECK
+
+        printf("checks : %s\n", (0 == xit_fail) ? "passed" : "FAILED");
+        if (0 != xit_fail)
+            break;
+
+        //======================================
+        // 耗时：TLS 握手（NTS-KE） 与 单次 NTS 请求
+
+        xtm_start = time_mono();
+        for (xut_iter = 0; xut_iter < 16; ++xut_iter)
+        {
+            if (0 != ntpnts_handshake(xnts_sess, XTIME_INVALID_VNSEC))
+                xit_fail += 1;
+        }
+        xtm_kecost = (time_mono() - xtm_start) / 16;
+
+        xtm_start = time_mono();
+        for (xut_iter = 0, xut_okay = 0; xut_iter < xut_count; ++xut_iter)
+        {
+            if (XTMVNSEC_IS_VALID(ntpcli_req_time(xntp_this, 3000)))
+                xut_okay += 1;
+        }
+        xtm_rqcost = (time_mono() - xtm_start) / xut_count;
+
+        printf("handshake : %.1f us/handshake\n", xtm_kecost / 10.0);
+        printf("request   : %u/%u replies, %.1f us/req, handshakes %u\n",
+               xut_okay, xut_count, xtm_rqcost / 10.0, ntpnts_handshakes(xnts_sess));
+
+        if (xut_okay != xut_count)
+            xit_fail += 1;
+
+        //======================================
+    } while (0);
+
+    if (X_INVALID_SOCKFD != xnts_srv.xfdt_udpfd)
+    {
+        server_stop(&xnts_srv);
+#if defined(_WIN32) || defined(_WIN64)
+        WaitForSingleObject(xthd_ke, INFINITE);
+        WaitForSingleObject(xthd_ntp, INFINITE);
+        CloseHandle(xthd_ke);
+        CloseHandle(xthd_ntp);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        pthread_join(xthd_ke, X_NULL);
+        pthread_join(xthd_ntp, X_NULL);
+#endif // defined(_WIN32) || defined(_WIN64)
+    }
+
+    if (X_INVALID_SOCKFD != xnts_srv.xfdt_tcpfd)
+        sockfd_close(xnts_srv.xfdt_tcpfd);
+    if (X_INVALID_SOCKFD != xnts_srv.xfdt_udpfd)
+        sockfd_close(xnts_srv.xfdt_udpfd);
+
+    if (X_NULL != xntp_this)
+    {
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+    }
+
+    ntpnts_destroy(xnts_sess);
+
+    if (X_NULL != xnts_srv.xctx_ptr) SSL_CTX_free(xnts_srv.xctx_ptr);
+    if (X_NULL != xcert_srv) X509_free(xcert_srv);
+    if (X_NULL != xpkey_srv) EVP_PKEY_free(xpkey_srv);
+    if (X_NULL != xcert_bad) X509_free(xcert_bad);
+    if (X_NULL != xpkey_bad) EVP_PKEY_free(xpkey_bad);
+
+    remove(XNTS_CA_FILE);
+    remove(XNTS_BAD_FILE);
+
+    //======================================
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    return (0 == xit_fail) ? 0 : 1;
+#else // !XNTP_OPENSSL
+    (x_void_t)argc;
+    usage(argv[0]);
+    printf("NTS is unavailable in this build (XNTP_OPENSSL is off)\n");
+    return 0;
+#endif // XNTP_OPENSSL
+}
+
+////////////////////////////////////////////////////////////////////////////////
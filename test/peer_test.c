@@ -0,0 +1,772 @@
+﻿/**
+ * @file peer_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 对称模式（主动/被动 对等体）的 关联状态机 与 轮询器 的 对称模式。
+ * @note
+ * 先在内存中 直接交换报文，校验 关联状态机 的 originate/receive/transmit 记录、重复 与 过期报文、认证；
+ * 再在本机回环接口上 启动 三个 轮询器 节点 与 一个 简易的 对等体线程：
+ * 节点 A 与 节点 B 互为 主动对等体；节点 C 只建立 被动关联；
+ * 对等体线程 的 时钟 比本地时钟 快 XPR_OFFSET，以 被动模式 应答 A，并 应答 A 的 客户端轮询。
+ */
+
+#include "ntp_poller.h"
+#include "ntp_peer.h"
+#include "ntp_packet.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 对等体线程 的 时钟 相对于 本地时钟 的 偏差（100 纳秒） */
+#define XPR_OFFSET      ((x_int64_t)(2500 * XTIME_VNSEC_MSEC))
+
+/** 偏差 的 允许误差（100 纳秒） */
+#define XPR_TOLERANCE   ((x_int64_t)(10 * XTIME_VNSEC_MSEC))
+
+/** 各节点的 轮询周期（毫秒） */
+#define XPR_PERIOD      100
+
+/** 每个节点 最多记录的 对端数量 */
+#define XPR_TRACK_MAX   8
+
+/**
+ * @struct xpr_track_t
+ * @brief  节点 对 某个对端 的 回调结果 统计。
+ */
+typedef struct xpr_track_t
+{
+    x_uint32_t xut_peer;    ///< 对端标识
+    x_uint32_t xut_mode;    ///< 本端模式
+    x_int64_t  xit_expect;  ///< 期望的 偏差（100 纳秒）
+    x_uint32_t xut_okay;    ///< 成功的 次数
+    x_uint32_t xut_tmout;   ///< 以 ETIMEDOUT 回调的 次数
+    x_uint32_t xut_error;   ///< 以 其他错误码 回调的 次数
+    x_int64_t  xit_maxerr;  ///< 偏差 的 最大误差（100 纳秒）
+} xpr_track_t;
+
+/**
+ * @struct xpr_node_t
+ * @brief  轮询器 节点（单个分片，回调 只在 分片线程 中执行）。
+ */
+typedef struct xpr_node_t
+{
+    xntp_pollptr_t xpoll_ptr;                ///< 轮询器
+    x_uint16_t     xut_sport;                ///< 对称模式 的 本地端口
+    x_uint32_t     xut_count;                ///< 已记录的 对端数量
+    xpr_track_t    xtrack[XPR_TRACK_MAX];    ///< 各对端的 统计
+} xpr_node_t;
+
+/**
+ * @struct xpr_shifted_t
+ * @brief  时钟偏快 的 简易对等体（测试用，不使用 ntpasc_*，以便 交叉验证）。
+ */
+typedef struct xpr_shifted_t
+{
+    x_sockfd_t          xfdt_sockfd;  ///< 套接字（绑定 127.0.0.1）
+    x_uint16_t          xut_port;     ///< 端口号
+    volatile x_uint32_t xut_active;   ///< 收到的 主动模式 报文 数量
+    volatile x_uint32_t xut_client;   ///< 收到的 客户端模式 报文 数量
+    volatile x_bool_t   xbt_stop;     ///< 停止标识
+} xpr_shifted_t;
+
+/**********************************************************/
+/**
+ * @brief 关闭套接字。
+ */
+static x_void_t sockfd_close(x_sockfd_t xfdt_sockfd)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    closesocket(xfdt_sockfd);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    close(xfdt_sockfd);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 取得 一个 空闲的 UDP 端口号（绑定 随机端口 后 立即关闭）。
+ */
+static x_uint16_t free_port(x_void_t)
+{
+    x_sockfd_t         xfdt_sockfd = X_INVALID_SOCKFD;
+    x_uint16_t         xut_port = 0;
+    struct sockaddr_in xaddr_host;
+#if defined(_WIN32) || defined(_WIN64)
+    x_int32_t          xit_alen = sizeof(struct sockaddr_in);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = sizeof(struct sockaddr_in);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    xfdt_sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (X_INVALID_SOCKFD == xfdt_sockfd)
+        return 0;
+
+    memset(&xaddr_host, 0, sizeof(struct sockaddr_in));
+    xaddr_host.sin_family = AF_INET;
+    if ((0 == bind(xfdt_sockfd, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in))) &&
+        (0 == getsockname(xfdt_sockfd, (struct sockaddr *)&xaddr_host, &xit_alen)))
+    {
+        xut_port = ntohs(xaddr_host.sin_port);
+    }
+
+    sockfd_close(xfdt_sockfd);
+
+    return xut_port;
+}
+
+/**********************************************************/
+/**
+ * @brief 在 节点 中 查找（或 新建）对端 的 统计项。
+ */
+static xpr_track_t * node_track(xpr_node_t * xnode_ptr, x_uint32_t xut_peer, x_uint32_t xut_mode)
+{
+    x_uint32_t xut_iter = 0;
+
+    for (xut_iter = 0; xut_iter < xnode_ptr->xut_count; ++xut_iter)
+    {
+        if (xut_peer == xnode_ptr->xtrack[xut_iter].xut_peer)
+            return &xnode_ptr->xtrack[xut_iter];
+    }
+
+    if (xnode_ptr->xut_count >= XPR_TRACK_MAX)
+        return X_NULL;
+
+    xnode_ptr->xtrack[xnode_ptr->xut_count].xut_peer = xut_peer;
+    xnode_ptr->xtrack[xnode_ptr->xut_count].xut_mode = xut_mode;
+    return &xnode_ptr->xtrack[xnode_ptr->xut_count++];
+}
+
+/**********************************************************/
+/**
+ * @brief 轮询结果的 回调函数：按对端 统计 成功次数、错误 与 偏差的 最大误差。
+ */
+static x_void_t node_result(x_pvoid_t xpvt_ctxt, const xntp_poll_result_t * xres_ptr)
+{
+    xpr_node_t  * xnode_ptr = (xpr_node_t *)xpvt_ctxt;
+    xpr_track_t * xtrk_ptr  = node_track(xnode_ptr, xres_ptr->xut_peer, xres_ptr->xut_mode);
+    x_int64_t     xit_error = 0;
+
+    if (X_NULL == xtrk_ptr)
+    {
+        return;
+    }
+
+    xtrk_ptr->xut_mode = xres_ptr->xut_mode;
+
+    if (ETIMEDOUT == xres_ptr->xit_errno)
+    {
+        xtrk_ptr->xut_tmout += 1;
+        return;
+    }
+
+    if (0 != xres_ptr->xit_errno)
+    {
+        xtrk_ptr->xut_error += 1;
+        return;
+    }
+
+    xit_error = xres_ptr->xit_offset - xtrk_ptr->xit_expect;
+    if (xit_error < 0)
+        xit_error = -xit_error;
+    if (xit_error > xtrk_ptr->xit_maxerr)
+        xtrk_ptr->xit_maxerr = xit_error;
+
+    xtrk_ptr->xut_okay += 1;
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 节点（单个分片；xut_sport 为 对称模式 的 本地端口）。
+ */
+static x_bool_t node_open(xpr_node_t * xnode_ptr, x_uint16_t xut_sport, x_bool_t xbt_passive)
+{
+    xntp_poll_conf_t xconf_this;
+
+    memset(xnode_ptr, 0, sizeof(xpr_node_t));
+    memset(&xconf_this, 0, sizeof(xntp_poll_conf_t));
+    xconf_this.xut_shards  = 1;
+    xconf_this.xut_period  = XPR_PERIOD;
+    xconf_this.xut_tmout   = XPR_PERIOD / 2;
+    xconf_this.xfunc_cbk   = node_result;
+    xconf_this.xpvt_ctxt   = xnode_ptr;
+    xconf_this.xut_sport   = xut_sport;
+    xconf_this.xbt_passive = xbt_passive;
+    xconf_this.xut_stratum = 2;
+
+    xnode_ptr->xut_sport = xut_sport;
+    xnode_ptr->xpoll_ptr = ntppoll_create(&xconf_this);
+    if (X_NULL == xnode_ptr->xpoll_ptr)
+    {
+        printf("ntppoll_create() return X_NULL, errno : %d\n", errno);
+        return X_FALSE;
+    }
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 为 节点 添加 对端，并登记 其 期望的 偏差。
+ */
+static x_uint32_t node_add(
+                    xpr_node_t * xnode_ptr,
+                    x_bool_t xbt_symm,
+                    x_uint16_t xut_port,
+                    x_int64_t xit_expect)
+{
+    x_uint32_t    xut_peer = 0;
+    xpr_track_t * xtrk_ptr = X_NULL;
+    x_int32_t     xit_errno = 0;
+
+    if (xbt_symm)
+        xit_errno = ntppoll_add_peer(xnode_ptr->xpoll_ptr, INADDR_LOOPBACK, xut_port, &xut_peer);
+    else
+        xit_errno = ntppoll_add(xnode_ptr->xpoll_ptr, INADDR_LOOPBACK, xut_port, &xut_peer);
+
+    if (0 != xit_errno)
+    {
+        printf("ntppoll_add%s() return %d\n", xbt_symm ? "_peer" : "", xit_errno);
+        return 0;
+    }
+
+    xtrk_ptr = node_track(xnode_ptr, xut_peer, xbt_symm ? ntp_mode_initiative : ntp_mode_client);
+    if (X_NULL != xtrk_ptr)
+        xtrk_ptr->xit_expect = xit_expect;
+
+    return xut_peer;
+}
+
+/**********************************************************/
+/**
+ * @brief 查找 节点中 指定本端模式 的 首个统计项（被动关联 的 对端标识 事先未知）。
+ */
+static xpr_track_t * node_find_mode(xpr_node_t * xnode_ptr, x_uint32_t xut_mode)
+{
+    x_uint32_t xut_iter = 0;
+
+    for (xut_iter = 0; xut_iter < xnode_ptr->xut_count; ++xut_iter)
+    {
+        if (xut_mode == xnode_ptr->xtrack[xut_iter].xut_mode)
+            return &xnode_ptr->xtrack[xut_iter];
+    }
+
+    return X_NULL;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 时钟偏快 的 对等体线程：以 被动模式 应答 主动模式 的报文，以 服务器模式 应答 客户端请求。
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static DWORD WINAPI shifted_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static x_pvoid_t shifted_proc(x_pvoid_t xpvt_param)
+#endif // defined(_WIN32) || defined(_WIN64)
+{
+    xpr_shifted_t    * xsft_ptr = (xpr_shifted_t *)xpvt_param;
+    x_int32_t          xit_rlen = 0;
+    x_uint32_t         xut_mode = 0;
+    x_uint64_t         xut_recv = 0;
+    xntp_view_t        xview_pk;
+    x_uchar_t          xbt_rbuf[XNTP_PKT_MAX];
+    x_uchar_t          xbt_sbuf[XNTP_PKT_LEN];
+    struct sockaddr_in xaddr_peer;
+    fd_set             xfds_rset;
+    struct timeval     xtm_value;
+#if defined(_WIN32) || defined(_WIN64)
+    x_int32_t          xit_alen = 0;
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = 0;
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    while (!xsft_ptr->xbt_stop)
+    {
+        xtm_value.tv_sec  = 0;
+        xtm_value.tv_usec = 10000;
+
+        FD_ZERO(&xfds_rset);
+        FD_SET(xsft_ptr->xfdt_sockfd, &xfds_rset);
+        if (select((x_int32_t)(xsft_ptr->xfdt_sockfd + 1), &xfds_rset, X_NULL, X_NULL, &xtm_value) <= 0)
+            continue;
+
+        xit_alen = sizeof(struct sockaddr_in);
+        xit_rlen = (x_int32_t)recvfrom(xsft_ptr->xfdt_sockfd,
+                                       (x_char_t *)xbt_rbuf,
+                                       sizeof(xbt_rbuf),
+                                       0,
+                                       (struct sockaddr *)&xaddr_peer,
+                                       &xit_alen);
+        xut_recv = ntp_stamp_from_vnsec((xtime_vnsec_t)((x_int64_t)time_vnsec() + XPR_OFFSET));
+
+        if ((xit_rlen <= 0) || (0 != ntpv_init(&xview_pk, xbt_rbuf, xit_rlen)))
+            continue;
+
+        xut_mode = ntpv_mode(&xview_pk);
+        if (ntp_mode_initiative == xut_mode)
+            xsft_ptr->xut_active += 1;
+        else if (ntp_mode_client == xut_mode)
+            xsft_ptr->xut_client += 1;
+        else
+            continue;
+
+        // 两种应答 的 originate/receive 字段 相同：回送 请求的 发送时间戳，以及 本端的 接收时间
+        ntp_req_init(xbt_sbuf);
+        xbt_sbuf[XNTP_OFF_LVM    ] = XNTP_LI_VN_MODE(0, 4, (ntp_mode_client == xut_mode) ? ntp_mode_server : ntp_mode_passive);
+        xbt_sbuf[XNTP_OFF_STRATUM] = 1;
+        ntp_store64(xbt_sbuf + XNTP_OFF_ORIGINATE, ntpv_transmit(&xview_pk));
+        ntp_store64(xbt_sbuf + XNTP_OFF_RECEIVE  , xut_recv);
+        ntp_store64(xbt_sbuf + XNTP_OFF_TRANSMIT ,
+                    ntp_stamp_from_vnsec((xtime_vnsec_t)((x_int64_t)time_vnsec() + XPR_OFFSET)));
+
+        sendto(xsft_ptr->xfdt_sockfd, (const x_char_t *)xbt_sbuf, XNTP_PKT_LEN, 0,
+               (struct sockaddr *)&xaddr_peer, sizeof(struct sockaddr_in));
+    }
+
+    return 0;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 在内存中 交换报文，校验 关联状态机（xkey_table 不为 X_NULL 时，以 key ID 1 认证）。
+ *
+ * @return x_int32_t : 返回 失败的 检查项 数量。
+ */
+static x_int32_t check_assoc(xntp_keyptr_t xkey_table)
+{
+    x_int32_t     xit_fail  = 0;
+    x_uint32_t    xut_keyid = (X_NULL != xkey_table) ? 1 : 0;
+    x_uint32_t    xut_alen  = 0;
+    x_uint32_t    xut_blen  = 0;
+    x_uint32_t    xut_clen  = 0;
+    xntp_assoc_t  xasc_a;
+    xntp_assoc_t  xasc_b;
+    xntp_assoc_t  xasc_c;
+    xntp_view_t   xview_pk;
+    xtime_vnsec_t xtm_4time[4];
+    x_uchar_t     xbt_pka[XNTP_ASSOC_PKT_MAX];
+    x_uchar_t     xbt_pkb[XNTP_ASSOC_PKT_MAX];
+    x_uchar_t     xbt_pkc[XNTP_ASSOC_PKT_MAX];
+
+#define XPR_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+/** 以 当前时刻 作为 T4，由 关联 处理 报文 */
+#define XPR_RECV(xasc, xpack, xplen)                                  \
+    ((0 == ntpv_init(&xview_pk, (xpack), (x_int32_t)(xplen))) ?        \
+     ntpasc_recv(&(xasc), xkey_table, &xview_pk, time_vnsec(), xtm_4time) : EBADMSG)
+
+    XPR_CHECK(EINVAL == ntpasc_init(&xasc_a, ntp_mode_client, 2, xut_keyid));
+    XPR_CHECK(EINVAL == ntpasc_init(&xasc_a, ntp_mode_initiative, 17, xut_keyid));
+    XPR_CHECK(0 == ntpasc_init(&xasc_a, ntp_mode_initiative, 2, xut_keyid));
+    XPR_CHECK(0 == ntpasc_init(&xasc_b, ntp_mode_passive, 0, xut_keyid));
+    XPR_CHECK(16 == xasc_b.xut_stratum);
+
+    //======================================
+    // A 首个报文：originate 与 receive 均为 0；B 只记录，不产生样本
+
+    XPR_CHECK(0 == ntpasc_build(&xasc_a, xkey_table, xbt_pka, &xut_alen));
+    XPR_CHECK(xut_alen == (XNTP_PKT_LEN + ((0 != xut_keyid) ? 24u : 0u)));
+    XPR_CHECK(ntp_mode_initiative == (xbt_pka[XNTP_OFF_LVM] & 7));
+    XPR_CHECK(0 == ntp_load64(xbt_pka + XNTP_OFF_ORIGINATE));
+    XPR_CHECK(EAGAIN == XPR_RECV(xasc_b, xbt_pka, xut_alen));
+    XPR_CHECK(xasc_b.xut_org == ntp_load64(xbt_pka + XNTP_OFF_TRANSMIT));
+
+    // B 应答：originate 回送 A 的 发送时间戳，A 得到样本
+    XPR_CHECK(0 == ntpasc_build(&xasc_b, xkey_table, xbt_pkb, &xut_blen));
+    XPR_CHECK(ntp_mode_passive == (xbt_pkb[XNTP_OFF_LVM] & 7));
+    XPR_CHECK(3 == (xbt_pkb[XNTP_OFF_LVM] >> 6));
+    XPR_CHECK(ntp_load64(xbt_pkb + XNTP_OFF_ORIGINATE) == ntp_load64(xbt_pka + XNTP_OFF_TRANSMIT));
+    XPR_CHECK(0 == XPR_RECV(xasc_a, xbt_pkb, xut_blen));
+    // 时间戳 经 NTP 格式 往返转换，会有 100 纳秒 以内的 截断误差
+    XPR_CHECK(xtm_4time[0] <= xtm_4time[3]);
+    XPR_CHECK(((x_int64_t)(xtm_4time[3] - xtm_4time[0]) - (x_int64_t)(xtm_4time[2] - xtm_4time[1])) >= -2);
+    XPR_CHECK(1 == (xasc_a.xut_reach & 1));
+    XPR_CHECK(ntp_mode_passive == xasc_a.xut_pmode);
+
+    // 重复的报文
+    XPR_CHECK(EALREADY == XPR_RECV(xasc_a, xbt_pkb, xut_blen));
+
+    //======================================
+    // A 再次发送 之后，B 的 旧报文（回送 A 上一个 发送时间戳）为 过期报文
+
+    XPR_CHECK(0 == ntpasc_build(&xasc_a, xkey_table, xbt_pka, &xut_alen));
+    XPR_CHECK(0 == (xasc_a.xut_reach & 1));
+    XPR_CHECK(0 == ntpasc_build(&xasc_b, xkey_table, xbt_pkb, &xut_blen));
+    XPR_CHECK(EPROTO == XPR_RECV(xasc_a, xbt_pkb, xut_blen));
+
+    // 过期报文 依然更新了 A 的记录：A 的 下一个报文 回送 B 的 最近发送时间戳，B 得到样本
+    XPR_CHECK(0 == ntpasc_build(&xasc_a, xkey_table, xbt_pkc, &xut_clen));
+    XPR_CHECK(ntp_load64(xbt_pkc + XNTP_OFF_ORIGINATE) == ntp_load64(xbt_pkb + XNTP_OFF_TRANSMIT));
+    XPR_CHECK(EPROTO == XPR_RECV(xasc_b, xbt_pka, xut_alen));
+    XPR_CHECK(0 == XPR_RECV(xasc_b, xbt_pkc, xut_clen));
+    XPR_CHECK(xtm_4time[0] == xasc_b.xtm_xmt);
+
+    // 发送时间戳 严格递增
+    XPR_CHECK(ntp_load64(xbt_pkc + XNTP_OFF_TRANSMIT) > ntp_load64(xbt_pka + XNTP_OFF_TRANSMIT));
+
+    //======================================
+    // 模式：被动对等体 之间 不能关联，客户端 报文 不属于 对称模式
+
+    XPR_CHECK(0 == ntpasc_init(&xasc_c, ntp_mode_passive, 2, xut_keyid));
+    XPR_CHECK(EBADMSG == XPR_RECV(xasc_c, xbt_pkb, xut_blen));
+
+    ntp_req_init(xbt_pkc);
+    ntp_req_stamp(xbt_pkc, time_vnsec());
+    XPR_CHECK(EBADMSG == XPR_RECV(xasc_c, xbt_pkc, XNTP_PKT_LEN));
+
+    //======================================
+    // 认证：篡改的报文、缺少 MAC 的报文
+
+    if (0 != xut_keyid)
+    {
+        XPR_CHECK(0 == ntpasc_build(&xasc_b, xkey_table, xbt_pkb, &xut_blen));
+        xbt_pkb[XNTP_OFF_RECEIVE] ^= 0x01;
+        XPR_CHECK(EACCES == XPR_RECV(xasc_a, xbt_pkb, xut_blen));
+        XPR_CHECK(EACCES == XPR_RECV(xasc_a, xbt_pkb, XNTP_PKT_LEN));
+
+        XPR_CHECK(0 == ntpasc_init(&xasc_c, ntp_mode_passive, 2, 9));
+        XPR_CHECK(ENOENT == ntpasc_build(&xasc_c, xkey_table, xbt_pkc, &xut_clen));
+    }
+
+#undef XPR_RECV
+#undef XPR_CHECK
+
+    return xit_fail;
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-d <msec>]\n", xszt_app);
+    printf("\t-d <msec> Duration of the loopback test in milliseconds, default 2000.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t          xit_iter   = 0;
+    x_uint32_t         xut_msecs  = 2000;
+    x_uint32_t         xut_polls  = 0;
+    x_int32_t          xit_fail   = 0;
+    x_bool_t           xbt_sftrun = X_FALSE;
+    xntp_keyptr_t      xkey_table = X_NULL;
+    xpr_track_t      * xtrk_ptr   = X_NULL;
+    x_uint32_t         xut_pb     = 0;
+    x_uint32_t         xut_pr     = 0;
+    x_uint32_t         xut_pc     = 0;
+    x_uint32_t         xut_px     = 0;
+    x_uint32_t         xut_cr     = 0;
+    x_uint32_t         xut_ba     = 0;
+    x_uint32_t         xut_plen   = 0;
+    xpr_node_t       * xnode_a    = X_NULL;
+    xpr_node_t       * xnode_b    = X_NULL;
+    xpr_node_t       * xnode_c    = X_NULL;
+    xntp_pollptr_t     xpoll_tmp  = X_NULL;
+    xntp_assoc_t       xasc_temp;
+    xntp_poll_conf_t   xconf_this;
+    xntp_poll_stat_t   xstat_this;
+    xpr_shifted_t      xsft_this;
+    struct sockaddr_in xaddr_host;
+    x_uchar_t          xbt_pack[XNTP_ASSOC_PKT_MAX];
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE    xthd_sft = X_NULL;
+    WSADATA   xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_t xthd_sft;
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    memset(&xsft_this, 0, sizeof(xpr_shifted_t));
+    xsft_this.xfdt_sockfd = X_INVALID_SOCKFD;
+
+    do
+    {
+        //======================================
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-d", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_msecs = (x_uint32_t)atoi(argv[++xit_iter]);
+            else
+            {
+                usage(argv[0]);
+                return 0;
+            }
+        }
+
+        if (xut_msecs < 10 * XPR_PERIOD)
+        {
+            usage(argv[0]);
+            break;
+        }
+
+#define XPR_CHECK(xcond)                                              \
+        do                                                            \
+        {                                                             \
+            if (!(xcond))                                             \
+            {                                                         \
+                printf("check failed at line %d : %s\n",              \
+                       __LINE__, #xcond);                             \
+                xit_fail += 1;                                        \
+            }                                                         \
+        } while (0)
+
+        //======================================
+        // 关联状态机
+
+        xit_fail += check_assoc(X_NULL);
+
+        xkey_table = ntpkey_create();
+        if ((X_NULL != xkey_table) &&
+            (0 == ntpkey_add(xkey_table, 1, ntp_auth_sha1, (const x_uchar_t *)"peer-secret", 11)))
+        {
+            xit_fail += check_assoc(xkey_table);
+            printf("association : checked (with and without authentication)\n");
+        }
+        else
+        {
+            printf("association : checked (authentication unavailable in this build)\n");
+        }
+
+        //======================================
+        // 无效的 参数
+
+        memset(&xconf_this, 0, sizeof(xntp_poll_conf_t));
+        xconf_this.xut_shards = 1;
+        xconf_this.xut_period = XPR_PERIOD;
+        xconf_this.xut_tmout  = XPR_PERIOD / 2;
+        xconf_this.xut_keyid  = 1;
+        XPR_CHECK((X_NULL == ntppoll_create(&xconf_this)) && (EINVAL == errno));
+        xconf_this.xut_keyid  = 0;
+
+        xpoll_tmp = ntppoll_create(&xconf_this);
+        XPR_CHECK(X_NULL != xpoll_tmp);
+        XPR_CHECK(EINVAL == ntppoll_add_peer(xpoll_tmp, INADDR_LOOPBACK, 123, X_NULL));
+        ntppoll_destroy(xpoll_tmp);
+
+        //======================================
+        // 三个 节点 与 时钟偏快 的 对等体
+
+        xnode_a = (xpr_node_t *)calloc(1, sizeof(xpr_node_t));
+        xnode_b = (xpr_node_t *)calloc(1, sizeof(xpr_node_t));
+        xnode_c = (xpr_node_t *)calloc(1, sizeof(xpr_node_t));
+        if ((X_NULL == xnode_a) || (X_NULL == xnode_b) || (X_NULL == xnode_c))
+        {
+            printf("calloc() return X_NULL\n");
+            xit_fail += 1;
+            break;
+        }
+
+        if (!node_open(xnode_a, free_port(), X_FALSE) ||
+            !node_open(xnode_b, free_port(), X_FALSE) ||
+            !node_open(xnode_c, free_port(), X_TRUE))
+        {
+            xit_fail += 1;
+            break;
+        }
+
+        xsft_this.xfdt_sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        xsft_this.xut_port    = free_port();
+        memset(&xaddr_host, 0, sizeof(struct sockaddr_in));
+        xaddr_host.sin_family      = AF_INET;
+        xaddr_host.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        xaddr_host.sin_port        = htons(xsft_this.xut_port);
+        if ((X_INVALID_SOCKFD == xsft_this.xfdt_sockfd) ||
+            (0 != bind(xsft_this.xfdt_sockfd, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in))))
+        {
+            printf("socket() or bind() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+#if defined(_WIN32) || defined(_WIN64)
+        xthd_sft = CreateThread(X_NULL, 0, shifted_proc, &xsft_this, 0, X_NULL);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        pthread_create(&xthd_sft, X_NULL, shifted_proc, &xsft_this);
+#endif // defined(_WIN32) || defined(_WIN64)
+        xbt_sftrun = X_TRUE;
+
+        // A：与 B 互为 主动对等体；C 为 其 建立 被动关联；另有 时钟偏快的 对等体、
+        //    同一对等体的 客户端轮询（同一分片线程 的 同一事件循环）、无应答的 对等体
+        xut_pb = node_add(xnode_a, X_TRUE , xnode_b->xut_sport, 0);
+        xut_pc = node_add(xnode_a, X_TRUE , xnode_c->xut_sport, 0);
+        xut_pr = node_add(xnode_a, X_TRUE , xsft_this.xut_port, XPR_OFFSET);
+        xut_cr = node_add(xnode_a, X_FALSE, xsft_this.xut_port, XPR_OFFSET);
+        xut_px = node_add(xnode_a, X_TRUE , free_port(), 0);
+        xut_ba = node_add(xnode_b, X_TRUE , xnode_a->xut_sport, 0);
+
+        XPR_CHECK(0 == ntppoll_start(xnode_c->xpoll_ptr));
+        XPR_CHECK(0 == ntppoll_start(xnode_b->xpoll_ptr));
+        XPR_CHECK(0 == ntppoll_start(xnode_a->xpoll_ptr));
+
+#if defined(_WIN32) || defined(_WIN64)
+        Sleep(xut_msecs);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        usleep(xut_msecs * 1000);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+        //======================================
+        // 未配置的 主动对等体 发往 未启用 被动关联 的 节点 B：报文 被丢弃
+
+        ntpasc_init(&xasc_temp, ntp_mode_initiative, 2, 0);
+        ntpasc_build(&xasc_temp, X_NULL, xbt_pack, &xut_plen);
+        xaddr_host.sin_port = htons(xnode_b->xut_sport);
+        sendto(xsft_this.xfdt_sockfd, (const x_char_t *)xbt_pack, xut_plen, 0,
+               (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in));
+
+#if defined(_WIN32) || defined(_WIN64)
+        Sleep(2 * XPR_PERIOD);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        usleep(2 * XPR_PERIOD * 1000);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+        ntppoll_stat(xnode_b->xpoll_ptr, -1, &xstat_this);
+        XPR_CHECK(xstat_this.xut_symdrop >= 1);
+
+        ntppoll_stat(xnode_a->xpoll_ptr, -1, &xstat_this);
+        printf("node A : polls %llu, replies %llu, errors %llu, symmetric packets %llu, dropped %llu\n",
+               (unsigned long long)xstat_this.xut_polls,
+               (unsigned long long)xstat_this.xut_replies,
+               (unsigned long long)xstat_this.xut_errors,
+               (unsigned long long)xstat_this.xut_sympkts,
+               (unsigned long long)xstat_this.xut_symdrop);
+
+        ntppoll_destroy(xnode_a->xpoll_ptr);
+        ntppoll_destroy(xnode_b->xpoll_ptr);
+        ntppoll_destroy(xnode_c->xpoll_ptr);
+        xnode_a->xpoll_ptr = X_NULL;
+        xnode_b->xpoll_ptr = X_NULL;
+        xnode_c->xpoll_ptr = X_NULL;
+
+        //======================================
+        // 各关联的 结果（首个周期 用于 交换时间戳，此外 允许少量 调度抖动）
+
+        xut_polls = xut_msecs / XPR_PERIOD;
+
+#define XPR_REPORT(xname, xnode, xpeer, xmode, xokay)                                      \
+        do                                                                                 \
+        {                                                                                  \
+            xtrk_ptr = (0 != (xpeer)) ? node_track((xnode), (xpeer), (xmode))              \
+                                      : node_find_mode((xnode), (xmode));                  \
+            XPR_CHECK(X_NULL != xtrk_ptr);                                                 \
+            if (X_NULL == xtrk_ptr)                                                        \
+                break;                                                                     \
+            printf("%-22s : mode %u, samples %3u, timeouts %3u, errors %u, max error %lld us\n", \
+                   (xname), xtrk_ptr->xut_mode, xtrk_ptr->xut_okay, xtrk_ptr->xut_tmout,   \
+                   xtrk_ptr->xut_error, xtrk_ptr->xit_maxerr / 10LL);                      \
+            XPR_CHECK((xmode) == xtrk_ptr->xut_mode);                                      \
+            XPR_CHECK((xokay) <= xtrk_ptr->xut_okay);                                      \
+            XPR_CHECK(xtrk_ptr->xit_maxerr <= XPR_TOLERANCE);                              \
+        } while (0)
+
+        XPR_REPORT("A -> B (active)"      , xnode_a, xut_pb, ntp_mode_initiative, xut_polls / 2);
+        XPR_REPORT("B -> A (active)"      , xnode_b, xut_ba, ntp_mode_initiative, xut_polls / 2);
+        XPR_REPORT("A -> C (active)"      , xnode_a, xut_pc, ntp_mode_initiative, xut_polls / 2);
+        XPR_REPORT("C <- A (passive)"     , xnode_c, 0     , ntp_mode_passive   , xut_polls / 2);
+        XPR_REPORT("A -> shifted (active)", xnode_a, xut_pr, ntp_mode_initiative, xut_polls / 2);
+        XPR_REPORT("A -> shifted (client)", xnode_a, xut_cr, ntp_mode_client    , xut_polls / 2);
+
+        xtrk_ptr = node_track(xnode_a, xut_px, ntp_mode_initiative);
+        XPR_CHECK((0 == xtrk_ptr->xut_okay) && (xtrk_ptr->xut_tmout >= (xut_polls / 2)));
+        printf("%-22s : timeouts %u\n", "A -> silent (active)", xtrk_ptr->xut_tmout);
+
+        XPR_CHECK(xsft_this.xut_active >= (xut_polls / 2));
+        XPR_CHECK(xsft_this.xut_client >= (xut_polls / 2));
+
+#undef XPR_REPORT
+#undef XPR_CHECK
+
+        printf("checks : %s\n", (0 == xit_fail) ? "passed" : "FAILED");
+
+        //======================================
+    } while (0);
+
+    if (xbt_sftrun)
+    {
+        xsft_this.xbt_stop = X_TRUE;
+#if defined(_WIN32) || defined(_WIN64)
+        WaitForSingleObject(xthd_sft, INFINITE);
+        CloseHandle(xthd_sft);
+#else // !(defined(_WIN32) || defined(_WIN64))
+        pthread_join(xthd_sft, X_NULL);
+#endif // defined(_WIN32) || defined(_WIN64)
+    }
+
+    if (X_INVALID_SOCKFD != xsft_this.xfdt_sockfd)
+    {
+        sockfd_close(xsft_this.xfdt_sockfd);
+    }
+
+    if (X_NULL != xnode_a)
+    {
+        ntppoll_destroy(xnode_a->xpoll_ptr);
+        free(xnode_a);
+    }
+
+    if (X_NULL != xnode_b)
+    {
+        ntppoll_destroy(xnode_b->xpoll_ptr);
+        free(xnode_b);
+    }
+
+    if (X_NULL != xnode_c)
+    {
+        ntppoll_destroy(xnode_c->xpoll_ptr);
+        free(xnode_c);
+    }
+
+    ntpkey_destroy(xkey_table);
+
+    //======================================
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    return (0 == xit_fail) ? 0 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,259 @@
+﻿/**
+ * @file poller_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 多核分片 NTP 轮询器（ntp_poller.h）的程序。
+ */
+
+#include "ntp_poller.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <WinSock2.h>
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 解析 “a.b.c.d[:port]” 格式的字符串。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；失败，返回 X_FALSE。
+ */
+static x_bool_t parse_addr(x_cstring_t xszt_addr, x_uint32_t * xut_ipv4, x_uint16_t * xut_port)
+{
+    x_uint32_t xut_ipv[4] = { 0, 0, 0, 0 };
+    x_uint32_t xut_value  = NTP_PORT;
+    x_int32_t  xit_count  = 0;
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4996)
+#endif // _MSC_VER
+    xit_count = sscanf(xszt_addr, "%u.%u.%u.%u:%u",
+                       &xut_ipv[0], &xut_ipv[1], &xut_ipv[2], &xut_ipv[3], &xut_value);
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+
+    if ((xit_count < 4) ||
+        (xut_ipv[0] > 0xFF) || (xut_ipv[1] > 0xFF) ||
+        (xut_ipv[2] > 0xFF) || (xut_ipv[3] > 0xFF) || (xut_value > 0xFFFF))
+    {
+        return X_FALSE;
+    }
+
+    *xut_ipv4 = (xut_ipv[0] << 24) | (xut_ipv[1] << 16) | (xut_ipv[2] << 8) | xut_ipv[3];
+    *xut_port = (x_uint16_t)xut_value;
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 轮询结果的 回调函数（详细模式下 输出每个结果）。
+ */
+static x_void_t poll_result(x_pvoid_t xpvt_ctxt, const xntp_poll_result_t * xres_ptr)
+{
+    if (!*(x_bool_t *)xpvt_ctxt)
+    {
+        return;
+    }
+
+    printf("peer %u [%u.%u.%u.%u:%u] shard %u : errno = %d, offset = %lld us, delay = %lld us\n",
+           xres_ptr->xut_peer,
+           (xres_ptr->xut_ipv4 >> 24) & 0xFF, (xres_ptr->xut_ipv4 >> 16) & 0xFF,
+           (xres_ptr->xut_ipv4 >>  8) & 0xFF, (xres_ptr->xut_ipv4 >>  0) & 0xFF,
+           xres_ptr->xut_port,
+           xres_ptr->xut_shard,
+           xres_ptr->xit_errno,
+           (long long)(xres_ptr->xit_offset / 10),
+           (long long)(xres_ptr->xit_delay / 10));
+}
+
+/**********************************************************/
+/**
+ * @brief 输出 统计信息。
+ */
+static x_void_t print_stat(x_cstring_t xszt_name, const xntp_poll_stat_t * xstat_ptr)
+{
+    printf("%-8s : peers %6u, polls %9llu, replies %9llu, errors %7llu, "
+           "stolen %5llu, given %5llu, lag %7llu us\n",
+           xszt_name,
+           xstat_ptr->xut_peers,
+           (unsigned long long)xstat_ptr->xut_polls,
+           (unsigned long long)xstat_ptr->xut_replies,
+           (unsigned long long)xstat_ptr->xut_errors,
+           (unsigned long long)xstat_ptr->xut_stolen,
+           (unsigned long long)xstat_ptr->xut_given,
+           (unsigned long long)(xstat_ptr->xut_lag / 10));
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-j <shards>] [-P <msec>] [-t <msec>] [-d <sec>] [-c <copies>] [-a] [-v] "
+           "<ip[:port]> [<ip[:port]> ...]\n", xszt_app);
+    printf("\t-j <shards> The number of shards (threads), default is the number of CPUs.\n");
+    printf("\t-P <msec>   Polling period of each peer in milliseconds, default 1000.\n");
+    printf("\t-t <msec>   Timeout of each poll in milliseconds, default 500.\n");
+    printf("\t-d <sec>    Duration of the test in seconds, default 5.\n");
+    printf("\t-c <copies> Add each address as many peers, default 1.\n");
+    printf("\t-a          Pin each shard to its own CPU.\n");
+    printf("\t-v          Output every result.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t        xit_iter  = 0;
+    x_uint32_t       xut_iter  = 0;
+    x_uint32_t       xut_secs  = 5;
+    x_uint32_t       xut_copy  = 1;
+    x_uint32_t       xut_ipv4  = 0;
+    x_uint16_t       xut_port  = 0;
+    x_int32_t        xit_errno = 0;
+    x_bool_t         xbt_verb  = X_FALSE;
+    x_bool_t         xbt_added = X_FALSE;
+    x_char_t         xszt_name[32];
+    xntp_pollptr_t   xpoll_ptr = X_NULL;
+    xntp_poll_conf_t xconf_this;
+    xntp_poll_stat_t xstat_this;
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    memset(&xconf_this, 0, sizeof(xntp_poll_conf_t));
+    xconf_this.xut_period = 1000;
+    xconf_this.xut_tmout  = 500;
+    xconf_this.xfunc_cbk  = poll_result;
+    xconf_this.xpvt_ctxt  = &xbt_verb;
+
+    //======================================
+
+    do
+    {
+        //======================================
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-j", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xconf_this.xut_shards = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-P", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xconf_this.xut_period = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-t", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xconf_this.xut_tmout = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-d", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_secs = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-c", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_copy = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if (0 == strcmp("-a", argv[xit_iter]))
+                xconf_this.xbt_affinity = X_TRUE;
+            else if (0 == strcmp("-v", argv[xit_iter]))
+                xbt_verb = X_TRUE;
+        }
+
+        xpoll_ptr = ntppoll_create(&xconf_this);
+        if (X_NULL == xpoll_ptr)
+        {
+            printf("ntppoll_create() return X_NULL, errno : %d\n", errno);
+            break;
+        }
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ('-' == argv[xit_iter][0])
+            {
+                if ((0 != strcmp("-a", argv[xit_iter])) && (0 != strcmp("-v", argv[xit_iter])))
+                    ++xit_iter;
+                continue;
+            }
+
+            if (!parse_addr(argv[xit_iter], &xut_ipv4, &xut_port))
+            {
+                continue;
+            }
+
+            for (xut_iter = 0; xut_iter < xut_copy; ++xut_iter)
+            {
+                ntppoll_add(xpoll_ptr, xut_ipv4, xut_port, X_NULL);
+            }
+
+            xbt_added = X_TRUE;
+        }
+
+        if (!xbt_added)
+        {
+            usage(argv[0]);
+            break;
+        }
+
+        //======================================
+
+        xit_errno = ntppoll_start(xpoll_ptr);
+        if (0 != xit_errno)
+        {
+            printf("ntppoll_start() return %d\n", xit_errno);
+            break;
+        }
+
+        for (xut_iter = 0; xut_iter < xut_secs; ++xut_iter)
+        {
+#if defined(_WIN32) || defined(_WIN64)
+            Sleep(1000);
+#else // !(defined(_WIN32) || defined(_WIN64))
+            sleep(1);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+            ntppoll_stat(xpoll_ptr, -1, &xstat_this);
+            print_stat("total", &xstat_this);
+        }
+
+        for (xut_iter = 0; xut_iter < ntppoll_shards(xpoll_ptr); ++xut_iter)
+        {
+            ntppoll_stat(xpoll_ptr, (x_int32_t)xut_iter, &xstat_this);
+            snprintf(xszt_name, sizeof(xszt_name), "shard %u", xut_iter);
+            print_stat(xszt_name, &xstat_this);
+        }
+
+        //======================================
+    } while (0);
+
+    if (X_NULL != xpoll_ptr)
+    {
+        ntppoll_destroy(xpoll_ptr);
+        xpoll_ptr = X_NULL;
+    }
+
+    //======================================
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
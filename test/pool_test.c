@@ -0,0 +1,399 @@
+﻿/**
+ * @file pool_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 NTP 服务端池 的 评分、择优、自动替换 与 容量整理。
+ * @note
+ * 在 本机回环地址 127.0.0.1 ~ 127.0.0.6 上 启动 简易服务端（同一端口），各自的 特征 为：
+ * .1 层数 1；.2 层数 2；.3 层数 4 且 偏移量 来回跳变（抖动大）；.4 层数 16（未同步）；
+ * .5 层数 1 但 往返时延 多 30 毫秒；.6 层数 3；127.0.0.7 没有 服务端。
+ * 活跃集合 大小 为 3，期望 为 { .1, .2, .6 }。
+ */
+
+#include "ntp_pool.h"
+#include "xtest_server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 毫秒 对应的 时间计量值 */
+#define XPL_MSEC        ((x_int64_t)XTIME_VNSEC_MSEC)
+
+/** 服务端 数量、首个地址、没有服务端 的 地址 */
+#define XPL_SERVERS     6
+#define XPL_ADDR(xn)    (0x7F000000 + (xn))
+#define XPL_ADDR_DEAD   XPL_ADDR(7)
+
+/** 活跃集合 大小 与 候选地址 容量 */
+#define XPL_ACTIVE      3
+#define XPL_CAPACITY    48
+
+/** 每轮 探测 的 超时时长 */
+#define XPL_TMOUT       (150 * XPL_MSEC)
+
+static x_int32_t xit_fail = 0;
+
+#define XPL_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+/**
+ * @struct xpl_server_t
+ * @brief  简易 NTP 服务端 与 其 应答特征（层数、LI 见 xsrv_base）。
+ */
+typedef struct xpl_server_t
+{
+    xtest_server_t    xsrv_base;    ///< 简易服务端
+    x_uint32_t        xut_delay;    ///< 收到请求 后、记录 T2 前 的 延迟（毫秒，计入 往返时延）
+    x_bool_t          xbt_swing;    ///< 偏移量 是否 在 ±20 毫秒 间 来回跳变
+    x_int64_t         xit_skew;     ///< 当前的 偏移量（仅 服务端线程 访问）
+    volatile x_bool_t xbt_mute;     ///< 是否 不应答（模拟 故障）
+} xpl_server_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 服务端 的 应答：按 各自的 特征 延迟、跳变 偏移量 或 不应答。
+ */
+static x_uint32_t trait_reply(
+                    xtest_server_t * xsrv_ptr,
+                    const x_uchar_t * xbt_rbuf,
+                    const xntp_view_t * xview_req,
+                    x_uchar_t * xbt_sbuf)
+{
+    xpl_server_t * xpl_ptr = (xpl_server_t *)xsrv_ptr->xpvt_ctx;
+
+    (x_void_t)xbt_rbuf;
+
+    if (xpl_ptr->xbt_mute)
+        return 0;
+
+    // 延迟 发生在 T2 之前（网络 慢），计入 往返时延
+    if (0 != xpl_ptr->xut_delay)
+        xtest_sleep_msec(xpl_ptr->xut_delay);
+
+    if (xpl_ptr->xbt_swing)
+        xpl_ptr->xit_skew = (xpl_ptr->xit_skew > 0) ? (-20 * XPL_MSEC) : (20 * XPL_MSEC);
+
+    xsrv_ptr->xit_offset = xpl_ptr->xit_skew;
+    return xtest_server_reply(xsrv_ptr, xview_req, xbt_sbuf);
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 执行 xut_rounds 轮 探测。
+ */
+static x_void_t pool_rounds(xntp_poolptr_t xpool_ptr, x_uint32_t xut_rounds)
+{
+    while (xut_rounds-- > 0)
+    {
+        XPL_CHECK(0 == ntppool_update(xpool_ptr, time_mono() + XPL_TMOUT));
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 判断 地址 是否 属于 活跃集合（同时 校验 活跃集合 按 评分 排列）。
+ */
+static x_bool_t pool_is_active(xntp_poolptr_t xpool_ptr, x_uint32_t xut_ipv4)
+{
+    xntp_cand_t xcand_list[XNTP_POOL_KMAX];
+    x_uint32_t  xut_count = ntppool_active(xpool_ptr, xcand_list, XNTP_POOL_KMAX);
+    x_uint32_t  xut_iter  = 0;
+    x_bool_t    xbt_found = X_FALSE;
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        XPL_CHECK(0 != (xcand_list[xut_iter].xut_flags & XNTP_CAND_ACTIVE));
+        if (xut_iter > 0)
+            XPL_CHECK(ntppool_score(&xcand_list[xut_iter - 1]) <= ntppool_score(&xcand_list[xut_iter]));
+        if (xut_ipv4 == xcand_list[xut_iter].xut_ipv4)
+            xbt_found = X_TRUE;
+    }
+
+    return xbt_found;
+}
+
+/**********************************************************/
+/**
+ * @brief 输出 各 候选地址 的 统计信息。
+ */
+static x_void_t pool_dump(xntp_poolptr_t xpool_ptr, x_uint16_t xut_port, x_cstring_t xszt_title)
+{
+    xntp_cand_t xcand;
+    x_uint32_t  xut_iter = 0;
+
+    printf("---- %s\n", xszt_title);
+    for (xut_iter = 1; xut_iter <= XPL_SERVERS + 1; ++xut_iter)
+    {
+        if (0 != ntppool_find(xpool_ptr, XPL_ADDR(xut_iter), xut_port, &xcand))
+            continue;
+
+        printf("  127.0.0.%u  reach %02X  stratum %2u  flags %u  delay %6u  jitter %6u  score %u\n",
+               xut_iter, xcand.xut_reach, xcand.xut_stratum, xcand.xut_flags,
+               xcand.xut_delay, xcand.xut_jitter, ntppool_score(&xcand));
+    }
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 校验 参数检查 与 候选地址 的 添加。
+ */
+static x_void_t check_basic(xntp_cliptr_t xntp_this, x_uint16_t xut_port)
+{
+    xntp_poolptr_t xpool_ptr = X_NULL;
+    xntp_cand_t    xcand;
+    x_uint32_t     xut_added = 0;
+
+    XPL_CHECK(24 == sizeof(xntp_cand_t));
+    XPL_CHECK(XNTP_POOL_UNFIT == ntppool_score(X_NULL));
+
+    XPL_CHECK(X_NULL == ntppool_create(X_NULL, 0, 0));
+    XPL_CHECK(EINVAL == errno);
+    XPL_CHECK(X_NULL == ntppool_create(xntp_this, XNTP_POOL_KMAX + 1, 0));
+    XPL_CHECK(EINVAL == errno);
+
+    xpool_ptr = ntppool_create(xntp_this, 0, 4);
+    XPL_CHECK(X_NULL != xpool_ptr);
+    if (X_NULL == xpool_ptr)
+        return;
+
+    XPL_CHECK(EINVAL == ntppool_add_addr(xpool_ptr, 0, xut_port));
+    XPL_CHECK(EINVAL == ntppool_add_addr(xpool_ptr, XPL_ADDR(1), 0));
+    XPL_CHECK(EINVAL == ntppool_add_host(xpool_ptr, "", xut_port, 0, X_NULL));
+    XPL_CHECK(EINVAL == ntppool_update(X_NULL, XTIME_INVALID_VNSEC));
+
+    // 数字地址 的 域名；编号子域名（"0.127.0.0.1" 等）解析失败 不影响 结果
+    XPL_CHECK(0 == ntppool_add_host(xpool_ptr, "127.0.0.1", xut_port, 2, &xut_added));
+    XPL_CHECK(1 == xut_added);
+    XPL_CHECK(0 == ntppool_add_host(xpool_ptr, "127.0.0.1", xut_port, 0, &xut_added));
+    XPL_CHECK(0 == xut_added);
+    XPL_CHECK(EHOSTUNREACH == ntppool_add_host(xpool_ptr, "xntp.pool.invalid", xut_port, 0, X_NULL));
+
+    XPL_CHECK(EEXIST == ntppool_add_addr(xpool_ptr, XPL_ADDR(1), xut_port));
+    XPL_CHECK(0 == ntppool_add_addr(xpool_ptr, XPL_ADDR(1), (x_uint16_t)(xut_port + 1)));
+    XPL_CHECK(0 == ntppool_add_addr(xpool_ptr, XPL_ADDR(2), xut_port));
+    XPL_CHECK(0 == ntppool_add_addr(xpool_ptr, XPL_ADDR(3), xut_port));
+    XPL_CHECK(4 == ntppool_count(xpool_ptr));
+
+    // 尚未探测 的 候选地址 不会被清理
+    XPL_CHECK(ENOSPC == ntppool_add_addr(xpool_ptr, XPL_ADDR(4), xut_port));
+    XPL_CHECK(ENOSPC == ntppool_add_host(xpool_ptr, "127.0.0.4", xut_port, 0, X_NULL));
+
+    XPL_CHECK(0 == ntppool_find(xpool_ptr, XPL_ADDR(2), xut_port, &xcand));
+    XPL_CHECK((0 == xcand.xut_probes) && (0 == xcand.xut_flags));
+    XPL_CHECK(XNTP_POOL_UNFIT == ntppool_score(&xcand));
+    XPL_CHECK(ENOENT == ntppool_find(xpool_ptr, XPL_ADDR(4), xut_port, &xcand));
+    XPL_CHECK(0 == ntppool_active(xpool_ptr, &xcand, 1));
+
+    ntppool_destroy(xpool_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 择优、故障替换、恢复后 换回，以及 容量已满 时 的 整理。
+ */
+static x_void_t check_select(xntp_cliptr_t xntp_this, xpl_server_t * xsrv_list, x_uint16_t xut_port)
+{
+    xntp_poolptr_t xpool_ptr = X_NULL;
+    xntp_cand_t    xcand;
+    xntp_cand_t    xcand_list[XNTP_POOL_KMAX];
+    x_uint32_t     xut_iter  = 0;
+    x_uint32_t     xut_count = 0;
+    x_int32_t      xit_errno = 0;
+
+    xpool_ptr = ntppool_create(xntp_this, XPL_ACTIVE, XPL_CAPACITY);
+    XPL_CHECK(X_NULL != xpool_ptr);
+    if (X_NULL == xpool_ptr)
+        return;
+
+    for (xut_iter = 1; xut_iter <= XPL_SERVERS + 1; ++xut_iter)
+    {
+        XPL_CHECK(0 == ntppool_add_addr(xpool_ptr, XPL_ADDR(xut_iter), xut_port));
+    }
+
+    //======================================
+    // 首轮 即可 选出 活跃集合
+
+    pool_rounds(xpool_ptr, 1);
+    XPL_CHECK(XPL_ACTIVE == ntppool_active(xpool_ptr, xcand_list, XNTP_POOL_KMAX));
+    XPL_CHECK(1 == ntppool_active(xpool_ptr, xcand_list, 1));
+    XPL_CHECK(XPL_ADDR(1) == xcand_list[0].xut_ipv4);
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(1)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(2)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(6)));
+
+    pool_rounds(xpool_ptr, 5);
+    pool_dump(xpool_ptr, xut_port, "steady");
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(1)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(2)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(6)));
+
+    XPL_CHECK(0 == ntppool_find(xpool_ptr, XPL_ADDR(1), xut_port, &xcand));
+    XPL_CHECK(0x3F == xcand.xut_reach);
+    XPL_CHECK((1 == xcand.xut_stratum) && (6 == xcand.xut_probes));
+
+    XPL_CHECK(0 == ntppool_find(xpool_ptr, XPL_ADDR(3), xut_port, &xcand));
+    XPL_CHECK(xcand.xut_jitter > 10 * XPL_MSEC);
+    XPL_CHECK(XNTP_POOL_UNFIT != ntppool_score(&xcand));
+
+    XPL_CHECK(0 == ntppool_find(xpool_ptr, XPL_ADDR(4), xut_port, &xcand));
+    XPL_CHECK((16 == xcand.xut_stratum) && (0 == xcand.xut_reach) && (0 == xcand.xut_flags));
+    XPL_CHECK(XNTP_POOL_UNFIT == ntppool_score(&xcand));
+
+    XPL_CHECK(0 == ntppool_find(xpool_ptr, XPL_ADDR(5), xut_port, &xcand));
+    XPL_CHECK(xcand.xut_delay >= 25 * XPL_MSEC);
+    XPL_CHECK(XNTP_CAND_STANDBY == (xcand.xut_flags & (XNTP_CAND_ACTIVE | XNTP_CAND_STANDBY)));
+
+    XPL_CHECK(0 == ntppool_find(xpool_ptr, XPL_ADDR_DEAD, xut_port, &xcand));
+    XPL_CHECK((0 == xcand.xut_reach) && (XNTP_POOL_UNFIT == ntppool_score(&xcand)));
+
+    //======================================
+    // .2 故障：由 .5 替换（.3 抖动大，.4 未同步，均 不会入选）
+
+    xsrv_list[1].xbt_mute = X_TRUE;
+    pool_rounds(xpool_ptr, 3);
+    pool_dump(xpool_ptr, xut_port, "127.0.0.2 muted");
+    XPL_CHECK(!pool_is_active(xpool_ptr, XPL_ADDR(2)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(5)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(1)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(6)));
+    XPL_CHECK(!pool_is_active(xpool_ptr, XPL_ADDR(3)));
+    XPL_CHECK(!pool_is_active(xpool_ptr, XPL_ADDR(4)));
+
+    // 恢复后，失败记录 移出 窗口 之前 不会 换回（滞后）
+    xsrv_list[1].xbt_mute = X_FALSE;
+    pool_rounds(xpool_ptr, 2);
+    XPL_CHECK(!pool_is_active(xpool_ptr, XPL_ADDR(2)));
+
+    pool_rounds(xpool_ptr, 8);
+    pool_dump(xpool_ptr, xut_port, "127.0.0.2 revived");
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(2)));
+    XPL_CHECK(!pool_is_active(xpool_ptr, XPL_ADDR(5)));
+
+    //======================================
+    // 容量已满：清理 持续不可达 的 候选地址，活跃集合 不受影响
+
+    for (xut_iter = 1; ; ++xut_iter)
+    {
+        xit_errno = ntppool_add_addr(xpool_ptr, 0x7F000100 + xut_iter, xut_port);
+        if (0 != xit_errno)
+            break;
+    }
+
+    XPL_CHECK(ENOSPC == xit_errno);
+    XPL_CHECK(XPL_CAPACITY == ntppool_count(xpool_ptr));
+
+    // 一轮 探测 后，不可达的 新地址 已可清理（.4、.7 同样）
+    pool_rounds(xpool_ptr, 2);
+    XPL_CHECK(0 == ntppool_add_addr(xpool_ptr, 0x7F000200, xut_port));
+    xut_count = ntppool_count(xpool_ptr);
+    printf("after compaction : %u candidate(s)\n", xut_count);
+    XPL_CHECK(xut_count <= XPL_SERVERS + 1);
+    XPL_CHECK(ENOENT == ntppool_find(xpool_ptr, XPL_ADDR_DEAD, xut_port, &xcand));
+    XPL_CHECK(0 == ntppool_find(xpool_ptr, XPL_ADDR(5), xut_port, &xcand));
+
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(1)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(2)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(6)));
+
+    pool_rounds(xpool_ptr, 2);
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(1)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(2)));
+    XPL_CHECK(pool_is_active(xpool_ptr, XPL_ADDR(6)));
+
+    ntppool_destroy(xpool_ptr);
+}
+
+//====================================================================
+
+int main(int argc, char * argv[])
+{
+    xpl_server_t  xsrv_list[XPL_SERVERS];
+    xntp_cliptr_t xntp_this = X_NULL;
+    x_uint32_t    xut_iter  = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA       xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    (x_void_t)argc;
+    (x_void_t)argv;
+
+    //======================================
+    // 各个 服务端 使用 同一端口
+
+    memset(xsrv_list, 0, sizeof(xsrv_list));
+    for (xut_iter = 0; xut_iter < XPL_SERVERS; ++xut_iter)
+    {
+        xsrv_list[xut_iter].xsrv_base.xut_ipv4    = XPL_ADDR(xut_iter + 1);
+        xsrv_list[xut_iter].xsrv_base.xut_stratum = 1;
+        xsrv_list[xut_iter].xsrv_base.xfunc_reply = trait_reply;
+        xsrv_list[xut_iter].xsrv_base.xpvt_ctx    = &xsrv_list[xut_iter];
+    }
+
+    xsrv_list[1].xsrv_base.xut_stratum = 2;
+    xsrv_list[2].xsrv_base.xut_stratum = 4;
+    xsrv_list[2].xbt_swing             = X_TRUE;
+    xsrv_list[3].xsrv_base.xut_stratum = 16;
+    xsrv_list[3].xsrv_base.xut_leap    = 3;
+    xsrv_list[4].xut_delay             = 30;
+    xsrv_list[5].xsrv_base.xut_stratum = 3;
+
+    for (xut_iter = 0; xut_iter < XPL_SERVERS; ++xut_iter)
+    {
+        xsrv_list[xut_iter].xsrv_base.xut_port = xsrv_list[0].xsrv_base.xut_port;
+        if (0 != xtest_server_start(&xsrv_list[xut_iter].xsrv_base))
+        {
+            printf("xtest_server_start() failed, errno : %d\n", errno);
+            while (xut_iter-- > 0)
+                xtest_server_stop(&xsrv_list[xut_iter].xsrv_base);
+            return 1;
+        }
+    }
+
+    //======================================
+
+    xntp_this = ntpcli_open();
+    XPL_CHECK(X_NULL != xntp_this);
+    if (X_NULL != xntp_this)
+    {
+        check_basic(xntp_this, xsrv_list[0].xsrv_base.xut_port);
+        check_select(xntp_this, xsrv_list, xsrv_list[0].xsrv_base.xut_port);
+        ntpcli_close(xntp_this);
+    }
+
+    //======================================
+
+    for (xut_iter = 0; xut_iter < XPL_SERVERS; ++xut_iter)
+    {
+        xtest_server_stop(&xsrv_list[xut_iter].xsrv_base);
+    }
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    return (0 == xit_fail) ? 0 : 1;
+}
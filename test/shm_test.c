@@ -0,0 +1,410 @@
+﻿/**
+ * @file shm_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 以 共享内存 发布的 校正时间（ntp_shm.h）。
+ * @note
+ * 依次校验：段 不存在、版本 不一致 时 打开失败；未发布 时 返回 无效值；只读 句柄 不能发布；
+ * 偏移量 方式 与 TSC 模型 方式 的 读取值；按 闰秒计划 平滑；发布方 重新创建 时，读取方 无须 重新打开；
+ * 然后（POSIX 下）由 子进程 只读映射 该段，在 父进程 持续发布 的 同时 校验 读取值 的 准确 与 单调；
+ * 最后 测量 ntpshm_now() 的 耗时。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ntp_client.h"
+#include "ntp_shm.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 秒 对应的 时间计量值 */
+#define XSM_SEC         ((x_int64_t)(1000 * XTIME_VNSEC_MSEC))
+
+/** 读取值 与 “系统时间 + 偏移量” 之间 的 允许误差（100 纳秒） */
+#define XSM_TOLERANCE   100
+
+/** 子进程 读取 的 时长（毫秒） */
+#define XSM_READ_MSEC   1000
+
+/** 检查失败的次数 */
+static x_int32_t xit_fail = 0;
+
+#define XSM_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 休眠 指定的 毫秒数。
+ */
+static x_void_t sleep_msec(x_uint32_t xut_msecs)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    Sleep(xut_msecs);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    usleep(xut_msecs * 1000);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 读取值 相对于 “系统时间 + 偏移量” 的 误差（100 纳秒）。
+ */
+static x_int64_t shm_error(xntp_shmptr_t xshm_ptr, x_int64_t xit_offset)
+{
+    x_int64_t xit_now = (x_int64_t)ntpshm_now(xshm_ptr);
+    x_int64_t xit_ref = (x_int64_t)time_vnsec() + xit_offset;
+
+    return xit_now - xit_ref;
+}
+
+/**********************************************************/
+/**
+ * @brief 子进程：只读映射 共享内存段，持续读取，校验 读取值 有效、单调，且 与 “系统时间 + 偏移量” 相近。
+ *
+ * @return x_int32_t : 通过，返回 0；否则 返回 1。
+ */
+static x_int32_t reader_proc(x_cstring_t xszt_name, x_int64_t xit_offset)
+{
+    xntp_shmptr_t xshm_ptr  = ntpshm_open(xszt_name);
+    xtime_vnsec_t xtm_until = time_mono() + XSM_READ_MSEC * XTIME_VNSEC_MSEC;
+    xtime_vnsec_t xtm_last  = 0;
+    xtime_vnsec_t xtm_curr  = 0;
+    xtime_vnsec_t xtm_sys0  = 0;
+    xtime_vnsec_t xtm_sys1  = 0;
+    x_int64_t     xit_error = 0;
+    x_int64_t     xit_worst = 0;
+    x_uint32_t    xut_count = 0;
+
+    if (X_NULL == xshm_ptr)
+    {
+        printf("reader : ntpshm_open() failed, errno : %d\n", errno);
+        return 1;
+    }
+
+    while (time_mono() < xtm_until)
+    {
+        xtm_sys0 = time_vnsec();
+        xtm_curr = ntpshm_now(xshm_ptr);
+        xtm_sys1 = time_vnsec();
+        if (!XTMVNSEC_IS_VALID(xtm_curr) || (xtm_curr < xtm_last))
+        {
+            printf("reader : invalid or backward value %llu -> %llu\n", xtm_last, xtm_curr);
+            ntpshm_close(xshm_ptr);
+            return 1;
+        }
+
+        xtm_last   = xtm_curr;
+        xut_count += 1;
+
+        // 两次 系统时间 之间 被调度出去 的 样本，不参与 误差统计
+        if (xtm_sys1 - xtm_sys0 > XSM_TOLERANCE)
+            continue;
+
+        // 发布方 的 偏移量 在 读取期间 缓慢增加，不超过 1 毫秒
+        xit_error = (x_int64_t)xtm_curr - ((x_int64_t)xtm_sys0 + xit_offset);
+        xit_worst = (llabs(xit_error) > llabs(xit_worst)) ? xit_error : xit_worst;
+    }
+
+    ntpshm_close(xshm_ptr);
+
+    printf("reader : %u reads, worst error %lld x 100 ns\n", xut_count, xit_worst);
+
+    return (llabs(xit_worst) < (XTIME_VNSEC_MSEC + XSM_TOLERANCE)) ? 0 : 1;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 校验 打开、发布 与 读取。
+ */
+static x_void_t check_publish(x_cstring_t xszt_name)
+{
+    xntp_shmptr_t   xshm_pub   = X_NULL;
+    xntp_shmptr_t   xshm_sub   = X_NULL;
+    x_int64_t       xit_offset = 3 * XTIME_VNSEC_MSEC;
+    x_int64_t       xit_error  = 0;
+    x_int64_t       xit_leap   = 0;
+    xntp_shmseg_t   xseg_copy;
+
+    ntpshm_unlink(xszt_name);
+
+    //======================================
+    // 段 不存在
+
+    errno = 0;
+    XSM_CHECK(X_NULL == ntpshm_open(xszt_name));
+    XSM_CHECK(ENOENT == errno);
+
+    do
+    {
+        xshm_pub = ntpshm_create(xszt_name);
+        xshm_sub = ntpshm_open(xszt_name);
+        if ((X_NULL == xshm_pub) || (X_NULL == xshm_sub))
+        {
+            printf("ntpshm_create() or ntpshm_open() failed, errno : %d\n", errno);
+            xit_fail += 1;
+            break;
+        }
+
+        //======================================
+        // 尚未发布；只读句柄 不能发布
+
+        XSM_CHECK(XTIME_INVALID_VNSEC == ntpshm_now(xshm_sub));
+        XSM_CHECK(EPERM == ntpshm_publish(xshm_sub, xit_offset, 0));
+        XSM_CHECK(0 == ntpshm_read(xshm_sub, &xseg_copy));
+        XSM_CHECK((XNTP_SHM_MAGIC == xseg_copy.xut_magic) && (XNTP_SHM_VERSION == xseg_copy.xut_version));
+        XSM_CHECK((sizeof(xntp_shmseg_t) == xseg_copy.xut_size) && (0 == xseg_copy.xut_valid));
+
+        //======================================
+        // TSC 时钟 未校准：读取方 以 系统时间 加上 偏移量
+
+        ntpclk_reset();
+        XSM_CHECK(0 == ntpshm_publish(xshm_pub, xit_offset, 0));
+        XSM_CHECK(0 == ntpshm_read(xshm_sub, &xseg_copy));
+        XSM_CHECK((1 == xseg_copy.xut_valid) && (1 == xseg_copy.xut_count) && (0 == xseg_copy.xclk_model.xut_valid));
+        xit_error = shm_error(xshm_sub, xit_offset);
+        XSM_CHECK(llabs(xit_error) < XSM_TOLERANCE);
+
+        //======================================
+        // TSC 时钟 已校准：读取方 只读取 TSC 与 共享内存
+
+        if (0 == ntpclk_update(xit_offset))
+        {
+            XSM_CHECK(0 == ntpshm_publish(xshm_pub, xit_offset, 0));
+            XSM_CHECK(0 == ntpshm_read(xshm_sub, &xseg_copy));
+            XSM_CHECK((2 == xseg_copy.xut_count) && (1 == xseg_copy.xclk_model.xut_valid));
+            xit_error = shm_error(xshm_sub, xit_offset);
+            XSM_CHECK(llabs(xit_error) < XSM_TOLERANCE);
+        }
+
+        //======================================
+        // 闰秒计划：6 小时后 插入闰秒，平滑时间 慢 0.25 秒
+
+        xit_leap = (x_int64_t)(time_vnsec() / XSM_SEC) + 6 * 3600;
+        XSM_CHECK(0 == ntpshm_publish(xshm_pub, xit_offset, XNTP_LEAPPLAN(xit_leap, 1)));
+        xit_error = shm_error(xshm_sub, xit_offset - XSM_SEC / 4);
+        XSM_CHECK(llabs(xit_error) < XSM_TOLERANCE + XSM_SEC / 86400);
+
+        //======================================
+        // 发布方 重新创建：读取方 无须 重新打开
+
+        ntpshm_close(xshm_pub);
+        xshm_pub = ntpshm_create(xszt_name);
+        XSM_CHECK(X_NULL != xshm_pub);
+        XSM_CHECK(XTIME_INVALID_VNSEC == ntpshm_now(xshm_sub));
+        XSM_CHECK(0 == ntpshm_publish(xshm_pub, xit_offset, 0));
+        xit_error = shm_error(xshm_sub, xit_offset);
+        XSM_CHECK(llabs(xit_error) < XSM_TOLERANCE);
+
+        XSM_CHECK(EINVAL == ntpcli_publish(X_NULL, xshm_pub));
+    } while (0);
+
+    if (X_NULL != xshm_sub)
+        ntpshm_close(xshm_sub);
+    if (X_NULL != xshm_pub)
+        ntpshm_close(xshm_pub);
+    ntpshm_unlink(xszt_name);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 版本 不一致 的 段 打开失败。
+ */
+static x_void_t check_version(x_cstring_t xszt_name)
+{
+#if !(defined(_WIN32) || defined(_WIN64))
+    xntp_shmseg_t xseg_bad;
+    int           xfd_shm = shm_open(xszt_name, O_CREAT | O_RDWR, 0644);
+
+    if (-1 == xfd_shm)
+    {
+        XSM_CHECK(-1 != xfd_shm);
+        return;
+    }
+
+    memset(&xseg_bad, 0, sizeof(xntp_shmseg_t));
+    xseg_bad.xut_magic   = XNTP_SHM_MAGIC;
+    xseg_bad.xut_version = XNTP_SHM_VERSION + 1;
+    xseg_bad.xut_size    = sizeof(xntp_shmseg_t);
+    XSM_CHECK(sizeof(xntp_shmseg_t) == (x_size_t)write(xfd_shm, &xseg_bad, sizeof(xntp_shmseg_t)));
+    close(xfd_shm);
+
+    errno = 0;
+    XSM_CHECK(X_NULL == ntpshm_open(xszt_name));
+    XSM_CHECK(EPROTO == errno);
+
+    ntpshm_unlink(xszt_name);
+#endif // !(defined(_WIN32) || defined(_WIN64))
+}
+
+/**********************************************************/
+/**
+ * @brief 子进程 读取 的 同时，父进程 每 10 毫秒 发布一次（偏移量 每次 增加 1 微秒）。
+ */
+static x_void_t check_process(x_cstring_t xszt_name)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    printf("process : skipped on Windows\n");
+#else // !(defined(_WIN32) || defined(_WIN64))
+    xntp_shmptr_t xshm_pub   = ntpshm_create(xszt_name);
+    x_int64_t     xit_offset = 7 * XTIME_VNSEC_MSEC;
+    x_int32_t     xit_status = 0;
+    x_uint32_t    xut_iter   = 0;
+    pid_t         xpid_child = 0;
+
+    if (X_NULL == xshm_pub)
+    {
+        XSM_CHECK(X_NULL != xshm_pub);
+        return;
+    }
+
+    // 重置 后 再校准，使 TSC 时钟 直接跳变 到 新的 偏移量
+    ntpclk_reset();
+    ntpclk_update(xit_offset);
+    XSM_CHECK(0 == ntpshm_publish(xshm_pub, xit_offset, 0));
+
+    xpid_child = fork();
+    if (0 == xpid_child)
+    {
+        xit_status = reader_proc(xszt_name, xit_offset);
+        fflush(stdout);
+        _exit(xit_status);
+    }
+
+    for (xut_iter = 0; xut_iter < (XSM_READ_MSEC + 200) / 10; ++xut_iter)
+    {
+        sleep_msec(10);
+        xit_offset += 10;
+        ntpclk_update(xit_offset);
+        XSM_CHECK(0 == ntpshm_publish(xshm_pub, xit_offset, 0));
+    }
+
+    XSM_CHECK(xpid_child == waitpid(xpid_child, &xit_status, 0));
+    XSM_CHECK(WIFEXITED(xit_status) && (0 == WEXITSTATUS(xit_status)));
+
+    ntpshm_close(xshm_pub);
+    ntpshm_unlink(xszt_name);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 测量 ntpshm_now() 与 time_vnsec() 的 耗时。
+ */
+static x_void_t bench_read(x_cstring_t xszt_name, x_uint32_t xut_count)
+{
+    xntp_shmptr_t xshm_pub = ntpshm_create(xszt_name);
+    xntp_shmptr_t xshm_sub = ntpshm_open(xszt_name);
+    x_uint32_t    xut_iter = 0;
+    x_uint64_t    xut_sum  = 0;
+    xtime_vnsec_t xtm_shm  = 0;
+    xtime_vnsec_t xtm_sys  = 0;
+
+    if ((X_NULL != xshm_pub) && (X_NULL != xshm_sub) && (0 == ntpshm_publish(xshm_pub, 0, 0)))
+    {
+        xtm_shm = time_mono();
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+            xut_sum += ntpshm_now(xshm_sub);
+        xtm_shm = time_mono() - xtm_shm;
+
+        xtm_sys = time_mono();
+        for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+            xut_sum += time_vnsec();
+        xtm_sys = time_mono() - xtm_sys;
+
+        printf("bench : ntpshm_now() %.2f ns, time_vnsec() %.2f ns [%llu]\n",
+               xtm_shm * 100.0 / xut_count,
+               xtm_sys * 100.0 / xut_count,
+               xut_sum & 1);
+    }
+
+    if (X_NULL != xshm_sub)
+        ntpshm_close(xshm_sub);
+    if (X_NULL != xshm_pub)
+        ntpshm_close(xshm_pub);
+    ntpshm_unlink(xszt_name);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_uint32_t xut_count = 10000000;
+    x_char_t   xszt_name[TEXT_LEN_64];
+
+    if (argc > 1)
+    {
+        xut_count = (x_uint32_t)atoi(argv[1]);
+    }
+
+    // 以 进程 ID 区分 段 的 名称，避免 与 正在运行的 发布方 冲突
+#if defined(_WIN32) || defined(_WIN64)
+    snprintf(xszt_name, sizeof(xszt_name), "Local\\xntp_test_%u", (x_uint32_t)GetCurrentProcessId());
+#else // !(defined(_WIN32) || defined(_WIN64))
+    snprintf(xszt_name, sizeof(xszt_name), "/xntp_test_%u", (x_uint32_t)getpid());
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    // 以 较长的 自旋 完成 TSC 的 首次校准，子进程 读取期间 的 频率误差 因而 很小
+    time_tsc_calibrate(200);
+
+    check_publish(xszt_name);
+    check_version(xszt_name);
+    check_process(xszt_name);
+    bench_read(xszt_name, xut_count);
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+    return (0 == xit_fail) ? 0 : 1;
+}
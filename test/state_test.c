@@ -0,0 +1,466 @@
+﻿/**
+ * @file state_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 热启动状态文件 与 客户端的 地址缓存。
+ * @note
+ * 先校验 状态文件 的 保存、加载，损坏、截断 的 文件 被拒绝，未知的 记录 被跳过；
+ * 再校验 ntpclk_warm() 预设的 频率 在 首次校准 时 即被采用；
+ * 然后 在本机回环地址上 启动一个 简易服务端：
+ * 以 “localhost” 请求 后，状态文件 记录了 解析所得的 127.0.0.1；
+ * 以 不可解析的 域名 与 预先写入的 地址 加载 状态文件 后，请求 无须 域名解析 即可成功，地址 过期后 则失败；
+ * 首个 缓存地址 不应答 时，请求 在 截止时间 内 改用 下一个地址，超时的 地址 不再 排在 首位。
+ */
+
+#include "ntp_client.h"
+#include "ntp_state.h"
+#include "xtest_server.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 秒 对应的 时间计量值 */
+#define XST_SEC         ((x_int64_t)(1000 * XTIME_VNSEC_MSEC))
+
+/** 测试用的 状态文件 */
+#define XST_FILE        "state_test.dat"
+
+/** 不可解析的 域名（.invalid 为 保留的 顶级域名） */
+#define XST_BAD_HOST    "xntp.state.invalid"
+
+/** 没有 服务端 的 回环地址（请求 不应答） */
+#define XST_DEAD_ADDR   0x7F000003
+
+/** 预设 的 频率偏差（ppb） */
+#define XST_FREQ        25000LL
+
+static x_int32_t xit_fail = 0;
+
+#define XST_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 读取 整个文件，返回 读取的 字节数（失败 返回 0）。
+ */
+static x_uint32_t file_read(x_cstring_t xszt_path, x_uchar_t * xbt_data, x_uint32_t xut_size)
+{
+    x_uint32_t xut_dlen  = 0;
+    FILE     * xfile_ptr = fopen(xszt_path, "rb");
+
+    if (X_NULL != xfile_ptr)
+    {
+        xut_dlen = (x_uint32_t)fread(xbt_data, 1, xut_size, xfile_ptr);
+        fclose(xfile_ptr);
+    }
+
+    return xut_dlen;
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 整个文件。
+ */
+static x_void_t file_write(x_cstring_t xszt_path, const x_uchar_t * xbt_data, x_uint32_t xut_dlen)
+{
+    FILE * xfile_ptr = fopen(xszt_path, "wb");
+
+    if (X_NULL != xfile_ptr)
+    {
+        fwrite(xbt_data, 1, xut_dlen, xfile_ptr);
+        fclose(xfile_ptr);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 状态文件 的 保存、加载 与 格式检查。
+ */
+static x_void_t check_file(x_void_t)
+{
+    xntp_state_t xstate;
+    xntp_state_t xload;
+    x_uchar_t    xbt_data[TEXT_LEN_1K];
+    x_uint32_t   xut_dlen = 0;
+    x_uint32_t   xut_hash = 0;
+    x_uint32_t   xut_iter = 0;
+
+    remove(XST_FILE);
+    XST_CHECK(ENOENT == ntpstate_load(XST_FILE, &xload));
+
+    memset(&xstate, 0, sizeof(xntp_state_t));
+    xstate.xtm_saved  = time_vnsec();
+    xstate.xbt_freq   = X_TRUE;
+    xstate.xit_freq   = -XST_FREQ;
+    strcpy(xstate.xszt_host, "pool.ntp.org");
+    xstate.xut_port   = 123;
+    xstate.xut_naddr  = 3;
+    xstate.xut_addrs[0] = 0x7F000001;
+    xstate.xut_addrs[1] = 0xC0A80001;
+    xstate.xut_addrs[2] = 0x0A000001;
+    xstate.xtm_expire = xstate.xtm_saved + 3600 * XST_SEC;
+
+    //======================================
+    // 往返
+
+    XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+    XST_CHECK(0 == ntpstate_load(XST_FILE, &xload));
+    XST_CHECK(0 == memcmp(&xstate, &xload, sizeof(xntp_state_t)));
+
+    // 只有 保存时刻
+    memset(&xload, 0xFF, sizeof(xntp_state_t));
+    xstate.xbt_freq     = X_FALSE;
+    xstate.xit_freq     = 0;
+    memset(xstate.xszt_host, 0, sizeof(xstate.xszt_host));
+    xstate.xut_port     = 0;
+    xstate.xut_naddr    = 0;
+    memset(xstate.xut_addrs, 0, sizeof(xstate.xut_addrs));
+    xstate.xtm_expire   = 0;
+    XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+    XST_CHECK(0 == ntpstate_load(XST_FILE, &xload));
+    XST_CHECK(0 == memcmp(&xstate, &xload, sizeof(xntp_state_t)));
+
+    //======================================
+    // 未知的 记录：追加后 修正 头部 的 长度 与 校验和
+
+    xstate.xbt_freq = X_TRUE;
+    xstate.xit_freq = XST_FREQ;
+    XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+    xut_dlen = file_read(XST_FILE, xbt_data, TEXT_LEN_1K);
+    XST_CHECK(xut_dlen > 16);
+
+    ntp_store32(xbt_data + xut_dlen + 0, 0x7777);
+    ntp_store32(xbt_data + xut_dlen + 4, 6);
+    memcpy(xbt_data + xut_dlen + 8, "future", 6);
+    xut_dlen += 14;
+
+    ntp_store32(xbt_data + 8, xut_dlen - 16);
+    for (xut_iter = 16, xut_hash = 0x811C9DC5U; xut_iter < xut_dlen; ++xut_iter)
+    {
+        xut_hash ^= xbt_data[xut_iter];
+        xut_hash *= 0x01000193U;
+    }
+    ntp_store32(xbt_data + 12, xut_hash);
+    file_write(XST_FILE, xbt_data, xut_dlen);
+
+    XST_CHECK(0 == ntpstate_load(XST_FILE, &xload));
+    XST_CHECK(xload.xbt_freq && (XST_FREQ == xload.xit_freq));
+
+    //======================================
+    // 损坏、截断
+
+    xbt_data[xut_dlen - 1] ^= 0x5A;
+    file_write(XST_FILE, xbt_data, xut_dlen);
+    XST_CHECK(EPROTO == ntpstate_load(XST_FILE, &xload));
+
+    xbt_data[xut_dlen - 1] ^= 0x5A;
+    file_write(XST_FILE, xbt_data, xut_dlen - 3);
+    XST_CHECK(EPROTO == ntpstate_load(XST_FILE, &xload));
+
+    file_write(XST_FILE, (const x_uchar_t *)"not a state file", 16);
+    XST_CHECK(EPROTO == ntpstate_load(XST_FILE, &xload));
+
+    remove(XST_FILE);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 预设的 频率 在 首次校准 时 即被采用。
+ */
+static x_void_t check_warm(x_void_t)
+{
+    xntp_clkstat_t xclk_stat;
+
+    if (0 == time_tsc_freq())
+    {
+        printf("TSC is not invariant, skip check_warm()\n");
+        return;
+    }
+
+    XST_CHECK(ERANGE == ntpclk_warm(XNTP_CLK_FREQ_MAX + 1));
+    XST_CHECK(ERANGE == ntpclk_warm(-XNTP_CLK_FREQ_MAX - 1));
+
+    ntpclk_reset();
+    XST_CHECK(0 == ntpclk_update(0));
+    ntpclk_stat(&xclk_stat);
+    XST_CHECK(xclk_stat.xbt_valid && !xclk_stat.xbt_freq);
+
+    ntpclk_reset();
+    XST_CHECK(0 == ntpclk_warm(XST_FREQ));
+    XST_CHECK(0 == ntpclk_update(0));
+    ntpclk_stat(&xclk_stat);
+    XST_CHECK(xclk_stat.xbt_valid && xclk_stat.xbt_freq);
+    XST_CHECK((xclk_stat.xit_freq > XST_FREQ - 10) && (xclk_stat.xit_freq < XST_FREQ + 10));
+
+    // 再次 平滑校准，基线 尚短，仍沿用 预设值
+    XST_CHECK(0 == ntpclk_update(0));
+    ntpclk_stat(&xclk_stat);
+    XST_CHECK((xclk_stat.xit_freq > XST_FREQ - 10) && (xclk_stat.xit_freq < XST_FREQ + 10));
+
+    ntpclk_reset();
+    ntpclk_stat(&xclk_stat);
+    XST_CHECK(!xclk_stat.xbt_valid);
+}
+
+/**********************************************************/
+/**
+ * @brief 校验 客户端 的 状态保存 与 地址缓存。
+ */
+static x_void_t check_client(x_void_t)
+{
+    xtest_server_t xst_srv;
+    xntp_cliptr_t  xntp_this = X_NULL;
+    xntp_state_t   xstate;
+    xtime_vnsec_t  xtm_value = XTIME_INVALID_VNSEC;
+    xtime_vnsec_t  xtm_mono  = 0;
+
+    memset(&xst_srv, 0, sizeof(xtest_server_t));
+    if (0 != xtest_server_start(&xst_srv))
+    {
+        printf("xtest_server_start() failed, errno : %d\n", errno);
+        xit_fail += 1;
+        return;
+    }
+
+    remove(XST_FILE);
+
+    do
+    {
+        //======================================
+        // 首次运行：没有 状态文件，请求成功 后 保存 解析结果
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XST_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        XST_CHECK(0 == ntpcli_config(xntp_this, "localhost", xst_srv.xut_port));
+        XST_CHECK(0 == ntpcli_state(xntp_this, XST_FILE));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        XST_CHECK(XTMVNSEC_IS_VALID(xtm_value));
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+
+        XST_CHECK(0 == ntpstate_load(XST_FILE, &xstate));
+        XST_CHECK(0 == strcmp("localhost", xstate.xszt_host));
+        XST_CHECK(xst_srv.xut_port == xstate.xut_port);
+        XST_CHECK((xstate.xut_naddr >= 1) && (0x7F000001 == xstate.xut_addrs[0]));
+        XST_CHECK(xstate.xtm_expire > time_vnsec() + (XNTP_STATE_ADDR_TTL - 60) * XST_SEC);
+
+        //======================================
+        // 热启动：域名 不可解析，请求 只能 使用 缓存的 地址
+
+        strcpy(xstate.xszt_host, XST_BAD_HOST);
+        xstate.xut_naddr    = 2;
+        xstate.xut_addrs[0] = 0x7F000001;
+        xstate.xut_addrs[1] = 0x7F000001;
+        XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XST_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, xst_srv.xut_port));
+        XST_CHECK(0 == ntpcli_state(xntp_this, XST_FILE));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        XST_CHECK(XTMVNSEC_IS_VALID(xtm_value));
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+
+        // 保存的 仍是 预先写入的 地址缓存
+        XST_CHECK(0 == ntpstate_load(XST_FILE, &xstate));
+        XST_CHECK((0 == strcmp(XST_BAD_HOST, xstate.xszt_host)) && (2 == xstate.xut_naddr));
+
+        //======================================
+        // 首个 缓存地址 不应答：其 截止时间 为 剩余时间 的 一半，到期后 请求 下一个地址
+
+        xstate.xut_naddr    = 2;
+        xstate.xut_addrs[0] = XST_DEAD_ADDR;
+        xstate.xut_addrs[1] = 0x7F000001;
+        XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XST_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, xst_srv.xut_port));
+        XST_CHECK(0 == ntpcli_state(xntp_this, XST_FILE));
+        xtm_mono  = time_mono();
+        xtm_value = ntpcli_req_time(xntp_this, 2000);
+        XST_CHECK(XTMVNSEC_IS_VALID(xtm_value));
+        XST_CHECK(time_mono() - xtm_mono < (xtime_vnsec_t)(1500 * XTIME_VNSEC_MSEC));
+
+        // 应答的 地址 移到 首位，下次 请求 不再 等待 不应答的 地址
+        xtm_mono  = time_mono();
+        xtm_value = ntpcli_req_time(xntp_this, 2000);
+        XST_CHECK(XTMVNSEC_IS_VALID(xtm_value));
+        XST_CHECK(time_mono() - xtm_mono < (xtime_vnsec_t)(500 * XTIME_VNSEC_MSEC));
+
+        XST_CHECK(0 == ntpcli_state_flush(xntp_this));
+        XST_CHECK(0 == ntpstate_load(XST_FILE, &xstate));
+        XST_CHECK((2 == xstate.xut_naddr) &&
+                  (0x7F000001 == xstate.xut_addrs[0]) && (XST_DEAD_ADDR == xstate.xut_addrs[1]));
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+
+        //======================================
+        // 缓存的 地址 均 不应答：超时的 首个地址 移到 末尾；只有 一个地址 时 清除缓存
+
+        xstate.xut_addrs[0] = XST_DEAD_ADDR;
+        xstate.xut_addrs[1] = XST_DEAD_ADDR + 1;
+        XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XST_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, xst_srv.xut_port));
+        XST_CHECK(0 == ntpcli_state(xntp_this, XST_FILE));
+        xtm_value = ntpcli_req_time(xntp_this, 300);
+        XST_CHECK(!XTMVNSEC_IS_VALID(xtm_value));
+
+        XST_CHECK(0 == ntpcli_state_flush(xntp_this));
+        XST_CHECK(0 == ntpstate_load(XST_FILE, &xstate));
+        XST_CHECK((2 == xstate.xut_naddr) &&
+                  (XST_DEAD_ADDR + 1 == xstate.xut_addrs[0]) && (XST_DEAD_ADDR == xstate.xut_addrs[1]));
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+
+        xstate.xut_naddr = 1;
+        XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XST_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, xst_srv.xut_port));
+        XST_CHECK(0 == ntpcli_state(xntp_this, XST_FILE));
+        xtm_value = ntpcli_req_time(xntp_this, 300);
+        XST_CHECK(!XTMVNSEC_IS_VALID(xtm_value));
+
+        XST_CHECK(0 == ntpcli_state_flush(xntp_this));
+        XST_CHECK(0 == ntpstate_load(XST_FILE, &xstate));
+        XST_CHECK(0 == xstate.xut_naddr);
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+
+        // 恢复 预先写入的 地址缓存，供 以下 校验 使用
+        xstate.xut_naddr    = 2;
+        xstate.xut_addrs[0] = 0x7F000001;
+        xstate.xut_addrs[1] = 0x7F000001;
+        xstate.xtm_expire   = time_vnsec() + 3600 * XST_SEC;
+        XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+
+        //======================================
+        // 服务端 改变 后，缓存 失效
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XST_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, xst_srv.xut_port));
+        XST_CHECK(0 == ntpcli_state(xntp_this, XST_FILE));
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, (x_uint16_t)(xst_srv.xut_port + 1)));
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, xst_srv.xut_port));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        XST_CHECK(!XTMVNSEC_IS_VALID(xtm_value));
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+
+        //======================================
+        // 地址 已过期：不使用
+
+        xstate.xtm_expire = time_vnsec() - XST_SEC;
+        XST_CHECK(0 == ntpstate_save(XST_FILE, &xstate));
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            XST_CHECK(X_NULL != xntp_this);
+            break;
+        }
+
+        XST_CHECK(0 == ntpcli_config(xntp_this, XST_BAD_HOST, xst_srv.xut_port));
+        XST_CHECK(0 == ntpcli_state(xntp_this, XST_FILE));
+        xtm_value = ntpcli_req_time(xntp_this, 3000);
+        XST_CHECK(!XTMVNSEC_IS_VALID(xtm_value));
+
+        // 损坏的 状态文件
+        file_write(XST_FILE, (const x_uchar_t *)"not a state file", 16);
+        XST_CHECK(EPROTO == ntpcli_state(xntp_this, XST_FILE));
+        XST_CHECK(0 == ntpcli_state(xntp_this, X_NULL));
+    } while (0);
+
+    if (X_NULL != xntp_this)
+    {
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+    }
+
+    remove(XST_FILE);
+
+    xtest_server_stop(&xst_srv);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    (x_void_t)argc;
+    (x_void_t)argv;
+
+    check_file();
+    check_warm();
+    check_client();
+
+    printf("%s : %d check(s) failed\n", (0 == xit_fail) ? "PASS" : "FAIL", xit_fail);
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    return (0 == xit_fail) ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+﻿/**
+ * @file sweep_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 批量请求（ntpcli_req_sweep()）的程序。
+ */
+
+#include "ntp_client.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <WinSock2.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 请求项的最大数量 */
+#define XSWEEP_MAX  4096
+
+/**********************************************************/
+/**
+ * @brief 解析 “a.b.c.d[:port]” 格式的字符串。
+ *
+ * @return x_bool_t : 成功，返回 X_TRUE；失败，返回 X_FALSE。
+ */
+static x_bool_t parse_addr(x_cstring_t xszt_addr, xntp_sweep_t * xsw_item)
+{
+    x_uint32_t xut_ipv[4] = { 0, 0, 0, 0 };
+    x_uint32_t xut_port   = NTP_PORT;
+    x_int32_t  xit_count  = 0;
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable:4996)
+#endif // _MSC_VER
+    xit_count = sscanf(xszt_addr, "%u.%u.%u.%u:%u",
+                       &xut_ipv[0], &xut_ipv[1], &xut_ipv[2], &xut_ipv[3], &xut_port);
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif // _MSC_VER
+
+    if ((xit_count < 4) ||
+        (xut_ipv[0] > 0xFF) || (xut_ipv[1] > 0xFF) ||
+        (xut_ipv[2] > 0xFF) || (xut_ipv[3] > 0xFF) || (xut_port > 0xFFFF))
+    {
+        return X_FALSE;
+    }
+
+    xsw_item->xut_ipv4 = (xut_ipv[0] << 24) | (xut_ipv[1] << 16) | (xut_ipv[2] << 8) | xut_ipv[3];
+    xsw_item->xut_port = (x_uint16_t)xut_port;
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 显示应用程序的 命令行格式。
+ */
+static x_void_t usage(x_cstring_t xszt_app)
+{
+    printf("Usage:\n %s [-n <number>] [-t <msec>] [-q] <ip[:port]> [<ip[:port]> ...]\n", xszt_app);
+    printf("\t-n <number> The times of repetition.\n");
+    printf("\t-t <msec>   Deadline of each sweep in milliseconds, default 3000.\n");
+    printf("\t-q          Output the summary only.\n");
+    printf("\t<ip[:port]> The IPv4 address of NTP server, one item may be given many times.\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    x_int32_t      xit_iter  = 0;
+    x_int32_t      xit_rept  = 1;
+    x_uint32_t     xut_tmout = 3000;
+    x_bool_t       xbt_quiet = X_FALSE;
+    x_uint32_t     xut_count = 0;
+    x_uint32_t     xut_iter  = 0;
+    x_uint32_t     xut_okay  = 0;
+    x_int32_t      xit_errno = 0;
+    xntp_cliptr_t  xntp_this = X_NULL;
+    xntp_sweep_t * xsw_list  = X_NULL;
+    xtime_vnsec_t  xtm_start = 0;
+    xtime_vnsec_t  xtm_spent = 0;
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSADATA xwsa_data;
+    WSAStartup(MAKEWORD(2, 0), &xwsa_data);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    do
+    {
+        //======================================
+
+        xsw_list = (xntp_sweep_t *)calloc(XSWEEP_MAX, sizeof(xntp_sweep_t));
+        if (X_NULL == xsw_list)
+        {
+            printf("calloc() return X_NULL\n");
+            break;
+        }
+
+        for (xit_iter = 1; xit_iter < argc; ++xit_iter)
+        {
+            if ((0 == strcmp("-n", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xit_rept = atoi(argv[++xit_iter]);
+            else if ((0 == strcmp("-t", argv[xit_iter])) && ((xit_iter + 1) < argc))
+                xut_tmout = (x_uint32_t)atoi(argv[++xit_iter]);
+            else if (0 == strcmp("-q", argv[xit_iter]))
+                xbt_quiet = X_TRUE;
+            else if ((xut_count < XSWEEP_MAX) && parse_addr(argv[xit_iter], &xsw_list[xut_count]))
+                xut_count += 1;
+        }
+
+        if (0 == xut_count)
+        {
+            usage(argv[0]);
+            break;
+        }
+
+        xntp_this = ntpcli_open();
+        if (X_NULL == xntp_this)
+        {
+            printf("ntpcli_open() return X_NULL, errno : %d\n", errno);
+            break;
+        }
+
+        //======================================
+
+        for (; xit_rept > 0; --xit_rept)
+        {
+            xtm_start = time_mono();
+            xit_errno = ntpcli_req_sweep(
+                            xntp_this,
+                            xsw_list,
+                            xut_count,
+                            xtm_start + xut_tmout * XTIME_VNSEC_MSEC);
+            xtm_spent = time_mono() - xtm_start;
+
+            if (0 != xit_errno)
+            {
+                printf("ntpcli_req_sweep() return %d\n", xit_errno);
+                break;
+            }
+
+            for (xut_iter = 0, xut_okay = 0; xut_iter < xut_count; ++xut_iter)
+            {
+                if (0 == xsw_list[xut_iter].xit_errno)
+                    xut_okay += 1;
+
+                if (xbt_quiet)
+                    continue;
+
+                printf("[%u] %u.%u.%u.%u:%u : errno = %d, RTT = %lld us, offset = %lld us, keyid = %u\n",
+                       xut_iter,
+                       (xsw_list[xut_iter].xut_ipv4 >> 24) & 0xFF,
+                       (xsw_list[xut_iter].xut_ipv4 >> 16) & 0xFF,
+                       (xsw_list[xut_iter].xut_ipv4 >>  8) & 0xFF,
+                       (xsw_list[xut_iter].xut_ipv4 >>  0) & 0xFF,
+                       xsw_list[xut_iter].xut_port,
+                       xsw_list[xut_iter].xit_errno,
+                       (0 != xsw_list[xut_iter].xit_errno) ? 0LL :
+                       ((x_int64_t)(xsw_list[xut_iter].xtm_4time[3] - xsw_list[xut_iter].xtm_4time[0]) -
+                        (x_int64_t)(xsw_list[xut_iter].xtm_4time[2] - xsw_list[xut_iter].xtm_4time[1])) / 10LL,
+                       (0 != xsw_list[xut_iter].xit_errno) ? 0LL :
+                       ((x_int64_t)(xsw_list[xut_iter].xtm_vnsec - xsw_list[xut_iter].xtm_4time[3])) / 10LL,
+                       xsw_list[xut_iter].xut_mackey);
+            }
+
+            printf("sweep : %u/%u replies in %llu us\n", xut_okay, xut_count, xtm_spent / 10ULL);
+        }
+
+        //======================================
+    } while (0);
+
+    if (X_NULL != xntp_this)
+    {
+        ntpcli_close(xntp_this);
+        xntp_this = X_NULL;
+    }
+
+    if (X_NULL != xsw_list)
+    {
+        free(xsw_list);
+        xsw_list = X_NULL;
+    }
+
+    //======================================
+
+#if defined(_WIN32) || defined(_WIN64)
+    WSACleanup();
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    //======================================
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
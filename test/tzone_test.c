@@ -0,0 +1,587 @@
+﻿/**
+ * @file tzone_test.c
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试 进程内的 时区转换（TZif 时区对象、time_vtod_tz()/time_dtov_tz()）。
+ * @note
+ * 先以 内存中 构造的 TZif 数据 校验 版本 1、版本 2（含 POSIX TZ 规则 的 展开）的 解析 与 各种 畸形数据；
+ * 再 加载 系统的 时区数据库（缺失时 跳过），在 1970 ~ 2199 年 间 逐步 对照 localtime_r()
+ * （含 各个 偏移变化 的 前后 1 秒），校验 time_dtov_tz() 的 往返、重复 与 跳过 的 本地时间；
+ * 最后 校验 多个线程 同时加载 同一时区 时 得到 同一对象。
+ */
+
+/**
+ * The MIT License (MIT)
+ * Copyright (c) Gaaagaa. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "xtzone.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+#if (defined(__linux__) || defined(__unix__))
+#include <pthread.h>
+#include <time.h>
+#endif // (defined(__linux__) || defined(__unix__))
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 1 秒 对应的 时间计量值 */
+#define XTZ_SEC         ((xtime_vnsec_t)10000000ULL)
+
+/** UNIX 秒数 转换为 时间计量值 */
+#define XTZ_VNSEC(xsec) ((xtime_vnsec_t)(xsec) * XTZ_SEC)
+
+/** 对照 localtime_r() 的 截止时刻：2200-01-01 00:00:00 UTC */
+#define XTZ_SEC_2200    7258118400LL
+
+/** 检查失败的次数 */
+static x_int32_t xit_fail = 0;
+
+#define XTZ_CHECK(xcond)                                              \
+    do                                                                \
+    {                                                                 \
+        if (!(xcond))                                                 \
+        {                                                             \
+            printf("check failed at line %d : %s\n",                  \
+                   __LINE__, #xcond);                                 \
+            xit_fail += 1;                                            \
+        }                                                             \
+    } while (0)
+
+/**
+ * @struct xtz_blob_t
+ * @brief  构造 TZif 数据 的 参数（只含 一个 数据块 的 内容）。
+ */
+typedef struct xtz_blob_t
+{
+    x_char_t          xct_version;      ///< 版本（'\0'、'2'、'3'、'4'）
+    x_uint32_t        xut_leapcnt;      ///< 闰秒记录 的 数量
+    x_uint32_t        xut_timecnt;      ///< 偏移变化 的 数量
+    const x_int64_t * xit_when;         ///< 偏移变化 的 时刻
+    const x_uint8_t * xut_index;        ///< 偏移变化 之后的 类型
+    x_uint32_t        xut_typecnt;      ///< 本地时间类型 的 数量
+    const x_int32_t * xit_utoff;        ///< 各个类型 的 时区偏移
+    const x_uint8_t * xut_isdst;        ///< 各个类型 的 夏令时标识
+    const x_uint8_t * xut_abbr;         ///< 各个类型 的 缩写位置
+    x_uint32_t        xut_charcnt;      ///< 缩写字符表 的 字节数
+    x_cstring_t       xszt_chars;       ///< 缩写字符表
+    x_cstring_t       xszt_rule;        ///< 末尾的 POSIX TZ 规则（版本 2 及以上）
+} xtz_blob_t;
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 写入 大端字节序 的 32 位 与 64 位 整数。
+ */
+static x_uchar_t * blob_be32(x_uchar_t * xct_iter, x_uint32_t xut_value)
+{
+    xct_iter[0] = (x_uchar_t)(xut_value >> 24);
+    xct_iter[1] = (x_uchar_t)(xut_value >> 16);
+    xct_iter[2] = (x_uchar_t)(xut_value >>  8);
+    xct_iter[3] = (x_uchar_t)(xut_value      );
+    return xct_iter + 4;
+}
+
+static x_uchar_t * blob_be64(x_uchar_t * xct_iter, x_uint64_t xut_value)
+{
+    blob_be32(xct_iter, (x_uint32_t)(xut_value >> 32));
+    return blob_be32(xct_iter + 4, (x_uint32_t)xut_value);
+}
+
+/**********************************************************/
+/**
+ * @brief 写入 TZif 文件头 与 数据块（xut_tsize 为 时刻 的 字节数）。
+ */
+static x_uchar_t * blob_block(x_uchar_t * xct_iter, const xtz_blob_t * xblob_ptr, x_uint32_t xut_tsize)
+{
+    x_uint32_t xut_iter = 0;
+
+    memcpy(xct_iter, "TZif", 4);
+    xct_iter[4] = (x_uchar_t)xblob_ptr->xct_version;
+    memset(xct_iter + 5, 0, 15);
+    xct_iter = blob_be32(xct_iter + 20, 0);
+    xct_iter = blob_be32(xct_iter, 0);
+    xct_iter = blob_be32(xct_iter, xblob_ptr->xut_leapcnt);
+    xct_iter = blob_be32(xct_iter, xblob_ptr->xut_timecnt);
+    xct_iter = blob_be32(xct_iter, xblob_ptr->xut_typecnt);
+    xct_iter = blob_be32(xct_iter, xblob_ptr->xut_charcnt);
+
+    for (xut_iter = 0; xut_iter < xblob_ptr->xut_timecnt; ++xut_iter)
+    {
+        if (8 == xut_tsize)
+            xct_iter = blob_be64(xct_iter, (x_uint64_t)xblob_ptr->xit_when[xut_iter]);
+        else
+            xct_iter = blob_be32(xct_iter, (x_uint32_t)xblob_ptr->xit_when[xut_iter]);
+    }
+
+    for (xut_iter = 0; xut_iter < xblob_ptr->xut_timecnt; ++xut_iter)
+        *xct_iter++ = xblob_ptr->xut_index[xut_iter];
+
+    for (xut_iter = 0; xut_iter < xblob_ptr->xut_typecnt; ++xut_iter)
+    {
+        xct_iter    = blob_be32(xct_iter, (x_uint32_t)xblob_ptr->xit_utoff[xut_iter]);
+        *xct_iter++ = xblob_ptr->xut_isdst[xut_iter];
+        *xct_iter++ = xblob_ptr->xut_abbr[xut_iter];
+    }
+
+    memcpy(xct_iter, xblob_ptr->xszt_chars, xblob_ptr->xut_charcnt);
+    xct_iter += xblob_ptr->xut_charcnt;
+
+    memset(xct_iter, 0, xblob_ptr->xut_leapcnt * (xut_tsize + 4));
+    xct_iter += xblob_ptr->xut_leapcnt * (xut_tsize + 4);
+
+    return xct_iter;
+}
+
+/**********************************************************/
+/**
+ * @brief 构造 TZif 数据：版本 1 只有 32 位 数据块；版本 2 及以上 的 版本 1 数据块 为空，其后 为 64 位 数据块 与 规则。
+ *
+ * @return x_uint32_t : 返回 数据的 字节数。
+ */
+static x_uint32_t blob_build(x_uchar_t * xct_data, const xtz_blob_t * xblob_ptr)
+{
+    x_uchar_t * xct_iter = xct_data;
+    xtz_blob_t  xblob_v1;
+
+    if ('\0' == xblob_ptr->xct_version)
+    {
+        return (x_uint32_t)(blob_block(xct_iter, xblob_ptr, 4) - xct_data);
+    }
+
+    memset(&xblob_v1, 0, sizeof(xtz_blob_t));
+    xblob_v1.xct_version = xblob_ptr->xct_version;
+
+    xct_iter = blob_block(xct_iter, &xblob_v1, 4);
+    xct_iter = blob_block(xct_iter, xblob_ptr, 8);
+    xct_iter += sprintf((x_char_t *)xct_iter, "\n%s\n", (X_NULL != xblob_ptr->xszt_rule) ? xblob_ptr->xszt_rule : "");
+
+    return (x_uint32_t)(xct_iter - xct_data);
+}
+
+/**********************************************************/
+/**
+ * @brief 以 UTC 的 日期、时间 构造 时间描述信息。
+ */
+static xtime_descr_t make_descr(
+                        x_uint32_t xut_year, x_uint32_t xut_month, x_uint32_t xut_day,
+                        x_uint32_t xut_hour, x_uint32_t xut_minute, x_uint32_t xut_second)
+{
+    xtime_descr_t xtm_descr = { 0 };
+
+    xtm_descr.ctx_year   = xut_year;
+    xtm_descr.ctx_month  = xut_month;
+    xtm_descr.ctx_day    = xut_day;
+    xtm_descr.ctx_hour   = xut_hour;
+    xtm_descr.ctx_minute = xut_minute;
+    xtm_descr.ctx_second = xut_second;
+
+    return xtm_descr;
+}
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 校验 构造的 TZif 数据：版本 1、版本 2 的 规则展开、南半球 与 半小时 的 夏令时、畸形数据。
+ */
+static x_void_t check_blob(x_void_t)
+{
+    x_uchar_t       xct_data[4096];
+    x_uint32_t      xut_size   = 0;
+    xtime_zoneptr_t xtzone_ptr = X_NULL;
+    xtime_descr_t   xtm_descr;
+    xtz_blob_t      xblob;
+
+    static const x_int64_t xit_when [2] = { 1000000000LL, 1100000000LL };
+    static const x_uint8_t xut_index[2] = { 1, 0 };
+    static const x_int32_t xit_utoff[2] = { 3600, 7200 };
+    static const x_uint8_t xut_isdst[2] = { 0, 1 };
+    static const x_uint8_t xut_abbr [2] = { 0, 4 };
+    static const x_int32_t xit_est  [1] = { -18000 };
+    static const x_uint8_t xut_zero [1] = { 0 };
+
+    //======================================
+    // 版本 1：两个 偏移变化
+
+    memset(&xblob, 0, sizeof(xtz_blob_t));
+    xblob.xut_timecnt = 2;
+    xblob.xit_when    = xit_when;
+    xblob.xut_index   = xut_index;
+    xblob.xut_typecnt = 2;
+    xblob.xit_utoff   = xit_utoff;
+    xblob.xut_isdst   = xut_isdst;
+    xblob.xut_abbr    = xut_abbr;
+    xblob.xut_charcnt = 8;
+    xblob.xszt_chars  = "AAA\0BBB";
+
+    xut_size   = blob_build(xct_data, &xblob);
+    xtzone_ptr = tzone_create(xct_data, xut_size);
+    XTZ_CHECK(X_NULL != xtzone_ptr);
+    if (X_NULL != xtzone_ptr)
+    {
+        XTZ_CHECK(3600 == tzone_offset(xtzone_ptr, XTZ_VNSEC(999999999LL)));
+        XTZ_CHECK(7200 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1000000000LL)));
+        XTZ_CHECK(7200 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1100000000LL) - 1));
+        XTZ_CHECK(3600 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1100000000LL)));
+        XTZ_CHECK(0 == strcmp("BBB", tzone_abbr(xtzone_ptr, XTZ_VNSEC(1050000000LL))));
+        XTZ_CHECK(0 == strcmp("AAA", tzone_abbr(xtzone_ptr, 0)));
+        XTZ_CHECK(0 == strcmp("", tzone_name(xtzone_ptr)));
+
+        // 1970-01-01 00:00:00 UTC 为 本地 01:00:00
+        xtm_descr = time_vtod_tz(xtzone_ptr, 0);
+        XTZ_CHECK((1970 == xtm_descr.ctx_year) && (1 == xtm_descr.ctx_hour) && (4 == xtm_descr.ctx_week));
+        XTZ_CHECK(0 == time_dtov_tz(xtzone_ptr, xtm_descr));
+
+        // 本地时间 早于 1970 年
+        XTZ_CHECK(!XTMVNSEC_IS_VALID(time_dtov_tz(xtzone_ptr, make_descr(1970, 1, 1, 0, 30, 0))));
+
+        tzone_destroy(xtzone_ptr);
+    }
+
+    //======================================
+    // 版本 2：没有 偏移变化，只有 规则（与 纽约 2007 年以后 相同）
+
+    memset(&xblob, 0, sizeof(xtz_blob_t));
+    xblob.xct_version = '2';
+    xblob.xut_typecnt = 1;
+    xblob.xit_utoff   = xit_est;
+    xblob.xut_isdst   = xut_zero;
+    xblob.xut_abbr    = xut_zero;
+    xblob.xut_charcnt = 4;
+    xblob.xszt_chars  = "EST";
+    xblob.xszt_rule   = "EST5EDT,M3.2.0,M11.1.0";
+
+    xut_size   = blob_build(xct_data, &xblob);
+    xtzone_ptr = tzone_create(xct_data, xut_size);
+    XTZ_CHECK(X_NULL != xtzone_ptr);
+    if (X_NULL != xtzone_ptr)
+    {
+        XTZ_CHECK(-18000 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1772953200LL) - 1));  // 2026-03-08 07:00:00 UTC
+        XTZ_CHECK(-14400 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1772953200LL)));
+        XTZ_CHECK(-14400 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1793512800LL) - 1));  // 2026-11-01 06:00:00 UTC
+        XTZ_CHECK(-18000 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1793512800LL)));
+        XTZ_CHECK(0 == strcmp("EDT", tzone_abbr(xtzone_ptr, XTZ_VNSEC(1782864000LL))));
+        XTZ_CHECK(-14400 == tzone_offset(xtzone_ptr, time_dtov_utc(make_descr(2199, 7, 1, 0, 0, 0))));
+        XTZ_CHECK(-18000 == tzone_offset(xtzone_ptr, time_dtov_utc(make_descr(2199, 12, 1, 0, 0, 0))));
+
+        // 跳过的 本地时间：按 前跳之前 的 偏移 换算；重复的 本地时间：取 较早的 时刻
+        XTZ_CHECK(XTZ_VNSEC(1772953200LL + 1800) == time_dtov_tz(xtzone_ptr, make_descr(2026, 3, 8, 2, 30, 0)));
+        XTZ_CHECK(XTZ_VNSEC(1793512800LL - 1800) == time_dtov_tz(xtzone_ptr, make_descr(2026, 11, 1, 1, 30, 0)));
+        XTZ_CHECK(XTZ_VNSEC(1793512800LL + 5400) == time_dtov_tz(xtzone_ptr, make_descr(2026, 11, 1, 2, 30, 0)));
+
+        xtm_descr = time_vtod_tz(xtzone_ptr, XTZ_VNSEC(1772953200LL));
+        XTZ_CHECK((3 == xtm_descr.ctx_hour) && (0 == xtm_descr.ctx_minute) && (0 == xtm_descr.ctx_week));
+
+        tzone_destroy(xtzone_ptr);
+    }
+
+    //======================================
+    // 南半球、半小时 的 夏令时（与 豪勋爵岛 相同）
+
+    xblob.xszt_rule = "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0";
+    xut_size   = blob_build(xct_data, &xblob);
+    xtzone_ptr = tzone_create(xct_data, xut_size);
+    XTZ_CHECK(X_NULL != xtzone_ptr);
+    if (X_NULL != xtzone_ptr)
+    {
+        XTZ_CHECK(39600 == tzone_offset(xtzone_ptr, time_dtov_utc(make_descr(2030, 1, 1, 0, 0, 0))));
+        XTZ_CHECK(37800 == tzone_offset(xtzone_ptr, time_dtov_utc(make_descr(2030, 7, 1, 0, 0, 0))));
+        XTZ_CHECK(0 == strcmp("+11", tzone_abbr(xtzone_ptr, time_dtov_utc(make_descr(2030, 1, 1, 0, 0, 0)))));
+        XTZ_CHECK(-18000 == tzone_offset(xtzone_ptr, 0));  // 早于 首个 偏移变化：类型 0
+        tzone_destroy(xtzone_ptr);
+    }
+
+    //======================================
+    // 无 夏令时 的 规则
+
+    xblob.xszt_rule = "<+0530>-5:30";
+    xut_size   = blob_build(xct_data, &xblob);
+    xtzone_ptr = tzone_create(xct_data, xut_size);
+    XTZ_CHECK(X_NULL != xtzone_ptr);
+    tzone_destroy(xtzone_ptr);
+
+    //======================================
+    // 畸形数据
+
+    xblob.xszt_rule = "EST5EDT,M13.1.0,M11.1.0";
+    xut_size = blob_build(xct_data, &xblob);
+    errno = 0;
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, xut_size)) && (EINVAL == errno));
+
+    xblob.xszt_rule = "EST5EDT";
+    xut_size = blob_build(xct_data, &xblob);
+    XTZ_CHECK(X_NULL != (xtzone_ptr = tzone_create(xct_data, xut_size)));  // 默认规则 M3.2.0,M11.1.0
+    XTZ_CHECK(-14400 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1772953200LL)));
+    tzone_destroy(xtzone_ptr);
+
+    xblob.xszt_rule = "EST5EDT,M3.2.0,M11.1.0";
+    xut_size = blob_build(xct_data, &xblob);
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, xut_size - 1)) && (EINVAL == errno));  // 规则 缺少 '\n'
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, 43)) && (EINVAL == errno));
+    XTZ_CHECK((X_NULL == tzone_create(X_NULL, 0)) && (EINVAL == errno));
+
+    xct_data[0] = 'X';
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, xut_size)) && (EINVAL == errno));
+
+    xblob.xut_leapcnt = 1;
+    xut_size = blob_build(xct_data, &xblob);
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, xut_size)) && (ENOTSUP == errno));
+    xblob.xut_leapcnt = 0;
+
+    memset(&xblob, 0, sizeof(xtz_blob_t));
+    xblob.xut_timecnt = 2;
+    xblob.xit_when    = xit_when;
+    xblob.xut_index   = xut_index;
+    xblob.xut_typecnt = 1;  // 类型索引 越界
+    xblob.xit_utoff   = xit_utoff;
+    xblob.xut_isdst   = xut_isdst;
+    xblob.xut_abbr    = xut_abbr;
+    xblob.xut_charcnt = 8;
+    xblob.xszt_chars  = "AAA\0BBB";
+    xut_size = blob_build(xct_data, &xblob);
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, xut_size)) && (EINVAL == errno));
+
+    xblob.xut_typecnt = 2;
+    xblob.xut_charcnt = 4;  // 缩写位置 越界
+    xut_size = blob_build(xct_data, &xblob);
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, xut_size)) && (EINVAL == errno));
+
+    xblob.xut_charcnt = 8;
+    xut_size = blob_build(xct_data, &xblob);
+    XTZ_CHECK(X_NULL != (xtzone_ptr = tzone_create(xct_data, xut_size)));
+    tzone_destroy(xtzone_ptr);
+
+    blob_be32(xct_data + 44 + 4, 1000000000U);  // 时刻 不递增
+    XTZ_CHECK((X_NULL == tzone_create(xct_data, xut_size)) && (EINVAL == errno));
+}
+
+#if (defined(__linux__) || defined(__unix__))
+
+/**********************************************************/
+/**
+ * @brief 对照 localtime_r()（进程的 TZ 已设为 同一时区文件）校验 xtm_time 时刻的 转换。
+ */
+static x_void_t check_instant(xtime_zoneptr_t xtzone_ptr, x_int64_t xit_time, x_bool_t xbt_print)
+{
+    time_t        xtm_time   = (time_t)xit_time;
+    xtime_vnsec_t xtm_vnsec  = XTZ_VNSEC(xit_time) + 1230000;
+    xtime_vnsec_t xtm_back   = 0;
+    xtime_descr_t xtm_descr  = time_vtod_tz(xtzone_ptr, xtm_vnsec);
+    x_bool_t      xbt_match  = X_FALSE;
+    struct tm     xtm_local;
+
+    localtime_r(&xtm_time, &xtm_local);
+
+    xbt_match = ((x_uint32_t)xtm_local.tm_year + 1900 == xtm_descr.ctx_year  ) &&
+                ((x_uint32_t)xtm_local.tm_mon  + 1    == xtm_descr.ctx_month ) &&
+                ((x_uint32_t)xtm_local.tm_mday        == xtm_descr.ctx_day   ) &&
+                ((x_uint32_t)xtm_local.tm_wday        == xtm_descr.ctx_week  ) &&
+                ((x_uint32_t)xtm_local.tm_hour        == xtm_descr.ctx_hour  ) &&
+                ((x_uint32_t)xtm_local.tm_min         == xtm_descr.ctx_minute) &&
+                ((x_uint32_t)xtm_local.tm_sec         == xtm_descr.ctx_second) &&
+                (123 == xtm_descr.ctx_msec) &&
+                (xtm_local.tm_gmtoff == tzone_offset(xtzone_ptr, xtm_vnsec)) &&
+                (0 == strcmp(xtm_local.tm_zone, tzone_abbr(xtzone_ptr, xtm_vnsec)));
+
+    // 往返：重复的 本地时间 取 较早的 时刻
+    xtm_back  = time_dtov_tz(xtzone_ptr, xtm_descr);
+    xbt_match = xbt_match && (xtm_back <= xtm_vnsec) &&
+                (time_vtod_tz(xtzone_ptr, xtm_back).ctx_value == xtm_descr.ctx_value);
+
+    if (!xbt_match && xbt_print)
+    {
+        printf("  %s @ %lld : libc %04d-%02d-%02d %02d:%02d:%02d %s(%ld), "
+               "tzone %04d-%02d-%02d %02d:%02d:%02d %s(%d), back %lld\n",
+               tzone_name(xtzone_ptr), xit_time,
+               xtm_local.tm_year + 1900, xtm_local.tm_mon + 1, xtm_local.tm_mday,
+               xtm_local.tm_hour, xtm_local.tm_min, xtm_local.tm_sec, xtm_local.tm_zone, xtm_local.tm_gmtoff,
+               xtm_descr.ctx_year, xtm_descr.ctx_month, xtm_descr.ctx_day,
+               xtm_descr.ctx_hour, xtm_descr.ctx_minute, xtm_descr.ctx_second,
+               tzone_abbr(xtzone_ptr, xtm_vnsec), tzone_offset(xtzone_ptr, xtm_vnsec),
+               (x_int64_t)(xtm_back / XTZ_SEC));
+    }
+
+    XTZ_CHECK(xbt_match);
+}
+
+/**********************************************************/
+/**
+ * @brief 对照 localtime_r()：1970-01-02 ~ 2199 年 逐步推进（步长 约 6 小时），并 校验 各个 偏移变化 的 前后 1 秒。
+ */
+static x_void_t check_libc(x_void_t)
+{
+    x_uint32_t      xut_zone   = 0;
+    x_int32_t       xit_fails  = 0;
+    x_int64_t       xit_time   = 0;
+    x_int64_t       xit_lower  = 0;
+    x_int64_t       xit_upper  = 0;
+    x_int64_t       xit_midst  = 0;
+    x_uint32_t      xut_trans  = 0;
+    xtime_zoneptr_t xtzone_ptr = X_NULL;
+    x_char_t        xszt_tz[TEXT_LEN_512];
+
+    static const x_cstring_t xszt_zones[] =
+    {
+        "America/New_York", "Australia/Lord_Howe", "Asia/Kolkata", "Europe/London",
+        "America/Sao_Paulo", "Pacific/Chatham", "Asia/Shanghai", "UTC",
+    };
+
+    for (xut_zone = 0; xut_zone < sizeof(xszt_zones) / sizeof(xszt_zones[0]); ++xut_zone)
+    {
+        xtzone_ptr = tzone_load(xszt_zones[xut_zone]);
+        if (X_NULL == xtzone_ptr)
+        {
+            printf("[%s] not loaded (errno %d), skipped.\n", xszt_zones[xut_zone], errno);
+            XTZ_CHECK(ENOENT == errno);
+            continue;
+        }
+
+        snprintf(xszt_tz, sizeof(xszt_tz), ":%s/%s", XTZONE_DIR_DEFAULT, xszt_zones[xut_zone]);
+        setenv("TZ", xszt_tz, 1);
+        tzset();
+
+        xit_fails = xit_fail;
+        xut_trans = 0;
+
+        for (xit_time = 86400; xit_time < XTZ_SEC_2200; xit_time += 6 * 3600 + 7 * 60 + 13)
+        {
+            check_instant(xtzone_ptr, xit_time, (xit_fail - xit_fails) < 8);
+
+            // 偏移变化：二分查找 变化时刻，校验 前后 1 秒
+            if ((xit_time > 86400) &&
+                (tzone_offset(xtzone_ptr, XTZ_VNSEC(xit_time)) !=
+                 tzone_offset(xtzone_ptr, XTZ_VNSEC(xit_time - (6 * 3600 + 7 * 60 + 13)))))
+            {
+                xit_lower = xit_time - (6 * 3600 + 7 * 60 + 13);
+                xit_upper = xit_time;
+                while (xit_upper - xit_lower > 1)
+                {
+                    xit_midst = (xit_lower + xit_upper) / 2;
+                    if (tzone_offset(xtzone_ptr, XTZ_VNSEC(xit_midst)) == tzone_offset(xtzone_ptr, XTZ_VNSEC(xit_lower)))
+                        xit_lower = xit_midst;
+                    else
+                        xit_upper = xit_midst;
+                }
+
+                check_instant(xtzone_ptr, xit_upper - 1, (xit_fail - xit_fails) < 8);
+                check_instant(xtzone_ptr, xit_upper    , (xit_fail - xit_fails) < 8);
+                xut_trans += 1;
+            }
+        }
+
+        printf("[%s] %u transitions checked, %d failures.\n", xszt_zones[xut_zone], xut_trans, xit_fail - xit_fails);
+    }
+
+    setenv("TZ", "UTC0", 1);
+    tzset();
+}
+
+/**********************************************************/
+/**
+ * @brief 同时加载 同一时区 的 线程。
+ */
+static x_pvoid_t load_proc(x_pvoid_t xpvt_param)
+{
+    return (x_pvoid_t)tzone_load((x_cstring_t)xpvt_param);
+}
+
+#endif // (defined(__linux__) || defined(__unix__))
+
+/**********************************************************/
+/**
+ * @brief 校验 时区对象 的 共享：重复加载 与 多个线程 同时加载 得到 同一对象，以及 名称 的 校验。
+ */
+static x_void_t check_shared(x_void_t)
+{
+    xtime_zoneptr_t xtzone_ptr = tzone_load("Europe/Paris");
+    xtime_descr_t   xtm_descr;
+
+    errno = 0;
+    XTZ_CHECK((X_NULL == tzone_load("../etc/passwd")) && (EINVAL == errno));
+    XTZ_CHECK((X_NULL == tzone_load("Asia/../../etc/passwd")) && (EINVAL == errno));
+    XTZ_CHECK((X_NULL == tzone_load("")) && (EINVAL == errno));
+    XTZ_CHECK((X_NULL == tzone_load("No/Such_Zone")) && (ENOENT == errno));
+
+    // X_NULL 为 UTC
+    xtm_descr = time_vtod_tz(X_NULL, XTZ_VNSEC(1793512800LL));
+    XTZ_CHECK((2026 == xtm_descr.ctx_year) && (11 == xtm_descr.ctx_month) && (6 == xtm_descr.ctx_hour));
+    XTZ_CHECK(XTZ_VNSEC(1793512800LL) == time_dtov_tz(X_NULL, xtm_descr));
+    XTZ_CHECK(0 == strcmp("UTC", tzone_name(X_NULL)));
+
+    if (X_NULL == xtzone_ptr)
+    {
+        printf("[Europe/Paris] not loaded (errno %d), shared checks skipped.\n", errno);
+        return;
+    }
+
+    XTZ_CHECK(xtzone_ptr == tzone_load("Europe/Paris"));
+    XTZ_CHECK(0 == strcmp("Europe/Paris", tzone_name(xtzone_ptr)));
+
+    // 共享的 时区对象 不被 销毁
+    tzone_destroy(xtzone_ptr);
+    XTZ_CHECK(3600 == tzone_offset(xtzone_ptr, XTZ_VNSEC(1798761600LL)));  // 2027-01-01 00:00:00 UTC
+
+#if (defined(__linux__) || defined(__unix__))
+    {
+        x_uint32_t xut_iter = 0;
+        pthread_t  xthd_list[8];
+        x_pvoid_t  xpvt_zone[8];
+
+        for (xut_iter = 0; xut_iter < 8; ++xut_iter)
+            pthread_create(&xthd_list[xut_iter], X_NULL, load_proc, (x_pvoid_t)"Europe/Berlin");
+        for (xut_iter = 0; xut_iter < 8; ++xut_iter)
+            pthread_join(xthd_list[xut_iter], &xpvt_zone[xut_iter]);
+
+        for (xut_iter = 0; xut_iter < 8; ++xut_iter)
+            XTZ_CHECK((X_NULL != xpvt_zone[xut_iter]) && (xpvt_zone[0] == xpvt_zone[xut_iter]));
+        XTZ_CHECK(xpvt_zone[0] == (x_pvoid_t)tzone_load("Europe/Berlin"));
+    }
+#endif // (defined(__linux__) || defined(__unix__))
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// 程序入口的主函数
+//
+
+int main(int argc, char * argv[])
+{
+    check_blob();
+    printf("TZif blobs : %s\n", (0 == xit_fail) ? "ok" : "FAILED");
+
+#if (defined(__linux__) || defined(__unix__))
+    check_libc();
+#endif // (defined(__linux__) || defined(__unix__))
+
+    check_shared();
+
+    printf("%s : %d failures\n", (argc > 0) ? argv[0] : "tzone_test", xit_fail);
+    return (0 == xit_fail) ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+﻿/**
+ * @file xtest_server.h
+ * Copyright (c) 2026 Gaaagaa. All rights reserved.
+ *
+ * @author  : Gaaagaa
+ * @date    : 2026-10-18
+ * @version : 1.0.0.0
+ * @brief   : 测试程序 共用的 简易 NTP 服务端（本机回环地址 上 的 UDP 服务端）。
+ * @note
+ * 默认 以 本地时钟 加 xit_offset 应答 客户端请求（LI 为 xut_leap，层数 为 xut_stratum）；
+ * 需要 特殊应答（延迟、不应答、签名、无效时间戳 等）的 测试，设置 xfunc_reply 逐个 构建 应答。
+ * 服务端 可 在 独立的 线程 中 运行（xtest_server_run()），
+ * 也可 由 测试程序 自己的 事件循环 在 套接字 可读 时 调用 xtest_server_serve()。
+ */
+
+#ifndef __XTEST_SERVER_H__
+#define __XTEST_SERVER_H__
+
+#include "ntp_packet.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <WinSock2.h>
+#include <windows.h>
+#else // !(defined(_WIN32) || defined(_WIN64))
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif // defined(_WIN32) || defined(_WIN64)
+
+#include <string.h>
+#include <errno.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/** 应答 缓存 的 容量（可容纳 带 MAC 的 应答） */
+#define XTEST_SBUF_MAX  (XNTP_PKT_LEN + XNTP_MAC_MAX)
+
+typedef struct xtest_server_t xtest_server_t;
+
+/**
+ * @brief 构建 应答 的 回调函数（收到 有效的 NTP 报文 后 调用）。
+ *
+ * @param [in ] xsrv_ptr  : 服务端。
+ * @param [in ] xbt_rbuf  : 收到的 报文。
+ * @param [in ] xview_req : 报文的 解析视图。
+ * @param [out] xbt_sbuf  : 应答 缓存（容量 为 XTEST_SBUF_MAX）。
+ *
+ * @return x_uint32_t : 返回 应答的 长度；返回 0 表示 不应答。
+ */
+typedef x_uint32_t (* xtest_reply_cbk)(
+                        xtest_server_t * xsrv_ptr,
+                        const x_uchar_t * xbt_rbuf,
+                        const xntp_view_t * xview_req,
+                        x_uchar_t * xbt_sbuf);
+
+/**
+ * @brief 周期回调（服务端线程 每 xut_tick 毫秒 调用 一次，如 发送 广播报文）。
+ */
+typedef x_void_t (* xtest_tick_cbk)(xtest_server_t * xsrv_ptr);
+
+/**
+ * @struct xtest_server_t
+ * @brief  简易 NTP 服务端 的 工作参数（使用前 清零，再 按需 设置）。
+ */
+struct xtest_server_t
+{
+    x_sockfd_t          xfdt_sockfd;  ///< 服务端套接字
+    x_uint32_t          xut_ipv4;     ///< 绑定的 地址（主机字节序，0 表示 127.0.0.1）
+    x_uint16_t          xut_port;     ///< 绑定的 端口号（0 表示 随机端口，打开后 为 实际的 端口号）
+    x_int64_t           xit_offset;   ///< 默认应答 的 时钟 相对于 本地时钟 的 偏差
+    x_uint32_t          xut_leap;     ///< 默认应答 的 LI
+    x_uint32_t          xut_stratum;  ///< 默认应答 的 层数（0 表示 2）
+    xtest_reply_cbk     xfunc_reply;  ///< 构建 应答 的 回调函数（X_NULL 表示 默认应答）
+    xtest_tick_cbk      xfunc_tick;   ///< 周期回调（X_NULL 表示 无）
+    x_uint32_t          xut_tick;     ///< 周期回调 的 间隔（毫秒）
+    x_pvoid_t           xpvt_ctx;     ///< 回调函数 使用的 上下文
+    volatile x_uint32_t xut_recvd;    ///< 已收到的 有效 NTP 报文 数量
+    volatile x_bool_t   xbt_stop;     ///< 停止标识
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE              xthd_proc;    ///< 服务端线程
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_t           xthd_proc;    ///< 服务端线程
+#endif // defined(_WIN32) || defined(_WIN64)
+};
+
+//====================================================================
+
+/**********************************************************/
+/**
+ * @brief 关闭套接字。
+ */
+static inline x_void_t xtest_sockfd_close(x_sockfd_t xfdt_sockfd)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    closesocket(xfdt_sockfd);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    close(xfdt_sockfd);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 休眠 指定的 毫秒数。
+ */
+static inline x_void_t xtest_sleep_msec(x_uint32_t xut_msec)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    Sleep(xut_msec);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    usleep(xut_msec * 1000);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 服务端 的 时钟（本地时钟 加 xit_offset）转换成的 NTP 时间戳。
+ */
+static inline x_uint64_t xtest_server_stamp(const xtest_server_t * xsrv_ptr)
+{
+    return ntp_stamp_from_vnsec((xtime_vnsec_t)((x_int64_t)time_vnsec() + xsrv_ptr->xit_offset));
+}
+
+/**********************************************************/
+/**
+ * @brief 构建 默认应答：服务器模式，T2 与 T3 取 xtest_server_stamp()。
+ *
+ * @return x_uint32_t : 返回 应答的 长度（XNTP_PKT_LEN）。
+ */
+static inline x_uint32_t xtest_server_reply(
+                            xtest_server_t * xsrv_ptr,
+                            const xntp_view_t * xview_req,
+                            x_uchar_t * xbt_sbuf)
+{
+    x_uint64_t xut_stamp = xtest_server_stamp(xsrv_ptr);
+
+    ntp_req_init(xbt_sbuf);
+    xbt_sbuf[XNTP_OFF_LVM    ] = XNTP_LI_VN_MODE(xsrv_ptr->xut_leap, 4, ntp_mode_server);
+    xbt_sbuf[XNTP_OFF_STRATUM] = (x_uchar_t)((0 != xsrv_ptr->xut_stratum) ? xsrv_ptr->xut_stratum : 2);
+    ntp_store64(xbt_sbuf + XNTP_OFF_ORIGINATE, ntpv_transmit(xview_req));
+    ntp_store64(xbt_sbuf + XNTP_OFF_RECEIVE  , xut_stamp);
+    ntp_store64(xbt_sbuf + XNTP_OFF_TRANSMIT , xut_stamp);
+
+    return XNTP_PKT_LEN;
+}
+
+/**********************************************************/
+/**
+ * @brief 建立 服务端套接字（绑定 xut_ipv4:xut_port）。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static inline x_int32_t xtest_server_open(xtest_server_t * xsrv_ptr)
+{
+    struct sockaddr_in xaddr_host;
+#if defined(_WIN32) || defined(_WIN64)
+    x_int32_t          xit_alen = sizeof(struct sockaddr_in);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = sizeof(struct sockaddr_in);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    if (0 == xsrv_ptr->xut_ipv4)
+        xsrv_ptr->xut_ipv4 = INADDR_LOOPBACK;
+
+    xsrv_ptr->xbt_stop    = X_FALSE;
+    xsrv_ptr->xfdt_sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (X_INVALID_SOCKFD == xsrv_ptr->xfdt_sockfd)
+        return errno;
+
+    memset(&xaddr_host, 0, sizeof(struct sockaddr_in));
+    xaddr_host.sin_family      = AF_INET;
+    xaddr_host.sin_addr.s_addr = htonl(xsrv_ptr->xut_ipv4);
+    xaddr_host.sin_port        = htons(xsrv_ptr->xut_port);
+
+    if ((0 != bind(xsrv_ptr->xfdt_sockfd, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in))) ||
+        (0 != getsockname(xsrv_ptr->xfdt_sockfd, (struct sockaddr *)&xaddr_host, &xit_alen)))
+    {
+        xtest_sockfd_close(xsrv_ptr->xfdt_sockfd);
+        xsrv_ptr->xfdt_sockfd = X_INVALID_SOCKFD;
+        return errno;
+    }
+
+    xsrv_ptr->xut_port = ntohs(xaddr_host.sin_port);
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 接收 一个报文，并 应答（套接字 可读 时 调用；否则 阻塞 至 收到报文）。
+ */
+static inline x_void_t xtest_server_serve(xtest_server_t * xsrv_ptr)
+{
+    x_uchar_t          xbt_rbuf[XNTP_PKT_MAX];
+    x_uchar_t          xbt_sbuf[XTEST_SBUF_MAX];
+    x_int32_t          xit_rlen = 0;
+    x_uint32_t         xut_slen = 0;
+    xntp_view_t        xview_pk;
+    struct sockaddr_in xaddr_peer;
+#if defined(_WIN32) || defined(_WIN64)
+    x_int32_t          xit_alen = sizeof(struct sockaddr_in);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    socklen_t          xit_alen = sizeof(struct sockaddr_in);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    xit_rlen = (x_int32_t)recvfrom(xsrv_ptr->xfdt_sockfd,
+                                   (x_char_t *)xbt_rbuf,
+                                   sizeof(xbt_rbuf),
+                                   0,
+                                   (struct sockaddr *)&xaddr_peer,
+                                   &xit_alen);
+    if ((xit_rlen <= 0) || xsrv_ptr->xbt_stop || (0 != ntpv_init(&xview_pk, xbt_rbuf, xit_rlen)))
+        return;
+
+    // 只有 服务端 自己 写入（C++20 不再 支持 volatile 的 复合赋值）
+    xsrv_ptr->xut_recvd = xsrv_ptr->xut_recvd + 1;
+
+    if (X_NULL != xsrv_ptr->xfunc_reply)
+        xut_slen = xsrv_ptr->xfunc_reply(xsrv_ptr, xbt_rbuf, &xview_pk, xbt_sbuf);
+    else
+        xut_slen = xtest_server_reply(xsrv_ptr, &xview_pk, xbt_sbuf);
+
+    if (0 == xut_slen)
+        return;
+
+    sendto(xsrv_ptr->xfdt_sockfd,
+           (const x_char_t *)xbt_sbuf,
+           xut_slen,
+           0,
+           (struct sockaddr *)&xaddr_peer,
+           sizeof(struct sockaddr_in));
+}
+
+/**********************************************************/
+/**
+ * @brief 服务端线程：应答请求；设置了 周期回调 时，每 xut_tick 毫秒 调用 一次。
+ */
+#if defined(_WIN32) || defined(_WIN64)
+static inline DWORD WINAPI xtest_server_proc(LPVOID xpvt_param)
+#else // !(defined(_WIN32) || defined(_WIN64))
+static inline x_pvoid_t xtest_server_proc(x_pvoid_t xpvt_param)
+#endif // defined(_WIN32) || defined(_WIN64)
+{
+    xtest_server_t * xsrv_ptr = (xtest_server_t *)xpvt_param;
+    xtime_vnsec_t    xtm_next = time_mono();
+    xtime_vnsec_t    xtm_mono = 0;
+    xtime_vnsec_t    xtm_wait = 0;
+    fd_set           xfds_rset;
+    struct timeval   xtm_value;
+
+    while (!xsrv_ptr->xbt_stop)
+    {
+        if ((X_NULL == xsrv_ptr->xfunc_tick) || (0 == xsrv_ptr->xut_tick))
+        {
+            xtest_server_serve(xsrv_ptr);
+            continue;
+        }
+
+        //======================================
+        // 到期时 调用 周期回调，其间 等待 请求
+
+        xtm_mono = time_mono();
+        if (xtm_mono >= xtm_next)
+        {
+            xsrv_ptr->xfunc_tick(xsrv_ptr);
+            xtm_next = xtm_mono + xsrv_ptr->xut_tick * XTIME_VNSEC_MSEC;
+            continue;
+        }
+
+        xtm_wait = xtm_next - xtm_mono;
+        xtm_value.tv_sec  = (x_long_t)(xtm_wait / (1000ULL * XTIME_VNSEC_MSEC));
+        xtm_value.tv_usec = (x_long_t)((xtm_wait % (1000ULL * XTIME_VNSEC_MSEC)) / 10ULL);
+
+        FD_ZERO(&xfds_rset);
+        FD_SET(xsrv_ptr->xfdt_sockfd, &xfds_rset);
+        if (select((x_int32_t)(xsrv_ptr->xfdt_sockfd + 1), &xfds_rset, X_NULL, X_NULL, &xtm_value) > 0)
+            xtest_server_serve(xsrv_ptr);
+    }
+
+    return 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 在 独立的 线程 中 运行 服务端（须 先 xtest_server_open()）。
+ */
+static inline x_void_t xtest_server_run(xtest_server_t * xsrv_ptr)
+{
+#if defined(_WIN32) || defined(_WIN64)
+    xsrv_ptr->xthd_proc = CreateThread(X_NULL, 0, xtest_server_proc, xsrv_ptr, 0, X_NULL);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_create(&xsrv_ptr->xthd_proc, X_NULL, xtest_server_proc, xsrv_ptr);
+#endif // defined(_WIN32) || defined(_WIN64)
+}
+
+/**********************************************************/
+/**
+ * @brief 建立 服务端套接字，并 在 独立的 线程 中 运行。
+ *
+ * @return x_int32_t : 成功，返回 0；失败，返回 错误码。
+ */
+static inline x_int32_t xtest_server_start(xtest_server_t * xsrv_ptr)
+{
+    x_int32_t xit_errno = xtest_server_open(xsrv_ptr);
+    if (0 == xit_errno)
+        xtest_server_run(xsrv_ptr);
+    return xit_errno;
+}
+
+/**********************************************************/
+/**
+ * @brief 停止 服务端线程（置停止标识后，投递一个 空报文 唤醒 recvfrom()），并 关闭 套接字。
+ */
+static inline x_void_t xtest_server_stop(xtest_server_t * xsrv_ptr)
+{
+    struct sockaddr_in xaddr_host;
+
+    memset(&xaddr_host, 0, sizeof(struct sockaddr_in));
+    xaddr_host.sin_family      = AF_INET;
+    xaddr_host.sin_addr.s_addr = htonl(xsrv_ptr->xut_ipv4);
+    xaddr_host.sin_port        = htons(xsrv_ptr->xut_port);
+
+    xsrv_ptr->xbt_stop = X_TRUE;
+    sendto(xsrv_ptr->xfdt_sockfd, "", 1, 0, (struct sockaddr *)&xaddr_host, sizeof(struct sockaddr_in));
+
+#if defined(_WIN32) || defined(_WIN64)
+    WaitForSingleObject(xsrv_ptr->xthd_proc, INFINITE);
+    CloseHandle(xsrv_ptr->xthd_proc);
+#else // !(defined(_WIN32) || defined(_WIN64))
+    pthread_join(xsrv_ptr->xthd_proc, X_NULL);
+#endif // defined(_WIN32) || defined(_WIN64)
+
+    xtest_sockfd_close(xsrv_ptr->xfdt_sockfd);
+    xsrv_ptr->xfdt_sockfd = X_INVALID_SOCKFD;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XTEST_SERVER_H__
@@ -33,6 +33,169 @@
 #include "xtime.h"
 #include <stdio.h>
 
+#if (defined(__linux__) || defined(__unix__))
+#include <stdlib.h>
+#include <time.h>
+#endif // (defined(__linux__) || defined(__unix__))
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**********************************************************/
+/**
+ * @brief 测试 成对采集 与 TSC 换算：系统时间 一致、单调性、与 原始单调时钟 的 速率偏差。
+ *
+ * @return x_int32_t : 返回 未通过的 校验项数量。
+ */
+static x_int32_t test_pair(void)
+{
+    x_int32_t     xit_fail  = 0;
+    x_uint32_t    xut_iter  = 0;
+    xtime_pair_t  xtm_pair  = time_pair();
+    xtime_vnsec_t xtm_real  = time_vnsec();
+    xtime_vnsec_t xtm_last  = 0;
+    xtime_vnsec_t xtm_fast  = 0;
+    xtime_vnsec_t xtm_raw0  = 0;
+    xtime_vnsec_t xtm_fast0 = 0;
+    xtime_vnsec_t xtm_raw1  = 0;
+    xtime_vnsec_t xtm_fast1 = 0;
+    x_int64_t     xit_diff  = 0;
+
+    printf("TSC : %llu Hz\n", time_tsc_freq());
+    printf("PAIR: mono %llu, real %llu, tsc %llu\n", xtm_pair.xtm_mono, xtm_pair.xtm_real, xtm_pair.xut_tsc);
+
+    // 成对采集的 系统时间 与 time_vnsec() 相差 不超过 1 毫秒
+    xit_diff = (x_int64_t)(xtm_real - xtm_pair.xtm_real);
+    if ((xit_diff < -(x_int64_t)XTIME_VNSEC_MSEC) || (xit_diff > (x_int64_t)XTIME_VNSEC_MSEC))
+    {
+        printf("PAIR: real differs from time_vnsec() by %lld\n", xit_diff);
+        xit_fail += 1;
+    }
+
+    // time_mono_fast() 单调不减，且 不早于 此前 成对采集的 单调时钟
+    xtm_last = xtm_pair.xtm_mono;
+    for (xut_iter = 0; xut_iter < 1000000; ++xut_iter)
+    {
+        xtm_fast = time_mono_fast();
+        if (xtm_fast < xtm_last)
+        {
+            printf("FAST: went backwards %llu -> %llu\n", xtm_last, xtm_fast);
+            xit_fail += 1;
+            break;
+        }
+        xtm_last = xtm_fast;
+    }
+
+    // 200 毫秒内，与 原始单调时钟 的 走时之差 不超过 50 ppm（10 微秒）
+    xtm_raw0  = time_mono_raw();
+    xtm_fast0 = time_mono_fast();
+    do
+    {
+        xtm_raw1  = time_mono_raw();
+        xtm_fast1 = time_mono_fast();
+    } while ((xtm_raw1 - xtm_raw0) < 200 * XTIME_VNSEC_MSEC);
+
+    xit_diff = (x_int64_t)(xtm_fast1 - xtm_fast0) - (x_int64_t)(xtm_raw1 - xtm_raw0);
+    printf("FAST: %lld x 100ns off CLOCK_MONOTONIC_RAW over %llu x 100ns\n", xit_diff, xtm_raw1 - xtm_raw0);
+    if ((xit_diff < -100) || (xit_diff > 100))
+    {
+        xit_fail += 1;
+    }
+
+    // 原始单调时钟 与 单调时钟 同为 开机以来的时长，相差 通常 远小于 1 秒
+    xit_diff = (x_int64_t)(time_mono_raw() - time_mono());
+    printf("RAW : %lld x 100ns off CLOCK_MONOTONIC\n", xit_diff);
+
+    return xit_fail;
+}
+
+/**********************************************************/
+/**
+ * @brief 测试 time_vtod() 的 线程内缓存：在 夏令时 切换、半小时 时区、跨年、闰日 前后 逐步转换，
+ *        与 localtime_r() 的 结果 逐项对照（含 倒退的 时刻）。
+ *
+ * @return x_int32_t : 返回 未通过的 校验项数量。
+ */
+static x_int32_t test_vtod_cache(void)
+{
+    x_int32_t xit_fail = 0;
+
+#if (defined(__linux__) || defined(__unix__))
+
+    x_uint32_t    xut_iter  = 0;
+    x_uint32_t    xut_zone  = 0;
+    x_uint32_t    xut_okay  = 0;
+    xtime_vnsec_t xtm_vnsec = 0;
+    xtime_descr_t xtm_descr;
+    time_t        xtm_time;
+    struct tm     xtm_local;
+
+    /** 时区（POSIX TZ 格式，无须 时区数据库）与 其 切换时刻（UTC 秒数） */
+    static const struct
+    {
+        x_cstring_t xszt_tz;
+        x_int64_t   xit_when;
+    } xzone_list[] =
+    {
+        { "EST5EDT,M3.2.0,M11.1.0"                , 1772953200LL },  // 2026-03-08 02:00 EST -> 03:00 EDT
+        { "EST5EDT,M3.2.0,M11.1.0"                , 1793512800LL },  // 2026-11-01 02:00 EDT -> 01:00 EST
+        { "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0"  , 1791041400LL },  // 半小时的 夏令时
+        { "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0"  , 1775314800LL },
+        { "IST-5:30"                              , 1798741800LL },  // 本地 跨年
+        { "UTC0"                                  , 1709161200LL },  // 2024-02-29 闰日
+    };
+
+    for (xut_zone = 0; xut_zone < sizeof(xzone_list) / sizeof(xzone_list[0]); ++xut_zone)
+    {
+        setenv("TZ", xzone_list[xut_zone].xszt_tz, 1);
+        tzset();
+
+        // 各项 相距 远超 1 小时，切换时区后的 首次转换 不会 落在 此前 缓存的 时间段 内
+        xtm_vnsec = (xtime_vnsec_t)(xzone_list[xut_zone].xit_when - 2 * 3600) * 10000000ULL;
+
+        for (xut_iter = 0, xut_okay = 0; xut_iter < 20000; ++xut_iter)
+        {
+            if (0 == (xut_iter % 11))
+                xtm_vnsec -= 30 * 10000000ULL + 4321;
+            else
+                xtm_vnsec += (xut_iter % 7) * 13000000ULL + 1234;
+
+            xtm_descr = time_vtod(xtm_vnsec);
+            xtm_time  = (time_t)(xtm_vnsec / 10000000ULL);
+            localtime_r(&xtm_time, &xtm_local);
+
+            if ((xtm_descr.ctx_year   == (x_uint32_t)(xtm_local.tm_year + 1900)) &&
+                (xtm_descr.ctx_month  == (x_uint32_t)(xtm_local.tm_mon  + 1   )) &&
+                (xtm_descr.ctx_day    == (x_uint32_t)(xtm_local.tm_mday       )) &&
+                (xtm_descr.ctx_week   == (x_uint32_t)(xtm_local.tm_wday       )) &&
+                (xtm_descr.ctx_hour   == (x_uint32_t)(xtm_local.tm_hour       )) &&
+                (xtm_descr.ctx_minute == (x_uint32_t)(xtm_local.tm_min        )) &&
+                (xtm_descr.ctx_second == (x_uint32_t)(xtm_local.tm_sec        )) &&
+                (xtm_descr.ctx_msec   == (x_uint32_t)((xtm_vnsec % 10000000ULL) / 10000)))
+            {
+                xut_okay += 1;
+                continue;
+            }
+
+            printf("VTOD: [%s] %llu -> %04d-%02d-%02d %d %02d:%02d:%02d.%03d, localtime_r() %02d:%02d:%02d\n",
+                   xzone_list[xut_zone].xszt_tz, xtm_vnsec,
+                   xtm_descr.ctx_year, xtm_descr.ctx_month, xtm_descr.ctx_day, xtm_descr.ctx_week,
+                   xtm_descr.ctx_hour, xtm_descr.ctx_minute, xtm_descr.ctx_second, xtm_descr.ctx_msec,
+                   xtm_local.tm_hour, xtm_local.tm_min, xtm_local.tm_sec);
+            xit_fail += 1;
+            break;
+        }
+
+        printf("VTOD: [%s] %u conversion(s) checked\n", xzone_list[xut_zone].xszt_tz, xut_okay);
+    }
+
+    unsetenv("TZ");
+    tzset();
+
+#endif // (defined(__linux__) || defined(__unix__))
+
+    return xit_fail;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 int main(int argc, char * argv[])
@@ -71,7 +234,7 @@ int main(int argc, char * argv[])
            xtm_dcnvt.ctx_second,
            xtm_dcnvt.ctx_msec);
 
-    return 0;
+    return (0 == (test_pair() + test_vtod_cache())) ? 0 : 1;
 }
 
 ////////////////////////////////////////////////////////////////////////////////